@@ -0,0 +1,945 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "ComplexDecomposition.h"
+#include "ComplexFormat.h"
+#include "ComplexMath.h"
+#include "ComplexReduction.h"
+#include "ComplexSparse.h"
+#include "Fft.h"
+#include "Fir.h"
+#include "Oscillator.h"
+#include "Parallel.h"
+#include "Polynomial.h"
+#include "QuantizedArray.h"
+#include "SlidingDft.h"
+
+using namespace Math;
+
+namespace {
+
+using StdComplex = std::complex<double>;
+using ComplexArrayD = BasicComplexArray<double>;
+
+/// Number of elements in the array and batched modes: from L1 resident inputs to inputs larger than the L2 cache
+const std::vector<int64_t> SIZES = {64, 1024, 16384, 262144};
+
+/// Number of taps of the FIR benchmarks, around FIR_DIRECT_TAPS and up to long filters
+const std::vector<int64_t> FIR_TAPS = {8, 32, 64, 128, 256, 1024};
+
+/// Number of samples that the FIR benchmarks filter per iteration
+constexpr std::size_t FIR_BLOCK = 16384;
+
+/// Number of bins of the spectral monitoring benchmarks
+const std::vector<int64_t> SPECTRAL_BINS = {8, 32, 128};
+
+/// Window of the sliding DFT and block of the Goertzel benchmarks
+constexpr std::size_t SPECTRAL_WINDOW = 1024;
+
+/// Order of the matrices of the factorization benchmarks, around and well above DECOMPOSITION_BLOCK_SIZE
+const std::vector<int64_t> MATRIX_ORDERS = {64, 256, 512};
+
+/// Orders of the small matrices of the batched eigen solver benchmarks, and the matrices per batch
+const std::vector<int64_t> EIGEN_ORDERS = {8, 16, 32};
+constexpr std::size_t EIGEN_BATCH = 256;
+
+/// Rows of the sparse benchmarks, with a vector in the L2 cache and vectors well beyond it, and elements per row
+const std::vector<int64_t> SPARSE_ROWS = {16384, 262144};
+constexpr std::size_t SPARSE_ROW_ELEMENTS = 8;
+
+/// Number of elements of the parallel benchmarks, up to MAX_ELEMENT_COUNT
+const std::vector<int64_t> PARALLEL_SIZES = {262144, 1 << 22, MAX_ELEMENT_COUNT};
+
+/// Real operand of the mixed complex/real operations
+constexpr double REAL_OPERAND = 1.25;
+
+/// Operands of an operation
+enum class Operands { Complex, ComplexComplex, ComplexReal, RealComplex };
+
+/// Modes in which an operation is benchmarked
+enum class Modes { All, ScalarAndArray, Scalar };
+
+/// @return Complex values with magnitudes in [0.5, 2) and uniformly distributed phases, the same for every run
+template <typename Z>
+std::vector<Z> testValues(const std::size_t size, const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> magnitude(0.5, 2.0);
+  std::uniform_real_distribution<double> phase(-std::numbers::pi, std::numbers::pi);
+  std::vector<Z> values(size);
+  for (Z& z : values) {
+    const double r = magnitude(generator);
+    const double phi = phase(generator);
+    z = Z(r * std::cos(phi), r * std::sin(phi));
+  }
+  return values;
+}
+
+/// @return Split array with the values of testValues, rounded to T
+template <scalar T = double>
+BasicComplexArray<T> testArray(const std::size_t size, const unsigned seed) {
+  const std::vector<ComplexD> values = testValues<ComplexD>(size, seed);
+  BasicComplexArray<T> array(static_cast<Math::size_t>(size));
+  for (std::size_t i = 0; i < size; ++i) {
+    array[i] = BasicComplex<T>(static_cast<T>(values[i].real()), static_cast<T>(values[i].imag()));
+  }
+  return array;
+}
+
+/// Applies an operation to its operands, b is only used by operations on two complex operands
+template <Operands O, typename Op, typename A>
+auto apply(const Op& op, const A& a, const A& b) {
+  if constexpr (O == Operands::Complex) {
+    return op(a);
+  } else if constexpr (O == Operands::ComplexComplex) {
+    return op(a, b);
+  } else if constexpr (O == Operands::ComplexReal) {
+    return op(a, REAL_OPERAND);
+  } else {
+    return op(REAL_OPERAND, a);
+  }
+}
+
+/// One operation on values in registers, measures the latency of the operation
+template <Operands O, typename Z, typename Op>
+void scalarBenchmark(benchmark::State& state, const Op& op) {
+  Z a = testValues<Z>(1, 1)[0];
+  Z b = testValues<Z>(1, 2)[0];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    auto result = apply<O>(op, a, b);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// A loop of the operation over interleaved arrays, measures the throughput that the compiler achieves with the type
+template <Operands O, typename Z, typename Op>
+void arrayBenchmark(benchmark::State& state, const Op& op) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const std::vector<Z> a = testValues<Z>(size, 1);
+  const std::vector<Z> b = testValues<Z>(size, 2);
+  std::vector<decltype(apply<O>(op, a[0], b[0]))> out(size);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < size; ++i) out[i] = apply<O>(op, a[i], b[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// The operation on split ComplexArrays of T, evaluated by the SIMD kernels. Real results are written to a real array.
+template <Operands O, typename Op, scalar T = double>
+void batchedBenchmark(benchmark::State& state, const Op& op) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const BasicComplexArray<T> a = testArray<T>(size, 1);
+  const BasicComplexArray<T> b = testArray<T>(size, 2);
+  BasicComplexArray<T> out(static_cast<Math::size_t>(size));
+  AlignedVector<T> realOut(size);
+  for (auto _ : state) {
+    const auto expression = apply<O>(op, a, b);
+    if constexpr (decltype(expression)::REAL) {
+      evaluate(expression, std::span<T>(realOut));
+    } else {
+      out = expression;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Registers the benchmarks of an operation: Scalar/<name>/{Math,Std}, Array/<name>/{Math,Std}/<size> and
+/// Batched/<name>/Math/<size>, and Float/Batched/<name>/Math/<size> on float arrays. The array mode of std::complex
+/// is the baseline of the batched mode.
+/// @param name Name of the operation
+/// @param mathOp Operation on Math::BasicComplex<double>, and on ComplexArrays in the batched mode
+/// @param stdOp Operation on std::complex<double>
+template <Operands O, Modes M = Modes::All, typename MathOp, typename StdOp>
+void registerOperation(const std::string& name, const MathOp& mathOp, const StdOp& stdOp) {
+  benchmark::RegisterBenchmark(("Scalar/" + name + "/Math").c_str(), scalarBenchmark<O, ComplexD, MathOp>, mathOp);
+  benchmark::RegisterBenchmark(("Scalar/" + name + "/Std").c_str(), scalarBenchmark<O, StdComplex, StdOp>, stdOp);
+  if constexpr (M != Modes::Scalar) {
+    benchmark::RegisterBenchmark(("Array/" + name + "/Math").c_str(), arrayBenchmark<O, ComplexD, MathOp>, mathOp)
+        ->ArgsProduct({SIZES});
+    benchmark::RegisterBenchmark(("Array/" + name + "/Std").c_str(), arrayBenchmark<O, StdComplex, StdOp>, stdOp)
+        ->ArgsProduct({SIZES});
+  }
+  if constexpr (M == Modes::All) {
+    benchmark::RegisterBenchmark(("Batched/" + name + "/Math").c_str(), batchedBenchmark<O, MathOp>, mathOp)
+        ->ArgsProduct({SIZES});
+    benchmark::RegisterBenchmark(("Float/Batched/" + name + "/Math").c_str(), batchedBenchmark<O, MathOp, float>,
+                                 mathOp)
+        ->ArgsProduct({SIZES});
+  }
+}
+
+/// Registers an operation that is spelled the same for both types
+template <Operands O, Modes M = Modes::All, typename Op>
+void registerOperation(const std::string& name, const Op& op) {
+  registerOperation<O, M>(name, op, op);
+}
+
+/// Frequency and initial phase of the oscillator benchmarks in radians
+constexpr double OSCILLATOR_FREQUENCY = 0.173;
+constexpr double OSCILLATOR_PHASE = 0.4;
+
+/// Phasor sequence by one exp per sample, the baseline of the oscillator
+void expPhasorBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<ComplexD> out(size);
+  for (auto _ : state) {
+    for (std::size_t n = 0; n < size; ++n) out[n] = exp(ComplexD(0, OSCILLATOR_FREQUENCY * n + OSCILLATOR_PHASE));
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Phasor sequence by the numerically controlled oscillator, which continues its stream over the iterations
+void oscillatorBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  BasicOscillator<double> oscillator(OSCILLATOR_FREQUENCY, OSCILLATOR_PHASE);
+  ComplexArrayD out(static_cast<Math::size_t>(size));
+  for (auto _ : state) {
+    oscillator.generate(out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Degree of the polynomial evaluation benchmarks
+constexpr std::size_t POLYNOMIAL_DEGREE = 16;
+
+/// Polynomial evaluation by Horner's scheme on std::complex, one point after the other
+void stdPolynomialBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const std::vector<StdComplex> c = testValues<StdComplex>(POLYNOMIAL_DEGREE + 1, 3);
+  const std::vector<StdComplex> z = testValues<StdComplex>(size, 1);
+  std::vector<StdComplex> out(size);
+  for (auto _ : state) {
+    for (std::size_t n = 0; n < size; ++n) {
+      StdComplex p = c[POLYNOMIAL_DEGREE];
+      for (std::size_t k = POLYNOMIAL_DEGREE; k-- > 0;) p = p * z[n] + c[k];
+      out[n] = p;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Polynomial evaluation by the SIMD kernel, one point per lane
+void polynomialBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const std::vector<ComplexD> c = testValues<ComplexD>(POLYNOMIAL_DEGREE + 1, 3);
+  const BasicPolynomial<double> p(c);
+  const ComplexArrayD z = testArray(size, 1);
+  ComplexArrayD out(static_cast<Math::size_t>(size));
+  for (auto _ : state) {
+    p.evaluate(z, out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Text of an array by operator<< on std::complex, one value after the other
+void stdStreamArrayBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const std::vector<StdComplex> z = testValues<StdComplex>(size, 1);
+  for (auto _ : state) {
+    std::ostringstream os;
+    os.precision(17);
+    for (const StdComplex& x : z) os << x << '\n';
+    benchmark::DoNotOptimize(os.str().data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Text of an array by the bulk writer into a buffer
+void formatArrayBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const ComplexArrayD z = testArray(size, 1);
+  std::vector<char> buffer(formattedSize<double>(size));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(to_chars<double>(buffer.data(), buffer.data() + buffer.size(), z).ptr);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Reading an array by operator>> on std::complex from its text "(a,b)"
+void stdParseArrayBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::ostringstream os;
+  os.precision(17);
+  for (const StdComplex& x : testValues<StdComplex>(size, 1)) os << x << '\n';
+  const std::string text = os.str();
+  std::vector<StdComplex> z(size);
+  for (auto _ : state) {
+    std::istringstream is(text);
+    for (StdComplex& x : z) is >> x;
+    benchmark::DoNotOptimize(z.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Reading an array by the bulk parser from its text "a + bi"
+void parseArrayBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<char> text(formattedSize<double>(size));
+  const char* const last = to_chars<double>(text.data(), text.data() + text.size(), testArray(size, 1)).ptr;
+  ComplexArrayD z(static_cast<Math::size_t>(size));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(from_chars<double>(text.data(), last, z).ptr);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Step of the quantized benchmarks, the values of testValues are below 2
+constexpr double QUANTIZATION_SCALE = 2.0 / 32767;
+
+/// int16 I/Q samples as std::complex<int16_t>, with the values of testValues
+std::vector<std::complex<int16_t>> stdQuantizedValues(const std::size_t size) {
+  std::vector<std::complex<int16_t>> q(size);
+  const std::vector<StdComplex> z = testValues<StdComplex>(size, 1);
+  for (std::size_t n = 0; n < size; ++n) {
+    q[n] = {static_cast<int16_t>(std::lround(z[n].real() / QUANTIZATION_SCALE)),
+            static_cast<int16_t>(std::lround(z[n].imag() / QUANTIZATION_SCALE))};
+  }
+  return q;
+}
+
+/// Dequantization of int16 samples into std::complex, one sample after the other
+void stdDequantizeBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const std::vector<std::complex<int16_t>> q = stdQuantizedValues(size);
+  std::vector<StdComplex> out(size);
+  for (auto _ : state) {
+    for (std::size_t n = 0; n < size; ++n) out[n] = QUANTIZATION_SCALE * StdComplex(q[n].real(), q[n].imag());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Dequantization of int16 samples by the SIMD kernel
+void dequantizeBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const BasicQuantizedArray<int16_t, double> q(testArray(size, 1), QUANTIZATION_SCALE);
+  ComplexArrayD out(static_cast<Math::size_t>(size));
+  for (auto _ : state) {
+    q.dequantize(out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// acc += dequantized samples * w on std::complex, one sample after the other
+void stdQuantizedMultiplyAccumulateBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const std::vector<std::complex<int16_t>> q = stdQuantizedValues(size);
+  const std::vector<StdComplex> w = testValues<StdComplex>(size, 2);
+  std::vector<StdComplex> acc(size);
+  for (auto _ : state) {
+    for (std::size_t n = 0; n < size; ++n) {
+      acc[n] += QUANTIZATION_SCALE * StdComplex(q[n].real(), q[n].imag()) * w[n];
+    }
+    benchmark::DoNotOptimize(acc.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// acc += dequantized samples * w by the fused SIMD kernel
+void quantizedMultiplyAccumulateBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const BasicQuantizedArray<int16_t, double> q(testArray(size, 1), QUANTIZATION_SCALE);
+  const ComplexArrayD w = testArray(size, 2);
+  ComplexArrayD acc(static_cast<Math::size_t>(size));
+  for (auto _ : state) {
+    q.multiplyAccumulate(w, acc);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// exp of a large array by the SIMD kernel on the calling thread, the baseline of the parallel transform
+void serialExpBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const ComplexArrayD z = testArray(size, 1);
+  ComplexArrayD out(static_cast<Math::size_t>(size));
+  for (auto _ : state) {
+    exp<double>(z, out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// exp of a large array by the SIMD kernel on all threads of the default pool
+void parallelExpBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const ComplexArrayD z = testArray(size, 1);
+  ComplexArrayD out(static_cast<Math::size_t>(size));
+  for (auto _ : state) {
+    parallelTransform<double>(z, out, [](const auto in, const auto result) { exp<double>(in, result); });
+    benchmark::ClobberMemory();
+  }
+  state.counters["threads"] = static_cast<double>(defaultThreadPool().threadCount());
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Reduction of std::complex vectors by a loop, op(x, y) returns the result
+template <typename Op>
+void stdReductionBenchmark(benchmark::State& state, const Op& op) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const std::vector<StdComplex> x = testValues<StdComplex>(size, 1);
+  const std::vector<StdComplex> y = testValues<StdComplex>(size, 2);
+  for (auto _ : state) benchmark::DoNotOptimize(op(x, y));
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// Reduction of split arrays of T by the compensated SIMD kernels, op(x, y) returns the result
+template <typename Op, scalar T = double>
+void reductionBenchmark(benchmark::State& state, const Op& op) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const BasicComplexArray<T> x = testArray<T>(size, 1);
+  const BasicComplexArray<T> y = testArray<T>(size, 2);
+  for (auto _ : state) benchmark::DoNotOptimize(op(x, y));
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// In-place forward FFT of interleaved numbers of T with a cached plan, butterflies accumulate in accumulator_t<T>
+template <scalar T = double>
+void fftBenchmark(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto plan = fftPlan<T>(static_cast<Math::size_t>(size), FftDirection::Forward);
+  AlignedVector<BasicComplex<T>> data(size);
+  const BasicComplexArray<T> z = testArray<T>(size, 1);
+  for (std::size_t i = 0; i < size; ++i) data[i] = z[i];
+  for (auto _ : state) {
+    plan->execute(data);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// FIR filter of a stream by a loop over std::complex that keeps the last taps - 1 samples before the block
+void stdFirBenchmark(benchmark::State& state) {
+  const auto m = static_cast<std::size_t>(state.range(0));
+  const std::vector<StdComplex> taps = testValues<StdComplex>(m, 1);
+  std::vector<StdComplex> buffer(m - 1 + FIR_BLOCK);
+  const std::vector<StdComplex> x = testValues<StdComplex>(FIR_BLOCK, 2);
+  std::vector<StdComplex> y(FIR_BLOCK);
+  for (auto _ : state) {
+    std::copy(buffer.end() - static_cast<std::ptrdiff_t>(m - 1), buffer.end(), buffer.begin());
+    std::copy(x.begin(), x.end(), buffer.begin() + static_cast<std::ptrdiff_t>(m - 1));
+    for (std::size_t n = 0; n < FIR_BLOCK; ++n) {
+      StdComplex s;
+      for (std::size_t k = 0; k < m; ++k) s += taps[k] * buffer[n + m - 1 - k];
+      y[n] = s;
+    }
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FIR_BLOCK));
+}
+
+/// FIR filter of a stream by BasicFirFilter with the given method
+void firBenchmark(benchmark::State& state, const FirMethod method) {
+  const auto m = static_cast<std::size_t>(state.range(0));
+  BasicFirFilter<double> filter(testArray(m, 1), method);
+  const ComplexArrayD x = testArray(FIR_BLOCK, 2);
+  ComplexArrayD y(static_cast<Math::size_t>(FIR_BLOCK));
+  for (auto _ : state) {
+    filter.filter(x, y);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FIR_BLOCK));
+}
+
+/// Sliding DFT on std::complex, one sample after the other through all bins
+void stdSlidingDftBenchmark(benchmark::State& state) {
+  const auto bins = static_cast<std::size_t>(state.range(0));
+  std::vector<StdComplex> twiddles(bins);
+  for (std::size_t k = 0; k < bins; ++k) {
+    twiddles[k] = std::polar(1.0, 2 * std::numbers::pi * static_cast<double>(k) / SPECTRAL_WINDOW);
+  }
+  std::vector<StdComplex> spectrum(bins);
+  std::vector<StdComplex> window(SPECTRAL_WINDOW);
+  std::size_t position = 0;
+  const std::vector<StdComplex> x = testValues<StdComplex>(FIR_BLOCK, 1);
+  for (auto _ : state) {
+    for (const StdComplex& sample : x) {
+      const StdComplex delta = sample - window[position];
+      window[position] = sample;
+      position = position + 1 == SPECTRAL_WINDOW ? 0 : position + 1;
+      for (std::size_t k = 0; k < bins; ++k) spectrum[k] = (spectrum[k] + delta) * twiddles[k];
+    }
+    benchmark::DoNotOptimize(spectrum.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FIR_BLOCK));
+}
+
+/// Sliding DFT by the SIMD kernel, bins in registers through blocks of samples
+void slidingDftBenchmark(benchmark::State& state) {
+  const auto bins = static_cast<std::size_t>(state.range(0));
+  std::vector<Math::size_t> indices(bins);
+  for (std::size_t k = 0; k < bins; ++k) indices[k] = static_cast<Math::size_t>(k);
+  BasicSlidingDft<double> sdft(SPECTRAL_WINDOW, indices);
+  const ComplexArrayD x = testArray(FIR_BLOCK, 1);
+  for (auto _ : state) {
+    sdft.update(x);
+    benchmark::DoNotOptimize(sdft.spectrum().realData());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FIR_BLOCK));
+}
+
+/// Goertzel detectors on std::complex, one sample after the other through all frequencies
+void stdGoertzelBenchmark(benchmark::State& state) {
+  const auto bins = static_cast<std::size_t>(state.range(0));
+  std::vector<double> coefficients(bins);
+  for (std::size_t k = 0; k < bins; ++k) coefficients[k] = 2 * std::cos(0.01 + 0.02 * static_cast<double>(k));
+  std::vector<StdComplex> s1(bins);
+  std::vector<StdComplex> s2(bins);
+  const std::vector<StdComplex> x = testValues<StdComplex>(FIR_BLOCK, 1);
+  for (auto _ : state) {
+    for (const StdComplex& sample : x) {
+      for (std::size_t k = 0; k < bins; ++k) {
+        const StdComplex s = sample + coefficients[k] * s1[k] - s2[k];
+        s2[k] = s1[k];
+        s1[k] = s;
+      }
+    }
+    benchmark::DoNotOptimize(s1.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FIR_BLOCK));
+}
+
+/// Goertzel detectors by the SIMD kernel, blocks of SPECTRAL_WINDOW samples
+void goertzelBenchmark(benchmark::State& state) {
+  const auto bins = static_cast<std::size_t>(state.range(0));
+  std::vector<double> frequencies(bins);
+  for (std::size_t k = 0; k < bins; ++k) frequencies[k] = 0.01 + 0.02 * static_cast<double>(k);
+  BasicGoertzelBank<double> bank(frequencies, SPECTRAL_WINDOW);
+  const ComplexArrayD x = testArray(FIR_BLOCK, 1);
+  ComplexArrayD out(static_cast<Math::size_t>(bank.outputSize(FIR_BLOCK)));
+  for (auto _ : state) {
+    bank.process(x, out);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FIR_BLOCK));
+}
+
+/// @return Column-major n x n matrix of testValues rounded to T, which is nonsingular in practice
+template <scalar T = double>
+BasicComplexMatrix<T> testMatrix(const std::size_t n) {
+  BasicComplexMatrix<T> a(static_cast<Math::size_t>(n), static_cast<Math::size_t>(n), MatrixLayout::ColumnMajor);
+  const std::vector<ComplexD> values = testValues<ComplexD>(n * n, 1);
+  std::transform(values.begin(), values.end(), a.data(), [](const ComplexD& z) {
+    return BasicComplex<T>(static_cast<T>(z.real()), static_cast<T>(z.imag()));
+  });
+  return a;
+}
+
+/// Unblocked right-looking LU factorization with partial pivoting on a column-major vector of std::complex, one rank-1
+/// update of the trailing matrix per column
+void stdLuBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const BasicComplexMatrix<double> matrix = testMatrix(n);
+  std::vector<StdComplex> a(n * n);
+  for (auto _ : state) {
+    std::transform(matrix.data(), matrix.data() + n * n, a.begin(),
+                   [](const auto& z) { return StdComplex(z.real(), z.imag()); });
+    for (std::size_t j = 0; j < n; ++j) {
+      std::size_t pivot = j;
+      for (std::size_t i = j + 1; i < n; ++i) {
+        if (std::abs(a[j * n + i]) > std::abs(a[j * n + pivot])) pivot = i;
+      }
+      for (std::size_t c = 0; c < n; ++c) std::swap(a[c * n + j], a[c * n + pivot]);
+      for (std::size_t i = j + 1; i < n; ++i) a[j * n + i] /= a[j * n + j];
+      for (std::size_t c = j + 1; c < n; ++c) {
+        const StdComplex u = a[c * n + j];
+        for (std::size_t i = j + 1; i < n; ++i) a[c * n + i] -= a[j * n + i] * u;
+      }
+    }
+    benchmark::DoNotOptimize(a.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n));
+}
+
+/// Blocked LU factorization, the trailing updates by the matrix product on the default pool
+template <scalar T = double>
+void luBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const BasicComplexMatrix<T> a = testMatrix<T>(n);
+  for (auto _ : state) {
+    BasicLuDecomposition<T> lu(a);
+    benchmark::DoNotOptimize(lu.factors().data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n));
+}
+
+/// Blocked Householder QR factorization
+void qrBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const BasicComplexMatrix<double> a = testMatrix(n);
+  for (auto _ : state) {
+    BasicQrDecomposition<double> qr(a);
+    benchmark::DoNotOptimize(qr.factors().data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n));
+}
+
+/// @return EIGEN_BATCH column-major n x n matrices of testValues
+std::vector<BasicComplexMatrix<double>> eigenBatch(const std::size_t n) {
+  std::vector<BasicComplexMatrix<double>> matrices;
+  const std::vector<ComplexD> values = testValues<ComplexD>(EIGEN_BATCH * n * n, 2);
+  for (std::size_t i = 0; i < EIGEN_BATCH; ++i) {
+    matrices.emplace_back(static_cast<Math::size_t>(n), static_cast<Math::size_t>(n), MatrixLayout::ColumnMajor);
+    std::copy_n(values.begin() + static_cast<std::ptrdiff_t>(i * n * n), n * n, matrices.back().data());
+  }
+  return matrices;
+}
+
+/// Eigenvalues and eigenvectors of a batch of small matrices one after the other, a new solver per matrix
+void stdEigenBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const std::vector<BasicComplexMatrix<double>> matrices = eigenBatch(n);
+  for (auto _ : state) {
+    for (const BasicComplexMatrix<double>& matrix : matrices) {
+      BasicEigenSolver<double> solver(static_cast<Math::size_t>(n));
+      solver.compute(matrix);
+      benchmark::DoNotOptimize(solver.eigenvectors().data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(EIGEN_BATCH));
+}
+
+/// Eigenvalues and eigenvectors of a batch of small matrices by the batched solver on the default pool
+void eigenBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const std::vector<BasicComplexMatrix<double>> matrices = eigenBatch(n);
+  std::vector<ComplexMatrixView<const double>> views(matrices.begin(), matrices.end());
+  const auto order = static_cast<Math::size_t>(n);
+  std::vector<BasicComplexMatrix<double>> vectors(EIGEN_BATCH, BasicComplexMatrix<double>(order, order));
+  std::vector<ComplexMatrixView<double>> vectorViews(vectors.begin(), vectors.end());
+  std::vector<ComplexD> eigenvalues(EIGEN_BATCH * n);
+  BasicBatchedEigenSolver<double> solver(order);
+  for (auto _ : state) {
+    solver.compute(views, eigenvalues, vectorViews);
+    benchmark::DoNotOptimize(eigenvalues.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(EIGEN_BATCH));
+}
+
+/// Eigenvalues and eigenvectors of one matrix, blocked Hessenberg reduction and QR with aggressive early deflation
+void eigenMatrixBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const BasicComplexMatrix<double> a = testMatrix(n);
+  BasicEigenSolver<double> solver(static_cast<Math::size_t>(n));
+  for (auto _ : state) {
+    solver.compute(a);
+    benchmark::DoNotOptimize(solver.eigenvectors().data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n));
+}
+
+/// @return Square matrix of SPARSE_ROW_ELEMENTS testValues per row in a band around the diagonal, in groups of 4 x 4
+/// blocks so that the BSR benchmarks store no padding, plus a diagonal that makes it dominant for the solvers
+std::vector<SparseEntry<double>> sparseEntries(const std::size_t n) {
+  constexpr std::size_t BLOCK = 4;
+  constexpr std::size_t BAND = 500;
+  std::mt19937 generator(3);
+  const std::vector<ComplexD> values = testValues<ComplexD>(n * SPARSE_ROW_ELEMENTS, 4);
+  std::vector<SparseEntry<double>> entries;
+  auto value = values.begin();
+  for (std::size_t r = 0; r < n / BLOCK; ++r) {
+    for (std::size_t k = 0; k < SPARSE_ROW_ELEMENTS / BLOCK; ++k) {
+      const std::size_t c = (r + generator() % BAND) % (n / BLOCK);
+      for (std::size_t i = 0; i < BLOCK; ++i) {
+        for (std::size_t j = 0; j < BLOCK; ++j) {
+          entries.push_back({static_cast<Math::size_t>(r * BLOCK + i), static_cast<Math::size_t>(c * BLOCK + j),
+                             *value++});
+        }
+      }
+    }
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    entries.push_back({static_cast<Math::size_t>(i), static_cast<Math::size_t>(i), {4.0 * SPARSE_ROW_ELEMENTS, 0}});
+  }
+  return entries;
+}
+
+BasicCsrMatrix<double> sparseMatrix(const std::size_t n) {
+  const auto order = static_cast<Math::size_t>(n);
+  return {order, order, sparseEntries(n)};
+}
+
+/// Product of a CSR matrix and a vector of std::complex, one row after the other
+void stdSparseBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const BasicCsrMatrix<double> a = sparseMatrix(n);
+  const std::span<const Math::size_t> offsets = a.offsets();
+  const std::span<const Math::size_t> indices = a.indices();
+  std::vector<StdComplex> values(a.nonZeros());
+  for (std::size_t k = 0; k < values.size(); ++k) values[k] = {a.values().realData()[k], a.values().imagData()[k]};
+  const std::vector<StdComplex> x = testValues<StdComplex>(n, 5);
+  std::vector<StdComplex> y(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      StdComplex sum;
+      for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) sum += values[k] * x[indices[k]];
+      y[i] = sum;
+    }
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(a.nonZeros()));
+}
+
+/// Product of a sparse matrix and a vector on the default pool, by format and operation, BSR with 4 x 4 blocks
+template <typename Matrix>
+void sparseBenchmark(benchmark::State& state, const SparseOperation operation) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const Matrix a = [&] {
+    if constexpr (std::is_same_v<Matrix, BasicBsrMatrix<double>>) {
+      return Matrix(sparseMatrix(n), 4);
+    } else {
+      return sparseMatrix(n);
+    }
+  }();
+  const ComplexArrayD x = testArray(n, 5);
+  ComplexArrayD y(static_cast<Math::size_t>(n));
+  for (auto _ : state) {
+    a.multiply(x, y, operation);
+    benchmark::DoNotOptimize(y.real().data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(a.nonZeros()));
+}
+
+/// Solution of a sparse system to a relative residual of 1e-10 on the default pool, items are the products
+template <bool RESTARTED>
+void sparseSolverBenchmark(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const BasicCsrMatrix<double> a = sparseMatrix(n);
+  const ComplexArrayD b = testArray(n, 6);
+  ComplexArrayD x(static_cast<Math::size_t>(n));
+  int64_t products = 0;
+  for (auto _ : state) {
+    std::ranges::fill(x.real(), 0.0);
+    std::ranges::fill(x.imag(), 0.0);
+    const SolverStatus status = RESTARTED ? gmres(a, b, x, 1e-10, 1000) : bicgstab(a, b, x, 1e-10, 1000);
+    products += RESTARTED ? status.iterations : 2 * status.iterations;
+    benchmark::DoNotOptimize(x.real().data());
+  }
+  state.SetItemsProcessed(products);
+}
+
+/// Registers Array/Reduction/<name>, the loop on std::complex, Batched/Reduction/<name> and
+/// Float/Batched/Reduction/<name> on float arrays
+/// @param name Name of the reduction
+/// @param mathOp Reduction of two BasicComplexArrays of double or float
+/// @param stdOp Reduction of two vectors of std::complex<double>
+template <typename MathOp, typename StdOp>
+void registerReduction(const std::string& name, const MathOp& mathOp, const StdOp& stdOp) {
+  benchmark::RegisterBenchmark(("Array/Reduction/" + name).c_str(), stdReductionBenchmark<StdOp>, stdOp)
+      ->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark(("Batched/Reduction/" + name).c_str(), reductionBenchmark<MathOp>, mathOp)
+      ->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark(("Float/Batched/Reduction/" + name).c_str(), reductionBenchmark<MathOp, float>, mathOp)
+      ->ArgsProduct({SIZES});
+}
+
+/// Registers the benchmarks of every operator and free function of Complex.h and of the batched modules, each next to
+/// its std::complex baseline
+void registerBenchmarks() {
+  using enum Operands;
+
+  // Parts, magnitude and phase
+  registerOperation<Complex>("Real", [](const auto& z) { return real(z); });
+  registerOperation<Complex>("Imag", [](const auto& z) { return imag(z); });
+  registerOperation<Complex>("Abs2", [](const auto& z) { return abs2(z); }, [](const auto& z) { return norm(z); });
+  registerOperation<Complex>("Abs", [](const auto& z) { return abs(z); });
+  registerOperation<Complex>("Arg", [](const auto& z) { return arg(z); });
+  registerOperation<Complex>("Conj", [](const auto& z) { return conj(z); });
+
+  // Arithmetic operators
+  registerOperation<Complex, Modes::ScalarAndArray>("Plus", [](const auto& z) { return +z; });
+  registerOperation<Complex>("Negate", [](const auto& z) { return -z; });
+  registerOperation<ComplexComplex>("Add", [](const auto& z, const auto& w) { return z + w; });
+  registerOperation<ComplexComplex>("Subtract", [](const auto& z, const auto& w) { return z - w; });
+  registerOperation<ComplexComplex>("Multiply", [](const auto& z, const auto& w) { return z * w; });
+  registerOperation<ComplexComplex>("Divide", [](const auto& z, const auto& w) { return z / w; });
+  registerOperation<ComplexReal>("AddReal", [](const auto& z, const auto& x) { return z + x; });
+  registerOperation<ComplexReal>("SubtractReal", [](const auto& z, const auto& x) { return z - x; });
+  registerOperation<ComplexReal>("MultiplyReal", [](const auto& z, const auto& x) { return z * x; });
+  registerOperation<ComplexReal>("DivideReal", [](const auto& z, const auto& x) { return z / x; });
+  registerOperation<RealComplex>("RealAdd", [](const auto& x, const auto& z) { return x + z; });
+  registerOperation<RealComplex>("RealSubtract", [](const auto& x, const auto& z) { return x - z; });
+  registerOperation<RealComplex>("RealMultiply", [](const auto& x, const auto& z) { return x * z; });
+  registerOperation<RealComplex>("RealDivide", [](const auto& x, const auto& z) { return x / z; });
+
+  // Compound assignment, on a copy so that the values do not drift over the iterations
+  constexpr auto SCALAR_AND_ARRAY = Modes::ScalarAndArray;
+  registerOperation<ComplexComplex, SCALAR_AND_ARRAY>("AddAssign", [](auto z, const auto& w) { return z += w; });
+  registerOperation<ComplexComplex, SCALAR_AND_ARRAY>("SubtractAssign", [](auto z, const auto& w) { return z -= w; });
+  registerOperation<ComplexComplex, SCALAR_AND_ARRAY>("MultiplyAssign", [](auto z, const auto& w) { return z *= w; });
+  registerOperation<ComplexComplex, SCALAR_AND_ARRAY>("DivideAssign", [](auto z, const auto& w) { return z /= w; });
+  registerOperation<ComplexReal, SCALAR_AND_ARRAY>("AddAssignReal", [](auto z, const auto& x) { return z += x; });
+  registerOperation<ComplexReal, SCALAR_AND_ARRAY>("SubtractAssignReal", [](auto z, const auto& x) { return z -= x; });
+  registerOperation<ComplexReal, SCALAR_AND_ARRAY>("MultiplyAssignReal", [](auto z, const auto& x) { return z *= x; });
+  registerOperation<ComplexReal, SCALAR_AND_ARRAY>("DivideAssignReal", [](auto z, const auto& x) { return z /= x; });
+
+  // Transcendental functions
+  registerOperation<Complex>("Exp", [](const auto& z) { return exp(z); });
+  registerOperation<Complex>("Log", [](const auto& z) { return log(z); });
+  registerOperation<Complex>("Sin", [](const auto& z) { return sin(z); });
+  registerOperation<Complex>("Cos", [](const auto& z) { return cos(z); });
+  registerOperation<Complex>("Tan", [](const auto& z) { return tan(z); });
+  registerOperation<Complex>("Sqrt", [](const auto& z) { return sqrt(z); });
+  registerOperation<Complex>("Asin", [](const auto& z) { return asin(z); });
+  registerOperation<Complex>("Acos", [](const auto& z) { return acos(z); });
+  registerOperation<Complex>("Atan", [](const auto& z) { return atan(z); });
+  registerOperation<ComplexReal>("PowReal", [](const auto& z, const auto& x) { return pow(z, x); });
+  registerOperation<ComplexComplex>("Pow", [](const auto& z, const auto& w) { return pow(z, w); });
+  registerOperation<Complex, SCALAR_AND_ARRAY>("PowInt", [](const auto& z) { return pow(z, 7); });
+
+  // Phasor generation, the oscillator against one exp per sample
+  benchmark::RegisterBenchmark("Array/Phasors/Exp", expPhasorBenchmark)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Batched/Phasors/Oscillator", oscillatorBenchmark)->ArgsProduct({SIZES});
+
+  // Polynomial evaluation, the kernel against Horner's scheme on std::complex
+  benchmark::RegisterBenchmark("Array/Polynomial/Horner", stdPolynomialBenchmark)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Batched/Polynomial/Horner", polynomialBenchmark)->ArgsProduct({SIZES});
+
+  // Text conversion, print() writes to the standard output and is represented by Stream. The bulk writer and parser
+  // run against operator<< and operator>> on std::complex at round-trip precision.
+  const auto stream = [](const auto& z) {
+    std::ostringstream os;
+    os << z;
+    return os.str();
+  };
+  registerOperation<Complex, Modes::Scalar>("Stream", stream);
+  registerOperation<Complex, Modes::Scalar>("ToString", [](const auto& z) { return to_string(z); }, stream);
+  benchmark::RegisterBenchmark("Array/Text/Stream", stdStreamArrayBenchmark)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Batched/Text/ToChars", formatArrayBenchmark)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Array/Text/Parse", stdParseArrayBenchmark)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Batched/Text/FromChars", parseArrayBenchmark)->ArgsProduct({SIZES});
+
+  // Parallel transform on the default pool against the kernel on one thread
+  benchmark::RegisterBenchmark("Array/ParallelExp", serialExpBenchmark)->ArgsProduct({PARALLEL_SIZES});
+  benchmark::RegisterBenchmark("Batched/ParallelExp", parallelExpBenchmark)->ArgsProduct({PARALLEL_SIZES});
+
+  // Quantized samples, the int16 kernels against loops over std::complex<int16_t>
+  benchmark::RegisterBenchmark("Array/Quantized/Dequantize", stdDequantizeBenchmark)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Batched/Quantized/Dequantize", dequantizeBenchmark)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Array/Quantized/MultiplyAccumulate", stdQuantizedMultiplyAccumulateBenchmark)
+      ->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Batched/Quantized/MultiplyAccumulate", quantizedMultiplyAccumulateBenchmark)
+      ->ArgsProduct({SIZES});
+
+  // Reductions, the compensated kernels against plain loops over std::complex
+  using StdVector = std::vector<StdComplex>;
+  registerReduction(
+      "Sum", []<typename T>(const BasicComplexArray<T>& x, const BasicComplexArray<T>&) { return sum<T>(x); },
+      [](const StdVector& x, const StdVector&) {
+        StdComplex s;
+        for (const StdComplex& z : x) s += z;
+        return s;
+      });
+  registerReduction(
+      "Dotc", []<typename T>(const BasicComplexArray<T>& x, const BasicComplexArray<T>& y) { return dotc<T>(x, y); },
+      [](const StdVector& x, const StdVector& y) {
+        StdComplex s;
+        for (std::size_t i = 0; i < x.size(); ++i) s += std::conj(x[i]) * y[i];
+        return s;
+      });
+  registerReduction(
+      "SquaredNorm",
+      []<typename T>(const BasicComplexArray<T>& x, const BasicComplexArray<T>&) { return squaredNorm<T>(x); },
+      [](const StdVector& x, const StdVector&) {
+        double s = 0;
+        for (const StdComplex& z : x) s += std::norm(z);
+        return s;
+      });
+  registerReduction(
+      "MaxAbsIndex",
+      []<typename T>(const BasicComplexArray<T>& x, const BasicComplexArray<T>&) { return maxAbsIndex<T>(x); },
+      [](const StdVector& x, const StdVector&) {
+        std::size_t index = 0;
+        for (std::size_t i = 1; i < x.size(); ++i) {
+          if (std::norm(x[i]) > std::norm(x[index])) index = i;
+        }
+        return index;
+      });
+
+  // FFT, the float plans accumulate in double in mixed precision
+  benchmark::RegisterBenchmark("Batched/Fft", fftBenchmark<>)->ArgsProduct({SIZES});
+  benchmark::RegisterBenchmark("Float/Batched/Fft", fftBenchmark<float>)->ArgsProduct({SIZES});
+
+  // FIR filters, direct form and overlap-save of the streaming filter against a loop over std::complex, by taps
+  benchmark::RegisterBenchmark("Array/Fir", stdFirBenchmark)->ArgsProduct({FIR_TAPS});
+  benchmark::RegisterBenchmark("Batched/Fir/Direct", firBenchmark, FirMethod::Direct)->ArgsProduct({FIR_TAPS});
+  benchmark::RegisterBenchmark("Batched/Fir/OverlapSave", firBenchmark, FirMethod::OverlapSave)
+      ->ArgsProduct({FIR_TAPS});
+
+  // Spectral monitoring, the sliding DFT and Goertzel kernels against per-sample loops over std::complex, by bins
+  benchmark::RegisterBenchmark("Array/Spectral/SlidingDft", stdSlidingDftBenchmark)->ArgsProduct({SPECTRAL_BINS});
+  benchmark::RegisterBenchmark("Batched/Spectral/SlidingDft", slidingDftBenchmark)->ArgsProduct({SPECTRAL_BINS});
+  benchmark::RegisterBenchmark("Array/Spectral/Goertzel", stdGoertzelBenchmark)->ArgsProduct({SPECTRAL_BINS});
+  benchmark::RegisterBenchmark("Batched/Spectral/Goertzel", goertzelBenchmark)->ArgsProduct({SPECTRAL_BINS});
+
+  // Dense factorizations, blocked LU and QR against an unblocked LU over std::complex, by order
+  benchmark::RegisterBenchmark("Array/Decomposition/Lu", stdLuBenchmark)->ArgsProduct({MATRIX_ORDERS});
+  benchmark::RegisterBenchmark("Batched/Decomposition/Lu", luBenchmark<>)->ArgsProduct({MATRIX_ORDERS});
+  benchmark::RegisterBenchmark("Float/Batched/Decomposition/Lu", luBenchmark<float>)->ArgsProduct({MATRIX_ORDERS});
+  benchmark::RegisterBenchmark("Batched/Decomposition/Qr", qrBenchmark)->ArgsProduct({MATRIX_ORDERS});
+
+  // Eigen solver, batches of small matrices against a solver per matrix on one thread, by order, and single larger
+  // matrices
+  benchmark::RegisterBenchmark("Array/Eigen/Batch", stdEigenBenchmark)->ArgsProduct({EIGEN_ORDERS});
+  benchmark::RegisterBenchmark("Batched/Eigen/Batch", eigenBenchmark)->ArgsProduct({EIGEN_ORDERS});
+  benchmark::RegisterBenchmark("Batched/Eigen/Matrix", eigenMatrixBenchmark)->Arg(64)->Arg(256);
+
+  // Sparse CSR, adjoint and 4 x 4 BSR products on the default pool against a loop over std::complex on one thread,
+  // items are the stored elements, and the GMRES and BiCGSTAB solvers
+  benchmark::RegisterBenchmark("Array/Sparse/Multiply", stdSparseBenchmark)->ArgsProduct({SPARSE_ROWS});
+  benchmark::RegisterBenchmark("Batched/Sparse/Multiply", sparseBenchmark<BasicCsrMatrix<double>>,
+                               SparseOperation::None)
+      ->ArgsProduct({SPARSE_ROWS});
+  benchmark::RegisterBenchmark("Batched/Sparse/Adjoint", sparseBenchmark<BasicCsrMatrix<double>>,
+                               SparseOperation::Adjoint)
+      ->ArgsProduct({SPARSE_ROWS});
+  benchmark::RegisterBenchmark("Batched/Sparse/Bsr", sparseBenchmark<BasicBsrMatrix<double>>, SparseOperation::None)
+      ->ArgsProduct({SPARSE_ROWS});
+  benchmark::RegisterBenchmark("Batched/Sparse/Gmres", sparseSolverBenchmark<true>)->ArgsProduct({SPARSE_ROWS});
+  benchmark::RegisterBenchmark("Batched/Sparse/Bicgstab", sparseSolverBenchmark<false>)->ArgsProduct({SPARSE_ROWS});
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  registerBenchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
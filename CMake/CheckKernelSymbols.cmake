@@ -0,0 +1,35 @@
+# Fails if a per-ISA kernel object of a static library defines a weak symbol outside its own inline namespace, e.g. a
+# copy of std::fma(float, float, float) compiled for AVX-512 that the linker could keep for the whole program. Only
+# unoptimized builds emit such copies, the check passes trivially otherwise.
+# Usage: cmake -DNM=<nm> -DLIBRARY=<static library> -P CheckKernelSymbols.cmake
+execute_process(COMMAND ${NM} -C --defined-only ${LIBRARY} OUTPUT_VARIABLE SYMBOLS RESULT_VARIABLE RESULT)
+if(NOT RESULT EQUAL 0)
+  message(FATAL_ERROR "${NM} failed on ${LIBRARY}")
+endif()
+
+# Brackets and semicolons of demangled names would break the list
+string(REPLACE "[" "(" SYMBOLS "${SYMBOLS}")
+string(REPLACE "]" ")" SYMBOLS "${SYMBOLS}")
+string(REPLACE ";" "," SYMBOLS "${SYMBOLS}")
+string(REPLACE "\n" ";" LINES "${SYMBOLS}")
+
+set(ISA "")
+set(LEAKED "")
+foreach(LINE IN LISTS LINES)
+  if(LINE MATCHES ":$")
+    # Archive member, the instruction set is the suffix of the kernel source
+    set(ISA "")
+    if(LINE MATCHES "(Avx2|Avx512)\\.cpp\\.o(bj)?:$")
+      set(ISA ${CMAKE_MATCH_1})
+    endif()
+  elseif(ISA AND LINE MATCHES " [VWu] (.*)$")
+    set(SYMBOL "${CMAKE_MATCH_1}")
+    if(NOT SYMBOL MATCHES "::${ISA}::" AND NOT SYMBOL MATCHES "^DW\\.ref\\.")
+      string(APPEND LEAKED "\n  ${ISA}: ${SYMBOL}")
+    endif()
+  endif()
+endforeach()
+
+if(LEAKED)
+  message(FATAL_ERROR "Weak symbols outside the kernel namespaces:${LEAKED}")
+endif()
@@ -0,0 +1,39 @@
+set(SIMD_MODULE_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+# Per-ISA kernel translation units: sources ending in Avx2.cpp or Avx512.cpp are compiled with the matching
+# instruction set flags, the rest of the target keeps the baseline flags. The kernels are selected at runtime.
+function(target_simd_kernels target)
+  if(NOT CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|x64)$")
+    return()
+  endif()
+
+  if(MSVC)
+    set(AVX2_FLAGS /arch:AVX2)
+    set(AVX512_FLAGS /arch:AVX512)
+  else()
+    set(AVX2_FLAGS -mavx2 -mfma)
+    set(AVX512_FLAGS -mavx512f -mfma)
+  endif()
+
+  get_target_property(SOURCES ${target} SOURCES)
+  foreach(SOURCE IN LISTS SOURCES)
+    if(SOURCE MATCHES "Avx512\\.cpp$")
+      set_source_files_properties(${SOURCE} PROPERTIES COMPILE_OPTIONS "${AVX512_FLAGS}")
+    elseif(SOURCE MATCHES "Avx2\\.cpp$")
+      set_source_files_properties(${SOURCE} PROPERTIES COMPILE_OPTIONS "${AVX2_FLAGS}")
+    endif()
+  endforeach()
+  target_compile_definitions(${target} PRIVATE MATH_SIMD_X86)
+endfunction()
+
+# Registers a test that the per-ISA objects of a static library share no inline functions with the rest of the
+# program, see CheckKernelSymbols.cmake
+function(add_simd_symbols_test target)
+  get_target_property(TYPE ${target} TYPE)
+  if(NOT CMAKE_NM OR MSVC OR NOT TYPE STREQUAL "STATIC_LIBRARY")
+    return()
+  endif()
+  add_test(NAME ${target}KernelSymbols
+           COMMAND ${CMAKE_COMMAND} -DNM=${CMAKE_NM} -DLIBRARY=$<TARGET_FILE:${target}>
+                   -P ${SIMD_MODULE_DIR}/CheckKernelSymbols.cmake)
+endfunction()
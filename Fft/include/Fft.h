@@ -0,0 +1,141 @@
+#ifndef MATH_FFT_H
+#define MATH_FFT_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Sign of the exponent of a discrete Fourier transform
+enum class FftDirection : uint8_t {
+  Forward,  ///< X[k] = sum x[j] e^(-2 pi i jk / n)
+  Inverse   ///< x[j] = 1/n sum X[k] e^(2 pi i jk / n)
+};
+
+/// Precomputed discrete Fourier transform of a fixed size and direction. Sizes whose prime factors are small use a
+/// mixed-radix Stockham (self-sorting Cooley-Tukey) algorithm with radix 2, 3, 4 and 5 butterflies and a generic
+/// odd radix; sizes with large prime factors are reduced to a convolution of 5-smooth size (Bluestein). All twiddle
+/// factors are computed once in the constructor. A plan is immutable after construction and can be executed from
+/// several threads at the same time. In mixed precision, a float plan transforms double copies of the data with a
+/// double plan, so that the butterflies accumulate in double.
+template <scalar T>
+class BasicFftPlan {
+public:
+  using value_type = BasicComplex<T>;
+
+protected:
+  /// Butterfly pass of the Stockham algorithm, twiddles[(u - 1) * stride + i] = w^(u i) for the outputs u > 0
+  struct Pass {
+    size_t radix;
+    size_t stride;
+    size_t twiddleOffset;
+  };
+
+  size_t m_Size;
+  FftDirection m_Direction;
+  T m_Scale;
+  std::vector<Pass> m_Passes;
+  AlignedVector<value_type> m_Twiddles;
+  /// Roots of unity for the generic radix butterflies, m_Roots[offset + k] = e^(+-2 pi i k / radix)
+  AlignedVector<value_type> m_Roots;
+  /// Bluestein: chirp e^(-+pi i k^2 / n), spectrum of the conjugate chirp and the forward plan of the convolution
+  AlignedVector<value_type> m_Chirp;
+  AlignedVector<value_type> m_ChirpSpectrum;
+  std::unique_ptr<BasicFftPlan> m_Convolution;
+  /// Mixed precision: plan of the accumulator type that computes the transform
+  std::unique_ptr<BasicFftPlan<accumulator_t<T>>> m_Widened;
+
+  void transform(const value_type* in, value_type* out, value_type* workspace) const;
+  void stockham(const value_type* in, value_type* out, value_type* workspace) const;
+  void bluestein(const value_type* in, value_type* out, value_type* workspace) const;
+  void widened(const value_type* in, value_type* out, value_type* workspace) const;
+
+public:
+  /// Creates a plan
+  /// @param size Transform length, between 1 and MAX_ELEMENT_COUNT
+  /// @param direction Forward or inverse transform, the inverse is scaled by 1/size
+  BasicFftPlan(size_t size, FftDirection direction);
+
+  BasicFftPlan(const BasicFftPlan&) = delete;
+  BasicFftPlan& operator=(const BasicFftPlan&) = delete;
+  BasicFftPlan(BasicFftPlan&&) noexcept = default;
+  BasicFftPlan& operator=(BasicFftPlan&&) noexcept = default;
+  ~BasicFftPlan() = default;
+
+  [[nodiscard]] size_t size() const { return m_Size; }
+  [[nodiscard]] FftDirection direction() const { return m_Direction; }
+  /// @return True if the size is reduced to a convolution (Bluestein)
+  [[nodiscard]] bool usesBluestein() const {
+    return m_Convolution != nullptr || (m_Widened != nullptr && m_Widened->usesBluestein());
+  }
+  /// @return Number of complex numbers that execute needs as scratch memory
+  [[nodiscard]] std::size_t workspaceSize() const;
+
+  /// Transforms out of place or in place (in and out may be the same span), using a thread local workspace
+  /// @param in Input of length size()
+  /// @param out Output of length size()
+  void execute(std::span<const value_type> in, std::span<value_type> out) const;
+
+  /// Transforms in place
+  /// @param data Input and output of length size()
+  void execute(std::span<value_type> data) const;
+
+  /// Transforms with caller provided scratch memory
+  /// @param in Input of length size()
+  /// @param out Output of length size()
+  /// @param workspace Scratch memory of at least workspaceSize() elements
+  void execute(std::span<const value_type> in, std::span<value_type> out, std::span<value_type> workspace) const;
+};
+
+using FftPlan = BasicFftPlan<real_t>;
+
+/// Get a plan from the process wide cache, keyed by size and direction. The plan is created on first use.
+/// @param size Transform length
+/// @param direction Forward or inverse transform
+/// @return Shared plan
+template <scalar T = real_t>
+std::shared_ptr<const BasicFftPlan<T>> fftPlan(size_t size, FftDirection direction);
+
+/// Removes all complex and real plans from the caches. Plans that are still referenced stay valid.
+void clearFftPlanCache();
+
+/// Computes the forward transform with a cached plan
+/// @param in Input
+/// @param out Output of the same size, may be the same span as the input
+template <scalar T>
+void fft(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<BasicComplex<T>> out) {
+  fftPlan<T>(static_cast<size_t>(out.size()), FftDirection::Forward)->execute(in, out);
+}
+
+/// Computes the forward transform in place with a cached plan
+/// @param data Input and output
+template <scalar T>
+void fft(std::span<BasicComplex<T>> data) {
+  fftPlan<T>(static_cast<size_t>(data.size()), FftDirection::Forward)->execute(data);
+}
+
+/// Computes the inverse transform (scaled by 1/n) with a cached plan
+/// @param in Input
+/// @param out Output of the same size, may be the same span as the input
+template <scalar T>
+void ifft(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<BasicComplex<T>> out) {
+  fftPlan<T>(static_cast<size_t>(out.size()), FftDirection::Inverse)->execute(in, out);
+}
+
+/// Computes the inverse transform (scaled by 1/n) in place with a cached plan
+/// @param data Input and output
+template <scalar T>
+void ifft(std::span<BasicComplex<T>> data) {
+  fftPlan<T>(static_cast<size_t>(data.size()), FftDirection::Inverse)->execute(data);
+}
+
+}  // namespace Math
+
+#endif  // MATH_FFT_H
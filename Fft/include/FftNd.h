@@ -0,0 +1,64 @@
+#ifndef MATH_FFT_ND_H
+#define MATH_FFT_ND_H
+
+#include <span>
+#include <type_traits>
+
+#include "Fft.h"
+#include "ThreadPool.h"
+
+namespace Math {
+
+/// Transforms a batch of contiguous signals of equal length, the signals are distributed over the threads of a pool
+/// @param in Input, in.size() / size signals stored one after the other
+/// @param out Output of the same size, may be the same span as the input
+/// @param size Length of each signal
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftBatch(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<BasicComplex<T>> out, size_t size,
+              FftDirection direction, ThreadPool& pool = defaultThreadPool());
+
+/// Transforms a batch of contiguous signals of equal length in place
+/// @param data Input and output, data.size() / size signals stored one after the other
+/// @param size Length of each signal
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftBatch(std::span<BasicComplex<T>> data, size_t size, FftDirection direction,
+              ThreadPool& pool = defaultThreadPool());
+
+/// Multidimensional transform of an array in row-major order (the last axis is contiguous). The last axis is
+/// transformed as a batch of rows, the other axes in panels of columns that are gathered into contiguous rows with a
+/// cache-oblivious transpose, so that no transform reads strided memory.
+/// @param in Input with as many elements as the product of the extents
+/// @param out Output of the same size, may be the same span as the input
+/// @param shape Extent of each axis, the inverse transform is scaled by 1 / product of the extents
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftNd(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<BasicComplex<T>> out,
+           std::span<const size_t> shape, FftDirection direction, ThreadPool& pool = defaultThreadPool());
+
+/// Multidimensional transform of an array in row-major order in place
+/// @param data Input and output with as many elements as the product of the extents
+/// @param shape Extent of each axis
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftNd(std::span<BasicComplex<T>> data, std::span<const size_t> shape, FftDirection direction,
+           ThreadPool& pool = defaultThreadPool());
+
+/// Transposes a matrix in row-major order with a cache-oblivious recursion over blocks
+/// @param in Matrix with rows * cols elements
+/// @param out Transposed matrix with cols rows of rows elements, must not overlap the input
+/// @param rows Number of rows of the input
+/// @param cols Number of columns of the input
+/// @param pool Threads that transpose bands of rows
+template <scalar T>
+void transpose(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<BasicComplex<T>> out, size_t rows,
+               size_t cols, ThreadPool& pool = defaultThreadPool());
+
+}  // namespace Math
+
+#endif  // MATH_FFT_ND_H
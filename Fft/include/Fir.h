@@ -0,0 +1,157 @@
+#ifndef MATH_FIR_H
+#define MATH_FIR_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "Fft.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Algorithm of an FIR filter
+enum class FirMethod : uint8_t {
+  Automatic,   ///< Direct for at most FIR_DIRECT_TAPS taps, overlap-save otherwise
+  Direct,      ///< SIMD dot product of the taps with every window of the input, O(taps) per sample
+  OverlapSave  ///< Blocks of the input are multiplied with the spectrum of the taps, O(log taps) per sample of a block
+};
+
+/// Largest number of taps that FirMethod::Automatic filters in direct form, about where overlap-save becomes faster
+constexpr size_t FIR_DIRECT_TAPS = 96;
+
+/// Largest number of taps of a filter, so that the overlap-save blocks stay within MAX_ELEMENT_COUNT
+constexpr size_t FIR_MAX_TAPS = 1U << 22;
+
+/// Streaming FIR filter y[n] = sum h[k] x[n - k] with complex taps h. The filter keeps the last taps - 1 input
+/// samples between calls, so a stream can be filtered in pieces of any size with the same result as in one piece,
+/// and every call writes as many samples as it reads, without delay. Short filters run in direct form, long ones by
+/// overlap-save: blocks of the input are transformed with an FFT of about four times the number of taps, at least
+/// 1024, multiplied with the spectrum of the taps and transformed back, and the samples that wrapped around are
+/// discarded. The cost of overlap-save is per block and every call runs at least one, so pieces shorter than the
+/// block size cost as much as a whole block: stream in pieces of at least blockSize() samples where that matters. The
+/// filter is stateful, use one per stream.
+template <scalar T>
+class BasicFirFilter {
+protected:
+  FirMethod m_Method;
+  /// Taps in reverse order, the factors of the direct form
+  BasicComplexArray<T> m_Reversed;
+  /// The last taps - 1 input samples followed by the block that is being filtered
+  BasicComplexArray<T> m_Buffer;
+  /// Number of new samples per block
+  size_t m_BlockSize;
+  /// Overlap-save: spectrum of the zero padded taps, the plans and the block that is transformed
+  AlignedVector<BasicComplex<T>> m_Spectrum;
+  std::shared_ptr<const BasicFftPlan<T>> m_Forward;
+  std::shared_ptr<const BasicFftPlan<T>> m_Inverse;
+  AlignedVector<BasicComplex<T>> m_Block;
+  /// Split copy of a block of interleaved samples
+  BasicComplexArray<T> m_Scratch;
+
+  [[nodiscard]] size_t history() const { return static_cast<size_t>(m_Reversed.size() - 1); }
+  void filterBlock(SplitSpan<const T> in, SplitSpan<T> out);
+
+public:
+  /// Creates a filter with zero history
+  /// @param taps Impulse response, between 1 and FIR_MAX_TAPS numbers
+  /// @param method Algorithm, by default chosen from the number of taps
+  explicit BasicFirFilter(std::type_identity_t<SplitSpan<const T>> taps, FirMethod method = FirMethod::Automatic);
+
+  /// @return Number of taps
+  [[nodiscard]] size_t size() const { return m_Reversed.size(); }
+  /// @return Algorithm that the filter uses, never Automatic
+  [[nodiscard]] FirMethod method() const { return m_Method; }
+  /// @return Number of new samples per block, the piece size at which overlap-save reaches its per-sample cost
+  [[nodiscard]] size_t blockSize() const { return m_BlockSize; }
+
+  /// Filters the next samples of the stream. out may alias in. Overlap-save transforms at least one block per call.
+  /// @param in Input samples
+  /// @param out Output samples of the same size
+  void filter(std::type_identity_t<SplitSpan<const T>> in, SplitSpan<T> out);
+
+  /// Filters the next samples of the stream. out may alias in.
+  /// @param in Interleaved input samples
+  /// @param out Interleaved output samples of the same size
+  void filter(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<BasicComplex<T>> out);
+
+  /// Clears the history, so that the next sample starts a new stream
+  void reset();
+};
+
+/// Streaming polyphase resampler by the rational factor interpolation / decimation. Conceptually the input is
+/// upsampled by inserting interpolation - 1 zeros after every sample, filtered with the taps and every decimation-th
+/// sample is kept; the polyphase form evaluates only the products with nonzero inputs of the kept samples, each
+/// output with one of the interpolation subfilters h[p], h[p + interpolation], .... The taps are designed for the
+/// upsampled rate, a gain of interpolation keeps the amplitude. The resampler keeps its history and its position
+/// between calls, use one per stream.
+template <scalar T>
+class BasicResampler {
+protected:
+  size_t m_Interpolation;
+  size_t m_Decimation;
+  /// Taps per subfilter
+  size_t m_Length;
+  /// Subfilters in reverse order, subfilter p at m_Phases[p * m_Length]
+  BasicComplexArray<T> m_Phases;
+  /// The last m_Length - 1 input samples followed by the block that is being resampled
+  BasicComplexArray<T> m_Buffer;
+  /// Position of the next output in the upsampled stream, relative to the first sample of the block
+  uint64_t m_Time;
+
+  [[nodiscard]] size_t history() const { return m_Length - 1; }
+  size_t resampleBlock(SplitSpan<const T> in, SplitSpan<T> out);
+
+public:
+  /// Creates a resampler with zero history
+  /// @param taps Impulse response at the upsampled rate, between 1 and FIR_MAX_TAPS numbers
+  /// @param interpolation Upsampling factor, at least 1
+  /// @param decimation Downsampling factor, at least 1
+  BasicResampler(std::type_identity_t<SplitSpan<const T>> taps, size_t interpolation, size_t decimation = 1);
+
+  [[nodiscard]] size_t interpolation() const { return m_Interpolation; }
+  [[nodiscard]] size_t decimation() const { return m_Decimation; }
+
+  /// @param inputSize Number of input samples of the next call of resample
+  /// @return Number of output samples that it writes
+  [[nodiscard]] std::size_t outputSize(std::size_t inputSize) const;
+
+  /// Resamples the next samples of the stream
+  /// @param in Input samples
+  /// @param out Output samples, at least outputSize(in.size()) of them
+  /// @return Number of output samples written
+  std::size_t resample(std::type_identity_t<SplitSpan<const T>> in, SplitSpan<T> out);
+
+  /// Clears the history and the position, so that the next sample starts a new stream
+  void reset();
+};
+
+using FirFilter = BasicFirFilter<real_t>;
+using Resampler = BasicResampler<real_t>;
+
+/// Full linear convolution, out[n] = sum x[k] h[n - k] for n < x.size() + h.size() - 1, in direct form or by
+/// overlap-save like BasicFirFilter
+/// @param x Signal
+/// @param h Kernel, not empty
+/// @param out Result of x.size() + h.size() - 1 numbers
+template <scalar T>
+void convolve(std::type_identity_t<SplitSpan<const T>> x, std::type_identity_t<SplitSpan<const T>> h,
+              SplitSpan<T> out);
+
+/// Full cross-correlation, out[n] = sum x[k + n - (h.size() - 1)] conj(h[k]) for n < x.size() + h.size() - 1, the
+/// lags from -(h.size() - 1) to x.size() - 1
+/// @param x Signal
+/// @param h Template, not empty
+/// @param out Result of x.size() + h.size() - 1 numbers
+template <scalar T>
+void correlate(std::type_identity_t<SplitSpan<const T>> x, std::type_identity_t<SplitSpan<const T>> h,
+               SplitSpan<T> out);
+
+}  // namespace Math
+
+#endif  // MATH_FIR_H
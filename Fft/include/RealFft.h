@@ -0,0 +1,117 @@
+#ifndef MATH_REAL_FFT_H
+#define MATH_REAL_FFT_H
+
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "AlignedAllocator.h"
+#include "Fft.h"
+#include "ThreadPool.h"
+
+namespace Math {
+
+/// Precomputed transform of real signals. The spectrum of a real signal of length n is Hermitian, X[n - k] =
+/// conj(X[k]), so only the n / 2 + 1 bins X[0] ... X[n / 2] are stored. The forward plan transforms real input to
+/// these bins, the inverse plan transforms them back to a real signal (scaled by 1/n); the imaginary parts of X[0] and,
+/// for even n, X[n / 2] are ignored. Even sizes pack the signal into a complex signal of half the length
+/// (z[j] = x[2j] + i x[2j + 1]) and separate the spectra of the even and odd samples afterwards, which halves the work
+/// and memory traffic of the complex transform. Odd sizes use the complex transform of the full length.
+template <scalar T>
+class BasicRealFftPlan {
+public:
+  using value_type = T;
+  using complex_type = BasicComplex<T>;
+
+protected:
+  size_t m_Size;
+  FftDirection m_Direction;
+  /// Complex transform of length n / 2 (even n) or n (odd n)
+  std::shared_ptr<const BasicFftPlan<T>> m_Complex;
+  /// Even n: m_Twiddles[k] = e^(-+2 pi i k / n) for k <= n / 4
+  AlignedVector<complex_type> m_Twiddles;
+
+  void checkDirection(FftDirection direction) const;
+
+public:
+  /// Creates a plan
+  /// @param size Length of the real signal, between 1 and MAX_ELEMENT_COUNT
+  /// @param direction Forward (real to complex) or inverse (complex to real) transform
+  BasicRealFftPlan(size_t size, FftDirection direction);
+
+  [[nodiscard]] size_t size() const { return m_Size; }
+  /// @return Number of complex bins, size() / 2 + 1
+  [[nodiscard]] size_t spectrumSize() const { return m_Size / 2 + 1; }
+  [[nodiscard]] FftDirection direction() const { return m_Direction; }
+  /// @return Number of complex numbers that execute needs as scratch memory
+  [[nodiscard]] std::size_t workspaceSize() const;
+
+  /// Transforms a real signal to its non-redundant bins, using a thread local workspace (forward plans only)
+  /// @param in Real signal of length size()
+  /// @param out Spectrum of length spectrumSize()
+  void execute(std::span<const T> in, std::span<complex_type> out) const;
+
+  /// Transforms non-redundant bins to a real signal, using a thread local workspace (inverse plans only)
+  /// @param in Spectrum of length spectrumSize()
+  /// @param out Real signal of length size()
+  void execute(std::span<const complex_type> in, std::span<T> out) const;
+
+  /// Transforms a real signal to its non-redundant bins with caller provided scratch memory (forward plans only)
+  /// @param in Real signal of length size()
+  /// @param out Spectrum of length spectrumSize()
+  /// @param workspace Scratch memory of at least workspaceSize() elements
+  void execute(std::span<const T> in, std::span<complex_type> out, std::span<complex_type> workspace) const;
+
+  /// Transforms non-redundant bins to a real signal with caller provided scratch memory (inverse plans only)
+  /// @param in Spectrum of length spectrumSize()
+  /// @param out Real signal of length size()
+  /// @param workspace Scratch memory of at least workspaceSize() elements
+  void execute(std::span<const complex_type> in, std::span<T> out, std::span<complex_type> workspace) const;
+};
+
+using RealFftPlan = BasicRealFftPlan<real_t>;
+
+/// Get a real plan from the process wide cache, keyed by size and direction. The plan is created on first use.
+/// @param size Length of the real signal
+/// @param direction Forward (real to complex) or inverse (complex to real) transform
+/// @return Shared plan
+template <scalar T = real_t>
+std::shared_ptr<const BasicRealFftPlan<T>> realFftPlan(size_t size, FftDirection direction);
+
+/// Computes the non-redundant bins of a real signal with a cached plan
+/// @param in Real signal
+/// @param out Spectrum of length in.size() / 2 + 1
+template <scalar T>
+void rfft(std::type_identity_t<std::span<const T>> in, std::span<BasicComplex<T>> out) {
+  realFftPlan<T>(static_cast<size_t>(in.size()), FftDirection::Forward)->execute(in, out);
+}
+
+/// Computes a real signal from its non-redundant bins with a cached plan, scaled by 1/n
+/// @param in Spectrum of length out.size() / 2 + 1
+/// @param out Real signal, its length selects the size of the transform
+template <scalar T>
+void irfft(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<T> out) {
+  realFftPlan<T>(static_cast<size_t>(out.size()), FftDirection::Inverse)->execute(in, out);
+}
+
+/// Transforms a batch of contiguous real signals of equal length, distributed over the threads of a pool
+/// @param in Real signals of length size, stored one after the other
+/// @param out Spectra of length size / 2 + 1, stored one after the other
+/// @param size Length of each signal
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void rfftBatch(std::type_identity_t<std::span<const T>> in, std::span<BasicComplex<T>> out, size_t size,
+               ThreadPool& pool = defaultThreadPool());
+
+/// Transforms a batch of contiguous spectra back to real signals of equal length, scaled by 1/size
+/// @param in Spectra of length size / 2 + 1, stored one after the other
+/// @param out Real signals of length size, stored one after the other
+/// @param size Length of each signal
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void irfftBatch(std::type_identity_t<std::span<const BasicComplex<T>>> in, std::span<T> out, size_t size,
+                ThreadPool& pool = defaultThreadPool());
+
+}  // namespace Math
+
+#endif  // MATH_REAL_FFT_H
@@ -0,0 +1,423 @@
+#include "Fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+#include "PlanCache.h"
+#include "RealFft.h"
+
+namespace Math {
+
+namespace {
+
+/// Computes e^(sign 2 pi i k / n) in extended precision, so that the rounding error of the tables stays below 1 ULP
+template <scalar T>
+BasicComplex<T> unitRoot(const uint64_t k, const uint64_t n, const FftDirection direction) {
+  const long double angle = 2 * std::numbers::pi_v<long double> * static_cast<long double>(k % n) / n;
+  const long double sign = direction == FftDirection::Forward ? -1 : 1;
+  return BasicComplex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(sign * std::sin(angle)));
+}
+
+/// Splits n into butterfly radices, 4 first, then 2, 3, 5 and the remaining primes in ascending order
+std::vector<size_t> factorize(size_t n) {
+  std::vector<size_t> factors;
+  while (n % 4 == 0) {
+    factors.push_back(4);
+    n /= 4;
+  }
+  if (n % 2 == 0) {
+    factors.push_back(2);
+    n /= 2;
+  }
+  for (size_t p = 3; p * p <= n; p += 2) {
+    while (n % p == 0) {
+      factors.push_back(p);
+      n /= p;
+    }
+  }
+  if (n > 1) factors.push_back(n);
+  return factors;
+}
+
+/// Rough number of operations per element of a Stockham transform, the generic butterfly is quadratic in the radix
+real_t stockhamCost(const size_t n) {
+  real_t cost = 0;
+  for (const size_t p : factorize(n)) cost += p <= 5 ? 1 : 0.5 * static_cast<real_t>(p);
+  return cost * n;
+}
+
+/// @return Smallest number >= n without prime factors above 5
+size_t smoothSize(const size_t n) {
+  for (size_t m = n;; ++m) {
+    size_t r = m;
+    for (const size_t p : {2, 3, 5}) {
+      while (r % p == 0) r /= p;
+    }
+    if (r == 1) return m;
+  }
+}
+
+/// Indexing of the Stockham passes: the input of a pass is cc(i, j, k) = cc[i + ido (j + radix k)], the output is
+/// ch(i, k, j) = ch[i + ido (k + l1 j)], where i < ido runs over the elements that share a twiddle factor, j < radix
+/// over the butterfly inputs and k < l1 over the butterflies of the previous passes.
+template <typename T>
+struct PassView {
+  const BasicComplex<T>* cc;
+  BasicComplex<T>* ch;
+  const BasicComplex<T>* twiddles;
+  std::size_t ido;
+  std::size_t l1;
+  std::size_t radix;
+
+  [[nodiscard]] const BasicComplex<T>& in(const std::size_t i, const std::size_t j, const std::size_t k) const {
+    return cc[i + ido * (j + radix * k)];
+  }
+  [[nodiscard]] BasicComplex<T>& out(const std::size_t i, const std::size_t k, const std::size_t j) const {
+    return ch[i + ido * (k + l1 * j)];
+  }
+  [[nodiscard]] const BasicComplex<T>& twiddle(const std::size_t j, const std::size_t i) const {
+    return twiddles[(j - 1) * ido + i];
+  }
+};
+
+/// @return z multiplied by -i (forward) or i (inverse)
+template <bool FORWARD, typename T>
+BasicComplex<T> rotate(const BasicComplex<T>& z) {
+  if constexpr (FORWARD) return BasicComplex<T>(z.imag(), -z.real());
+  return BasicComplex<T>(-z.imag(), z.real());
+}
+
+template <bool FORWARD, typename T>
+void pass2(const PassView<T>& v) {
+  for (std::size_t k = 0; k < v.l1; ++k) {
+    for (std::size_t i = 0; i < v.ido; ++i) {
+      const BasicComplex<T> a0 = v.in(i, 0, k);
+      const BasicComplex<T> a1 = v.in(i, 1, k);
+      v.out(i, k, 0) = a0 + a1;
+      v.out(i, k, 1) = (a0 - a1) * v.twiddle(1, i);
+    }
+  }
+}
+
+template <bool FORWARD, typename T>
+void pass3(const PassView<T>& v) {
+  constexpr T SIN = std::numbers::sqrt3_v<T> / 2;
+  for (std::size_t k = 0; k < v.l1; ++k) {
+    for (std::size_t i = 0; i < v.ido; ++i) {
+      const BasicComplex<T> a0 = v.in(i, 0, k);
+      const BasicComplex<T> t = v.in(i, 1, k) + v.in(i, 2, k);
+      const BasicComplex<T> s = a0 - T(0.5) * t;
+      const BasicComplex<T> d = SIN * rotate<FORWARD>(v.in(i, 1, k) - v.in(i, 2, k));
+      v.out(i, k, 0) = a0 + t;
+      v.out(i, k, 1) = (s + d) * v.twiddle(1, i);
+      v.out(i, k, 2) = (s - d) * v.twiddle(2, i);
+    }
+  }
+}
+
+template <bool FORWARD, typename T>
+void pass4(const PassView<T>& v) {
+  for (std::size_t k = 0; k < v.l1; ++k) {
+    for (std::size_t i = 0; i < v.ido; ++i) {
+      const BasicComplex<T> t1 = v.in(i, 0, k) + v.in(i, 2, k);
+      const BasicComplex<T> t2 = v.in(i, 0, k) - v.in(i, 2, k);
+      const BasicComplex<T> t3 = v.in(i, 1, k) + v.in(i, 3, k);
+      const BasicComplex<T> t4 = rotate<FORWARD>(v.in(i, 1, k) - v.in(i, 3, k));
+      v.out(i, k, 0) = t1 + t3;
+      v.out(i, k, 1) = (t2 + t4) * v.twiddle(1, i);
+      v.out(i, k, 2) = (t1 - t3) * v.twiddle(2, i);
+      v.out(i, k, 3) = (t2 - t4) * v.twiddle(3, i);
+    }
+  }
+}
+
+template <bool FORWARD, typename T>
+void pass5(const PassView<T>& v) {
+  const T c1 = static_cast<T>(0.30901699437494742410L);   // cos(2 pi / 5)
+  const T c2 = static_cast<T>(-0.80901699437494742410L);  // cos(4 pi / 5)
+  const T s1 = static_cast<T>(0.95105651629515357212L);   // sin(2 pi / 5)
+  const T s2 = static_cast<T>(0.58778525229247312917L);   // sin(4 pi / 5)
+  for (std::size_t k = 0; k < v.l1; ++k) {
+    for (std::size_t i = 0; i < v.ido; ++i) {
+      const BasicComplex<T> a0 = v.in(i, 0, k);
+      const BasicComplex<T> t1 = v.in(i, 1, k) + v.in(i, 4, k);
+      const BasicComplex<T> t2 = v.in(i, 2, k) + v.in(i, 3, k);
+      const BasicComplex<T> t3 = v.in(i, 1, k) - v.in(i, 4, k);
+      const BasicComplex<T> t4 = v.in(i, 2, k) - v.in(i, 3, k);
+      const BasicComplex<T> r1 = a0 + c1 * t1 + c2 * t2;
+      const BasicComplex<T> r2 = a0 + c2 * t1 + c1 * t2;
+      const BasicComplex<T> d1 = rotate<FORWARD>(s1 * t3 + s2 * t4);
+      const BasicComplex<T> d2 = rotate<FORWARD>(s2 * t3 - s1 * t4);
+      v.out(i, k, 0) = a0 + t1 + t2;
+      v.out(i, k, 1) = (r1 + d1) * v.twiddle(1, i);
+      v.out(i, k, 2) = (r2 + d2) * v.twiddle(2, i);
+      v.out(i, k, 3) = (r2 - d2) * v.twiddle(3, i);
+      v.out(i, k, 4) = (r1 - d1) * v.twiddle(4, i);
+    }
+  }
+}
+
+/// Butterfly of any odd radix p as a direct DFT, inputs j and p - j are combined so that half of the products are
+/// shared between the outputs u and p - u
+template <bool FORWARD, typename T>
+void passGeneric(const PassView<T>& v, const BasicComplex<T>* roots) {
+  const std::size_t p = v.radix;
+  const std::size_t half = (p + 1) / 2;
+  BasicComplex<T> sums[64];
+  BasicComplex<T> differences[64];
+  std::vector<BasicComplex<T>> heapSums;
+  std::vector<BasicComplex<T>> heapDifferences;
+  BasicComplex<T>* sum = sums;
+  BasicComplex<T>* difference = differences;
+  if (half > 64) {
+    heapSums.resize(half);
+    heapDifferences.resize(half);
+    sum = heapSums.data();
+    difference = heapDifferences.data();
+  }
+  for (std::size_t k = 0; k < v.l1; ++k) {
+    for (std::size_t i = 0; i < v.ido; ++i) {
+      const BasicComplex<T> a0 = v.in(i, 0, k);
+      BasicComplex<T> y0 = a0;
+      for (std::size_t j = 1; j < half; ++j) {
+        sum[j] = v.in(i, j, k) + v.in(i, p - j, k);
+        difference[j] = v.in(i, j, k) - v.in(i, p - j, k);
+        y0 += sum[j];
+      }
+      v.out(i, k, 0) = y0;
+      for (std::size_t u = 1; u < half; ++u) {
+        // y_u = a0 + sum_j (cos(2 pi uj / p) s_j +- i sin(2 pi uj / p) d_j), y_(p-u) flips the sign of the sine part
+        BasicComplex<T> re = a0;
+        BasicComplex<T> im;
+        std::size_t index = 0;
+        for (std::size_t j = 1; j < half; ++j) {
+          index += u;
+          if (index >= p) index -= p;
+          re += roots[index].real() * sum[j];
+          im += roots[index].imag() * difference[j];
+        }
+        const BasicComplex<T> rotated(-im.imag(), im.real());
+        v.out(i, k, u) = (re + rotated) * v.twiddle(u, i);
+        v.out(i, k, p - u) = (re - rotated) * v.twiddle(p - u, i);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+/// Creates a plan
+/// @param size Transform length, between 1 and MAX_ELEMENT_COUNT
+/// @param direction Forward or inverse transform, the inverse is scaled by 1/size
+template <scalar T>
+BasicFftPlan<T>::BasicFftPlan(const size_t size, const FftDirection direction)
+    : m_Size(size),
+      m_Direction(direction),
+      m_Scale(direction == FftDirection::Inverse ? T(1) / static_cast<T>(size) : T(1)) {
+  if (size == 0) throw std::invalid_argument("FftPlan: size must be positive");
+  if (size > MAX_ELEMENT_COUNT) throw std::length_error("FftPlan: size exceeds MAX_ELEMENT_COUNT");
+  if constexpr (!std::same_as<accumulator_t<T>, T>) {
+    m_Scale = T(1);
+    m_Widened = std::make_unique<BasicFftPlan<accumulator_t<T>>>(size, direction);
+    return;
+  }
+
+  const size_t convolutionSize = smoothSize(2 * size - 1);
+  const real_t bluesteinCost = 2 * stockhamCost(convolutionSize) + 4.0 * convolutionSize;
+  if (size > 5 && bluesteinCost < stockhamCost(size)) {
+    // X_k = c_k sum_j (x_j c_j) conj(c_(k-j)) with the chirp c_j = e^(-+pi i j^2 / n), evaluated as a cyclic
+    // convolution of length m >= 2n - 1. The spectrum of conj(c) includes the 1/m of the inverse transform.
+    m_Convolution = std::make_unique<BasicFftPlan>(convolutionSize, FftDirection::Forward);
+    m_Chirp.resize(size);
+    AlignedVector<value_type> kernel(convolutionSize);
+    for (size_t k = 0; k < size; ++k) {
+      const uint64_t square = static_cast<uint64_t>(k) * k % (2 * static_cast<uint64_t>(size));
+      m_Chirp[k] = unitRoot<T>(square, 2 * static_cast<uint64_t>(size), direction);
+      kernel[k] = conj(m_Chirp[k]);
+      if (k > 0) kernel[convolutionSize - k] = kernel[k];
+    }
+    m_ChirpSpectrum.resize(convolutionSize);
+    m_Convolution->execute(kernel, m_ChirpSpectrum);
+    const T scale = T(1) / static_cast<T>(convolutionSize);
+    for (value_type& z : m_ChirpSpectrum) z *= scale;
+    return;
+  }
+
+  size_t l1 = 1;
+  for (const size_t radix : factorize(size)) {
+    const size_t ido = size / (l1 * radix);
+    m_Passes.push_back({radix, ido, static_cast<size_t>(m_Twiddles.size())});
+    for (size_t j = 1; j < radix; ++j) {
+      for (size_t i = 0; i < ido; ++i) {
+        m_Twiddles.push_back(unitRoot<T>(uint64_t(j) * i, uint64_t(ido) * radix, direction));
+      }
+    }
+    if (radix > 5) {
+      for (size_t k = 0; k < radix; ++k) m_Roots.push_back(unitRoot<T>(k, radix, direction));
+    }
+    l1 *= radix;
+  }
+}
+
+/// @return Number of complex numbers that execute needs as scratch memory
+template <scalar T>
+std::size_t BasicFftPlan<T>::workspaceSize() const {
+  if (m_Widened) {
+    // The widened data and the workspace of the wider plan, plus the padding to align them
+    using Wide = BasicComplex<accumulator_t<T>>;
+    const std::size_t bytes = (m_Size + m_Widened->workspaceSize()) * sizeof(Wide) + alignof(Wide);
+    return (bytes + sizeof(value_type) - 1) / sizeof(value_type);
+  }
+  if (m_Convolution) return m_Convolution->size() + m_Convolution->workspaceSize();
+  return 2 * std::size_t(m_Size);
+}
+
+/// Transforms out of place or in place (in and out may be the same span), using a thread local workspace
+/// @param in Input of length size()
+/// @param out Output of length size()
+template <scalar T>
+void BasicFftPlan<T>::execute(const std::span<const value_type> in, const std::span<value_type> out) const {
+  thread_local AlignedVector<value_type> workspace;
+  if (workspace.size() < workspaceSize()) workspace.resize(workspaceSize());
+  execute(in, out, workspace);
+}
+
+/// Transforms in place
+/// @param data Input and output of length size()
+template <scalar T>
+void BasicFftPlan<T>::execute(const std::span<value_type> data) const {
+  execute(data, data);
+}
+
+/// Transforms with caller provided scratch memory
+/// @param in Input of length size()
+/// @param out Output of length size()
+/// @param workspace Scratch memory of at least workspaceSize() elements
+template <scalar T>
+void BasicFftPlan<T>::execute(const std::span<const value_type> in, const std::span<value_type> out,
+                              const std::span<value_type> workspace) const {
+  if (in.size() != m_Size || out.size() != m_Size) throw std::invalid_argument("FftPlan: size mismatch");
+  if (workspace.size() < workspaceSize()) throw std::invalid_argument("FftPlan: workspace too small");
+  transform(in.data(), out.data(), workspace.data());
+  if (m_Scale != T(1)) {
+    for (value_type& z : out) z *= m_Scale;
+  }
+}
+
+template <scalar T>
+void BasicFftPlan<T>::transform(const value_type* in, value_type* out, value_type* workspace) const {
+  if (m_Widened) {
+    widened(in, out, workspace);
+  } else if (m_Convolution) {
+    bluestein(in, out, workspace);
+  } else {
+    stockham(in, out, workspace);
+  }
+}
+
+template <scalar T>
+void BasicFftPlan<T>::stockham(const value_type* in, value_type* out, value_type* workspace) const {
+  const std::size_t n = m_Size;
+  if (m_Passes.empty()) {
+    out[0] = in[0];
+    return;
+  }
+  if (m_Passes.size() == 1 && in == out) {
+    std::copy(in, in + n, workspace);
+    in = workspace;
+  }
+  // Intermediate results alternate between the two halves of the workspace, the last pass writes the output
+  const value_type* src = in;
+  std::size_t l1 = 1;
+  std::size_t rootOffset = 0;
+  for (std::size_t p = 0; p < m_Passes.size(); ++p) {
+    const Pass& pass = m_Passes[p];
+    value_type* dst = p + 1 == m_Passes.size() ? out : workspace + (p % 2) * n;
+    if (dst == src) dst = workspace + ((p + 1) % 2) * n;
+    const PassView<T> view = {src, dst, m_Twiddles.data() + pass.twiddleOffset, pass.stride, l1, pass.radix};
+    const bool forward = m_Direction == FftDirection::Forward;
+    switch (pass.radix) {
+      case 2:
+        forward ? pass2<true>(view) : pass2<false>(view);
+        break;
+      case 3:
+        forward ? pass3<true>(view) : pass3<false>(view);
+        break;
+      case 4:
+        forward ? pass4<true>(view) : pass4<false>(view);
+        break;
+      case 5:
+        forward ? pass5<true>(view) : pass5<false>(view);
+        break;
+      default:
+        forward ? passGeneric<true>(view, m_Roots.data() + rootOffset)
+                : passGeneric<false>(view, m_Roots.data() + rootOffset);
+        rootOffset += pass.radix;
+        break;
+    }
+    src = dst;
+    l1 *= pass.radix;
+  }
+}
+
+template <scalar T>
+void BasicFftPlan<T>::bluestein(const value_type* in, value_type* out, value_type* workspace) const {
+  const std::size_t n = m_Size;
+  const std::size_t m = m_Convolution->size();
+  value_type* a = workspace;
+  value_type* convolutionWorkspace = workspace + m;
+  for (std::size_t k = 0; k < n; ++k) a[k] = in[k] * m_Chirp[k];
+  std::fill(a + n, a + m, value_type());
+  m_Convolution->transform(a, a, convolutionWorkspace);
+  // The inverse transform is a forward transform of the conjugate
+  for (std::size_t k = 0; k < m; ++k) a[k] = conj(a[k] * m_ChirpSpectrum[k]);
+  m_Convolution->transform(a, a, convolutionWorkspace);
+  for (std::size_t k = 0; k < n; ++k) out[k] = conj(a[k]) * m_Chirp[k];
+}
+
+template <scalar T>
+void BasicFftPlan<T>::widened(const value_type* in, value_type* out, value_type* workspace) const {
+  using Wide = BasicComplex<accumulator_t<T>>;
+  const std::size_t n = m_Size;
+  void* memory = workspace;
+  std::size_t space = workspaceSize() * sizeof(value_type);
+  Wide* data = static_cast<Wide*>(std::align(alignof(Wide), (n + m_Widened->workspaceSize()) * sizeof(Wide), memory,
+                                              space));
+  for (std::size_t k = 0; k < n; ++k) data[k] = Wide(in[k].real(), in[k].imag());
+  const std::span<Wide> wide(data, n);
+  m_Widened->execute(wide, wide, std::span<Wide>(data + n, m_Widened->workspaceSize()));
+  for (std::size_t k = 0; k < n; ++k) {
+    out[k] = value_type(static_cast<T>(data[k].real()), static_cast<T>(data[k].imag()));
+  }
+}
+
+/// Get a plan from the process wide cache, keyed by size and direction. The plan is created on first use.
+/// @param size Transform length
+/// @param direction Forward or inverse transform
+/// @return Shared plan
+template <scalar T>
+std::shared_ptr<const BasicFftPlan<T>> fftPlan(const size_t size, const FftDirection direction) {
+  return PlanCache<BasicFftPlan<T>>::instance().get(size, direction);
+}
+
+/// Removes all complex and real plans from the caches. Plans that are still referenced stay valid.
+void clearFftPlanCache() {
+  PlanCache<BasicFftPlan<float>>::instance().clear();
+  PlanCache<BasicFftPlan<double>>::instance().clear();
+  PlanCache<BasicFftPlan<long double>>::instance().clear();
+  PlanCache<BasicRealFftPlan<float>>::instance().clear();
+  PlanCache<BasicRealFftPlan<double>>::instance().clear();
+  PlanCache<BasicRealFftPlan<long double>>::instance().clear();
+}
+
+template class BasicFftPlan<float>;
+template class BasicFftPlan<double>;
+template class BasicFftPlan<long double>;
+template std::shared_ptr<const BasicFftPlan<float>> fftPlan<float>(size_t, FftDirection);
+template std::shared_ptr<const BasicFftPlan<double>> fftPlan<double>(size_t, FftDirection);
+template std::shared_ptr<const BasicFftPlan<long double>> fftPlan<long double>(size_t, FftDirection);
+
+}  // namespace Math
@@ -0,0 +1,184 @@
+#include "FftNd.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "AlignedAllocator.h"
+
+namespace Math {
+
+namespace {
+
+/// Elements below which a block is transposed directly, 16 x 16 complex doubles fill 4 KiB per side
+constexpr std::size_t TRANSPOSE_BLOCK = 16;
+/// Columns that are gathered into one panel when transforming a strided axis, 16 complex doubles are 4 cache lines
+constexpr std::size_t PANEL_WIDTH = 16;
+/// Minimum number of elements per parallel task, smaller tasks do not amortize the synchronization
+constexpr std::size_t TASK_ELEMENTS = 1 << 14;
+
+/// Cache-oblivious transpose of a strided rows x cols block: the larger dimension is halved until the block fits
+/// into the cache, without knowing the cache size
+template <typename T>
+void transposeBlock(const T* in, const std::size_t inStride, T* out, const std::size_t outStride,
+                    const std::size_t rows, const std::size_t cols) {
+  if (rows <= TRANSPOSE_BLOCK && cols <= TRANSPOSE_BLOCK) {
+    for (std::size_t r = 0; r < rows; ++r) {
+      for (std::size_t c = 0; c < cols; ++c) out[c * outStride + r] = in[r * inStride + c];
+    }
+  } else if (rows >= cols) {
+    const std::size_t half = rows / 2;
+    transposeBlock(in, inStride, out, outStride, half, cols);
+    transposeBlock(in + half * inStride, inStride, out + half, outStride, rows - half, cols);
+  } else {
+    const std::size_t half = cols / 2;
+    transposeBlock(in, inStride, out, outStride, rows, half);
+    transposeBlock(in + half, inStride, out + half * outStride, outStride, rows, cols - half);
+  }
+}
+
+/// @return Number of consecutive indices that make up a task of about TASK_ELEMENTS elements
+std::size_t grainSize(const std::size_t elementsPerIndex) {
+  return std::max<std::size_t>(1, TASK_ELEMENTS / std::max<std::size_t>(1, elementsPerIndex));
+}
+
+/// Transforms the middle axis of an array of shape (outer, n, inner) with inner > 1. Each task gathers PANEL_WIDTH
+/// columns of one outer slice into contiguous rows, transforms them and scatters them back.
+template <scalar T>
+void transformAxis(const BasicComplex<T>* in, BasicComplex<T>* out, const std::size_t outer, const std::size_t n,
+                   const std::size_t inner, const BasicFftPlan<T>& plan, ThreadPool& pool) {
+  const std::size_t panels = (inner + PANEL_WIDTH - 1) / PANEL_WIDTH;
+  pool.parallelFor(0, outer * panels, grainSize(n * PANEL_WIDTH), [&](const std::size_t task) {
+    thread_local AlignedVector<BasicComplex<T>> buffer;
+    thread_local AlignedVector<BasicComplex<T>> workspace;
+    buffer.resize(std::max(buffer.size(), n * PANEL_WIDTH));
+    workspace.resize(std::max(workspace.size(), plan.workspaceSize()));
+
+    const std::size_t slice = task / panels;
+    const std::size_t column = task % panels * PANEL_WIDTH;
+    const std::size_t width = std::min(PANEL_WIDTH, inner - column);
+    const std::size_t offset = slice * n * inner + column;
+    transposeBlock(in + offset, inner, buffer.data(), n, n, width);
+    for (std::size_t c = 0; c < width; ++c) {
+      const std::span<BasicComplex<T>> row(buffer.data() + c * n, n);
+      plan.execute(row, row, workspace);
+    }
+    transposeBlock(buffer.data(), n, out + offset, inner, width, n);
+  });
+}
+
+void checkSize(const std::size_t inSize, const std::size_t outSize, const std::size_t expected) {
+  if (inSize != outSize || inSize != expected) throw std::invalid_argument("FftNd: size mismatch");
+}
+
+}  // namespace
+
+/// Transforms a batch of contiguous signals of equal length, the signals are distributed over the threads of a pool
+/// @param in Input, in.size() / size signals stored one after the other
+/// @param out Output of the same size, may be the same span as the input
+/// @param size Length of each signal
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftBatch(const std::type_identity_t<std::span<const BasicComplex<T>>> in, const std::span<BasicComplex<T>> out,
+              const size_t size, const FftDirection direction, ThreadPool& pool) {
+  if (size == 0 || in.size() % size != 0) throw std::invalid_argument("FftNd: size must divide the batch");
+  checkSize(in.size(), out.size(), in.size());
+  const std::shared_ptr<const BasicFftPlan<T>> plan = fftPlan<T>(size, direction);
+  pool.parallelFor(0, in.size() / size, grainSize(size), [&](const std::size_t i) {
+    plan->execute(in.subspan(i * size, size), out.subspan(i * size, size));
+  });
+}
+
+/// Transforms a batch of contiguous signals of equal length in place
+/// @param data Input and output, data.size() / size signals stored one after the other
+/// @param size Length of each signal
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftBatch(const std::span<BasicComplex<T>> data, const size_t size, const FftDirection direction,
+              ThreadPool& pool) {
+  fftBatch<T>(data, data, size, direction, pool);
+}
+
+/// Multidimensional transform of an array in row-major order (the last axis is contiguous). The last axis is
+/// transformed as a batch of rows, the other axes in panels of columns that are gathered into contiguous rows with a
+/// cache-oblivious transpose, so that no transform reads strided memory.
+/// @param in Input with as many elements as the product of the extents
+/// @param out Output of the same size, may be the same span as the input
+/// @param shape Extent of each axis, the inverse transform is scaled by 1 / product of the extents
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftNd(const std::type_identity_t<std::span<const BasicComplex<T>>> in, const std::span<BasicComplex<T>> out,
+           const std::span<const size_t> shape, const FftDirection direction, ThreadPool& pool) {
+  if (shape.empty()) throw std::invalid_argument("FftNd: shape must not be empty");
+  std::size_t total = 1;
+  for (const size_t extent : shape) {
+    if (extent == 0) throw std::invalid_argument("FftNd: extents must be positive");
+    total *= extent;
+    if (total > MAX_ELEMENT_COUNT) throw std::length_error("FftNd: size exceeds MAX_ELEMENT_COUNT");
+  }
+  checkSize(in.size(), out.size(), total);
+
+  // The first transformed axis reads the input, all further axes work in place on the output
+  const BasicComplex<T>* source = in.data();
+  std::size_t inner = 1;
+  for (std::size_t axis = shape.size(); axis-- > 0;) {
+    const std::size_t n = shape[axis];
+    if (n > 1) {
+      if (inner == 1) {
+        fftBatch<T>(std::span(source, total), out, static_cast<size_t>(n), direction, pool);
+      } else {
+        const std::shared_ptr<const BasicFftPlan<T>> plan = fftPlan<T>(static_cast<size_t>(n), direction);
+        transformAxis<T>(source, out.data(), total / (n * inner), n, inner, *plan, pool);
+      }
+      source = out.data();
+    }
+    inner *= n;
+  }
+  if (source != out.data()) std::copy(in.begin(), in.end(), out.begin());
+}
+
+/// Multidimensional transform of an array in row-major order in place
+/// @param data Input and output with as many elements as the product of the extents
+/// @param shape Extent of each axis
+/// @param direction Forward or inverse transform
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void fftNd(const std::span<BasicComplex<T>> data, const std::span<const size_t> shape, const FftDirection direction,
+           ThreadPool& pool) {
+  fftNd<T>(data, data, shape, direction, pool);
+}
+
+/// Transposes a matrix in row-major order with a cache-oblivious recursion over blocks
+/// @param in Matrix with rows * cols elements
+/// @param out Transposed matrix with cols rows of rows elements, must not overlap the input
+/// @param rows Number of rows of the input
+/// @param cols Number of columns of the input
+/// @param pool Threads that transpose bands of rows
+template <scalar T>
+void transpose(const std::type_identity_t<std::span<const BasicComplex<T>>> in, const std::span<BasicComplex<T>> out,
+               const size_t rows, const size_t cols, ThreadPool& pool) {
+  checkSize(in.size(), out.size(), std::size_t(rows) * cols);
+  const std::size_t bands = (rows + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+  pool.parallelFor(0, bands, grainSize(TRANSPOSE_BLOCK * cols), [&](const std::size_t band) {
+    const std::size_t first = band * TRANSPOSE_BLOCK;
+    const std::size_t count = std::min<std::size_t>(TRANSPOSE_BLOCK, rows - first);
+    transposeBlock(in.data() + first * cols, cols, out.data() + first, rows, count, cols);
+  });
+}
+
+#define MATH_INSTANTIATE_FFT_ND(T)                                                                              \
+  template void fftBatch<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>, size_t, FftDirection, \
+                            ThreadPool&);                                                                       \
+  template void fftBatch<T>(std::span<BasicComplex<T>>, size_t, FftDirection, ThreadPool&);                     \
+  template void fftNd<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>, std::span<const size_t>, \
+                         FftDirection, ThreadPool&);                                                            \
+  template void fftNd<T>(std::span<BasicComplex<T>>, std::span<const size_t>, FftDirection, ThreadPool&);       \
+  template void transpose<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>, size_t, size_t, ThreadPool&);
+
+MATH_INSTANTIATE_FFT_ND(float)
+MATH_INSTANTIATE_FFT_ND(double)
+MATH_INSTANTIATE_FFT_ND(long double)
+
+}  // namespace Math
@@ -0,0 +1,267 @@
+#include "Fir.h"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+#include "ComplexReduction.h"
+
+namespace Math {
+
+namespace {
+
+/// Number of new samples per block of the direct form and of the resampler
+constexpr size_t DIRECT_BLOCK_SIZE = 1024;
+
+/// Smallest transform of the overlap-save blocks, which amortizes the per-block overhead for short filters
+constexpr size_t MIN_BLOCK_TRANSFORM = 1024;
+
+/// Largest transform of the overlap-save blocks, a power of two of at least 2 * FIR_MAX_TAPS
+constexpr size_t MAX_BLOCK_TRANSFORM = 1U << 23;
+
+static_assert(MAX_BLOCK_TRANSFORM <= MAX_ELEMENT_COUNT && MAX_BLOCK_TRANSFORM >= 2 * FIR_MAX_TAPS);
+
+void checkSize(const std::size_t size, const std::size_t expected) {
+  if (size != expected) throw std::invalid_argument("FirFilter: operands differ in size");
+}
+
+/// Copies the elements of from to the start of to, which may overlap from if it starts before it
+template <typename T>
+void copy(const SplitSpan<const T> from, const SplitSpan<T> to) {
+  std::copy(from.realData(), from.realData() + from.size(), to.realData());
+  std::copy(from.imagData(), from.imagData() + from.size(), to.imagData());
+}
+
+/// Moves the last history elements of buffer[0, history + count) to its start
+template <typename T>
+void shiftHistory(const SplitSpan<T> buffer, const size_t history, const size_t count) {
+  copy<T>(buffer.subspan(count, history), buffer);
+}
+
+template <typename T>
+void clear(const SplitSpan<T> z) {
+  std::fill(z.realData(), z.realData() + z.size(), T(0));
+  std::fill(z.imagData(), z.imagData() + z.size(), T(0));
+}
+
+/// @return Number of taps after checking it
+template <typename T>
+size_t checkedTaps(const SplitSpan<const T> taps, const char* message) {
+  if (taps.empty()) throw std::invalid_argument(message);
+  if (taps.size() > FIR_MAX_TAPS) throw std::length_error("FirFilter: number of taps exceeds FIR_MAX_TAPS");
+  return taps.size();
+}
+
+}  // namespace
+
+/// Creates a filter with zero history
+/// @param taps Impulse response, between 1 and FIR_MAX_TAPS numbers
+/// @param method Algorithm, by default chosen from the number of taps
+template <scalar T>
+BasicFirFilter<T>::BasicFirFilter(const std::type_identity_t<SplitSpan<const T>> taps, const FirMethod method)
+    : m_Method(method), m_Reversed(checkedTaps(taps, "FirFilter: no taps")), m_BlockSize(DIRECT_BLOCK_SIZE) {
+  const size_t m = taps.size();
+  for (size_t k = 0; k < m; ++k) m_Reversed[k] = taps[m - 1 - k];
+  if (m_Method == FirMethod::Automatic) m_Method = m <= FIR_DIRECT_TAPS ? FirMethod::Direct : FirMethod::OverlapSave;
+  if (m_Method == FirMethod::OverlapSave) {
+    // About four new samples per tap in every block
+    const size_t n = std::clamp(std::bit_ceil(4 * m), MIN_BLOCK_TRANSFORM, MAX_BLOCK_TRANSFORM);
+    m_BlockSize = n - m + 1;
+    m_Forward = fftPlan<T>(n, FftDirection::Forward);
+    m_Inverse = fftPlan<T>(n, FftDirection::Inverse);
+    m_Spectrum.assign(n, BasicComplex<T>());
+    for (size_t k = 0; k < m; ++k) m_Spectrum[k] = taps[k];
+    m_Forward->execute(m_Spectrum);
+    m_Block.resize(n);
+  }
+  m_Buffer.resize(history() + m_BlockSize);
+  m_Scratch.resize(m_BlockSize);
+}
+
+/// Filters at most m_BlockSize samples
+/// @param in Input samples
+/// @param out Output samples of the same size, may alias in
+template <scalar T>
+void BasicFirFilter<T>::filterBlock(const SplitSpan<const T> in, const SplitSpan<T> out) {
+  const size_t h = history();
+  const size_t count = in.size();
+  const SplitSpan<T> buffer = m_Buffer.view().subspan(0, h + count);
+  copy<T>(in, buffer.subspan(h, count));
+  if (m_Method == FirMethod::Direct) {
+    slidingDot<T>(buffer, m_Reversed, out);
+  } else {
+    // Circular convolution of the history and the new samples with the taps; the outputs from h on do not wrap
+    const std::span<BasicComplex<T>> block(m_Block);
+    interleave<T>(buffer, block.subspan(0, h + count));
+    std::fill(block.begin() + h + count, block.end(), BasicComplex<T>());
+    m_Forward->execute(block);
+    for (std::size_t k = 0; k < block.size(); ++k) block[k] *= m_Spectrum[k];
+    m_Inverse->execute(block);
+    deinterleave<T>(block.subspan(h, count), out);
+  }
+  shiftHistory(m_Buffer.view(), h, count);
+}
+
+/// Filters the next samples of the stream. out may alias in. Overlap-save transforms at least one block per call.
+/// @param in Input samples
+/// @param out Output samples of the same size
+template <scalar T>
+void BasicFirFilter<T>::filter(const std::type_identity_t<SplitSpan<const T>> in, const SplitSpan<T> out) {
+  checkSize(in.size(), out.size());
+  for (size_t i = 0; i < in.size(); i += m_BlockSize) {
+    const size_t n = std::min(m_BlockSize, in.size() - i);
+    filterBlock(in.subspan(i, n), out.subspan(i, n));
+  }
+}
+
+/// Filters the next samples of the stream. out may alias in.
+/// @param in Interleaved input samples
+/// @param out Interleaved output samples of the same size
+template <scalar T>
+void BasicFirFilter<T>::filter(const std::type_identity_t<std::span<const BasicComplex<T>>> in,
+                               const std::span<BasicComplex<T>> out) {
+  checkSize(in.size(), out.size());
+  // Whole blocks, so that overlap-save runs one transform per block like the split overload
+  for (std::size_t i = 0; i < in.size(); i += m_BlockSize) {
+    const size_t n = static_cast<size_t>(std::min<std::size_t>(m_BlockSize, in.size() - i));
+    const SplitSpan<T> block = m_Scratch.view().subspan(0, n);
+    deinterleave<T>(in.subspan(i, n), block);
+    filterBlock(block, block);
+    interleave<T>(block, out.subspan(i, n));
+  }
+}
+
+/// Clears the history, so that the next sample starts a new stream
+template <scalar T>
+void BasicFirFilter<T>::reset() {
+  clear(m_Buffer.view().subspan(0, history()));
+}
+
+/// Creates a resampler with zero history
+/// @param taps Impulse response at the upsampled rate, between 1 and FIR_MAX_TAPS numbers
+/// @param interpolation Upsampling factor, at least 1
+/// @param decimation Downsampling factor, at least 1
+template <scalar T>
+BasicResampler<T>::BasicResampler(const std::type_identity_t<SplitSpan<const T>> taps, const size_t interpolation,
+                                  const size_t decimation)
+    : m_Interpolation(interpolation), m_Decimation(decimation), m_Length(0), m_Time(0) {
+  checkedTaps(taps, "Resampler: no taps");
+  if (interpolation == 0 || decimation == 0) throw std::invalid_argument("Resampler: factors must be positive");
+  m_Length = (taps.size() + interpolation - 1) / interpolation;
+  if (static_cast<std::size_t>(m_Length) * interpolation > MAX_ELEMENT_COUNT) {
+    throw std::length_error("Resampler: subfilters exceed MAX_ELEMENT_COUNT");
+  }
+  m_Phases.resize(m_Length * interpolation);
+  for (size_t p = 0; p < interpolation; ++p) {
+    for (size_t j = 0; j < m_Length && p + j * interpolation < taps.size(); ++j) {
+      m_Phases[p * m_Length + m_Length - 1 - j] = taps[p + j * interpolation];
+    }
+  }
+  m_Buffer.resize(history() + DIRECT_BLOCK_SIZE);
+}
+
+/// @param inputSize Number of input samples of the next call of resample
+/// @return Number of output samples that it writes
+template <scalar T>
+std::size_t BasicResampler<T>::outputSize(const std::size_t inputSize) const {
+  const uint64_t end = static_cast<uint64_t>(inputSize) * m_Interpolation;
+  return m_Time >= end ? 0 : static_cast<std::size_t>((end - m_Time + m_Decimation - 1) / m_Decimation);
+}
+
+/// Resamples at most DIRECT_BLOCK_SIZE samples
+/// @param in Input samples
+/// @param out Output samples, at least outputSize(in.size()) of them
+/// @return Number of output samples written
+template <scalar T>
+size_t BasicResampler<T>::resampleBlock(const SplitSpan<const T> in, const SplitSpan<T> out) {
+  const size_t h = history();
+  const size_t count = static_cast<size_t>(outputSize(in.size()));
+  copy<T>(in, m_Buffer.view().subspan(h, in.size()));
+  // Outputs that are interpolation / g apart use the same subfilter, on inputs decimation / g apart
+  const size_t g = std::gcd(m_Interpolation, m_Decimation);
+  const size_t outStride = m_Interpolation / g;
+  const size_t inStride = m_Decimation / g;
+  for (size_t r = 0; r < std::min(outStride, count); ++r) {
+    const uint64_t time = m_Time + static_cast<uint64_t>(r) * m_Decimation;
+    const auto phase = static_cast<size_t>(time % m_Interpolation);
+    const auto first = static_cast<size_t>(time / m_Interpolation);
+    const size_t outputs = (count - r + outStride - 1) / outStride;
+    slidingDot<T>(m_Buffer.view().subspan(first, (outputs - 1) * inStride + m_Length),
+                  m_Phases.view().subspan(phase * m_Length, m_Length), out.subspan(r, (outputs - 1) * outStride + 1),
+                  inStride, outStride);
+  }
+  m_Time = m_Time + static_cast<uint64_t>(count) * m_Decimation - static_cast<uint64_t>(in.size()) * m_Interpolation;
+  shiftHistory(m_Buffer.view(), h, in.size());
+  return count;
+}
+
+/// Resamples the next samples of the stream
+/// @param in Input samples
+/// @param out Output samples, at least outputSize(in.size()) of them
+/// @return Number of output samples written
+template <scalar T>
+std::size_t BasicResampler<T>::resample(const std::type_identity_t<SplitSpan<const T>> in, const SplitSpan<T> out) {
+  if (out.size() < outputSize(in.size())) throw std::invalid_argument("Resampler: output is too small");
+  std::size_t written = 0;
+  for (size_t i = 0; i < in.size(); i += DIRECT_BLOCK_SIZE) {
+    const size_t n = std::min(DIRECT_BLOCK_SIZE, in.size() - i);
+    written += resampleBlock(in.subspan(i, n), out.subspan(static_cast<size_t>(written), out.size() - written));
+  }
+  return written;
+}
+
+/// Clears the history and the position, so that the next sample starts a new stream
+template <scalar T>
+void BasicResampler<T>::reset() {
+  clear(m_Buffer.view().subspan(0, history()));
+  m_Time = 0;
+}
+
+/// Full linear convolution, out[n] = sum x[k] h[n - k] for n < x.size() + h.size() - 1, in direct form or by
+/// overlap-save like BasicFirFilter
+/// @param x Signal
+/// @param h Kernel, not empty
+/// @param out Result of x.size() + h.size() - 1 numbers
+template <scalar T>
+void convolve(const std::type_identity_t<SplitSpan<const T>> x, const std::type_identity_t<SplitSpan<const T>> h,
+              const SplitSpan<T> out) {
+  if (h.empty()) throw std::invalid_argument("convolve: empty kernel");
+  if (out.size() != x.size() + h.size() - 1) {
+    throw std::invalid_argument("convolve: output size must be x.size() + h.size() - 1");
+  }
+  BasicFirFilter<T> filter(h);
+  filter.filter(x, out.subspan(0, x.size()));
+  // The tail is the response to the zeros after the signal
+  const SplitSpan<T> tail = out.subspan(x.size(), h.size() - 1);
+  clear(tail);
+  filter.filter(tail, tail);
+}
+
+/// Full cross-correlation, out[n] = sum x[k + n - (h.size() - 1)] conj(h[k]) for n < x.size() + h.size() - 1, the
+/// lags from -(h.size() - 1) to x.size() - 1
+/// @param x Signal
+/// @param h Template, not empty
+/// @param out Result of x.size() + h.size() - 1 numbers
+template <scalar T>
+void correlate(const std::type_identity_t<SplitSpan<const T>> x, const std::type_identity_t<SplitSpan<const T>> h,
+               const SplitSpan<T> out) {
+  if (h.empty()) throw std::invalid_argument("correlate: empty template");
+  BasicComplexArray<T> kernel(h.size());
+  for (size_t k = 0; k < h.size(); ++k) kernel[k] = conj(h[h.size() - 1 - k]);
+  convolve<T>(x, kernel, out);
+}
+
+#define MATH_INSTANTIATE_FIR(T)                                                          \
+  template class BasicFirFilter<T>;                                                      \
+  template class BasicResampler<T>;                                                      \
+  template void convolve<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>);       \
+  template void correlate<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>);
+
+MATH_INSTANTIATE_FIR(float)
+MATH_INSTANTIATE_FIR(double)
+MATH_INSTANTIATE_FIR(long double)
+
+#undef MATH_INSTANTIATE_FIR
+
+}  // namespace Math
@@ -0,0 +1,54 @@
+#ifndef MATH_PLAN_CACHE_H
+#define MATH_PLAN_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "Fft.h"
+
+namespace Math {
+
+/// Process wide cache of shared plans, keyed by size and direction. Plans are created on first use and stay valid
+/// while they are referenced, also after the cache was cleared.
+template <typename Plan>
+class PlanCache {
+protected:
+  std::mutex m_Mutex;
+  std::map<std::pair<size_t, FftDirection>, std::shared_ptr<const Plan>> m_Plans;
+
+public:
+  /// @return Cache of the plan type
+  static PlanCache& instance() {
+    static PlanCache cache;
+    return cache;
+  }
+
+  /// Get a plan from the cache, the plan is created if the cache has none for the key. The plan is built outside the
+  /// lock, so lookups of other plans do not wait for it. Threads that build the same plan at once keep the first one.
+  /// @param size Transform length
+  /// @param direction Forward or inverse transform
+  /// @return Shared plan
+  std::shared_ptr<const Plan> get(const size_t size, const FftDirection direction) {
+    const auto key = std::make_pair(size, direction);
+    {
+      const std::lock_guard lock(m_Mutex);
+      const auto it = m_Plans.find(key);
+      if (it != m_Plans.end()) return it->second;
+    }
+    std::shared_ptr<const Plan> plan = std::make_shared<const Plan>(size, direction);
+    const std::lock_guard lock(m_Mutex);
+    return m_Plans.try_emplace(key, std::move(plan)).first->second;
+  }
+
+  /// Removes all plans
+  void clear() {
+    const std::lock_guard lock(m_Mutex);
+    m_Plans.clear();
+  }
+};
+
+}  // namespace Math
+
+#endif  // MATH_PLAN_CACHE_H
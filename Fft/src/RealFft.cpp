@@ -0,0 +1,217 @@
+#include "RealFft.h"
+
+#include <algorithm>
+#include <numbers>
+#include <stdexcept>
+
+#include "PlanCache.h"
+
+namespace Math {
+
+namespace {
+
+/// @return Elements per parallel task of a batch, smaller tasks do not amortize the synchronization
+std::size_t grainSize(const std::size_t size) {
+  return std::max<std::size_t>(1, (std::size_t(1) << 14) / size);
+}
+
+}  // namespace
+
+/// Creates a plan
+/// @param size Length of the real signal, between 1 and MAX_ELEMENT_COUNT
+/// @param direction Forward (real to complex) or inverse (complex to real) transform
+template <scalar T>
+BasicRealFftPlan<T>::BasicRealFftPlan(const size_t size, const FftDirection direction)
+    : m_Size(size), m_Direction(direction) {
+  if (size == 0) throw std::invalid_argument("RealFftPlan: size must be positive");
+  if (size > MAX_ELEMENT_COUNT) throw std::length_error("RealFftPlan: size exceeds MAX_ELEMENT_COUNT");
+  if (size % 2 != 0) {
+    m_Complex = fftPlan<T>(size, direction);
+    return;
+  }
+  m_Complex = fftPlan<T>(size / 2, direction);
+  const long double sign = direction == FftDirection::Forward ? -1 : 1;
+  for (size_t k = 0; k <= size / 4; ++k) {
+    const long double angle = 2 * std::numbers::pi_v<long double> * k / size;
+    m_Twiddles.emplace_back(static_cast<T>(std::cos(angle)), static_cast<T>(sign * std::sin(angle)));
+  }
+}
+
+/// @return Number of complex numbers that execute needs as scratch memory
+template <scalar T>
+std::size_t BasicRealFftPlan<T>::workspaceSize() const {
+  if (m_Size % 2 != 0) return m_Size + m_Complex->workspaceSize();
+  if (m_Direction == FftDirection::Inverse) return m_Size / 2 + m_Complex->workspaceSize();
+  return m_Complex->workspaceSize();
+}
+
+template <scalar T>
+void BasicRealFftPlan<T>::checkDirection(const FftDirection direction) const {
+  if (direction != m_Direction) throw std::invalid_argument("RealFftPlan: wrong direction for this plan");
+}
+
+/// Transforms a real signal to its non-redundant bins, using a thread local workspace (forward plans only)
+/// @param in Real signal of length size()
+/// @param out Spectrum of length spectrumSize()
+template <scalar T>
+void BasicRealFftPlan<T>::execute(const std::span<const T> in, const std::span<complex_type> out) const {
+  thread_local AlignedVector<complex_type> workspace;
+  if (workspace.size() < workspaceSize()) workspace.resize(workspaceSize());
+  execute(in, out, workspace);
+}
+
+/// Transforms non-redundant bins to a real signal, using a thread local workspace (inverse plans only)
+/// @param in Spectrum of length spectrumSize()
+/// @param out Real signal of length size()
+template <scalar T>
+void BasicRealFftPlan<T>::execute(const std::span<const complex_type> in, const std::span<T> out) const {
+  thread_local AlignedVector<complex_type> workspace;
+  if (workspace.size() < workspaceSize()) workspace.resize(workspaceSize());
+  execute(in, out, workspace);
+}
+
+/// Transforms a real signal to its non-redundant bins with caller provided scratch memory (forward plans only)
+/// @param in Real signal of length size()
+/// @param out Spectrum of length spectrumSize()
+/// @param workspace Scratch memory of at least workspaceSize() elements
+template <scalar T>
+void BasicRealFftPlan<T>::execute(const std::span<const T> in, const std::span<complex_type> out,
+                                  const std::span<complex_type> workspace) const {
+  checkDirection(FftDirection::Forward);
+  if (in.size() != m_Size || out.size() != spectrumSize()) throw std::invalid_argument("RealFftPlan: size mismatch");
+  if (workspace.size() < workspaceSize()) throw std::invalid_argument("RealFftPlan: workspace too small");
+  const std::size_t n = m_Size;
+
+  if (n % 2 != 0) {
+    const std::span<complex_type> full = workspace.first(n);
+    for (std::size_t j = 0; j < n; ++j) full[j] = complex_type(in[j], 0);
+    m_Complex->execute(full, full, workspace.subspan(n));
+    std::copy_n(full.begin(), out.size(), out.begin());
+    out[0] = complex_type(out[0].real(), 0);
+    return;
+  }
+
+  // The packed signal z[j] = x[2j] + i x[2j + 1] is transformed in the first half of the output. With the spectra E
+  // and O of the even and odd samples, Z[k] = E[k] + i O[k] and conj(Z[m - k]) = E[k] - i O[k], so that
+  // X[k] = E[k] + W^k O[k] and X[m - k] = conj(E[k] - W^k O[k]) follow from the pair Z[k], Z[m - k].
+  const std::size_t m = n / 2;
+  const std::span<complex_type> z = out.first(m);
+  for (std::size_t j = 0; j < m; ++j) z[j] = complex_type(in[2 * j], in[2 * j + 1]);
+  m_Complex->execute(z, z, workspace);
+
+  const complex_type z0 = z[0];
+  out[0] = complex_type(z0.real() + z0.imag(), 0);
+  out[m] = complex_type(z0.real() - z0.imag(), 0);
+  for (std::size_t k = 1; 2 * k <= m; ++k) {
+    const complex_type a = out[k];
+    const complex_type b = conj(out[m - k]);
+    const complex_type even = T(0.5) * (a + b);
+    const complex_type difference = T(0.5) * (a - b);
+    const complex_type odd(difference.imag(), -difference.real());
+    const complex_type t = m_Twiddles[k] * odd;
+    out[k] = even + t;
+    if (2 * k != m) out[m - k] = conj(even - t);
+  }
+}
+
+/// Transforms non-redundant bins to a real signal with caller provided scratch memory (inverse plans only)
+/// @param in Spectrum of length spectrumSize()
+/// @param out Real signal of length size()
+/// @param workspace Scratch memory of at least workspaceSize() elements
+template <scalar T>
+void BasicRealFftPlan<T>::execute(const std::span<const complex_type> in, const std::span<T> out,
+                                  const std::span<complex_type> workspace) const {
+  checkDirection(FftDirection::Inverse);
+  if (in.size() != spectrumSize() || out.size() != m_Size) throw std::invalid_argument("RealFftPlan: size mismatch");
+  if (workspace.size() < workspaceSize()) throw std::invalid_argument("RealFftPlan: workspace too small");
+  const std::size_t n = m_Size;
+
+  if (n % 2 != 0) {
+    const std::span<complex_type> full = workspace.first(n);
+    full[0] = complex_type(in[0].real(), 0);
+    for (std::size_t k = 1; k < in.size(); ++k) {
+      full[k] = in[k];
+      full[n - k] = conj(in[k]);
+    }
+    m_Complex->execute(full, full, workspace.subspan(n));
+    for (std::size_t j = 0; j < n; ++j) out[j] = full[j].real();
+    return;
+  }
+
+  // Inverse of the forward separation: E[k] = (X[k] + conj(X[m - k])) / 2, O[k] = W^-k (X[k] - conj(X[m - k])) / 2
+  // and Z[k] = E[k] + i O[k], Z[m - k] = conj(E[k] - i O[k])
+  const std::size_t m = n / 2;
+  const std::span<complex_type> z = workspace.first(m);
+  z[0] = complex_type(T(0.5) * (in[0].real() + in[m].real()), T(0.5) * (in[0].real() - in[m].real()));
+  for (std::size_t k = 1; 2 * k <= m; ++k) {
+    const complex_type a = in[k];
+    const complex_type b = conj(in[m - k]);
+    const complex_type even = T(0.5) * (a + b);
+    const complex_type odd = m_Twiddles[k] * (T(0.5) * (a - b));
+    const complex_type rotated(-odd.imag(), odd.real());
+    z[k] = even + rotated;
+    if (2 * k != m) z[m - k] = conj(even - rotated);
+  }
+  m_Complex->execute(z, z, workspace.subspan(m));
+  for (std::size_t j = 0; j < m; ++j) {
+    out[2 * j] = z[j].real();
+    out[2 * j + 1] = z[j].imag();
+  }
+}
+
+/// Get a real plan from the process wide cache, keyed by size and direction. The plan is created on first use.
+/// @param size Length of the real signal
+/// @param direction Forward (real to complex) or inverse (complex to real) transform
+/// @return Shared plan
+template <scalar T>
+std::shared_ptr<const BasicRealFftPlan<T>> realFftPlan(const size_t size, const FftDirection direction) {
+  return PlanCache<BasicRealFftPlan<T>>::instance().get(size, direction);
+}
+
+/// Transforms a batch of contiguous real signals of equal length, distributed over the threads of a pool
+/// @param in Real signals of length size, stored one after the other
+/// @param out Spectra of length size / 2 + 1, stored one after the other
+/// @param size Length of each signal
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void rfftBatch(const std::type_identity_t<std::span<const T>> in, const std::span<BasicComplex<T>> out,
+               const size_t size, ThreadPool& pool) {
+  if (size == 0 || in.size() % size != 0) throw std::invalid_argument("RealFft: size must divide the batch");
+  const std::size_t count = in.size() / size;
+  const std::size_t bins = size / 2 + 1;
+  if (out.size() != count * bins) throw std::invalid_argument("RealFft: size mismatch");
+  const std::shared_ptr<const BasicRealFftPlan<T>> plan = realFftPlan<T>(size, FftDirection::Forward);
+  pool.parallelFor(0, count, grainSize(size), [&](const std::size_t i) {
+    plan->execute(in.subspan(i * size, size), out.subspan(i * bins, bins));
+  });
+}
+
+/// Transforms a batch of contiguous spectra back to real signals of equal length, scaled by 1/size
+/// @param in Spectra of length size / 2 + 1, stored one after the other
+/// @param out Real signals of length size, stored one after the other
+/// @param size Length of each signal
+/// @param pool Threads that execute the transforms
+template <scalar T>
+void irfftBatch(const std::type_identity_t<std::span<const BasicComplex<T>>> in, const std::span<T> out,
+                const size_t size, ThreadPool& pool) {
+  if (size == 0 || out.size() % size != 0) throw std::invalid_argument("RealFft: size must divide the batch");
+  const std::size_t count = out.size() / size;
+  const std::size_t bins = size / 2 + 1;
+  if (in.size() != count * bins) throw std::invalid_argument("RealFft: size mismatch");
+  const std::shared_ptr<const BasicRealFftPlan<T>> plan = realFftPlan<T>(size, FftDirection::Inverse);
+  pool.parallelFor(0, count, grainSize(size), [&](const std::size_t i) {
+    plan->execute(in.subspan(i * bins, bins), out.subspan(i * size, size));
+  });
+}
+
+#define MATH_INSTANTIATE_REAL_FFT(T)                                                                                   \
+  template class BasicRealFftPlan<T>;                                                                                  \
+  template std::shared_ptr<const BasicRealFftPlan<T>> realFftPlan<T>(size_t, FftDirection);                            \
+  template void rfftBatch<T>(std::span<const T>, std::span<BasicComplex<T>>, size_t, ThreadPool&);                     \
+  template void irfftBatch<T>(std::span<const BasicComplex<T>>, std::span<T>, size_t, ThreadPool&);
+
+MATH_INSTANTIATE_REAL_FFT(float)
+MATH_INSTANTIATE_REAL_FFT(double)
+MATH_INSTANTIATE_REAL_FFT(long double)
+
+}  // namespace Math
@@ -0,0 +1,144 @@
+#include "FftNd.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+#include <vector>
+
+#include "TestTolerance.h"
+
+using namespace Math;
+
+using Shape = std::vector<Math::size_t>;
+
+namespace {
+
+std::vector<Complex> testSignal(const std::size_t size) {
+  std::vector<Complex> x(size);
+  for (std::size_t i = 0; i < size; ++i) x[i] = Complex(std::sin(0.37 * i + 0.2), std::cos(0.91 * i) - 0.3);
+  return x;
+}
+
+/// Direct evaluation of the transform along one axis of a row-major array
+std::vector<Complex> naiveAxis(const std::vector<Complex>& x, const Shape& shape, const std::size_t axis,
+                               const FftDirection direction) {
+  std::size_t inner = 1;
+  for (std::size_t a = axis + 1; a < shape.size(); ++a) inner *= shape[a];
+  const std::size_t n = shape[axis];
+  const std::size_t outer = x.size() / (n * inner);
+  const long double sign = direction == FftDirection::Forward ? -1 : 1;
+  const long double scale = direction == FftDirection::Inverse ? 1.0L / n : 1.0L;
+  std::vector<Complex> result(x.size());
+  for (std::size_t o = 0; o < outer; ++o) {
+    for (std::size_t i = 0; i < inner; ++i) {
+      for (std::size_t k = 0; k < n; ++k) {
+        long double re = 0;
+        long double im = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+          const long double angle = sign * 2 * std::numbers::pi_v<long double> * (j * k % n) / n;
+          const Complex& z = x[(o * n + j) * inner + i];
+          re += z.real() * std::cos(angle) - z.imag() * std::sin(angle);
+          im += z.real() * std::sin(angle) + z.imag() * std::cos(angle);
+        }
+        result[(o * n + k) * inner + i] = Complex(static_cast<real_t>(re * scale), static_cast<real_t>(im * scale));
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<Complex> naiveNd(std::vector<Complex> x, const Shape& shape, const FftDirection direction) {
+  for (std::size_t axis = 0; axis < shape.size(); ++axis) x = naiveAxis(x, shape, axis, direction);
+  return x;
+}
+
+void expectNear(const std::vector<Complex>& result, const std::vector<Complex>& expected, const real_t epsilon) {
+  ASSERT_EQ(result.size(), expected.size());
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    EXPECT_NEAR(result[i].real(), expected[i].real(), epsilon) << "index " << i;
+    EXPECT_NEAR(result[i].imag(), expected[i].imag(), epsilon) << "index " << i;
+  }
+}
+
+}  // namespace
+
+class FftNdTest : public ::testing::Test {
+protected:
+  ThreadPool m_Pool{4};
+};
+
+TEST_F(FftNdTest, Batch) {
+  constexpr std::size_t SIZE = 60;
+  constexpr std::size_t COUNT = 301;
+  const std::vector<Complex> x = testSignal(SIZE * COUNT);
+  std::vector<Complex> y(x.size());
+  fftBatch<real_t>(x, y, SIZE, FftDirection::Forward, m_Pool);
+  expectNear(y, naiveAxis(x, {COUNT, SIZE}, 1, FftDirection::Forward), scaledTolerance<real_t>(1e-12));
+  fftBatch<real_t>(y, SIZE, FftDirection::Inverse, m_Pool);
+  expectNear(y, x, scaledTolerance<real_t>(1e-14));
+  EXPECT_THROW(fftBatch<real_t>(y, 11, FftDirection::Forward, m_Pool), std::invalid_argument);
+  EXPECT_THROW(fftBatch<real_t>(x, std::span<Complex>(y).first(SIZE), SIZE, FftDirection::Forward, m_Pool),
+               std::invalid_argument);
+}
+
+TEST_F(FftNdTest, TwoDimensional) {
+  for (const auto& shape : {Shape{48, 40}, Shape{7, 33}, Shape{1, 64},
+                            Shape{64, 1}, Shape{37, 17}}) {
+    const std::vector<Complex> x = testSignal(std::size_t(shape[0]) * shape[1]);
+    std::vector<Complex> y(x.size());
+    fftNd<real_t>(x, y, shape, FftDirection::Forward, m_Pool);
+    expectNear(y, naiveNd(x, shape, FftDirection::Forward), scaledTolerance<real_t>(1e-11));
+    fftNd<real_t>(y, shape, FftDirection::Inverse, m_Pool);
+    expectNear(y, x, scaledTolerance<real_t>(1e-14));
+  }
+}
+
+TEST_F(FftNdTest, ThreeDimensional) {
+  const Shape shape = {6, 20, 18};
+  const std::vector<Complex> x = testSignal(6 * 20 * 18);
+  std::vector<Complex> y = x;
+  fftNd<real_t>(y, shape, FftDirection::Forward, m_Pool);
+  expectNear(y, naiveNd(x, shape, FftDirection::Forward), scaledTolerance<real_t>(1e-11));
+  fftNd<real_t>(y, shape, FftDirection::Inverse);
+  expectNear(y, x, scaledTolerance<real_t>(1e-14));
+}
+
+TEST_F(FftNdTest, TrivialShape) {
+  const std::vector<Complex> x = testSignal(5);
+  std::vector<Complex> y(5);
+  fftNd<real_t>(x, y, Shape{1, 5, 1}, FftDirection::Forward, m_Pool);
+  expectNear(y, naiveNd(x, {5}, FftDirection::Forward), scaledTolerance<real_t>(1e-14));
+  std::vector<Complex> one(1);
+  fftNd<real_t>(std::vector<Complex>{Complex(2, 3)}, one, Shape{1, 1}, FftDirection::Forward, m_Pool);
+  EXPECT_EQ(one[0].real(), 2);
+  EXPECT_EQ(one[0].imag(), 3);
+  EXPECT_THROW(fftNd<real_t>(y, Shape{2, 3}, FftDirection::Forward, m_Pool), std::invalid_argument);
+  EXPECT_THROW(fftNd<real_t>(y, Shape{}, FftDirection::Forward, m_Pool), std::invalid_argument);
+}
+
+TEST_F(FftNdTest, Transpose) {
+  for (const auto& [rows, cols] :
+       {std::pair<Math::size_t, Math::size_t>{1, 1}, {3, 70}, {70, 3}, {129, 65}, {256, 256}}) {
+    const std::vector<Complex> x = testSignal(std::size_t(rows) * cols);
+    std::vector<Complex> y(x.size());
+    transpose<real_t>(x, y, rows, cols, m_Pool);
+    for (std::size_t r = 0; r < rows; ++r) {
+      for (std::size_t c = 0; c < cols; ++c) {
+        ASSERT_EQ(y[c * rows + r].real(), x[r * cols + c].real());
+        ASSERT_EQ(y[c * rows + r].imag(), x[r * cols + c].imag());
+      }
+    }
+  }
+}
+
+TEST_F(FftNdTest, SinglePrecision) {
+  std::vector<ComplexF> x(32 * 24);
+  for (std::size_t i = 0; i < x.size(); ++i) x[i] = ComplexF(std::sin(0.1F * i), 0.5F);
+  std::vector<ComplexF> y(x.size());
+  fftNd<float>(x, y, Shape{32, 24}, FftDirection::Forward, m_Pool);
+  fftNd<float>(y, Shape{32, 24}, FftDirection::Inverse, m_Pool);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(y[i].real(), x[i].real(), 1e-5);
+    EXPECT_NEAR(y[i].imag(), x[i].imag(), 1e-5);
+  }
+}
@@ -0,0 +1,168 @@
+#include "Fft.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+#include "TestTolerance.h"
+
+using namespace Math;
+
+constexpr real_t TEST_EPSILON = scaledTolerance<real_t>(1e-14);
+
+namespace {
+
+/// Deterministic test signal
+template <typename T>
+std::vector<BasicComplex<T>> testSignal(const std::size_t size) {
+  std::vector<BasicComplex<T>> x(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    x[i] = BasicComplex<T>(static_cast<T>(std::sin(0.71 * i + 0.2)), static_cast<T>(std::cos(1.37 * i - 0.4) + 0.1));
+  }
+  return x;
+}
+
+/// Direct evaluation of the discrete Fourier transform in extended precision
+template <typename T>
+std::vector<BasicComplex<T>> naiveDft(const std::vector<BasicComplex<T>>& x, const FftDirection direction) {
+  const std::size_t n = x.size();
+  const long double sign = direction == FftDirection::Forward ? -1 : 1;
+  std::vector<BasicComplex<T>> result(n);
+  for (std::size_t k = 0; k < n; ++k) {
+    long double re = 0;
+    long double im = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+      const long double angle = sign * 2 * std::numbers::pi_v<long double> * static_cast<long double>(j * k % n) / n;
+      re += x[j].real() * std::cos(angle) - x[j].imag() * std::sin(angle);
+      im += x[j].real() * std::sin(angle) + x[j].imag() * std::cos(angle);
+    }
+    const long double scale = direction == FftDirection::Inverse ? 1.0L / n : 1.0L;
+    result[k] = BasicComplex<T>(static_cast<T>(re * scale), static_cast<T>(im * scale));
+  }
+  return result;
+}
+
+/// @return Largest error relative to the root mean square of the expected values
+template <typename T>
+real_t relativeError(const std::vector<BasicComplex<T>>& result, const std::vector<BasicComplex<T>>& expected) {
+  real_t error = 0;
+  real_t norm = 0;
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    error = std::max(error, static_cast<real_t>(abs(result[i] - expected[i])));
+    norm += static_cast<real_t>(abs2(expected[i]));
+  }
+  return error / std::sqrt(norm / static_cast<real_t>(result.size()));
+}
+
+}  // namespace
+
+class FftSizeTest : public ::testing::TestWithParam<std::size_t> {};
+
+TEST_P(FftSizeTest, MatchesDft) {
+  const std::size_t n = GetParam();
+  const std::vector<Complex> x = testSignal<real_t>(n);
+  std::vector<Complex> forward(n);
+  std::vector<Complex> inverse(n);
+  fft<real_t>(x, forward);
+  ifft<real_t>(x, inverse);
+  EXPECT_LT(relativeError(forward, naiveDft(x, FftDirection::Forward)), TEST_EPSILON);
+  EXPECT_LT(relativeError(inverse, naiveDft(x, FftDirection::Inverse)), TEST_EPSILON);
+}
+
+TEST_P(FftSizeTest, RoundTrip) {
+  const std::size_t n = GetParam();
+  const std::vector<Complex> x = testSignal<real_t>(n);
+  std::vector<Complex> y = x;
+  fft<real_t>(y);
+  ifft<real_t>(y);
+  EXPECT_LT(relativeError(y, x), TEST_EPSILON);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, FftSizeTest,
+                         ::testing::Values(1, 2, 3, 4, 5, 6, 7, 8, 11, 12, 13, 16, 25, 30, 31, 49, 60, 64, 97, 120, 121,
+                                           128, 210, 243, 256, 289, 360, 500, 509, 1000, 1009, 1024, 2310));
+
+TEST(FftTest, Bluestein) {
+  EXPECT_FALSE(FftPlan(1024, FftDirection::Forward).usesBluestein());
+  EXPECT_FALSE(FftPlan(7, FftDirection::Forward).usesBluestein());
+  EXPECT_TRUE(FftPlan(1009, FftDirection::Forward).usesBluestein());
+  EXPECT_TRUE(FftPlan(2 * 1009, FftDirection::Inverse).usesBluestein());
+}
+
+TEST(FftTest, ExecuteVariants) {
+  constexpr std::size_t N = 360;
+  const FftPlan plan(N, FftDirection::Forward);
+  const std::vector<Complex> x = testSignal<real_t>(N);
+  const std::vector<Complex> expected = naiveDft(x, FftDirection::Forward);
+
+  std::vector<Complex> out(N);
+  plan.execute(x, out);
+  EXPECT_LT(relativeError(out, expected), TEST_EPSILON);
+
+  std::vector<Complex> data = x;
+  plan.execute(data);
+  EXPECT_LT(relativeError(data, expected), TEST_EPSILON);
+
+  std::vector<Complex> workspace(plan.workspaceSize());
+  plan.execute(x, out, workspace);
+  EXPECT_LT(relativeError(out, expected), TEST_EPSILON);
+
+  EXPECT_THROW(plan.execute(x, std::span<Complex>(out).first(N - 1)), std::invalid_argument);
+  EXPECT_THROW(plan.execute(x, out, std::span<Complex>(workspace).first(N)), std::invalid_argument);
+  EXPECT_THROW(FftPlan(0, FftDirection::Forward), std::invalid_argument);
+  EXPECT_THROW(FftPlan(MAX_ELEMENT_COUNT + 1, FftDirection::Forward), std::length_error);
+}
+
+TEST(FftTest, PlanCache) {
+  const auto forward = fftPlan(96, FftDirection::Forward);
+  EXPECT_EQ(fftPlan(96, FftDirection::Forward), forward);
+  EXPECT_NE(fftPlan(96, FftDirection::Inverse), forward);
+  EXPECT_NE(fftPlan(97, FftDirection::Forward), forward);
+  EXPECT_EQ(forward->size(), 96);
+  clearFftPlanCache();
+  EXPECT_NE(fftPlan(96, FftDirection::Forward), forward);
+  EXPECT_EQ(forward->size(), 96);
+  // Threads that build the same plan at once all get the one that was cached first
+  std::vector<std::shared_ptr<const FftPlan>> plans(4);
+  std::vector<std::thread> threads;
+  for (auto& plan : plans) threads.emplace_back([&plan] { plan = fftPlan(1009, FftDirection::Forward); });
+  for (std::thread& thread : threads) thread.join();
+  for (const auto& plan : plans) EXPECT_EQ(plan, fftPlan(1009, FftDirection::Forward));
+}
+
+TEST(FftTest, Impulse) {
+  std::vector<Complex> x(48);
+  x[5] = Complex(1, 0);
+  fft<real_t>(x);
+  for (std::size_t k = 0; k < x.size(); ++k) {
+    const real_t angle = -2 * std::numbers::pi * static_cast<real_t>(5 * k % 48) / 48;
+    EXPECT_NEAR(x[k].real(), std::cos(angle), TEST_EPSILON / 10);
+    EXPECT_NEAR(x[k].imag(), std::sin(angle), TEST_EPSILON / 10);
+  }
+}
+
+TEST(FftTest, SinglePrecision) {
+  for (const std::size_t n : {64, 100, 127, 1009}) {
+    const std::vector<ComplexF> x = testSignal<float>(n);
+    std::vector<ComplexF> y(n);
+    fft<float>(x, y);
+    EXPECT_LT(relativeError(y, naiveDft(x, FftDirection::Forward)), 2e-6) << n;
+    ifft<float>(y);
+    EXPECT_LT(relativeError(y, x), 2e-6) << n;
+  }
+}
+
+TEST(FftTest, MixedPrecision) {
+  if (!std::same_as<accumulator_t<float>, double>) GTEST_SKIP() << "float accumulates in float";
+  // Only the input and the output are rounded to float, the error does not grow with the size
+  for (const std::size_t n : {2048, 2053}) {
+    const std::vector<ComplexF> x = testSignal<float>(n);
+    std::vector<ComplexF> y(n);
+    fft<float>(x, y);
+    EXPECT_LT(relativeError(y, naiveDft(x, FftDirection::Forward)), 3e-7) << n;
+    ifft<float>(y);
+    EXPECT_LT(relativeError(y, x), 3e-7) << n;
+  }
+}
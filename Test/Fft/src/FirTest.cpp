@@ -0,0 +1,205 @@
+#include "Fir.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "ComplexReduction.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+template <scalar T>
+BasicComplexArray<T> randomArray(const std::size_t size, const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<T> uniform(-1, 1);
+  BasicComplexArray<T> z(static_cast<Math::size_t>(size));
+  for (std::size_t i = 0; i < size; ++i) z[i] = BasicComplex<T>(uniform(generator), uniform(generator));
+  return z;
+}
+
+/// y[n] = sum h[k] x[n - k] for n < x.size() + h.size() - 1, in long double
+template <scalar T>
+std::vector<BasicComplex<long double>> reference(const BasicComplexArray<T>& x, const BasicComplexArray<T>& h) {
+  std::vector<BasicComplex<long double>> y(x.size() + h.size() - 1);
+  for (std::size_t n = 0; n < y.size(); ++n) {
+    for (std::size_t k = 0; k < h.size(); ++k) {
+      if (n >= k && n - k < x.size()) {
+        y[n] += BasicComplex<long double>(h.real()[k], h.imag()[k]) *
+                BasicComplex<long double>(x.real()[n - k], x.imag()[n - k]);
+      }
+    }
+  }
+  return y;
+}
+
+/// Tolerance of a filter with m taps of magnitude up to 1
+template <scalar T>
+T tolerance(const std::size_t m) {
+  return scaledTolerance<T>(1e-14) * static_cast<T>(m + 10);
+}
+
+template <scalar T>
+void expectNear(const BasicComplex<T>& result, const BasicComplex<long double>& expected, const T tol) {
+  EXPECT_NEAR(result.real(), static_cast<T>(expected.real()), tol);
+  EXPECT_NEAR(result.imag(), static_cast<T>(expected.imag()), tol);
+}
+
+/// Filters a stream in pieces of random size and compares it with the reference
+template <scalar T>
+void expectStreaming(const std::size_t m, const FirMethod method) {
+  const BasicComplexArray<T> h = randomArray<T>(m, 1);
+  const BasicComplexArray<T> x = randomArray<T>(5000, 2);
+  const auto expected = reference(x, h);
+  BasicFirFilter<T> filter(h, method);
+  EXPECT_EQ(filter.size(), m);
+  EXPECT_NE(filter.method(), FirMethod::Automatic);
+  BasicComplexArray<T> y = x;
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<std::size_t> pieces(0, 700);
+  for (std::size_t i = 0; i < x.size();) {
+    const std::size_t n = std::min(pieces(generator), x.size() - i);
+    // In place
+    filter.filter(y.view().subspan(static_cast<Math::size_t>(i), static_cast<Math::size_t>(n)),
+                  y.view().subspan(static_cast<Math::size_t>(i), static_cast<Math::size_t>(n)));
+    i += n;
+  }
+  for (std::size_t n = 0; n < x.size(); ++n) expectNear<T>(y[n], expected[n], tolerance<T>(m));
+  // After a reset the stream starts over
+  filter.reset();
+  BasicComplexArray<T> again(x.size());
+  filter.filter(x, again);
+  for (std::size_t n = 0; n < x.size(); ++n) expectNear<T>(again[n], expected[n], tolerance<T>(m));
+}
+
+/// Upsamples by inserting zeros, filters and keeps every decimation-th sample
+template <scalar T>
+std::vector<BasicComplex<long double>> resampleReference(const BasicComplexArray<T>& x, const BasicComplexArray<T>& h,
+                                                         const std::size_t interpolation,
+                                                         const std::size_t decimation) {
+  BasicComplexArray<T> upsampled(static_cast<Math::size_t>(x.size() * interpolation));
+  for (std::size_t i = 0; i < x.size(); ++i) upsampled[i * interpolation] = x[i];
+  const auto filtered = reference(upsampled, h);
+  std::vector<BasicComplex<long double>> y;
+  for (std::size_t n = 0; n < upsampled.size(); n += decimation) y.push_back(filtered[n]);
+  return y;
+}
+
+template <scalar T>
+void expectResampling(const std::size_t m, const std::size_t interpolation, const std::size_t decimation) {
+  const BasicComplexArray<T> h = randomArray<T>(m, 4);
+  const BasicComplexArray<T> x = randomArray<T>(3000, 5);
+  const auto expected = resampleReference(x, h, interpolation, decimation);
+  BasicResampler<T> resampler(h, interpolation, decimation);
+  EXPECT_EQ(resampler.interpolation(), interpolation);
+  EXPECT_EQ(resampler.decimation(), decimation);
+  EXPECT_EQ(resampler.outputSize(x.size()), expected.size());
+  BasicComplexArray<T> y(static_cast<Math::size_t>(expected.size()));
+  std::size_t written = 0;
+  std::mt19937 generator(6);
+  std::uniform_int_distribution<std::size_t> pieces(0, 1500);
+  for (std::size_t i = 0; i < x.size();) {
+    const std::size_t n = std::min(pieces(generator), x.size() - i);
+    const std::size_t size = resampler.outputSize(n);
+    EXPECT_EQ(resampler.resample(x.view().subspan(static_cast<Math::size_t>(i), static_cast<Math::size_t>(n)),
+                                 y.view().subspan(static_cast<Math::size_t>(written),
+                                                  static_cast<Math::size_t>(y.size() - written))),
+              size);
+    written += size;
+    i += n;
+  }
+  ASSERT_EQ(written, expected.size());
+  for (std::size_t n = 0; n < written; ++n) expectNear<T>(y[n], expected[n], tolerance<T>(m));
+}
+
+}  // namespace
+
+TEST(FirTest, Direct) {
+  for (const std::size_t m : {1, 2, 7, 16, 48, 100}) {
+    expectStreaming<real_t>(m, FirMethod::Direct);
+    expectStreaming<float>(m, FirMethod::Direct);
+  }
+}
+
+TEST(FirTest, OverlapSave) {
+  for (const std::size_t m : {1, 2, 7, 49, 300, 1500}) {
+    expectStreaming<real_t>(m, FirMethod::OverlapSave);
+    expectStreaming<float>(m, FirMethod::OverlapSave);
+  }
+}
+
+TEST(FirTest, Automatic) {
+  const ComplexArray h = randomArray<real_t>(FIR_DIRECT_TAPS, 1);
+  EXPECT_EQ(FirFilter(h).method(), FirMethod::Direct);
+  EXPECT_EQ(FirFilter(randomArray<real_t>(FIR_DIRECT_TAPS + 1, 1)).method(), FirMethod::OverlapSave);
+  // Interleaved samples, in place
+  const ComplexArray x = randomArray<real_t>(1000, 2);
+  std::vector<Complex> interleaved(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) interleaved[i] = x[i];
+  FirFilter filter(h);
+  filter.filter(interleaved, interleaved);
+  const auto expected = reference(x, h);
+  for (std::size_t n = 0; n < x.size(); ++n) expectNear<real_t>(interleaved[n], expected[n], tolerance<real_t>(50));
+  // Overlap-save over more than one block
+  const ComplexArray g = randomArray<real_t>(FIR_DIRECT_TAPS + 1, 3);
+  FirFilter overlapSave(g);
+  EXPECT_EQ(overlapSave.blockSize(), 1024 - g.size() + 1);
+  for (std::size_t i = 0; i < x.size(); ++i) interleaved[i] = x[i];
+  overlapSave.filter(interleaved, interleaved);
+  const auto expectedOverlapSave = reference(x, g);
+  for (std::size_t n = 0; n < x.size(); ++n) {
+    expectNear<real_t>(interleaved[n], expectedOverlapSave[n], tolerance<real_t>(50));
+  }
+}
+
+TEST(FirTest, Convolution) {
+  for (const std::size_t m : {1, 10, 200}) {
+    const ComplexArray x = randomArray<real_t>(777, 7);
+    const ComplexArray h = randomArray<real_t>(m, 8);
+    ComplexArray y(static_cast<Math::size_t>(x.size() + m - 1));
+    convolve<real_t>(x, h, y);
+    const auto expected = reference(x, h);
+    for (std::size_t n = 0; n < y.size(); ++n) expectNear<real_t>(y[n], expected[n], tolerance<real_t>(m));
+    // Correlation with the template itself peaks at lag 0, index m - 1
+    ComplexArray c(static_cast<Math::size_t>(x.size() + m - 1));
+    correlate<real_t>(x, h, c);
+    ComplexArray kernel(static_cast<Math::size_t>(m));
+    for (std::size_t k = 0; k < m; ++k) kernel[k] = conj(h[m - 1 - k]);
+    const auto correlation = reference(x, kernel);
+    for (std::size_t n = 0; n < c.size(); ++n) expectNear<real_t>(c[n], correlation[n], tolerance<real_t>(m));
+    ComplexArray autocorrelation(static_cast<Math::size_t>(2 * m - 1));
+    correlate<real_t>(h, h, autocorrelation);
+    EXPECT_NEAR(autocorrelation[m - 1].real(), squaredNorm<real_t>(h), tolerance<real_t>(m));
+    EXPECT_NEAR(autocorrelation[m - 1].imag(), 0, tolerance<real_t>(m));
+  }
+}
+
+TEST(FirTest, Resampling) {
+  expectResampling<real_t>(30, 1, 1);
+  expectResampling<real_t>(61, 1, 4);
+  expectResampling<real_t>(64, 4, 1);
+  expectResampling<real_t>(95, 3, 2);
+  expectResampling<real_t>(95, 2, 3);
+  expectResampling<real_t>(7, 5, 7);
+  expectResampling<float>(120, 6, 4);
+}
+
+TEST(FirTest, Errors) {
+  EXPECT_THROW(FirFilter{ComplexArray()}, std::invalid_argument);
+  EXPECT_THROW((Resampler{ComplexArray(), 2}), std::invalid_argument);
+  EXPECT_THROW(Resampler(ComplexArray(3), 0, 1), std::invalid_argument);
+  EXPECT_THROW(Resampler(ComplexArray(3), 1, 0), std::invalid_argument);
+  FirFilter filter(ComplexArray(3));
+  ComplexArray x(5);
+  ComplexArray y(4);
+  EXPECT_THROW(filter.filter(x, y), std::invalid_argument);
+  EXPECT_THROW(convolve<real_t>(x, ComplexArray(), y), std::invalid_argument);
+  EXPECT_THROW(convolve<real_t>(x, ComplexArray(3), y), std::invalid_argument);
+  Resampler resampler(ComplexArray(4), 3, 1);
+  EXPECT_THROW(resampler.resample(x, y), std::invalid_argument);
+}
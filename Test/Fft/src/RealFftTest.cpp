@@ -0,0 +1,117 @@
+#include "RealFft.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+template <typename T>
+std::vector<T> testSignal(const std::size_t size) {
+  std::vector<T> x(size);
+  for (std::size_t i = 0; i < size; ++i) x[i] = static_cast<T>(std::sin(0.53 * i + 0.1) + 0.25 * std::cos(2.9 * i));
+  return x;
+}
+
+/// Reference: complex transform of the widened signal
+template <typename T>
+std::vector<BasicComplex<T>> complexSpectrum(const std::vector<T>& x) {
+  std::vector<BasicComplex<T>> z(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) z[i] = BasicComplex<T>(x[i], 0);
+  fft<T>(z);
+  return z;
+}
+
+}  // namespace
+
+class RealFftSizeTest : public ::testing::TestWithParam<std::size_t> {};
+
+TEST_P(RealFftSizeTest, MatchesComplexTransform) {
+  const std::size_t n = GetParam();
+  const std::vector<real_t> x = testSignal<real_t>(n);
+  const std::vector<Complex> expected = complexSpectrum(x);
+  std::vector<Complex> spectrum(n / 2 + 1);
+  rfft<real_t>(x, spectrum);
+  for (std::size_t k = 0; k < spectrum.size(); ++k) {
+    EXPECT_NEAR(spectrum[k].real(), expected[k].real(), scaledTolerance<real_t>(1e-13) * std::sqrt(n)) << k;
+    EXPECT_NEAR(spectrum[k].imag(), expected[k].imag(), scaledTolerance<real_t>(1e-13) * std::sqrt(n)) << k;
+  }
+  EXPECT_EQ(spectrum[0].imag(), 0);
+  if (n % 2 == 0) {
+    EXPECT_EQ(spectrum[n / 2].imag(), 0);
+  }
+}
+
+TEST_P(RealFftSizeTest, RoundTrip) {
+  const std::size_t n = GetParam();
+  const std::vector<real_t> x = testSignal<real_t>(n);
+  std::vector<Complex> spectrum(n / 2 + 1);
+  std::vector<real_t> y(n);
+  rfft<real_t>(x, spectrum);
+  irfft<real_t>(spectrum, y);
+  for (std::size_t i = 0; i < n; ++i) EXPECT_NEAR(y[i], x[i], scaledTolerance<real_t>(1e-14)) << i;
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, RealFftSizeTest,
+                         ::testing::Values(1, 2, 3, 4, 5, 6, 8, 9, 10, 12, 15, 16, 18, 62, 64, 100, 127, 256, 1000,
+                                           1022, 2018, 4096));
+
+TEST(RealFftTest, InverseIgnoresImaginaryEdgeBins) {
+  const std::vector<real_t> x = testSignal<real_t>(16);
+  std::vector<Complex> spectrum(9);
+  rfft<real_t>(x, spectrum);
+  spectrum[0] = Complex(spectrum[0].real(), 5);
+  spectrum[8] = Complex(spectrum[8].real(), -3);
+  std::vector<real_t> y(16);
+  irfft<real_t>(spectrum, y);
+  for (std::size_t i = 0; i < x.size(); ++i) EXPECT_NEAR(y[i], x[i], scaledTolerance<real_t>(1e-14));
+}
+
+TEST(RealFftTest, PlanErrors) {
+  const RealFftPlan forward(12, FftDirection::Forward);
+  EXPECT_EQ(forward.spectrumSize(), 7);
+  std::vector<real_t> x(12);
+  std::vector<Complex> spectrum(7);
+  EXPECT_THROW(forward.execute(spectrum, x), std::invalid_argument);
+  EXPECT_THROW(forward.execute(x, std::span<Complex>(spectrum).first(6)), std::invalid_argument);
+  EXPECT_THROW(RealFftPlan(0, FftDirection::Inverse), std::invalid_argument);
+  EXPECT_EQ(realFftPlan(12, FftDirection::Forward), realFftPlan(12, FftDirection::Forward));
+}
+
+TEST(RealFftTest, Batch) {
+  constexpr std::size_t SIZE = 30;
+  constexpr std::size_t COUNT = 123;
+  constexpr std::size_t BINS = SIZE / 2 + 1;
+  ThreadPool pool(3);
+  const std::vector<real_t> x = testSignal<real_t>(SIZE * COUNT);
+  std::vector<Complex> spectra(BINS * COUNT);
+  rfftBatch<real_t>(x, spectra, SIZE, pool);
+  for (std::size_t i = 0; i < COUNT; i += 17) {
+    const std::vector<real_t> signal(x.begin() + i * SIZE, x.begin() + (i + 1) * SIZE);
+    const std::vector<Complex> expected = complexSpectrum(signal);
+    for (std::size_t k = 0; k < BINS; ++k) {
+      EXPECT_NEAR(spectra[i * BINS + k].real(), expected[k].real(), scaledTolerance<real_t>(1e-13));
+      EXPECT_NEAR(spectra[i * BINS + k].imag(), expected[k].imag(), scaledTolerance<real_t>(1e-13));
+    }
+  }
+  std::vector<real_t> y(x.size());
+  irfftBatch<real_t>(spectra, y, SIZE, pool);
+  for (std::size_t i = 0; i < x.size(); ++i) EXPECT_NEAR(y[i], x[i], scaledTolerance<real_t>(1e-14));
+  EXPECT_THROW(rfftBatch<real_t>(x, std::span<Complex>(spectra).first(BINS), SIZE, pool), std::invalid_argument);
+  EXPECT_THROW(irfftBatch<real_t>(spectra, y, 29, pool), std::invalid_argument);
+}
+
+TEST(RealFftTest, SinglePrecision) {
+  for (const std::size_t n : {64, 99}) {
+    const std::vector<float> x = testSignal<float>(n);
+    std::vector<ComplexF> spectrum(n / 2 + 1);
+    std::vector<float> y(n);
+    rfft<float>(x, spectrum);
+    irfft<float>(spectrum, y);
+    for (std::size_t i = 0; i < n; ++i) EXPECT_NEAR(y[i], x[i], 1e-6);
+  }
+}
@@ -0,0 +1,20 @@
+#ifndef MATH_TEST_TOLERANCE_H
+#define MATH_TEST_TOLERANCE_H
+
+#include <limits>
+
+#include "Types.h"
+
+namespace Math {
+
+/// Converts a tolerance for double precision results to precision T, by the ratio of the machine epsilons
+/// @param tolerance Tolerance in double precision
+/// @return Tolerance in precision T
+template <scalar T>
+constexpr T scaledTolerance(const double tolerance) {
+  return static_cast<T>(tolerance * (std::numeric_limits<T>::epsilon() / std::numeric_limits<double>::epsilon()));
+}
+
+}  // namespace Math
+
+#endif  // MATH_TEST_TOLERANCE_H
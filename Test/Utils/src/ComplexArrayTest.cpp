@@ -0,0 +1,176 @@
+#include "ComplexArray.h"
+
+#include <complex>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Simd.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+constexpr real_t TEST_EPSILON = scaledTolerance<real_t>(1e-12);
+
+namespace {
+
+/// Deterministic test data with a length that is not a multiple of any vector width
+ComplexArray testArray(const std::size_t size, const real_t offset) {
+  ComplexArray z(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    z[i] = Complex(std::sin(0.37 * i + offset) * (1 + i), std::cos(1.13 * i - offset) * (2 + 0.5 * i));
+  }
+  return z;
+}
+
+void expectNear(const ComplexArray& result, const std::vector<Complex>& expected) {
+  ASSERT_EQ(result.size(), expected.size());
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    const real_t scale = 1 + abs(expected[i]);
+    EXPECT_NEAR(result[i].real(), expected[i].real(), TEST_EPSILON * scale) << "index " << i;
+    EXPECT_NEAR(result[i].imag(), expected[i].imag(), TEST_EPSILON * scale) << "index " << i;
+  }
+}
+
+template <typename F>
+std::vector<Complex> reference(const ComplexArray& z, F f) {
+  std::vector<Complex> result;
+  for (std::size_t i = 0; i < z.size(); ++i) result.push_back(f(static_cast<Complex>(z[i])));
+  return result;
+}
+
+}  // namespace
+
+class ComplexArrayTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  static constexpr std::size_t SIZE = 37;
+  const ComplexArray m_A = testArray(SIZE, 0.1);
+  const ComplexArray m_B = testArray(SIZE, 0.7);
+  const Complex m_C = Complex(1.5, -0.25);
+  const real_t m_R = 2.5;
+
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+
+  std::vector<Complex> zip(Complex (*f)(Complex, Complex)) const {
+    std::vector<Complex> result;
+    for (std::size_t i = 0; i < SIZE; ++i) result.push_back(f(m_A[i], m_B[i]));
+    return result;
+  }
+};
+
+TEST_P(ComplexArrayTest, Construction) {
+  const ComplexArray empty;
+  EXPECT_TRUE(empty.empty());
+  const ComplexArray filled(5, Complex(1, 2));
+  EXPECT_EQ(filled.size(), 5U);
+  EXPECT_DOUBLE_EQ(filled[4].real(), 1);
+  EXPECT_DOUBLE_EQ(filled[4].imag(), 2);
+  const ComplexArray list = {Complex(1, 2), Complex(3, 4)};
+  EXPECT_DOUBLE_EQ(list[1].real(), 3);
+  EXPECT_DOUBLE_EQ(list.imag()[1], 4);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(m_A.real().data()) % MEMORY_ALIGNMENT, 0U);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(m_A.imag().data()) % MEMORY_ALIGNMENT, 0U);
+  EXPECT_THROW(ComplexArray(MAX_ELEMENT_COUNT + 1), std::length_error);
+}
+
+TEST_P(ComplexArrayTest, ArrayArrayOperators) {
+  expectNear(m_A + m_B, zip([](Complex a, Complex b) { return a + b; }));
+  expectNear(m_A - m_B, zip([](Complex a, Complex b) { return a - b; }));
+  expectNear(m_A * m_B, zip([](Complex a, Complex b) { return a * b; }));
+  expectNear(m_A / m_B, zip([](Complex a, Complex b) { return a / b; }));
+  EXPECT_THROW(m_A + ComplexArray(SIZE + 1), std::invalid_argument);
+}
+
+TEST_P(ComplexArrayTest, ArrayComplexOperators) {
+  const Complex c = m_C;
+  expectNear(m_A + c, reference(m_A, [c](Complex z) { return z + c; }));
+  expectNear(c + m_A, reference(m_A, [c](Complex z) { return c + z; }));
+  expectNear(m_A - c, reference(m_A, [c](Complex z) { return z - c; }));
+  expectNear(c - m_A, reference(m_A, [c](Complex z) { return c - z; }));
+  expectNear(m_A * c, reference(m_A, [c](Complex z) { return z * c; }));
+  expectNear(c * m_A, reference(m_A, [c](Complex z) { return c * z; }));
+  expectNear(m_A / c, reference(m_A, [c](Complex z) { return z / c; }));
+  expectNear(c / m_A, reference(m_A, [c](Complex z) { return c / z; }));
+}
+
+TEST_P(ComplexArrayTest, ArrayRealOperators) {
+  const real_t r = m_R;
+  expectNear(m_A + r, reference(m_A, [r](Complex z) { return z + r; }));
+  expectNear(r + m_A, reference(m_A, [r](Complex z) { return r + z; }));
+  expectNear(m_A - r, reference(m_A, [r](Complex z) { return z - r; }));
+  expectNear(r - m_A, reference(m_A, [r](Complex z) { return r - z; }));
+  expectNear(m_A * r, reference(m_A, [r](Complex z) { return z * r; }));
+  expectNear(r * m_A, reference(m_A, [r](Complex z) { return r * z; }));
+  expectNear(m_A / r, reference(m_A, [r](Complex z) { return z / r; }));
+  expectNear(r / m_A, reference(m_A, [r](Complex z) { return r / z; }));
+}
+
+TEST_P(ComplexArrayTest, CompoundAssignment) {
+  ComplexArray z = m_A;
+  z *= m_B;
+  z += m_C;
+  z /= m_R;
+  expectNear(z, zip([](Complex a, Complex b) { return (a * b + Complex(1.5, -0.25)) / 2.5; }));
+}
+
+TEST_P(ComplexArrayTest, UnaryFunctions) {
+  expectNear(-m_A, reference(m_A, [](Complex z) { return -z; }));
+  expectNear(conj(m_A), reference(m_A, [](Complex z) { return conj(z); }));
+  const RealArray magnitudes = abs(m_A);
+  const RealArray squaredMagnitudes = abs2(m_A);
+  const RealArray arguments = arg(m_A);
+  for (std::size_t i = 0; i < SIZE; ++i) {
+    const std::complex<real_t> std_z(m_A[i].real(), m_A[i].imag());
+    EXPECT_NEAR(magnitudes[i], std::abs(std_z), TEST_EPSILON * magnitudes[i]);
+    EXPECT_NEAR(squaredMagnitudes[i], std::norm(std_z), TEST_EPSILON * squaredMagnitudes[i]);
+    EXPECT_NEAR(arguments[i], std::arg(std_z), TEST_EPSILON);
+  }
+}
+
+TEST_P(ComplexArrayTest, ArgQuadrants) {
+  const ComplexArray z = {Complex(1, 0),   Complex(-1, 0),  Complex(0, 1),    Complex(0, -1),  Complex(0, 0),
+                          Complex(-1, -0.0), Complex(3, 4), Complex(-3, 4),   Complex(-3, -4), Complex(3, -4),
+                          Complex(1e-300, 1), Complex(1, 1e-300), Complex(-2, 1e-3), Complex(0.5, 0.49),
+                          Complex(0.5, 0.34), Complex(-7, -6.9)};
+  const RealArray arguments = arg(z);
+  constexpr real_t tolerance = scaledTolerance<real_t>(2e-16);
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    EXPECT_NEAR(arguments[i], std::atan2(z[i].imag(), z[i].real()), tolerance * std::abs(arguments[i]))
+        << "index " << i;
+  }
+}
+
+TEST_P(ComplexArrayTest, SinglePrecision) {
+  BasicComplexArray<float> a(19);
+  BasicComplexArray<float> b(19);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = ComplexF(0.5F * i - 3, 1.25F - 0.3F * i);
+    b[i] = ComplexF(1 + 0.1F * i, 0.7F);
+  }
+  const BasicComplexArray<float> quotient = a / b;
+  const AlignedVector<float> arguments = arg(a);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const ComplexF expected = static_cast<ComplexF>(a[i]) / static_cast<ComplexF>(b[i]);
+    EXPECT_NEAR(quotient[i].real(), expected.real(), 1e-5F);
+    EXPECT_NEAR(quotient[i].imag(), expected.imag(), 1e-5F);
+    EXPECT_NEAR(arguments[i], std::atan2(a[i].imag(), a[i].real()), 1e-6F);
+  }
+}
+
+TEST_P(ComplexArrayTest, Interleave) {
+  std::vector<Complex> interleaved(SIZE);
+  interleave<real_t>(m_A, interleaved);
+  ComplexArray z(SIZE);
+  deinterleave<real_t>(interleaved, z);
+  expectNear(z, reference(m_A, [](Complex x) { return x; }));
+  expectNear(ComplexArray(std::span<const Complex>(interleaved)), reference(m_A, [](Complex x) { return x; }));
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, ComplexArrayTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
@@ -0,0 +1,432 @@
+#include "ComplexDecomposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+ComplexMatrix randomMatrix(const std::size_t rows, const std::size_t cols, const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<real_t> distribution(-1, 1);
+  ComplexMatrix m(rows, cols);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) {
+      m(i, j) = Complex(distribution(generator), distribution(generator));
+    }
+  }
+  return m;
+}
+
+real_t largest(const ComplexMatrixView<const real_t> m) {
+  real_t result = 0;
+  for (std::size_t i = 0; i < m.rows(); ++i) {
+    for (std::size_t j = 0; j < m.cols(); ++j) result = std::max(result, abs(m(i, j)));
+  }
+  return result;
+}
+
+/// Expects |A X - B| <= tolerance |A| |X| n elementwise, the backward error of a stable solver
+void expectSolution(const ComplexMatrixView<const real_t> a, const ComplexMatrixView<const real_t> x,
+                    const ComplexMatrixView<const real_t> b, const double tolerance) {
+  ASSERT_EQ(x.rows(), a.cols());
+  ASSERT_EQ(x.cols(), b.cols());
+  ComplexMatrix residual(b);
+  gemm(Complex(1, 0), a, x, Complex(-1, 0), residual.view());
+  EXPECT_LE(largest(residual.view()),
+            scaledTolerance<real_t>(tolerance) * largest(a) * largest(x) * static_cast<real_t>(a.cols()));
+}
+
+void expectNear(const ComplexMatrixView<const real_t> result, const ComplexMatrixView<const real_t> expected,
+                const real_t epsilon) {
+  ASSERT_EQ(result.rows(), expected.rows());
+  ASSERT_EQ(result.cols(), expected.cols());
+  for (std::size_t i = 0; i < result.rows(); ++i) {
+    for (std::size_t j = 0; j < result.cols(); ++j) {
+      EXPECT_NEAR(result(i, j).real(), expected(i, j).real(), epsilon) << i << ", " << j;
+      EXPECT_NEAR(result(i, j).imag(), expected(i, j).imag(), epsilon) << i << ", " << j;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ComplexDecompositionTest, LuSolve) {
+  // Sizes around the block size exercise the unblocked, blocked and partial panels
+  for (const std::size_t n : {1, 2, 7, 63, 64, 65, 150}) {
+    const ComplexMatrix a = randomMatrix(n, n, static_cast<unsigned>(n));
+    const ComplexMatrix b = randomMatrix(n, 5, static_cast<unsigned>(n + 1));
+    const LuDecomposition lu(a);
+    EXPECT_EQ(lu.size(), n);
+    EXPECT_FALSE(lu.singular());
+    const ComplexMatrix x = lu.solve(b);
+    expectSolution(a, x, b, 1e-14);
+
+    // P A = L U
+    ComplexMatrix l(n, n);
+    ComplexMatrix u(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        if (i > j) l(i, j) = lu.factors()(i, j);
+        if (i <= j) u(i, j) = lu.factors()(i, j);
+      }
+      l(i, i) = Complex(1, 0);
+    }
+    ComplexMatrix pa(a);
+    for (std::size_t i = 0; i < n; ++i) {
+      ASSERT_GE(lu.pivots()[i], i);
+      for (std::size_t j = 0; j < n; ++j) std::swap(pa(i, j), pa(lu.pivots()[i], j));
+    }
+    expectNear(l * u, pa, scaledTolerance<real_t>(1e-13) * static_cast<real_t>(n));
+  }
+}
+
+TEST(ComplexDecompositionTest, LuPivoting) {
+  const ComplexMatrix a = {{Complex(0, 0), Complex(2, 0)}, {Complex(0, 1), Complex(1, 0)}};
+  const LuDecomposition lu(a);
+  EXPECT_EQ(lu.pivots()[0], 1);
+  EXPECT_EQ(lu.pivots()[1], 1);
+  const Complex determinant = lu.determinant();
+  EXPECT_NEAR(determinant.real(), 0, EPSILON<real_t>);
+  EXPECT_NEAR(determinant.imag(), -2, EPSILON<real_t>);
+  const ComplexMatrix b = {{Complex(2, 0)}, {Complex(1, 1)}};
+  const ComplexMatrix x = lu.solve(b);
+  EXPECT_NEAR(x(0, 0).real(), 1, EPSILON<real_t>);
+  EXPECT_NEAR(x(0, 0).imag(), 0, EPSILON<real_t>);
+  EXPECT_NEAR(x(1, 0).real(), 1, EPSILON<real_t>);
+  EXPECT_NEAR(x(1, 0).imag(), 0, EPSILON<real_t>);
+}
+
+TEST(ComplexDecompositionTest, LuSolveInPlace) {
+  const ComplexMatrix a = randomMatrix(90, 90, 3);
+  const ComplexMatrix b = randomMatrix(90, 70, 4);
+  ThreadPool pool(3);
+  const LuDecomposition lu(a, pool);
+  // Row-major right-hand sides, each column solved on its own
+  ComplexMatrix x(b);
+  lu.solveInPlace(x.view(), pool);
+  expectSolution(a, x, b, 1e-14);
+  for (const std::size_t j : {0, 33, 69}) {
+    const ComplexMatrix column = lu.solve(b.submatrix(0, j, 90, 1));
+    expectNear(column, x.submatrix(0, j, 90, 1), scaledTolerance<real_t>(1e-12));
+  }
+}
+
+TEST(ComplexDecompositionTest, LuScaling) {
+  // The squared magnitudes of the pivots overflow, and underflow for tiny matrices
+  const real_t large = std::numeric_limits<real_t>::max() / 4096;
+  const real_t small = std::numeric_limits<real_t>::min() * real_t(1e6);
+  for (const real_t scale : {large, small}) {
+    const ComplexMatrix a = randomMatrix(80, 80, 5);
+    const ComplexMatrix b = randomMatrix(80, 2, 6);
+    ComplexMatrix scaled(a);
+    ComplexMatrix scaledB(b);
+    for (std::size_t i = 0; i < 80; ++i) {
+      for (std::size_t j = 0; j < 80; ++j) scaled(i, j) *= scale;
+      for (std::size_t j = 0; j < 2; ++j) scaledB(i, j) *= scale;
+    }
+    const ComplexMatrix x = LuDecomposition(scaled).solve(scaledB);
+    expectNear(x, LuDecomposition(a).solve(b), scaledTolerance<real_t>(1e-10));
+  }
+}
+
+TEST(ComplexDecompositionTest, LuSingular) {
+  const ComplexMatrix a = {{Complex(1, 1), Complex(2, 2), Complex(0, 1)},
+                           {Complex(2, 2), Complex(4, 4), Complex(1, 0)},
+                           {Complex(3, 0), Complex(6, 0), Complex(1, 1)}};
+  const LuDecomposition lu(a);
+  EXPECT_TRUE(lu.singular());
+  EXPECT_EQ(lu.determinant().real(), 0);
+  EXPECT_EQ(lu.determinant().imag(), 0);
+  EXPECT_THROW((void)lu.solve(ComplexMatrix(3, 1)), std::invalid_argument);
+}
+
+TEST(ComplexDecompositionTest, QrFactors) {
+  for (const auto& [m, n] : {std::pair<std::size_t, std::size_t>{1, 1}, {150, 90}, {64, 64}, {40, 100}, {130, 1}}) {
+    const ComplexMatrix a = randomMatrix(m, n, static_cast<unsigned>(m + n));
+    const QrDecomposition qr(a);
+    const ComplexMatrix q = qr.q();
+    const ComplexMatrix r = qr.r();
+    const std::size_t k = std::min(m, n);
+    ASSERT_EQ(q.rows(), m);
+    ASSERT_EQ(q.cols(), k);
+    ASSERT_EQ(r.rows(), k);
+    ASSERT_EQ(r.cols(), n);
+    const real_t epsilon = scaledTolerance<real_t>(1e-13) * static_cast<real_t>(std::max(m, n));
+    expectNear(q * r, a, epsilon);
+
+    // Q^H Q = I
+    ComplexMatrix qh(k, m);
+    for (std::size_t i = 0; i < m; ++i) {
+      for (std::size_t j = 0; j < k; ++j) qh(j, i) = conj(q(i, j));
+    }
+    expectNear(qh * q, ComplexMatrix::identity(k), epsilon);
+    for (std::size_t i = 0; i < k; ++i) {
+      EXPECT_EQ(r(i, i).imag(), 0);
+      for (std::size_t j = 0; j < i; ++j) EXPECT_EQ(abs(r(i, j)), 0);
+    }
+
+    // applyQAdjoint inverts applyQ
+    ComplexMatrix b = randomMatrix(m, 3, 7);
+    qr.applyQ(b.view());
+    qr.applyQAdjoint(b.view());
+    expectNear(b, randomMatrix(m, 3, 7), epsilon);
+  }
+}
+
+TEST(ComplexDecompositionTest, QrSolve) {
+  // Square systems have the solution of LU
+  const ComplexMatrix a = randomMatrix(100, 100, 8);
+  const ComplexMatrix b = randomMatrix(100, 4, 9);
+  const ComplexMatrix x = QrDecomposition(a).solve(b);
+  expectSolution(a, x, b, 1e-14);
+  expectNear(x, LuDecomposition(a).solve(b), scaledTolerance<real_t>(1e-10));
+
+  // The residual of a least squares solution is orthogonal to the columns of A
+  ThreadPool pool(3);
+  const ComplexMatrix tall = randomMatrix(200, 70, 10);
+  const ComplexMatrix rhs = randomMatrix(200, 3, 11);
+  const ComplexMatrix solution = QrDecomposition(tall, pool).solve(rhs, pool);
+  ASSERT_EQ(solution.rows(), 70);
+  ComplexMatrix residual(rhs);
+  gemm(Complex(1, 0), tall, solution, Complex(-1, 0), residual.view());
+  ComplexMatrix adjoint(70, 200);
+  for (std::size_t i = 0; i < 200; ++i) {
+    for (std::size_t j = 0; j < 70; ++j) adjoint(j, i) = conj(tall(i, j));
+  }
+  expectNear(adjoint * residual, ComplexMatrix(70, 3), scaledTolerance<real_t>(1e-12));
+}
+
+TEST(ComplexDecompositionTest, QrScaling) {
+  const real_t scale = std::numeric_limits<real_t>::max() / 1024;
+  ComplexMatrix a = randomMatrix(70, 70, 12);
+  const ComplexMatrix b = randomMatrix(70, 1, 13);
+  const ComplexMatrix expected = QrDecomposition(a).solve(b);
+  for (std::size_t i = 0; i < 70; ++i) {
+    for (std::size_t j = 0; j < 70; ++j) a(i, j) *= scale;
+  }
+  ComplexMatrix x = QrDecomposition(a).solve(b);
+  for (std::size_t i = 0; i < 70; ++i) x(i, 0) *= scale;
+  expectNear(x, expected, scaledTolerance<real_t>(1e-10));
+}
+
+TEST(ComplexDecompositionTest, Errors) {
+  EXPECT_THROW(LuDecomposition{ComplexMatrix(3, 2)}, std::invalid_argument);
+  const LuDecomposition lu(ComplexMatrix::identity(3));
+  EXPECT_THROW((void)lu.solve(ComplexMatrix(2, 1)), std::invalid_argument);
+
+  const QrDecomposition wide(randomMatrix(2, 3, 14));
+  EXPECT_THROW((void)wide.solve(ComplexMatrix(2, 1)), std::invalid_argument);
+  const QrDecomposition qr(randomMatrix(4, 3, 15));
+  EXPECT_THROW((void)qr.solve(ComplexMatrix(3, 1)), std::invalid_argument);
+  ComplexMatrix b(5, 1);
+  EXPECT_THROW(qr.applyQ(b.view()), std::invalid_argument);
+  const QrDecomposition deficient(ComplexMatrix(4, 3));
+  EXPECT_THROW((void)deficient.solve(ComplexMatrix(4, 1)), std::invalid_argument);
+}
+
+namespace {
+
+/// Expects A V = V diag(lambda) and unit columns of V, relative to |A|
+void expectEigenpairs(const ComplexMatrixView<const real_t> a, const std::span<const Complex> eigenvalues,
+                      const ComplexMatrixView<const real_t> vectors, const double tolerance) {
+  const std::size_t n = a.rows();
+  ASSERT_EQ(eigenvalues.size(), n);
+  ASSERT_EQ(vectors.rows(), n);
+  ASSERT_EQ(vectors.cols(), n);
+  ComplexMatrix residual = ComplexMatrix(a) * ComplexMatrix(vectors);
+  for (std::size_t j = 0; j < n; ++j) {
+    real_t length = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      residual(i, j) -= vectors(i, j) * eigenvalues[j];
+      length += abs2(vectors(i, j));
+    }
+    EXPECT_NEAR(length, 1, scaledTolerance<real_t>(1e-13) * static_cast<real_t>(n));
+  }
+  EXPECT_LE(largest(residual.view()), scaledTolerance<real_t>(tolerance) * largest(a) * static_cast<real_t>(n));
+}
+
+/// Expects every number of expected to be close to one of result
+void expectSameSpectrum(const std::span<const Complex> result, const std::span<const Complex> expected,
+                        const real_t epsilon) {
+  ASSERT_EQ(result.size(), expected.size());
+  for (const Complex& lambda : expected) {
+    real_t distance = std::numeric_limits<real_t>::infinity();
+    for (const Complex& mu : result) distance = std::min(distance, abs(lambda - mu));
+    EXPECT_LE(distance, epsilon) << lambda.real() << ", " << lambda.imag();
+  }
+}
+
+}  // namespace
+
+TEST(ComplexDecompositionTest, EigenSolve) {
+  // Sizes around the block size, and beyond the size of aggressive early deflation
+  for (const std::size_t n : {1, 2, 3, 10, 47, 66, 150}) {
+    const ComplexMatrix a = randomMatrix(n, n, static_cast<unsigned>(n + 20));
+    EigenSolver solver(n);
+    solver.compute(a);
+    expectEigenpairs(a, solver.eigenvalues(), solver.eigenvectors(), 1e-13);
+
+    // A = Z T Z^H with unitary Z and upper triangular T
+    const ComplexMatrixView<const real_t> t = solver.schur();
+    const ComplexMatrixView<const real_t> z = solver.schurVectors();
+    ComplexMatrix zh(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        zh(j, i) = conj(z(i, j));
+        if (i > j) {
+          EXPECT_EQ(abs(t(i, j)), 0) << i << ", " << j;
+        }
+      }
+    }
+    const real_t epsilon = scaledTolerance<real_t>(1e-13) * static_cast<real_t>(n);
+    const ComplexMatrix unitary(z);
+    expectNear(zh * unitary, ComplexMatrix::identity(n), epsilon);
+    expectNear(unitary * ComplexMatrix(t) * zh, a, epsilon);
+
+    // The eigenvalues alone are the same
+    EigenSolver values(n, false);
+    values.compute(a);
+    EXPECT_EQ(values.eigenvectors().rows(), 0);
+    expectSameSpectrum(values.eigenvalues(), solver.eigenvalues(), scaledTolerance<real_t>(1e-10));
+  }
+}
+
+TEST(ComplexDecompositionTest, EigenSpectra) {
+  // Triangular matrices have their diagonal as eigenvalues
+  ComplexMatrix triangular = randomMatrix(5, 5, 21);
+  for (std::size_t i = 0; i < 5; ++i) {
+    for (std::size_t j = 0; j < i; ++j) triangular(i, j) = Complex();
+    triangular(i, i) = Complex(static_cast<real_t>(i), -static_cast<real_t>(i));
+  }
+  EigenSolver solver(5);
+  solver.compute(triangular);
+  std::vector<Complex> diagonal;
+  for (std::size_t i = 0; i < 5; ++i) diagonal.push_back(triangular(i, i));
+  expectSameSpectrum(solver.eigenvalues(), diagonal, scaledTolerance<real_t>(1e-13));
+
+  // The cyclic shift, a unitary matrix on which unshifted QR makes no progress, has the roots of unity
+  for (const std::size_t n : {2, 8, 60}) {
+    ComplexMatrix cycle(n, n);
+    for (std::size_t i = 0; i < n; ++i) cycle((i + 1) % n, i) = Complex(1, 0);
+    EigenSolver cyclic(n);
+    cyclic.compute(cycle);
+    std::vector<Complex> roots;
+    for (std::size_t k = 0; k < n; ++k) {
+      const real_t angle = 2 * std::numbers::pi_v<real_t> * static_cast<real_t>(k) / static_cast<real_t>(n);
+      roots.emplace_back(std::cos(angle), std::sin(angle));
+    }
+    expectSameSpectrum(cyclic.eigenvalues(), roots, scaledTolerance<real_t>(1e-12));
+    expectEigenpairs(cycle, cyclic.eigenvalues(), cyclic.eigenvectors(), 1e-13);
+  }
+
+  // A Jordan block converges to its multiple eigenvalue with the accuracy eps^(1/n)
+  ComplexMatrix jordan(4, 4);
+  for (std::size_t i = 0; i < 4; ++i) {
+    jordan(i, i) = Complex(2, 1);
+    if (i > 0) jordan(i - 1, i) = Complex(1, 0);
+  }
+  EigenSolver defective(4);
+  defective.compute(jordan);
+  for (const Complex& lambda : defective.eigenvalues()) {
+    EXPECT_LE(abs(lambda - Complex(2, 1)), std::pow(EPSILON<real_t>, real_t(0.25)) * 10);
+  }
+  for (std::size_t j = 0; j < 4; ++j) EXPECT_FALSE(std::isnan(defective.eigenvectors()(0, j).real()));
+}
+
+TEST(ComplexDecompositionTest, EigenReuse) {
+  // A solver computes one matrix after the other with its workspaces
+  EigenSolver solver(70);
+  ThreadPool pool(3);
+  for (const unsigned seed : {22, 23}) {
+    const ComplexMatrix a = randomMatrix(70, 70, seed);
+    solver.compute(a, pool);
+    expectEigenpairs(a, solver.eigenvalues(), solver.eigenvectors(), 1e-13);
+  }
+}
+
+TEST(ComplexDecompositionTest, BatchedEigenSolve) {
+  ThreadPool pool(3);
+  for (const std::size_t n : {1, 12, 50}) {
+    std::vector<ComplexMatrix> matrices;
+    std::vector<ComplexMatrixView<const real_t>> views;
+    for (unsigned i = 0; i < 20; ++i) matrices.push_back(randomMatrix(n, n, 100 + i));
+    for (const ComplexMatrix& matrix : matrices) views.push_back(matrix);
+    std::vector<Complex> eigenvalues(20 * n);
+    std::vector<ComplexMatrix> vectors(20, ComplexMatrix(n, n));
+    std::vector<ComplexMatrixView<real_t>> vectorViews;
+    for (ComplexMatrix& matrix : vectors) vectorViews.push_back(matrix);
+
+    BatchedEigenSolver batched(n, true, pool);
+    EXPECT_EQ(batched.size(), n);
+    batched.compute(views, eigenvalues, vectorViews);
+    EigenSolver solver(n);
+    for (std::size_t i = 0; i < 20; ++i) {
+      const std::span<const Complex> values(eigenvalues.data() + i * n, n);
+      expectEigenpairs(matrices[i], values, vectors[i], 1e-13);
+      solver.compute(matrices[i]);
+      expectSameSpectrum(values, solver.eigenvalues(), scaledTolerance<real_t>(1e-10));
+    }
+
+    BatchedEigenSolver values(n, false, pool);
+    std::vector<Complex> only(20 * n);
+    values.compute(views, only);
+    expectSameSpectrum(only, eigenvalues, scaledTolerance<real_t>(1e-10));
+  }
+}
+
+TEST(ComplexDecompositionTest, ConcurrentBatchedEigenSolve) {
+  // A pool of one thread has one solver, so concurrent calls have to allocate more
+  ThreadPool pool(1);
+  constexpr std::size_t n = 12;
+  constexpr std::size_t count = 50;
+  std::vector<ComplexMatrix> matrices;
+  std::vector<ComplexMatrixView<const real_t>> views;
+  for (unsigned i = 0; i < count; ++i) matrices.push_back(randomMatrix(n, n, 200 + i));
+  for (const ComplexMatrix& matrix : matrices) views.push_back(matrix);
+  BatchedEigenSolver batched(n, false, pool);
+  std::vector<Complex> expected(count * n);
+  batched.compute(views, expected);
+
+  std::vector<std::vector<Complex>> eigenvalues(4, std::vector<Complex>(count * n));
+  std::vector<std::thread> threads;
+  for (std::vector<Complex>& values : eigenvalues) {
+    threads.emplace_back([&] { batched.compute(views, values); });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (const std::vector<Complex>& values : eigenvalues) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(values[i].real(), expected[i].real()) << i;
+      EXPECT_EQ(values[i].imag(), expected[i].imag()) << i;
+    }
+  }
+}
+
+TEST(ComplexDecompositionTest, EigenErrors) {
+  EigenSolver solver(3);
+  EXPECT_THROW(solver.compute(ComplexMatrix(3, 2)), std::invalid_argument);
+  EXPECT_THROW(solver.compute(ComplexMatrix(4, 4)), std::invalid_argument);
+
+  BatchedEigenSolver batched(2, false);
+  const ComplexMatrix a(2, 2);
+  const ComplexMatrix b(3, 3);
+  std::vector<ComplexMatrixView<const real_t>> views = {a, a};
+  std::vector<Complex> eigenvalues(3);
+  EXPECT_THROW(batched.compute(views, eigenvalues), std::invalid_argument);
+  eigenvalues.resize(4);
+  ComplexMatrix vector(2, 2);
+  const std::vector<ComplexMatrixView<real_t>> vectors = {vector, vector};
+  EXPECT_THROW(batched.compute(views, eigenvalues, vectors), std::invalid_argument);
+  views[1] = b;
+  EXPECT_THROW(batched.compute(views, eigenvalues), std::invalid_argument);
+}
@@ -0,0 +1,174 @@
+#include "ComplexExpression.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "ComplexMath.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+constexpr real_t TEST_EPSILON = scaledTolerance<real_t>(1e-13);
+
+ComplexArray testArray(const std::size_t size, const real_t offset) {
+  ComplexArray z(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    z[i] = Complex(std::sin(0.37 * i + offset) + 0.5, std::cos(1.13 * i - offset) * (1 + 0.01 * i));
+  }
+  return z;
+}
+
+template <typename F>
+std::vector<Complex> zip(const ComplexArray& a, const ComplexArray& b, F f) {
+  std::vector<Complex> result(a.size());
+  for (std::size_t i = 0; i < a.size(); ++i) result[i] = f(a[i], b[i]);
+  return result;
+}
+
+void expectNear(const ComplexArray& result, const std::vector<Complex>& expected, const real_t epsilon = TEST_EPSILON) {
+  ASSERT_EQ(result.size(), expected.size());
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    const real_t scale = 1 + abs(expected[i]);
+    EXPECT_NEAR(result[i].real(), expected[i].real(), epsilon * scale) << "index " << i;
+    EXPECT_NEAR(result[i].imag(), expected[i].imag(), epsilon * scale) << "index " << i;
+  }
+}
+
+}  // namespace
+
+class ComplexExpressionTest : public ::testing::TestWithParam<std::size_t> {
+protected:
+  const ComplexArray m_A = testArray(GetParam(), 0.1);
+  const ComplexArray m_B = testArray(GetParam(), 0.7);
+  const ComplexArray m_C = testArray(GetParam(), 1.9);
+  const ComplexArray m_D = testArray(GetParam(), 2.3);
+};
+
+TEST_P(ComplexExpressionTest, FusedArithmetic) {
+  const ComplexArray result = m_A * m_B + conj(m_C) / m_D;
+  std::vector<Complex> expected(m_A.size());
+  for (std::size_t i = 0; i < m_A.size(); ++i) expected[i] = m_A[i] * m_B[i] + conj(m_C[i]) / m_D[i];
+  expectNear(result, expected);
+
+  const ComplexArray scaled = 2.0 * (m_A - Complex(1, 2)) / (1.5 - m_B) - -m_C;
+  for (std::size_t i = 0; i < m_A.size(); ++i) {
+    expected[i] = 2.0 * (m_A[i] - Complex(1, 2)) / (1.5 - m_B[i]) - -m_C[i];
+  }
+  expectNear(scaled, expected);
+}
+
+TEST_P(ComplexExpressionTest, RealFunctions) {
+  const ComplexArray result = abs(m_A) * m_B + real(m_C) - imag(m_D) * arg(m_A) + abs2(m_B);
+  std::vector<Complex> expected(m_A.size());
+  for (std::size_t i = 0; i < m_A.size(); ++i) {
+    expected[i] = abs(m_A[i]) * m_B[i] + real(m_C[i]) - imag(m_D[i]) * arg(m_A[i]) + abs2(m_B[i]);
+  }
+  expectNear(result, expected);
+
+  const RealArray magnitudes = abs(m_A * m_B) / 2.0;
+  ASSERT_EQ(magnitudes.size(), m_A.size());
+  for (std::size_t i = 0; i < m_A.size(); ++i) {
+    EXPECT_NEAR(magnitudes[i], abs(m_A[i] * m_B[i]) / 2, TEST_EPSILON * (1 + magnitudes[i]));
+  }
+  static_assert(decltype(abs(m_A) + 1.0)::REAL);
+  static_assert(!decltype(abs(m_A) + Complex(0, 1))::REAL);
+  static_assert(!decltype(sqrt(abs(m_A)))::REAL);
+}
+
+TEST_P(ComplexExpressionTest, Transcendental) {
+  const ComplexArray result = exp(m_A * 0.5) * sqrt(m_B) - log(m_C) + sin(m_D) / cos(m_D) - tan(m_D) +
+                              pow(m_A, 1.5) + pow(m_A, Complex(0.5, 0.25)) + pow(m_A, conj(m_B)) + atan(m_B) -
+                              asin(m_C * 0.5) + acos(m_C * 0.5);
+  std::vector<Complex> expected(m_A.size());
+  for (std::size_t i = 0; i < m_A.size(); ++i) {
+    const Complex a = m_A[i];
+    const Complex b = m_B[i];
+    const Complex c = m_C[i];
+    const Complex d = m_D[i];
+    expected[i] = exp(a * 0.5) * sqrt(b) - log(c) + sin(d) / cos(d) - tan(d) + pow(a, 1.5) +
+                  pow(a, Complex(0.5, 0.25)) + pow(a, conj(b)) + atan(b) - asin(c * 0.5) + acos(c * 0.5);
+  }
+  expectNear(result, expected, scaledTolerance<real_t>(1e-12));
+}
+
+TEST_P(ComplexExpressionTest, Aliasing) {
+  ComplexArray a = m_A;
+  a = conj(m_B) + a * a;
+  expectNear(a, zip(m_A, m_B, [](Complex x, Complex y) { return conj(y) + x * x; }));
+
+  ComplexArray b = m_B;
+  b = m_A / conj(b) - b;
+  expectNear(b, zip(m_A, m_B, [](Complex x, Complex y) { return x / conj(y) - y; }));
+}
+
+TEST_P(ComplexExpressionTest, CompoundAssignment) {
+  ComplexArray a = m_A;
+  a += m_B * m_C;
+  a -= conj(m_B);
+  a *= a + m_D;
+  a /= m_C * 2.0;
+  std::vector<Complex> expected(m_A.size());
+  for (std::size_t i = 0; i < m_A.size(); ++i) {
+    Complex x = m_A[i] + m_B[i] * m_C[i] - conj(m_B[i]);
+    x = x * (x + m_D[i]);
+    expected[i] = x / (m_C[i] * 2.0);
+  }
+  expectNear(a, expected);
+}
+
+TEST_P(ComplexExpressionTest, Temporaries) {
+  // The rvalue array is moved into the expression, which can be evaluated after the statement that created it
+  const auto expression = (m_A + m_B) * ComplexArray(conj(m_C));
+  const ComplexArray result = expression;
+  std::vector<Complex> expected(m_A.size());
+  for (std::size_t i = 0; i < m_A.size(); ++i) expected[i] = (m_A[i] + m_B[i]) * conj(m_C[i]);
+  expectNear(result, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, ComplexExpressionTest, ::testing::Values(0, 1, 7, 256, 257, 1000));
+
+TEST(ComplexExpressionTest, SplitSpans) {
+  const ComplexArray a = testArray(300, 0.4);
+  AlignedVector<real_t> real(300);
+  AlignedVector<real_t> imag(300);
+  const SplitSpan<real_t> out(real, imag);
+  evaluate(a.view() * Complex(0, 1) + a, out);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const Complex expected = a[i] * Complex(0, 1) + a[i];
+    EXPECT_NEAR(real[i], expected.real(), TEST_EPSILON);
+    EXPECT_NEAR(imag[i], expected.imag(), TEST_EPSILON);
+  }
+  evaluate(out.subspan(0, 200) - a.view().subspan(100, 200), out.subspan(100, 200));
+  EXPECT_NEAR(real[299], (a[199] * Complex(0, 1) + a[199]).real() - a[299].real(), TEST_EPSILON);
+}
+
+TEST(ComplexExpressionTest, Errors) {
+  const ComplexArray a(10);
+  const ComplexArray b(11);
+  EXPECT_THROW(a + b, std::invalid_argument);
+  EXPECT_THROW(pow(a, b), std::invalid_argument);
+  ComplexArray c(10);
+  EXPECT_THROW(c += conj(b), std::invalid_argument);
+  AlignedVector<real_t> parts(11);
+  EXPECT_THROW(evaluate(a * 2.0, SplitSpan<real_t>(parts, parts)), std::invalid_argument);
+  c = conj(b);
+  EXPECT_EQ(c.size(), 11);
+}
+
+TEST(ComplexExpressionTest, SinglePrecision) {
+  BasicComplexArray<float> a(100);
+  BasicComplexArray<float> b(100);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = ComplexF(0.5F * i - 3, 1.25F - 0.3F * i);
+    b[i] = ComplexF(1 + 0.1F * i, 0.7F);
+  }
+  const BasicComplexArray<float> result = exp(a * 0.01F) / b + 2 * conj(b);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const ComplexF expected = exp(static_cast<ComplexF>(a[i]) * 0.01F) / static_cast<ComplexF>(b[i]) +
+                              2.0F * conj(static_cast<ComplexF>(b[i]));
+    EXPECT_NEAR(result[i].real(), expected.real(), 1e-5F * (1 + abs(expected)));
+    EXPECT_NEAR(result[i].imag(), expected.imag(), 1e-5F * (1 + abs(expected)));
+  }
+}
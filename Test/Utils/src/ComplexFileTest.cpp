@@ -0,0 +1,176 @@
+#include "ComplexFile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "ComplexMath.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+/// Path of a temporary file that is removed at the end of the test
+class TemporaryFile {
+protected:
+  std::filesystem::path m_Path;
+
+public:
+  explicit TemporaryFile(const char* name)
+      : m_Path(std::filesystem::temp_directory_path() /
+               (std::string("ComplexFileTest_") + name + "_" + std::to_string(::getpid()))) {}
+  TemporaryFile(const TemporaryFile&) = delete;
+  TemporaryFile& operator=(const TemporaryFile&) = delete;
+  ~TemporaryFile() { std::filesystem::remove(m_Path); }
+
+  [[nodiscard]] const std::filesystem::path& path() const { return m_Path; }
+};
+
+Complex value(const std::size_t i) {
+  return Complex(std::sin(0.01 * i), static_cast<real_t>(i));
+}
+
+void expectValues(const SplitSpan<const real_t> z, const std::size_t offset = 0) {
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    EXPECT_EQ(z.real()[i], value(offset + i).real());
+    EXPECT_EQ(z.imag()[i], value(offset + i).imag());
+  }
+}
+
+bool aligned(const void* p) {
+  return reinterpret_cast<std::uintptr_t>(p) % MEMORY_ALIGNMENT == 0;
+}
+
+}  // namespace
+
+TEST(ComplexFileTest, SplitAppend) {
+  const TemporaryFile temporary("split");
+  constexpr std::size_t SIZE = 10000;
+  {
+    ComplexFile file = ComplexFile::create(temporary.path(), ComplexLayout::Split);
+    EXPECT_EQ(file.size(), 0U);
+    // Appends of both layouts that grow the file several times
+    for (std::size_t i = 0; i < SIZE; i += 1000) {
+      ComplexArray block(1000);
+      for (std::size_t k = 0; k < 1000; ++k) block[k] = value(i + k);
+      if (i % 2000 == 0) {
+        file.append(block);
+      } else {
+        std::vector<Complex> interleaved(1000);
+        for (std::size_t k = 0; k < 1000; ++k) interleaved[k] = block[k];
+        file.append(interleaved);
+      }
+      expectValues(file.split(0, i + 1000));
+    }
+    EXPECT_GE(file.capacity(), SIZE);
+    EXPECT_TRUE(aligned(file.split().realData()));
+    EXPECT_TRUE(aligned(file.split().imagData()));
+    EXPECT_THROW(static_cast<void>(file.interleaved()), std::invalid_argument);
+  }
+  // Closing trims the capacity
+  EXPECT_LT(std::filesystem::file_size(temporary.path()), ComplexFile::HEADER_SIZE + 2 * (SIZE + 64) * sizeof(real_t));
+  const ComplexFile file = ComplexFile::open(temporary.path());
+  EXPECT_EQ(file.size(), SIZE);
+  EXPECT_EQ(file.layout(), ComplexLayout::Split);
+  expectValues(file.split());
+  expectValues(file.split(5000, 17), 5000);
+  EXPECT_TRUE(aligned(file.split().imagData()));
+  EXPECT_THROW(static_cast<void>(file.split(9990, 11)), std::invalid_argument);
+}
+
+TEST(ComplexFileTest, ZeroCopy) {
+  const TemporaryFile temporary("interleaved");
+  constexpr std::size_t SIZE = 777;
+  {
+    ComplexFile file = ComplexFile::create(temporary.path(), ComplexLayout::Interleaved, SIZE);
+    ComplexArray z(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i) z[i] = value(i);
+    file.append(z);
+    EXPECT_TRUE(aligned(file.interleaved().data()));
+    file.flush();
+  }
+  {
+    // The functions of the library work in place on the mapping
+    ComplexFile file = ComplexFile::open(temporary.path(), FileAccess::ReadWrite);
+    const std::span<Complex> z = file.interleaved();
+    for (Complex& x : z) x = Complex(0, x.real());
+    exp<real_t>(z, z);
+  }
+  const ComplexFile file = ComplexFile::open(temporary.path());
+  ASSERT_EQ(file.interleaved().size(), SIZE);
+  for (std::size_t i = 0; i < SIZE; ++i) {
+    EXPECT_NEAR(file.interleaved()[i].real(), std::cos(value(i).real()), scaledTolerance<real_t>(1e-15));
+    EXPECT_NEAR(file.interleaved()[i].imag(), std::sin(value(i).real()), scaledTolerance<real_t>(1e-15));
+  }
+}
+
+TEST(ComplexFileTest, ForeignByteOrder) {
+  const TemporaryFile temporary("foreign");
+  // Header and numbers of a file of the other byte order, written by hand
+  std::vector<unsigned char> bytes(64 + 4 * sizeof(double));
+  std::memcpy(bytes.data(), "MATHCPLX", 8);
+  const bool little = std::endian::native == std::endian::little;
+  bytes[little ? 9 : 8] = 1;
+  bytes[10] = sizeof(double);
+  bytes[11] = 0;
+  bytes[12] = little ? 2 : 1;
+  bytes[little ? 16 : 23] = 2;
+  const double parts[4] = {1.5, -2, 0.25, 1e300};
+  for (std::size_t i = 0; i < 4; ++i) {
+    std::memcpy(&bytes[64 + i * sizeof(double)], &parts[i], sizeof(double));
+    std::reverse(bytes.begin() + 64 + i * sizeof(double), bytes.begin() + 64 + (i + 1) * sizeof(double));
+  }
+  // Swap the size field into the foreign order
+  std::reverse(bytes.begin() + 16, bytes.begin() + 24);
+  std::ofstream(temporary.path(), std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), 96);
+  const BasicComplexFile<double> file = BasicComplexFile<double>::open(temporary.path());
+  ASSERT_EQ(file.size(), 2U);
+  EXPECT_EQ(file.interleaved()[0].real(), 1.5);
+  EXPECT_EQ(file.interleaved()[0].imag(), -2);
+  EXPECT_EQ(file.interleaved()[1].imag(), 1e300);
+  EXPECT_THROW(BasicComplexFile<double>::open(temporary.path(), FileAccess::ReadWrite), std::invalid_argument);
+}
+
+TEST(ComplexFileTest, Errors) {
+  const TemporaryFile temporary("errors");
+  EXPECT_THROW(ComplexFile::open(temporary.path()), std::system_error);
+  std::ofstream(temporary.path()) << "not a complex file, but long enough to hold a header of sixty-four bytes";
+  EXPECT_THROW(ComplexFile::open(temporary.path()), std::invalid_argument);
+  { BasicComplexFile<float>::create(temporary.path(), ComplexLayout::Split).append(BasicComplexArray<float>(5)); }
+  EXPECT_THROW(BasicComplexFile<double>::open(temporary.path()), std::invalid_argument);
+  BasicComplexFile<float> file = BasicComplexFile<float>::open(temporary.path());
+  EXPECT_EQ(file.size(), 5U);
+  EXPECT_THROW(static_cast<void>(file.split()), std::invalid_argument);
+  EXPECT_THROW(file.append(BasicComplexArray<float>(1)), std::invalid_argument);
+  // Moving transfers the mapping
+  const BasicComplexFile<float> moved = std::move(file);
+  EXPECT_EQ(moved.split().size(), 5U);
+}
+
+TEST(ComplexFileTest, CorruptedHeader) {
+  const TemporaryFile temporary("corrupted");
+  for (const ComplexLayout layout : {ComplexLayout::Interleaved, ComplexLayout::Split}) {
+    { BasicComplexFile<float>::create(temporary.path(), layout).append(BasicComplexArray<float>(5)); }
+    // A size and capacity of 2^61 floats, for which the file size of 64 + 2 * 2^61 * 4 bytes wraps around to 64
+    const uint64_t huge = uint64_t(1) << 61;
+    {
+      std::fstream stream(temporary.path(), std::ios::binary | std::ios::in | std::ios::out);
+      stream.seekp(16);
+      stream.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+      stream.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    }
+    EXPECT_THROW(BasicComplexFile<float>::open(temporary.path()), std::invalid_argument);
+  }
+}
@@ -0,0 +1,207 @@
+#include "ComplexFormat.h"
+
+#include <charconv>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ComplexArray.h"
+
+using namespace Math;
+
+namespace {
+
+/// Reads one complex number and expects that it is the whole text
+Complex parse(const std::string& text) {
+  Complex z(-7, -7);
+  const std::from_chars_result result = from_chars(text.data(), text.data() + text.size(), z);
+  EXPECT_EQ(result.ec, std::errc()) << text;
+  EXPECT_EQ(result.ptr, text.data() + text.size()) << text;
+  return z;
+}
+
+void expectEqual(const Complex& result, const Complex& expected) {
+  EXPECT_EQ(result.real(), expected.real());
+  EXPECT_EQ(result.imag(), expected.imag());
+}
+
+/// Expects that the text of random numbers reads back to the same numbers
+template <scalar T>
+void expectRoundTrip() {
+  std::mt19937 generator(5);
+  std::uniform_real_distribution<T> mantissa(-1, 1);
+  std::uniform_int_distribution<int> exponent(std::numeric_limits<T>::min_exponent,
+                                              std::numeric_limits<T>::max_exponent - 1);
+  for (int i = 0; i < 1000; ++i) {
+    const BasicComplex<T> z(std::ldexp(mantissa(generator), exponent(generator)),
+                            std::ldexp(mantissa(generator), exponent(generator)));
+    char buffer[COMPLEX_CHARS_MAX<T>];
+    const std::to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), z);
+    ASSERT_EQ(result.ec, std::errc());
+    BasicComplex<T> parsed;
+    EXPECT_EQ(from_chars(buffer, result.ptr, parsed).ptr, result.ptr);
+    EXPECT_EQ(parsed.real(), z.real());
+    EXPECT_EQ(parsed.imag(), z.imag());
+  }
+}
+
+}  // namespace
+
+TEST(ComplexFormatTest, Shortest) {
+  EXPECT_EQ(to_string(Complex(1, 2)), "1 + 2i");
+  EXPECT_EQ(to_string(Complex(0.1, -0.3)), "0.1 - 0.3i");
+  EXPECT_EQ(to_string(Complex(-5, 0)), "-5");
+  EXPECT_EQ(to_string(ComplexF(0.1F, 1e-30F)), "0.1 + 1e-30i");
+  EXPECT_EQ(to_string(Complex(INFINITY, -INFINITY)), "inf - infi");
+  std::ostringstream os;
+  os << Complex(2.5, -1) << ',' << Complex(3, 0);
+  EXPECT_EQ(os.str(), "2.5 - 1i,3");
+}
+
+TEST(ComplexFormatTest, RoundTrip) {
+  expectRoundTrip<float>();
+  expectRoundTrip<double>();
+  expectRoundTrip<long double>();
+}
+
+TEST(ComplexFormatTest, BufferTooSmall) {
+  char buffer[8];
+  for (std::size_t size = 0; size < 7; ++size) {
+    const std::to_chars_result result = to_chars(buffer, buffer + size, Complex(1.5, -2.25));
+    EXPECT_EQ(result.ec, std::errc::value_too_large) << size;
+    EXPECT_EQ(result.ptr, buffer + size);
+  }
+  EXPECT_EQ(to_chars(buffer, buffer + 7, Complex(1.5, 2)).ptr, buffer + 7);
+}
+
+TEST(ComplexFormatTest, Bulk) {
+  ComplexArray z(1000);
+  std::vector<Complex> interleaved(z.size());
+  std::string expected;
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    interleaved[i] = Complex(std::sin(0.1 * i), -std::cos(0.3 * i) * i);
+    z[i] = interleaved[i];
+    expected += to_string(interleaved[i]) + ';';
+  }
+  std::vector<char> buffer(formattedSize<real_t>(z.size()));
+  std::to_chars_result result = to_chars<real_t>(buffer.data(), buffer.data() + buffer.size(), z, ';');
+  ASSERT_EQ(result.ec, std::errc());
+  EXPECT_EQ(std::string(buffer.data(), result.ptr), expected);
+  result = to_chars<real_t>(buffer.data(), buffer.data() + buffer.size(), interleaved, ';');
+  EXPECT_EQ(std::string(buffer.data(), result.ptr), expected);
+  result = to_chars<real_t>(buffer.data(), buffer.data() + expected.size() - 1, z, ';');
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  // Larger than the buffer of the stream writer
+  std::ostringstream os;
+  for (int i = 0; i < 100; ++i) write<real_t>(os, z, ';');
+  std::string repeated;
+  for (int i = 0; i < 100; ++i) repeated += expected;
+  EXPECT_EQ(os.str(), repeated);
+  std::ostringstream lines;
+  write<real_t>(lines, interleaved);
+  EXPECT_EQ(lines.str().substr(0, to_string(interleaved[0]).size() + 1), to_string(interleaved[0]) + '\n');
+}
+
+TEST(ComplexFormatTest, Parse) {
+  expectEqual(parse("1 + 2i"), Complex(1, 2));
+  expectEqual(parse("1+2j"), Complex(1, 2));
+  expectEqual(parse("0.5 -\t0.25i"), Complex(0.5, -0.25));
+  expectEqual(parse("-3e-2"), Complex(-0.03, 0));
+  expectEqual(parse("-2.5i"), Complex(0, -2.5));
+  expectEqual(parse("(1,-2)"), Complex(1, -2));
+  expectEqual(parse("( 1 , 2 )"), Complex(1, 2));
+  expectEqual(parse("(4)"), Complex(4, 0));
+  const Complex infinite = parse("-inf - infi");
+  EXPECT_EQ(infinite.real(), -INFINITY);
+  EXPECT_EQ(infinite.imag(), -INFINITY);
+  EXPECT_TRUE(std::isnan(parse("nan").real()));
+  // A sign that is not followed by an imaginary part ends the number
+  for (const std::string text : {"1 -2", "1 + -2i", "1 + 2", "1 +"}) {
+    Complex z;
+    EXPECT_EQ(from_chars(text.data(), text.data() + text.size(), z).ptr, text.data() + 1) << text;
+    expectEqual(z, Complex(1, 0));
+  }
+  for (const std::string text : {"", "x", "+1", "i", "(1,2", "(,2)", "( 1 2)"}) {
+    Complex z(5, 5);
+    const std::from_chars_result result = from_chars(text.data(), text.data() + text.size(), z);
+    EXPECT_EQ(result.ec, std::errc::invalid_argument) << text;
+    EXPECT_EQ(result.ptr, text.data()) << text;
+    expectEqual(z, Complex(5, 5));
+  }
+  const std::string tooLarge = "1 + 1e99999i";
+  Complex z(5, 5);
+  const std::from_chars_result result = from_chars(tooLarge.data(), tooLarge.data() + tooLarge.size(), z);
+  EXPECT_EQ(result.ec, std::errc::result_out_of_range);
+  EXPECT_EQ(result.ptr, tooLarge.data() + tooLarge.size());
+  expectEqual(z, Complex(5, 5));
+}
+
+TEST(ComplexFormatTest, BulkParse) {
+  const std::string text = " 1+2i, 3;(4,5)\r\n 6i\n";
+  ComplexArray z(10);
+  ParseResult result = from_chars<real_t>(text.data(), text.data() + text.size(), z);
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(result.count, 4U);
+  EXPECT_EQ(result.ptr, text.data() + text.size());
+  expectEqual(z[2], Complex(4, 5));
+  expectEqual(z[3], Complex(0, 6));
+  // Full output, the remaining text can be read from ptr
+  std::vector<Complex> interleaved(2);
+  result = from_chars<real_t>(text.data(), text.data() + text.size(), interleaved);
+  EXPECT_EQ(result.count, 2U);
+  EXPECT_EQ(std::string(result.ptr, 5), "(4,5)");
+  // Errors are at the number that could not be read
+  const std::string invalid = "1 2x 3";
+  result = from_chars<real_t>(invalid.data(), invalid.data() + invalid.size(), z);
+  EXPECT_EQ(result.ec, std::errc::invalid_argument);
+  EXPECT_EQ(result.count, 1U);
+  EXPECT_EQ(result.ptr, invalid.data() + 2);
+}
+
+TEST(ComplexFormatTest, Read) {
+  ComplexArray z(100000);
+  for (std::size_t i = 0; i < z.size(); ++i) z[i] = Complex(std::sin(0.1 * i) * 1e5, std::cos(0.7 * i) / 3);
+  // Lines, and single lines that are larger than a chunk, with blanks inside the numbers
+  for (const char separator : {'\n', ';', ' ', ','}) {
+    std::stringstream stream;
+    write<real_t>(stream, z, separator);
+    ComplexArray array(1, Complex(-1, -1));
+    const ReadResult result = read(stream, array);
+    EXPECT_EQ(result.ec, std::errc());
+    EXPECT_EQ(result.count, z.size());
+    EXPECT_EQ(result.position, stream.str().size());
+    ASSERT_EQ(array.size(), z.size() + 1);
+    expectEqual(array[0], Complex(-1, -1));
+    for (std::size_t i = 0; i < z.size(); ++i) expectEqual(array[i + 1], z[i]);
+  }
+  // One line of parentheses with blanks and ',' inside
+  std::stringstream parentheses;
+  for (std::size_t i = 0; i < z.size(); ++i) parentheses << "( " << i << " , -" << i % 1000 << " ) ";
+  std::vector<Complex> pairs;
+  EXPECT_EQ(read(parentheses, pairs).ec, std::errc());
+  ASSERT_EQ(pairs.size(), z.size());
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    expectEqual(pairs[i], Complex(static_cast<real_t>(i), -static_cast<real_t>(i % 1000)));
+  }
+  std::stringstream stream;
+  write<real_t>(stream, z);
+  stream << "1 + 2i\n3 + ?\n";
+  std::vector<Complex> vector;
+  const ReadResult result = read(stream, vector);
+  EXPECT_EQ(result.ec, std::errc::invalid_argument);
+  EXPECT_EQ(result.count, z.size() + 2);
+  EXPECT_EQ(result.position, stream.str().size() - 4);
+  expectEqual(vector.back(), Complex(3, 0));
+}
+
+#ifdef __cpp_lib_format
+TEST(ComplexFormatTest, Formatter) {
+  EXPECT_EQ(std::format("[{}]", Complex(0.5, -0.25)), "[0.5 - 0.25i]");
+  const Complex z(1, 1);
+  EXPECT_THROW(static_cast<void>(std::vformat("{:>10}", std::make_format_args(z))), std::format_error);
+}
+#endif
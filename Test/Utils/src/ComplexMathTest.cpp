@@ -0,0 +1,235 @@
+#include "ComplexMath.h"
+
+#include <cmath>
+#include <complex>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+#include "Simd.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+constexpr real_t TEST_EPSILON = scaledTolerance<real_t>(1e-13);
+
+namespace {
+
+/// Tests of the double precision error bounds, independent of real_t
+using ComplexArrayD = BasicComplexArray<double>;
+
+/// Deterministic test data with a length that is not a multiple of any vector width
+ComplexArray testArray(const std::size_t size) {
+  ComplexArray z(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    z[i] = Complex(3 * std::sin(0.71 * i + 0.2), 2 * std::cos(0.37 * i - 0.4) + 0.1);
+  }
+  return z;
+}
+
+void expectNear(const ComplexArray& result, const std::vector<Complex>& expected, const real_t epsilon) {
+  ASSERT_EQ(result.size(), expected.size());
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    const real_t scale = 1 + abs(expected[i]);
+    EXPECT_NEAR(result[i].real(), expected[i].real(), epsilon * scale) << "index " << i;
+    EXPECT_NEAR(result[i].imag(), expected[i].imag(), epsilon * scale) << "index " << i;
+  }
+}
+
+template <typename F>
+std::vector<Complex> reference(const ComplexArray& z, F f) {
+  std::vector<Complex> result;
+  for (std::size_t i = 0; i < z.size(); ++i) result.push_back(f(static_cast<Complex>(z[i])));
+  return result;
+}
+
+/// @return Distance of x to the correctly rounded value of the reference in units in the last place
+template <typename T>
+long double ulpError(const T x, const long double reference) {
+  const T rounded = static_cast<T>(reference);
+  const long double ulp = std::nextafter(std::abs(rounded), std::numeric_limits<T>::infinity()) - std::abs(rounded);
+  return std::abs(static_cast<long double>(x) - reference) / ulp;
+}
+
+}  // namespace
+
+class ComplexMathTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  static constexpr std::size_t SIZE = 61;
+  const ComplexArray m_Z = testArray(SIZE);
+
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+};
+
+TEST_P(ComplexMathTest, ExpLog) {
+  expectNear(exp(m_Z), reference(m_Z, [](Complex z) { return exp(z); }), TEST_EPSILON);
+  expectNear(log(m_Z), reference(m_Z, [](Complex z) { return log(z); }), TEST_EPSILON);
+}
+
+TEST_P(ComplexMathTest, Trigonometric) {
+  expectNear(sin(m_Z), reference(m_Z, [](Complex z) { return sin(z); }), TEST_EPSILON);
+  expectNear(cos(m_Z), reference(m_Z, [](Complex z) { return cos(z); }), TEST_EPSILON);
+  expectNear(tan(m_Z), reference(m_Z, [](Complex z) { return tan(z); }), TEST_EPSILON);
+  const ComplexArray large = {Complex(0.5, 30), Complex(-1, -25), Complex(2, 400)};
+  const ComplexArray tangents = tan(large);
+  for (std::size_t i = 0; i < large.size(); ++i) {
+    EXPECT_NEAR(tangents[i].real(), 0, TEST_EPSILON);
+    EXPECT_DOUBLE_EQ(tangents[i].imag(), std::copysign(1.0, large[i].imag()));
+  }
+}
+
+TEST_P(ComplexMathTest, InverseTrigonometric) {
+  expectNear(asin(m_Z), reference(m_Z, [](Complex z) { return asin(z); }), TEST_EPSILON);
+  expectNear(acos(m_Z), reference(m_Z, [](Complex z) { return acos(z); }), TEST_EPSILON);
+  expectNear(atan(m_Z), reference(m_Z, [](Complex z) { return atan(z); }), TEST_EPSILON);
+}
+
+TEST_P(ComplexMathTest, Sqrt) {
+  expectNear(sqrt(m_Z), reference(m_Z, [](Complex z) { return sqrt(z); }), TEST_EPSILON);
+  const ComplexArray axes = {Complex(0, 0), Complex(4, 0), Complex(-4, 0), Complex(-4, -0.0), Complex(0, 2),
+                             Complex(-1e-20, 1)};
+  expectNear(sqrt(axes), reference(axes, [](Complex z) { return sqrt(z); }), TEST_EPSILON);
+}
+
+TEST_P(ComplexMathTest, Pow) {
+  const Complex w(0.75, -0.5);
+  expectNear(pow(m_Z, 2.5), reference(m_Z, [](Complex z) { return pow(z, 2.5); }), TEST_EPSILON);
+  expectNear(pow(m_Z, w), reference(m_Z, [&w](Complex z) { return pow(z, w); }), TEST_EPSILON);
+  const ComplexArray exponents = conj(m_Z) * 0.25;
+  std::vector<Complex> expected;
+  for (std::size_t i = 0; i < SIZE; ++i) expected.push_back(pow(static_cast<Complex>(m_Z[i]), exponents[i]));
+  expectNear(pow(m_Z, exponents), expected, TEST_EPSILON);
+  EXPECT_THROW(pow(m_Z, ComplexArray(SIZE + 1)), std::invalid_argument);
+}
+
+TEST_P(ComplexMathTest, Interleaved) {
+  std::vector<Complex> z(1000);
+  for (std::size_t i = 0; i < z.size(); ++i) z[i] = Complex(0.01 * i - 4, 0.003 * i);
+  std::vector<Complex> result(z.size());
+  exp<real_t>(z, result);
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    EXPECT_NEAR(result[i].real(), exp(z[i]).real(), TEST_EPSILON * abs(exp(z[i])));
+    EXPECT_NEAR(result[i].imag(), exp(z[i]).imag(), TEST_EPSILON * abs(exp(z[i])));
+  }
+  pow<real_t>(z, z, result);
+  for (std::size_t i = 1; i < z.size(); ++i) {
+    EXPECT_NEAR(result[i].real(), pow(z[i], z[i]).real(), TEST_EPSILON * (1 + abs(pow(z[i], z[i]))));
+    EXPECT_NEAR(result[i].imag(), pow(z[i], z[i]).imag(), TEST_EPSILON * (1 + abs(pow(z[i], z[i]))));
+  }
+  EXPECT_THROW(sin<real_t>(z, std::span<Complex>(result).first(3)), std::invalid_argument);
+}
+
+TEST_P(ComplexMathTest, RealAxisUlp) {
+  // On the real axis exp, sin and cos reduce to the real primitives (see SimdMath.h for their error bounds)
+  constexpr std::size_t COUNT = 4001;
+  ComplexArrayD x(COUNT);
+  BasicComplexArray<float> xf(COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    x[i] = ComplexD(-700 + 0.35 * i, 0);
+    xf[i] = ComplexF(-100 + 0.0465F * i, 0);
+  }
+  const ComplexArrayD e = exp(x);
+  const BasicComplexArray<float> ef = exp(xf);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    EXPECT_LE(ulpError(e[i].real(), std::exp(static_cast<long double>(x[i].real()))), 2) << x[i].real();
+    EXPECT_LE(ulpError(ef[i].real(), std::exp(static_cast<long double>(xf[i].real()))), 2) << xf[i].real();
+  }
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    x[i] = ComplexD(-1000 + 0.5 * i, 0);
+    xf[i] = ComplexF(-100 + 0.05F * i, 0);
+  }
+  const ComplexArrayD s = sin(x);
+  const ComplexArrayD c = cos(x);
+  const BasicComplexArray<float> sf = sin(xf);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    EXPECT_LE(ulpError(s[i].real(), std::sin(static_cast<long double>(x[i].real()))), 2) << x[i].real();
+    EXPECT_LE(ulpError(c[i].real(), std::cos(static_cast<long double>(x[i].real()))), 2) << x[i].real();
+    EXPECT_LE(ulpError(sf[i].real(), std::sin(static_cast<long double>(xf[i].real()))), 2) << xf[i].real();
+  }
+}
+
+TEST_P(ComplexMathTest, SpecialValues) {
+  const double inf = std::numeric_limits<double>::infinity();
+  const ComplexArrayD e = exp(ComplexArrayD{ComplexD(800, 0), ComplexD(-800, 1), ComplexD(1e-310, 0)});
+  EXPECT_EQ(e[0].real(), inf);
+  EXPECT_EQ(e[1].real(), 0);
+  EXPECT_DOUBLE_EQ(e[2].real(), 1);
+  const ComplexArrayD l = log(ComplexArrayD{ComplexD(0, 0), ComplexD(1e-300, 0), ComplexD(-1, 0)});
+  EXPECT_EQ(l[0].real(), -inf);
+  EXPECT_DOUBLE_EQ(l[1].real(), std::log(1e-300));
+  EXPECT_DOUBLE_EQ(l[2].imag(), M_PI);
+  const ComplexArrayD s = sin(ComplexArrayD{ComplexD(1e7, 0), ComplexD(-3e8, 0)});
+  EXPECT_DOUBLE_EQ(s[0].real(), std::sin(1e7));
+  EXPECT_DOUBLE_EQ(s[1].real(), std::sin(-3e8));
+}
+
+TEST_P(ComplexMathTest, PowerSequences) {
+  constexpr std::size_t COUNT = 20000;
+  const Complex z = Complex(1.00002, 0) * Complex(std::cos(0.013), std::sin(0.013));
+  const Complex start(-0.5, 2);
+  ComplexArray sequence(COUNT);
+  std::vector<Complex> interleaved(COUNT);
+  powers<real_t>(z, sequence);
+  geometric<real_t>(start, z, interleaved);
+  for (std::size_t k = 0; k < COUNT; k += 7) {
+    const std::complex<long double> expected = std::pow(std::complex<long double>(z.real(), z.imag()), k);
+    const long double tolerance = TEST_EPSILON * std::abs(expected);
+    EXPECT_NEAR(sequence[k].real(), expected.real(), tolerance) << k;
+    EXPECT_NEAR(sequence[k].imag(), expected.imag(), tolerance) << k;
+    const Complex product = start * static_cast<Complex>(sequence[k]);
+    EXPECT_NEAR(interleaved[k].real(), product.real(), 2 * tolerance * abs(start)) << k;
+    EXPECT_NEAR(interleaved[k].imag(), product.imag(), 2 * tolerance * abs(start)) << k;
+  }
+  EXPECT_EQ(sequence[0].real(), 1);
+  EXPECT_EQ(sequence[0].imag(), 0);
+  EXPECT_EQ(interleaved[0].real(), start.real());
+  EXPECT_EQ(interleaved[0].imag(), start.imag());
+  powers<real_t>(z, std::span<Complex>());
+}
+
+TEST_P(ComplexMathTest, Phasors) {
+  constexpr std::size_t COUNT = 100003;
+  constexpr real_t PHASE = 0.3;
+  constexpr real_t FREQUENCY = -2.1;
+  ComplexArray sequence(COUNT);
+  std::vector<Complex> interleaved(COUNT);
+  phasors<real_t>(PHASE, FREQUENCY, sequence);
+  phasors<real_t>(PHASE, FREQUENCY, interleaved);
+  for (std::size_t k = 0; k < COUNT; ++k) {
+    const long double angle = static_cast<long double>(PHASE) + static_cast<long double>(FREQUENCY) * k;
+    ASSERT_NEAR(sequence[k].real(), std::cos(angle), TEST_EPSILON) << k;
+    ASSERT_NEAR(sequence[k].imag(), std::sin(angle), TEST_EPSILON) << k;
+    ASSERT_EQ(interleaved[k].real(), sequence[k].real()) << k;
+    ASSERT_EQ(interleaved[k].imag(), sequence[k].imag()) << k;
+  }
+}
+
+TEST_P(ComplexMathTest, SinglePrecision) {
+  BasicComplexArray<float> z(29);
+  for (std::size_t i = 0; i < z.size(); ++i) z[i] = ComplexF(0.3F * i - 4, 1.5F - 0.1F * i);
+  const BasicComplexArray<float> e = exp(z);
+  const BasicComplexArray<float> l = log(z);
+  const BasicComplexArray<float> s = sin(z);
+  const BasicComplexArray<float> r = sqrt(z);
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    const ComplexD zd(z[i].real(), z[i].imag());
+    EXPECT_NEAR(e[i].real(), exp(zd).real(), 1e-6 * abs(exp(zd)));
+    EXPECT_NEAR(e[i].imag(), exp(zd).imag(), 1e-6 * abs(exp(zd)));
+    EXPECT_NEAR(l[i].real(), log(zd).real(), 1e-6);
+    EXPECT_NEAR(l[i].imag(), log(zd).imag(), 1e-6);
+    EXPECT_NEAR(s[i].real(), sin(zd).real(), 1e-6 * abs(sin(zd)));
+    EXPECT_NEAR(s[i].imag(), sin(zd).imag(), 1e-6 * abs(sin(zd)));
+    EXPECT_NEAR(r[i].real(), sqrt(zd).real(), 1e-6);
+    EXPECT_NEAR(r[i].imag(), sqrt(zd).imag(), 1e-6);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, ComplexMathTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
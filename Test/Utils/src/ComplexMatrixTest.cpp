@@ -0,0 +1,178 @@
+#include "ComplexMatrix.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+#include "Simd.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+template <typename T>
+BasicComplexMatrix<T> testMatrix(const std::size_t rows, const std::size_t cols, const MatrixLayout layout,
+                                  const real_t seed) {
+  BasicComplexMatrix<T> m(rows, cols, layout);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) {
+      m(i, j) = BasicComplex<T>(static_cast<T>(std::sin(seed + 0.7 * i + 1.3 * j)),
+                                static_cast<T>(std::cos(seed * 0.5 + 0.2 * i - 0.9 * j)));
+    }
+  }
+  return m;
+}
+
+template <typename T>
+BasicComplex<long double> widen(const BasicComplex<T>& z) {
+  return BasicComplex<long double>(z.real(), z.imag());
+}
+
+/// Reference product alpha a b + beta c in long double
+template <typename T>
+BasicComplexMatrix<T> naiveGemm(const BasicComplex<T>& alpha, const ComplexMatrixView<const T> a,
+                                const ComplexMatrixView<const T> b, const BasicComplex<T>& beta,
+                                const ComplexMatrixView<const T> c) {
+  BasicComplexMatrix<T> result(c.rows(), c.cols());
+  for (std::size_t i = 0; i < c.rows(); ++i) {
+    for (std::size_t j = 0; j < c.cols(); ++j) {
+      BasicComplex<long double> sum;
+      for (std::size_t p = 0; p < a.cols(); ++p) sum += widen(a(i, p)) * widen(b(p, j));
+      sum = widen(alpha) * sum + widen(beta) * widen(c(i, j));
+      result(i, j) = BasicComplex<T>(static_cast<T>(sum.real()), static_cast<T>(sum.imag()));
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void expectNear(const ComplexMatrixView<const T> result, const ComplexMatrixView<const T> expected,
+                const real_t epsilon) {
+  ASSERT_EQ(result.rows(), expected.rows());
+  ASSERT_EQ(result.cols(), expected.cols());
+  for (std::size_t i = 0; i < result.rows(); ++i) {
+    for (std::size_t j = 0; j < result.cols(); ++j) {
+      EXPECT_NEAR(result(i, j).real(), expected(i, j).real(), epsilon) << i << ", " << j;
+      EXPECT_NEAR(result(i, j).imag(), expected(i, j).imag(), epsilon) << i << ", " << j;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ComplexMatrixTest, Construction) {
+  const ComplexMatrix m = {{Complex(1, 2), Complex(3, 4), Complex(5, 6)},
+                           {Complex(7, 8), Complex(9, 10), Complex(11, 12)}};
+  EXPECT_EQ(m.rows(), 2);
+  EXPECT_EQ(m.cols(), 3);
+  EXPECT_EQ(m(1, 2).real(), 11);
+  EXPECT_EQ(m.data()[3].imag(), 8);
+
+  const ComplexMatrix columns(m.view(), MatrixLayout::ColumnMajor);
+  EXPECT_EQ(columns.layout(), MatrixLayout::ColumnMajor);
+  EXPECT_EQ(columns(1, 2).imag(), 12);
+  EXPECT_EQ(columns.data()[1].real(), 7);
+
+  const ComplexMatrix identity = ComplexMatrix::identity(3);
+  EXPECT_EQ(identity(1, 1).real(), 1);
+  EXPECT_EQ(identity(1, 2).real(), 0);
+
+  EXPECT_THROW(ComplexMatrix({{Complex(1, 0)}, {Complex(1, 0), Complex(2, 0)}}), std::invalid_argument);
+  EXPECT_THROW(ComplexMatrix(MAX_ELEMENT_COUNT, 2), std::length_error);
+}
+
+TEST(ComplexMatrixTest, Views) {
+  ComplexMatrix m = testMatrix<real_t>(5, 7, MatrixLayout::RowMajor, 0.3);
+  const ComplexMatrixView<real_t> block = m.submatrix(1, 2, 3, 4);
+  EXPECT_EQ(block.rows(), 3);
+  EXPECT_EQ(block(2, 3).real(), m(3, 5).real());
+  block(0, 0) = Complex(42, 0);
+  EXPECT_EQ(m(1, 2).real(), 42);
+
+  const ComplexMatrixView<const real_t> transposed = block.transposed();
+  EXPECT_EQ(transposed.rows(), 4);
+  EXPECT_EQ(transposed(3, 2).imag(), m(3, 5).imag());
+  EXPECT_EQ(transposed.submatrix(1, 1, 2, 2)(1, 0).real(), m(2, 4).real());
+  EXPECT_THROW(static_cast<void>(block.submatrix(2, 0, 2, 1)), std::invalid_argument);
+  EXPECT_TRUE(block.submatrix(3, 4, 0, 0).empty());
+}
+
+class GemmTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+};
+
+TEST_P(GemmTest, Shapes) {
+  ThreadPool pool(3);
+  const Complex alpha(0.5, -1.25);
+  const Complex beta(-0.75, 0.5);
+  for (const auto& [m, n, k] : {std::tuple<std::size_t, std::size_t, std::size_t>{1, 1, 1}, {3, 5, 7}, {17, 13, 1},
+                                {31, 37, 300}, {100, 7, 64}, {5, 200, 33}, {130, 66, 513}}) {
+    for (const MatrixLayout layout : {MatrixLayout::RowMajor, MatrixLayout::ColumnMajor}) {
+      const ComplexMatrix a = testMatrix<real_t>(m, k, layout, 0.1);
+      const ComplexMatrix b = testMatrix<real_t>(k, n, MatrixLayout::RowMajor, 0.7);
+      ComplexMatrix c = testMatrix<real_t>(m, n, layout, 1.9);
+      const ComplexMatrix expected = naiveGemm<real_t>(alpha, a, b, beta, c);
+      gemm(alpha, a, b, beta, c, pool);
+      expectNear<real_t>(c, expected, scaledTolerance<real_t>(1e-13) * static_cast<real_t>(k));
+    }
+  }
+}
+
+TEST_P(GemmTest, StridedViews) {
+  const ComplexMatrix a = testMatrix<real_t>(40, 50, MatrixLayout::ColumnMajor, 0.2);
+  const ComplexMatrix b = testMatrix<real_t>(60, 45, MatrixLayout::RowMajor, 0.4);
+  ComplexMatrix c(50, 70);
+  // c[10:30, 5:35] = a[3:23, 7:40] * b[20:55, 2:32]^T
+  const ComplexMatrixView<const real_t> lhs = a.submatrix(3, 7, 20, 33);
+  const ComplexMatrixView<const real_t> rhs = b.submatrix(20, 2, 30, 33).transposed();
+  const ComplexMatrixView<real_t> result = c.submatrix(10, 5, 20, 30);
+  gemm(Complex(1, 0), lhs, rhs, Complex(0, 0), result);
+  const ComplexMatrix expected = naiveGemm<real_t>(Complex(1, 0), lhs, rhs, Complex(0, 0), result);
+  expectNear<real_t>(result, expected, scaledTolerance<real_t>(1e-12));
+  EXPECT_EQ(c(9, 5).real(), 0);
+  EXPECT_EQ(c(30, 5).real(), 0);
+  EXPECT_EQ(c(10, 35).real(), 0);
+}
+
+TEST_P(GemmTest, BetaZeroIgnoresC) {
+  const ComplexMatrix a = testMatrix<real_t>(9, 4, MatrixLayout::RowMajor, 0.2);
+  const ComplexMatrix b = testMatrix<real_t>(4, 6, MatrixLayout::RowMajor, 0.4);
+  ComplexMatrix c(9, 6);
+  const real_t nan = std::numeric_limits<real_t>::quiet_NaN();
+  for (std::size_t i = 0; i < 9; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) c(i, j) = Complex(nan, nan);
+  }
+  gemm(Complex(1, 0), a, b, Complex(0, 0), c);
+  expectNear<real_t>(c, a * b, 0);
+  const ComplexMatrix expected = naiveGemm<real_t>(Complex(1, 0), a, b, Complex(0, 0), ComplexMatrix(9, 6));
+  expectNear<real_t>(c, expected, scaledTolerance<real_t>(1e-14));
+  EXPECT_THROW(gemm(Complex(1, 0), a, a, Complex(0, 0), c), std::invalid_argument);
+}
+
+TEST_P(GemmTest, SinglePrecision) {
+  const BasicComplexMatrix<float> a = testMatrix<float>(70, 90, MatrixLayout::RowMajor, 0.2);
+  const BasicComplexMatrix<float> b = testMatrix<float>(90, 50, MatrixLayout::ColumnMajor, 0.4);
+  const BasicComplexMatrix<float> c = a * b;
+  expectNear<float>(c, naiveGemm<float>(ComplexF(1, 0), a, b, ComplexF(0, 0), c), 2e-4);
+}
+
+TEST_P(GemmTest, MixedPrecision) {
+  if (!std::same_as<accumulator_t<float>, double>) GTEST_SKIP() << "float accumulates in float";
+  // The products are rounded to float once per panel of the inner dimension instead of once per term
+  const BasicComplexMatrix<float> a = testMatrix<float>(20, 1000, MatrixLayout::RowMajor, 0.2);
+  const BasicComplexMatrix<float> b = testMatrix<float>(1000, 30, MatrixLayout::ColumnMajor, 0.4);
+  const BasicComplexMatrix<float> c = a * b;
+  expectNear<float>(c, naiveGemm<float>(ComplexF(1, 0), a, b, ComplexF(0, 0), c), 2e-5);
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, GemmTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
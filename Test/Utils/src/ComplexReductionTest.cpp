@@ -0,0 +1,229 @@
+#include "ComplexReduction.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <utility>
+#include <stdexcept>
+
+#include "ComplexArray.h"
+#include "Simd.h"
+#include "TestTolerance.h"
+#include "ThreadPool.h"
+
+using namespace Math;
+
+namespace {
+
+/// Sizes that end in every tail of the kernels, and that span several parallel chunks
+constexpr std::size_t SIZES[] = {0, 1, 15, 16, 17, 1003, 2 * REDUCTION_GRAIN + 5};
+
+template <scalar T>
+void expectEqual(const BasicComplex<T>& result, const BasicComplex<T>& expected) {
+  EXPECT_EQ(result.real(), expected.real());
+  EXPECT_EQ(result.imag(), expected.imag());
+}
+
+template <scalar T>
+BasicComplexArray<T> randomArray(const std::size_t size, const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<T> uniform(-1, 1);
+  BasicComplexArray<T> z(static_cast<Math::size_t>(size));
+  for (std::size_t i = 0; i < size; ++i) z[i] = BasicComplex<T>(uniform(generator), uniform(generator));
+  return z;
+}
+
+/// Numbers whose large parts cancel exactly, which a plain loop loses: (big, -big, 1, -big, big, 1, ...) for the real
+/// parts, the imaginary parts scaled by -2. The sum of every three elements is (1, -2).
+template <scalar T>
+BasicComplexArray<T> cancellingArray(const std::size_t triples) {
+  const T big = T(1) / std::numeric_limits<T>::epsilon();
+  BasicComplexArray<T> z(static_cast<Math::size_t>(3 * triples));
+  for (std::size_t k = 0; k < triples; ++k) {
+    const T sign = k % 2 == 0 ? T(1) : T(-1);
+    const T x = sign * big * T(1 + k % 7);
+    z[3 * k] = BasicComplex<T>(x, -2 * x);
+    z[3 * k + 1] = BasicComplex<T>(-x, 2 * x);
+    z[3 * k + 2] = BasicComplex<T>(1, -2);
+  }
+  // Reorder so that the large parts are not adjacent
+  for (std::size_t k = 1; k + 1 < 3 * triples; k += 3) {
+    const BasicComplex<T> large = z[k];
+    z[k] = z[k + 1];
+    z[k + 1] = large;
+  }
+  return z;
+}
+
+template <scalar T>
+void expectSums() {
+  const T tolerance = 4 * std::numeric_limits<T>::epsilon();
+  for (const std::size_t size : SIZES) {
+    const BasicComplexArray<T> x = randomArray<T>(size, 1);
+    const BasicComplexArray<T> y = randomArray<T>(size, 2);
+    BasicComplex<long double> expectedSum;
+    BasicComplex<long double> expectedDotu;
+    BasicComplex<long double> expectedDotc;
+    long double expectedNorm = 0;
+    long double magnitude = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      const BasicComplex<long double> a(x.real()[i], x.imag()[i]);
+      const BasicComplex<long double> b(y.real()[i], y.imag()[i]);
+      expectedSum += a;
+      expectedDotu += a * b;
+      expectedDotc += conj(a) * b;
+      expectedNorm += abs2(a);
+      magnitude += abs2(a) + abs2(b);
+    }
+    const BasicComplex<T> s = sum<T>(x);
+    EXPECT_NEAR(s.real(), expectedSum.real(), tolerance * std::fabs(expectedSum.real()) + 1e-30) << size;
+    EXPECT_NEAR(s.imag(), expectedSum.imag(), tolerance * std::fabs(expectedSum.imag()) + 1e-30) << size;
+    // The products are compensated only with a fused multiply-add, so the dot products are bounded by their terms
+    const BasicComplex<T> u = dotu<T>(x, y);
+    const BasicComplex<T> c = dotc<T>(x, y);
+    EXPECT_NEAR(u.real(), expectedDotu.real(), tolerance * magnitude + 1e-30) << size;
+    EXPECT_NEAR(u.imag(), expectedDotu.imag(), tolerance * magnitude + 1e-30) << size;
+    EXPECT_NEAR(c.real(), expectedDotc.real(), tolerance * magnitude + 1e-30) << size;
+    EXPECT_NEAR(c.imag(), expectedDotc.imag(), tolerance * magnitude + 1e-30) << size;
+    EXPECT_NEAR(squaredNorm<T>(x), expectedNorm, tolerance * expectedNorm) << size;
+  }
+}
+
+template <scalar T>
+void expectCompensation() {
+  for (const std::size_t triples : {std::size_t(1), std::size_t(100), REDUCTION_GRAIN}) {
+    const BasicComplexArray<T> z = cancellingArray<T>(triples);
+    const BasicComplex<T> s = sum<T>(z);
+    EXPECT_EQ(s.real(), T(triples)) << triples;
+    EXPECT_EQ(s.imag(), -2 * T(triples)) << triples;
+    // Products with +-1 are exact, so the dot products cancel exactly as well
+    const BasicComplexArray<T> ones(z.size(), BasicComplex<T>(1, 0));
+    expectEqual(dotu<T>(z, ones), s);
+    expectEqual(dotc<T>(ones, z), s);
+    expectEqual(dotc<T>(z, ones), conj(s));
+  }
+}
+
+template <scalar T>
+void expectMaxAbsIndex() {
+  for (const std::size_t size : SIZES) {
+    BasicComplexArray<T> z = randomArray<T>(size, 3);
+    if (size == 0) {
+      EXPECT_EQ(maxAbsIndex<T>(z), 0U);
+      continue;
+    }
+    // The largest magnitude twice, the first one wins
+    const std::size_t first = size / 3;
+    z[first] = BasicComplex<T>(3, -4);
+    z[size - 1] = BasicComplex<T>(-4, 3);
+    EXPECT_EQ(maxAbsIndex<T>(z), first) << size;
+    z[size - 1] = BasicComplex<T>(NAN, 10);
+    EXPECT_EQ(maxAbsIndex<T>(z), first) << size;
+  }
+  // Squared magnitudes that overflow
+  const T large = std::sqrt(std::numeric_limits<T>::max());
+  BasicComplexArray<T> z = randomArray<T>(100, 4);
+  z[10] = BasicComplex<T>(2 * large, 0);
+  z[70] = BasicComplex<T>(0, -3 * large);
+  EXPECT_EQ(maxAbsIndex<T>(z), 70U);
+  EXPECT_EQ(maxAbsIndex<T>(BasicComplexArray<T>(20, BasicComplex<T>(NAN, 0))), 0U);
+}
+
+template <scalar T>
+void expectSlidingDot() {
+  const T tolerance = scaledTolerance<T>(1e-14) * 64;
+  for (const std::size_t m : {1, 3, 16, 37}) {
+    for (const auto& [inStride, outStride] : {std::pair<std::size_t, std::size_t>{1, 1}, {3, 1}, {1, 2}, {2, 5}}) {
+      const std::size_t count = 101;
+      const BasicComplexArray<T> x = randomArray<T>((count - 1) * inStride + m, 7);
+      const BasicComplexArray<T> taps = randomArray<T>(m, 8);
+      const BasicComplex<T> untouched(5, -5);
+      BasicComplexArray<T> out((count - 1) * outStride + 1, untouched);
+      slidingDot<T>(x, taps, out, inStride, outStride);
+      for (std::size_t i = 0; i < out.size(); ++i) {
+        if (i % outStride != 0) {
+          expectEqual<T>(out[i], untouched);
+          continue;
+        }
+        BasicComplex<long double> expected;
+        for (std::size_t k = 0; k < m; ++k) {
+          const std::size_t j = i / outStride * inStride + k;
+          expected += BasicComplex<long double>(taps.real()[k], taps.imag()[k]) *
+                      BasicComplex<long double>(x.real()[j], x.imag()[j]);
+        }
+        EXPECT_NEAR(out[i].real(), expected.real(), tolerance) << m << ' ' << i;
+        EXPECT_NEAR(out[i].imag(), expected.imag(), tolerance) << m << ' ' << i;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+class ComplexReductionTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+};
+
+TEST_P(ComplexReductionTest, Accuracy) {
+  expectSums<float>();
+  expectSums<double>();
+}
+
+TEST_P(ComplexReductionTest, Compensation) {
+  expectCompensation<float>();
+  expectCompensation<double>();
+}
+
+TEST_P(ComplexReductionTest, MaxAbsIndex) {
+  expectMaxAbsIndex<float>();
+  expectMaxAbsIndex<double>();
+}
+
+TEST_P(ComplexReductionTest, SlidingDot) {
+  expectSlidingDot<float>();
+  expectSlidingDot<double>();
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, ComplexReductionTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
+
+TEST(ComplexReductionBasicTest, Deterministic) {
+  const ComplexArray x = randomArray<real_t>(5 * REDUCTION_GRAIN + 17, 5);
+  const ComplexArray y = randomArray<real_t>(x.size(), 6);
+  ThreadPool serial(1);
+  const Complex expectedSum = sum<real_t>(x, serial);
+  const Complex expectedDot = dotc<real_t>(x, y, serial);
+  const real_t expectedNorm = squaredNorm<real_t>(x, serial);
+  for (const std::size_t threads : {2, 3, 8}) {
+    ThreadPool pool(threads);
+    expectEqual(sum<real_t>(x, pool), expectedSum);
+    expectEqual(dotc<real_t>(x, y, pool), expectedDot);
+    EXPECT_EQ(squaredNorm<real_t>(x, pool), expectedNorm);
+  }
+}
+
+TEST(ComplexReductionBasicTest, ExtendedPrecision) {
+  const BasicComplexArray<long double> z{{1, 2}, {3, -4}, {-5, 6}};
+  expectEqual(sum<long double>(z), BasicComplex<long double>(-1, 4));
+  expectEqual(dotu<long double>(z, z), BasicComplex<long double>(-21, -80));
+  expectEqual(dotc<long double>(z, z), BasicComplex<long double>(91, 0));
+  EXPECT_EQ(squaredNorm<long double>(z), 91);
+  EXPECT_EQ(maxAbsIndex<long double>(z), 2U);
+}
+
+TEST(ComplexReductionBasicTest, Errors) {
+  EXPECT_THROW(dotu<real_t>(ComplexArray(3), ComplexArray(4)), std::invalid_argument);
+  EXPECT_THROW(dotc<real_t>(ComplexArray(3), ComplexArray(2)), std::invalid_argument);
+  ComplexArray out(4);
+  EXPECT_THROW(slidingDot<real_t>(ComplexArray(5), ComplexArray(3), out), std::invalid_argument);
+  EXPECT_THROW(slidingDot<real_t>(ComplexArray(6), ComplexArray(3), out, 0), std::invalid_argument);
+}
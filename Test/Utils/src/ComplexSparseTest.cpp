@@ -0,0 +1,310 @@
+#include "ComplexSparse.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "Simd.h"
+#include "ThreadPool.h"
+
+using namespace Math;
+
+namespace {
+
+void expectEqual(const Complex& result, const Complex& expected) {
+  EXPECT_EQ(result.real(), expected.real());
+  EXPECT_EQ(result.imag(), expected.imag());
+}
+
+template <scalar T>
+std::vector<SparseEntry<T>> randomEntries(const Math::size_t rows, const Math::size_t cols, const std::size_t count,
+                                          const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<T> uniform(-1, 1);
+  std::vector<SparseEntry<T>> entries;
+  if (rows == 0 || cols == 0) return entries;
+  for (std::size_t k = 0; k < count; ++k) {
+    const auto row = static_cast<Math::size_t>(generator() % rows);
+    const auto col = static_cast<Math::size_t>(generator() % cols);
+    entries.push_back({row, col, BasicComplex<T>(uniform(generator), uniform(generator))});
+  }
+  return entries;
+}
+
+template <scalar T>
+BasicComplexArray<T> randomArray(const Math::size_t size, const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<T> uniform(-1, 1);
+  BasicComplexArray<T> z(size);
+  for (Math::size_t i = 0; i < size; ++i) z[i] = BasicComplex<T>(uniform(generator), uniform(generator));
+  return z;
+}
+
+/// Checks every product of a matrix against the sums over its entries, in which duplicates add up
+template <typename Matrix, scalar T = typename Matrix::scalar_type>
+void expectProducts(const Matrix& a, const std::vector<SparseEntry<T>>& entries, ThreadPool& pool) {
+  constexpr SparseOperation OPERATIONS[] = {SparseOperation::None, SparseOperation::Transpose,
+                                            SparseOperation::Adjoint};
+  for (const SparseOperation operation : OPERATIONS) {
+    const bool transposed = operation != SparseOperation::None;
+    const BasicComplexArray<T> x = randomArray<T>(transposed ? a.rows() : a.cols(), 7);
+    BasicComplexArray<T> y(transposed ? a.cols() : a.rows(), BasicComplex<T>(NAN, NAN));
+    a.multiply(x, y, operation, pool);
+    std::vector<BasicComplex<long double>> expected(y.size());
+    std::vector<long double> magnitude(y.size());
+    for (const SparseEntry<T>& e : entries) {
+      BasicComplex<long double> value(e.value.real(), e.value.imag());
+      if (operation == SparseOperation::Adjoint) value = conj(value);
+      const Math::size_t i = transposed ? e.col : e.row;
+      const BasicComplex<T> xj = x[transposed ? e.row : e.col];
+      expected[i] += value * BasicComplex<long double>(xj.real(), xj.imag());
+      magnitude[i] += abs(value) * abs(xj);
+    }
+    const T epsilon = std::numeric_limits<T>::epsilon();
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      const BasicComplex<T> yi = y[i];
+      const long double tolerance = 4 * epsilon * magnitude[i];
+      // Compared in long double, EXPECT_NEAR would round the extended precision results to double
+      EXPECT_LE(std::abs(yi.real() - expected[i].real()), tolerance) << i << " " << int(operation);
+      EXPECT_LE(std::abs(yi.imag() - expected[i].imag()), tolerance) << i << " " << int(operation);
+    }
+  }
+}
+
+template <scalar T>
+void expectCompressedProducts() {
+  ThreadPool pool(3);
+  // Rows shorter and longer than the widest pack, enough elements for several parallel chunks, and long vectors with
+  // too few elements for a partial vector per thread
+  const struct {
+    Math::size_t rows;
+    Math::size_t cols;
+    std::size_t count;
+  } shapes[] = {{0, 0, 0}, {1, 1, 1}, {7, 5, 20}, {33, 40, 900}, {1500, 1100, 40 * SPARSE_GRAIN / 8},
+                {1 << 18, 1 << 18, 1 << 17}};
+  for (const auto& shape : shapes) {
+    const std::vector<SparseEntry<T>> entries = randomEntries<T>(shape.rows, shape.cols, shape.count, 1);
+    const BasicCsrMatrix<T> csr(shape.rows, shape.cols, entries);
+    const BasicCscMatrix<T> csc(shape.rows, shape.cols, entries);
+    expectProducts(csr, entries, pool);
+    expectProducts(csc, entries, pool);
+  }
+}
+
+template <scalar T>
+void expectBlockProducts() {
+  ThreadPool pool(3);
+  for (const Math::size_t block : {1U, 2U, 3U, 4U, 5U, 8U, 17U}) {
+    for (const Math::size_t blocks : {1U, 6U, 150U}) {
+      const Math::size_t rows = block * blocks;
+      const Math::size_t cols = block * (blocks + 2);
+      const std::vector<SparseEntry<T>> entries = randomEntries<T>(rows, cols, std::size_t(rows) * 12, 2);
+      const BasicBsrMatrix<T> bsr(BasicCsrMatrix<T>(rows, cols, entries), block);
+      EXPECT_EQ(bsr.nonZeros(), std::size_t(bsr.blockCount()) * block * block);
+      expectProducts(bsr, entries, pool);
+    }
+  }
+}
+
+/// Nonsymmetric, diagonally dominant complex system like an upwind discretization of convection and diffusion,
+/// with one long range coupling per row
+template <scalar T>
+BasicCsrMatrix<T> convectionMatrix(const Math::size_t n) {
+  std::vector<SparseEntry<T>> entries;
+  for (Math::size_t i = 0; i < n; ++i) {
+    entries.push_back({i, i, BasicComplex<T>(4, 1)});
+    if (i > 0) entries.push_back({i, i - 1, BasicComplex<T>(-1.5, 0.3)});
+    if (i + 1 < n) entries.push_back({i, i + 1, BasicComplex<T>(-0.5, -0.2)});
+    entries.push_back({i, static_cast<Math::size_t>((std::size_t(i) * 7919 + 13) % n), BasicComplex<T>(0.4, 0.6)});
+  }
+  return BasicCsrMatrix<T>(n, n, entries);
+}
+
+template <typename Matrix, scalar T = typename Matrix::scalar_type>
+T relativeResidual(const Matrix& a, const BasicComplexArray<T>& b, const BasicComplexArray<T>& x) {
+  BasicComplexArray<T> r(b.size());
+  a.multiply(x, r);
+  long double residual = 0;
+  long double norm = 0;
+  for (Math::size_t i = 0; i < b.size(); ++i) {
+    residual += abs2(BasicComplex<T>(b[i]) - BasicComplex<T>(r[i]));
+    norm += abs2(BasicComplex<T>(b[i]));
+  }
+  return static_cast<T>(std::sqrt(residual / norm));
+}
+
+template <typename Matrix, scalar T = typename Matrix::scalar_type>
+void expectSolutions(const Matrix& a, const double tolerance) {
+  const BasicComplexArray<T> b = randomArray<T>(a.rows(), 3);
+  for (const Math::size_t restart : {5U, 30U}) {
+    BasicComplexArray<T> x(a.rows());
+    const SolverStatus status = gmres(a, b, x, tolerance, 1000, restart);
+    EXPECT_TRUE(status.converged) << restart;
+    EXPECT_LE(status.residual, tolerance);
+    EXPECT_NEAR(relativeResidual(a, b, x), status.residual, tolerance);
+  }
+  BasicComplexArray<T> x(a.rows());
+  const SolverStatus status = bicgstab(a, b, x, tolerance, 1000);
+  EXPECT_TRUE(status.converged);
+  EXPECT_LE(status.residual, tolerance);
+  EXPECT_NEAR(relativeResidual(a, b, x), status.residual, tolerance);
+}
+
+}  // namespace
+
+class ComplexSparseTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+};
+
+TEST_P(ComplexSparseTest, CompressedProducts) {
+  expectCompressedProducts<float>();
+  expectCompressedProducts<double>();
+}
+
+TEST_P(ComplexSparseTest, BlockProducts) {
+  expectBlockProducts<float>();
+  expectBlockProducts<double>();
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, ComplexSparseTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
+
+TEST(ComplexSparseBasicTest, ExtendedPrecision) {
+  ThreadPool pool(2);
+  const std::vector<SparseEntry<long double>> entries = randomEntries<long double>(40, 30, 300, 4);
+  expectProducts(BasicCsrMatrix<long double>(40, 30, entries), entries, pool);
+  expectProducts(BasicCscMatrix<long double>(40, 30, entries), entries, pool);
+  expectProducts(BasicBsrMatrix<long double>(BasicCsrMatrix<long double>(40, 30, entries), 10), entries, pool);
+}
+
+TEST(ComplexSparseBasicTest, Construction) {
+  // Duplicates are added, explicit zeros of the entries are kept
+  const std::vector<SparseEntry<real_t>> entries = {
+      {1, 2, {1, 2}}, {0, 0, {3, 0}}, {1, 0, {0, 0}}, {1, 2, {-4, 1}}, {2, 1, {0, -1}}};
+  const CsrMatrix csr(3, 3, entries);
+  EXPECT_EQ(csr.nonZeros(), 4U);
+  EXPECT_EQ(std::vector<Math::size_t>(csr.offsets().begin(), csr.offsets().end()),
+            (std::vector<Math::size_t>{0, 1, 3, 4}));
+  EXPECT_EQ(std::vector<Math::size_t>(csr.indices().begin(), csr.indices().end()),
+            (std::vector<Math::size_t>{0, 0, 2, 1}));
+  expectEqual(csr.values()[2], Complex(-3, 3));
+  const ComplexMatrix dense = csr.toDense();
+  expectEqual(dense(1, 2), Complex(-3, 3));
+  expectEqual(dense(2, 2), Complex(0, 0));
+
+  // A dense matrix drops its zeros, and the conversions keep every element
+  const CscMatrix csc(dense.view());
+  EXPECT_EQ(csc.nonZeros(), 3U);
+  const CsrMatrix back = csc.toCsr();
+  const CscMatrix again = back.toCsc();
+  EXPECT_EQ(std::vector<Math::size_t>(again.indices().begin(), again.indices().end()),
+            std::vector<Math::size_t>(csc.indices().begin(), csc.indices().end()));
+  for (Math::size_t i = 0; i < 3; ++i) {
+    for (Math::size_t j = 0; j < 3; ++j) {
+      expectEqual(back.toDense()(i, j), dense(i, j));
+      expectEqual(csc.toDense()(i, j), dense(i, j));
+    }
+  }
+
+  // Blocks hold zeros where the CSR matrix has no element, which toCsr drops again
+  const std::vector<SparseEntry<real_t>> blockEntries = randomEntries<real_t>(12, 8, 20, 5);
+  const CsrMatrix a(12, 8, blockEntries);
+  const BsrMatrix bsr(a, 4);
+  EXPECT_EQ(bsr.blockSize(), 4U);
+  EXPECT_GE(bsr.nonZeros(), a.nonZeros());
+  const CsrMatrix unblocked = bsr.toCsr();
+  EXPECT_EQ(std::vector<Math::size_t>(unblocked.offsets().begin(), unblocked.offsets().end()),
+            std::vector<Math::size_t>(a.offsets().begin(), a.offsets().end()));
+  EXPECT_EQ(std::vector<Math::size_t>(unblocked.indices().begin(), unblocked.indices().end()),
+            std::vector<Math::size_t>(a.indices().begin(), a.indices().end()));
+  const ComplexMatrix expected = a.toDense();
+  const ComplexMatrix blocked = bsr.toDense();
+  for (Math::size_t i = 0; i < 12; ++i) {
+    for (Math::size_t j = 0; j < 8; ++j) expectEqual(blocked(i, j), expected(i, j));
+  }
+
+  // Compressed arrays that are passed in
+  const CsrMatrix raw(2, 3, {0, 2, 3}, {0, 2, 1}, {1, 2, 3}, {0, 0, 1});
+  expectEqual(raw.toDense()(1, 1), Complex(3, 1));
+}
+
+TEST(ComplexSparseBasicTest, Solvers) {
+  const double tolerance = MATH_DOUBLE_PRECISION && !MATH_MIXED_PRECISION ? 1e-10 : 1e-4;
+  const CsrMatrix csr = convectionMatrix<real_t>(3000);
+  expectSolutions(csr, tolerance);
+  expectSolutions(csr.toCsc(), tolerance);
+  expectSolutions(BsrMatrix(csr, 3), tolerance);
+  expectSolutions(convectionMatrix<long double>(200), 1e-12);
+
+  // Without restarts GMRES solves a system of size n in at most n iterations
+  const std::vector<SparseEntry<double>> entries = randomEntries<double>(12, 12, 60, 6);
+  BasicCsrMatrix<double> small(12, 12, entries);
+  std::vector<SparseEntry<double>> shifted = entries;
+  for (Math::size_t i = 0; i < 12; ++i) shifted.push_back({i, i, {3, 0}});
+  small = BasicCsrMatrix<double>(12, 12, shifted);
+  const BasicComplexArray<double> b = randomArray<double>(12, 8);
+  BasicComplexArray<double> x(12);
+  const SolverStatus status = gmres(small, b, x, 1e-12, 100, 12);
+  EXPECT_TRUE(status.converged);
+  EXPECT_LE(status.iterations, 12U);
+}
+
+TEST(ComplexSparseBasicTest, SolverLimits) {
+  const CsrMatrix a = convectionMatrix<real_t>(500);
+  // A zero right-hand side has the solution 0
+  ComplexArray x = randomArray<real_t>(500, 9);
+  SolverStatus status = bicgstab(a, ComplexArray(500), x, 1e-6, 100);
+  EXPECT_TRUE(status.converged);
+  EXPECT_EQ(status.iterations, 0U);
+  expectEqual(x[17], Complex(0, 0));
+  // The iteration limit stops the solvers, with the true residual
+  const ComplexArray b = randomArray<real_t>(500, 10);
+  for (const bool restarted : {false, true}) {
+    ComplexArray y(500);
+    status = restarted ? gmres(a, b, y, 1e-6, 3) : bicgstab(a, b, y, 1e-6, 2);
+    EXPECT_FALSE(status.converged);
+    EXPECT_EQ(status.iterations, restarted ? 3U : 2U);
+    EXPECT_GT(status.residual, 1e-6);
+    EXPECT_NEAR(relativeResidual(a, b, y), status.residual, 1e-4);
+  }
+}
+
+TEST(ComplexSparseBasicTest, Errors) {
+  const std::vector<SparseEntry<real_t>> outside = {{3, 0, {1, 0}}};
+  EXPECT_THROW(CsrMatrix(3, 3, outside), std::invalid_argument);
+  EXPECT_THROW(CscMatrix(3, 3, outside), std::invalid_argument);
+  EXPECT_THROW(CsrMatrix(MAX_ELEMENT_COUNT + 1, 1, {}), std::length_error);
+  // Offsets that decrease, columns that repeat, sizes that differ
+  EXPECT_THROW(CsrMatrix(2, 2, {0, 2, 1}, {0, 1}, {1, 1}, {0, 0}), std::invalid_argument);
+  EXPECT_THROW(CsrMatrix(1, 2, {0, 2}, {1, 1}, {1, 1}, {0, 0}), std::invalid_argument);
+  EXPECT_THROW(CscMatrix(2, 1, {0, 1}, {0}, {1, 1}, {0}), std::invalid_argument);
+  EXPECT_THROW(CscMatrix(2, 1, {0, 1}, {2}, {1}, {0}), std::invalid_argument);
+
+  const CsrMatrix a = convectionMatrix<real_t>(6);
+  EXPECT_THROW(BsrMatrix(a, 4), std::invalid_argument);
+  EXPECT_THROW(BsrMatrix(a, 0), std::invalid_argument);
+  ComplexArray x(6);
+  ComplexArray y(5);
+  EXPECT_THROW(a.multiply(x, y), std::invalid_argument);
+  EXPECT_THROW(a.toCsc().multiply(x, y, SparseOperation::Adjoint), std::invalid_argument);
+  EXPECT_THROW(BsrMatrix(a, 2).multiply(y, x), std::invalid_argument);
+
+  const CsrMatrix wide(3, 4, std::vector<SparseEntry<real_t>>{{0, 3, {1, 0}}});
+  ComplexArray b(3);
+  EXPECT_THROW(gmres(wide, b, b, 1e-6, 10), std::invalid_argument);
+  EXPECT_THROW(gmres(a, x, y, 1e-6, 10), std::invalid_argument);
+  EXPECT_THROW(gmres(a, x, x, 1e-6, 10, 0), std::invalid_argument);
+  EXPECT_THROW(bicgstab(a, y, x, 1e-6, 10), std::invalid_argument);
+}
@@ -2,10 +2,11 @@
 
 #include <complex>
 #include <gtest/gtest.h>
+#include <limits>
 
 using namespace Math;
 
-constexpr real_t TEST_EPSILON = 1e-9;
+constexpr real_t TEST_EPSILON = EPSILON<real_t>;
 
 TEST(ComplexTest, DefaultConstructor) {
   const Complex z;
@@ -176,6 +177,28 @@ TEST(ComplexTest, SqrtFunction) {
   EXPECT_NEAR(result.imag(), std_result.imag(), TEST_EPSILON);
 }
 
+TEST(ComplexTest, IntegerPowFunction) {
+  const Complex z(0.9, 0.6);
+  std::complex<real_t> std_power(1, 0);
+  for (int n = 0; n <= 40; ++n) {
+    const Complex result = pow(z, n);
+    EXPECT_NEAR(result.real(), std_power.real(), TEST_EPSILON * std::abs(std_power)) << n;
+    EXPECT_NEAR(result.imag(), std_power.imag(), TEST_EPSILON * std::abs(std_power)) << n;
+    const Complex inverse = pow(z, -n);
+    EXPECT_NEAR(inverse.real(), (real_t(1) / std_power).real(), TEST_EPSILON / std::abs(std_power)) << -n;
+    EXPECT_NEAR(inverse.imag(), (real_t(1) / std_power).imag(), TEST_EPSILON / std::abs(std_power)) << -n;
+    std_power *= std::complex<real_t>(0.9, 0.6);
+  }
+  // Exact for small Gaussian integers, and usable in constant expressions
+  static_assert(pow(Complex(1, 1), 8).real() == 16 && pow(Complex(1, 1), 8).imag() == 0);
+  static_assert(pow(Complex(0, 1), -3).real() == 0 && pow(Complex(0, 1), -3).imag() == 1);
+  const Complex power = pow(Complex(2, -1), 5U);
+  EXPECT_EQ(power.real(), -38);
+  EXPECT_EQ(power.imag(), -41);
+  EXPECT_EQ(pow(Complex(0, 0), 0).real(), 1);
+  EXPECT_EQ(pow(Complex(-1, 0), std::numeric_limits<int64_t>::min()).real(), 1);
+}
+
 /*
 TEST(ComplexTest, EqualityOperator) {
   const Complex z1(1, 2);
@@ -318,4 +341,66 @@ TEST(ComplexTest, DivisionOperatorRealComplex) {
   const std::complex<real_t> std_result = r / std_z;
   EXPECT_NEAR(result.real(), std_result.real(), TEST_EPSILON);
   EXPECT_NEAR(result.imag(), std_result.imag(), TEST_EPSILON);
-}
\ No newline at end of file
+}
+
+TEST(ComplexTest, ScaledDivideFunction) {
+  const Complex result = scaledDivide(Complex(10, 5), Complex(2, 1));
+  EXPECT_NEAR(result.real(), 5, TEST_EPSILON * 5);
+  EXPECT_NEAR(result.imag(), 0, TEST_EPSILON * 5);
+  const Complex swapped = scaledDivide(Complex(-5, 10), Complex(1, 2));
+  EXPECT_NEAR(swapped.real(), 3, TEST_EPSILON * 5);
+  EXPECT_NEAR(swapped.imag(), 4, TEST_EPSILON * 5);
+
+  // The squared magnitude of the divisor overflows, and underflows for the reciprocal
+  const real_t large = std::numeric_limits<real_t>::max() / 4;
+  const Complex ratio = scaledDivide(Complex(large, large), Complex(large, -large));
+  EXPECT_NEAR(ratio.real(), 0, TEST_EPSILON);
+  EXPECT_NEAR(ratio.imag(), 1, TEST_EPSILON);
+  const real_t small = std::numeric_limits<real_t>::min() * 4;
+  const Complex tiny = scaledDivide(Complex(small, 0), Complex(small, small));
+  EXPECT_NEAR(tiny.real(), real_t(0.5), TEST_EPSILON);
+  EXPECT_NEAR(tiny.imag(), real_t(-0.5), TEST_EPSILON);
+}
+
+TEST(ComplexTest, TriviallyCopyable) {
+  EXPECT_TRUE(std::is_trivially_copyable_v<ComplexF>);
+  EXPECT_TRUE(std::is_trivially_copyable_v<ComplexD>);
+  EXPECT_TRUE(std::is_trivially_copyable_v<ComplexLD>);
+  EXPECT_EQ(sizeof(Complex), 2 * sizeof(real_t));
+}
+
+TEST(ComplexTest, ConstexprArithmetic) {
+  constexpr Complex z1(1, 2);
+  constexpr Complex z2(3, 4);
+  constexpr Complex result = conj(z1 * z2 + z1 / z2 - real_t(2) * z1);
+  constexpr std::complex<real_t> std_result = std::conj(std::complex<real_t>(1, 2) * std::complex<real_t>(3, 4) +
+                                                        std::complex<real_t>(1, 2) / std::complex<real_t>(3, 4) -
+                                                        real_t(2) * std::complex<real_t>(1, 2));
+  static_assert(abs2(Complex(3, 4)) == 25);
+  EXPECT_NEAR(result.real(), std_result.real(), TEST_EPSILON);
+  EXPECT_NEAR(result.imag(), std_result.imag(), TEST_EPSILON);
+}
+
+TEST(ComplexTest, SinglePrecision) {
+  const ComplexF z1(0.5F, 0.3F);
+  const ComplexF z2(2, -1);
+  const std::complex<float> std_z1(0.5F, 0.3F);
+  const std::complex<float> std_z2(2, -1);
+  const ComplexF product = z1 * z2;
+  const std::complex<float> std_product = std_z1 * std_z2;
+  EXPECT_FLOAT_EQ(product.real(), std_product.real());
+  EXPECT_FLOAT_EQ(product.imag(), std_product.imag());
+  const ComplexF result = exp(z1);
+  const std::complex<float> std_result = std::exp(std_z1);
+  EXPECT_NEAR(result.real(), std_result.real(), 1e-6F);
+  EXPECT_NEAR(result.imag(), std_result.imag(), 1e-6F);
+}
+
+TEST(ComplexTest, ExtendedPrecision) {
+  const ComplexLD z(0.5L, 0.3L);
+  const std::complex<long double> std_z(0.5L, 0.3L);
+  const ComplexLD result = asin(z);
+  const std::complex<long double> std_result = std::asin(std_z);
+  EXPECT_NEAR(static_cast<double>(result.real()), static_cast<double>(std_result.real()), TEST_EPSILON);
+  EXPECT_NEAR(static_cast<double>(result.imag()), static_cast<double>(std_result.imag()), TEST_EPSILON);
+}
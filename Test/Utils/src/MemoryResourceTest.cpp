@@ -0,0 +1,197 @@
+#include "MemoryResource.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "ComplexMatrix.h"
+#include "ThreadPool.h"
+
+using namespace Math;
+
+namespace {
+
+/// Upstream resource that counts the calls that reach it
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t bytes = 0;
+
+protected:
+  void* do_allocate(const std::size_t size, const std::size_t alignment) override {
+    ++allocations;
+    bytes += size;
+    return std::pmr::new_delete_resource()->allocate(size, alignment);
+  }
+  void do_deallocate(void* p, const std::size_t size, const std::size_t alignment) override {
+    ++deallocations;
+    bytes -= size;
+    std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+bool isAligned(const void* p, const std::size_t alignment = MEMORY_ALIGNMENT) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(ArenaResourceTest, AlignedBumpAllocation) {
+  CountingResource upstream;
+  ArenaResource arena(4096, &upstream);
+  EXPECT_EQ(arena.capacity(), 0);
+  void* a = arena.allocate(1, 1);
+  void* b = arena.allocate(100, 8);
+  void* c = arena.allocate(64, 256);
+  EXPECT_TRUE(isAligned(a));
+  EXPECT_TRUE(isAligned(b));
+  EXPECT_TRUE(isAligned(c, 256));
+  EXPECT_EQ(static_cast<std::byte*>(b) - static_cast<std::byte*>(a), 64);
+  EXPECT_EQ(upstream.allocations, 1);
+  EXPECT_EQ(arena.capacity(), 4096);
+  EXPECT_GE(arena.used(), 64 + 128 + 64);
+}
+
+TEST(ArenaResourceTest, ResetReusesCapacity) {
+  CountingResource upstream;
+  ArenaResource arena(1024, &upstream);
+  const auto pipeline = [&] {
+    for (std::size_t size = 100; size < 20000; size *= 2) EXPECT_NE(arena.allocate(size, 64), nullptr);
+  };
+  pipeline();
+  EXPECT_GT(upstream.allocations, 1);
+  // The first reset merges the chunks into one
+  arena.reset();
+  EXPECT_EQ(arena.used(), 0);
+  const std::size_t allocations = upstream.allocations;
+  for (int call = 0; call < 10; ++call) {
+    pipeline();
+    arena.reset();
+  }
+  EXPECT_EQ(upstream.allocations, allocations);
+  arena.release();
+  EXPECT_EQ(arena.capacity(), 0);
+  EXPECT_EQ(upstream.bytes, 0);
+}
+
+TEST(ArenaResourceTest, LargeAllocation) {
+  CountingResource upstream;
+  {
+    ArenaResource arena(256, &upstream);
+    void* p = arena.allocate(100000, 4096);
+    EXPECT_TRUE(isAligned(p, 4096));
+    EXPECT_GE(arena.capacity(), 100000);
+  }
+  EXPECT_EQ(upstream.allocations, upstream.deallocations);
+  EXPECT_EQ(upstream.bytes, 0);
+}
+
+TEST(PoolResourceTest, SizeClasses) {
+  CountingResource upstream;
+  PoolResource pool(1 << 16, &upstream);
+  EXPECT_EQ(pool.largestBlock(), 1 << 16);
+  void* a = pool.allocate(10, 1);
+  void* b = pool.allocate(64, 64);
+  void* c = pool.allocate(3000, 8);
+  void* d = pool.allocate(100, 1024);
+  EXPECT_TRUE(isAligned(a));
+  EXPECT_TRUE(isAligned(b));
+  EXPECT_TRUE(isAligned(c));
+  EXPECT_TRUE(isAligned(d, 1024));
+  EXPECT_NE(a, b);
+  pool.deallocate(c, 3000, 8);
+  EXPECT_EQ(pool.allocate(2049, 8), c);
+  pool.deallocate(pool.allocate(500, 16), 500, 16);
+  const std::size_t allocations = upstream.allocations;
+  for (int i = 0; i < 100; ++i) pool.deallocate(pool.allocate(500, 16), 500, 16);
+  EXPECT_EQ(upstream.allocations, allocations);
+}
+
+TEST(PoolResourceTest, LargeBlocksGoUpstream) {
+  CountingResource upstream;
+  PoolResource pool(4096, &upstream);
+  void* p = pool.allocate(5000, 8);
+  EXPECT_TRUE(isAligned(p));
+  EXPECT_EQ(upstream.allocations, 1);
+  EXPECT_EQ(pool.capacity(), 0);
+  pool.deallocate(p, 5000, 8);
+  EXPECT_EQ(upstream.deallocations, 1);
+  pool.deallocate(pool.allocate(64, 8192), 64, 8192);
+  EXPECT_EQ(pool.capacity(), 0);
+}
+
+TEST(PoolResourceTest, ConcurrentUse) {
+  CountingResource upstream;
+  PoolResource pool(1 << 20, &upstream);
+  ThreadPool threads(4);
+  threads.parallelFor(0, 400, 1, [&](const std::size_t i) {
+    const std::size_t size = 64 + 97 * (i % 50);
+    std::vector<void*> blocks;
+    for (int k = 0; k < 20; ++k) {
+      auto* block = static_cast<unsigned char*>(pool.allocate(size, 64));
+      block[0] = static_cast<unsigned char>(i);
+      block[size - 1] = static_cast<unsigned char>(i);
+      blocks.push_back(block);
+    }
+    for (void* block : blocks) {
+      EXPECT_EQ(static_cast<unsigned char*>(block)[0], static_cast<unsigned char>(i));
+      EXPECT_EQ(static_cast<unsigned char*>(block)[size - 1], static_cast<unsigned char>(i));
+      pool.deallocate(block, size, 64);
+    }
+  });
+  pool.release();
+  EXPECT_EQ(upstream.bytes, 0);
+}
+
+TEST(FirstTouchResourceTest, LargeBlocks) {
+  CountingResource upstream;
+  ThreadPool threads(4);
+  FirstTouchResource resource(threads, 1 << 16, &upstream);
+  {
+    // Real and imaginary parts are touched by the pool, then zeroed by the array
+    ComplexArray z(100000, &resource);
+    EXPECT_EQ(upstream.allocations, 2);
+    EXPECT_TRUE(isAligned(z.imag().data()));
+    EXPECT_EQ(z[99999].real(), 0);
+    threads.parallelFor(0, z.size(), 1000, [&](const std::size_t i) { z.real()[i] = 1; });
+    EXPECT_EQ(z[54321].real(), 1);
+    // Small blocks are only forwarded
+    const ComplexArray small(10, &resource);
+    EXPECT_EQ(upstream.allocations, 4);
+  }
+  EXPECT_EQ(upstream.bytes, 0);
+  EXPECT_TRUE(resource.is_equal(resource));
+  EXPECT_FALSE(resource.is_equal(FirstTouchResource(threads)));
+}
+
+TEST(MemoryResourceTest, Containers) {
+  CountingResource upstream;
+  ArenaResource arena(1 << 20, &upstream);
+  for (int call = 0; call < 5; ++call) {
+    ComplexArray a(1000, Complex(1, 2), &arena);
+    ComplexArray b(1000, &arena);
+    b = a * a + 1.0;
+    EXPECT_EQ(b.get_allocator().resource(), &arena);
+    EXPECT_TRUE(isAligned(b.real().data()));
+    EXPECT_DOUBLE_EQ(b[999].real(), -2);
+    EXPECT_DOUBLE_EQ(b[999].imag(), 4);
+    ComplexMatrix m(30, 30, MatrixLayout::ColumnMajor, &arena);
+    EXPECT_TRUE(isAligned(m.data()));
+    m(29, 29) = Complex(1, 0);
+    // Copies use the default resource
+    const ComplexArray copy = a;
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::new_delete_resource());
+    arena.reset();
+  }
+  EXPECT_EQ(upstream.allocations, 1);
+
+  PoolResource pool;
+  AlignedVector<Complex> buffer(100, AlignedAllocator<Complex>(&pool));
+  EXPECT_TRUE(isAligned(buffer.data()));
+  std::pmr::vector<Complex> pmrBuffer(100, &pool);
+  EXPECT_EQ(pmrBuffer.size(), 100);
+}
@@ -0,0 +1,132 @@
+#include "Oscillator.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+#include <vector>
+
+#include "TestTolerance.h"
+
+using namespace Math;
+
+constexpr real_t TEST_EPSILON = scaledTolerance<real_t>(1e-14);
+
+namespace {
+
+/// Phasor of an angle that is evaluated in long double
+Complex expected(const long double angle) {
+  return Complex(static_cast<real_t>(std::cos(angle)), static_cast<real_t>(std::sin(angle)));
+}
+
+void expectNear(const Complex& result, const Complex& expected, const real_t epsilon) {
+  EXPECT_NEAR(result.real(), expected.real(), epsilon);
+  EXPECT_NEAR(result.imag(), expected.imag(), epsilon);
+}
+
+}  // namespace
+
+TEST(OscillatorTest, Generate) {
+  constexpr real_t FREQUENCY = 0.173;
+  constexpr real_t PHASE = -1.2;
+  Oscillator oscillator(FREQUENCY, PHASE);
+  ComplexArray samples(1000);
+  std::size_t n = 0;
+  // Calls of odd sizes continue the stream across block boundaries
+  for (const Math::size_t size : {1, 255, 300, 17, 1000}) {
+    oscillator.generate(samples.view().subspan(0, size));
+    for (Math::size_t k = 0; k < size; ++k, ++n) {
+      expectNear(samples[k], expected(PHASE + static_cast<long double>(FREQUENCY) * n), TEST_EPSILON);
+    }
+  }
+  const long double turn = 2 * std::numbers::pi_v<long double>;
+  EXPECT_NEAR(oscillator.phase(), std::remainder(PHASE + static_cast<long double>(FREQUENCY) * n, turn), TEST_EPSILON);
+}
+
+TEST(OscillatorTest, PhaseDoesNotDrift) {
+  constexpr real_t FREQUENCY = 2.875;
+  Oscillator oscillator(FREQUENCY);
+  ComplexArray samples(4096);
+  for (int i = 0; i < 256; ++i) oscillator.generate(samples);
+  // After 2^20 samples the reference angle and the frequency, which is a multiple of 2 pi / 2^64, are each accurate
+  // to about 2e-13. The magnitude does not drift at all.
+  const long double angle = static_cast<long double>(FREQUENCY) * (256 * 4096 - 1);
+  expectNear(samples[4095], expected(angle), scaledTolerance<real_t>(1e-12));
+  EXPECT_NEAR(abs(static_cast<Complex>(samples[4095])), 1, TEST_EPSILON);
+}
+
+TEST(OscillatorTest, Interleaved) {
+  Oscillator split(-0.61, 0.5);
+  Oscillator interleaved(-0.61, 0.5);
+  ComplexArray a(777);
+  std::vector<Complex> b(777);
+  split.generate(a);
+  interleaved.generate(b);
+  for (std::size_t k = 0; k < b.size(); ++k) {
+    EXPECT_EQ(b[k].real(), a[k].real());
+    EXPECT_EQ(b[k].imag(), a[k].imag());
+  }
+}
+
+TEST(OscillatorTest, FrequencyAndPhase) {
+  Oscillator oscillator(0.25, 2.5 * M_PI);
+  EXPECT_NEAR(oscillator.frequency(), 0.25, TEST_EPSILON);
+  EXPECT_NEAR(oscillator.phase(), M_PI / 2, TEST_EPSILON);
+  ComplexArray samples(10);
+  oscillator.generate(samples);
+  oscillator.setFrequency(-0.5);
+  oscillator.generate(samples);
+  // The phase stays continuous across the frequency change
+  expectNear(samples[0], expected(M_PI / 2 + 10 * 0.25L), TEST_EPSILON);
+  expectNear(samples[9], expected(M_PI / 2 + 10 * 0.25L - 9 * 0.5L), TEST_EPSILON);
+  oscillator.setPhase(0.125);
+  oscillator.generate(samples);
+  expectNear(samples[1], expected(0.125L - 0.5L), TEST_EPSILON);
+}
+
+TEST(OscillatorTest, Modulate) {
+  constexpr std::size_t SIZE = 700;
+  constexpr real_t FREQUENCY = 0.4;
+  std::vector<real_t> frequencyDeviation(SIZE);
+  std::vector<real_t> phaseDeviation(SIZE);
+  for (std::size_t n = 0; n < SIZE; ++n) {
+    frequencyDeviation[n] = 0.05 * std::sin(0.01 * n);
+    phaseDeviation[n] = 0.8 * std::cos(0.03 * n);
+  }
+  Oscillator oscillator(FREQUENCY);
+  ComplexArray samples(SIZE);
+  oscillator.modulate(frequencyDeviation, phaseDeviation, samples);
+  long double phase = 0;
+  for (std::size_t n = 0; n < SIZE; ++n) {
+    expectNear(samples[n], expected(phase + phaseDeviation[n]), 10 * TEST_EPSILON);
+    phase += FREQUENCY + static_cast<long double>(frequencyDeviation[n]);
+  }
+  // The integrated frequency deviation carries over to the next call
+  oscillator.modulate({}, {}, samples.view().subspan(0, 1));
+  expectNear(samples[0], expected(phase), 10 * TEST_EPSILON);
+  EXPECT_THROW(oscillator.modulate(std::span(frequencyDeviation).first(3), {}, samples), std::invalid_argument);
+}
+
+TEST(OscillatorTest, Mix) {
+  const ComplexArray signal(600, Complex(0.5, -2));
+  Oscillator reference(1.1, 0.2);
+  Oscillator mixer(1.1, 0.2);
+  ComplexArray carrier(600);
+  ComplexArray shifted = signal;
+  reference.generate(carrier);
+  mixer.mix(shifted, shifted);
+  for (std::size_t k = 0; k < signal.size(); ++k) {
+    expectNear(shifted[k], static_cast<Complex>(signal[k]) * static_cast<Complex>(carrier[k]), TEST_EPSILON);
+  }
+  EXPECT_THROW(mixer.mix(signal, carrier.view().subspan(0, 5)), std::invalid_argument);
+}
+
+TEST(OscillatorTest, SinglePrecision) {
+  BasicOscillator<float> oscillator(0.3F, 1);
+  BasicComplexArray<float> samples(5000);
+  oscillator.generate(samples);
+  for (std::size_t n = 0; n < samples.size(); n += 13) {
+    const long double angle = 1 + static_cast<long double>(0.3F) * n;
+    EXPECT_NEAR(samples[n].real(), std::cos(angle), 1e-6);
+    EXPECT_NEAR(samples[n].imag(), std::sin(angle), 1e-6);
+  }
+}
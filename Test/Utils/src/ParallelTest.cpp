@@ -0,0 +1,83 @@
+#include "Parallel.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "ComplexMath.h"
+
+using namespace Math;
+
+namespace {
+
+ComplexArray testArray(const std::size_t size) {
+  ComplexArray z(static_cast<Math::size_t>(size));
+  for (std::size_t i = 0; i < size; ++i) z[static_cast<Math::size_t>(i)] = Complex(std::sin(0.01 * i), 0.001 * i);
+  return z;
+}
+
+}  // namespace
+
+TEST(ParallelTest, Transform) {
+  ThreadPool pool(4);
+  for (const std::size_t size : {0, 1, 1000, 100003}) {
+    const ComplexArray z = testArray(size);
+    ComplexArray expected(static_cast<Math::size_t>(size));
+    exp<real_t>(z, expected);
+    // Chunks start on blocks, so the kernels see the same packs as on the whole array
+    std::mutex mutex;
+    std::vector<const real_t*> chunks;
+    ComplexArray out(static_cast<Math::size_t>(size));
+    parallelTransform<real_t>(
+        z, out,
+        [&](const SplitSpan<const real_t> in, const SplitSpan<real_t> result) {
+          exp<real_t>(in, result);
+          const std::lock_guard lock(mutex);
+          chunks.push_back(result.realData());
+        },
+        pool, 1000);
+    for (std::size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(out.real()[i], expected.real()[i]);
+      EXPECT_EQ(out.imag()[i], expected.imag()[i]);
+    }
+    for (const real_t* chunk : chunks) EXPECT_EQ((chunk - out.real().data()) % PARALLEL_BLOCK, 0);
+    if (size > 10000) {
+      EXPECT_GT(chunks.size(), 1);
+    }
+  }
+}
+
+TEST(ParallelTest, TransformBinary) {
+  ThreadPool pool(3);
+  const ComplexArray a = testArray(50000);
+  const ComplexArray b = testArray(50000);
+  ComplexArray out(50000);
+  parallelTransform<real_t>(
+      a, b, out, [](const auto lhs, const auto rhs, const auto result) { multiply<real_t>(lhs, rhs, result); }, pool);
+  const ComplexArray expected = a * b;
+  for (Math::size_t i = 0; i < out.size(); i += 997) {
+    EXPECT_EQ(out[i].real(), expected[i].real());
+    EXPECT_EQ(out[i].imag(), expected[i].imag());
+  }
+  EXPECT_THROW(parallelTransform<real_t>(a, ComplexArray(3), out, [](auto, auto, auto) {}), std::invalid_argument);
+}
+
+TEST(ParallelTest, TransformInterleaved) {
+  ThreadPool pool(4);
+  std::vector<Complex> z(70000);
+  for (std::size_t i = 0; i < z.size(); ++i) z[i] = Complex(-0.0001 * i, 1);
+  std::vector<Complex> expected(z.size());
+  exp<real_t>(z, expected);
+  std::vector<Complex> out(z.size());
+  parallelTransform<real_t>(
+      z, out, [](const auto in, const auto result) { exp<real_t>(in, result); }, pool);
+  for (std::size_t i = 0; i < z.size(); i += 1001) {
+    EXPECT_EQ(out[i].real(), expected[i].real());
+    EXPECT_EQ(out[i].imag(), expected[i].imag());
+  }
+  const std::span<Complex> shorter = std::span<Complex>(out).first(5);
+  EXPECT_THROW(parallelTransform<real_t>(z, shorter, [](auto, auto) {}), std::invalid_argument);
+}
@@ -0,0 +1,178 @@
+#include "Polynomial.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Simd.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+constexpr real_t TEST_EPSILON = scaledTolerance<real_t>(1e-12);
+
+namespace {
+
+/// Polynomial with the given roots and leading coefficient
+template <scalar T>
+BasicPolynomial<T> fromRoots(const std::vector<BasicComplex<T>>& roots, const BasicComplex<T>& leading) {
+  std::vector<BasicComplex<T>> c{leading};
+  for (const BasicComplex<T>& r : roots) {
+    c.emplace_back();
+    for (std::size_t k = c.size() - 1; k > 0; --k) c[k] = c[k - 1] - r * c[k];
+    c[0] = -r * c[0];
+  }
+  return BasicPolynomial<T>(c);
+}
+
+/// Expects every root to be matched by one computed root
+template <scalar T>
+void expectRoots(std::span<const BasicComplex<T>> result, const std::vector<BasicComplex<T>>& expected,
+                 const T epsilon) {
+  ASSERT_EQ(result.size(), expected.size());
+  std::vector<bool> used(result.size());
+  for (const BasicComplex<T>& r : expected) {
+    std::size_t best = 0;
+    T distance = INFINITY;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      if (!used[i] && abs(result[i] - r) < distance) {
+        best = i;
+        distance = abs(result[i] - r);
+      }
+    }
+    used[best] = true;
+    EXPECT_LE(distance, epsilon * std::max<T>(1, abs(r))) << r.real() << " " << r.imag();
+  }
+}
+
+/// Expects a residual that is within the rounding error of evaluating the polynomial at the root
+void expectResidual(const Polynomial& p, const Complex& root) {
+  const auto magnitude = [](const Complex& z) { return std::hypot(z.real(), z.imag()); };
+  real_t bound = 0;
+  for (std::size_t k = p.degree() + 1; k-- > 0;) bound = bound * magnitude(root) + magnitude(p[k]);
+  EXPECT_LE(magnitude(p(root)), 16 * real_t(p.degree() + 1) * std::numeric_limits<real_t>::epsilon() * bound);
+}
+
+}  // namespace
+
+class PolynomialTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+};
+
+TEST_P(PolynomialTest, Evaluate) {
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<real_t> uniform(-1, 1);
+  std::vector<Complex> c(14);
+  for (Complex& x : c) x = Complex(uniform(generator), uniform(generator));
+  const Polynomial p(c);
+  ComplexArray z(1000);
+  for (std::size_t i = 0; i < z.size(); ++i) z[i] = Complex(uniform(generator), uniform(generator));
+  // Sizes that end in every tail of the kernel
+  for (const Math::size_t size : {0, 1, 3, 37, 1000}) {
+    ComplexArray values(size);
+    p.evaluate(z.view().subspan(0, size), values);
+    for (std::size_t i = 0; i < size; ++i) {
+      const Complex expected = p(z[i]);
+      EXPECT_NEAR(values[i].real(), expected.real(), TEST_EPSILON);
+      EXPECT_NEAR(values[i].imag(), expected.imag(), TEST_EPSILON);
+    }
+  }
+  // In place, and at interleaved points
+  std::vector<Complex> interleaved(z.size());
+  for (std::size_t i = 0; i < z.size(); ++i) interleaved[i] = z[i];
+  p.evaluate(interleaved, interleaved);
+  p.evaluate(z, z);
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    EXPECT_EQ(interleaved[i].real(), z[i].real());
+    EXPECT_EQ(interleaved[i].imag(), z[i].imag());
+  }
+  EXPECT_THROW(p.evaluate(z, z.view().subspan(0, 3)), std::invalid_argument);
+}
+
+TEST_P(PolynomialTest, Roots) {
+  const std::vector<Complex> expected{{1, 0}, {-2, 0}, {0.5, 3}, {0.5, -3}, {-1, -1}, {4, 0.25}, {0, 2}};
+  const Polynomial p = fromRoots<real_t>(expected, Complex(2, -1));
+  expectRoots<real_t>(p.roots(), expected, TEST_EPSILON);
+}
+
+TEST_P(PolynomialTest, Batch) {
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<real_t> uniform(-3, 3);
+  std::uniform_int_distribution<int> degree(1, 20);
+  std::vector<Polynomial> polynomials;
+  std::vector<std::vector<Complex>> expected;
+  std::size_t total = 0;
+  for (int i = 0; i < 100; ++i) {
+    std::vector<Complex>& r = expected.emplace_back(degree(generator));
+    for (Complex& x : r) x = Complex(uniform(generator), uniform(generator));
+    polynomials.push_back(fromRoots<real_t>(r, Complex(uniform(generator), 1)));
+    total += r.size();
+  }
+  std::vector<Complex> roots(total);
+  const std::vector<RootStatus> status = Math::roots<real_t>(polynomials, roots);
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i < polynomials.size(); ++i) {
+    EXPECT_TRUE(status[i].converged);
+    EXPECT_LT(status[i].iterations, 100U);
+    // Random roots may lie close together, where they are ill-conditioned, so check the backward error
+    for (std::size_t k = 0; k < expected[i].size(); ++k) expectResidual(polynomials[i], roots[offset + k]);
+    offset += expected[i].size();
+  }
+  roots.pop_back();
+  EXPECT_THROW(Math::roots<real_t>(polynomials, roots), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, PolynomialTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
+
+TEST(PolynomialBasicTest, Coefficients) {
+  const Polynomial p{{1, 2}, {0, 0}, {-3, 0}, {0, 0}, {0, 0}};
+  EXPECT_EQ(p.degree(), 2U);
+  EXPECT_EQ(p.coefficients().size(), 3U);
+  EXPECT_EQ(p[2].real(), -3);
+  EXPECT_EQ(Polynomial().degree(), 0U);
+  EXPECT_EQ(Polynomial({{0, 0}, {0, 0}}).degree(), 0U);
+  // p(z) = 1 + 2i - 3 z^2, p'(z) = -6 z
+  const Complex value = p(Complex(1, 1));
+  EXPECT_NEAR(value.real(), 1, TEST_EPSILON);
+  EXPECT_NEAR(value.imag(), -4, TEST_EPSILON);
+  const Polynomial d = p.derivative();
+  EXPECT_EQ(d.degree(), 1U);
+  EXPECT_EQ(d[0].real(), 0);
+  EXPECT_EQ(d[1].real(), -6);
+  EXPECT_EQ(d.derivative().derivative().degree(), 0U);
+}
+
+TEST(PolynomialBasicTest, SpecialRoots) {
+  // Roots at zero are exact, degree 1 is solved directly
+  const std::vector<Complex> roots = Polynomial{{0, 0}, {0, 0}, {6, 0}, {-2, 0}}.roots();
+  ASSERT_EQ(roots.size(), 3U);
+  EXPECT_EQ(abs(roots[0]), 0);
+  EXPECT_EQ(abs(roots[1]), 0);
+  EXPECT_NEAR(roots[2].real(), 3, TEST_EPSILON);
+  EXPECT_TRUE((Polynomial{{5, 0}}.roots().empty()));
+  EXPECT_THROW(static_cast<void>(Polynomial().roots()), std::invalid_argument);
+  // A coefficient that is not finite never lets the roots converge
+  const real_t nan = std::numeric_limits<real_t>::quiet_NaN();
+  EXPECT_THROW(static_cast<void>(Polynomial{{1, 0}, {nan, 0}, {1, 0}}.roots()), std::runtime_error);
+  // A double root converges only linearly, to about the square root of the precision
+  const std::vector<Complex> expected{{1, 0}, {1, 0}, {-1, 0}};
+  expectRoots<real_t>(fromRoots<real_t>(expected, Complex(1, 0)).roots(), expected, scaledTolerance<real_t>(1e-6));
+}
+
+TEST(PolynomialBasicTest, SinglePrecision) {
+  const std::vector<BasicComplex<float>> expected{{1, 1}, {-2, 0.5F}, {3, 0}, {0, -1}, {-0.5F, -2}};
+  const BasicPolynomial<float> p = fromRoots<float>(expected, BasicComplex<float>(1, 0));
+  expectRoots<float>(p.roots(), expected, 1e-4F);
+}
@@ -0,0 +1,192 @@
+#include "QuantizedArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "Simd.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+/// Sizes that end in every tail of the kernels
+constexpr std::size_t SIZES[] = {0, 1, 15, 16, 17, 1003};
+
+/// Quantized value of x as the kernels compute it
+template <quantized Q, scalar T>
+Q reference(const T x, const T scale) {
+  const T y = x * (T(1) / scale);
+  if (std::isnan(y)) return 0;
+  return static_cast<Q>(std::nearbyint(std::clamp<T>(y, std::numeric_limits<Q>::min(), std::numeric_limits<Q>::max())));
+}
+
+/// Random numbers of which some exceed the range of the quantization by up to a half
+template <scalar T>
+BasicComplexArray<T> randomArray(const std::size_t size, const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<T> uniform(-1.5, 1.5);
+  BasicComplexArray<T> z(static_cast<Math::size_t>(size));
+  for (std::size_t i = 0; i < size; ++i) z[i] = BasicComplex<T>(uniform(generator), uniform(generator));
+  return z;
+}
+
+template <quantized Q, scalar T>
+void expectRoundTrip() {
+  const T scale = T(1) / std::numeric_limits<Q>::max();
+  for (const std::size_t size : SIZES) {
+    const BasicComplexArray<T> z = randomArray<T>(size, 3);
+    const BasicQuantizedArray<Q, T> q(z, scale);
+    ASSERT_EQ(q.size(), size);
+    for (std::size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(q.samples()[i].i, (reference<Q, T>(z.real()[i], scale))) << i;
+      EXPECT_EQ(q.samples()[i].q, (reference<Q, T>(z.imag()[i], scale))) << i;
+    }
+    // Dequantization is exact, and within half a step of the numbers that did not saturate
+    BasicComplexArray<T> split(static_cast<Math::size_t>(size));
+    std::vector<BasicComplex<T>> interleaved(size);
+    q.dequantize(split);
+    q.dequantize(interleaved);
+    for (std::size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(split.real()[i], scale * T(q.samples()[i].i));
+      EXPECT_EQ(split.imag()[i], scale * T(q.samples()[i].q));
+      EXPECT_EQ(interleaved[i].real(), split.real()[i]);
+      EXPECT_EQ(interleaved[i].imag(), q[i].imag());
+      if (std::fabs(z.real()[i]) < 1) {
+        EXPECT_LE(std::fabs(split.real()[i] - z.real()[i]), scale / 2 * (1 + 1e-3));
+      }
+    }
+    // Quantizing interleaved numbers gives the same samples
+    std::vector<BasicComplex<T>> values(size);
+    for (std::size_t i = 0; i < size; ++i) values[i] = z[i];
+    BasicQuantizedArray<Q, T> fromInterleaved(static_cast<Math::size_t>(size), scale);
+    fromInterleaved.quantize(values);
+    for (std::size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(fromInterleaved.samples()[i].i, q.samples()[i].i);
+      EXPECT_EQ(fromInterleaved.samples()[i].q, q.samples()[i].q);
+    }
+  }
+}
+
+template <quantized Q, scalar T>
+void expectSaturation() {
+  constexpr Q LOW = std::numeric_limits<Q>::min();
+  constexpr Q HIGH = std::numeric_limits<Q>::max();
+  const std::vector<BasicComplex<T>> values{{T(HIGH) + T(0.49), T(LOW) - T(0.49)},
+                                            {T(1e30), -T(1e30)},
+                                            {INFINITY, -INFINITY},
+                                            {NAN, T(2.5)},
+                                            {T(-3.5), T(0.5)}};
+  // Repeated so that every value also goes through full packs
+  std::vector<BasicComplex<T>> z;
+  for (int k = 0; k < 20; ++k) z.insert(z.end(), values.begin(), values.end());
+  BasicQuantizedArray<Q, T> q(static_cast<Math::size_t>(z.size()));
+  q.quantize(z);
+  for (std::size_t i = 0; i < z.size(); i += values.size()) {
+    EXPECT_EQ(q.samples()[i].i, HIGH);
+    EXPECT_EQ(q.samples()[i].q, LOW);
+    EXPECT_EQ(q.samples()[i + 1].i, HIGH);
+    EXPECT_EQ(q.samples()[i + 1].q, LOW);
+    EXPECT_EQ(q.samples()[i + 2].i, HIGH);
+    EXPECT_EQ(q.samples()[i + 2].q, LOW);
+    EXPECT_EQ(q.samples()[i + 3].i, 0);
+    // Ties round to even
+    EXPECT_EQ(q.samples()[i + 3].q, 2);
+    EXPECT_EQ(q.samples()[i + 4].i, -4);
+    EXPECT_EQ(q.samples()[i + 4].q, 0);
+  }
+}
+
+template <quantized Q, scalar T>
+void expectMultiplyAccumulate() {
+  const T scale = T(0.75) / std::numeric_limits<Q>::max();
+  constexpr std::size_t OFFSET = 5;
+  for (const std::size_t size : SIZES) {
+    const BasicQuantizedArray<Q, T> q(randomArray<T>(size + OFFSET, 11), scale);
+    const BasicComplexArray<T> w = randomArray<T>(size, 12);
+    BasicComplexArray<T> acc = randomArray<T>(size, 13);
+    const BasicComplexArray<T> initial = acc;
+    q.multiplyAccumulate(w, acc, OFFSET);
+    for (std::size_t i = 0; i < size; ++i) {
+      const BasicComplex<T> expected = initial[i] + q[i + OFFSET] * w[i];
+      EXPECT_NEAR(acc.real()[i], expected.real(), scaledTolerance<T>(1e-14));
+      EXPECT_NEAR(acc.imag()[i], expected.imag(), scaledTolerance<T>(1e-14));
+    }
+  }
+}
+
+}  // namespace
+
+class QuantizedArrayTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+};
+
+TEST_P(QuantizedArrayTest, RoundTrip) {
+  expectRoundTrip<int8_t, float>();
+  expectRoundTrip<int16_t, float>();
+  expectRoundTrip<int8_t, double>();
+  expectRoundTrip<int16_t, double>();
+}
+
+TEST_P(QuantizedArrayTest, Saturation) {
+  expectSaturation<int8_t, float>();
+  expectSaturation<int16_t, float>();
+  expectSaturation<int8_t, double>();
+  expectSaturation<int16_t, double>();
+}
+
+TEST_P(QuantizedArrayTest, MultiplyAccumulate) {
+  expectMultiplyAccumulate<int8_t, float>();
+  expectMultiplyAccumulate<int16_t, float>();
+  expectMultiplyAccumulate<int8_t, double>();
+  expectMultiplyAccumulate<int16_t, double>();
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, QuantizedArrayTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
+
+TEST(QuantizedArrayBasicTest, FullScale) {
+  ComplexArray z{{0.5, -2}, {1, 1}, {INFINITY, 0}};
+  EXPECT_EQ(QuantizedArray16::fullScale(z), real_t(2) / 32767);
+  const QuantizedArray8 q(z, QuantizedArray8::fullScale(z));
+  EXPECT_EQ(q.samples()[0].q, -127);
+  EXPECT_EQ(QuantizedArray8::fullScale(ComplexArray(3)), 1);
+  // Raw samples, e.g. from a capture, and the rescaling of all numbers
+  QuantizedArray16 capture(2, 0.5);
+  capture.samples()[1] = {-32768, 7};
+  EXPECT_EQ(capture[1].real(), -16384);
+  capture.setScale(2);
+  EXPECT_EQ(capture[1].imag(), 14);
+  BasicQuantizedArray<int16_t, long double> extended;
+  extended.resize(3);
+  BasicComplexArray<long double> out(3, BasicComplex<long double>(1, 1));
+  extended.dequantize(out);
+  EXPECT_EQ(out[2].real(), 0);
+}
+
+TEST(QuantizedArrayBasicTest, Errors) {
+  EXPECT_THROW(QuantizedArray16(4, 0), std::invalid_argument);
+  EXPECT_THROW(QuantizedArray16(4, NAN), std::invalid_argument);
+  QuantizedArray16 q(4);
+  EXPECT_THROW(q.setScale(-1), std::invalid_argument);
+  ComplexArray z(3);
+  EXPECT_THROW(q.dequantize(z, 2), std::invalid_argument);
+  EXPECT_THROW(q.quantize(z, 5), std::invalid_argument);
+  EXPECT_THROW(q.multiplyAccumulate(ComplexArray(2), z), std::invalid_argument);
+  EXPECT_THROW(q.resize(MAX_ELEMENT_COUNT + 1), std::length_error);
+}
@@ -0,0 +1,242 @@
+#include "SlidingDft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "ComplexArray.h"
+#include "Simd.h"
+#include "TestTolerance.h"
+
+using namespace Math;
+
+namespace {
+
+template <scalar T>
+BasicComplexArray<T> randomArray(const std::size_t size, const unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<T> uniform(-1, 1);
+  BasicComplexArray<T> z(static_cast<Math::size_t>(size));
+  for (std::size_t i = 0; i < size; ++i) z[i] = BasicComplex<T>(uniform(generator), uniform(generator));
+  return z;
+}
+
+/// @return exp(-i w m) for m < n, in long double
+std::vector<BasicComplex<long double>> basis(const std::size_t n, const long double w) {
+  std::vector<BasicComplex<long double>> phasors(n);
+  for (std::size_t m = 0; m < n; ++m) {
+    const long double angle = -w * static_cast<long double>(m);
+    phasors[m] = BasicComplex<long double>(std::cos(angle), std::sin(angle));
+  }
+  return phasors;
+}
+
+/// sum x[start + m] phasors[m] for m < phasors.size(), in long double; samples before 0 are zero
+template <scalar T>
+BasicComplex<long double> dft(const BasicComplexArray<T>& x, const std::ptrdiff_t start,
+                              const std::vector<BasicComplex<long double>>& phasors) {
+  BasicComplex<long double> sum;
+  for (std::size_t m = 0; m < phasors.size(); ++m) {
+    const std::ptrdiff_t i = start + static_cast<std::ptrdiff_t>(m);
+    if (i >= 0) sum += BasicComplex<long double>(x.real()[i], x.imag()[i]) * phasors[m];
+  }
+  return sum;
+}
+
+/// DFT of a window at bin k
+std::vector<BasicComplex<long double>> binBasis(const std::size_t windowSize, const std::size_t k) {
+  return basis(windowSize, 2 * std::numbers::pi_v<long double> * k / static_cast<long double>(windowSize));
+}
+
+template <scalar T>
+void expectNear(const BasicComplex<T>& result, const BasicComplex<long double>& expected, const T tolerance) {
+  EXPECT_NEAR(result.real(), static_cast<T>(expected.real()), tolerance);
+  EXPECT_NEAR(result.imag(), static_cast<T>(expected.imag()), tolerance);
+}
+
+/// Bins that fill several packs of every instruction set and end in a partial one
+std::vector<Math::size_t> someBins(const std::size_t windowSize, const std::size_t count) {
+  std::vector<Math::size_t> bins;
+  for (std::size_t i = 0; i < count; ++i) bins.push_back(static_cast<Math::size_t>((i * 7 + 1) % windowSize));
+  return bins;
+}
+
+/// Compares the spectrum after every sample with the DFT of the window, feeding pieces of random size
+template <scalar T>
+void expectSliding(const std::size_t windowSize, const std::size_t binCount, const std::size_t resyncWindows) {
+  const std::vector<Math::size_t> bins = someBins(windowSize, binCount);
+  const std::size_t size = 6 * windowSize + 300;
+  const BasicComplexArray<T> x = randomArray<T>(size, 1);
+  BasicSlidingDft<T> sdft(static_cast<Math::size_t>(windowSize), bins, static_cast<Math::size_t>(resyncWindows));
+  BasicComplexArray<T> spectra(static_cast<Math::size_t>(size * bins.size()));
+  std::mt19937 generator(2);
+  std::uniform_int_distribution<std::size_t> pieces(0, 2 * windowSize + 100);
+  for (std::size_t i = 0; i < size;) {
+    const std::size_t n = std::min(pieces(generator), size - i);
+    sdft.update(x.view().subspan(static_cast<Math::size_t>(i), static_cast<Math::size_t>(n)),
+                spectra.view().subspan(static_cast<Math::size_t>(i * bins.size()),
+                                       static_cast<Math::size_t>(n * bins.size())));
+    i += n;
+  }
+  const T tolerance = scaledTolerance<T>(1e-13) * static_cast<T>(windowSize);
+  for (std::size_t k = 0; k < bins.size(); ++k) {
+    const auto phasors = binBasis(windowSize, bins[k]);
+    for (std::size_t t = 0; t < size; t += 7) {
+      const auto start = static_cast<std::ptrdiff_t>(t + 1) - static_cast<std::ptrdiff_t>(windowSize);
+      expectNear<T>(spectra[t * bins.size() + k], dft(x, start, phasors), tolerance);
+    }
+    // The last spectrum can also be recomputed
+    expectNear<T>(sdft[static_cast<Math::size_t>(k)], dft(x, static_cast<std::ptrdiff_t>(size - windowSize), phasors),
+                  tolerance);
+  }
+}
+
+template <scalar T>
+void expectGoertzel(const std::size_t blockSize, const std::size_t frequencyCount) {
+  std::vector<T> frequencies;
+  for (std::size_t i = 0; i < frequencyCount; ++i) frequencies.push_back(static_cast<T>(0.05 + 0.37 * i));
+  const std::size_t blocks = 5;
+  const BasicComplexArray<T> x = randomArray<T>(blocks * blockSize + blockSize / 2, 3);
+  BasicGoertzelBank<T> bank(frequencies, static_cast<Math::size_t>(blockSize));
+  EXPECT_EQ(bank.outputSize(x.size()), blocks * frequencyCount);
+  BasicComplexArray<T> out(static_cast<Math::size_t>(blocks * frequencyCount));
+  std::size_t written = 0;
+  std::mt19937 generator(4);
+  std::uniform_int_distribution<std::size_t> pieces(0, 2 * blockSize);
+  for (std::size_t i = 0; i < x.size();) {
+    const std::size_t n = std::min(pieces(generator), x.size() - i);
+    const std::size_t expected = bank.outputSize(n);
+    EXPECT_EQ(bank.process(x.view().subspan(static_cast<Math::size_t>(i), static_cast<Math::size_t>(n)),
+                           out.view().subspan(static_cast<Math::size_t>(written),
+                                              static_cast<Math::size_t>(out.size() - written))),
+              expected);
+    written += expected;
+    i += n;
+  }
+  ASSERT_EQ(written, out.size());
+  const T tolerance = scaledTolerance<T>(1e-13) * static_cast<T>(blockSize);
+  for (std::size_t k = 0; k < frequencyCount; ++k) {
+    const auto phasors = basis(blockSize, frequencies[k]);
+    for (std::size_t b = 0; b < blocks; ++b) {
+      const auto start = static_cast<std::ptrdiff_t>(b * blockSize);
+      expectNear<T>(out[b * frequencyCount + k], dft(x, start, phasors), tolerance);
+    }
+  }
+}
+
+}  // namespace
+
+class SlidingDftTest : public ::testing::TestWithParam<Simd::Isa> {
+protected:
+  void SetUp() override {
+    if (Simd::setActiveIsa(GetParam()) != GetParam()) {
+      GTEST_SKIP() << Simd::to_string(GetParam()) << " is not supported";
+    }
+  }
+
+  void TearDown() override { Simd::setActiveIsa(Simd::detectIsa()); }
+};
+
+TEST_P(SlidingDftTest, Sliding) {
+  for (const std::size_t resyncWindows : {1, 3, 1000}) {
+    expectSliding<float>(16, 5, resyncWindows);
+    expectSliding<double>(16, 5, resyncWindows);
+    expectSliding<float>(64, 37, resyncWindows);
+    expectSliding<double>(64, 37, resyncWindows);
+    expectSliding<double>(300, 40, resyncWindows);
+  }
+}
+
+TEST_P(SlidingDftTest, Goertzel) {
+  expectGoertzel<float>(1, 3);
+  expectGoertzel<float>(100, 37);
+  expectGoertzel<double>(100, 37);
+  expectGoertzel<double>(1000, 5);
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, SlidingDftTest,
+                         ::testing::Values(Simd::Isa::Scalar, Simd::Isa::Sse2, Simd::Isa::Avx2, Simd::Isa::Avx512),
+                         [](const auto& info) { return Simd::to_string(info.param); });
+
+TEST(SlidingDftBasicTest, Stabilization) {
+  // After a million samples the recomputations keep the error of float at that of a few windows
+  const std::size_t windowSize = 100;
+  const std::vector<Math::size_t> bins{1, 13, 50};
+  const BasicComplexArray<float> x = randomArray<float>(1 << 20, 5);
+  BasicSlidingDft<float> sdft(windowSize, bins);
+  sdft.update(x);
+  const auto start = static_cast<std::ptrdiff_t>(x.size() - windowSize);
+  for (std::size_t k = 0; k < bins.size(); ++k) {
+    expectNear<float>(sdft[static_cast<Math::size_t>(k)], dft(x, start, binBasis(windowSize, bins[k])), 2e-4F);
+  }
+}
+
+TEST(SlidingDftBasicTest, Updates) {
+  const std::vector<Math::size_t> bins{0, 2, 5, 7};
+  const ComplexArray x = randomArray<real_t>(1000, 6);
+  SlidingDft split(8, bins);
+  split.update(x);
+  SlidingDft single(8, bins);
+  for (std::size_t i = 0; i < x.size(); ++i) single.update(x[i]);
+  std::vector<Complex> interleaved(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) interleaved[i] = x[i];
+  SlidingDft fromInterleaved(8, bins);
+  fromInterleaved.update(std::span<const Complex>(interleaved));
+  EXPECT_EQ(split.windowSize(), 8U);
+  ASSERT_EQ(split.bins().size(), bins.size());
+  for (std::size_t k = 0; k < bins.size(); ++k) {
+    const auto i = static_cast<Math::size_t>(k);
+    EXPECT_EQ(single[i].real(), split[i].real());
+    EXPECT_EQ(single[i].imag(), split[i].imag());
+    EXPECT_EQ(fromInterleaved[i].real(), split[i].real());
+    EXPECT_EQ(fromInterleaved[i].imag(), split[i].imag());
+  }
+  // A reset starts a window of zeros, a constant fills bin 0 only
+  split.reset();
+  for (std::size_t i = 0; i < 3; ++i) split.update(Complex(1, -1));
+  EXPECT_NEAR(split[0].real(), 3, scaledTolerance<real_t>(1e-12));
+  EXPECT_NEAR(split[0].imag(), -3, scaledTolerance<real_t>(1e-12));
+  split.update(ComplexArray(8, Complex(2, 0)));
+  EXPECT_NEAR(split[0].real(), 16, scaledTolerance<real_t>(1e-12));
+  for (Math::size_t k = 1; k < bins.size(); ++k) EXPECT_NEAR(abs(split[k]), 0, scaledTolerance<real_t>(1e-12));
+}
+
+TEST(SlidingDftBasicTest, GoertzelInterleaved) {
+  const std::vector<real_t> frequencies{0.1, 1, 3};
+  const ComplexArray x = randomArray<real_t>(1000, 7);
+  std::vector<Complex> interleaved(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) interleaved[i] = x[i];
+  GoertzelBank split(frequencies, 300);
+  GoertzelBank fromInterleaved(frequencies, 300);
+  ComplexArray expected(9);
+  ComplexArray out(9);
+  EXPECT_EQ(split.process(x, expected), 9U);
+  EXPECT_EQ(fromInterleaved.process(std::span<const Complex>(interleaved), out), 9U);
+  for (Math::size_t i = 0; i < out.size(); ++i) {
+    EXPECT_EQ(out[i].real(), expected[i].real());
+    EXPECT_EQ(out[i].imag(), expected[i].imag());
+  }
+  // The 100 samples of the incomplete block are discarded
+  fromInterleaved.reset();
+  EXPECT_EQ(fromInterleaved.outputSize(299), 0U);
+  EXPECT_EQ(fromInterleaved.outputSize(300), 3U);
+}
+
+TEST(SlidingDftBasicTest, Errors) {
+  const std::vector<Math::size_t> bins{0, 8};
+  EXPECT_THROW(SlidingDft(8, bins), std::invalid_argument);
+  EXPECT_THROW(SlidingDft(0, {}), std::invalid_argument);
+  EXPECT_THROW(SlidingDft(9, bins, 0), std::invalid_argument);
+  EXPECT_THROW(SlidingDft(MAX_ELEMENT_COUNT, {}), std::length_error);
+  SlidingDft sdft(9, bins);
+  ComplexArray spectra(5);
+  EXPECT_THROW(sdft.update(ComplexArray(3), spectra), std::invalid_argument);
+  const std::vector<real_t> frequencies{1};
+  EXPECT_THROW(GoertzelBank(frequencies, 0), std::invalid_argument);
+  GoertzelBank bank(frequencies, 2);
+  EXPECT_THROW(bank.process(ComplexArray(5), ComplexArray(1)), std::invalid_argument);
+}
@@ -0,0 +1,153 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Math;
+
+TEST(ThreadPoolTest, ThreadCount) {
+  EXPECT_EQ(ThreadPool(1).threadCount(), 1);
+  EXPECT_EQ(ThreadPool(4).threadCount(), 4);
+  EXPECT_GE(defaultThreadPool().threadCount(), 1);
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  ThreadPool pool(4);
+  for (const std::size_t grain : {1, 7, 1000, 5000}) {
+    std::vector<int> visits(3001, 0);
+    pool.parallelFor(1, visits.size(), grain, [&](const std::size_t i) { ++visits[i]; });
+    EXPECT_EQ(visits[0], 0);
+    EXPECT_EQ(std::accumulate(visits.begin(), visits.end(), 0), 3000) << grain;
+    EXPECT_EQ(*std::max_element(visits.begin(), visits.end()), 1) << grain;
+  }
+  pool.parallelFor(5, 5, 1, [](std::size_t) { FAIL(); });
+}
+
+TEST(ThreadPoolTest, Nested) {
+  ThreadPool pool(3);
+  std::atomic<std::size_t> sum = 0;
+  pool.parallelFor(0, 10, 1, [&](const std::size_t i) {
+    pool.parallelFor(0, 10, 1, [&](const std::size_t j) { sum += i * 10 + j; });
+  });
+  EXPECT_EQ(sum, 4950);
+}
+
+TEST(ThreadPoolTest, Exception) {
+  ThreadPool pool(4);
+  EXPECT_THROW(pool.parallelFor(0, 100, 1,
+                                [](const std::size_t i) {
+                                  if (i == 37) throw std::runtime_error("failure");
+                                }),
+               std::runtime_error);
+  // The pool is still usable afterwards
+  std::atomic<std::size_t> count = 0;
+  pool.parallelFor(0, 64, 1, [&](std::size_t) { ++count; });
+  EXPECT_EQ(count, 64);
+}
+
+TEST(ThreadPoolTest, ManyLoops) {
+  ThreadPool pool(4);
+  std::vector<double> data(1000);
+  for (int repetition = 0; repetition < 500; ++repetition) {
+    pool.parallelFor(0, data.size(), 16, [&](const std::size_t i) { data[i] += 1; });
+  }
+  for (const double x : data) EXPECT_EQ(x, 500);
+}
+
+TEST(ThreadPoolTest, ParallelForRange) {
+  ThreadPool pool(4);
+  for (const std::size_t grain : {1, 100, 5000}) {
+    std::mutex mutex;
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    pool.parallelForRange(3, 4003, grain, [&](const std::size_t first, const std::size_t last) {
+      const std::lock_guard lock(mutex);
+      chunks.emplace_back(first, last);
+    });
+    std::sort(chunks.begin(), chunks.end());
+    EXPECT_EQ(chunks.front().first, 3);
+    EXPECT_EQ(chunks.back().second, 4003);
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+      if (c + 1 < chunks.size()) {
+        EXPECT_EQ(chunks[c].second, chunks[c + 1].first);
+        EXPECT_GE(chunks[c].second - chunks[c].first, grain);
+      }
+    }
+  }
+}
+
+TEST(ThreadPoolTest, WorkStealing) {
+  ThreadPool pool(4);
+  // The share of the calling thread is slow, idle workers steal from it
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::vector<std::atomic<int>> visits(64);
+  pool.parallelFor(0, visits.size(), 1, [&](const std::size_t i) {
+    ++visits[i];
+    if (i < visits.size() / 4) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      const std::lock_guard lock(mutex);
+      threads.insert(std::this_thread::get_id());
+    }
+  });
+  for (const std::atomic<int>& count : visits) EXPECT_EQ(count, 1);
+  EXPECT_GE(threads.size(), 2);
+}
+
+TEST(ThreadPoolTest, ParallelReduce) {
+  const auto sum = [](const std::size_t first, const std::size_t last) {
+    std::size_t s = 0;
+    for (std::size_t i = first; i < last; ++i) s += i;
+    return s;
+  };
+  const auto plus = [](const std::size_t a, const std::size_t b) { return a + b; };
+  for (const std::size_t threads : {1, 3, 4}) {
+    ThreadPool pool(threads);
+    for (const std::size_t grain : {1, 64, 100000}) {
+      EXPECT_EQ(pool.parallelReduce(0, 10000, grain, std::size_t(0), sum, plus), 49995000U);
+      EXPECT_EQ(pool.parallelReduce(0, 10000, grain, std::size_t(0), sum, plus, ReductionOrder::Deterministic),
+                49995000U);
+    }
+    EXPECT_EQ(pool.parallelReduce(7, 7, 1, std::size_t(42), sum, plus), 42);
+  }
+}
+
+TEST(ThreadPoolTest, DeterministicReduction) {
+  // A floating point sum that depends on the order of the additions
+  std::vector<float> values(100000);
+  for (std::size_t i = 0; i < values.size(); ++i) values[i] = std::sin(float(i)) * float(1 + i % 1000);
+  const auto sum = [&](const std::size_t first, const std::size_t last) {
+    float s = 0;
+    for (std::size_t i = first; i < last; ++i) s += values[i];
+    return s;
+  };
+  const auto plus = [](const float a, const float b) { return a + b; };
+  const float expected =
+      ThreadPool(1).parallelReduce(0, values.size(), 999, 0.0F, sum, plus, ReductionOrder::Deterministic);
+  for (const std::size_t threads : {2, 3, 8}) {
+    ThreadPool pool(threads);
+    for (int run = 0; run < 10; ++run) {
+      EXPECT_EQ(pool.parallelReduce(0, values.size(), 999, 0.0F, sum, plus, ReductionOrder::Deterministic), expected);
+    }
+  }
+  // Combination in index order, for operations that are not commutative
+  ThreadPool pool(4);
+  const std::vector<std::size_t> order = pool.parallelReduce(
+      0, 100, 10, std::vector<std::size_t>(),
+      [](const std::size_t first, std::size_t) { return std::vector<std::size_t>{first}; },
+      [](std::vector<std::size_t> a, const std::vector<std::size_t>& b) {
+        a.insert(a.end(), b.begin(), b.end());
+        return a;
+      },
+      ReductionOrder::Deterministic);
+  EXPECT_EQ(order, (std::vector<std::size_t>{0, 10, 20, 30, 40, 50, 60, 70, 80, 90}));
+}
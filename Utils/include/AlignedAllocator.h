@@ -0,0 +1,75 @@
+#ifndef MATH_ALIGNED_ALLOCATOR_H
+#define MATH_ALIGNED_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "Types.h"
+
+namespace Math {
+
+/// Allocator that returns memory aligned to a cache line, so that SIMD kernels can use full width loads and stores.
+/// The memory comes from a std::pmr::memory_resource, by default aligned operator new, and can be redirected to an
+/// ArenaResource or PoolResource (see MemoryResource.h). Like std::pmr::polymorphic_allocator, the resource is not
+/// propagated on assignment and copies of a container use the default resource.
+template <typename T, std::size_t Alignment = MEMORY_ALIGNMENT>
+class AlignedAllocator {
+protected:
+  std::pmr::memory_resource* m_Resource = std::pmr::new_delete_resource();
+
+  static constexpr std::size_t ALIGNMENT = std::max(Alignment, alignof(T));
+
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+
+  /// Create an allocator that takes its memory from a resource
+  /// @param resource Memory resource, must outlive the containers that use the allocator
+  AlignedAllocator(std::pmr::memory_resource* resource) noexcept  // NOLINT(google-explicit-constructor)
+      : m_Resource(resource) {}
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>& other) noexcept  // NOLINT(google-explicit-constructor)
+      : m_Resource(other.resource()) {}
+
+  /// Allocate aligned memory for n elements
+  /// @param n Number of elements
+  /// @return Pointer to the uninitialized memory
+  T* allocate(const std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+    return static_cast<T*>(m_Resource->allocate(n * sizeof(T), ALIGNMENT));
+  }
+
+  /// Release memory obtained from allocate
+  /// @param p Pointer to the memory
+  /// @param n Number of elements
+  void deallocate(T* p, const std::size_t n) noexcept { m_Resource->deallocate(p, n * sizeof(T), ALIGNMENT); }
+
+  /// @return Resource that provides the memory
+  std::pmr::memory_resource* resource() const noexcept { return m_Resource; }
+
+  /// Copies of containers use the default resource
+  AlignedAllocator select_on_container_copy_construction() const noexcept { return AlignedAllocator(); }
+
+  template <typename U>
+  friend bool operator==(const AlignedAllocator& lhs, const AlignedAllocator<U, Alignment>& rhs) noexcept {
+    return lhs.resource() == rhs.resource() || lhs.resource()->is_equal(*rhs.resource());
+  }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+}  // namespace Math
+
+#endif  // MATH_ALIGNED_ALLOCATOR_H
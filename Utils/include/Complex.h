@@ -1,85 +1,590 @@
 #ifndef MATH_COMPLEX_H
 #define MATH_COMPLEX_H
 
-#include <iosfwd>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <limits>
 #include <string>
+#include <system_error>
+#include <type_traits>
+#include <version>
+#if __has_include(<format>)
+#include <format>
+#endif
 
 #include "Types.h"
 
 namespace Math {
 
-class Complex {
+/// Complex number with real and imaginary part of type T. The class is trivially copyable and all arithmetic is
+/// constexpr and defined in this header, so that it can be inlined and vectorized by the compiler.
+template <scalar T>
+class BasicComplex {
 protected:
-  real_t m_Real;
-  real_t m_Imag;
+  T m_Real;
+  T m_Imag;
 
 public:
-  Complex();
-  Complex(real_t real, real_t imag);
-  Complex(const Complex& other);
+  using value_type = T;
 
-  Complex& operator=(const Complex& other) = default;
+  /// Default constructor: creates a complex number with 0 real and 0 imaginary part
+  constexpr BasicComplex() : m_Real(0), m_Imag(0) {}
+
+  /// Create a new complex number
+  /// @param real Real part
+  /// @param imag Imaginary part
+  constexpr BasicComplex(const T real, const T imag) : m_Real(real), m_Imag(imag) {}
+
+  constexpr BasicComplex(const BasicComplex& other) = default;
+  constexpr BasicComplex(BasicComplex&& other) = default;
+  constexpr BasicComplex& operator=(const BasicComplex& other) = default;
+  constexpr BasicComplex& operator=(BasicComplex&& other) = default;
+  ~BasicComplex() = default;
 
   /// Get the real part of the complex number
   /// @return Real part
-  real_t real() const { return m_Real; }
+  constexpr T real() const { return m_Real; }
 
   /// Get the imaginary part of the complex number
   /// @return Imaginary part
-  real_t imag() const { return m_Imag; }
-
-  friend real_t real(const Complex& z);
-  friend real_t imag(const Complex& z);
-  friend real_t abs(const Complex& z);
-  friend real_t abs2(const Complex& z);
-  friend real_t arg(const Complex& z);
-  friend Complex conj(const Complex& z);
-  friend Complex exp(const Complex& z);
-  friend Complex log(const Complex& z);
-  friend Complex sin(const Complex& z);
-  friend Complex cos(const Complex& z);
-  friend Complex tan(const Complex& z);
-  friend Complex asin(const Complex& z);
-  friend Complex acos(const Complex& z);
-  friend Complex atan(const Complex& z);
-  friend Complex pow(const Complex& z, real_t w);
-  friend Complex pow(const Complex& z, const Complex& w);
-  friend Complex sqrt(const Complex& z);
-
-  Complex operator+() const;
-  Complex operator-() const;
-  Complex& operator+=(const Complex& rhs);
-  Complex& operator-=(const Complex& rhs);
-  Complex& operator*=(const Complex& rhs);
-  Complex& operator/=(const Complex& rhs);
-  Complex& operator+=(real_t rhs);
-  Complex& operator-=(real_t rhs);
-  Complex& operator*=(real_t rhs);
-  Complex& operator/=(real_t rhs);
+  constexpr T imag() const { return m_Imag; }
+
+  /// @return A copy of the complex number
+  constexpr BasicComplex operator+() const { return *this; }
+
+  /// Negate a complex number
+  /// @return A negated copy
+  constexpr BasicComplex operator-() const { return BasicComplex(-m_Real, -m_Imag); }
+
+  /// Adds two complex numbers and assigns it to the original variable
+  /// @param rhs Complex number
+  /// @return The updated complex number
+  constexpr BasicComplex& operator+=(const BasicComplex& rhs) {
+    m_Real += rhs.m_Real;
+    m_Imag += rhs.m_Imag;
+    return *this;
+  }
+
+  /// Subtracts two complex numbers and assigns it to the original variable
+  /// @param rhs The complex number to subtract
+  /// @return The updated complex number
+  constexpr BasicComplex& operator-=(const BasicComplex& rhs) {
+    m_Real -= rhs.m_Real;
+    m_Imag -= rhs.m_Imag;
+    return *this;
+  }
+
+  /// Multiplies two complex numbers and assigns it to the original variable
+  /// @param rhs Complex number
+  /// @return The updated complex number
+  constexpr BasicComplex& operator*=(const BasicComplex& rhs) {
+    const T real = m_Real * rhs.m_Real - m_Imag * rhs.m_Imag;
+    m_Imag = m_Imag * rhs.m_Real + m_Real * rhs.m_Imag;
+    m_Real = real;
+    return *this;
+  }
+
+  /// Divides two complex numbers and assigns it to the original variable
+  /// @param rhs Divisor, complex number
+  /// @return The updated complex number
+  constexpr BasicComplex& operator/=(const BasicComplex& rhs) {
+    const T div = rhs.m_Real * rhs.m_Real + rhs.m_Imag * rhs.m_Imag;
+    const T real = (m_Real * rhs.m_Real + m_Imag * rhs.m_Imag) / div;
+    m_Imag = (m_Imag * rhs.m_Real - m_Real * rhs.m_Imag) / div;
+    m_Real = real;
+    return *this;
+  }
+
+  /// Adds a real number to a complex number and assigns it to the original variable
+  /// @param rhs Real number
+  /// @return The updated complex number
+  constexpr BasicComplex& operator+=(const T rhs) {
+    m_Real += rhs;
+    return *this;
+  }
+
+  /// Subtracts a real number from a complex number and assigns it to the original variable
+  /// @param rhs Real number
+  /// @return The updated complex number
+  constexpr BasicComplex& operator-=(const T rhs) {
+    m_Real -= rhs;
+    return *this;
+  }
+
+  /// Multiplies a complex number with a real number and assigns it to the original variable
+  /// @param rhs Real number
+  /// @return The updated complex number
+  constexpr BasicComplex& operator*=(const T rhs) {
+    m_Real *= rhs;
+    m_Imag *= rhs;
+    return *this;
+  }
+
+  /// Divides a complex number by a real number and assigns it to the original variable
+  /// @param rhs Real number
+  /// @return The updated complex number
+  constexpr BasicComplex& operator/=(const T rhs) {
+    m_Real /= rhs;
+    m_Imag /= rhs;
+    return *this;
+  }
 };
 
-Complex operator+(Complex lhs, const Complex& rhs);
-Complex operator+(Complex lhs, real_t rhs);
-Complex operator+(real_t lhs, Complex rhs);
-Complex operator-(Complex lhs, const Complex& rhs);
-Complex operator-(Complex lhs, real_t rhs);
-Complex operator-(real_t lhs, const Complex& rhs);
-Complex operator*(Complex lhs, const Complex& rhs);
-Complex operator*(Complex lhs, real_t rhs);
-Complex operator*(real_t lhs, Complex rhs);
-Complex operator/(Complex lhs, const Complex& rhs);
-Complex operator/(Complex lhs, real_t rhs);
-Complex operator/(real_t lhs, const Complex& rhs);
-
-std::string to_string(const Complex& z);
-std::ostream& operator<<(std::ostream& os, const Complex& z);
-void print(const Complex& z);
+using ComplexF = BasicComplex<float>;
+using ComplexD = BasicComplex<double>;
+using ComplexLD = BasicComplex<long double>;
+using Complex = BasicComplex<real_t>;
+
+/// Get the real part of the complex number z
+/// @param z Complex number
+/// @return Real part of z
+template <scalar T>
+constexpr T real(const BasicComplex<T>& z) {
+  return z.real();
+}
+
+/// Get the imaginary part of the complex number z
+/// @param z Complex number
+/// @return Imaginary part of z
+template <scalar T>
+constexpr T imag(const BasicComplex<T>& z) {
+  return z.imag();
+}
+
+/// Computes the squared magnitude of a complex number z
+/// @param z Complex number
+/// @return Squared magnitude of z
+template <scalar T>
+constexpr T abs2(const BasicComplex<T>& z) {
+  return z.real() * z.real() + z.imag() * z.imag();
+}
+
+/// Computes the magnitude of a complex number z
+/// @param z Complex number
+/// @return Magnitude of z
+template <scalar T>
+T abs(const BasicComplex<T>& z) {
+  return std::sqrt(abs2(z));
+}
+
+/// Computes the argument (angle to real axis) of a complex number z
+/// @param z Complex number
+/// @return Argument of z
+template <scalar T>
+T arg(const BasicComplex<T>& z) {
+  return std::atan2(z.imag(), z.real());
+}
+
+/// Computes the conjugate of a complex number z
+/// @param z Complex number
+/// @return Conjugate complex number of z
+template <scalar T>
+constexpr BasicComplex<T> conj(const BasicComplex<T>& z) {
+  return BasicComplex<T>(z.real(), -z.imag());
+}
+
+/// Adds two complex numbers
+/// @param lhs Complex number
+/// @param rhs Complex number
+/// @return The addition of the two complex numbers
+template <scalar T>
+constexpr BasicComplex<T> operator+(BasicComplex<T> lhs, const BasicComplex<T>& rhs) {
+  lhs += rhs;
+  return lhs;
+}
+
+/// Adds a real number to a complex number
+/// @param lhs Complex number
+/// @param rhs Real Number
+/// @return The addition of the complex and real numbers
+template <scalar T>
+constexpr BasicComplex<T> operator+(BasicComplex<T> lhs, const std::type_identity_t<T> rhs) {
+  lhs += rhs;
+  return lhs;
+}
+
+/// Adds a real number to a complex number
+/// @param lhs Real Number
+/// @param rhs Complex number
+/// @return The addition of the complex and real numbers
+template <scalar T>
+constexpr BasicComplex<T> operator+(const std::type_identity_t<T> lhs, BasicComplex<T> rhs) {
+  rhs += lhs;
+  return rhs;
+}
+
+/// Subtracts two complex numbers
+/// @param lhs Complex number
+/// @param rhs Complex number
+/// @return The difference of the two complex numbers
+template <scalar T>
+constexpr BasicComplex<T> operator-(BasicComplex<T> lhs, const BasicComplex<T>& rhs) {
+  lhs -= rhs;
+  return lhs;
+}
+
+/// Subtracts a real number from a complex number
+/// @param lhs Complex number
+/// @param rhs Real number
+/// @return The difference of the two complex numbers
+template <scalar T>
+constexpr BasicComplex<T> operator-(BasicComplex<T> lhs, const std::type_identity_t<T> rhs) {
+  lhs -= rhs;
+  return lhs;
+}
+
+/// Subtracts a complex number from a real number
+/// @param lhs Real number
+/// @param rhs Complex number
+/// @return The difference of the two complex numbers
+template <scalar T>
+constexpr BasicComplex<T> operator-(const std::type_identity_t<T> lhs, const BasicComplex<T>& rhs) {
+  BasicComplex<T> tmp = -rhs;
+  tmp += lhs;
+  return tmp;
+}
+
+/// Multiplies two complex numbers
+/// @param lhs Complex number
+/// @param rhs Complex number
+/// @return The multiplication of the two complex numbers
+template <scalar T>
+constexpr BasicComplex<T> operator*(BasicComplex<T> lhs, const BasicComplex<T>& rhs) {
+  lhs *= rhs;
+  return lhs;
+}
+
+/// Multiplies a real number and a complex number
+/// @param lhs Complex number
+/// @param rhs Real number
+/// @return The multiplication's result
+template <scalar T>
+constexpr BasicComplex<T> operator*(BasicComplex<T> lhs, const std::type_identity_t<T> rhs) {
+  lhs *= rhs;
+  return lhs;
+}
+
+/// Multiplies a complex number and a real number
+/// @param lhs Real number
+/// @param rhs Complex number
+/// @return The multiplication's result
+template <scalar T>
+constexpr BasicComplex<T> operator*(const std::type_identity_t<T> lhs, BasicComplex<T> rhs) {
+  rhs *= lhs;
+  return rhs;
+}
+
+/// Divides two complex numbers
+/// @param lhs Complex number
+/// @param rhs Complex number
+/// @return The division of the two complex numbers
+template <scalar T>
+constexpr BasicComplex<T> operator/(BasicComplex<T> lhs, const BasicComplex<T>& rhs) {
+  lhs /= rhs;
+  return lhs;
+}
+
+/// Divides a complex number by a real number
+/// @param lhs Complex number
+/// @param rhs Real number
+/// @return The division's result
+template <scalar T>
+constexpr BasicComplex<T> operator/(BasicComplex<T> lhs, const std::type_identity_t<T> rhs) {
+  lhs /= rhs;
+  return lhs;
+}
+
+/// Divides a real number by a complex number
+/// @param lhs Real number
+/// @param rhs Complex number
+/// @return The division's result
+template <scalar T>
+constexpr BasicComplex<T> operator/(const std::type_identity_t<T> lhs, const BasicComplex<T>& rhs) {
+  return BasicComplex<T>(lhs, 0) / rhs;
+}
+
+/// Divides two complex numbers with Smith's algorithm. The divisor is scaled by its larger part first, so that no
+/// intermediate result overflows or underflows unless the quotient does, at the cost of one more division than
+/// operator/, whose squared magnitude of the divisor overflows beyond the square root of the largest number.
+/// @param lhs Complex number
+/// @param rhs Complex number
+/// @return The division of the two complex numbers
+template <scalar T>
+BasicComplex<T> scaledDivide(const BasicComplex<T>& lhs, const BasicComplex<T>& rhs) {
+  if (std::abs(rhs.real()) >= std::abs(rhs.imag())) {
+    const T ratio = rhs.imag() / rhs.real();
+    const T div = rhs.real() + rhs.imag() * ratio;
+    return BasicComplex<T>((lhs.real() + lhs.imag() * ratio) / div, (lhs.imag() - lhs.real() * ratio) / div);
+  }
+  const T ratio = rhs.real() / rhs.imag();
+  const T div = rhs.real() * ratio + rhs.imag();
+  return BasicComplex<T>((lhs.real() * ratio + lhs.imag()) / div, (lhs.imag() * ratio - lhs.real()) / div);
+}
+
+/// Computes the exponential map of a complex number z
+/// @param z Complex number
+/// @return Exponential of z
+template <scalar T>
+BasicComplex<T> exp(const BasicComplex<T>& z) {
+  const T magnitude = std::exp(z.real());
+  return BasicComplex<T>(magnitude * std::cos(z.imag()), magnitude * std::sin(z.imag()));
+}
+
+/// Computes the logarithmic map of a complex number z
+/// @param z Complex number
+/// @return Logarithm of z
+template <scalar T>
+BasicComplex<T> log(const BasicComplex<T>& z) {
+  return BasicComplex<T>(std::log(abs(z)), arg(z));
+}
+
+/// Computes the sine of a complex number z
+/// @param z Complex number
+/// @return Sine of z
+template <scalar T>
+BasicComplex<T> sin(const BasicComplex<T>& z) {
+  return BasicComplex<T>(std::sin(z.real()) * std::cosh(z.imag()), std::cos(z.real()) * std::sinh(z.imag()));
+}
+
+/// Computes the cosine of a complex number z
+/// @param z Complex number
+/// @return Cosine of z
+template <scalar T>
+BasicComplex<T> cos(const BasicComplex<T>& z) {
+  return BasicComplex<T>(std::cos(z.real()) * std::cosh(z.imag()), -std::sin(z.real()) * std::sinh(z.imag()));
+}
+
+/// Computes the tangent of a complex number z
+/// @param z Complex number
+/// @return Tangent of z
+template <scalar T>
+BasicComplex<T> tan(const BasicComplex<T>& z) {
+  return sin(z) / cos(z);
+}
+
+/// Computes the square root of a complex number z
+/// @param z Complex number
+/// @return Square root of z
+template <scalar T>
+BasicComplex<T> sqrt(const BasicComplex<T>& z) {
+  const T r = abs(z);
+  const T x = z.real();
+  const T y = z.imag();
+  const T u = std::sqrt((r + x) / 2);
+  T v = std::sqrt((r - x) / 2);
+  if (y < 0) v = -v;
+  return BasicComplex<T>(u, v);
+}
+
+/// Computes the arc-sine of a complex number z
+/// @param z Complex number
+/// @return Arc-sine of z
+template <scalar T>
+BasicComplex<T> asin(const BasicComplex<T>& z) {
+  const BasicComplex<T> i(0, 1);
+  return -i * log(i * z + sqrt(static_cast<T>(1.0) - z * z));
+}
+
+/// Computes the arc-cosine of a complex number z
+/// @param z Complex number
+/// @return Arc-cosine of z
+template <scalar T>
+BasicComplex<T> acos(const BasicComplex<T>& z) {
+  return -BasicComplex<T>(0, 1) * log(z + sqrt(z * z - static_cast<T>(1.0)));
+}
+
+/// Computes the arc-tangent of a complex number z
+/// @param z Complex number
+/// @return Arc-tangent of z
+template <scalar T>
+BasicComplex<T> atan(const BasicComplex<T>& z) {
+  const BasicComplex<T> i(0, 1);
+  const BasicComplex<T> one(1, 0);
+  return (i / BasicComplex<T>(2, 0)) * (log(one - i * z) - log(one + i * z));
+}
+
+/// Computes the power of a complex number z with a real exponent w
+/// @param z Base, complex number
+/// @param w Exponent, real number
+/// @return z to the power of w
+template <scalar T>
+BasicComplex<T> pow(const BasicComplex<T>& z, const std::type_identity_t<T> w) {
+  return exp(w * log(z));
+}
+
+/// Computes the power of a complex number z with an integer exponent n by binary exponentiation. It needs at most
+/// 2 log2|n| multiplications instead of exp and log, and is exact for small Gaussian integers.
+/// @param z Base, complex number
+/// @param n Exponent, integer
+/// @return z to the power of n, 1 for n = 0
+template <scalar T, std::integral I>
+  requires(!std::same_as<I, bool>)
+constexpr BasicComplex<T> pow(const BasicComplex<T>& z, const I n) {
+  using U = std::make_unsigned_t<I>;
+  U e = n < 0 ? U(U(0) - U(n)) : U(n);
+  BasicComplex<T> result(1, 0);
+  BasicComplex<T> base = z;
+  while (e != 0) {
+    if (e & 1) result *= base;
+    e >>= 1;
+    if (e != 0) base *= base;
+  }
+  return n < 0 ? T(1) / result : result;
+}
+
+/// Computes the power of a complex number z with a complex exponent w
+/// @param z Base, complex number
+/// @param w Exponent, complex number
+/// @return z to the power of w
+template <scalar T>
+BasicComplex<T> pow(const BasicComplex<T>& z, const BasicComplex<T>& w) {
+  return exp(w * log(z));
+}
+
+/// Upper bound of the characters that to_chars writes for a complex number: two parts of at most max_digits10 digits,
+/// sign, decimal point and exponent, the separator " + " and the imaginary unit
+template <scalar T>
+constexpr std::size_t COMPLEX_CHARS_MAX = 2 * (std::numeric_limits<T>::max_digits10 + 10) + 4;
+
+/// Writes a complex number as "a + bi" or "a - bi", or as "a" if the imaginary part is zero. Every part is the
+/// shortest text that reads back to the same value, and nothing is allocated.
+/// @param first Start of the buffer
+/// @param last End of the buffer, COMPLEX_CHARS_MAX<T> characters are always enough
+/// @param z Complex number
+/// @return End of the text, or errc::value_too_large with ptr == last if the buffer is too small
+template <scalar T>
+std::to_chars_result to_chars(char* first, char* last, const BasicComplex<T>& z) {
+  std::to_chars_result result = std::to_chars(first, last, z.real());
+  if (result.ec != std::errc() || z.imag() == 0) return result;
+  if (last - result.ptr < 3) return {last, std::errc::value_too_large};
+  const bool negative = std::signbit(z.imag());
+  *result.ptr++ = ' ';
+  *result.ptr++ = negative ? '-' : '+';
+  *result.ptr++ = ' ';
+  result = std::to_chars(result.ptr, last, negative ? -z.imag() : z.imag());
+  if (result.ec != std::errc()) return result;
+  if (result.ptr == last) return {last, std::errc::value_too_large};
+  *result.ptr++ = 'i';
+  return result;
+}
+
+/// Reads a complex number in one of the forms "a", "bi", "a + bi" and "a - bi", with or without blanks around the
+/// sign and with i or j as the imaginary unit, or "(a,b)" as std::complex writes it. This accepts every text of
+/// to_chars. The parts are read by std::from_chars, so leading blanks and '+' are not accepted, and nothing is
+/// allocated or thrown.
+/// @param first Start of the text
+/// @param last End of the text
+/// @param z Complex number, unchanged on error
+/// @return End of the number, errc::invalid_argument with ptr == first if there is none, or
+/// errc::result_out_of_range with ptr at the end of the number if a part does not fit T
+template <scalar T>
+std::from_chars_result from_chars(const char* const first, const char* const last, BasicComplex<T>& z) {
+  const auto blanks = [last](const char* p) {
+    while (p != last && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+  };
+  const auto unit = [last](const char* p) { return p != last && (*p == 'i' || *p == 'j'); };
+  const std::from_chars_result invalid{first, std::errc::invalid_argument};
+  T real = 0;
+  T imag = 0;
+  if (first != last && *first == '(') {
+    const char* p = blanks(first + 1);
+    std::from_chars_result part = std::from_chars(p, last, real);
+    if (part.ec == std::errc::invalid_argument) return invalid;
+    std::errc ec = part.ec;
+    p = blanks(part.ptr);
+    if (p != last && *p == ',') {
+      p = blanks(p + 1);
+      part = std::from_chars(p, last, imag);
+      if (part.ec == std::errc::invalid_argument) return invalid;
+      if (ec == std::errc()) ec = part.ec;
+      p = blanks(part.ptr);
+    }
+    if (p == last || *p != ')') return invalid;
+    if (ec == std::errc()) z = BasicComplex<T>(real, imag);
+    return {p + 1, ec};
+  }
+  const std::from_chars_result part = std::from_chars(first, last, real);
+  if (part.ec == std::errc::invalid_argument) return invalid;
+  if (unit(part.ptr)) {
+    if (part.ec == std::errc()) z = BasicComplex<T>(0, real);
+    return {part.ptr + 1, part.ec};
+  }
+  // The imaginary part is optional: a sign that is not followed by one, like in "1 -2", ends the number after a
+  const char* p = blanks(part.ptr);
+  if (p != last && (*p == '+' || *p == '-')) {
+    const bool negative = *p == '-';
+    const char* q = blanks(p + 1);
+    // A second sign, like in "1 + -2i", is not accepted
+    const std::from_chars_result imagPart = q != last && *q != '-' ? std::from_chars(q, last, imag) : invalid;
+    if (imagPart.ec != std::errc::invalid_argument && unit(imagPart.ptr)) {
+      const std::errc ec = part.ec != std::errc() ? part.ec : imagPart.ec;
+      if (ec == std::errc()) z = BasicComplex<T>(real, negative ? -imag : imag);
+      return {imagPart.ptr + 1, ec};
+    }
+  }
+  if (part.ec == std::errc()) z = BasicComplex<T>(real, 0);
+  return part;
+}
+
+/// Converts a complex number to a string, see to_chars
+/// @param z Complex number
+/// @return The complex number as a string
+template <scalar T>
+std::string to_string(const BasicComplex<T>& z) {
+  char buffer[COMPLEX_CHARS_MAX<T>];
+  return std::string(buffer, to_chars(buffer, buffer + sizeof(buffer), z).ptr);
+}
+
+/// Serializes a complex number, see to_chars
+template <scalar T>
+std::ostream& operator<<(std::ostream& os, const BasicComplex<T>& z) {
+  char buffer[COMPLEX_CHARS_MAX<T>];
+  return os.write(buffer, to_chars(buffer, buffer + sizeof(buffer), z).ptr - buffer);
+}
+
+/// Prints a complex number in the default output stream
+template <scalar T>
+void print(const BasicComplex<T>& z) {
+  std::cout << z << '\n';
+}
+
+static_assert(std::is_trivially_copyable_v<Complex>);
+static_assert(std::is_standard_layout_v<Complex>);
+static_assert(sizeof(Complex) == 2 * sizeof(real_t));
 
 }  // namespace Math
 
 namespace std {
 
-std::string to_string(const Math::Complex& z);
+/// Overloads the conversion from a complex number to a string
+template <Math::scalar T>
+std::string to_string(const Math::BasicComplex<T>& z) {
+  return Math::to_string(z);
+}
+
+#ifdef __cpp_lib_format
+/// Formats a complex number like Math::to_chars, std::format("{}", z). Format specifications are not supported.
+template <Math::scalar T>
+struct formatter<Math::BasicComplex<T>, char> {
+  constexpr format_parse_context::iterator parse(format_parse_context& context) {
+    if (context.begin() != context.end() && *context.begin() != '}') {
+      throw format_error("Complex: format specifications are not supported");
+    }
+    return context.begin();
+  }
+
+  template <typename Context>
+  typename Context::iterator format(const Math::BasicComplex<T>& z, Context& context) const {
+    char buffer[Math::COMPLEX_CHARS_MAX<T>];
+    return std::copy(buffer, Math::to_chars(buffer, buffer + sizeof(buffer), z).ptr, context.out());
+  }
+};
+#endif
 
 }  // namespace std
 
@@ -0,0 +1,685 @@
+#ifndef MATH_COMPLEX_ARRAY_H
+#define MATH_COMPLEX_ARRAY_H
+
+#include <algorithm>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "ComplexExpression.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Owning array of complex numbers in structure of arrays layout. Real and imaginary parts are kept in separate,
+/// cache line aligned buffers so that elementwise operations map directly onto SIMD registers.
+template <scalar T>
+class BasicComplexArray {
+protected:
+  AlignedVector<T> m_Real;
+  AlignedVector<T> m_Imag;
+
+  static size_t checkedSize(const std::size_t size) {
+    if (size > MAX_ELEMENT_COUNT) throw std::length_error("ComplexArray: size exceeds MAX_ELEMENT_COUNT");
+    return static_cast<size_t>(size);
+  }
+
+public:
+  using value_type = BasicComplex<T>;
+  using allocator_type = AlignedAllocator<T>;
+
+  /// Reference to an element that reads and writes the separate real and imaginary parts
+  class Reference {
+    T& m_Real;
+    T& m_Imag;
+
+  public:
+    Reference(T& real, T& imag) : m_Real(real), m_Imag(imag) {}
+    Reference(const Reference& other) = default;
+
+    operator value_type() const { return value_type(m_Real, m_Imag); }  // NOLINT(google-explicit-constructor)
+    Reference& operator=(const value_type& z) {
+      m_Real = z.real();
+      m_Imag = z.imag();
+      return *this;
+    }
+    Reference& operator=(const Reference& other) { return *this = static_cast<value_type>(other); }
+    T real() const { return m_Real; }
+    T imag() const { return m_Imag; }
+  };
+
+  /// Default constructor: creates an empty array
+  BasicComplexArray() = default;
+
+  /// Create an empty array that allocates from a memory resource
+  /// @param allocator Allocator of the real and imaginary parts, e.g. a pointer to an ArenaResource
+  explicit BasicComplexArray(const allocator_type& allocator) : m_Real(allocator), m_Imag(allocator) {}
+
+  /// Create an array of zeros
+  /// @param size Number of elements
+  /// @param allocator Allocator of the real and imaginary parts
+  explicit BasicComplexArray(const size_t size, const allocator_type& allocator = allocator_type())
+      : m_Real(checkedSize(size), allocator), m_Imag(size, allocator) {}
+
+  /// Create an array filled with a value
+  /// @param size Number of elements
+  /// @param value Value of all elements
+  /// @param allocator Allocator of the real and imaginary parts
+  BasicComplexArray(const size_t size, const value_type& value, const allocator_type& allocator = allocator_type())
+      : m_Real(checkedSize(size), value.real(), allocator), m_Imag(size, value.imag(), allocator) {}
+
+  /// Create an array from a list of complex numbers
+  /// @param values Elements
+  BasicComplexArray(const std::initializer_list<value_type> values)
+      : BasicComplexArray(std::span<const value_type>(values.begin(), values.size())) {}
+
+  /// Create an array from interleaved complex numbers
+  /// @param values Elements
+  explicit BasicComplexArray(const std::span<const value_type> values) : BasicComplexArray(checkedSize(values.size())) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      m_Real[i] = values[i].real();
+      m_Imag[i] = values[i].imag();
+    }
+  }
+
+  size_t size() const { return static_cast<size_t>(m_Real.size()); }
+  bool empty() const { return m_Real.empty(); }
+  allocator_type get_allocator() const { return m_Real.get_allocator(); }
+  static constexpr size_t max_size() { return MAX_ELEMENT_COUNT; }
+
+  /// Changes the number of elements, new elements are zero
+  /// @param size Number of elements
+  void resize(const size_t size) {
+    m_Real.resize(checkedSize(size));
+    m_Imag.resize(size);
+  }
+
+  value_type operator[](const size_t i) const { return value_type(m_Real[i], m_Imag[i]); }
+  Reference operator[](const size_t i) { return Reference(m_Real[i], m_Imag[i]); }
+
+  std::span<T> real() { return m_Real; }
+  std::span<const T> real() const { return m_Real; }
+  std::span<T> imag() { return m_Imag; }
+  std::span<const T> imag() const { return m_Imag; }
+
+  SplitSpan<T> view() { return SplitSpan<T>(m_Real.data(), m_Imag.data(), size()); }
+  SplitSpan<const T> view() const { return SplitSpan<const T>(m_Real.data(), m_Imag.data(), size()); }
+  operator SplitSpan<T>() { return view(); }                    // NOLINT(google-explicit-constructor)
+  operator SplitSpan<const T>() const { return view(); }        // NOLINT(google-explicit-constructor)
+
+  /// Create an array from the values of an expression (see ComplexExpression.h)
+  /// @param expression Elementwise expression of arrays
+  /// @param allocator Allocator of the real and imaginary parts
+  template <typename E>
+    requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+  BasicComplexArray(const E& expression,  // NOLINT(google-explicit-constructor)
+                    const allocator_type& allocator = allocator_type())
+      : BasicComplexArray(checkedSize(expression.size()), allocator) {
+    evaluate(expression, view());
+  }
+
+  /// Assigns the values of an expression, which may refer to this array
+  /// @param expression Elementwise expression of arrays
+  /// @return The updated array
+  template <typename E>
+    requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+  BasicComplexArray& operator=(const E& expression) {
+    if (expression.size() == size()) {
+      evaluate(expression, view());
+    } else {
+      *this = BasicComplexArray(expression, get_allocator());
+    }
+    return *this;
+  }
+
+  template <typename E>
+    requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+  BasicComplexArray& operator+=(const E& rhs);
+  template <typename E>
+    requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+  BasicComplexArray& operator-=(const E& rhs);
+  template <typename E>
+    requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+  BasicComplexArray& operator*=(const E& rhs);
+  template <typename E>
+    requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+  BasicComplexArray& operator/=(const E& rhs);
+  BasicComplexArray& operator+=(const BasicComplexArray& rhs);
+  BasicComplexArray& operator-=(const BasicComplexArray& rhs);
+  BasicComplexArray& operator*=(const BasicComplexArray& rhs);
+  BasicComplexArray& operator/=(const BasicComplexArray& rhs);
+  BasicComplexArray& operator+=(const value_type& rhs);
+  BasicComplexArray& operator-=(const value_type& rhs);
+  BasicComplexArray& operator*=(const value_type& rhs);
+  BasicComplexArray& operator/=(const value_type& rhs);
+  BasicComplexArray& operator+=(T rhs);
+  BasicComplexArray& operator-=(T rhs);
+  BasicComplexArray& operator*=(T rhs);
+  BasicComplexArray& operator/=(T rhs);
+};
+
+using ComplexArray = BasicComplexArray<real_t>;
+using RealArray = AlignedVector<real_t>;
+
+// Elementwise kernels on split complex views. The output may alias an input, all views must have the same size.
+// They are vectorized with the widest instruction set available at runtime (see Simd.h).
+
+template <scalar T>
+void add(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<SplitSpan<const T>> rhs, SplitSpan<T> out);
+template <scalar T>
+void add(std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs, SplitSpan<T> out);
+template <scalar T>
+void add(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<T> rhs, SplitSpan<T> out);
+template <scalar T>
+void subtract(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<SplitSpan<const T>> rhs,
+              SplitSpan<T> out);
+template <scalar T>
+void subtract(std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs, SplitSpan<T> out);
+template <scalar T>
+void subtract(const BasicComplex<T>& lhs, std::type_identity_t<SplitSpan<const T>> rhs, SplitSpan<T> out);
+template <scalar T>
+void subtract(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<T> rhs, SplitSpan<T> out);
+template <scalar T>
+void subtract(std::type_identity_t<T> lhs, std::type_identity_t<SplitSpan<const T>> rhs, SplitSpan<T> out);
+template <scalar T>
+void multiply(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<SplitSpan<const T>> rhs,
+              SplitSpan<T> out);
+template <scalar T>
+void multiply(std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs, SplitSpan<T> out);
+template <scalar T>
+void multiply(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<T> rhs, SplitSpan<T> out);
+template <scalar T>
+void divide(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<SplitSpan<const T>> rhs,
+            SplitSpan<T> out);
+template <scalar T>
+void divide(std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs, SplitSpan<T> out);
+template <scalar T>
+void divide(const BasicComplex<T>& lhs, std::type_identity_t<SplitSpan<const T>> rhs, SplitSpan<T> out);
+template <scalar T>
+void divide(std::type_identity_t<SplitSpan<const T>> lhs, std::type_identity_t<T> rhs, SplitSpan<T> out);
+template <scalar T>
+void divide(std::type_identity_t<T> lhs, std::type_identity_t<SplitSpan<const T>> rhs, SplitSpan<T> out);
+template <scalar T>
+void negate(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void conj(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void abs(std::type_identity_t<SplitSpan<const T>> z, std::span<T> out);
+template <scalar T>
+void abs2(std::type_identity_t<SplitSpan<const T>> z, std::span<T> out);
+template <scalar T>
+void arg(std::type_identity_t<SplitSpan<const T>> z, std::span<T> out);
+
+/// Copies interleaved complex numbers into a split view
+/// @param z Interleaved complex numbers
+/// @param out Split view of the same size
+template <scalar T>
+void deinterleave(std::span<const BasicComplex<T>> z, SplitSpan<T> out);
+
+/// Copies a split view into interleaved complex numbers
+/// @param z Split view
+/// @param out Interleaved complex numbers of the same size
+template <scalar T>
+void interleave(std::type_identity_t<SplitSpan<const T>> z, std::span<BasicComplex<T>> out);
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator+=(const BasicComplexArray& rhs) {
+  add<T>(view(), rhs.view(), view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator-=(const BasicComplexArray& rhs) {
+  subtract<T>(view(), rhs.view(), view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator*=(const BasicComplexArray& rhs) {
+  multiply<T>(view(), rhs.view(), view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator/=(const BasicComplexArray& rhs) {
+  divide<T>(view(), rhs.view(), view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator+=(const value_type& rhs) {
+  add<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator-=(const value_type& rhs) {
+  subtract<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator*=(const value_type& rhs) {
+  multiply<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator/=(const value_type& rhs) {
+  divide<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator+=(const T rhs) {
+  add<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator-=(const T rhs) {
+  subtract<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator*=(const T rhs) {
+  multiply<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+BasicComplexArray<T>& BasicComplexArray<T>::operator/=(const T rhs) {
+  divide<T>(view(), rhs, view());
+  return *this;
+}
+
+template <scalar T>
+template <typename E>
+  requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+BasicComplexArray<T>& BasicComplexArray<T>::operator+=(const E& rhs) {
+  if (rhs.size() != size()) throw std::invalid_argument("ComplexArray: operands differ in size");
+  forEachBlock(rhs, [&](const std::size_t offset, const SplitSpan<const T> values) {
+    const SplitSpan<T> block = view().subspan(static_cast<size_t>(offset), values.size());
+    add<T>(block, values, block);
+  });
+  return *this;
+}
+
+template <scalar T>
+template <typename E>
+  requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+BasicComplexArray<T>& BasicComplexArray<T>::operator-=(const E& rhs) {
+  if (rhs.size() != size()) throw std::invalid_argument("ComplexArray: operands differ in size");
+  forEachBlock(rhs, [&](const std::size_t offset, const SplitSpan<const T> values) {
+    const SplitSpan<T> block = view().subspan(static_cast<size_t>(offset), values.size());
+    subtract<T>(block, values, block);
+  });
+  return *this;
+}
+
+template <scalar T>
+template <typename E>
+  requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+BasicComplexArray<T>& BasicComplexArray<T>::operator*=(const E& rhs) {
+  if (rhs.size() != size()) throw std::invalid_argument("ComplexArray: operands differ in size");
+  forEachBlock(rhs, [&](const std::size_t offset, const SplitSpan<const T> values) {
+    const SplitSpan<T> block = view().subspan(static_cast<size_t>(offset), values.size());
+    multiply<T>(block, values, block);
+  });
+  return *this;
+}
+
+template <scalar T>
+template <typename E>
+  requires(complexExpression<E> && std::same_as<typename E::scalar_type, T>)
+BasicComplexArray<T>& BasicComplexArray<T>::operator/=(const E& rhs) {
+  if (rhs.size() != size()) throw std::invalid_argument("ComplexArray: operands differ in size");
+  forEachBlock(rhs, [&](const std::size_t offset, const SplitSpan<const T> values) {
+    const SplitSpan<T> block = view().subspan(static_cast<size_t>(offset), values.size());
+    divide<T>(block, values, block);
+  });
+  return *this;
+}
+
+// Lazy elementwise operators and functions of arrays. They return expressions (see ComplexExpression.h) that are
+// evaluated in one pass when they are assigned to an array; operands are arrays, SplitSpans and expressions, combined
+// with each other or with complex and real numbers.
+
+/// Wraps an array as an expression operand that refers to the array
+template <scalar T>
+SplitSpanExpression<T> toExpression(const BasicComplexArray<T>& z) {
+  return SplitSpanExpression<T>(z.view());
+}
+
+/// Wraps a temporary array as an expression operand that owns the array
+template <scalar T>
+ArrayValueExpression<BasicComplexArray<T>> toExpression(BasicComplexArray<T>&& z) {
+  return ArrayValueExpression<BasicComplexArray<T>>(std::move(z));
+}
+
+/// Arrays, SplitSpans and expressions
+template <typename X>
+concept arrayOperand = requires(X&& x) {
+  { toExpression(std::forward<X>(x)) } -> complexExpression;
+};
+
+/// Underlying floating point type of an array operand
+template <typename X>
+using operand_scalar_t = typename decltype(toExpression(std::declval<X>()))::scalar_type;
+
+/// Real and complex numbers that can be combined with the elements of an array of type T
+template <typename S, typename T>
+concept scalarOperand =
+    std::is_arithmetic_v<std::remove_cvref_t<S>> || std::same_as<std::remove_cvref_t<S>, BasicComplex<T>>;
+
+/// Operands of an elementwise binary operation: at least one array operand, the other one an array operand of the same
+/// type or a number
+template <typename L, typename R>
+concept complexOperands =
+    (arrayOperand<L> && arrayOperand<R> && std::same_as<operand_scalar_t<L>, operand_scalar_t<R>>) ||
+    (arrayOperand<L> && scalarOperand<R, operand_scalar_t<L>>) ||
+    (scalarOperand<L, operand_scalar_t<R>> && arrayOperand<R>);
+
+/// Converts an operand of a binary expression: real numbers to T, array operands to expressions
+template <scalar T, typename X>
+auto toOperand(X&& x) {
+  if constexpr (std::is_arithmetic_v<std::remove_cvref_t<X>>) {
+    return static_cast<T>(x);
+  } else if constexpr (std::same_as<std::remove_cvref_t<X>, BasicComplex<T>>) {
+    return BasicComplex<T>(x);
+  } else {
+    return toExpression(std::forward<X>(x));
+  }
+}
+
+/// @return Expression of an elementwise operation of two operands
+template <typename Op, typename L, typename R>
+  requires complexOperands<L, R>
+auto binaryExpression(L&& lhs, R&& rhs) {
+  using T = operand_scalar_t<std::conditional_t<arrayOperand<L>, L, R>>;
+  using LhsOperand = decltype(toOperand<T>(std::forward<L>(lhs)));
+  using RhsOperand = decltype(toOperand<T>(std::forward<R>(rhs)));
+  return BinaryExpression<Op, LhsOperand, RhsOperand>(toOperand<T>(std::forward<L>(lhs)),
+                                                      toOperand<T>(std::forward<R>(rhs)));
+}
+
+/// @return Expression of an elementwise function of an array operand
+template <typename Op, typename X>
+  requires arrayOperand<X>
+auto unaryExpression(X&& z) {
+  using Operand = decltype(toExpression(std::forward<X>(z)));
+  return UnaryExpression<Op, Operand>(toExpression(std::forward<X>(z)));
+}
+
+struct AddOperation : ElementwiseOperation {
+  static constexpr bool PRESERVES_REAL = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    add<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const BasicComplex<T>& rhs, const SplitSpan<T> out) {
+    add<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const std::type_identity_t<T> rhs, const SplitSpan<T> out) {
+    add<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const BasicComplex<T>& lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    add<T>(rhs, lhs, out);
+  }
+  template <scalar T>
+  static void apply(const std::type_identity_t<T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    add<T>(rhs, lhs, out);
+  }
+};
+
+struct SubtractOperation : ElementwiseOperation {
+  static constexpr bool PRESERVES_REAL = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    subtract<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const BasicComplex<T>& rhs, const SplitSpan<T> out) {
+    subtract<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const std::type_identity_t<T> rhs, const SplitSpan<T> out) {
+    subtract<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const BasicComplex<T>& lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    subtract<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const std::type_identity_t<T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    subtract<T>(lhs, rhs, out);
+  }
+};
+
+struct MultiplyOperation : ElementwiseOperation {
+  static constexpr bool PRESERVES_REAL = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    multiply<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const BasicComplex<T>& rhs, const SplitSpan<T> out) {
+    multiply<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const std::type_identity_t<T> rhs, const SplitSpan<T> out) {
+    multiply<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const BasicComplex<T>& lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    multiply<T>(rhs, lhs, out);
+  }
+  template <scalar T>
+  static void apply(const std::type_identity_t<T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    multiply<T>(rhs, lhs, out);
+  }
+};
+
+struct DivideOperation : ElementwiseOperation {
+  static constexpr bool PRESERVES_REAL = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    divide<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const BasicComplex<T>& rhs, const SplitSpan<T> out) {
+    divide<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> lhs, const std::type_identity_t<T> rhs, const SplitSpan<T> out) {
+    divide<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const BasicComplex<T>& lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    divide<T>(lhs, rhs, out);
+  }
+  template <scalar T>
+  static void apply(const std::type_identity_t<T> lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+    divide<T>(lhs, rhs, out);
+  }
+};
+
+struct NegateOperation : ElementwiseOperation {
+  static constexpr bool PRESERVES_REAL = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    negate<T>(z, out);
+  }
+};
+
+struct ConjOperation : ElementwiseOperation {
+  static constexpr bool PRESERVES_REAL = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    conj<T>(z, out);
+  }
+};
+
+struct RealOperation : ElementwiseOperation {
+  static constexpr bool REAL_RESULT = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    if (z.realData() != out.realData()) std::copy_n(z.realData(), z.size(), out.realData());
+    std::fill_n(out.imagData(), out.size(), T(0));
+  }
+};
+
+struct ImagOperation : ElementwiseOperation {
+  static constexpr bool REAL_RESULT = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    std::copy_n(z.imagData(), z.size(), out.realData());
+    std::fill_n(out.imagData(), out.size(), T(0));
+  }
+};
+
+struct AbsOperation : ElementwiseOperation {
+  static constexpr bool REAL_RESULT = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    abs<T>(z, out.real());
+    std::fill_n(out.imagData(), out.size(), T(0));
+  }
+};
+
+struct Abs2Operation : ElementwiseOperation {
+  static constexpr bool REAL_RESULT = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    abs2<T>(z, out.real());
+    std::fill_n(out.imagData(), out.size(), T(0));
+  }
+};
+
+struct ArgOperation : ElementwiseOperation {
+  static constexpr bool REAL_RESULT = true;
+
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    arg<T>(z, out.real());
+    std::fill_n(out.imagData(), out.size(), T(0));
+  }
+};
+
+/// @return The array operand as an expression
+template <typename X>
+  requires arrayOperand<X>
+auto operator+(X&& z) {
+  return toExpression(std::forward<X>(z));
+}
+
+/// @return Expression of the negated elements
+template <typename X>
+  requires arrayOperand<X>
+auto operator-(X&& z) {
+  return unaryExpression<NegateOperation>(std::forward<X>(z));
+}
+
+/// @return Expression of the elementwise sums
+template <typename L, typename R>
+  requires complexOperands<L, R>
+auto operator+(L&& lhs, R&& rhs) {
+  return binaryExpression<AddOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/// @return Expression of the elementwise differences
+template <typename L, typename R>
+  requires complexOperands<L, R>
+auto operator-(L&& lhs, R&& rhs) {
+  return binaryExpression<SubtractOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/// @return Expression of the elementwise products
+template <typename L, typename R>
+  requires complexOperands<L, R>
+auto operator*(L&& lhs, R&& rhs) {
+  return binaryExpression<MultiplyOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/// @return Expression of the elementwise quotients
+template <typename L, typename R>
+  requires complexOperands<L, R>
+auto operator/(L&& lhs, R&& rhs) {
+  return binaryExpression<DivideOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/// Computes the conjugates of all elements
+/// @param z Array operand
+/// @return Expression of the conjugates
+template <typename X>
+  requires arrayOperand<X>
+auto conj(X&& z) {
+  return unaryExpression<ConjOperation>(std::forward<X>(z));
+}
+
+/// Gets the real parts of all elements
+/// @param z Array operand
+/// @return Real-valued expression of the real parts
+template <typename X>
+  requires arrayOperand<X>
+auto real(X&& z) {
+  return unaryExpression<RealOperation>(std::forward<X>(z));
+}
+
+/// Gets the imaginary parts of all elements
+/// @param z Array operand
+/// @return Real-valued expression of the imaginary parts
+template <typename X>
+  requires arrayOperand<X>
+auto imag(X&& z) {
+  return unaryExpression<ImagOperation>(std::forward<X>(z));
+}
+
+/// Computes the magnitudes of all elements
+/// @param z Array operand
+/// @return Real-valued expression of the magnitudes
+template <typename X>
+  requires arrayOperand<X>
+auto abs(X&& z) {
+  return unaryExpression<AbsOperation>(std::forward<X>(z));
+}
+
+/// Computes the squared magnitudes of all elements
+/// @param z Array operand
+/// @return Real-valued expression of the squared magnitudes
+template <typename X>
+  requires arrayOperand<X>
+auto abs2(X&& z) {
+  return unaryExpression<Abs2Operation>(std::forward<X>(z));
+}
+
+/// Computes the arguments of all elements
+/// @param z Array operand
+/// @return Real-valued expression of the arguments
+template <typename X>
+  requires arrayOperand<X>
+auto arg(X&& z) {
+  return unaryExpression<ArgOperation>(std::forward<X>(z));
+}
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_ARRAY_H
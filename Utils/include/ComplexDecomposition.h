@@ -0,0 +1,252 @@
+#ifndef MATH_COMPLEX_DECOMPOSITION_H
+#define MATH_COMPLEX_DECOMPOSITION_H
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Complex.h"
+#include "ComplexMatrix.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Columns of the panels of the blocked factorizations
+constexpr size_t DECOMPOSITION_BLOCK_SIZE = 64;
+
+/// Rows of the active blocks of the QR iteration from which the eigen solver uses aggressive early deflation
+constexpr size_t EIGEN_DEFLATION_SIZE = 96;
+
+/// LU factorization with partial pivoting P A = L U of a square matrix, computed once and reused for any number of
+/// right-hand sides. The factorization is blocked and right-looking: a panel of DECOMPOSITION_BLOCK_SIZE columns is
+/// factored by recursive halving, the rows of the panel are solved for the block row of U, and the trailing matrix is
+/// updated by one matrix product, which runs in parallel on the pool. Divisions by the pivots use scaledDivide.
+/// A zero pivot does not stop the factorization, singular() reports it and solve throws.
+template <scalar T>
+class BasicLuDecomposition {
+protected:
+  /// L below the diagonal, its unit diagonal is implicit, and U on and above it, in column-major order
+  BasicComplexMatrix<T> m_Factors;
+  /// Row i was exchanged with row m_Pivots[i] >= i in step i
+  std::vector<size_t> m_Pivots;
+  bool m_Singular = false;
+
+  void factorPanel(std::size_t col, std::size_t width, ThreadPool& pool);
+
+public:
+  /// Factors a matrix
+  /// @param a Square matrix
+  /// @param pool Threads that update the trailing matrix
+  explicit BasicLuDecomposition(std::type_identity_t<ComplexMatrixView<const T>> a,
+                                ThreadPool& pool = defaultThreadPool());
+
+  [[nodiscard]] size_t size() const { return m_Factors.rows(); }
+
+  /// @return L below the diagonal and U on and above it
+  [[nodiscard]] ComplexMatrixView<const T> factors() const { return m_Factors.view(); }
+
+  /// @return Row exchanged with row i in step i, for every row i
+  [[nodiscard]] std::span<const size_t> pivots() const { return m_Pivots; }
+
+  /// @return Whether U has a zero on its diagonal
+  [[nodiscard]] bool singular() const { return m_Singular; }
+
+  /// @return Determinant of the matrix
+  [[nodiscard]] BasicComplex<T> determinant() const;
+
+  /// Solves A X = B in place
+  /// @param b Right-hand sides B, size() x k, overwritten with X
+  /// @param pool Threads that solve blocks of columns of b
+  void solveInPlace(std::type_identity_t<ComplexMatrixView<T>> b, ThreadPool& pool = defaultThreadPool()) const;
+
+  /// Solves A X = B
+  /// @param b Right-hand sides B, size() x k
+  /// @param pool Threads that solve blocks of columns of b
+  /// @return X, column-major size() x k
+  [[nodiscard]] BasicComplexMatrix<T> solve(std::type_identity_t<ComplexMatrixView<const T>> b,
+                                            ThreadPool& pool = defaultThreadPool()) const;
+};
+
+/// Householder QR factorization A = Q R of an m x n matrix, Q = H_0 H_1 ... with H_j = I - tau_j v_j v_j^H, computed
+/// once and reused for any number of right-hand sides. The factorization is blocked: the reflectors of a panel of
+/// DECOMPOSITION_BLOCK_SIZE columns, factored by recursive halving, are accumulated into the compact WY form
+/// I - V T V^H, and the trailing matrix is updated by three matrix products, which run in parallel on the pool. Norms
+/// are scaled so that they overflow only if the result does. solve returns the least squares solution of a matrix
+/// with m >= n and full column rank.
+template <scalar T>
+class BasicQrDecomposition {
+protected:
+  /// R on and above the diagonal and the reflectors v_j below it, their unit first element is implicit, in
+  /// column-major order
+  BasicComplexMatrix<T> m_Factors;
+  std::vector<BasicComplex<T>> m_Tau;
+  /// Upper triangular T of the panel at column j in the columns [j, j + DECOMPOSITION_BLOCK_SIZE)
+  BasicComplexMatrix<T> m_Triangular;
+
+  void factorPanel(std::size_t col, std::size_t width, ThreadPool& pool);
+  void applyReflectors(ComplexMatrixView<T> b, bool adjoint, ThreadPool& pool) const;
+
+public:
+  /// Factors a matrix
+  /// @param a m x n matrix
+  /// @param pool Threads that update the trailing matrix
+  explicit BasicQrDecomposition(std::type_identity_t<ComplexMatrixView<const T>> a,
+                                ThreadPool& pool = defaultThreadPool());
+
+  [[nodiscard]] size_t rows() const { return m_Factors.rows(); }
+  [[nodiscard]] size_t cols() const { return m_Factors.cols(); }
+
+  /// @return R on and above the diagonal and the reflectors below it
+  [[nodiscard]] ComplexMatrixView<const T> factors() const { return m_Factors.view(); }
+
+  /// @return Factors tau_j of the reflectors
+  [[nodiscard]] std::span<const BasicComplex<T>> tau() const { return m_Tau; }
+
+  /// @return Upper trapezoidal R, min(m, n) x n
+  [[nodiscard]] BasicComplexMatrix<T> r() const;
+
+  /// @return First min(m, n) columns of Q, m x min(m, n)
+  [[nodiscard]] BasicComplexMatrix<T> q(ThreadPool& pool = defaultThreadPool()) const;
+
+  /// Multiplies by Q in place
+  /// @param b m x k matrix, overwritten with Q b
+  /// @param pool Threads that compute the products
+  void applyQ(std::type_identity_t<ComplexMatrixView<T>> b, ThreadPool& pool = defaultThreadPool()) const;
+
+  /// Multiplies by Q^H in place
+  /// @param b m x k matrix, overwritten with Q^H b
+  /// @param pool Threads that compute the products
+  void applyQAdjoint(std::type_identity_t<ComplexMatrixView<T>> b, ThreadPool& pool = defaultThreadPool()) const;
+
+  /// Solves min |A X - B| in the least squares sense, the exact solution of a square system
+  /// @param b Right-hand sides B, m x k, m >= n
+  /// @param pool Threads that compute the products
+  /// @return X, column-major n x k
+  [[nodiscard]] BasicComplexMatrix<T> solve(std::type_identity_t<ComplexMatrixView<const T>> b,
+                                            ThreadPool& pool = defaultThreadPool()) const;
+};
+
+/// Eigenvalues and eigenvectors of square matrices of one size, with every workspace allocated by the constructor so
+/// that compute does not allocate. The matrix is reduced to Hessenberg form H = Q^H A Q by blocked Householder
+/// reflectors, whose panels accumulate the right-hand updates in Y = A V T so that the trailing matrix is updated by
+/// matrix products. Implicitly shifted QR sweeps with Wilkinson shifts then reduce H to the upper triangular Schur form
+/// T = Z^H A Z. Active blocks of at least EIGEN_DEFLATION_SIZE rows first try aggressive early deflation: the Schur
+/// form of a window at the bottom of the block reveals the eigenvalues that have converged long before the
+/// subdiagonal is small, and the other eigenvalues of the window are the shifts of the next sweeps. Eigenvectors are
+/// solved from T by back substitution and transformed by Z.
+template <scalar T>
+class BasicEigenSolver {
+protected:
+  size_t m_Size;
+  bool m_Vectors;
+  /// H, then T, in column-major order
+  BasicComplexMatrix<T> m_Schur;
+  /// Q, then Z
+  BasicComplexMatrix<T> m_SchurVectors;
+  BasicComplexMatrix<T> m_Eigenvectors;
+  std::vector<BasicComplex<T>> m_Eigenvalues;
+
+  // Panels of the Hessenberg reduction: V and V^H, Y = A V T, T and T^H, and products of a panel with the matrix
+  BasicComplexMatrix<T> m_Reflectors;
+  BasicComplexMatrix<T> m_ReflectorsAdjoint;
+  BasicComplexMatrix<T> m_Y;
+  BasicComplexMatrix<T> m_Triangular;
+  BasicComplexMatrix<T> m_TriangularAdjoint;
+  BasicComplexMatrix<T> m_PanelProduct;
+  BasicComplexMatrix<T> m_RowProduct;
+  BasicComplexMatrix<T> m_RowProductT;
+
+  // Deflation window: its Schur form and vectors, their adjoint and the products with the rest of the matrix
+  BasicComplexMatrix<T> m_Window;
+  BasicComplexMatrix<T> m_WindowVectors;
+  BasicComplexMatrix<T> m_WindowAdjoint;
+  BasicComplexMatrix<T> m_WindowColumns;
+  BasicComplexMatrix<T> m_WindowRows;
+  std::vector<BasicComplex<T>> m_Shifts;
+  /// Rotations of a QR sweep
+  std::vector<T> m_Cosines;
+  std::vector<BasicComplex<T>> m_Sines;
+
+  /// Triangular eigenvectors of T
+  BasicComplexMatrix<T> m_Work;
+  std::vector<BasicComplex<T>> m_Vector;
+
+  void reduceHessenberg(ThreadPool& pool);
+  void reducePanel(std::size_t col, std::size_t width);
+  std::size_t deflateWindow(std::size_t lo, std::size_t hi, std::size_t& shifts, ThreadPool& pool);
+  void solveEigenvectors(ThreadPool& pool);
+
+public:
+  /// Allocates the workspaces
+  /// @param size Number of rows and columns of the matrices
+  /// @param vectors Whether to compute the Schur vectors and the eigenvectors besides the eigenvalues
+  explicit BasicEigenSolver(size_t size, bool vectors = true);
+
+  [[nodiscard]] size_t size() const { return m_Size; }
+  [[nodiscard]] bool vectors() const { return m_Vectors; }
+
+  /// Computes the eigenvalues, and the eigenvectors if they were requested
+  /// @param a size() x size() matrix
+  /// @param pool Threads that compute the matrix products
+  void compute(std::type_identity_t<ComplexMatrixView<const T>> a, ThreadPool& pool = defaultThreadPool());
+
+  /// @return Eigenvalues, in the order of the diagonal of the Schur form
+  [[nodiscard]] std::span<const BasicComplex<T>> eigenvalues() const { return m_Eigenvalues; }
+
+  /// @return Eigenvectors of unit length in the columns, in the order of eigenvalues(), or an empty view
+  [[nodiscard]] ComplexMatrixView<const T> eigenvectors() const { return m_Eigenvectors.view(); }
+
+  /// @return Upper triangular Schur form T with A = Z T Z^H if vectors were requested, else the active blocks are
+  /// triangular but the elements above them are not transformed
+  [[nodiscard]] ComplexMatrixView<const T> schur() const { return m_Schur.view(); }
+
+  /// @return Unitary Schur vectors Z, or an empty view
+  [[nodiscard]] ComplexMatrixView<const T> schurVectors() const { return m_SchurVectors.view(); }
+};
+
+/// Eigenvalues and eigenvectors of batches of matrices of one size. Every thread of the pool owns a BasicEigenSolver,
+/// allocated by the constructor, and solves whole matrices with it, so that a batch of small matrices runs on all
+/// cores without allocating. compute may be called from several threads at once, a call that finds the pool busy
+/// runs on its own thread and allocates another solver if all of them are in use.
+template <scalar T>
+class BasicBatchedEigenSolver {
+protected:
+  ThreadPool* m_Pool;
+  size_t m_Size;
+  bool m_Vectors;
+  /// A deque keeps the solvers in place when concurrent calls add more
+  std::deque<BasicEigenSolver<T>> m_Solvers;
+  /// Solvers that no thread is using
+  std::vector<BasicEigenSolver<T>*> m_Free;
+  std::mutex m_Mutex;
+
+public:
+  /// Allocates one solver per thread of the pool
+  /// @param size Number of rows and columns of the matrices
+  /// @param vectors Whether to compute the eigenvectors besides the eigenvalues
+  /// @param pool Threads that solve the matrices
+  explicit BasicBatchedEigenSolver(size_t size, bool vectors = true, ThreadPool& pool = defaultThreadPool());
+
+  [[nodiscard]] size_t size() const { return m_Size; }
+  [[nodiscard]] bool vectors() const { return m_Vectors; }
+
+  /// Computes the eigenvalues, and the eigenvectors if they were requested, of every matrix
+  /// @param matrices size() x size() matrices
+  /// @param eigenvalues matrices.size() * size() numbers, the eigenvalues of matrix i at i * size()
+  /// @param eigenvectors One size() x size() matrix per matrix for its eigenvectors, or empty
+  void compute(std::span<const ComplexMatrixView<const T>> matrices, std::span<BasicComplex<T>> eigenvalues,
+               std::span<const ComplexMatrixView<T>> eigenvectors = {});
+};
+
+using LuDecomposition = BasicLuDecomposition<real_t>;
+using QrDecomposition = BasicQrDecomposition<real_t>;
+using EigenSolver = BasicEigenSolver<real_t>;
+using BatchedEigenSolver = BasicBatchedEigenSolver<real_t>;
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_DECOMPOSITION_H
@@ -0,0 +1,334 @@
+#ifndef MATH_COMPLEX_EXPRESSION_H
+#define MATH_COMPLEX_EXPRESSION_H
+
+// Expression templates for elementwise arithmetic on split complex arrays. The operators of ComplexArray.h and the
+// array functions of ComplexMath.h return expression objects instead of arrays, and the whole expression is evaluated
+// once it is assigned to an array or a SplitSpan. Evaluation runs in blocks of EXPRESSION_BLOCK elements: every
+// operation of the expression is applied to one block with the runtime dispatched SIMD kernels before the next block
+// is started, so intermediate results live in a few stack buffers in the L1 cache, nothing is allocated, and every
+// operand is read from memory once.
+//
+// Expressions refer to lvalue operands, which must outlive them; rvalue arrays are moved into the expression. Values
+// of real functions (abs, abs2, arg, real, imag) are complex numbers with zero imaginary part inside an expression,
+// and a real-valued expression converts to an AlignedVector of real numbers.
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Elements per block of an expression evaluation, small enough that the temporaries of an expression stay in the L1
+/// cache and large enough to amortize the kernel calls
+constexpr std::size_t EXPRESSION_BLOCK = 256;
+
+/// Number of scalars in one temporary block: real parts followed by imaginary parts
+constexpr std::size_t EXPRESSION_BLOCK_SCALARS = 2 * EXPRESSION_BLOCK;
+
+/// Base of the elementwise operations of an expression
+struct ElementwiseOperation {
+  /// Whether the result is real for every argument, its imaginary part is then zero
+  static constexpr bool REAL_RESULT = false;
+  /// Whether the result is real when all arguments are real
+  static constexpr bool PRESERVES_REAL = false;
+};
+
+/// Base class of the expression nodes. Derived classes provide
+///   std::size_t size() const                          number of elements
+///   static constexpr bool LEAF                        whether evaluate returns a view of existing memory
+///   static constexpr bool REAL                        whether the imaginary part of the values is zero
+///   static constexpr std::size_t BUFFERS              temporary blocks needed by evaluate
+///   SplitSpan<const T> evaluate(offset, count, out, scratch) const
+///                                                     values of the elements [offset, offset + count), computed
+///                                                     into out or returned as a view of the operand
+///   bool overlaps(SplitSpan<const T> memory) const    whether any operand shares memory with the view
+template <typename Derived, scalar T>
+class ComplexExpression {
+public:
+  using scalar_type = T;
+  using value_type = BasicComplex<T>;
+
+  /// Evaluates a real-valued expression
+  /// @return Real parts of the values
+  operator AlignedVector<T>() const  // NOLINT(google-explicit-constructor)
+    requires Derived::REAL;
+};
+
+/// Expression nodes: classes derived from ComplexExpression
+template <typename E>
+concept complexExpression =
+    requires { typename std::remove_cvref_t<E>::scalar_type; } &&
+    std::derived_from<std::remove_cvref_t<E>,
+                      ComplexExpression<std::remove_cvref_t<E>, typename std::remove_cvref_t<E>::scalar_type>>;
+
+/// @return View of a temporary block of count elements in scratch memory
+template <scalar T>
+SplitSpan<T> scratchBlock(T* scratch, const std::size_t count) {
+  return SplitSpan<T>(scratch, scratch + EXPRESSION_BLOCK, static_cast<size_t>(count));
+}
+
+/// @return Whether two split views share memory
+template <scalar T>
+bool overlaps(const SplitSpan<const T> a, const SplitSpan<const T> b) {
+  if (a.empty() || b.empty()) return false;
+  const std::less<const T*> less;
+  const auto intersect = [&](const T* p, const std::size_t m, const T* q, const std::size_t n) {
+    return less(p, q + n) && less(q, p + m);
+  };
+  return intersect(a.realData(), a.size(), b.realData(), b.size()) ||
+         intersect(a.realData(), a.size(), b.imagData(), b.size()) ||
+         intersect(a.imagData(), a.size(), b.realData(), b.size()) ||
+         intersect(a.imagData(), a.size(), b.imagData(), b.size());
+}
+
+/// Leaf referring to existing split memory, an array or a SplitSpan
+template <scalar T>
+class SplitSpanExpression : public ComplexExpression<SplitSpanExpression<T>, T> {
+protected:
+  SplitSpan<const T> m_Data;
+
+public:
+  static constexpr bool LEAF = true;
+  static constexpr bool REAL = false;
+  static constexpr std::size_t BUFFERS = 0;
+
+  explicit SplitSpanExpression(const SplitSpan<const T> data) : m_Data(data) {}
+
+  std::size_t size() const { return m_Data.size(); }
+  SplitSpan<const T> evaluate(const std::size_t offset, const std::size_t count, SplitSpan<T> /*out*/,
+                              T* /*scratch*/) const {
+    return m_Data.subspan(static_cast<size_t>(offset), static_cast<size_t>(count));
+  }
+  bool overlaps(const SplitSpan<const T> memory) const { return Math::overlaps<T>(m_Data, memory); }
+};
+
+/// Leaf owning an array that was passed to an operator as an rvalue
+/// @tparam A Array type with a view() that returns SplitSpan<const T>
+template <typename A>
+class ArrayValueExpression : public ComplexExpression<ArrayValueExpression<A>, typename A::value_type::value_type> {
+public:
+  using T = typename A::value_type::value_type;
+
+protected:
+  A m_Array;
+
+public:
+  static constexpr bool LEAF = true;
+  static constexpr bool REAL = false;
+  static constexpr std::size_t BUFFERS = 0;
+
+  explicit ArrayValueExpression(A&& array) : m_Array(std::move(array)) {}
+
+  std::size_t size() const { return m_Array.size(); }
+  SplitSpan<const T> evaluate(const std::size_t offset, const std::size_t count, SplitSpan<T> /*out*/,
+                              T* /*scratch*/) const {
+    return m_Array.view().subspan(static_cast<size_t>(offset), static_cast<size_t>(count));
+  }
+  bool overlaps(const SplitSpan<const T> memory) const { return Math::overlaps<T>(m_Array.view(), memory); }
+};
+
+/// Elementwise function of one expression
+/// @tparam Op ElementwiseOperation with static void apply(SplitSpan<const T> z, SplitSpan<T> out), out may alias z
+/// @tparam E Expression of the argument
+template <typename Op, typename E>
+class UnaryExpression : public ComplexExpression<UnaryExpression<Op, E>, typename E::scalar_type> {
+public:
+  using T = typename E::scalar_type;
+
+protected:
+  E m_Operand;
+
+public:
+  static constexpr bool LEAF = false;
+  static constexpr bool REAL = Op::REAL_RESULT || (Op::PRESERVES_REAL && E::REAL);
+  static constexpr std::size_t BUFFERS = E::BUFFERS;
+
+  explicit UnaryExpression(E operand) : m_Operand(std::move(operand)) {}
+
+  std::size_t size() const { return m_Operand.size(); }
+  SplitSpan<const T> evaluate(const std::size_t offset, const std::size_t count, const SplitSpan<T> out,
+                              T* scratch) const {
+    Op::apply(m_Operand.evaluate(offset, count, out, scratch), out);
+    return out;
+  }
+  bool overlaps(const SplitSpan<const T> memory) const { return m_Operand.overlaps(memory); }
+};
+
+/// Elementwise function of two operands, at least one of them an expression and the other one an expression, a
+/// complex number or a real number
+/// @tparam Op ElementwiseOperation with static void apply(lhs, rhs, SplitSpan<T> out) for the operand kinds, where
+/// expressions are passed as SplitSpan<const T> that out may alias
+template <typename Op, typename L, typename R>
+class BinaryExpression
+    : public ComplexExpression<BinaryExpression<Op, L, R>,
+                              typename std::conditional_t<complexExpression<L>, L, R>::scalar_type> {
+public:
+  using T = typename std::conditional_t<complexExpression<L>, L, R>::scalar_type;
+
+protected:
+  L m_Lhs;
+  R m_Rhs;
+
+  template <typename X>
+  static constexpr bool isReal() {
+    if constexpr (complexExpression<X>) {
+      return X::REAL;
+    } else {
+      return std::same_as<X, T>;
+    }
+  }
+
+  static constexpr std::size_t buffers() {
+    if constexpr (!complexExpression<L>) {
+      return R::BUFFERS;
+    } else if constexpr (!complexExpression<R>) {
+      return L::BUFFERS;
+    } else if constexpr (L::LEAF) {
+      return R::BUFFERS;
+    } else {
+      return std::max(L::BUFFERS, R::LEAF ? 0 : R::BUFFERS + 1);
+    }
+  }
+
+public:
+  static constexpr bool LEAF = false;
+  static constexpr bool REAL = Op::REAL_RESULT || (Op::PRESERVES_REAL && isReal<L>() && isReal<R>());
+  static constexpr std::size_t BUFFERS = buffers();
+
+  /// @throws std::invalid_argument If two expressions differ in size
+  BinaryExpression(L lhs, R rhs) : m_Lhs(std::move(lhs)), m_Rhs(std::move(rhs)) {
+    if constexpr (complexExpression<L> && complexExpression<R>) {
+      if (m_Lhs.size() != m_Rhs.size()) throw std::invalid_argument("ComplexArray: operands differ in size");
+    }
+  }
+
+  std::size_t size() const {
+    if constexpr (complexExpression<L>) {
+      return m_Lhs.size();
+    } else {
+      return m_Rhs.size();
+    }
+  }
+
+  SplitSpan<const T> evaluate(const std::size_t offset, const std::size_t count, const SplitSpan<T> out,
+                              T* scratch) const {
+    if constexpr (!complexExpression<L>) {
+      Op::apply(m_Lhs, m_Rhs.evaluate(offset, count, out, scratch), out);
+    } else if constexpr (!complexExpression<R>) {
+      Op::apply(m_Lhs.evaluate(offset, count, out, scratch), m_Rhs, out);
+    } else if constexpr (L::LEAF) {
+      // The right operand is computed in out, the left one is read from its memory
+      const SplitSpan<const T> rhs = m_Rhs.evaluate(offset, count, out, scratch);
+      Op::apply(m_Lhs.evaluate(offset, count, out, scratch), rhs, out);
+    } else if constexpr (R::LEAF) {
+      Op::apply(m_Lhs.evaluate(offset, count, out, scratch), m_Rhs.evaluate(offset, count, out, scratch), out);
+    } else {
+      // The left operand is computed in out, the right one in the first temporary block
+      const SplitSpan<const T> lhs = m_Lhs.evaluate(offset, count, out, scratch);
+      const SplitSpan<const T> rhs =
+          m_Rhs.evaluate(offset, count, scratchBlock(scratch, count), scratch + EXPRESSION_BLOCK_SCALARS);
+      Op::apply(lhs, rhs, out);
+    }
+    return out;
+  }
+
+  bool overlaps(const SplitSpan<const T> memory) const {
+    bool result = false;
+    if constexpr (complexExpression<L>) result = result || m_Lhs.overlaps(memory);
+    if constexpr (complexExpression<R>) result = result || m_Rhs.overlaps(memory);
+    return result;
+  }
+};
+
+/// Evaluates an expression block by block into temporary memory
+/// @param expression Expression
+/// @param f Called as f(offset, values) with the values of the elements [offset, offset + values.size())
+template <typename E, typename F>
+  requires complexExpression<E>
+void forEachBlock(const E& expression, F&& f) {
+  using T = typename E::scalar_type;
+  alignas(MEMORY_ALIGNMENT) T scratch[(E::BUFFERS + 1) * EXPRESSION_BLOCK_SCALARS];
+  for (std::size_t offset = 0; offset < expression.size(); offset += EXPRESSION_BLOCK) {
+    const std::size_t count = std::min(EXPRESSION_BLOCK, expression.size() - offset);
+    f(offset, expression.evaluate(offset, count, scratchBlock(scratch, count), scratch + EXPRESSION_BLOCK_SCALARS));
+  }
+}
+
+/// Evaluates an expression into split memory. The output may be an operand of the expression, the expression is then
+/// evaluated into temporary blocks that are copied to the output.
+/// @param expression Expression
+/// @param out Values, of the same size as the expression
+/// @throws std::invalid_argument If the sizes differ
+template <typename E>
+  requires complexExpression<E>
+void evaluate(const E& expression, const SplitSpan<typename E::scalar_type> out) {
+  using T = typename E::scalar_type;
+  if (expression.size() != out.size()) throw std::invalid_argument("ComplexArray: operands differ in size");
+  if (expression.overlaps(out)) {
+    forEachBlock(expression, [&](const std::size_t offset, const SplitSpan<const T> values) {
+      std::copy_n(values.realData(), values.size(), out.realData() + offset);
+      std::copy_n(values.imagData(), values.size(), out.imagData() + offset);
+    });
+    return;
+  }
+  alignas(MEMORY_ALIGNMENT) T scratch[E::BUFFERS == 0 ? 1 : E::BUFFERS * EXPRESSION_BLOCK_SCALARS];
+  for (std::size_t offset = 0; offset < out.size(); offset += EXPRESSION_BLOCK) {
+    const std::size_t count = std::min(EXPRESSION_BLOCK, out.size() - offset);
+    const SplitSpan<T> block = out.subspan(static_cast<size_t>(offset), static_cast<size_t>(count));
+    const SplitSpan<const T> values = expression.evaluate(offset, count, block, scratch);
+    if (values.realData() != block.realData()) {
+      std::copy_n(values.realData(), count, block.realData());
+      std::copy_n(values.imagData(), count, block.imagData());
+    }
+  }
+}
+
+/// Evaluates a real-valued expression
+/// @param expression Expression whose values have zero imaginary part
+/// @param out Real parts of the values, of the same size as the expression
+/// @throws std::invalid_argument If the sizes differ
+template <typename E>
+  requires(complexExpression<E> && E::REAL)
+void evaluate(const E& expression, const std::span<typename E::scalar_type> out) {
+  using T = typename E::scalar_type;
+  if (expression.size() != out.size()) throw std::invalid_argument("ComplexArray: operands differ in size");
+  forEachBlock(expression, [&](const std::size_t offset, const SplitSpan<const T> values) {
+    std::copy_n(values.realData(), values.size(), out.begin() + offset);
+  });
+}
+
+template <typename Derived, scalar T>
+ComplexExpression<Derived, T>::operator AlignedVector<T>() const
+  requires Derived::REAL
+{
+  const Derived& expression = static_cast<const Derived&>(*this);
+  AlignedVector<T> result(expression.size());
+  evaluate(expression, std::span<T>(result));
+  return result;
+}
+
+/// Wraps an expression operand, expressions are copied or moved
+template <typename E>
+  requires complexExpression<E>
+std::remove_cvref_t<E> toExpression(E&& expression) {
+  return std::forward<E>(expression);
+}
+
+/// Wraps a split view as an expression operand
+template <typename T>
+SplitSpanExpression<std::remove_const_t<T>> toExpression(const SplitSpan<T> z) {
+  return SplitSpanExpression<std::remove_const_t<T>>(z);
+}
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_EXPRESSION_H
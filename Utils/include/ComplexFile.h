@@ -0,0 +1,134 @@
+#ifndef MATH_COMPLEX_FILE_H
+#define MATH_COMPLEX_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <type_traits>
+
+#include "Complex.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Order of the complex numbers of a file in memory
+enum class ComplexLayout : uint8_t {
+  Interleaved,  ///< Real and imaginary part of every number next to each other, like std::span<BasicComplex<T>>
+  Split         ///< All real parts, then all imaginary parts, like SplitSpan<T>
+};
+
+/// Access to an opened complex file
+enum class FileAccess : uint8_t {
+  Read,      ///< The numbers can be read
+  ReadWrite  ///< The numbers can be changed and appended
+};
+
+/// Binary file of complex numbers that is mapped into memory, so the numbers are read and written in place through
+/// spans that the arithmetic, FFT and reduction functions take directly. The file starts with a header of HEADER_SIZE
+/// bytes, which are all zero except for
+///   offset  0  char[8]  magic "MATHCPLX"
+///   offset  8  uint16   format version, 1
+///   offset 10  uint8    size of a part in bytes, 4 for float, 8 for double, 16 for long double
+///   offset 11  uint8    layout, 0 interleaved, 1 split
+///   offset 12  uint8    byte order, 1 little endian, 2 big endian
+///   offset 16  uint64   number of complex numbers
+///   offset 24  uint64   capacity, the offset of the imaginary parts from the real parts of a split file
+/// and the integers are in the byte order of the file. The numbers follow the header, so they are aligned to
+/// MEMORY_ALIGNMENT bytes, and the capacity is a multiple of MEMORY_ALIGNMENT bytes for the same reason. A file of the
+/// other byte order is swapped in a private copy of the mapping when it is opened for reading. long double files are
+/// only portable between platforms with the same long double format. The file is not thread safe.
+template <scalar T>
+class BasicComplexFile {
+public:
+  /// Size of the header in bytes
+  static constexpr std::size_t HEADER_SIZE = 64;
+
+protected:
+  int m_Descriptor = -1;
+  std::byte* m_Mapping = nullptr;
+  std::size_t m_MappingSize = 0;
+  std::size_t m_Size = 0;
+  std::size_t m_Capacity = 0;
+  ComplexLayout m_Layout = ComplexLayout::Interleaved;
+  FileAccess m_Access = FileAccess::Read;
+
+  BasicComplexFile() = default;
+
+  [[nodiscard]] T* real() const;
+  [[nodiscard]] T* imag() const;
+  void checkWritable() const;
+  void checkLayout(ComplexLayout layout) const;
+  void map(std::size_t bytes);
+  void reserve(std::size_t capacity);
+  void writeHeader();
+  void close();
+
+public:
+  BasicComplexFile(const BasicComplexFile&) = delete;
+  BasicComplexFile& operator=(const BasicComplexFile&) = delete;
+  BasicComplexFile(BasicComplexFile&& other) noexcept;
+  BasicComplexFile& operator=(BasicComplexFile&& other) noexcept;
+
+  /// Writes the header, trims the unused capacity and unmaps the file
+  ~BasicComplexFile();
+
+  /// Opens an existing file
+  /// @param path Path of the file
+  /// @param access Read, or read and write
+  /// @return Mapped file
+  static BasicComplexFile open(const std::filesystem::path& path, FileAccess access = FileAccess::Read);
+
+  /// Creates an empty file for reading and writing, replacing an existing one
+  /// @param path Path of the file
+  /// @param layout Order of the numbers
+  /// @param capacity Numbers for which space is reserved, so that appending them does not move the mapping
+  /// @return Mapped file
+  static BasicComplexFile create(const std::filesystem::path& path, ComplexLayout layout, std::size_t capacity = 0);
+
+  /// @return Number of complex numbers
+  [[nodiscard]] std::size_t size() const { return m_Size; }
+  /// @return Numbers that fit into the file before it grows
+  [[nodiscard]] std::size_t capacity() const { return m_Capacity; }
+  [[nodiscard]] ComplexLayout layout() const { return m_Layout; }
+  [[nodiscard]] FileAccess access() const { return m_Access; }
+
+  /// @return Numbers of a split file. Spans are valid until the file grows or is closed.
+  [[nodiscard]] SplitSpan<const T> split() const;
+  /// @return Numbers of a split file that was opened for writing
+  [[nodiscard]] SplitSpan<T> split();
+
+  /// Numbers of a split file, for files with more numbers than a SplitSpan holds
+  /// @param offset Index of the first number
+  /// @param count Number of numbers
+  /// @return Numbers offset to offset + count
+  [[nodiscard]] SplitSpan<const T> split(std::size_t offset, std::size_t count) const;
+  /// Numbers of a split file that was opened for writing, for files with more numbers than a SplitSpan holds
+  /// @param offset Index of the first number
+  /// @param count Number of numbers
+  /// @return Numbers offset to offset + count
+  [[nodiscard]] SplitSpan<T> split(std::size_t offset, std::size_t count);
+
+  /// @return Numbers of an interleaved file. Spans are valid until the file grows or is closed.
+  [[nodiscard]] std::span<const BasicComplex<T>> interleaved() const;
+  /// @return Numbers of an interleaved file that was opened for writing
+  [[nodiscard]] std::span<BasicComplex<T>> interleaved();
+
+  /// Appends numbers, growing the file geometrically when its capacity is exhausted
+  /// @param z Numbers, in either layout
+  void append(std::type_identity_t<SplitSpan<const T>> z);
+
+  /// Appends numbers, growing the file geometrically when its capacity is exhausted
+  /// @param z Interleaved numbers, in either layout
+  void append(std::type_identity_t<std::span<const BasicComplex<T>>> z);
+
+  /// Writes the header and the numbers to the disk
+  void flush();
+};
+
+using ComplexFile = BasicComplexFile<real_t>;
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_FILE_H
@@ -0,0 +1,123 @@
+#ifndef MATH_COMPLEX_FORMAT_H
+#define MATH_COMPLEX_FORMAT_H
+
+#include <charconv>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Upper bound of the characters that the bulk to_chars writes for count complex numbers
+/// @param count Number of complex numbers
+/// @return Buffer size that is always large enough
+template <scalar T>
+constexpr std::size_t formattedSize(const std::size_t count) {
+  return count * (COMPLEX_CHARS_MAX<T> + 1);
+}
+
+/// Writes complex numbers as text, each one as by to_chars and followed by a separator
+/// @param first Start of the buffer
+/// @param last End of the buffer, formattedSize<T>(z.size()) characters are always enough
+/// @param z Complex numbers
+/// @param separator Character after every number
+/// @return End of the text, or errc::value_too_large with ptr == last if the buffer is too small
+template <scalar T>
+std::to_chars_result to_chars(char* first, char* last, std::type_identity_t<SplitSpan<const T>> z,
+                              char separator = '\n');
+
+/// Writes complex numbers as text, each one as by to_chars and followed by a separator
+/// @param first Start of the buffer
+/// @param last End of the buffer, formattedSize<T>(z.size()) characters are always enough
+/// @param z Interleaved complex numbers
+/// @param separator Character after every number
+/// @return End of the text, or errc::value_too_large with ptr == last if the buffer is too small
+template <scalar T>
+std::to_chars_result to_chars(char* first, char* last, std::type_identity_t<std::span<const BasicComplex<T>>> z,
+                              char separator = '\n');
+
+/// Writes complex numbers to a stream, each one as by to_chars and followed by a separator. The text is formatted
+/// into a buffer on the stack and handed to the stream in large blocks, so a file is written at I/O speed.
+/// @param os Output stream
+/// @param z Complex numbers
+/// @param separator Character after every number
+template <scalar T>
+void write(std::ostream& os, std::type_identity_t<SplitSpan<const T>> z, char separator = '\n');
+
+/// Writes complex numbers to a stream, each one as by to_chars and followed by a separator. The text is formatted
+/// into a buffer on the stack and handed to the stream in large blocks, so a file is written at I/O speed.
+/// @param os Output stream
+/// @param z Interleaved complex numbers
+/// @param separator Character after every number
+template <scalar T>
+void write(std::ostream& os, std::type_identity_t<std::span<const BasicComplex<T>>> z, char separator = '\n');
+
+/// Result of reading complex numbers from a buffer
+struct ParseResult {
+  /// Where reading stopped: past the separators after the last number, or at the number that could not be read
+  const char* ptr;
+  /// Numbers that were read
+  std::size_t count;
+  /// errc() if the text ended or the output is full, the error of from_chars otherwise
+  std::errc ec;
+};
+
+/// Result of reading complex numbers from a stream
+struct ReadResult {
+  /// Numbers that were appended
+  std::size_t count;
+  /// Characters read, or offset of the number that could not be read, from where the stream was
+  std::size_t position;
+  /// errc() if the stream ended, the error of from_chars otherwise
+  std::errc ec;
+};
+
+/// Reads complex numbers in the forms of from_chars, separated by blanks, line breaks, ',' or ';'. Errors are
+/// reported, not thrown.
+/// @param first Start of the text
+/// @param last End of the text
+/// @param z Complex numbers, read until the text ends or z is full
+/// @return Where reading stopped, numbers read and error
+template <scalar T>
+ParseResult from_chars(const char* first, const char* last, std::type_identity_t<SplitSpan<T>> z);
+
+/// Reads complex numbers in the forms of from_chars, separated by blanks, line breaks, ',' or ';'. Errors are
+/// reported, not thrown.
+/// @param first Start of the text
+/// @param last End of the text
+/// @param z Interleaved complex numbers, read until the text ends or z is full
+/// @return Where reading stopped, numbers read and error
+template <scalar T>
+ParseResult from_chars(const char* first, const char* last, std::type_identity_t<std::span<BasicComplex<T>>> z);
+
+/// Reads complex numbers from a stream until it ends and appends them to an array, see from_chars. The stream is
+/// read in large chunks that are cut between numbers, and every chunk is parsed straight into the array. Errors are
+/// reported, not thrown, the numbers before the error are appended.
+/// @param is Input stream
+/// @param out Array to append to
+/// @return Numbers appended, position and error
+/// @throws std::length_error If the array would exceed MAX_ELEMENT_COUNT
+template <scalar T>
+ReadResult read(std::istream& is, BasicComplexArray<T>& out);
+
+/// Reads complex numbers from a stream until it ends and appends them to a vector, see from_chars. The stream is
+/// read in large chunks that are cut between numbers, and every chunk is parsed straight into the vector. Errors are
+/// reported, not thrown, the numbers before the error are appended.
+/// @param is Input stream
+/// @param out Vector to append to
+/// @return Numbers appended, position and error
+template <scalar T>
+ReadResult read(std::istream& is, std::vector<BasicComplex<T>>& out);
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_FORMAT_H
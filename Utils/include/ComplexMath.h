@@ -0,0 +1,266 @@
+#ifndef MATH_COMPLEX_MATH_H
+#define MATH_COMPLEX_MATH_H
+
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "Types.h"
+
+namespace Math {
+
+// Batch versions of the elementary functions in Complex.h. They evaluate SIMD polynomial approximations with the
+// widest instruction set available at runtime (see SimdMath.h for the error bounds of the real primitives); results
+// agree with the scalar functions to a few ULP away from branch cuts and singularities. The output may alias the
+// input, all spans must have the same size.
+
+template <scalar T>
+void exp(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void log(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void sin(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void cos(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void tan(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void asin(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void acos(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void atan(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void sqrt(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out);
+template <scalar T>
+void pow(std::type_identity_t<SplitSpan<const T>> z, std::type_identity_t<T> w, SplitSpan<T> out);
+template <scalar T>
+void pow(std::type_identity_t<SplitSpan<const T>> z, const BasicComplex<T>& w, SplitSpan<T> out);
+template <scalar T>
+void pow(std::type_identity_t<SplitSpan<const T>> z, std::type_identity_t<SplitSpan<const T>> w, SplitSpan<T> out);
+
+// Interleaved versions, the input is converted to split form in small blocks on the stack.
+
+template <scalar T>
+void exp(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void log(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void sin(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void cos(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void tan(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void asin(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void acos(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void atan(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void sqrt(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void pow(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::type_identity_t<T> w,
+         std::span<BasicComplex<T>> out);
+template <scalar T>
+void pow(std::type_identity_t<std::span<const BasicComplex<T>>> z, const BasicComplex<T>& w,
+         std::span<BasicComplex<T>> out);
+template <scalar T>
+void pow(std::type_identity_t<std::span<const BasicComplex<T>>> z,
+         std::type_identity_t<std::span<const BasicComplex<T>>> w, std::span<BasicComplex<T>> out);
+
+// Power sequences, written to the whole output span. They are generated in blocks of the same size as the
+// interleaved conversion: every block is the first one, the powers of the ratio, times an anchor power. The first
+// block and the anchors are evaluated in long double and the anchors are recomputed from the exact power every few
+// blocks. An element therefore costs one complex multiplication, and its error grows with the index only at the rate
+// of long double rounding, a few ulp of double for 10^4 elements instead of up to one ulp per element.
+
+template <scalar T>
+void powers(const BasicComplex<T>& z, SplitSpan<T> out);
+template <scalar T>
+void geometric(const BasicComplex<T>& start, const BasicComplex<T>& ratio, SplitSpan<T> out);
+template <scalar T>
+void phasors(std::type_identity_t<T> phase, std::type_identity_t<T> frequency, SplitSpan<T> out);
+template <scalar T>
+void powers(const BasicComplex<T>& z, std::span<BasicComplex<T>> out);
+template <scalar T>
+void geometric(const BasicComplex<T>& start, const BasicComplex<T>& ratio, std::span<BasicComplex<T>> out);
+template <scalar T>
+void phasors(std::type_identity_t<T> phase, std::type_identity_t<T> frequency, std::span<BasicComplex<T>> out);
+
+// Elementwise operations of the expressions on arrays (see ComplexExpression.h), forwarding to the batch functions
+
+struct ExpOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    exp<T>(z, out);
+  }
+};
+
+struct LogOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    log<T>(z, out);
+  }
+};
+
+struct SinOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    sin<T>(z, out);
+  }
+};
+
+struct CosOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    cos<T>(z, out);
+  }
+};
+
+struct TanOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    tan<T>(z, out);
+  }
+};
+
+struct AsinOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    asin<T>(z, out);
+  }
+};
+
+struct AcosOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    acos<T>(z, out);
+  }
+};
+
+struct AtanOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    atan<T>(z, out);
+  }
+};
+
+struct SqrtOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<T> out) {
+    sqrt<T>(z, out);
+  }
+};
+
+struct PowOperation : ElementwiseOperation {
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const std::type_identity_t<T> w, const SplitSpan<T> out) {
+    pow<T>(z, w, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const BasicComplex<T>& w, const SplitSpan<T> out) {
+    pow<T>(z, w, out);
+  }
+  template <scalar T>
+  static void apply(const SplitSpan<const T> z, const SplitSpan<const T> w, const SplitSpan<T> out) {
+    pow<T>(z, w, out);
+  }
+};
+
+/// Computes the exponential map of all elements
+/// @param z Array operand
+/// @return Expression of the exponentials
+template <typename X>
+  requires arrayOperand<X>
+auto exp(X&& z) {
+  return unaryExpression<ExpOperation>(std::forward<X>(z));
+}
+
+/// Computes the logarithmic map of all elements
+/// @param z Array operand
+/// @return Expression of the logarithms
+template <typename X>
+  requires arrayOperand<X>
+auto log(X&& z) {
+  return unaryExpression<LogOperation>(std::forward<X>(z));
+}
+
+/// Computes the sine of all elements
+/// @param z Array operand
+/// @return Expression of the sines
+template <typename X>
+  requires arrayOperand<X>
+auto sin(X&& z) {
+  return unaryExpression<SinOperation>(std::forward<X>(z));
+}
+
+/// Computes the cosine of all elements
+/// @param z Array operand
+/// @return Expression of the cosines
+template <typename X>
+  requires arrayOperand<X>
+auto cos(X&& z) {
+  return unaryExpression<CosOperation>(std::forward<X>(z));
+}
+
+/// Computes the tangent of all elements
+/// @param z Array operand
+/// @return Expression of the tangents
+template <typename X>
+  requires arrayOperand<X>
+auto tan(X&& z) {
+  return unaryExpression<TanOperation>(std::forward<X>(z));
+}
+
+/// Computes the arc-sine of all elements
+/// @param z Array operand
+/// @return Expression of the arc-sines
+template <typename X>
+  requires arrayOperand<X>
+auto asin(X&& z) {
+  return unaryExpression<AsinOperation>(std::forward<X>(z));
+}
+
+/// Computes the arc-cosine of all elements
+/// @param z Array operand
+/// @return Expression of the arc-cosines
+template <typename X>
+  requires arrayOperand<X>
+auto acos(X&& z) {
+  return unaryExpression<AcosOperation>(std::forward<X>(z));
+}
+
+/// Computes the arc-tangent of all elements
+/// @param z Array operand
+/// @return Expression of the arc-tangents
+template <typename X>
+  requires arrayOperand<X>
+auto atan(X&& z) {
+  return unaryExpression<AtanOperation>(std::forward<X>(z));
+}
+
+/// Computes the square root of all elements
+/// @param z Array operand
+/// @return Expression of the square roots
+template <typename X>
+  requires arrayOperand<X>
+auto sqrt(X&& z) {
+  return unaryExpression<SqrtOperation>(std::forward<X>(z));
+}
+
+/// Raises all elements to a real or complex power, or to the powers in another array operand
+/// @param z Bases
+/// @param w Exponent, or array operand of exponents of the same size
+/// @return Expression of the powers
+template <typename X, typename W>
+  requires(arrayOperand<X> && complexOperands<X, W>)
+auto pow(X&& z, W&& w) {
+  return binaryExpression<PowOperation>(std::forward<X>(z), std::forward<W>(w));
+}
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_MATH_H
@@ -0,0 +1,245 @@
+#ifndef MATH_COMPLEX_MATRIX_H
+#define MATH_COMPLEX_MATRIX_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Order in which the elements of a matrix are stored
+enum class MatrixLayout : uint8_t {
+  RowMajor,    ///< Rows are contiguous
+  ColumnMajor  ///< Columns are contiguous
+};
+
+/// Non-owning view of a matrix of interleaved complex numbers with arbitrary strides, element (i, j) is at
+/// data[i * rowStride + j * colStride]. Views of submatrices and transposes share the memory of the matrix.
+/// T may be const-qualified for read-only views.
+template <typename T>
+  requires scalar<std::remove_const_t<T>>
+class ComplexMatrixView {
+public:
+  using value_type = BasicComplex<std::remove_const_t<T>>;
+  using element_type = std::conditional_t<std::is_const_v<T>, const value_type, value_type>;
+
+protected:
+  element_type* m_Data = nullptr;
+  size_t m_Rows = 0;
+  size_t m_Cols = 0;
+  index_t m_RowStride = 0;
+  index_t m_ColStride = 0;
+
+public:
+  constexpr ComplexMatrixView() = default;
+
+  /// Create a view of strided memory
+  /// @param data Element (0, 0)
+  /// @param rows Number of rows
+  /// @param cols Number of columns
+  /// @param rowStride Distance between two rows in elements
+  /// @param colStride Distance between two columns in elements
+  constexpr ComplexMatrixView(element_type* data, const size_t rows, const size_t cols, const index_t rowStride,
+                              const index_t colStride)
+      : m_Data(data), m_Rows(rows), m_Cols(cols), m_RowStride(rowStride), m_ColStride(colStride) {}
+
+  /// Converts a mutable view into a read-only view
+  template <typename U>
+    requires(std::is_const_v<T> && std::same_as<const U, T>)
+  constexpr ComplexMatrixView(const ComplexMatrixView<U>& other)  // NOLINT(google-explicit-constructor)
+      : m_Data(other.data()),
+        m_Rows(other.rows()),
+        m_Cols(other.cols()),
+        m_RowStride(other.rowStride()),
+        m_ColStride(other.colStride()) {}
+
+  constexpr element_type* data() const { return m_Data; }
+  constexpr size_t rows() const { return m_Rows; }
+  constexpr size_t cols() const { return m_Cols; }
+  constexpr index_t rowStride() const { return m_RowStride; }
+  constexpr index_t colStride() const { return m_ColStride; }
+  constexpr bool empty() const { return m_Rows == 0 || m_Cols == 0; }
+
+  /// Get the element in row i and column j
+  /// @param i Row index
+  /// @param j Column index
+  /// @return Reference to the element
+  constexpr element_type& operator()(const size_t i, const size_t j) const {
+    return m_Data[static_cast<index_t>(i) * m_RowStride + static_cast<index_t>(j) * m_ColStride];
+  }
+
+  /// Get a view of a block of the matrix
+  /// @param row First row of the block
+  /// @param col First column of the block
+  /// @param rows Number of rows of the block
+  /// @param cols Number of columns of the block
+  /// @return View of the rows [row, row + rows) and columns [col, col + cols)
+  ComplexMatrixView submatrix(const size_t row, const size_t col, const size_t rows, const size_t cols) const {
+    if (std::size_t(row) + rows > m_Rows || std::size_t(col) + cols > m_Cols) {
+      throw std::invalid_argument("ComplexMatrixView: submatrix exceeds the matrix");
+    }
+    return ComplexMatrixView(rows == 0 || cols == 0 ? m_Data : &(*this)(row, col), rows, cols, m_RowStride,
+                             m_ColStride);
+  }
+
+  /// @return View of the transposed matrix, without copying the elements
+  constexpr ComplexMatrixView transposed() const {
+    return ComplexMatrixView(m_Data, m_Cols, m_Rows, m_ColStride, m_RowStride);
+  }
+};
+
+/// Owning dense matrix of complex numbers in row-major or column-major order. The elements are interleaved
+/// BasicComplex values in one cache line aligned buffer.
+template <scalar T>
+class BasicComplexMatrix {
+public:
+  using value_type = BasicComplex<T>;
+  using allocator_type = AlignedAllocator<value_type>;
+
+protected:
+  AlignedVector<value_type> m_Data;
+  size_t m_Rows = 0;
+  size_t m_Cols = 0;
+  MatrixLayout m_Layout = MatrixLayout::RowMajor;
+
+  static std::size_t checkedSize(const size_t rows, const size_t cols) {
+    const std::size_t size = std::size_t(rows) * cols;
+    if (size > MAX_ELEMENT_COUNT) throw std::length_error("ComplexMatrix: size exceeds MAX_ELEMENT_COUNT");
+    return size;
+  }
+
+public:
+  /// Default constructor: creates an empty matrix
+  BasicComplexMatrix() = default;
+
+  /// Create a matrix of zeros
+  /// @param rows Number of rows
+  /// @param cols Number of columns
+  /// @param layout Storage order
+  /// @param allocator Allocator of the elements, e.g. a pointer to an ArenaResource
+  BasicComplexMatrix(const size_t rows, const size_t cols, const MatrixLayout layout = MatrixLayout::RowMajor,
+                     const allocator_type& allocator = allocator_type())
+      : m_Data(checkedSize(rows, cols), allocator), m_Rows(rows), m_Cols(cols), m_Layout(layout) {}
+
+  /// Create a matrix from a list of rows
+  /// @param rows Rows of equal length
+  /// @param layout Storage order
+  BasicComplexMatrix(const std::initializer_list<std::initializer_list<value_type>> rows,
+                     const MatrixLayout layout = MatrixLayout::RowMajor)
+      : BasicComplexMatrix(static_cast<size_t>(rows.size()),
+                           rows.size() == 0 ? 0 : static_cast<size_t>(rows.begin()->size()), layout) {
+    size_t i = 0;
+    for (const std::initializer_list<value_type>& row : rows) {
+      if (row.size() != m_Cols) throw std::invalid_argument("ComplexMatrix: rows differ in length");
+      size_t j = 0;
+      for (const value_type& z : row) (*this)(i, j++) = z;
+      ++i;
+    }
+  }
+
+  /// Create a copy of a view
+  /// @param view Elements
+  /// @param layout Storage order
+  explicit BasicComplexMatrix(const ComplexMatrixView<const T> view, const MatrixLayout layout = MatrixLayout::RowMajor)
+      : BasicComplexMatrix(view.rows(), view.cols(), layout) {
+    // In storage order, so that the writes are contiguous
+    if (layout == MatrixLayout::ColumnMajor) {
+      for (size_t j = 0; j < m_Cols; ++j) {
+        for (size_t i = 0; i < m_Rows; ++i) m_Data[std::size_t(j) * m_Rows + i] = view(i, j);
+      }
+      return;
+    }
+    for (size_t i = 0; i < m_Rows; ++i) {
+      for (size_t j = 0; j < m_Cols; ++j) m_Data[std::size_t(i) * m_Cols + j] = view(i, j);
+    }
+  }
+
+  /// Create an identity matrix
+  /// @param size Number of rows and columns
+  /// @param layout Storage order
+  /// @return Matrix with ones on the diagonal
+  static BasicComplexMatrix identity(const size_t size, const MatrixLayout layout = MatrixLayout::RowMajor) {
+    BasicComplexMatrix result(size, size, layout);
+    for (size_t i = 0; i < size; ++i) result(i, i) = value_type(1, 0);
+    return result;
+  }
+
+  size_t rows() const { return m_Rows; }
+  size_t cols() const { return m_Cols; }
+  std::size_t size() const { return m_Data.size(); }
+  bool empty() const { return m_Data.empty(); }
+  MatrixLayout layout() const { return m_Layout; }
+  allocator_type get_allocator() const { return m_Data.get_allocator(); }
+  value_type* data() { return m_Data.data(); }
+  const value_type* data() const { return m_Data.data(); }
+
+  /// @return Distance between two rows in elements
+  index_t rowStride() const { return m_Layout == MatrixLayout::RowMajor ? m_Cols : 1; }
+  /// @return Distance between two columns in elements
+  index_t colStride() const { return m_Layout == MatrixLayout::RowMajor ? 1 : m_Rows; }
+
+  value_type& operator()(const size_t i, const size_t j) { return m_Data[i * rowStride() + j * colStride()]; }
+  const value_type& operator()(const size_t i, const size_t j) const {
+    return m_Data[i * rowStride() + j * colStride()];
+  }
+
+  ComplexMatrixView<T> view() { return ComplexMatrixView<T>(data(), m_Rows, m_Cols, rowStride(), colStride()); }
+  ComplexMatrixView<const T> view() const {
+    return ComplexMatrixView<const T>(data(), m_Rows, m_Cols, rowStride(), colStride());
+  }
+  operator ComplexMatrixView<T>() { return view(); }              // NOLINT(google-explicit-constructor)
+  operator ComplexMatrixView<const T>() const { return view(); }  // NOLINT(google-explicit-constructor)
+
+  /// Get a view of a block of the matrix
+  /// @param row First row of the block
+  /// @param col First column of the block
+  /// @param rows Number of rows of the block
+  /// @param cols Number of columns of the block
+  /// @return View of the rows [row, row + rows) and columns [col, col + cols)
+  ComplexMatrixView<T> submatrix(const size_t row, const size_t col, const size_t rows, const size_t cols) {
+    return view().submatrix(row, col, rows, cols);
+  }
+  ComplexMatrixView<const T> submatrix(const size_t row, const size_t col, const size_t rows,
+                                       const size_t cols) const {
+    return view().submatrix(row, col, rows, cols);
+  }
+};
+
+using ComplexMatrix = BasicComplexMatrix<real_t>;
+
+/// General matrix product c = alpha a b + beta c. The product is computed in cache blocks: panels of b (kc x nc) and
+/// blocks of a (mc x kc) are packed into contiguous split real and imaginary buffers, and a SIMD micro-kernel
+/// accumulates register tiles of c from them. Blocks of rows of c are distributed over the threads of the pool.
+/// When beta is zero, c is overwritten without being read. In mixed precision, float operands are packed as double and
+/// the products of a panel of depth kc are accumulated in double before they are added to c.
+/// @param alpha Factor of the product
+/// @param a Left factor, m x k
+/// @param b Right factor, k x n
+/// @param beta Factor of c
+/// @param c Result, m x n, must not overlap a or b
+/// @param pool Threads that compute blocks of the product
+template <scalar T>
+void gemm(const BasicComplex<T>& alpha, std::type_identity_t<ComplexMatrixView<const T>> a,
+          std::type_identity_t<ComplexMatrixView<const T>> b, const BasicComplex<T>& beta,
+          std::type_identity_t<ComplexMatrixView<T>> c, ThreadPool& pool = defaultThreadPool());
+
+/// Computes the matrix product a b
+/// @param a Left factor, m x k
+/// @param b Right factor, k x n
+/// @return Row-major m x n product
+template <scalar T>
+BasicComplexMatrix<T> operator*(const BasicComplexMatrix<T>& a, const BasicComplexMatrix<T>& b) {
+  BasicComplexMatrix<T> result(a.rows(), b.cols());
+  gemm(BasicComplex<T>(1, 0), a, b, BasicComplex<T>(0, 0), result);
+  return result;
+}
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_MATRIX_H
@@ -0,0 +1,73 @@
+#ifndef MATH_COMPLEX_REDUCTION_H
+#define MATH_COMPLEX_REDUCTION_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Complex.h"
+#include "SplitSpan.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace Math {
+
+// Reductions of split complex arrays. The SIMD kernels keep the rounding errors of every lane in compensated sums
+// (TwoSum, and the errors of the products where the instruction set has a fused multiply-add), so the results are
+// about as accurate as sums in twice the working precision, and the chunk results are combined in accumulator_t<T>.
+// Arrays of more than REDUCTION_GRAIN elements are reduced in parallel in chunks of exactly REDUCTION_GRAIN
+// elements that are combined in index order, so a result does not depend on the number of threads.
+
+/// Number of elements per chunk of a parallel reduction
+constexpr std::size_t REDUCTION_GRAIN = std::size_t(1) << 15;
+
+/// @param z Complex numbers
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Sum of the elements
+template <scalar T>
+BasicComplex<T> sum(std::type_identity_t<SplitSpan<const T>> z, ThreadPool& pool = defaultThreadPool());
+
+/// Unconjugated dot product, the sum of x[i] * y[i]
+/// @param x Complex numbers
+/// @param y Complex numbers of the same size
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Dot product
+template <scalar T>
+BasicComplex<T> dotu(std::type_identity_t<SplitSpan<const T>> x, std::type_identity_t<SplitSpan<const T>> y,
+                     ThreadPool& pool = defaultThreadPool());
+
+/// Conjugated dot product, the sum of conj(x[i]) * y[i]
+/// @param x Complex numbers
+/// @param y Complex numbers of the same size
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Dot product
+template <scalar T>
+BasicComplex<T> dotc(std::type_identity_t<SplitSpan<const T>> x, std::type_identity_t<SplitSpan<const T>> y,
+                     ThreadPool& pool = defaultThreadPool());
+
+/// @param z Complex numbers
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Sum of abs2(z[i]), the squared Euclidean norm
+template <scalar T>
+T squaredNorm(std::type_identity_t<SplitSpan<const T>> z, ThreadPool& pool = defaultThreadPool());
+
+/// @param z Complex numbers
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Index of the first element of largest magnitude, NaN is skipped; 0 if z is empty or all NaN
+template <scalar T>
+size_t maxAbsIndex(std::type_identity_t<SplitSpan<const T>> z, ThreadPool& pool = defaultThreadPool());
+
+/// Dot products of the taps with sliding windows of x, out[i * outStride] = sum of taps[k] * x[i * inStride + k] for
+/// the elements of out at multiples of outStride. With reversed taps this is the direct form of an FIR filter; the
+/// windows are vectorized with plain multiply-adds, without compensation.
+/// @param x Complex numbers, at least (count - 1) * inStride + taps.size() of them for count outputs
+/// @param taps Factors of a window
+/// @param out Results
+/// @param inStride Distance between the windows of consecutive outputs, at least 1
+/// @param outStride Distance between consecutive outputs, at least 1
+template <scalar T>
+void slidingDot(std::type_identity_t<SplitSpan<const T>> x, std::type_identity_t<SplitSpan<const T>> taps,
+                SplitSpan<T> out, std::size_t inStride = 1, std::size_t outStride = 1);
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_REDUCTION_H
@@ -0,0 +1,287 @@
+#ifndef MATH_COMPLEX_SPARSE_H
+#define MATH_COMPLEX_SPARSE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "ComplexMatrix.h"
+#include "SplitSpan.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace Math {
+
+// Sparse complex matrices whose memory is proportional to the number of stored elements: the values are split into
+// real and imaginary parts like BasicComplexArray, with one 32-bit index per element, or per block, and one offset
+// per row or column. Products with vectors read the values and indices once, so they are limited by the memory
+// bandwidth. They run in parallel over chunks of about SPARSE_GRAIN elements, and the SIMD kernels gather the
+// elements of x, or scatter into y for the products that run across the compressed rows or columns. Those keep a
+// partial y per thread that is summed at the end, so their rounding can depend on the number of threads. The partial
+// vectors are limited to SPARSE_PARTIAL_RATIO elements per stored element and reused by the calling thread.
+// Dimensions are limited to MAX_ELEMENT_COUNT, like the vectors that the matrices multiply.
+
+/// Stored elements, plus one per row, per chunk of a parallel product with a sparse matrix
+constexpr std::size_t SPARSE_GRAIN = std::size_t(1) << 14;
+
+/// Elements of the partial vectors of a product that scatters into y, per stored element of the matrix
+constexpr std::size_t SPARSE_PARTIAL_RATIO = 2;
+
+/// Operator applied to a sparse matrix in a product with a vector
+enum class SparseOperation : uint8_t {
+  None,       ///< y = A x
+  Transpose,  ///< y = A^T x
+  Adjoint     ///< y = A^H x
+};
+
+/// Element of a sparse matrix in coordinate form
+template <scalar T>
+struct SparseEntry {
+  size_t row;
+  size_t col;
+  BasicComplex<T> value;
+};
+
+template <scalar T>
+class BasicCscMatrix;
+
+/// Compressed sparse row (CSR) matrix: the elements of each row with their columns, which are increasing and
+/// distinct within a row. Products with the matrix gather the elements of x; products with its transpose or adjoint
+/// scatter into y, so convert to CSC for many of those.
+template <scalar T>
+class BasicCsrMatrix {
+protected:
+  size_t m_Rows = 0;
+  size_t m_Cols = 0;
+  /// Row i has the elements [m_Offsets[i], m_Offsets[i + 1])
+  std::vector<size_t> m_Offsets = {0};
+  /// Column of every element
+  std::vector<size_t> m_Indices;
+  AlignedVector<T> m_Real;
+  AlignedVector<T> m_Imag;
+
+public:
+  using scalar_type = T;
+
+  /// Default constructor: creates an empty 0 x 0 matrix
+  BasicCsrMatrix() = default;
+
+  /// Create a matrix from its elements in any order, the values of duplicates are added
+  /// @param rows Number of rows
+  /// @param cols Number of columns
+  /// @param entries Elements inside the matrix
+  BasicCsrMatrix(size_t rows, size_t cols, std::span<const SparseEntry<T>> entries);
+
+  /// Create a matrix from the nonzero elements of a dense matrix
+  /// @param a Dense matrix
+  explicit BasicCsrMatrix(std::type_identity_t<ComplexMatrixView<const T>> a);
+
+  /// Create a matrix from compressed rows
+  /// @param rows Number of rows
+  /// @param cols Number of columns
+  /// @param offsets rows + 1 nondecreasing offsets from 0 to the number of elements, row i has [offsets[i],
+  /// offsets[i + 1])
+  /// @param indices Column of every element, increasing within a row
+  /// @param real Real parts of the elements
+  /// @param imag Imaginary parts of the elements
+  BasicCsrMatrix(size_t rows, size_t cols, std::vector<size_t> offsets, std::vector<size_t> indices,
+                 AlignedVector<T> real, AlignedVector<T> imag);
+
+  [[nodiscard]] size_t rows() const { return m_Rows; }
+  [[nodiscard]] size_t cols() const { return m_Cols; }
+  /// @return Number of stored elements
+  [[nodiscard]] size_t nonZeros() const { return static_cast<size_t>(m_Indices.size()); }
+  [[nodiscard]] std::span<const size_t> offsets() const { return m_Offsets; }
+  [[nodiscard]] std::span<const size_t> indices() const { return m_Indices; }
+  [[nodiscard]] SplitSpan<const T> values() const { return {m_Real.data(), m_Imag.data(), nonZeros()}; }
+
+  /// @return Copy in compressed columns
+  [[nodiscard]] BasicCscMatrix<T> toCsc() const;
+
+  /// @return Dense copy, row-major
+  [[nodiscard]] BasicComplexMatrix<T> toDense() const;
+
+  /// Multiplies a vector by the matrix, its transpose or its adjoint
+  /// @param x Vector of cols() elements, rows() for the transpose and the adjoint
+  /// @param y Product of rows() elements, cols() for the transpose and the adjoint, must not overlap x
+  /// @param operation Operator applied to the matrix
+  /// @param pool Threads that compute chunks of the product
+  void multiply(std::type_identity_t<SplitSpan<const T>> x, SplitSpan<T> y,
+                SparseOperation operation = SparseOperation::None, ThreadPool& pool = defaultThreadPool()) const;
+};
+
+/// Compressed sparse column (CSC) matrix: the elements of each column with their rows, which are increasing and
+/// distinct within a column. Products with the transpose or the adjoint gather the elements of x; products with the
+/// matrix scatter into y, so convert to CSR for many of those.
+template <scalar T>
+class BasicCscMatrix {
+protected:
+  size_t m_Rows = 0;
+  size_t m_Cols = 0;
+  /// Column j has the elements [m_Offsets[j], m_Offsets[j + 1])
+  std::vector<size_t> m_Offsets = {0};
+  /// Row of every element
+  std::vector<size_t> m_Indices;
+  AlignedVector<T> m_Real;
+  AlignedVector<T> m_Imag;
+
+public:
+  using scalar_type = T;
+
+  /// Default constructor: creates an empty 0 x 0 matrix
+  BasicCscMatrix() = default;
+
+  /// Create a matrix from its elements in any order, the values of duplicates are added
+  /// @param rows Number of rows
+  /// @param cols Number of columns
+  /// @param entries Elements inside the matrix
+  BasicCscMatrix(size_t rows, size_t cols, std::span<const SparseEntry<T>> entries);
+
+  /// Create a matrix from the nonzero elements of a dense matrix
+  /// @param a Dense matrix
+  explicit BasicCscMatrix(std::type_identity_t<ComplexMatrixView<const T>> a);
+
+  /// Create a matrix from compressed columns
+  /// @param rows Number of rows
+  /// @param cols Number of columns
+  /// @param offsets cols + 1 nondecreasing offsets from 0 to the number of elements, column j has [offsets[j],
+  /// offsets[j + 1])
+  /// @param indices Row of every element, increasing within a column
+  /// @param real Real parts of the elements
+  /// @param imag Imaginary parts of the elements
+  BasicCscMatrix(size_t rows, size_t cols, std::vector<size_t> offsets, std::vector<size_t> indices,
+                 AlignedVector<T> real, AlignedVector<T> imag);
+
+  [[nodiscard]] size_t rows() const { return m_Rows; }
+  [[nodiscard]] size_t cols() const { return m_Cols; }
+  /// @return Number of stored elements
+  [[nodiscard]] size_t nonZeros() const { return static_cast<size_t>(m_Indices.size()); }
+  [[nodiscard]] std::span<const size_t> offsets() const { return m_Offsets; }
+  [[nodiscard]] std::span<const size_t> indices() const { return m_Indices; }
+  [[nodiscard]] SplitSpan<const T> values() const { return {m_Real.data(), m_Imag.data(), nonZeros()}; }
+
+  /// @return Copy in compressed rows
+  [[nodiscard]] BasicCsrMatrix<T> toCsr() const;
+
+  /// @return Dense copy, column-major
+  [[nodiscard]] BasicComplexMatrix<T> toDense() const;
+
+  /// Multiplies a vector by the matrix, its transpose or its adjoint
+  /// @param x Vector of cols() elements, rows() for the transpose and the adjoint
+  /// @param y Product of rows() elements, cols() for the transpose and the adjoint, must not overlap x
+  /// @param operation Operator applied to the matrix
+  /// @param pool Threads that compute chunks of the product
+  void multiply(std::type_identity_t<SplitSpan<const T>> x, SplitSpan<T> y,
+                SparseOperation operation = SparseOperation::None, ThreadPool& pool = defaultThreadPool()) const;
+};
+
+/// Block compressed sparse row (BSR) matrix of dense square blocks, for matrices whose elements come in small dense
+/// blocks, like the coupled fields of a discretization. One index per block instead of per element saves memory
+/// bandwidth, and the product with the matrix loads the blocks with full width vector loads, without gathers.
+/// The blocks are stored column-major and the dimensions are multiples of the block size.
+template <scalar T>
+class BasicBsrMatrix {
+protected:
+  size_t m_Rows = 0;
+  size_t m_Cols = 0;
+  size_t m_Block = 1;
+  /// Block row i has the blocks [m_Offsets[i], m_Offsets[i + 1])
+  std::vector<size_t> m_Offsets = {0};
+  /// Block column of every block
+  std::vector<size_t> m_Indices;
+  /// Elements of block k at [k * m_Block^2, (k + 1) * m_Block^2), column-major
+  AlignedVector<T> m_Real;
+  AlignedVector<T> m_Imag;
+
+public:
+  using scalar_type = T;
+
+  /// Default constructor: creates an empty 0 x 0 matrix
+  BasicBsrMatrix() = default;
+
+  /// Create a matrix from the blocks that contain elements of a CSR matrix, the other elements of those blocks are 0
+  /// @param a Matrix whose dimensions are multiples of block
+  /// @param block Rows and columns of a block, at least 1
+  BasicBsrMatrix(const BasicCsrMatrix<T>& a, size_t block);
+
+  [[nodiscard]] size_t rows() const { return m_Rows; }
+  [[nodiscard]] size_t cols() const { return m_Cols; }
+  /// @return Rows and columns of a block
+  [[nodiscard]] size_t blockSize() const { return m_Block; }
+  /// @return Number of stored blocks
+  [[nodiscard]] size_t blockCount() const { return static_cast<size_t>(m_Indices.size()); }
+  /// @return Number of stored elements, including the zeros inside the blocks
+  [[nodiscard]] size_t nonZeros() const { return static_cast<size_t>(m_Real.size()); }
+  [[nodiscard]] std::span<const size_t> offsets() const { return m_Offsets; }
+  [[nodiscard]] std::span<const size_t> indices() const { return m_Indices; }
+  [[nodiscard]] SplitSpan<const T> values() const { return {m_Real.data(), m_Imag.data(), nonZeros()}; }
+
+  /// @return Copy in compressed rows without the zeros inside the blocks
+  [[nodiscard]] BasicCsrMatrix<T> toCsr() const;
+
+  /// @return Dense copy, row-major
+  [[nodiscard]] BasicComplexMatrix<T> toDense() const;
+
+  /// Multiplies a vector by the matrix, its transpose or its adjoint
+  /// @param x Vector of cols() elements, rows() for the transpose and the adjoint
+  /// @param y Product of rows() elements, cols() for the transpose and the adjoint, must not overlap x
+  /// @param operation Operator applied to the matrix
+  /// @param pool Threads that compute chunks of the product
+  void multiply(std::type_identity_t<SplitSpan<const T>> x, SplitSpan<T> y,
+                SparseOperation operation = SparseOperation::None, ThreadPool& pool = defaultThreadPool()) const;
+};
+
+using CsrMatrix = BasicCsrMatrix<real_t>;
+using CscMatrix = BasicCscMatrix<real_t>;
+using BsrMatrix = BasicBsrMatrix<real_t>;
+
+/// Convergence of an iterative solver
+struct SolverStatus {
+  /// Iterations until convergence, or the iteration limit
+  size_t iterations;
+  /// Relative residual |b - A x| / |b| of the solution, recomputed from x
+  double residual;
+  /// True if the residual is at most the tolerance
+  bool converged;
+};
+
+/// Solves A x = b with restarted GMRES(m), which minimizes the residual over a Krylov space of at most restart
+/// dimensions with one product by A per iteration. The basis is orthogonalized by modified Gram-Schmidt with the
+/// compensated, parallel dotc, and the least squares problem is updated by Givens rotations. Without restarts GMRES
+/// solves any nonsingular system in at most rows() iterations in exact arithmetic; restarts bound the memory to
+/// restart + 1 vectors, but the iteration can stall.
+/// @param a Square CSR, CSC or BSR matrix
+/// @param b Right-hand side
+/// @param x Initial guess, overwritten with the solution
+/// @param tolerance Relative residual |b - A x| / |b| at which the iteration stops
+/// @param maxIterations Maximum number of iterations, each one product by A
+/// @param restart Dimension m of the Krylov space between restarts, at least 1
+/// @param pool Threads that compute the products and the vector operations
+/// @return Convergence
+template <typename Matrix>
+SolverStatus gmres(const Matrix& a, SplitSpan<const typename Matrix::scalar_type> b,
+                   SplitSpan<typename Matrix::scalar_type> x, double tolerance, size_t maxIterations,
+                   size_t restart = 30, ThreadPool& pool = defaultThreadPool());
+
+/// Solves A x = b with BiCGSTAB, the stabilized biconjugate gradient method, which needs two products by A and
+/// seven vectors per iteration. Its residual is updated recursively; when that reaches the tolerance the true
+/// residual is recomputed and the iteration restarts from it if it is larger. Breakdowns restart the iteration too.
+/// @param a Square CSR, CSC or BSR matrix
+/// @param b Right-hand side
+/// @param x Initial guess, overwritten with the solution
+/// @param tolerance Relative residual |b - A x| / |b| at which the iteration stops
+/// @param maxIterations Maximum number of iterations, each two products by A
+/// @param pool Threads that compute the products and the vector operations
+/// @return Convergence
+template <typename Matrix>
+SolverStatus bicgstab(const Matrix& a, SplitSpan<const typename Matrix::scalar_type> b,
+                      SplitSpan<typename Matrix::scalar_type> x, double tolerance, size_t maxIterations,
+                      ThreadPool& pool = defaultThreadPool());
+
+}  // namespace Math
+
+#endif  // MATH_COMPLEX_SPARSE_H
@@ -0,0 +1,146 @@
+#ifndef MATH_MEMORY_RESOURCE_H
+#define MATH_MEMORY_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Monotonic arena: allocations bump a pointer through large chunks from the upstream resource and deallocation is a
+/// no-op. reset() makes the whole capacity available again without returning it, and merges the chunks into one, so
+/// that a pipeline that allocates the same buffers on every call reaches a steady state without any upstream
+/// allocation. Every block is aligned to at least MEMORY_ALIGNMENT bytes. Not thread safe: use one arena per thread.
+class ArenaResource : public std::pmr::memory_resource {
+protected:
+  struct Chunk {
+    std::byte* data;
+    std::size_t size;
+  };
+
+  std::pmr::memory_resource* m_Upstream;
+  std::vector<Chunk> m_Chunks;
+  std::byte* m_Current = nullptr;
+  std::byte* m_End = nullptr;
+  std::size_t m_NextChunkSize;
+
+  void addChunk(std::size_t minimumSize);
+  void releaseChunks() noexcept;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+  /// Create an empty arena, the first chunk is allocated on first use
+  /// @param initialSize Size of the first chunk in bytes
+  /// @param upstream Resource that provides the chunks
+  explicit ArenaResource(std::size_t initialSize = std::size_t(1) << 16,
+                         std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+  ArenaResource(const ArenaResource&) = delete;
+  ArenaResource& operator=(const ArenaResource&) = delete;
+  ~ArenaResource() override;
+
+  /// Invalidates all blocks and makes the capacity available for new allocations. If the arena grew since the last
+  /// reset, its chunks are replaced by a single chunk of the total capacity.
+  void reset();
+
+  /// Invalidates all blocks and returns all chunks to the upstream resource
+  void release() noexcept;
+
+  /// @return Total size of the chunks in bytes
+  [[nodiscard]] std::size_t capacity() const;
+
+  /// @return Bytes handed out since the last reset, including alignment padding
+  [[nodiscard]] std::size_t used() const;
+
+  [[nodiscard]] std::pmr::memory_resource* upstream() const { return m_Upstream; }
+};
+
+/// Thread safe pool of blocks in power of two size classes from MEMORY_ALIGNMENT bytes up to a largest block size.
+/// Freed blocks are kept in a free list of their class and reused by later allocations of the same class, so that
+/// short-lived buffers of recurring sizes cause no upstream allocation once the pool is warm. Larger requests are
+/// forwarded to the upstream resource. Every block is aligned to at least MEMORY_ALIGNMENT bytes.
+class PoolResource : public std::pmr::memory_resource {
+protected:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct Chunk {
+    void* data;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  std::pmr::memory_resource* m_Upstream;
+  std::size_t m_LargestBlock;
+  std::vector<FreeBlock*> m_FreeLists;
+  std::vector<Chunk> m_Chunks;
+  mutable std::mutex m_Mutex;
+
+  [[nodiscard]] std::size_t sizeClass(std::size_t bytes, std::size_t alignment) const;
+  void refill(std::size_t sizeClass);
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+  /// Create an empty pool
+  /// @param largestBlock Largest size in bytes that is served from the pool, rounded up to a power of two
+  /// @param upstream Resource that provides the chunks of the pool and the blocks that are too large for it
+  explicit PoolResource(std::size_t largestBlock = std::size_t(1) << 20,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+  PoolResource(const PoolResource&) = delete;
+  PoolResource& operator=(const PoolResource&) = delete;
+  ~PoolResource() override;
+
+  /// Returns all chunks to the upstream resource. Blocks that are still in use become invalid, blocks larger than
+  /// largestBlock() are not affected.
+  void release() noexcept;
+
+  /// @return Largest size in bytes that is served from the pool
+  [[nodiscard]] std::size_t largestBlock() const { return m_LargestBlock; }
+
+  /// @return Total size of the chunks in bytes
+  [[nodiscard]] std::size_t capacity() const;
+
+  [[nodiscard]] std::pmr::memory_resource* upstream() const { return m_Upstream; }
+};
+
+/// Resource for the large arrays of parallel loops on NUMA systems. An operating system places a page on the node of
+/// the thread that touches it first, so a buffer that is zeroed by the allocating thread ends up on one node and all
+/// other threads read it remotely. This resource touches the pages of every large block from the threads of a pool,
+/// in contiguous shares in thread order, before the container initializes them. Parallel loops over the whole array
+/// give each thread the same share (see ThreadPool), so its data is local. Only pages that are new to the process are
+/// placed, which is the case for large blocks from the default resource.
+class FirstTouchResource : public std::pmr::memory_resource {
+protected:
+  std::pmr::memory_resource* m_Upstream;
+  ThreadPool* m_Pool;
+  std::size_t m_Threshold;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+  /// Create a resource
+  /// @param pool Threads that touch the pages, must outlive the resource
+  /// @param threshold Size in bytes from which blocks are touched in parallel
+  /// @param upstream Resource that provides the blocks
+  explicit FirstTouchResource(ThreadPool& pool = defaultThreadPool(), std::size_t threshold = std::size_t(1) << 20,
+                              std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+  [[nodiscard]] std::size_t threshold() const { return m_Threshold; }
+  [[nodiscard]] std::pmr::memory_resource* upstream() const { return m_Upstream; }
+};
+
+}  // namespace Math
+
+#endif  // MATH_MEMORY_RESOURCE_H
@@ -0,0 +1,81 @@
+#ifndef MATH_OSCILLATOR_H
+#define MATH_OSCILLATOR_H
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Numerically controlled oscillator, a stream of unit phasors exp(i phi_n) with phi_(n+1) = phi_n + w. The phase is
+/// a 64-bit fixed point fraction of a turn, so it wraps exactly and does not drift however long the stream runs, and
+/// the frequency is rounded to a multiple of 2 pi / 2^64 radians per sample. Samples are generated in blocks by
+/// rotating a table of exp(i k w) with the phasor of the block start, which is evaluated from the accumulator: one
+/// complex multiplication per sample, and the phase error is corrected at every block. Frequency and phase modulation
+/// are applied as a second rotation with the SIMD exponential. The oscillator is stateful, use one per stream.
+template <scalar T>
+class BasicOscillator {
+public:
+  /// Number of samples per block, the length of the rotation table
+  static constexpr size_t BLOCK_SIZE = 256;
+
+protected:
+  uint64_t m_Phase;
+  uint64_t m_Increment;
+  /// exp(i k w) for k < BLOCK_SIZE
+  BasicComplexArray<T> m_Rotation;
+  BasicComplexArray<T> m_Scratch;
+
+  [[nodiscard]] BasicComplex<T> phasor() const;
+  void carrier(SplitSpan<T> out);
+
+public:
+  /// Creates an oscillator
+  /// @param frequency Phase increment per sample in radians
+  /// @param phase Phase of the first sample in radians
+  explicit BasicOscillator(T frequency, T phase = 0);
+
+  /// @return Phase increment per sample in radians, in [-pi, pi)
+  [[nodiscard]] T frequency() const;
+  /// @return Phase of the next sample in radians, in [-pi, pi)
+  [[nodiscard]] T phase() const;
+
+  /// Changes the frequency from the next sample on, keeping the phase continuous
+  /// @param frequency Phase increment per sample in radians
+  void setFrequency(T frequency);
+
+  /// Sets the phase of the next sample
+  /// @param phase Phase in radians
+  void setPhase(T phase);
+
+  /// Writes the next samples and advances the phase
+  /// @param out Samples
+  void generate(SplitSpan<T> out);
+
+  /// Writes the next samples and advances the phase
+  /// @param out Interleaved samples
+  void generate(std::span<BasicComplex<T>> out);
+
+  /// Writes the next samples of the modulated oscillator, exp(i (phi_n + p_n)) with
+  /// phi_(n+1) = phi_n + w + f_n. The frequency deviation is integrated into the phase.
+  /// @param frequencyDeviation f_n in radians per sample, empty for no frequency modulation
+  /// @param phaseDeviation p_n in radians, empty for no phase modulation
+  /// @param out Samples
+  void modulate(std::span<const T> frequencyDeviation, std::span<const T> phaseDeviation, SplitSpan<T> out);
+
+  /// Multiplies a signal by the next samples, which shifts its spectrum by the frequency. out may alias in.
+  /// @param in Signal
+  /// @param out Shifted signal of the same size
+  void mix(std::type_identity_t<SplitSpan<const T>> in, SplitSpan<T> out);
+};
+
+using Oscillator = BasicOscillator<real_t>;
+
+}  // namespace Math
+
+#endif  // MATH_OSCILLATOR_H
@@ -0,0 +1,98 @@
+#ifndef MATH_PARALLEL_H
+#define MATH_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Complex.h"
+#include "SplitSpan.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Elements per block of the parallel transforms. Chunks are whole blocks, so that every chunk starts on a cache line
+/// of an aligned array and no two threads write the same line.
+constexpr std::size_t PARALLEL_BLOCK = 64;
+
+/// Default minimum number of elements per chunk of the parallel transforms, large enough that a chunk of a cheap
+/// elementwise function outweighs the cost of scheduling it
+constexpr std::size_t PARALLEL_GRAIN = std::size_t(1) << 14;
+
+/// Calls f(offset, count) in parallel for chunks of whole blocks that cover [0, size)
+/// @param size Number of elements
+/// @param pool Threads that run the chunks
+/// @param grain Minimum number of elements per chunk
+/// @param f Function that is called with the first element and the number of elements of each chunk
+template <typename F>
+void parallelBlocks(const std::size_t size, ThreadPool& pool, const std::size_t grain, F&& f) {
+  const std::size_t blocks = (size + PARALLEL_BLOCK - 1) / PARALLEL_BLOCK;
+  pool.parallelForRange(0, blocks, std::max<std::size_t>(grain / PARALLEL_BLOCK, 1),
+                        [&](const std::size_t first, const std::size_t last) {
+                          const std::size_t offset = first * PARALLEL_BLOCK;
+                          f(static_cast<size_t>(offset),
+                            static_cast<size_t>(std::min(last * PARALLEL_BLOCK, size) - offset));
+                        });
+}
+
+/// Applies an elementwise function to an array in parallel, f(z.subspan(i, n), out.subspan(i, n)) for chunks that
+/// cover the array, e.g. [](auto z, auto out) { exp<real_t>(z, out); }. Arrays of at most grain elements are
+/// transformed on the calling thread.
+/// @param z Complex numbers
+/// @param out Results of the same size
+/// @param f Function that transforms a chunk
+/// @param pool Threads that run the chunks
+/// @param grain Minimum number of elements per chunk
+template <scalar T, typename F>
+void parallelTransform(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out, F&& f,
+                       ThreadPool& pool = defaultThreadPool(), const std::size_t grain = PARALLEL_GRAIN) {
+  if (z.size() != out.size()) throw std::invalid_argument("parallelTransform: operands differ in size");
+  parallelBlocks(out.size(), pool, grain, [&](const size_t offset, const size_t count) {
+    f(z.subspan(offset, count), out.subspan(offset, count));
+  });
+}
+
+/// Applies an elementwise function of two arrays in parallel, f(lhs.subspan(i, n), rhs.subspan(i, n),
+/// out.subspan(i, n)) for chunks that cover the arrays, e.g. [](auto a, auto b, auto out) { multiply<real_t>(a, b,
+/// out); }. Arrays of at most grain elements are transformed on the calling thread.
+/// @param lhs Complex numbers
+/// @param rhs Complex numbers of the same size
+/// @param out Results of the same size
+/// @param f Function that transforms a chunk
+/// @param pool Threads that run the chunks
+/// @param grain Minimum number of elements per chunk
+template <scalar T, typename F>
+void parallelTransform(const std::type_identity_t<SplitSpan<const T>> lhs,
+                       const std::type_identity_t<SplitSpan<const T>> rhs, const SplitSpan<T> out, F&& f,
+                       ThreadPool& pool = defaultThreadPool(), const std::size_t grain = PARALLEL_GRAIN) {
+  if (lhs.size() != out.size() || rhs.size() != out.size()) {
+    throw std::invalid_argument("parallelTransform: operands differ in size");
+  }
+  parallelBlocks(out.size(), pool, grain, [&](const size_t offset, const size_t count) {
+    f(lhs.subspan(offset, count), rhs.subspan(offset, count), out.subspan(offset, count));
+  });
+}
+
+/// Applies an elementwise function to interleaved complex numbers in parallel, f(z.subspan(i, n), out.subspan(i, n))
+/// for chunks that cover the array. Arrays of at most grain elements are transformed on the calling thread.
+/// @param z Interleaved complex numbers
+/// @param out Interleaved results of the same size
+/// @param f Function that transforms a chunk
+/// @param pool Threads that run the chunks
+/// @param grain Minimum number of elements per chunk
+template <scalar T, typename F>
+void parallelTransform(const std::type_identity_t<std::span<const BasicComplex<T>>> z,
+                       const std::span<BasicComplex<T>> out, F&& f, ThreadPool& pool = defaultThreadPool(),
+                       const std::size_t grain = PARALLEL_GRAIN) {
+  if (z.size() != out.size()) throw std::invalid_argument("parallelTransform: operands differ in size");
+  parallelBlocks(out.size(), pool, grain, [&](const size_t offset, const size_t count) {
+    f(z.subspan(offset, count), out.subspan(offset, count));
+  });
+}
+
+}  // namespace Math
+
+#endif  // MATH_PARALLEL_H
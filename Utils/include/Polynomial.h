@@ -0,0 +1,99 @@
+#ifndef MATH_POLYNOMIAL_H
+#define MATH_POLYNOMIAL_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "SplitSpan.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Polynomial with complex coefficients, c[0] + c[1] z + ... + c[n] z^n. The coefficients are stored in split form
+/// from the constant term up, without trailing zeros, so that the leading coefficient is nonzero unless the
+/// polynomial is zero. Evaluation at arrays of points runs Horner's scheme in the SIMD kernels, one point per lane.
+template <scalar T>
+class BasicPolynomial {
+protected:
+  BasicComplexArray<T> m_Coefficients;
+
+  void trim();
+
+public:
+  /// Creates the zero polynomial
+  BasicPolynomial();
+
+  /// Creates a polynomial from its coefficients
+  /// @param coefficients c[0], c[1], ..., from the constant term up
+  BasicPolynomial(std::initializer_list<BasicComplex<T>> coefficients);
+
+  /// Creates a polynomial from its coefficients
+  /// @param coefficients c[0], c[1], ..., from the constant term up
+  explicit BasicPolynomial(std::span<const BasicComplex<T>> coefficients);
+
+  /// @return Degree, 0 for constants including the zero polynomial
+  [[nodiscard]] size_t degree() const { return m_Coefficients.size() - 1; }
+
+  /// @return Coefficients from the constant term up, degree() + 1 of them
+  [[nodiscard]] SplitSpan<const T> coefficients() const { return m_Coefficients.view(); }
+
+  /// @return Coefficient of z^i
+  [[nodiscard]] BasicComplex<T> operator[](const size_t i) const {
+    return BasicComplex<T>(m_Coefficients.real()[i], m_Coefficients.imag()[i]);
+  }
+
+  /// Evaluates the polynomial at one point
+  /// @param z Point
+  /// @return Value at z
+  [[nodiscard]] BasicComplex<T> operator()(const BasicComplex<T>& z) const;
+
+  /// Evaluates the polynomial at all points. out may alias z.
+  /// @param z Points
+  /// @param out Values of the same size
+  void evaluate(std::type_identity_t<SplitSpan<const T>> z, SplitSpan<T> out) const;
+
+  /// Evaluates the polynomial at all points. out may alias z.
+  /// @param z Interleaved points
+  /// @param out Values of the same size
+  void evaluate(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::span<BasicComplex<T>> out) const;
+
+  /// @return First derivative
+  [[nodiscard]] BasicPolynomial derivative() const;
+
+  /// Finds all roots with the Aberth-Ehrlich method, see Math::roots
+  /// @return degree() roots, in no particular order
+  /// @throws std::runtime_error If the iteration does not converge, e.g. for coefficients that are not finite
+  [[nodiscard]] std::vector<BasicComplex<T>> roots() const;
+};
+
+using Polynomial = BasicPolynomial<real_t>;
+
+/// Convergence of the root finder for one polynomial
+struct RootStatus {
+  /// Aberth iterations until every root converged, or the iteration limit
+  size_t iterations;
+  /// True if every root converged within the iteration limit
+  bool converged;
+};
+
+/// Finds the roots of a batch of polynomials with the Aberth-Ehrlich method, which refines all roots of a polynomial
+/// simultaneously and converges cubically to simple roots. A root is frozen once its value is dominated by the rounding
+/// error of the evaluation or its correction is below the working precision, and a polynomial stops iterating as
+/// soon as all of its roots are frozen. The polynomials are distributed over the threads of a pool.
+/// @param polynomials Polynomials, the zero polynomial is not allowed
+/// @param roots Roots of all polynomials, the degree of each one after the other
+/// @param pool Threads that find the roots
+/// @return Convergence of every polynomial
+template <scalar T>
+std::vector<RootStatus> roots(std::span<const BasicPolynomial<T>> polynomials, std::span<BasicComplex<T>> roots,
+                              ThreadPool& pool = defaultThreadPool());
+
+}  // namespace Math
+
+#endif  // MATH_POLYNOMIAL_H
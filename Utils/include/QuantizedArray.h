@@ -0,0 +1,121 @@
+#ifndef MATH_QUANTIZED_ARRAY_H
+#define MATH_QUANTIZED_ARRAY_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Integer types of quantized complex numbers
+template <typename Q>
+concept quantized = std::same_as<Q, int8_t> || std::same_as<Q, int16_t>;
+
+/// Complex number as a pair of integers, the I (real) and Q (imaginary) sample of a receiver
+template <quantized Q>
+struct IqSample {
+  Q i;
+  Q q;
+};
+
+/// Owning array of quantized complex numbers z = scale * (I + iQ), stored as interleaved integer pairs in the layout
+/// in which receivers deliver them. An int16 pair takes a quarter of the memory of a complex double, an int8 pair an
+/// eighth, so large recordings stay compact in memory and in cache. The numbers are converted in blocks by SIMD
+/// kernels that split the pairs with integer shifts, and multiplyAccumulate dequantizes on the fly without a
+/// floating point copy of the data. Quantization rounds to the nearest integer and saturates.
+template <quantized Q, scalar T>
+class BasicQuantizedArray {
+public:
+  using value_type = BasicComplex<T>;
+  using sample_type = IqSample<Q>;
+
+  /// Largest magnitude of a part of a sample
+  static constexpr Q MAX_VALUE = std::numeric_limits<Q>::max();
+
+protected:
+  AlignedVector<sample_type> m_Samples;
+  T m_Scale;
+
+  static size_t checkedSize(std::size_t size);
+  static T checkedScale(T scale);
+  void checkRange(std::size_t offset, std::size_t count) const;
+
+public:
+  /// Create an array of zeros
+  /// @param size Number of elements
+  /// @param scale Value of one quantization step, positive and finite
+  explicit BasicQuantizedArray(size_t size = 0, T scale = 1);
+
+  /// Create an array by quantizing complex numbers
+  /// @param z Complex numbers
+  /// @param scale Value of one quantization step, e.g. fullScale(z)
+  BasicQuantizedArray(std::type_identity_t<SplitSpan<const T>> z, T scale);
+
+  /// Smallest scale at which no part of the numbers saturates, so that the largest one maps to MAX_VALUE
+  /// @param z Complex numbers
+  /// @return Scale, 1 if all numbers are zero or not finite
+  [[nodiscard]] static T fullScale(std::type_identity_t<SplitSpan<const T>> z);
+
+  [[nodiscard]] size_t size() const { return static_cast<size_t>(m_Samples.size()); }
+  [[nodiscard]] bool empty() const { return m_Samples.empty(); }
+  /// @return Value of one quantization step
+  [[nodiscard]] T scale() const { return m_Scale; }
+
+  /// Changes the value of one quantization step, which rescales all numbers without touching the samples
+  /// @param scale Positive and finite scale
+  void setScale(T scale) { m_Scale = checkedScale(scale); }
+
+  /// Changes the number of elements, new elements are zero
+  /// @param size Number of elements
+  void resize(size_t size) { m_Samples.resize(checkedSize(size)); }
+
+  /// @return Raw samples, e.g. to read a capture into
+  [[nodiscard]] std::span<sample_type> samples() { return m_Samples; }
+  [[nodiscard]] std::span<const sample_type> samples() const { return m_Samples; }
+
+  /// @return Dequantized element i
+  [[nodiscard]] value_type operator[](const size_t i) const {
+    return value_type(m_Scale * T(m_Samples[i].i), m_Scale * T(m_Samples[i].q));
+  }
+
+  /// Dequantizes out.size() elements
+  /// @param out Complex numbers
+  /// @param offset Index of the first element
+  void dequantize(SplitSpan<T> out, std::size_t offset = 0) const;
+
+  /// Dequantizes out.size() elements
+  /// @param out Interleaved complex numbers
+  /// @param offset Index of the first element
+  void dequantize(std::span<BasicComplex<T>> out, std::size_t offset = 0) const;
+
+  /// Quantizes z.size() elements with the scale of the array
+  /// @param z Complex numbers
+  /// @param offset Index of the first element
+  void quantize(std::type_identity_t<SplitSpan<const T>> z, std::size_t offset = 0);
+
+  /// Quantizes z.size() elements with the scale of the array
+  /// @param z Interleaved complex numbers
+  /// @param offset Index of the first element
+  void quantize(std::type_identity_t<std::span<const BasicComplex<T>>> z, std::size_t offset = 0);
+
+  /// Fused dequantize-multiply-accumulate, acc[k] += (*this)[offset + k] * w[k] for k < acc.size()
+  /// @param w Factors, the size of acc
+  /// @param acc Accumulators
+  /// @param offset Index of the first element
+  void multiplyAccumulate(std::type_identity_t<SplitSpan<const T>> w, SplitSpan<T> acc, std::size_t offset = 0) const;
+};
+
+using QuantizedArray8 = BasicQuantizedArray<int8_t, real_t>;
+using QuantizedArray16 = BasicQuantizedArray<int16_t, real_t>;
+
+}  // namespace Math
+
+#endif  // MATH_QUANTIZED_ARRAY_H
@@ -0,0 +1,32 @@
+#ifndef MATH_SIMD_H
+#define MATH_SIMD_H
+
+#include <cstdint>
+#include <string>
+
+namespace Math::Simd {
+
+/// Instruction sets with dedicated kernels
+enum class Isa : uint8_t { Scalar, Sse2, Avx2, Avx512 };
+
+/// Detects the widest instruction set that is supported by the CPU and was compiled into the library
+/// @return Best available instruction set
+Isa detectIsa();
+
+/// Get the instruction set used by the kernels
+/// @return Active instruction set, initially the detected one
+Isa activeIsa();
+
+/// Selects the instruction set used by the kernels, e.g. to compare the implementations in tests and benchmarks
+/// @param isa Requested instruction set, limited to the detected one
+/// @return Instruction set that is active afterwards
+Isa setActiveIsa(Isa isa);
+
+/// Converts an instruction set to its name
+/// @param isa Instruction set
+/// @return Name of the instruction set
+std::string to_string(Isa isa);
+
+}  // namespace Math::Simd
+
+#endif  // MATH_SIMD_H
@@ -0,0 +1,811 @@
+#ifndef MATH_SIMD_PACK_H
+#define MATH_SIMD_PACK_H
+
+// Fixed-width SIMD vectors for the kernels in the per-ISA translation units. The instruction set is selected by the
+// compiler flags of the including translation unit, and everything is declared in an inline namespace named after it,
+// so the same kernel source can be compiled several times with different flags without violating the ODR.
+// Kernel translation units must only call functions from this header and the C library, never inline functions that
+// are shared with the rest of the program, because the linker could otherwise pick a copy compiled for a wider ISA.
+// That includes the float overloads of <cmath> and the members of std::numeric_limits, which an unoptimized build
+// does not inline, so the kernels use CLibrary and Limits below.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(MATH_SIMD_FORCE_SCALAR)
+#define MATH_SIMD_TARGET Scalar
+#elif defined(__AVX512F__)
+#define MATH_SIMD_TARGET Avx512
+#define MATH_SIMD_AVX512
+#define MATH_SIMD_AVX2
+#define MATH_SIMD_SSE2
+#include <immintrin.h>
+#elif defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define MATH_SIMD_TARGET Avx2
+#define MATH_SIMD_AVX2
+#define MATH_SIMD_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define MATH_SIMD_TARGET Sse2
+#define MATH_SIMD_SSE2
+#include <emmintrin.h>
+#else
+#define MATH_SIMD_TARGET Scalar
+#endif
+
+// Forces inlining of the pack functions that are too large for the default heuristics. An outlined call passes the
+// packs through memory and, with AVX, has to clear the upper register halves before every call.
+#if defined(_MSC_VER)
+#define MATH_SIMD_INLINE __forceinline
+#else
+#define MATH_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace Math::Simd {
+inline namespace MATH_SIMD_TARGET {
+
+/// The C library functions for float, double and long double, e.g. CLibrary::sqrt(x) calls sqrtf, sqrt or sqrtl
+namespace CLibrary {
+
+#define MATH_SIMD_C_FUNCTION(NAME)                      \
+  template <typename T, typename... A>                  \
+  MATH_SIMD_INLINE T NAME(const T x, const A... args) { \
+    if constexpr (std::is_same_v<T, float>) {           \
+      return ::NAME##f(x, args...);                     \
+    } else if constexpr (std::is_same_v<T, double>) {   \
+      return ::NAME(x, args...);                        \
+    } else {                                            \
+      static_assert(std::is_same_v<T, long double>);    \
+      return ::NAME##l(x, args...);                     \
+    }                                                   \
+  }
+
+MATH_SIMD_C_FUNCTION(fma)
+MATH_SIMD_C_FUNCTION(sqrt)
+MATH_SIMD_C_FUNCTION(fabs)
+MATH_SIMD_C_FUNCTION(copysign)
+MATH_SIMD_C_FUNCTION(nearbyint)
+MATH_SIMD_C_FUNCTION(ldexp)
+MATH_SIMD_C_FUNCTION(frexp)
+MATH_SIMD_C_FUNCTION(exp)
+MATH_SIMD_C_FUNCTION(log)
+MATH_SIMD_C_FUNCTION(sin)
+MATH_SIMD_C_FUNCTION(cos)
+MATH_SIMD_C_FUNCTION(sinh)
+MATH_SIMD_C_FUNCTION(cosh)
+MATH_SIMD_C_FUNCTION(atan2)
+
+#undef MATH_SIMD_C_FUNCTION
+
+/// Sign bit of x, also of zeros and NaN
+template <typename T>
+MATH_SIMD_INLINE bool signbit(const T x) {
+  return CLibrary::copysign(T(1), x) < T(0);
+}
+
+}  // namespace CLibrary
+
+/// Constants of std::numeric_limits
+template <typename T>
+struct Limits {
+  static constexpr T min = std::numeric_limits<T>::min();
+  static constexpr T max = std::numeric_limits<T>::max();
+  static constexpr T infinity = std::numeric_limits<T>::infinity();
+  static constexpr T quietNaN = std::numeric_limits<T>::quiet_NaN();
+};
+
+/// Register level operations of a vector with W lanes of type T
+template <typename T, std::size_t W>
+struct PackTraits;
+
+/// Single lane fallback, used for the scalar target, for long double and for loop remainders
+template <typename T>
+struct PackTraits<T, 1> {
+  using Reg = T;
+  using MaskReg = bool;
+
+  static Reg set1(const T x) { return x; }
+  static Reg load(const T* p) { return *p; }
+  static void store(T* p, const Reg v) { *p = v; }
+  static Reg gather(const T* p, const std::uint32_t* indices) { return p[*indices]; }
+  static void scatter(T* p, const std::uint32_t* indices, const Reg v) { p[*indices] = v; }
+  static Reg add(const Reg a, const Reg b) { return a + b; }
+  static Reg sub(const Reg a, const Reg b) { return a - b; }
+  static Reg mul(const Reg a, const Reg b) { return a * b; }
+  static Reg div(const Reg a, const Reg b) { return a / b; }
+#if defined(FP_FAST_FMA)
+  /// Whether fmadd, fmsub and fnmadd round only once
+  static constexpr bool FUSED = true;
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return CLibrary::fma(a, b, c); }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return CLibrary::fma(a, b, -c); }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return CLibrary::fma(-a, b, c); }
+#else
+  static constexpr bool FUSED = false;
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return a * b + c; }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return a * b - c; }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return c - a * b; }
+#endif
+  static Reg sqrt(const Reg a) { return CLibrary::sqrt(a); }
+  static Reg abs(const Reg a) { return CLibrary::fabs(a); }
+  static Reg min(const Reg a, const Reg b) { return b < a ? b : a; }
+  static Reg max(const Reg a, const Reg b) { return a < b ? b : a; }
+  static Reg copysign(const Reg mag, const Reg sign) { return CLibrary::copysign(mag, sign); }
+  static MaskReg lt(const Reg a, const Reg b) { return a < b; }
+  static MaskReg le(const Reg a, const Reg b) { return a <= b; }
+  static MaskReg eq(const Reg a, const Reg b) { return a == b; }
+  static MaskReg signbit(const Reg a) { return CLibrary::signbit(a); }
+  static Reg blend(const MaskReg m, const Reg a, const Reg b) { return m ? a : b; }
+  static MaskReg maskAnd(const MaskReg a, const MaskReg b) { return a && b; }
+  static MaskReg maskOr(const MaskReg a, const MaskReg b) { return a || b; }
+  static MaskReg maskNot(const MaskReg a) { return !a; }
+  static bool any(const MaskReg m) { return m; }
+  static bool all(const MaskReg m) { return m; }
+  static Reg round(const Reg a) { return CLibrary::nearbyint(a); }
+  static Reg pow2(const Reg n) { return CLibrary::ldexp(T(1), static_cast<int>(n)); }
+  static Reg exponent(const Reg a) {
+    int e = 0;
+    CLibrary::frexp(a, &e);
+    return static_cast<Reg>(e);
+  }
+  static Reg mantissa(const Reg a) {
+    int e = 0;
+    return CLibrary::frexp(a, &e);
+  }
+  template <typename Q>
+  static void loadPairs(const Q* p, Reg& re, Reg& im) {
+    re = static_cast<Reg>(p[0]);
+    im = static_cast<Reg>(p[1]);
+  }
+  template <typename Q>
+  static void storePairs(Q* p, const Reg re, const Reg im) {
+    p[0] = static_cast<Q>(CLibrary::nearbyint(re));
+    p[1] = static_cast<Q>(CLibrary::nearbyint(im));
+  }
+};
+
+#if defined(MATH_SIMD_SSE2)
+
+// An int16 I/Q pair, or an int8 pair sign extended to 16 bits, is held in a 32-bit integer lane with I in the low
+// half (x86 is little endian). Shifts split the lanes into the sign extended parts for the conversion to floating
+// point, and join converted parts back into pairs.
+
+/// @return Sign extended real parts of BITS-bit pairs
+template <int BITS>
+MATH_SIMD_INLINE __m128i pairReal(const __m128i v) {
+  return _mm_srai_epi32(_mm_slli_epi32(v, 32 - BITS), 32 - BITS);
+}
+/// @return Sign extended imaginary parts of BITS-bit pairs
+template <int BITS>
+MATH_SIMD_INLINE __m128i pairImag(const __m128i v) {
+  return _mm_srai_epi32(v, BITS);
+}
+/// @return BITS-bit pairs of parts in the range of a BITS-bit integer
+template <int BITS>
+MATH_SIMD_INLINE __m128i joinPairs(const __m128i re, const __m128i im) {
+  return _mm_or_si128(_mm_and_si128(re, _mm_set1_epi32((1 << BITS) - 1)), _mm_slli_epi32(im, BITS));
+}
+/// @return The low four 16-bit lanes sign extended to 32 bits
+MATH_SIMD_INLINE __m128i widen16(const __m128i v) {
+  return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+template <>
+struct PackTraits<double, 2> {
+  using Reg = __m128d;
+  using MaskReg = __m128d;
+  static constexpr bool FUSED = false;
+
+  static Reg set1(const double x) { return _mm_set1_pd(x); }
+  static Reg load(const double* p) { return _mm_loadu_pd(p); }
+  static void store(double* p, const Reg v) { _mm_storeu_pd(p, v); }
+  static Reg gather(const double* p, const std::uint32_t* indices) { return _mm_set_pd(p[indices[1]], p[indices[0]]); }
+  static void scatter(double* p, const std::uint32_t* indices, const Reg v) {
+    _mm_storel_pd(p + indices[0], v);
+    _mm_storeh_pd(p + indices[1], v);
+  }
+  static Reg add(const Reg a, const Reg b) { return _mm_add_pd(a, b); }
+  static Reg sub(const Reg a, const Reg b) { return _mm_sub_pd(a, b); }
+  static Reg mul(const Reg a, const Reg b) { return _mm_mul_pd(a, b); }
+  static Reg div(const Reg a, const Reg b) { return _mm_div_pd(a, b); }
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return _mm_sub_pd(_mm_mul_pd(a, b), c); }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return _mm_sub_pd(c, _mm_mul_pd(a, b)); }
+  static Reg sqrt(const Reg a) { return _mm_sqrt_pd(a); }
+  static Reg abs(const Reg a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+  static Reg min(const Reg a, const Reg b) { return _mm_min_pd(a, b); }
+  static Reg max(const Reg a, const Reg b) { return _mm_max_pd(a, b); }
+  static Reg copysign(const Reg mag, const Reg sign) {
+    const Reg mask = _mm_set1_pd(-0.0);
+    return _mm_or_pd(_mm_andnot_pd(mask, mag), _mm_and_pd(mask, sign));
+  }
+  static MaskReg lt(const Reg a, const Reg b) { return _mm_cmplt_pd(a, b); }
+  static MaskReg le(const Reg a, const Reg b) { return _mm_cmple_pd(a, b); }
+  static MaskReg eq(const Reg a, const Reg b) { return _mm_cmpeq_pd(a, b); }
+  static MaskReg signbit(const Reg a) {
+    return _mm_castsi128_pd(_mm_shuffle_epi32(_mm_srai_epi32(_mm_castpd_si128(a), 31), 0xF5));
+  }
+  static Reg blend(const MaskReg m, const Reg a, const Reg b) {
+    return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+  }
+  static MaskReg maskAnd(const MaskReg a, const MaskReg b) { return _mm_and_pd(a, b); }
+  static MaskReg maskOr(const MaskReg a, const MaskReg b) { return _mm_or_pd(a, b); }
+  static MaskReg maskNot(const MaskReg a) { return _mm_xor_pd(a, _mm_castsi128_pd(_mm_set1_epi32(-1))); }
+  static bool any(const MaskReg m) { return _mm_movemask_pd(m) != 0; }
+  static bool all(const MaskReg m) { return _mm_movemask_pd(m) == 0x3; }
+  static Reg round(const Reg a) {
+    const Reg magic = _mm_set1_pd(6755399441055744.0);
+    return _mm_sub_pd(_mm_add_pd(a, magic), magic);
+  }
+  static Reg pow2(const Reg n) {
+    const __m128i bits = _mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(4503599627371519.0)));
+    return _mm_castsi128_pd(_mm_slli_epi64(bits, 52));
+  }
+  static Reg exponent(const Reg a) {
+    const Reg biased = _mm_or_pd(_mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(a), 52)), _mm_set1_pd(0x1p52));
+    return _mm_sub_pd(biased, _mm_set1_pd(0x1p52 + 1022));
+  }
+  static Reg mantissa(const Reg a) {
+    const Reg mask = _mm_castsi128_pd(_mm_set1_epi64x(0x000FFFFFFFFFFFFF));
+    return _mm_or_pd(_mm_and_pd(a, mask), _mm_set1_pd(0.5));
+  }
+  static void loadPairs(const std::int16_t* p, Reg& re, Reg& im) {
+    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+    re = _mm_cvtepi32_pd(pairReal<16>(v));
+    im = _mm_cvtepi32_pd(pairImag<16>(v));
+  }
+  static void loadPairs(const std::int8_t* p, Reg& re, Reg& im) {
+    int bits = 0;
+    std::memcpy(&bits, p, sizeof(bits));
+    const __m128i v = widen16(_mm_cvtsi32_si128(bits));
+    re = _mm_cvtepi32_pd(pairReal<8>(v));
+    im = _mm_cvtepi32_pd(pairImag<8>(v));
+  }
+  static void storePairs(std::int16_t* p, const Reg re, const Reg im) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), joinPairs<16>(_mm_cvtpd_epi32(re), _mm_cvtpd_epi32(im)));
+  }
+  static void storePairs(std::int8_t* p, const Reg re, const Reg im) {
+    const __m128i pairs = joinPairs<8>(_mm_cvtpd_epi32(re), _mm_cvtpd_epi32(im));
+    const int bits = _mm_cvtsi128_si32(_mm_packs_epi32(pairs, pairs));
+    std::memcpy(p, &bits, sizeof(bits));
+  }
+};
+
+template <>
+struct PackTraits<float, 4> {
+  using Reg = __m128;
+  using MaskReg = __m128;
+  static constexpr bool FUSED = false;
+
+  static Reg set1(const float x) { return _mm_set1_ps(x); }
+  static Reg load(const float* p) { return _mm_loadu_ps(p); }
+  static void store(float* p, const Reg v) { _mm_storeu_ps(p, v); }
+  static Reg gather(const float* p, const std::uint32_t* indices) {
+    return _mm_set_ps(p[indices[3]], p[indices[2]], p[indices[1]], p[indices[0]]);
+  }
+  static void scatter(float* p, const std::uint32_t* indices, const Reg v) {
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, v);
+    for (std::size_t i = 0; i < 4; ++i) p[indices[i]] = lanes[i];
+  }
+  static Reg add(const Reg a, const Reg b) { return _mm_add_ps(a, b); }
+  static Reg sub(const Reg a, const Reg b) { return _mm_sub_ps(a, b); }
+  static Reg mul(const Reg a, const Reg b) { return _mm_mul_ps(a, b); }
+  static Reg div(const Reg a, const Reg b) { return _mm_div_ps(a, b); }
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return _mm_sub_ps(_mm_mul_ps(a, b), c); }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+  static Reg sqrt(const Reg a) { return _mm_sqrt_ps(a); }
+  static Reg abs(const Reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0F), a); }
+  static Reg min(const Reg a, const Reg b) { return _mm_min_ps(a, b); }
+  static Reg max(const Reg a, const Reg b) { return _mm_max_ps(a, b); }
+  static Reg copysign(const Reg mag, const Reg sign) {
+    const Reg mask = _mm_set1_ps(-0.0F);
+    return _mm_or_ps(_mm_andnot_ps(mask, mag), _mm_and_ps(mask, sign));
+  }
+  static MaskReg lt(const Reg a, const Reg b) { return _mm_cmplt_ps(a, b); }
+  static MaskReg le(const Reg a, const Reg b) { return _mm_cmple_ps(a, b); }
+  static MaskReg eq(const Reg a, const Reg b) { return _mm_cmpeq_ps(a, b); }
+  static MaskReg signbit(const Reg a) { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(a), 31)); }
+  static Reg blend(const MaskReg m, const Reg a, const Reg b) {
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+  }
+  static MaskReg maskAnd(const MaskReg a, const MaskReg b) { return _mm_and_ps(a, b); }
+  static MaskReg maskOr(const MaskReg a, const MaskReg b) { return _mm_or_ps(a, b); }
+  static MaskReg maskNot(const MaskReg a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+  static bool any(const MaskReg m) { return _mm_movemask_ps(m) != 0; }
+  static bool all(const MaskReg m) { return _mm_movemask_ps(m) == 0xF; }
+  static Reg round(const Reg a) {
+    const Reg magic = _mm_set1_ps(12582912.0F);
+    return _mm_sub_ps(_mm_add_ps(a, magic), magic);
+  }
+  static Reg pow2(const Reg n) {
+    const __m128i bits = _mm_castps_si128(_mm_add_ps(n, _mm_set1_ps(8388735.0F)));
+    return _mm_castsi128_ps(_mm_slli_epi32(bits, 23));
+  }
+  static Reg exponent(const Reg a) {
+    const Reg biased = _mm_or_ps(_mm_castsi128_ps(_mm_srli_epi32(_mm_castps_si128(a), 23)), _mm_set1_ps(0x1p23F));
+    return _mm_sub_ps(biased, _mm_set1_ps(0x1p23F + 126));
+  }
+  static Reg mantissa(const Reg a) {
+    const Reg mask = _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF));
+    return _mm_or_ps(_mm_and_ps(a, mask), _mm_set1_ps(0.5F));
+  }
+  static void loadPairs(const std::int16_t* p, Reg& re, Reg& im) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    re = _mm_cvtepi32_ps(pairReal<16>(v));
+    im = _mm_cvtepi32_ps(pairImag<16>(v));
+  }
+  static void loadPairs(const std::int8_t* p, Reg& re, Reg& im) {
+    const __m128i v = widen16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+    re = _mm_cvtepi32_ps(pairReal<8>(v));
+    im = _mm_cvtepi32_ps(pairImag<8>(v));
+  }
+  static void storePairs(std::int16_t* p, const Reg re, const Reg im) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), joinPairs<16>(_mm_cvtps_epi32(re), _mm_cvtps_epi32(im)));
+  }
+  static void storePairs(std::int8_t* p, const Reg re, const Reg im) {
+    const __m128i pairs = joinPairs<8>(_mm_cvtps_epi32(re), _mm_cvtps_epi32(im));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(pairs, pairs));
+  }
+};
+
+#endif
+
+#if defined(MATH_SIMD_AVX2)
+
+template <int BITS>
+MATH_SIMD_INLINE __m256i pairReal(const __m256i v) {
+  return _mm256_srai_epi32(_mm256_slli_epi32(v, 32 - BITS), 32 - BITS);
+}
+template <int BITS>
+MATH_SIMD_INLINE __m256i pairImag(const __m256i v) {
+  return _mm256_srai_epi32(v, BITS);
+}
+template <int BITS>
+MATH_SIMD_INLINE __m256i joinPairs(const __m256i re, const __m256i im) {
+  return _mm256_or_si256(_mm256_and_si256(re, _mm256_set1_epi32((1 << BITS) - 1)), _mm256_slli_epi32(im, BITS));
+}
+/// @return int8 pairs of 32-bit lanes narrowed to 16 bits
+MATH_SIMD_INLINE __m128i narrow16(const __m256i v) {
+  return _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+template <>
+struct PackTraits<double, 4> {
+  using Reg = __m256d;
+  using MaskReg = __m256d;
+  static constexpr bool FUSED = true;
+
+  static Reg set1(const double x) { return _mm256_set1_pd(x); }
+  static Reg load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* p, const Reg v) { _mm256_storeu_pd(p, v); }
+  static Reg gather(const double* p, const std::uint32_t* indices) {
+    return _mm256_i32gather_pd(p, _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices)), 8);
+  }
+  static void scatter(double* p, const std::uint32_t* indices, const Reg v) {
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, v);
+    for (std::size_t i = 0; i < 4; ++i) p[indices[i]] = lanes[i];
+  }
+  static Reg add(const Reg a, const Reg b) { return _mm256_add_pd(a, b); }
+  static Reg sub(const Reg a, const Reg b) { return _mm256_sub_pd(a, b); }
+  static Reg mul(const Reg a, const Reg b) { return _mm256_mul_pd(a, b); }
+  static Reg div(const Reg a, const Reg b) { return _mm256_div_pd(a, b); }
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return _mm256_fmadd_pd(a, b, c); }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return _mm256_fmsub_pd(a, b, c); }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return _mm256_fnmadd_pd(a, b, c); }
+  static Reg sqrt(const Reg a) { return _mm256_sqrt_pd(a); }
+  static Reg abs(const Reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+  static Reg min(const Reg a, const Reg b) { return _mm256_min_pd(a, b); }
+  static Reg max(const Reg a, const Reg b) { return _mm256_max_pd(a, b); }
+  static Reg copysign(const Reg mag, const Reg sign) {
+    const Reg mask = _mm256_set1_pd(-0.0);
+    return _mm256_or_pd(_mm256_andnot_pd(mask, mag), _mm256_and_pd(mask, sign));
+  }
+  static MaskReg lt(const Reg a, const Reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+  static MaskReg le(const Reg a, const Reg b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+  static MaskReg eq(const Reg a, const Reg b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+  static MaskReg signbit(const Reg a) {
+    return _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_setzero_si256(), _mm256_castpd_si256(a)));
+  }
+  static Reg blend(const MaskReg m, const Reg a, const Reg b) { return _mm256_blendv_pd(b, a, m); }
+  static MaskReg maskAnd(const MaskReg a, const MaskReg b) { return _mm256_and_pd(a, b); }
+  static MaskReg maskOr(const MaskReg a, const MaskReg b) { return _mm256_or_pd(a, b); }
+  static MaskReg maskNot(const MaskReg a) { return _mm256_xor_pd(a, _mm256_castsi256_pd(_mm256_set1_epi32(-1))); }
+  static bool any(const MaskReg m) { return _mm256_movemask_pd(m) != 0; }
+  static bool all(const MaskReg m) { return _mm256_movemask_pd(m) == 0xF; }
+  static Reg round(const Reg a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static Reg pow2(const Reg n) {
+    const __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(4503599627371519.0)));
+    return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+  }
+  static Reg exponent(const Reg a) {
+    const __m256i bits = _mm256_srli_epi64(_mm256_castpd_si256(a), 52);
+    const Reg biased = _mm256_or_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(0x1p52));
+    return _mm256_sub_pd(biased, _mm256_set1_pd(0x1p52 + 1022));
+  }
+  static Reg mantissa(const Reg a) {
+    const Reg mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFF));
+    return _mm256_or_pd(_mm256_and_pd(a, mask), _mm256_set1_pd(0.5));
+  }
+  static void loadPairs(const std::int16_t* p, Reg& re, Reg& im) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    re = _mm256_cvtepi32_pd(pairReal<16>(v));
+    im = _mm256_cvtepi32_pd(pairImag<16>(v));
+  }
+  static void loadPairs(const std::int8_t* p, Reg& re, Reg& im) {
+    const __m128i v = _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+    re = _mm256_cvtepi32_pd(pairReal<8>(v));
+    im = _mm256_cvtepi32_pd(pairImag<8>(v));
+  }
+  static void storePairs(std::int16_t* p, const Reg re, const Reg im) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), joinPairs<16>(_mm256_cvtpd_epi32(re), _mm256_cvtpd_epi32(im)));
+  }
+  static void storePairs(std::int8_t* p, const Reg re, const Reg im) {
+    const __m128i pairs = joinPairs<8>(_mm256_cvtpd_epi32(re), _mm256_cvtpd_epi32(im));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(pairs, pairs));
+  }
+};
+
+template <>
+struct PackTraits<float, 8> {
+  using Reg = __m256;
+  using MaskReg = __m256;
+  static constexpr bool FUSED = true;
+
+  static Reg set1(const float x) { return _mm256_set1_ps(x); }
+  static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, const Reg v) { _mm256_storeu_ps(p, v); }
+  static Reg gather(const float* p, const std::uint32_t* indices) {
+    return _mm256_i32gather_ps(p, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices)), 4);
+  }
+  static void scatter(float* p, const std::uint32_t* indices, const Reg v) {
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, v);
+    for (std::size_t i = 0; i < 8; ++i) p[indices[i]] = lanes[i];
+  }
+  static Reg add(const Reg a, const Reg b) { return _mm256_add_ps(a, b); }
+  static Reg sub(const Reg a, const Reg b) { return _mm256_sub_ps(a, b); }
+  static Reg mul(const Reg a, const Reg b) { return _mm256_mul_ps(a, b); }
+  static Reg div(const Reg a, const Reg b) { return _mm256_div_ps(a, b); }
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return _mm256_fmadd_ps(a, b, c); }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return _mm256_fmsub_ps(a, b, c); }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return _mm256_fnmadd_ps(a, b, c); }
+  static Reg sqrt(const Reg a) { return _mm256_sqrt_ps(a); }
+  static Reg abs(const Reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), a); }
+  static Reg min(const Reg a, const Reg b) { return _mm256_min_ps(a, b); }
+  static Reg max(const Reg a, const Reg b) { return _mm256_max_ps(a, b); }
+  static Reg copysign(const Reg mag, const Reg sign) {
+    const Reg mask = _mm256_set1_ps(-0.0F);
+    return _mm256_or_ps(_mm256_andnot_ps(mask, mag), _mm256_and_ps(mask, sign));
+  }
+  static MaskReg lt(const Reg a, const Reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static MaskReg le(const Reg a, const Reg b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+  static MaskReg eq(const Reg a, const Reg b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+  static MaskReg signbit(const Reg a) { return _mm256_castsi256_ps(_mm256_srai_epi32(_mm256_castps_si256(a), 31)); }
+  static Reg blend(const MaskReg m, const Reg a, const Reg b) { return _mm256_blendv_ps(b, a, m); }
+  static MaskReg maskAnd(const MaskReg a, const MaskReg b) { return _mm256_and_ps(a, b); }
+  static MaskReg maskOr(const MaskReg a, const MaskReg b) { return _mm256_or_ps(a, b); }
+  static MaskReg maskNot(const MaskReg a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+  static bool any(const MaskReg m) { return _mm256_movemask_ps(m) != 0; }
+  static bool all(const MaskReg m) { return _mm256_movemask_ps(m) == 0xFF; }
+  static Reg round(const Reg a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static Reg pow2(const Reg n) {
+    const __m256i bits = _mm256_castps_si256(_mm256_add_ps(n, _mm256_set1_ps(8388735.0F)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 23));
+  }
+  static Reg exponent(const Reg a) {
+    const __m256i bits = _mm256_srli_epi32(_mm256_castps_si256(a), 23);
+    const Reg biased = _mm256_or_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(0x1p23F));
+    return _mm256_sub_ps(biased, _mm256_set1_ps(0x1p23F + 126));
+  }
+  static Reg mantissa(const Reg a) {
+    const Reg mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF));
+    return _mm256_or_ps(_mm256_and_ps(a, mask), _mm256_set1_ps(0.5F));
+  }
+  static void loadPairs(const std::int16_t* p, Reg& re, Reg& im) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    re = _mm256_cvtepi32_ps(pairReal<16>(v));
+    im = _mm256_cvtepi32_ps(pairImag<16>(v));
+  }
+  static void loadPairs(const std::int8_t* p, Reg& re, Reg& im) {
+    const __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    re = _mm256_cvtepi32_ps(pairReal<8>(v));
+    im = _mm256_cvtepi32_ps(pairImag<8>(v));
+  }
+  static void storePairs(std::int16_t* p, const Reg re, const Reg im) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), joinPairs<16>(_mm256_cvtps_epi32(re), _mm256_cvtps_epi32(im)));
+  }
+  static void storePairs(std::int8_t* p, const Reg re, const Reg im) {
+    const __m256i pairs = joinPairs<8>(_mm256_cvtps_epi32(re), _mm256_cvtps_epi32(im));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), narrow16(pairs));
+  }
+};
+
+#endif
+
+#if defined(MATH_SIMD_AVX512)
+
+template <int BITS>
+MATH_SIMD_INLINE __m512i pairReal(const __m512i v) {
+  return _mm512_srai_epi32(_mm512_slli_epi32(v, 32 - BITS), 32 - BITS);
+}
+template <int BITS>
+MATH_SIMD_INLINE __m512i pairImag(const __m512i v) {
+  return _mm512_srai_epi32(v, BITS);
+}
+template <int BITS>
+MATH_SIMD_INLINE __m512i joinPairs(const __m512i re, const __m512i im) {
+  return _mm512_or_si512(_mm512_and_si512(re, _mm512_set1_epi32((1 << BITS) - 1)), _mm512_slli_epi32(im, BITS));
+}
+
+template <>
+struct PackTraits<double, 8> {
+  using Reg = __m512d;
+  using MaskReg = __mmask8;
+  static constexpr bool FUSED = true;
+
+  static Reg set1(const double x) { return _mm512_set1_pd(x); }
+  static Reg load(const double* p) { return _mm512_loadu_pd(p); }
+  static void store(double* p, const Reg v) { _mm512_storeu_pd(p, v); }
+  static Reg gather(const double* p, const std::uint32_t* indices) {
+    return _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices)), p, 8);
+  }
+  static void scatter(double* p, const std::uint32_t* indices, const Reg v) {
+    _mm512_i32scatter_pd(p, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices)), v, 8);
+  }
+  static Reg add(const Reg a, const Reg b) { return _mm512_add_pd(a, b); }
+  static Reg sub(const Reg a, const Reg b) { return _mm512_sub_pd(a, b); }
+  static Reg mul(const Reg a, const Reg b) { return _mm512_mul_pd(a, b); }
+  static Reg div(const Reg a, const Reg b) { return _mm512_div_pd(a, b); }
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return _mm512_fmadd_pd(a, b, c); }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return _mm512_fmsub_pd(a, b, c); }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return _mm512_fnmadd_pd(a, b, c); }
+  static Reg sqrt(const Reg a) { return _mm512_sqrt_pd(a); }
+  static Reg abs(const Reg a) { return _mm512_abs_pd(a); }
+  static Reg min(const Reg a, const Reg b) { return _mm512_min_pd(a, b); }
+  static Reg max(const Reg a, const Reg b) { return _mm512_max_pd(a, b); }
+  static Reg copysign(const Reg mag, const Reg sign) {
+    const __m512i mask = _mm512_set1_epi64(INT64_MIN);
+    const __m512i bits = _mm512_ternarylogic_epi64(mask, _mm512_castpd_si512(sign), _mm512_castpd_si512(mag), 0xCA);
+    return _mm512_castsi512_pd(bits);
+  }
+  static MaskReg lt(const Reg a, const Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+  static MaskReg le(const Reg a, const Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+  static MaskReg eq(const Reg a, const Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+  static MaskReg signbit(const Reg a) {
+    return _mm512_cmplt_epi64_mask(_mm512_castpd_si512(a), _mm512_setzero_si512());
+  }
+  static Reg blend(const MaskReg m, const Reg a, const Reg b) { return _mm512_mask_blend_pd(m, b, a); }
+  static MaskReg maskAnd(const MaskReg a, const MaskReg b) { return a & b; }
+  static MaskReg maskOr(const MaskReg a, const MaskReg b) { return a | b; }
+  static MaskReg maskNot(const MaskReg a) { return static_cast<MaskReg>(~a); }
+  static bool any(const MaskReg m) { return m != 0; }
+  static bool all(const MaskReg m) { return m == 0xFF; }
+  static Reg round(const Reg a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static Reg pow2(const Reg n) {
+    const __m512i bits = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(4503599627371519.0)));
+    return _mm512_castsi512_pd(_mm512_slli_epi64(bits, 52));
+  }
+  static Reg exponent(const Reg a) { return _mm512_add_pd(_mm512_getexp_pd(a), _mm512_set1_pd(1)); }
+  static Reg mantissa(const Reg a) { return _mm512_getmant_pd(a, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_zero); }
+  static void loadPairs(const std::int16_t* p, Reg& re, Reg& im) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    re = _mm512_cvtepi32_pd(pairReal<16>(v));
+    im = _mm512_cvtepi32_pd(pairImag<16>(v));
+  }
+  static void loadPairs(const std::int8_t* p, Reg& re, Reg& im) {
+    const __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    re = _mm512_cvtepi32_pd(pairReal<8>(v));
+    im = _mm512_cvtepi32_pd(pairImag<8>(v));
+  }
+  static void storePairs(std::int16_t* p, const Reg re, const Reg im) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), joinPairs<16>(_mm512_cvtpd_epi32(re), _mm512_cvtpd_epi32(im)));
+  }
+  static void storePairs(std::int8_t* p, const Reg re, const Reg im) {
+    const __m256i pairs = joinPairs<8>(_mm512_cvtpd_epi32(re), _mm512_cvtpd_epi32(im));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), narrow16(pairs));
+  }
+};
+
+template <>
+struct PackTraits<float, 16> {
+  using Reg = __m512;
+  using MaskReg = __mmask16;
+  static constexpr bool FUSED = true;
+
+  static Reg set1(const float x) { return _mm512_set1_ps(x); }
+  static Reg load(const float* p) { return _mm512_loadu_ps(p); }
+  static void store(float* p, const Reg v) { _mm512_storeu_ps(p, v); }
+  static Reg gather(const float* p, const std::uint32_t* indices) {
+    return _mm512_i32gather_ps(_mm512_loadu_si512(indices), p, 4);
+  }
+  static void scatter(float* p, const std::uint32_t* indices, const Reg v) {
+    _mm512_i32scatter_ps(p, _mm512_loadu_si512(indices), v, 4);
+  }
+  static Reg add(const Reg a, const Reg b) { return _mm512_add_ps(a, b); }
+  static Reg sub(const Reg a, const Reg b) { return _mm512_sub_ps(a, b); }
+  static Reg mul(const Reg a, const Reg b) { return _mm512_mul_ps(a, b); }
+  static Reg div(const Reg a, const Reg b) { return _mm512_div_ps(a, b); }
+  static Reg fmadd(const Reg a, const Reg b, const Reg c) { return _mm512_fmadd_ps(a, b, c); }
+  static Reg fmsub(const Reg a, const Reg b, const Reg c) { return _mm512_fmsub_ps(a, b, c); }
+  static Reg fnmadd(const Reg a, const Reg b, const Reg c) { return _mm512_fnmadd_ps(a, b, c); }
+  static Reg sqrt(const Reg a) { return _mm512_sqrt_ps(a); }
+  static Reg abs(const Reg a) { return _mm512_abs_ps(a); }
+  static Reg min(const Reg a, const Reg b) { return _mm512_min_ps(a, b); }
+  static Reg max(const Reg a, const Reg b) { return _mm512_max_ps(a, b); }
+  static Reg copysign(const Reg mag, const Reg sign) {
+    const __m512i mask = _mm512_set1_epi32(INT32_MIN);
+    const __m512i bits = _mm512_ternarylogic_epi32(mask, _mm512_castps_si512(sign), _mm512_castps_si512(mag), 0xCA);
+    return _mm512_castsi512_ps(bits);
+  }
+  static MaskReg lt(const Reg a, const Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+  static MaskReg le(const Reg a, const Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+  static MaskReg eq(const Reg a, const Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+  static MaskReg signbit(const Reg a) {
+    return _mm512_cmplt_epi32_mask(_mm512_castps_si512(a), _mm512_setzero_si512());
+  }
+  static Reg blend(const MaskReg m, const Reg a, const Reg b) { return _mm512_mask_blend_ps(m, b, a); }
+  static MaskReg maskAnd(const MaskReg a, const MaskReg b) { return a & b; }
+  static MaskReg maskOr(const MaskReg a, const MaskReg b) { return a | b; }
+  static MaskReg maskNot(const MaskReg a) { return static_cast<MaskReg>(~a); }
+  static bool any(const MaskReg m) { return m != 0; }
+  static bool all(const MaskReg m) { return m == 0xFFFF; }
+  static Reg round(const Reg a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static Reg pow2(const Reg n) {
+    const __m512i bits = _mm512_castps_si512(_mm512_add_ps(n, _mm512_set1_ps(8388735.0F)));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(bits, 23));
+  }
+  static Reg exponent(const Reg a) { return _mm512_add_ps(_mm512_getexp_ps(a), _mm512_set1_ps(1)); }
+  static Reg mantissa(const Reg a) { return _mm512_getmant_ps(a, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_zero); }
+  static void loadPairs(const std::int16_t* p, Reg& re, Reg& im) {
+    const __m512i v = _mm512_loadu_si512(p);
+    re = _mm512_cvtepi32_ps(pairReal<16>(v));
+    im = _mm512_cvtepi32_ps(pairImag<16>(v));
+  }
+  static void loadPairs(const std::int8_t* p, Reg& re, Reg& im) {
+    const __m512i v = _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+    re = _mm512_cvtepi32_ps(pairReal<8>(v));
+    im = _mm512_cvtepi32_ps(pairImag<8>(v));
+  }
+  static void storePairs(std::int16_t* p, const Reg re, const Reg im) {
+    _mm512_storeu_si512(p, joinPairs<16>(_mm512_cvtps_epi32(re), _mm512_cvtps_epi32(im)));
+  }
+  static void storePairs(std::int8_t* p, const Reg re, const Reg im) {
+    const __m512i pairs = joinPairs<8>(_mm512_cvtps_epi32(re), _mm512_cvtps_epi32(im));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtepi32_epi16(pairs));
+  }
+};
+
+#endif
+
+/// Number of lanes of the widest vector of the current target for type T
+template <typename T>
+constexpr std::size_t NATIVE_WIDTH = 1;
+#if defined(MATH_SIMD_AVX512)
+template <>
+constexpr std::size_t NATIVE_WIDTH<double> = 8;
+template <>
+constexpr std::size_t NATIVE_WIDTH<float> = 16;
+#elif defined(MATH_SIMD_AVX2)
+template <>
+constexpr std::size_t NATIVE_WIDTH<double> = 4;
+template <>
+constexpr std::size_t NATIVE_WIDTH<float> = 8;
+#elif defined(MATH_SIMD_SSE2)
+template <>
+constexpr std::size_t NATIVE_WIDTH<double> = 2;
+template <>
+constexpr std::size_t NATIVE_WIDTH<float> = 4;
+#endif
+
+/// Lane-wise comparison result of two packs
+template <typename T, std::size_t W>
+struct PackMask {
+  using Traits = PackTraits<T, W>;
+  typename Traits::MaskReg m;
+
+  friend PackMask operator&(const PackMask a, const PackMask b) { return {Traits::maskAnd(a.m, b.m)}; }
+  friend PackMask operator|(const PackMask a, const PackMask b) { return {Traits::maskOr(a.m, b.m)}; }
+  friend PackMask operator!(const PackMask a) { return {Traits::maskNot(a.m)}; }
+  friend bool any(const PackMask a) { return Traits::any(a.m); }
+  friend bool all(const PackMask a) { return Traits::all(a.m); }
+};
+
+/// Vector of W lanes of type T
+template <typename T, std::size_t W>
+struct Pack {
+  using Traits = PackTraits<T, W>;
+  using Reg = typename Traits::Reg;
+  using Mask = PackMask<T, W>;
+  using value_type = T;
+  static constexpr std::size_t width = W;
+
+  Reg v;
+
+  Pack() : v(Traits::set1(T(0))) {}
+  explicit Pack(const T x) : v(Traits::set1(x)) {}
+
+  static Pack fromRegister(const Reg r) {
+    Pack p;
+    p.v = r;
+    return p;
+  }
+  static Pack load(const T* p) { return fromRegister(Traits::load(p)); }
+  void store(T* p) const { Traits::store(p, v); }
+
+  /// Loads the elements p[indices[i]] of W indices below 2^31
+  static Pack gather(const T* p, const std::uint32_t* indices) { return fromRegister(Traits::gather(p, indices)); }
+  /// Stores the lanes to p[indices[i]] for W distinct indices below 2^31
+  void scatter(T* p, const std::uint32_t* indices) const { Traits::scatter(p, indices, v); }
+
+  /// Loads W interleaved pairs of int8_t or int16_t, real parts first, and converts them exactly
+  template <typename Q>
+  static void loadPairs(const Q* p, Pack& re, Pack& im) {
+    Traits::loadPairs(p, re.v, im.v);
+  }
+  /// Rounds to the nearest integer, ties to even, and stores W interleaved pairs of int8_t or int16_t. The values
+  /// must be in the range of Q.
+  template <typename Q>
+  static void storePairs(Q* p, const Pack re, const Pack im) {
+    Traits::storePairs(p, re.v, im.v);
+  }
+
+  Pack& operator+=(const Pack rhs) { return *this = *this + rhs; }
+  Pack& operator-=(const Pack rhs) { return *this = *this - rhs; }
+  Pack& operator*=(const Pack rhs) { return *this = *this * rhs; }
+  Pack& operator/=(const Pack rhs) { return *this = *this / rhs; }
+
+  friend Pack operator+(const Pack a, const Pack b) { return fromRegister(Traits::add(a.v, b.v)); }
+  friend Pack operator-(const Pack a, const Pack b) { return fromRegister(Traits::sub(a.v, b.v)); }
+  friend Pack operator*(const Pack a, const Pack b) { return fromRegister(Traits::mul(a.v, b.v)); }
+  friend Pack operator/(const Pack a, const Pack b) { return fromRegister(Traits::div(a.v, b.v)); }
+  friend Pack operator-(const Pack a) { return fromRegister(Traits::sub(Traits::set1(T(0)), a.v)); }
+  friend Mask operator<(const Pack a, const Pack b) { return {Traits::lt(a.v, b.v)}; }
+  friend Mask operator<=(const Pack a, const Pack b) { return {Traits::le(a.v, b.v)}; }
+  friend Mask operator>(const Pack a, const Pack b) { return {Traits::lt(b.v, a.v)}; }
+  friend Mask operator>=(const Pack a, const Pack b) { return {Traits::le(b.v, a.v)}; }
+  friend Mask operator==(const Pack a, const Pack b) { return {Traits::eq(a.v, b.v)}; }
+
+  /// @return a * b + c
+  friend Pack mulAdd(const Pack a, const Pack b, const Pack c) { return fromRegister(Traits::fmadd(a.v, b.v, c.v)); }
+  /// @return a * b - c
+  friend Pack mulSub(const Pack a, const Pack b, const Pack c) { return fromRegister(Traits::fmsub(a.v, b.v, c.v)); }
+  /// @return c - a * b
+  friend Pack negMulAdd(const Pack a, const Pack b, const Pack c) {
+    return fromRegister(Traits::fnmadd(a.v, b.v, c.v));
+  }
+  friend Pack sqrt(const Pack a) { return fromRegister(Traits::sqrt(a.v)); }
+  friend Pack abs(const Pack a) { return fromRegister(Traits::abs(a.v)); }
+  friend Pack min(const Pack a, const Pack b) { return fromRegister(Traits::min(a.v, b.v)); }
+  friend Pack max(const Pack a, const Pack b) { return fromRegister(Traits::max(a.v, b.v)); }
+  friend Pack copysign(const Pack mag, const Pack sign) { return fromRegister(Traits::copysign(mag.v, sign.v)); }
+  friend Mask signbit(const Pack a) { return {Traits::signbit(a.v)}; }
+  /// @return Lane-wise m ? a : b
+  friend Pack select(const Mask m, const Pack a, const Pack b) { return fromRegister(Traits::blend(m.m, a.v, b.v)); }
+  /// Rounds to the nearest integer, ties to even. The SSE2 version is exact for |a| < 2^51 (float: 2^22).
+  friend Pack round(const Pack a) { return fromRegister(Traits::round(a.v)); }
+  /// @return 2^n for integer valued n in the normal exponent range
+  friend Pack pow2(const Pack n) { return fromRegister(Traits::pow2(n.v)); }
+  /// @return Exponent e of a = m * 2^e with m in [0.5, 1), for positive normal a
+  friend Pack exponent(const Pack a) { return fromRegister(Traits::exponent(a.v)); }
+  /// @return Mantissa m of a = m * 2^e with m in [0.5, 1), for positive normal a
+  friend Pack mantissa(const Pack a) { return fromRegister(Traits::mantissa(a.v)); }
+};
+
+/// Widest pack of the current target
+template <typename T>
+using Native = Pack<T, NATIVE_WIDTH<T>>;
+
+/// Single lane pack used for loop remainders
+template <typename T>
+using Single = Pack<T, 1>;
+
+}  // namespace MATH_SIMD_TARGET
+}  // namespace Math::Simd
+
+#endif  // MATH_SIMD_PACK_H
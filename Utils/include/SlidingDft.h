@@ -0,0 +1,144 @@
+#ifndef MATH_SLIDING_DFT_H
+#define MATH_SLIDING_DFT_H
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "AlignedAllocator.h"
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "SplitSpan.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Number of windows after which a sliding DFT recomputes its bins by default
+constexpr size_t SLIDING_DFT_RESYNC_WINDOWS = 8;
+
+/// Sliding DFT of a stream at selected bins, X_k = sum w[m] exp(-2 pi i k m / N) over the window w of the last N
+/// samples, updated after every sample by X_k <- (X_k + x_new - x_old) exp(2 pi i k / N) at O(bins) per sample. The
+/// bins are vectorized, and packs of bins run through a block of samples in registers. The recurrence has its poles
+/// on the unit circle, so rounding errors are never damped and the rounded twiddles do not cancel the samples that
+/// leave the window exactly; every resyncWindows windows the bins are recomputed from the samples of the window,
+/// which bounds the error by that of (resyncWindows + 1) N steps. Before the first N samples the window is padded
+/// with zeros. The transform keeps its window between calls, use one per stream.
+template <scalar T>
+class BasicSlidingDft {
+protected:
+  size_t m_WindowSize;
+  /// Number of samples between recomputations
+  std::size_t m_ResyncPeriod;
+  std::vector<size_t> m_Bins;
+  /// exp(2 pi i k / N) of the bins
+  BasicComplexArray<T> m_Twiddles;
+  BasicComplexArray<T> m_Spectrum;
+  /// The window starts at m_Position, new samples are appended after it until the buffer is full
+  BasicComplexArray<T> m_Buffer;
+  size_t m_Position;
+  /// Differences of the new samples and the ones that leave the window
+  BasicComplexArray<T> m_Delta;
+  std::size_t m_Elapsed;
+
+  void resync();
+  void slide(SplitSpan<const T> samples, SplitSpan<T> spectra);
+
+public:
+  /// Creates a transform of a window of zeros
+  /// @param windowSize N, between 1 and MAX_ELEMENT_COUNT / 2
+  /// @param bins Indices k < N of the bins
+  /// @param resyncWindows Number of windows between the recomputations of the bins, at least 1
+  BasicSlidingDft(size_t windowSize, std::span<const size_t> bins, size_t resyncWindows = SLIDING_DFT_RESYNC_WINDOWS);
+
+  [[nodiscard]] size_t windowSize() const { return m_WindowSize; }
+  [[nodiscard]] std::span<const size_t> bins() const { return m_Bins; }
+
+  /// @return X_k of the current window for the bins, in the order of bins()
+  [[nodiscard]] SplitSpan<const T> spectrum() const { return m_Spectrum.view(); }
+
+  /// @return X_k of the current window for the i-th bin
+  [[nodiscard]] BasicComplex<T> operator[](const size_t i) const {
+    return BasicComplex<T>(m_Spectrum.real()[i], m_Spectrum.imag()[i]);
+  }
+
+  /// Slides the window by one sample
+  /// @param sample Next sample of the stream
+  void update(const BasicComplex<T>& sample);
+
+  /// Slides the window over the next samples of the stream
+  /// @param samples Samples
+  void update(std::type_identity_t<SplitSpan<const T>> samples);
+
+  /// Slides the window over the next samples of the stream
+  /// @param samples Interleaved samples
+  void update(std::type_identity_t<std::span<const BasicComplex<T>>> samples);
+
+  /// Slides the window over the next samples of the stream and writes the spectrum after every sample
+  /// @param samples Samples
+  /// @param spectra samples.size() * bins().size() numbers, the spectrum after sample t at t * bins().size()
+  void update(std::type_identity_t<SplitSpan<const T>> samples, SplitSpan<T> spectra);
+
+  /// Clears the window, so that the next sample starts a new stream
+  void reset();
+};
+
+/// Bank of Goertzel detectors, the DFT X(w) = sum x[n] exp(-i w n) of consecutive blocks of blockSize samples at
+/// arbitrary frequencies w. Every sample advances the second order recurrence s <- x + 2 cos(w) s1 - s2 of every
+/// frequency, two real multiply-adds instead of a complex multiplication, vectorized over the frequencies; the end of
+/// a block combines the last two states into X(w) and starts the next block from zero. Blocks may span calls, use
+/// one bank per stream.
+template <scalar T>
+class BasicGoertzelBank {
+protected:
+  size_t m_BlockSize;
+  std::vector<T> m_Frequencies;
+  /// 2 cos(w)
+  AlignedVector<T> m_Coefficients;
+  /// X(w) = m_Last * s1 + m_BeforeLast * s2 after the last sample of a block
+  BasicComplexArray<T> m_Last;
+  BasicComplexArray<T> m_BeforeLast;
+  BasicComplexArray<T> m_S1;
+  BasicComplexArray<T> m_S2;
+  BasicComplexArray<T> m_Scratch;
+  /// Samples of the current block
+  size_t m_Position;
+
+  void finish(SplitSpan<T> out);
+
+public:
+  /// Creates a bank at the start of a block
+  /// @param frequencies Frequencies w in radians per sample
+  /// @param blockSize Number of samples per block, at least 1
+  BasicGoertzelBank(std::span<const T> frequencies, size_t blockSize);
+
+  [[nodiscard]] size_t blockSize() const { return m_BlockSize; }
+  [[nodiscard]] std::span<const T> frequencies() const { return m_Frequencies; }
+
+  /// @param inputSize Number of samples of the next call of process
+  /// @return Number of results that it writes, frequencies().size() per completed block
+  [[nodiscard]] std::size_t outputSize(std::size_t inputSize) const;
+
+  /// Feeds the next samples of the stream
+  /// @param in Samples
+  /// @param out X(w) of every block that completes, at least outputSize(in.size()) numbers, in the order of
+  /// frequencies() per block
+  /// @return Number of results written
+  std::size_t process(std::type_identity_t<SplitSpan<const T>> in, SplitSpan<T> out);
+
+  /// Feeds the next samples of the stream
+  /// @param in Interleaved samples
+  /// @param out X(w) of every block that completes, at least outputSize(in.size()) numbers
+  /// @return Number of results written
+  std::size_t process(std::type_identity_t<std::span<const BasicComplex<T>>> in, SplitSpan<T> out);
+
+  /// Discards the samples of the current block
+  void reset();
+};
+
+using SlidingDft = BasicSlidingDft<real_t>;
+using GoertzelBank = BasicGoertzelBank<real_t>;
+
+}  // namespace Math
+
+#endif  // MATH_SLIDING_DFT_H
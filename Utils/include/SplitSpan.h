@@ -0,0 +1,71 @@
+#ifndef MATH_SPLIT_SPAN_H
+#define MATH_SPLIT_SPAN_H
+
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Complex.h"
+#include "Types.h"
+
+namespace Math {
+
+/// Non-owning view of complex numbers whose real and imaginary parts are stored in two separate arrays
+/// (structure of arrays). T may be const-qualified for read-only views.
+template <typename T>
+  requires scalar<std::remove_const_t<T>>
+class SplitSpan {
+protected:
+  T* m_Real = nullptr;
+  T* m_Imag = nullptr;
+  size_t m_Size = 0;
+
+public:
+  using value_type = BasicComplex<std::remove_const_t<T>>;
+
+  constexpr SplitSpan() = default;
+
+  /// Create a view of two arrays with the given number of elements
+  /// @param real Real parts
+  /// @param imag Imaginary parts
+  /// @param size Number of complex numbers
+  constexpr SplitSpan(T* real, T* imag, const size_t size) : m_Real(real), m_Imag(imag), m_Size(size) {}
+
+  /// Create a view of two spans of equal size
+  /// @param real Real parts
+  /// @param imag Imaginary parts
+  SplitSpan(const std::span<T> real, const std::span<T> imag)
+      : m_Real(real.data()), m_Imag(imag.data()), m_Size(static_cast<size_t>(real.size())) {
+    if (real.size() != imag.size()) throw std::invalid_argument("SplitSpan: real and imaginary parts differ in size");
+  }
+
+  /// Converts a mutable view into a read-only view
+  template <typename U>
+    requires(std::is_const_v<T> && std::same_as<const U, T>)
+  constexpr SplitSpan(const SplitSpan<U>& other)  // NOLINT(google-explicit-constructor)
+      : m_Real(other.realData()), m_Imag(other.imagData()), m_Size(other.size()) {}
+
+  constexpr size_t size() const { return m_Size; }
+  constexpr bool empty() const { return m_Size == 0; }
+  constexpr T* realData() const { return m_Real; }
+  constexpr T* imagData() const { return m_Imag; }
+  constexpr std::span<T> real() const { return {m_Real, m_Size}; }
+  constexpr std::span<T> imag() const { return {m_Imag, m_Size}; }
+
+  /// Get the complex number at position i
+  /// @param i Index
+  /// @return Copy of the element
+  constexpr value_type operator[](const size_t i) const { return value_type(m_Real[i], m_Imag[i]); }
+
+  /// Get a view of a contiguous part of the elements
+  /// @param offset Index of the first element
+  /// @param count Number of elements
+  /// @return View of the elements [offset, offset + count)
+  constexpr SplitSpan subspan(const size_t offset, const size_t count) const {
+    return SplitSpan(m_Real + offset, m_Imag + offset, count);
+  }
+};
+
+}  // namespace Math
+
+#endif  // MATH_SPLIT_SPAN_H
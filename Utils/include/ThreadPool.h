@@ -0,0 +1,177 @@
+#ifndef MATH_THREAD_POOL_H
+#define MATH_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Math {
+
+/// Order in which parallelReduce combines the results of the chunks
+enum class ReductionOrder : uint8_t {
+  /// Every thread folds the chunks it runs into one partial result. The fastest order, but the result can change in
+  /// the last bits from run to run when the combination is not associative, like a floating point sum.
+  Any,
+  /// Chunks of exactly grain indices, independent of the number of threads, whose results are combined pairwise in
+  /// index order, so the result is the same on every run and every pool
+  Deterministic
+};
+
+/// Fixed set of worker threads that execute one parallel loop at a time. The calling thread takes part in the loop,
+/// so a pool with threadCount() == 1 has no workers and runs everything inline. Loops that are started from inside a
+/// loop, or while another thread owns the pool, run serially on the calling thread.
+///
+/// The chunks of a loop are scheduled by work stealing: every thread starts on its own contiguous share of the range
+/// and takes chunks from its front, and a thread that runs out steals the back half of the largest remaining share.
+/// Loops of equal size and grain therefore give each thread the same part of the data unless the load is uneven,
+/// which keeps the data in the caches of that core and, with FirstTouchResource, on its NUMA node.
+class ThreadPool {
+protected:
+  /// Function that runs one chunk of a loop on the thread with the given index
+  using Chunk = std::function<void(std::size_t chunk, std::size_t thread)>;
+
+  /// Chunks [begin, end) that a thread has yet to run, packed into one word so that the owner and thieves update it
+  /// with a single compare-and-swap
+  struct alignas(64) Share {
+    std::atomic<uint64_t> range = 0;
+  };
+
+  /// Loop that is currently distributed over the workers
+  struct Job {
+    const Chunk* chunk = nullptr;
+    std::size_t chunkCount = 0;
+    std::atomic<std::size_t> done = 0;
+    std::exception_ptr error;
+    std::mutex errorMutex;
+  };
+
+  std::vector<std::thread> m_Workers;
+  std::unique_ptr<Share[]> m_Shares;
+  std::mutex m_Mutex;
+  std::condition_variable m_Wake;
+  std::condition_variable m_Finished;
+  std::mutex m_Submit;
+  Job* m_Job = nullptr;
+  uint64_t m_Generation = 0;
+  std::size_t m_Active = 0;
+  bool m_Stop = false;
+
+  void work(std::size_t thread);
+  bool popChunk(std::size_t thread, std::size_t& chunk);
+  bool stealChunk(std::size_t thread, std::size_t& chunk);
+  void runChunks(Job& job, std::size_t thread);
+  void run(std::size_t chunkCount, const Chunk& chunk);
+  [[nodiscard]] std::size_t chunkSize(std::size_t count, std::size_t grain) const;
+
+public:
+  /// Starts threadCount - 1 workers
+  /// @param threadCount Number of threads that execute a loop, including the caller, at least 1
+  explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  /// @return Number of threads that execute a loop, including the caller
+  [[nodiscard]] std::size_t threadCount() const { return m_Workers.size() + 1; }
+
+  /// Calls f(first, last) for chunks [first, last) that cover [begin, end) and waits for all calls to finish. The
+  /// range is split into about four chunks per thread, each of at least grain indices. The first exception thrown by
+  /// f is rethrown after the loop.
+  /// @param begin First index
+  /// @param end One past the last index
+  /// @param grain Minimum number of indices per chunk
+  /// @param f Function that is called with the bounds of each chunk
+  template <typename F>
+  void parallelForRange(const std::size_t begin, const std::size_t end, const std::size_t grain, F&& f) {
+    if (begin >= end) return;
+    const std::size_t size = chunkSize(end - begin, grain);
+    const std::size_t chunkCount = (end - begin + size - 1) / size;
+    if (chunkCount == 1 || m_Workers.empty()) {
+      f(begin, end);
+      return;
+    }
+    const Chunk chunk = [&](const std::size_t c, std::size_t /*thread*/) {
+      const std::size_t first = begin + c * size;
+      f(first, std::min(end, first + size));
+    };
+    run(chunkCount, chunk);
+  }
+
+  /// Calls f(i) for every i in [begin, end) and waits for all calls to finish. The range is split into chunks of at
+  /// least grain indices. The first exception thrown by f is rethrown after the loop, and the remaining indices of
+  /// the chunk that threw are skipped.
+  /// @param begin First index
+  /// @param end One past the last index
+  /// @param grain Minimum number of indices per chunk
+  /// @param f Function that is called with each index
+  template <typename F>
+  void parallelFor(const std::size_t begin, const std::size_t end, const std::size_t grain, F&& f) {
+    parallelForRange(begin, end, grain, [&](const std::size_t first, const std::size_t last) {
+      for (std::size_t i = first; i < last; ++i) f(i);
+    });
+  }
+
+  /// Reduces [begin, end) in parallel: f(first, last) reduces a chunk to a partial result, and combine(a, b) merges
+  /// two partial results. combine has to be associative, and commutative unless the order is deterministic, in which
+  /// a always covers lower indices than b; floating point sums are both up to rounding. The first exception thrown by
+  /// f or combine is rethrown after the loop.
+  /// @param begin First index
+  /// @param end One past the last index
+  /// @param grain Minimum number of indices per chunk, the exact number for ReductionOrder::Deterministic
+  /// @param identity Result of an empty range, and the start of every partial result
+  /// @param f Function that reduces the indices [first, last)
+  /// @param combine Function that merges two partial results
+  /// @param order Whether the result has to be reproducible
+  /// @return combine of the results of all chunks
+  template <typename T, typename F, typename Combine>
+  T parallelReduce(const std::size_t begin, const std::size_t end, const std::size_t grain, const T& identity, F&& f,
+                   Combine&& combine, const ReductionOrder order = ReductionOrder::Any) {
+    if (begin >= end) return identity;
+    if (order == ReductionOrder::Deterministic) {
+      const std::size_t size = std::max<std::size_t>({grain, 1, (end - begin - 1) / UINT32_MAX + 1});
+      const std::size_t chunkCount = (end - begin + size - 1) / size;
+      std::vector<T> partial(chunkCount, identity);
+      const Chunk chunk = [&](const std::size_t c, std::size_t /*thread*/) {
+        const std::size_t first = begin + c * size;
+        partial[c] = combine(identity, f(first, std::min(end, first + size)));
+      };
+      run(chunkCount, chunk);
+      for (std::size_t step = 1; step < chunkCount; step *= 2) {
+        for (std::size_t c = 0; c + step < chunkCount; c += 2 * step) {
+          partial[c] = combine(partial[c], partial[c + step]);
+        }
+      }
+      return partial[0];
+    }
+    struct alignas(64) Partial {
+      T value;
+    };
+    std::vector<Partial> partial(threadCount(), Partial{identity});
+    const std::size_t size = chunkSize(end - begin, grain);
+    const Chunk chunk = [&](const std::size_t c, const std::size_t thread) {
+      const std::size_t first = begin + c * size;
+      partial[thread].value = combine(partial[thread].value, f(first, std::min(end, first + size)));
+    };
+    run((end - begin + size - 1) / size, chunk);
+    T result = partial[0].value;
+    for (std::size_t thread = 1; thread < partial.size(); ++thread) result = combine(result, partial[thread].value);
+    return result;
+  }
+};
+
+/// Get the pool shared by the library, with one thread per hardware thread
+/// @return Process wide thread pool
+ThreadPool& defaultThreadPool();
+
+}  // namespace Math
+
+#endif  // MATH_THREAD_POOL_H
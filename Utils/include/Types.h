@@ -1,25 +1,59 @@
 #ifndef MATH_TYPES_H
 #define MATH_TYPES_H
 
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+
+// Precision of real_t, set by the CMake options of the same names:
+//   MATH_DOUBLE_PRECISION=1 (default)  real_t is double
+//   MATH_DOUBLE_PRECISION=0            real_t is float
+//   MATH_MIXED_PRECISION=1             real_t is float, reductions and FFT butterflies on float data accumulate in
+//                                      double (see accumulator_t), regardless of MATH_DOUBLE_PRECISION
+#ifndef MATH_DOUBLE_PRECISION
+#define MATH_DOUBLE_PRECISION 1
+#endif
+#ifndef MATH_MIXED_PRECISION
+#define MATH_MIXED_PRECISION 0
+#endif
 
 namespace Math {
 
-// #define MATH_DOUBLE_PRECISION
-
 using size_t = uint32_t;
 using index_t = int64_t;
+#if MATH_DOUBLE_PRECISION && !MATH_MIXED_PRECISION
 using real_t = double;
+#else
+using real_t = float;
+#endif
 
 constexpr size_t MAX_ELEMENT_COUNT = 10'000'000;
-constexpr real_t EPSILON = 1e-9;
+constexpr std::size_t MEMORY_ALIGNMENT = 64;
 
-/*
-using complex_t = std::complex<float>;
+/// Floating point types that can be used as the underlying type of a complex number
 template <typename T>
-concept scalar = std::is_same_v<T, real_t> || std::is_same_v<T, complex_t>;
-*/
-
+concept scalar = std::same_as<T, float> || std::same_as<T, double> || std::same_as<T, long double>;
+
+/// Absolute tolerance below which a value of type T is treated as zero
+template <scalar T>
+constexpr T EPSILON = std::same_as<T, float> ? T(1e-4) : std::same_as<T, double> ? T(1e-9) : T(1e-12);
+
+/// Type in which sums over many values of type T are accumulated: T itself, except for float in mixed precision
+template <scalar T>
+struct accumulator {
+  using type = T;
+};
+
+#if MATH_MIXED_PRECISION
+template <>
+struct accumulator<float> {
+  using type = double;
+};
+#endif
+
+template <scalar T>
+using accumulator_t = typename accumulator<T>::type;
 
 }  // namespace Math
 
@@ -1,9 +1,28 @@
 #ifndef MATH_UTILS_H
 #define MATH_UTILS_H
 
+#include "AlignedAllocator.h"
 #include "Complex.h"
+#include "ComplexArray.h"
+#include "ComplexDecomposition.h"
+#include "ComplexExpression.h"
+#include "ComplexFile.h"
+#include "ComplexFormat.h"
+#include "ComplexMath.h"
+#include "ComplexMatrix.h"
+#include "ComplexReduction.h"
+#include "ComplexSparse.h"
+#include "MemoryResource.h"
+#include "Oscillator.h"
+#include "Parallel.h"
+#include "Polynomial.h"
+#include "QuantizedArray.h"
+#include "SlidingDft.h"
 
 #include "Error.h"
+#include "Simd.h"
+#include "SplitSpan.h"
+#include "ThreadPool.h"
 #include "Types.h"
 
 #endif  // MATH_UTILS_H
@@ -0,0 +1,315 @@
+#include "ComplexArray.h"
+
+#include <stdexcept>
+
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+template <typename T>
+Kernels::Split<T> split(const SplitSpan<T> z) {
+  return {z.realData(), z.imagData()};
+}
+
+template <typename T>
+const Kernels::ElementwiseKernels<T>& kernels() {
+  return Kernels::table<T>().elementwise;
+}
+
+void checkSize(const std::size_t size, const std::size_t expected) {
+  if (size != expected) throw std::invalid_argument("ComplexArray: operands differ in size");
+}
+
+template <typename T>
+void arrayArray(const Kernels::BinaryOp op, const SplitSpan<const T> lhs, const SplitSpan<const T> rhs,
+                const SplitSpan<T> out) {
+  checkSize(lhs.size(), out.size());
+  checkSize(rhs.size(), out.size());
+  kernels<T>().arrayArray[op](split(lhs), split(rhs), split(out), out.size());
+}
+
+template <typename T>
+void arrayComplex(const Kernels::BinaryOp op, const SplitSpan<const T> lhs, const BasicComplex<T>& rhs,
+                  const SplitSpan<T> out) {
+  checkSize(lhs.size(), out.size());
+  kernels<T>().arrayComplex[op](split(lhs), rhs.real(), rhs.imag(), split(out), out.size());
+}
+
+template <typename T>
+void complexArray(const Kernels::BinaryOp op, const BasicComplex<T>& lhs, const SplitSpan<const T> rhs,
+                  const SplitSpan<T> out) {
+  checkSize(rhs.size(), out.size());
+  kernels<T>().complexArray[op](lhs.real(), lhs.imag(), split(rhs), split(out), out.size());
+}
+
+template <typename T>
+void arrayReal(const Kernels::BinaryOp op, const SplitSpan<const T> lhs, const T rhs, const SplitSpan<T> out) {
+  checkSize(lhs.size(), out.size());
+  kernels<T>().arrayReal[op](split(lhs), rhs, split(out), out.size());
+}
+
+template <typename T>
+void realArray(const Kernels::BinaryOp op, const T lhs, const SplitSpan<const T> rhs, const SplitSpan<T> out) {
+  checkSize(rhs.size(), out.size());
+  kernels<T>().realArray[op](lhs, split(rhs), split(out), out.size());
+}
+
+}  // namespace
+
+/// Adds two arrays elementwise
+/// @param lhs Complex numbers
+/// @param rhs Complex numbers
+/// @param out Sums
+template <scalar T>
+void add(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<SplitSpan<const T>> rhs,
+         const SplitSpan<T> out) {
+  arrayArray<T>(Kernels::Add, lhs, rhs, out);
+}
+
+/// Adds a complex number to all elements of an array
+/// @param lhs Complex numbers
+/// @param rhs Complex number
+/// @param out Sums
+template <scalar T>
+void add(const std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs, const SplitSpan<T> out) {
+  arrayComplex<T>(Kernels::Add, lhs, rhs, out);
+}
+
+/// Adds a real number to all elements of an array
+/// @param lhs Complex numbers
+/// @param rhs Real number
+/// @param out Sums
+template <scalar T>
+void add(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<T> rhs,
+         const SplitSpan<T> out) {
+  arrayReal<T>(Kernels::Add, lhs, rhs, out);
+}
+
+/// Subtracts two arrays elementwise
+/// @param lhs Complex numbers
+/// @param rhs Complex numbers
+/// @param out Differences
+template <scalar T>
+void subtract(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<SplitSpan<const T>> rhs,
+              const SplitSpan<T> out) {
+  arrayArray<T>(Kernels::Subtract, lhs, rhs, out);
+}
+
+/// Subtracts a complex number from all elements of an array
+/// @param lhs Complex numbers
+/// @param rhs Complex number
+/// @param out Differences
+template <scalar T>
+void subtract(const std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs,
+              const SplitSpan<T> out) {
+  arrayComplex<T>(Kernels::Subtract, lhs, rhs, out);
+}
+
+/// Subtracts all elements of an array from a complex number
+/// @param lhs Complex number
+/// @param rhs Complex numbers
+/// @param out Differences
+template <scalar T>
+void subtract(const BasicComplex<T>& lhs, const std::type_identity_t<SplitSpan<const T>> rhs,
+              const SplitSpan<T> out) {
+  complexArray<T>(Kernels::Subtract, lhs, rhs, out);
+}
+
+/// Subtracts a real number from all elements of an array
+/// @param lhs Complex numbers
+/// @param rhs Real number
+/// @param out Differences
+template <scalar T>
+void subtract(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<T> rhs,
+              const SplitSpan<T> out) {
+  arrayReal<T>(Kernels::Subtract, lhs, rhs, out);
+}
+
+/// Subtracts all elements of an array from a real number
+/// @param lhs Real number
+/// @param rhs Complex numbers
+/// @param out Differences
+template <scalar T>
+void subtract(const std::type_identity_t<T> lhs, const std::type_identity_t<SplitSpan<const T>> rhs,
+              const SplitSpan<T> out) {
+  realArray<T>(Kernels::Subtract, lhs, rhs, out);
+}
+
+/// Multiplies two arrays elementwise
+/// @param lhs Complex numbers
+/// @param rhs Complex numbers
+/// @param out Products
+template <scalar T>
+void multiply(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<SplitSpan<const T>> rhs,
+              const SplitSpan<T> out) {
+  arrayArray<T>(Kernels::Multiply, lhs, rhs, out);
+}
+
+/// Multiplies all elements of an array with a complex number
+/// @param lhs Complex numbers
+/// @param rhs Complex number
+/// @param out Products
+template <scalar T>
+void multiply(const std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs,
+              const SplitSpan<T> out) {
+  arrayComplex<T>(Kernels::Multiply, lhs, rhs, out);
+}
+
+/// Multiplies all elements of an array with a real number
+/// @param lhs Complex numbers
+/// @param rhs Real number
+/// @param out Products
+template <scalar T>
+void multiply(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<T> rhs,
+              const SplitSpan<T> out) {
+  arrayReal<T>(Kernels::Multiply, lhs, rhs, out);
+}
+
+/// Divides two arrays elementwise
+/// @param lhs Dividends
+/// @param rhs Divisors
+/// @param out Quotients
+template <scalar T>
+void divide(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<SplitSpan<const T>> rhs,
+            const SplitSpan<T> out) {
+  arrayArray<T>(Kernels::Divide, lhs, rhs, out);
+}
+
+/// Divides all elements of an array by a complex number
+/// @param lhs Dividends
+/// @param rhs Divisor
+/// @param out Quotients
+template <scalar T>
+void divide(const std::type_identity_t<SplitSpan<const T>> lhs, const BasicComplex<T>& rhs, const SplitSpan<T> out) {
+  arrayComplex<T>(Kernels::Divide, lhs, rhs, out);
+}
+
+/// Divides a complex number by all elements of an array
+/// @param lhs Dividend
+/// @param rhs Divisors
+/// @param out Quotients
+template <scalar T>
+void divide(const BasicComplex<T>& lhs, const std::type_identity_t<SplitSpan<const T>> rhs, const SplitSpan<T> out) {
+  complexArray<T>(Kernels::Divide, lhs, rhs, out);
+}
+
+/// Divides all elements of an array by a real number
+/// @param lhs Dividends
+/// @param rhs Divisor
+/// @param out Quotients
+template <scalar T>
+void divide(const std::type_identity_t<SplitSpan<const T>> lhs, const std::type_identity_t<T> rhs,
+            const SplitSpan<T> out) {
+  arrayReal<T>(Kernels::Divide, lhs, rhs, out);
+}
+
+/// Divides a real number by all elements of an array
+/// @param lhs Dividend
+/// @param rhs Divisors
+/// @param out Quotients
+template <scalar T>
+void divide(const std::type_identity_t<T> lhs, const std::type_identity_t<SplitSpan<const T>> rhs,
+            const SplitSpan<T> out) {
+  realArray<T>(Kernels::Divide, lhs, rhs, out);
+}
+
+/// Negates all elements of an array
+/// @param z Complex numbers
+/// @param out Negated complex numbers
+template <scalar T>
+void negate(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  checkSize(z.size(), out.size());
+  kernels<T>().negate(split(z), split(out), out.size());
+}
+
+/// Computes the conjugates of all elements of an array
+/// @param z Complex numbers
+/// @param out Conjugates
+template <scalar T>
+void conj(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  checkSize(z.size(), out.size());
+  kernels<T>().conj(split(z), split(out), out.size());
+}
+
+/// Computes the magnitudes of all elements of an array
+/// @param z Complex numbers
+/// @param out Magnitudes
+template <scalar T>
+void abs(const std::type_identity_t<SplitSpan<const T>> z, const std::span<T> out) {
+  checkSize(z.size(), out.size());
+  kernels<T>().abs(split(z), out.data(), out.size());
+}
+
+/// Computes the squared magnitudes of all elements of an array
+/// @param z Complex numbers
+/// @param out Squared magnitudes
+template <scalar T>
+void abs2(const std::type_identity_t<SplitSpan<const T>> z, const std::span<T> out) {
+  checkSize(z.size(), out.size());
+  kernels<T>().abs2(split(z), out.data(), out.size());
+}
+
+/// Computes the arguments of all elements of an array
+/// @param z Complex numbers
+/// @param out Arguments
+template <scalar T>
+void arg(const std::type_identity_t<SplitSpan<const T>> z, const std::span<T> out) {
+  checkSize(z.size(), out.size());
+  kernels<T>().arg(split(z), out.data(), out.size());
+}
+
+/// Copies interleaved complex numbers into a split view
+/// @param z Interleaved complex numbers
+/// @param out Split view of the same size
+template <scalar T>
+void deinterleave(const std::span<const BasicComplex<T>> z, const SplitSpan<T> out) {
+  checkSize(z.size(), out.size());
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    out.realData()[i] = z[i].real();
+    out.imagData()[i] = z[i].imag();
+  }
+}
+
+/// Copies a split view into interleaved complex numbers
+/// @param z Split view
+/// @param out Interleaved complex numbers of the same size
+template <scalar T>
+void interleave(const std::type_identity_t<SplitSpan<const T>> z, const std::span<BasicComplex<T>> out) {
+  checkSize(z.size(), out.size());
+  for (std::size_t i = 0; i < out.size(); ++i) out[i] = BasicComplex<T>(z.realData()[i], z.imagData()[i]);
+}
+
+#define MATH_INSTANTIATE_COMPLEX_ARRAY(T)                                                                       \
+  template void add<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>);                                   \
+  template void add<T>(SplitSpan<const T>, const BasicComplex<T>&, SplitSpan<T>);                               \
+  template void add<T>(SplitSpan<const T>, T, SplitSpan<T>);                                                    \
+  template void subtract<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>);                              \
+  template void subtract<T>(SplitSpan<const T>, const BasicComplex<T>&, SplitSpan<T>);                          \
+  template void subtract<T>(const BasicComplex<T>&, SplitSpan<const T>, SplitSpan<T>);                          \
+  template void subtract<T>(SplitSpan<const T>, T, SplitSpan<T>);                                               \
+  template void subtract<T>(T, SplitSpan<const T>, SplitSpan<T>);                                               \
+  template void multiply<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>);                              \
+  template void multiply<T>(SplitSpan<const T>, const BasicComplex<T>&, SplitSpan<T>);                          \
+  template void multiply<T>(SplitSpan<const T>, T, SplitSpan<T>);                                               \
+  template void divide<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>);                                \
+  template void divide<T>(SplitSpan<const T>, const BasicComplex<T>&, SplitSpan<T>);                            \
+  template void divide<T>(const BasicComplex<T>&, SplitSpan<const T>, SplitSpan<T>);                            \
+  template void divide<T>(SplitSpan<const T>, T, SplitSpan<T>);                                                 \
+  template void divide<T>(T, SplitSpan<const T>, SplitSpan<T>);                                                 \
+  template void negate<T>(SplitSpan<const T>, SplitSpan<T>);                                                    \
+  template void conj<T>(SplitSpan<const T>, SplitSpan<T>);                                                      \
+  template void abs<T>(SplitSpan<const T>, std::span<T>);                                                       \
+  template void abs2<T>(SplitSpan<const T>, std::span<T>);                                                      \
+  template void arg<T>(SplitSpan<const T>, std::span<T>);                                                       \
+  template void deinterleave<T>(std::span<const BasicComplex<T>>, SplitSpan<T>);                                \
+  template void interleave<T>(SplitSpan<const T>, std::span<BasicComplex<T>>);
+
+MATH_INSTANTIATE_COMPLEX_ARRAY(float)
+MATH_INSTANTIATE_COMPLEX_ARRAY(double)
+MATH_INSTANTIATE_COMPLEX_ARRAY(long double)
+
+#undef MATH_INSTANTIATE_COMPLEX_ARRAY
+
+}  // namespace Math
@@ -0,0 +1,1099 @@
+#include "ComplexDecomposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Math {
+
+namespace {
+
+template <scalar T>
+bool isZero(const BasicComplex<T>& z) {
+  return z.real() == 0 && z.imag() == 0;
+}
+
+/// @return |re z| + |im z|, the magnitude by which pivots are chosen, as in LAPACK
+template <scalar T>
+T magnitude1(const BasicComplex<T>& z) {
+  return std::abs(z.real()) + std::abs(z.imag());
+}
+
+/// Columns up to which a panel is factored column by column
+constexpr std::size_t PANEL_COLUMNS = 8;
+
+/// Rows of the diagonal blocks of the triangular solves, which are solved by substitution
+constexpr std::size_t TRIANGULAR_BLOCK_SIZE = 16;
+
+/// Threads solve blocks of columns of the right-hand sides that hold about this many products
+constexpr std::size_t SOLVE_GRAIN = 4096;
+
+/// Computes y[i] -= a x[i] for n elements at the given strides. The columns of the factors are contiguous, and so
+/// are those of column-major right-hand sides, which take the contiguous loop.
+template <scalar T>
+void subtractMultiple(const BasicComplex<T>& a, const BasicComplex<T>* x, const index_t xStride, BasicComplex<T>* y,
+                      const index_t yStride, const std::size_t n) {
+  if (xStride == 1 && yStride == 1) {
+    for (std::size_t i = 0; i < n; ++i) y[i] -= x[i] * a;
+    return;
+  }
+  for (std::size_t i = 0; i < n; ++i) y[static_cast<index_t>(i) * yStride] -= x[static_cast<index_t>(i) * xStride] * a;
+}
+
+/// @return Sum of conj(x[i]) y[i] over n contiguous elements
+template <scalar T>
+BasicComplex<T> conjugateDot(const BasicComplex<T>* x, const BasicComplex<T>* y, const std::size_t n) {
+  T real = 0;
+  T imag = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    real += x[i].real() * y[i].real() + x[i].imag() * y[i].imag();
+    imag += x[i].real() * y[i].imag() - x[i].imag() * y[i].real();
+  }
+  return BasicComplex<T>(real, imag);
+}
+
+template <scalar T>
+void swapRows(const ComplexMatrixView<T> a, const std::size_t i, const std::size_t j) {
+  for (std::size_t c = 0; c < a.cols(); ++c) std::swap(a(i, c), a(j, c));
+}
+
+/// Solves L X = B in place by blocks of rows: the columns of a diagonal block are solved by substitution in parallel,
+/// and the rows below are updated by one matrix product
+/// @param l Lower triangular n x n matrix, the elements above the diagonal are not read
+/// @param unit Whether the diagonal of l is one and not read
+/// @param b n x k right-hand sides, overwritten with X
+template <scalar T>
+void solveLower(const ComplexMatrixView<const T> l, const bool unit, const ComplexMatrixView<T> b, ThreadPool& pool) {
+  const std::size_t n = l.rows();
+  for (std::size_t k = 0; k < n; k += TRIANGULAR_BLOCK_SIZE) {
+    const std::size_t kb = std::min<std::size_t>(TRIANGULAR_BLOCK_SIZE, n - k);
+    pool.parallelFor(0, b.cols(), std::max<std::size_t>(1, SOLVE_GRAIN / (kb * kb)), [&](const std::size_t j) {
+      for (std::size_t p = k; p < k + kb; ++p) {
+        if (!unit) b(p, j) = scaledDivide(b(p, j), l(p, p));
+        const BasicComplex<T> x = b(p, j);
+        if (isZero(x)) continue;
+        subtractMultiple(x, &l(p + 1, p), l.rowStride(), &b(p + 1, j), b.rowStride(), k + kb - p - 1);
+      }
+    });
+    if (k + kb < n) {
+      const auto below = static_cast<size_t>(n - k - kb);
+      gemm(BasicComplex<T>(-1, 0), l.submatrix(k + kb, k, below, kb), b.submatrix(k, 0, kb, b.cols()),
+           BasicComplex<T>(1, 0), b.submatrix(k + kb, 0, below, b.cols()), pool);
+    }
+  }
+}
+
+/// Solves U X = B in place by blocks of rows from the bottom, like solveLower
+/// @param u Upper triangular n x n matrix, the elements below the diagonal are not read
+/// @param b n x k right-hand sides, overwritten with X
+template <scalar T>
+void solveUpper(const ComplexMatrixView<const T> u, const ComplexMatrixView<T> b, ThreadPool& pool) {
+  for (std::size_t end = u.rows(); end > 0;) {
+    const std::size_t k = end - std::min<std::size_t>(TRIANGULAR_BLOCK_SIZE, end);
+    const std::size_t kb = end - k;
+    pool.parallelFor(0, b.cols(), std::max<std::size_t>(1, SOLVE_GRAIN / (kb * kb)), [&](const std::size_t j) {
+      for (std::size_t p = end; p-- > k;) {
+        b(p, j) = scaledDivide(b(p, j), u(p, p));
+        const BasicComplex<T> x = b(p, j);
+        if (isZero(x)) continue;
+        subtractMultiple(x, &u(k, p), u.rowStride(), &b(k, j), b.rowStride(), p - k);
+      }
+    });
+    if (k > 0) {
+      gemm(BasicComplex<T>(-1, 0), u.submatrix(0, k, k, kb), b.submatrix(k, 0, kb, b.cols()),
+           BasicComplex<T>(1, 0), b.submatrix(0, 0, k, b.cols()), pool);
+    }
+    end = k;
+  }
+}
+
+/// Euclidean norm of n contiguous numbers, scaled by the largest part so that the squares neither overflow nor
+/// underflow
+template <scalar T>
+T norm(const BasicComplex<T>* x, const std::size_t n) {
+  T largest = 0;
+  for (std::size_t i = 0; i < n; ++i) largest = std::max({largest, std::abs(x[i].real()), std::abs(x[i].imag())});
+  if (largest == 0 || !std::isfinite(largest)) return largest;
+  const T inverse = 1 / largest;
+  T sum = 0;
+  for (std::size_t i = 0; i < n; ++i) sum += abs2(x[i] * inverse);
+  return largest * std::sqrt(sum);
+}
+
+/// Computes the reflector H = I - tau v v^H with H^H x = (beta, 0, ..., 0) and a real beta, as LAPACK's zlarfg
+/// @param x n contiguous numbers, overwritten with beta followed by v without its unit first element
+/// @return tau, zero if x is already a real multiple of the first unit vector
+template <scalar T>
+BasicComplex<T> householder(BasicComplex<T>* x, const std::size_t n) {
+  const BasicComplex<T> alpha = x[0];
+  const T tailNorm = norm(x + 1, n - 1);
+  if (tailNorm == 0 && alpha.imag() == 0) return BasicComplex<T>();
+  const T beta = -std::copysign(std::hypot(alpha.real(), alpha.imag(), tailNorm), alpha.real());
+  const BasicComplex<T> scale = scaledDivide(BasicComplex<T>(1, 0), alpha - beta);
+  for (std::size_t i = 1; i < n; ++i) x[i] *= scale;
+  x[0] = BasicComplex<T>(beta, 0);
+  return BasicComplex<T>((beta - alpha.real()) / beta, -alpha.imag() / beta);
+}
+
+/// Reflectors of a panel with their unit and zero elements, and their adjoint, as operands of matrix products
+template <scalar T>
+struct Reflectors {
+  BasicComplexMatrix<T> v;
+  BasicComplexMatrix<T> vh;
+
+  /// @param panel Reflectors below the diagonal, r x kb
+  explicit Reflectors(const ComplexMatrixView<const T> panel)
+      : v(panel.rows(), panel.cols(), MatrixLayout::ColumnMajor),
+        vh(panel.cols(), panel.rows(), MatrixLayout::ColumnMajor) {
+    for (std::size_t j = 0; j < panel.cols(); ++j) {
+      v(j, j) = vh(j, j) = BasicComplex<T>(1, 0);
+      for (std::size_t i = j + 1; i < panel.rows(); ++i) {
+        v(i, j) = panel(i, j);
+        vh(j, i) = conj(panel(i, j));
+      }
+    }
+  }
+};
+
+/// Computes T of the block reflector H_0 H_1 ... = I - V T V^H column by column, T(0:i, i) = -tau_i T(0:i, 0:i)
+/// V(:, 0:i)^H v_i as LAPACK's zlarft, with the products of the reflectors from one matrix product
+/// @param reflectors V, r x kb
+/// @param tau kb factors of the reflectors
+/// @param triangular T, kb x kb, the elements below the diagonal are not written
+template <scalar T>
+void formTriangular(const Reflectors<T>& reflectors, const BasicComplex<T>* tau, const ComplexMatrixView<T> triangular,
+                    ThreadPool& pool) {
+  const std::size_t kb = triangular.rows();
+  BasicComplexMatrix<T> gram(kb, kb, MatrixLayout::ColumnMajor);
+  gemm(BasicComplex<T>(1, 0), reflectors.vh.view(), reflectors.v.view(), BasicComplex<T>(0, 0), gram.view(), pool);
+  for (std::size_t i = 0; i < kb; ++i) {
+    for (std::size_t p = 0; p < i; ++p) {
+      BasicComplex<T> sum;
+      for (std::size_t q = p; q < i; ++q) sum += triangular(p, q) * gram(q, i);
+      triangular(p, i) = -tau[i] * sum;
+    }
+    triangular(i, i) = tau[i];
+  }
+}
+
+/// Multiplies by the block reflector I - V op(T) V^H in place with three matrix products, op(T) = T^H for the adjoint
+/// @param reflectors V, r x kb
+/// @param triangular T, kb x kb
+/// @param c r x k matrix
+template <scalar T>
+void applyBlockReflector(const Reflectors<T>& reflectors, const ComplexMatrixView<const T> triangular,
+                         const bool adjoint, const ComplexMatrixView<T> c, ThreadPool& pool) {
+  const std::size_t kb = triangular.rows();
+  BasicComplexMatrix<T> op(kb, kb, MatrixLayout::ColumnMajor);
+  for (std::size_t j = 0; j < kb; ++j) {
+    for (std::size_t i = 0; i <= j; ++i) {
+      if (adjoint) {
+        op(j, i) = conj(triangular(i, j));
+      } else {
+        op(i, j) = triangular(i, j);
+      }
+    }
+  }
+  BasicComplexMatrix<T> w(kb, c.cols(), MatrixLayout::ColumnMajor);
+  BasicComplexMatrix<T> tw(kb, c.cols(), MatrixLayout::ColumnMajor);
+  gemm(BasicComplex<T>(1, 0), reflectors.vh.view(), c, BasicComplex<T>(0, 0), w.view(), pool);
+  gemm(BasicComplex<T>(1, 0), op.view(), w.view(), BasicComplex<T>(0, 0), tw.view(), pool);
+  gemm(BasicComplex<T>(-1, 0), reflectors.v.view(), tw.view(), BasicComplex<T>(1, 0), c, pool);
+}
+
+/// Rows of the deflation window of an active block of the QR iteration are this fraction of its rows
+constexpr std::size_t DEFLATION_WINDOW_DIVISOR = 6;
+
+/// Rows of the smallest deflation window
+constexpr std::size_t DEFLATION_WINDOW_MIN = 12;
+
+/// Percentage of the deflation window that, when it deflates, makes the next deflation follow without a sweep
+constexpr std::size_t DEFLATION_NIBBLE = 14;
+
+/// Sweeps of one active block without a deflation, per row of the block, after which the QR iteration fails
+constexpr std::size_t ITERATION_LIMIT = 30;
+
+/// Sweeps without a deflation after which an exceptional shift breaks a possible cycle
+constexpr std::size_t EXCEPTIONAL_SHIFT_PERIOD = 10;
+
+/// @return Rows of the deflation window of an active block, zero below EIGEN_DEFLATION_SIZE rows
+std::size_t deflationWindow(const std::size_t rows) {
+  if (rows < EIGEN_DEFLATION_SIZE) return 0;
+  return std::max(DEFLATION_WINDOW_MIN, rows / DEFLATION_WINDOW_DIVISOR);
+}
+
+template <scalar T>
+void copy(const ComplexMatrixView<const T> source, const ComplexMatrixView<T> target) {
+  for (std::size_t j = 0; j < source.cols(); ++j) {
+    for (std::size_t i = 0; i < source.rows(); ++i) target(i, j) = source(i, j);
+  }
+}
+
+/// Multiplies by a reflector from the left, C = H^H C with H = I - tau v v^H
+/// @param v c.rows() numbers
+/// @param c Matrix with contiguous columns
+template <scalar T>
+void reflectLeft(const BasicComplex<T>* v, const BasicComplex<T>& tau, const ComplexMatrixView<T> c) {
+  for (std::size_t j = 0; j < c.cols(); ++j) {
+    const BasicComplex<T> f = conj(tau) * conjugateDot(v, &c(0, j), c.rows());
+    subtractMultiple<T>(f, v, 1, &c(0, j), 1, c.rows());
+  }
+}
+
+/// Multiplies by a reflector from the right, C = C H with H = I - tau v v^H
+/// @param v c.cols() numbers
+/// @param c Matrix with contiguous columns
+/// @param work c.rows() numbers
+template <scalar T>
+void reflectRight(const BasicComplex<T>* v, const BasicComplex<T>& tau, const ComplexMatrixView<T> c,
+                  BasicComplex<T>* work) {
+  std::fill_n(work, c.rows(), BasicComplex<T>());
+  for (std::size_t j = 0; j < c.cols(); ++j) subtractMultiple<T>(-v[j], &c(0, j), 1, work, 1, c.rows());
+  for (std::size_t j = 0; j < c.cols(); ++j) subtractMultiple<T>(tau * conj(v[j]), work, 1, &c(0, j), 1, c.rows());
+}
+
+/// Plane rotation G = [c s; -conj(s) c] with a real c
+template <scalar T>
+struct Rotation {
+  T c = 1;
+  BasicComplex<T> s;
+};
+
+/// Computes the rotation with G (f, g) = (r, 0), as LAPACK's zlartg. The squares are taken of f and g scaled by
+/// their largest part, so that they neither overflow nor, for the larger of the two, underflow.
+template <scalar T>
+Rotation<T> givens(const BasicComplex<T>& f, const BasicComplex<T>& g, BasicComplex<T>& r) {
+  if (isZero(g)) {
+    r = f;
+    return {};
+  }
+  const T scale = std::max({std::abs(f.real()), std::abs(f.imag()), std::abs(g.real()), std::abs(g.imag())});
+  const BasicComplex<T> fs = f / scale;
+  const BasicComplex<T> gs = g / scale;
+  const T f2 = abs2(fs);
+  const T d = std::sqrt(f2 + abs2(gs));
+  if (f2 == 0) {
+    // f is zero or negligible beside g
+    r = BasicComplex<T>(d * scale, 0);
+    return {0, conj(gs) / d};
+  }
+  const T fAbs = std::sqrt(f2);
+  const BasicComplex<T> phase = fs / fAbs;
+  r = phase * (d * scale);
+  return {fAbs / d, phase * conj(gs) / d};
+}
+
+/// Multiplies the rows k and k + 1 by G, the columns [first, last)
+template <scalar T>
+void rotateRows(const ComplexMatrixView<T> a, const std::size_t k, const std::size_t first, const std::size_t last,
+                const Rotation<T>& rotation) {
+  for (std::size_t j = first; j < last; ++j) {
+    const BasicComplex<T> x = a(k, j);
+    const BasicComplex<T> y = a(k + 1, j);
+    a(k, j) = rotation.c * x + rotation.s * y;
+    a(k + 1, j) = rotation.c * y - conj(rotation.s) * x;
+  }
+}
+
+/// Multiplies the columns k and k + 1 by G^H, the rows [first, last)
+template <scalar T>
+void rotateColumns(const ComplexMatrixView<T> a, const std::size_t k, const std::size_t first, const std::size_t last,
+                   const Rotation<T>& rotation) {
+  BasicComplex<T>* x = &a(0, k);
+  BasicComplex<T>* y = &a(0, k + 1);
+  const index_t stride = a.rowStride();
+  for (std::size_t i = first; i < last; ++i) {
+    const BasicComplex<T> p = x[static_cast<index_t>(i) * stride];
+    const BasicComplex<T> q = y[static_cast<index_t>(i) * stride];
+    x[static_cast<index_t>(i) * stride] = rotation.c * p + conj(rotation.s) * q;
+    y[static_cast<index_t>(i) * stride] = rotation.c * q - rotation.s * p;
+  }
+}
+
+/// Finds the first row of the active block of a Hessenberg matrix that ends at row hi: the row below the last
+/// subdiagonal element that is negligible by the criterion of Ahues and Tisseur, as in LAPACK's zlahqr, which is set
+/// to zero
+/// @param small Magnitude below which subdiagonal elements are always negligible
+template <scalar T>
+std::size_t split(const ComplexMatrixView<T> h, const std::size_t lo, const std::size_t hi, const T small) {
+  const T ulp = std::numeric_limits<T>::epsilon();
+  for (std::size_t k = hi; k > lo; --k) {
+    const T subdiagonal = magnitude1(h(k, k - 1));
+    if (subdiagonal <= small) {
+      h(k, k - 1) = BasicComplex<T>();
+      return k;
+    }
+    T diagonal = magnitude1(h(k - 1, k - 1)) + magnitude1(h(k, k));
+    if (diagonal == 0) {
+      if (k - 1 > lo) diagonal += magnitude1(h(k - 1, k - 2));
+      if (k < hi) diagonal += magnitude1(h(k + 1, k));
+    }
+    if (subdiagonal > ulp * diagonal) continue;
+    const T ab = std::max(subdiagonal, magnitude1(h(k - 1, k)));
+    const T ba = std::min(subdiagonal, magnitude1(h(k - 1, k)));
+    const T aa = std::max(magnitude1(h(k, k)), magnitude1(h(k - 1, k - 1) - h(k, k)));
+    const T bb = std::min(magnitude1(h(k, k)), magnitude1(h(k - 1, k - 1) - h(k, k)));
+    const T s = aa + ab;
+    if (ba * (ab / s) <= std::max(small, ulp * (bb * (aa / s)))) {
+      h(k, k - 1) = BasicComplex<T>();
+      return k;
+    }
+  }
+  return lo;
+}
+
+/// @return Eigenvalue of the trailing 2 x 2 block of rows hi - 1 and hi that is closer to h(hi, hi)
+template <scalar T>
+BasicComplex<T> wilkinsonShift(const ComplexMatrixView<const T> h, const std::size_t hi) {
+  const BasicComplex<T> shift = h(hi, hi);
+  const BasicComplex<T> u = sqrt(h(hi - 1, hi)) * sqrt(h(hi, hi - 1));
+  T s = magnitude1(u);
+  if (s == 0) return shift;
+  const BasicComplex<T> x = (h(hi - 1, hi - 1) - shift) * T(0.5);
+  const T xMagnitude = magnitude1(x);
+  s = std::max(s, xMagnitude);
+  BasicComplex<T> y = s * sqrt((x / s) * (x / s) + (u / s) * (u / s));
+  if (xMagnitude > 0) {
+    const BasicComplex<T> direction = x / xMagnitude;
+    if (direction.real() * y.real() + direction.imag() * y.imag() < 0) y = -y;
+  }
+  return shift - u * scaledDivide(u, x + y);
+}
+
+/// Chases the bulge of one implicitly shifted QR step down the active block [lo, hi] by rotations. The rows are rotated
+/// column by column as late as possible: the rotations that a column has not seen are applied when the bulge reaches
+/// it, or after the sweep, so that columns of column-major matrices are traversed contiguously and once per sweep.
+/// @param z Matrix whose columns are rotated as well, or empty
+/// @param full Whether to update the rows above and the columns right of the block as well, for the Schur form
+/// @param cosines, sines Storage for the rotations, hi numbers
+template <scalar T>
+void sweep(const ComplexMatrixView<T> h, const ComplexMatrixView<T> z, const std::size_t lo, const std::size_t hi,
+           const BasicComplex<T>& shift, const bool full, T* cosines, BasicComplex<T>* sines) {
+  const std::size_t top = full ? 0 : lo;
+  const std::size_t end = full ? h.cols() : hi + 1;
+  // Applies the rotations [lo, last) to the rows of column j
+  const auto rotateColumn = [&](const std::size_t j, const std::size_t last) {
+    for (std::size_t k = lo; k < last; ++k) {
+      const BasicComplex<T> x = h(k, j);
+      const BasicComplex<T> y = h(k + 1, j);
+      h(k, j) = cosines[k] * x + sines[k] * y;
+      h(k + 1, j) = cosines[k] * y - conj(sines[k]) * x;
+    }
+  };
+  for (std::size_t k = lo; k < hi; ++k) {
+    BasicComplex<T> r;
+    Rotation<T> rotation;
+    if (k == lo) {
+      rotation = givens<T>(h(lo, lo) - shift, h(lo + 1, lo), r);
+    } else {
+      rotation = givens<T>(h(k, k - 1), h(k + 1, k - 1), r);
+      h(k, k - 1) = r;
+      h(k + 1, k - 1) = BasicComplex<T>();
+    }
+    cosines[k] = rotation.c;
+    sines[k] = rotation.s;
+    rotateColumn(k + 1, k);
+    rotateRows(h, k, k, k + 2, rotation);
+    rotateColumns(h, k, top, std::min(k + 3, hi + 1), rotation);
+    if (z.rows() > 0) rotateColumns(z, k, 0, z.rows(), rotation);
+  }
+  for (std::size_t j = hi + 1; j < end; ++j) rotateColumn(j, hi);
+}
+
+/// Reduces the rows and columns [lo, hi] of a Hessenberg matrix to upper triangular form by implicitly shifted QR
+/// sweeps, deflating whenever a subdiagonal element becomes negligible, as LAPACK's zlahqr. Every tenth sweep without
+/// a deflation uses an exceptional shift.
+/// @param z Matrix whose columns are rotated as well, or empty
+/// @param full Whether to update the rows above and the columns right of the active blocks as well, for the Schur form
+/// @param deflate Called as deflate(lo, hi, count) for an active block without shifts; returns the number of rows it
+/// deflated at the bottom of the block and sets count to the number of shifts it left
+/// @param shifts Shifts left by deflate, used from the last
+/// @param cosines, sines Storage for the rotations of a sweep, hi numbers
+/// @return Whether the iteration converged
+template <scalar T, typename Deflate>
+bool shiftedQr(const ComplexMatrixView<T> h, const ComplexMatrixView<T> z, const std::size_t lo, const std::size_t hi,
+               const bool full, Deflate&& deflate, const std::span<const BasicComplex<T>> shifts, T* cosines,
+               BasicComplex<T>* sines) {
+  const T small = std::numeric_limits<T>::min() * (static_cast<T>(hi - lo + 1) / std::numeric_limits<T>::epsilon());
+  std::size_t i = hi;
+  // First row of the active block the shifts belong to
+  std::size_t active = hi + 1;
+  std::size_t shiftCount = 0;
+  std::size_t iterations = 0;
+  while (i > lo) {
+    const std::size_t l = split(h, lo, i, small);
+    if (l == i) {
+      --i;
+      iterations = 0;
+      continue;
+    }
+    if (l != active) {
+      active = l;
+      shiftCount = 0;
+    }
+    if (shiftCount == 0) {
+      const std::size_t deflated = deflate(l, i, shiftCount);
+      if (deflated > 0) {
+        i -= deflated;
+        iterations = 0;
+        continue;
+      }
+    }
+    BasicComplex<T> shift;
+    if (iterations > 0 && iterations % EXCEPTIONAL_SHIFT_PERIOD == 0) {
+      // From the top and the bottom of the block in turn
+      if (iterations / EXCEPTIONAL_SHIFT_PERIOD % 2 == 1) {
+        shift = h(l, l) + BasicComplex<T>(T(0.75) * magnitude1(h(l + 1, l)), 0);
+      } else {
+        shift = h(i, i) + BasicComplex<T>(T(0.75) * magnitude1(h(i, i - 1)), 0);
+      }
+    } else if (shiftCount > 0) {
+      shift = shifts[--shiftCount];
+    } else {
+      shift = wilkinsonShift<T>(h, i);
+    }
+    sweep(h, z, l, i, shift, full, cosines, sines);
+    if (++iterations > ITERATION_LIMIT * std::max<std::size_t>(10, i - l + 1)) return false;
+  }
+  return true;
+}
+
+/// Swaps the adjacent diagonal elements k and k + 1 of an upper triangular matrix by a rotation, as LAPACK's ztrexc
+/// @param u Matrix whose columns k and k + 1 are rotated as well
+template <scalar T>
+void swapDiagonal(const ComplexMatrixView<T> t, const ComplexMatrixView<T> u, const std::size_t k) {
+  const BasicComplex<T> first = t(k, k);
+  const BasicComplex<T> second = t(k + 1, k + 1);
+  BasicComplex<T> r;
+  const Rotation<T> rotation = givens<T>(t(k, k + 1), second - first, r);
+  rotateRows(t, k, k + 2, t.cols(), rotation);
+  rotateColumns(t, k, 0, k, rotation);
+  t(k, k) = second;
+  t(k + 1, k + 1) = first;
+  rotateColumns(u, k, 0, u.rows(), rotation);
+}
+
+}  // namespace
+
+/// Factors a matrix
+/// @param a Square matrix
+/// @param pool Threads that update the trailing matrix
+template <scalar T>
+BasicLuDecomposition<T>::BasicLuDecomposition(const std::type_identity_t<ComplexMatrixView<const T>> a,
+                                              ThreadPool& pool)
+    : m_Factors(a, MatrixLayout::ColumnMajor), m_Pivots(a.rows()) {
+  if (a.rows() != a.cols()) throw std::invalid_argument("LuDecomposition: matrix must be square");
+  const std::size_t n = a.rows();
+  const ComplexMatrixView<T> lu = m_Factors.view();
+  for (std::size_t k = 0; k < n; k += DECOMPOSITION_BLOCK_SIZE) {
+    const std::size_t kb = std::min<std::size_t>(DECOMPOSITION_BLOCK_SIZE, n - k);
+    factorPanel(k, kb, pool);
+    if (k + kb == n) break;
+    // Block row of U and the trailing matrix
+    const auto rest = static_cast<size_t>(n - k - kb);
+    solveLower<T>(lu.submatrix(k, k, kb, kb), true, lu.submatrix(k, k + kb, kb, rest), pool);
+    gemm(BasicComplex<T>(-1, 0), lu.submatrix(k + kb, k, rest, kb), lu.submatrix(k, k + kb, kb, rest),
+         BasicComplex<T>(1, 0), lu.submatrix(k + kb, k + kb, rest, rest), pool);
+  }
+}
+
+/// Factors the panel of the columns [col, col + width) and the rows from col down. Wide panels are split in halves
+/// like the whole matrix, so that most of their updates are matrix products as well, narrow ones are factored column
+/// by column. Pivoting exchanges whole rows, so that the other columns need no second pass.
+template <scalar T>
+void BasicLuDecomposition<T>::factorPanel(const std::size_t col, const std::size_t width, ThreadPool& pool) {
+  const std::size_t n = size();
+  const ComplexMatrixView<T> lu = m_Factors.view();
+  if (width > PANEL_COLUMNS) {
+    const std::size_t left = width / 2;
+    const std::size_t right = width - left;
+    factorPanel(col, left, pool);
+    const auto below = static_cast<size_t>(n - col - left);
+    solveLower<T>(lu.submatrix(col, col, left, left), true, lu.submatrix(col, col + left, left, right), pool);
+    gemm(BasicComplex<T>(-1, 0), lu.submatrix(col + left, col, below, left), lu.submatrix(col, col + left, left, right),
+         BasicComplex<T>(1, 0), lu.submatrix(col + left, col + left, below, right), pool);
+    factorPanel(col + left, right, pool);
+    return;
+  }
+  for (std::size_t j = col; j < col + width; ++j) {
+    std::size_t pivot = j;
+    T largest = magnitude1(lu(j, j));
+    for (std::size_t i = j + 1; i < n; ++i) {
+      const T candidate = magnitude1(lu(i, j));
+      if (candidate > largest) {
+        largest = candidate;
+        pivot = i;
+      }
+    }
+    m_Pivots[j] = static_cast<size_t>(pivot);
+    if (pivot != j) swapRows(lu, j, pivot);
+    const BasicComplex<T> diagonal = lu(j, j);
+    if (isZero(diagonal)) {
+      m_Singular = true;
+      continue;
+    }
+    for (std::size_t i = j + 1; i < n; ++i) lu(i, j) = scaledDivide(lu(i, j), diagonal);
+    for (std::size_t c = j + 1; c < col + width; ++c) {
+      const BasicComplex<T> u = lu(j, c);
+      if (isZero(u)) continue;
+      subtractMultiple<T>(u, &lu(j + 1, j), 1, &lu(j + 1, c), 1, n - j - 1);
+    }
+  }
+}
+
+/// @return Determinant of the matrix
+template <scalar T>
+BasicComplex<T> BasicLuDecomposition<T>::determinant() const {
+  BasicComplex<T> result(1, 0);
+  for (size_t i = 0; i < size(); ++i) {
+    result *= m_Factors(i, i);
+    if (m_Pivots[i] != i) result = -result;
+  }
+  return result;
+}
+
+/// Solves A X = B in place
+/// @param b Right-hand sides B, size() x k, overwritten with X
+/// @param pool Threads that solve blocks of columns of b
+template <scalar T>
+void BasicLuDecomposition<T>::solveInPlace(const std::type_identity_t<ComplexMatrixView<T>> b,
+                                           ThreadPool& pool) const {
+  if (b.rows() != size()) throw std::invalid_argument("LuDecomposition: right-hand sides must have size() rows");
+  if (m_Singular) throw std::invalid_argument("LuDecomposition: matrix is singular");
+  for (size_t i = 0; i < size(); ++i) {
+    if (m_Pivots[i] != i) swapRows(b, i, m_Pivots[i]);
+  }
+  solveLower<T>(m_Factors.view(), true, b, pool);
+  solveUpper<T>(m_Factors.view(), b, pool);
+}
+
+/// Solves A X = B
+/// @param b Right-hand sides B, size() x k
+/// @param pool Threads that solve blocks of columns of b
+/// @return X, column-major size() x k
+template <scalar T>
+BasicComplexMatrix<T> BasicLuDecomposition<T>::solve(const std::type_identity_t<ComplexMatrixView<const T>> b,
+                                                     ThreadPool& pool) const {
+  BasicComplexMatrix<T> x(b, MatrixLayout::ColumnMajor);
+  solveInPlace(x.view(), pool);
+  return x;
+}
+
+/// Factors a matrix
+/// @param a m x n matrix
+/// @param pool Threads that update the trailing matrix
+template <scalar T>
+BasicQrDecomposition<T>::BasicQrDecomposition(const std::type_identity_t<ComplexMatrixView<const T>> a,
+                                              ThreadPool& pool)
+    : m_Factors(a, MatrixLayout::ColumnMajor), m_Tau(std::min(a.rows(), a.cols())) {
+  const std::size_t m = a.rows();
+  const std::size_t n = a.cols();
+  const std::size_t count = m_Tau.size();
+  m_Triangular = BasicComplexMatrix<T>(std::min(DECOMPOSITION_BLOCK_SIZE, static_cast<size_t>(count)),
+                                       static_cast<size_t>(count), MatrixLayout::ColumnMajor);
+  const ComplexMatrixView<T> qr = m_Factors.view();
+  for (std::size_t k = 0; k < count; k += DECOMPOSITION_BLOCK_SIZE) {
+    const std::size_t kb = std::min<std::size_t>(DECOMPOSITION_BLOCK_SIZE, count - k);
+    factorPanel(k, kb, pool);
+    const Reflectors<T> reflectors(qr.submatrix(k, k, m - k, kb));
+    const ComplexMatrixView<T> triangular = m_Triangular.submatrix(0, k, kb, kb);
+    formTriangular<T>(reflectors, &m_Tau[k], triangular, pool);
+    if (k + kb < n) {
+      applyBlockReflector<T>(reflectors, triangular, true, qr.submatrix(k, k + kb, m - k, n - k - kb), pool);
+    }
+  }
+}
+
+/// Computes the reflectors of the columns [col, col + width) and applies them to those columns, the rows from col
+/// down. Wide panels are split in halves like the whole matrix, so that most of their updates are matrix products as
+/// well, narrow ones are reduced column by column.
+template <scalar T>
+void BasicQrDecomposition<T>::factorPanel(const std::size_t col, const std::size_t width, ThreadPool& pool) {
+  const std::size_t m = rows();
+  const ComplexMatrixView<T> qr = m_Factors.view();
+  if (width > PANEL_COLUMNS) {
+    const std::size_t left = width / 2;
+    factorPanel(col, left, pool);
+    const Reflectors<T> reflectors(qr.submatrix(col, col, m - col, left));
+    BasicComplexMatrix<T> triangular(left, left, MatrixLayout::ColumnMajor);
+    formTriangular<T>(reflectors, &m_Tau[col], triangular.view(), pool);
+    applyBlockReflector<T>(reflectors, triangular, true, qr.submatrix(col, col + left, m - col, width - left), pool);
+    factorPanel(col + left, width - left, pool);
+    return;
+  }
+  for (std::size_t j = col; j < col + width; ++j) {
+    const BasicComplex<T> tau = householder(&qr(j, j), m - j);
+    m_Tau[j] = tau;
+    if (isZero(tau)) continue;
+    for (std::size_t c = j + 1; c < col + width; ++c) {
+      const BasicComplex<T> f = conj(tau) * (qr(j, c) + conjugateDot(&qr(j + 1, j), &qr(j + 1, c), m - j - 1));
+      qr(j, c) -= f;
+      subtractMultiple<T>(f, &qr(j + 1, j), 1, &qr(j + 1, c), 1, m - j - 1);
+    }
+  }
+}
+
+/// Multiplies by Q or Q^H in place, a block reflector per panel
+/// @param b m x k matrix
+/// @param adjoint Whether to multiply by Q^H
+template <scalar T>
+void BasicQrDecomposition<T>::applyReflectors(const ComplexMatrixView<T> b, const bool adjoint,
+                                              ThreadPool& pool) const {
+  if (b.rows() != rows()) throw std::invalid_argument("QrDecomposition: matrix must have rows() rows");
+  const std::size_t reflectors = m_Tau.size();
+  const std::size_t panels = (reflectors + DECOMPOSITION_BLOCK_SIZE - 1) / DECOMPOSITION_BLOCK_SIZE;
+  for (std::size_t i = 0; i < panels; ++i) {
+    // Q^H = ... H_1^H H_0^H applies the first panel first, Q the last one
+    const std::size_t k = (adjoint ? i : panels - 1 - i) * DECOMPOSITION_BLOCK_SIZE;
+    const auto kb = static_cast<size_t>(std::min<std::size_t>(DECOMPOSITION_BLOCK_SIZE, reflectors - k));
+    const auto r = static_cast<size_t>(rows() - k);
+    applyBlockReflector<T>(Reflectors<T>(m_Factors.submatrix(k, k, r, kb)), m_Triangular.submatrix(0, k, kb, kb),
+                           adjoint, b.submatrix(k, 0, r, b.cols()), pool);
+  }
+}
+
+/// @return Upper trapezoidal R, min(m, n) x n
+template <scalar T>
+BasicComplexMatrix<T> BasicQrDecomposition<T>::r() const {
+  BasicComplexMatrix<T> result(static_cast<size_t>(m_Tau.size()), cols(), MatrixLayout::ColumnMajor);
+  for (size_t j = 0; j < cols(); ++j) {
+    for (size_t i = 0; i < result.rows() && i <= j; ++i) result(i, j) = m_Factors(i, j);
+  }
+  return result;
+}
+
+/// @return First min(m, n) columns of Q, m x min(m, n)
+template <scalar T>
+BasicComplexMatrix<T> BasicQrDecomposition<T>::q(ThreadPool& pool) const {
+  BasicComplexMatrix<T> result(rows(), static_cast<size_t>(m_Tau.size()), MatrixLayout::ColumnMajor);
+  for (size_t i = 0; i < result.cols(); ++i) result(i, i) = BasicComplex<T>(1, 0);
+  applyReflectors(result.view(), false, pool);
+  return result;
+}
+
+/// Multiplies by Q in place
+/// @param b m x k matrix, overwritten with Q b
+/// @param pool Threads that compute the products
+template <scalar T>
+void BasicQrDecomposition<T>::applyQ(const std::type_identity_t<ComplexMatrixView<T>> b, ThreadPool& pool) const {
+  applyReflectors(b, false, pool);
+}
+
+/// Multiplies by Q^H in place
+/// @param b m x k matrix, overwritten with Q^H b
+/// @param pool Threads that compute the products
+template <scalar T>
+void BasicQrDecomposition<T>::applyQAdjoint(const std::type_identity_t<ComplexMatrixView<T>> b,
+                                            ThreadPool& pool) const {
+  applyReflectors(b, true, pool);
+}
+
+/// Solves min |A X - B| in the least squares sense, the exact solution of a square system
+/// @param b Right-hand sides B, m x k, m >= n
+/// @param pool Threads that compute the products
+/// @return X, column-major n x k
+template <scalar T>
+BasicComplexMatrix<T> BasicQrDecomposition<T>::solve(const std::type_identity_t<ComplexMatrixView<const T>> b,
+                                                     ThreadPool& pool) const {
+  if (rows() < cols()) throw std::invalid_argument("QrDecomposition: least squares needs rows() >= cols()");
+  if (b.rows() != rows()) throw std::invalid_argument("QrDecomposition: right-hand sides must have rows() rows");
+  for (size_t i = 0; i < cols(); ++i) {
+    if (isZero(m_Factors(i, i))) throw std::invalid_argument("QrDecomposition: matrix is rank deficient");
+  }
+  BasicComplexMatrix<T> y(b, MatrixLayout::ColumnMajor);
+  applyReflectors(y.view(), true, pool);
+  const ComplexMatrixView<T> x = y.submatrix(0, 0, cols(), b.cols());
+  solveUpper<T>(m_Factors.submatrix(0, 0, cols(), cols()), x, pool);
+  return BasicComplexMatrix<T>(x, MatrixLayout::ColumnMajor);
+}
+
+/// Allocates the workspaces
+/// @param size Number of rows and columns of the matrices
+/// @param vectors Whether to compute the Schur vectors and the eigenvectors besides the eigenvalues
+template <scalar T>
+BasicEigenSolver<T>::BasicEigenSolver(const size_t size, const bool vectors)
+    : m_Size(size), m_Vectors(vectors), m_Schur(size, size, MatrixLayout::ColumnMajor), m_Eigenvalues(size) {
+  const size_t block = std::min(DECOMPOSITION_BLOCK_SIZE, size);
+  const auto window = static_cast<size_t>(deflationWindow(size));
+  const auto matrix = [](const size_t rows, const size_t cols) {
+    return BasicComplexMatrix<T>(rows, cols, MatrixLayout::ColumnMajor);
+  };
+  if (vectors) {
+    m_SchurVectors = matrix(size, size);
+    m_Eigenvectors = matrix(size, size);
+    m_Work = matrix(size, size);
+  }
+  m_Reflectors = matrix(size, block);
+  m_ReflectorsAdjoint = matrix(block, size);
+  m_Y = matrix(size, block);
+  m_Triangular = matrix(block, block);
+  m_TriangularAdjoint = matrix(block, block);
+  m_PanelProduct = matrix(size, block);
+  m_RowProduct = matrix(block, size);
+  m_RowProductT = matrix(block, size);
+  m_Window = matrix(window, window);
+  m_WindowVectors = matrix(window, window);
+  m_WindowAdjoint = matrix(window, window);
+  m_WindowColumns = matrix(size, window);
+  m_WindowRows = matrix(window, size);
+  m_Shifts.resize(window);
+  m_Cosines.resize(size);
+  m_Sines.resize(size);
+  m_Vector.resize(2 * std::size_t(size));
+}
+
+/// Computes the eigenvalues, and the eigenvectors if they were requested
+/// @param a size() x size() matrix
+/// @param pool Threads that compute the matrix products
+template <scalar T>
+void BasicEigenSolver<T>::compute(const std::type_identity_t<ComplexMatrixView<const T>> a, ThreadPool& pool) {
+  if (a.rows() != m_Size || a.cols() != m_Size) {
+    throw std::invalid_argument("EigenSolver: matrix must be size() x size()");
+  }
+  const std::size_t n = m_Size;
+  if (n == 0) return;
+  const ComplexMatrixView<T> h = m_Schur.view();
+  const ComplexMatrixView<T> z = m_SchurVectors.view();
+  copy<T>(a, h);
+  for (std::size_t j = 0; j < z.cols(); ++j) {
+    for (std::size_t i = 0; i < z.rows(); ++i) z(i, j) = BasicComplex<T>(i == j ? 1 : 0, 0);
+  }
+  reduceHessenberg(pool);
+  const auto deflate = [&](const std::size_t lo, const std::size_t hi, std::size_t& shifts) {
+    return deflateWindow(lo, hi, shifts, pool);
+  };
+  if (!shiftedQr<T>(h, z, 0, n - 1, m_Vectors, deflate, m_Shifts, m_Cosines.data(), m_Sines.data())) {
+    throw std::runtime_error("EigenSolver: QR iteration did not converge");
+  }
+  for (std::size_t i = 0; i < n; ++i) m_Eigenvalues[i] = h(i, i);
+  if (m_Vectors) solveEigenvectors(pool);
+}
+
+/// Reduces the matrix to Hessenberg form H = Q^H A Q panel by panel, and accumulates Q if vectors were requested.
+/// The reflectors of a panel are applied to the columns right of it with a few matrix products: A = (I - V T^H V^H)
+/// (A - Y V^H).
+template <scalar T>
+void BasicEigenSolver<T>::reduceHessenberg(ThreadPool& pool) {
+  const std::size_t n = m_Size;
+  const std::size_t count = n > 2 ? n - 2 : 0;
+  const ComplexMatrixView<T> h = m_Schur.view();
+  const BasicComplex<T> one(1, 0);
+  const BasicComplex<T> zero;
+  for (std::size_t k = 0; k < count; k += DECOMPOSITION_BLOCK_SIZE) {
+    const auto kb = static_cast<size_t>(std::min<std::size_t>(DECOMPOSITION_BLOCK_SIZE, count - k));
+    reducePanel(k, kb);
+    const auto rest = static_cast<size_t>(n - k - kb);
+    const auto below = static_cast<size_t>(n - k - 1);
+    const ComplexMatrixView<T> v = m_Reflectors.submatrix(k + 1, 0, below, kb);
+    const ComplexMatrixView<T> vh = m_ReflectorsAdjoint.submatrix(0, k + 1, kb, below);
+    const ComplexMatrixView<T> y = m_Y.submatrix(0, 0, n, kb);
+    gemm(-one, y, m_ReflectorsAdjoint.submatrix(0, k + kb, kb, rest), one, h.submatrix(0, k + kb, n, rest), pool);
+
+    const ComplexMatrixView<T> triangular = m_Triangular.submatrix(0, 0, kb, kb);
+    const ComplexMatrixView<T> adjoint = m_TriangularAdjoint.submatrix(0, 0, kb, kb);
+    for (std::size_t j = 0; j < kb; ++j) {
+      for (std::size_t i = 0; i < kb; ++i) adjoint(i, j) = i >= j ? conj(triangular(j, i)) : zero;
+    }
+    const ComplexMatrixView<T> trailing = h.submatrix(k + 1, k + kb, below, rest);
+    const ComplexMatrixView<T> product = m_RowProduct.submatrix(0, 0, kb, rest);
+    const ComplexMatrixView<T> productT = m_RowProductT.submatrix(0, 0, kb, rest);
+    gemm(one, vh, trailing, zero, product, pool);
+    gemm(one, adjoint, product, zero, productT, pool);
+    gemm(-one, v, productT, one, trailing, pool);
+
+    if (m_Vectors) {
+      // Q = Q (I - V T V^H)
+      const ComplexMatrixView<T> q = m_SchurVectors.submatrix(0, k + 1, n, below);
+      gemm(one, q, v, zero, y, pool);
+      gemm(one, y, triangular, zero, m_PanelProduct.submatrix(0, 0, n, kb), pool);
+      gemm(-one, m_PanelProduct.submatrix(0, 0, n, kb), vh, one, q, pool);
+    }
+  }
+}
+
+/// Computes the reflectors of the columns [col, col + width) as LAPACK's zlahr2: every column is first brought up to
+/// date by the reflectors before it, the right-hand updates through Y = A V T, which gains a column per reflector, so
+/// that the columns right of the panel need not be updated until the panel is done. Fills V, V^H, T and Y.
+template <scalar T>
+void BasicEigenSolver<T>::reducePanel(const std::size_t col, const std::size_t width) {
+  const std::size_t n = m_Size;
+  const ComplexMatrixView<T> h = m_Schur.view();
+  const ComplexMatrixView<T> v = m_Reflectors.view();
+  const ComplexMatrixView<T> vh = m_ReflectorsAdjoint.view();
+  const ComplexMatrixView<T> y = m_Y.view();
+  const ComplexMatrixView<T> t = m_Triangular.view();
+  BasicComplex<T>* w = m_Vector.data();
+  for (std::size_t p = 0; p < width; ++p) {
+    const std::size_t j = col + p;
+    BasicComplex<T>* a = &h(0, j);
+    if (p > 0) {
+      // A(:, j) -= Y V(j, :)^H, then A(col + 1:, j) = (I - V T^H V^H) A(col + 1:, j)
+      for (std::size_t q = 0; q < p; ++q) subtractMultiple<T>(conj(v(j, q)), &y(0, q), 1, a, 1, n);
+      const std::size_t rows = n - col - 1;
+      for (std::size_t q = 0; q < p; ++q) w[q] = conjugateDot(&v(col + 1, q), a + col + 1, rows);
+      for (std::size_t q = p; q-- > 0;) {
+        BasicComplex<T> sum;
+        for (std::size_t r = 0; r <= q; ++r) sum += conj(t(r, q)) * w[r];
+        w[q] = sum;
+      }
+      for (std::size_t q = 0; q < p; ++q) subtractMultiple<T>(w[q], &v(col + 1, q), 1, a + col + 1, 1, rows);
+    }
+
+    const std::size_t rows = n - j - 1;
+    const BasicComplex<T> tau = householder(a + j + 1, rows);
+    for (std::size_t i = 0; i < n; ++i) {
+      BasicComplex<T> element;
+      if (i == j + 1) {
+        element = BasicComplex<T>(1, 0);
+      } else if (i > j + 1) {
+        element = a[i];
+        a[i] = BasicComplex<T>();
+      }
+      v(i, p) = element;
+      vh(p, i) = conj(element);
+    }
+
+    // T(0:p, p) = -tau T(0:p, 0:p) g and Y(:, p) = tau (A(:, j + 1:) v - Y(:, 0:p) g) with g = V(:, 0:p)^H v
+    for (std::size_t q = 0; q < p; ++q) w[q] = conjugateDot(&v(j + 1, q), &v(j + 1, p), rows);
+    for (std::size_t r = 0; r < p; ++r) {
+      BasicComplex<T> sum;
+      for (std::size_t q = r; q < p; ++q) sum += t(r, q) * w[q];
+      t(r, p) = -tau * sum;
+    }
+    t(p, p) = tau;
+    BasicComplex<T>* column = &y(0, p);
+    std::fill_n(column, n, BasicComplex<T>());
+    for (std::size_t c = j + 1; c < n; ++c) {
+      if (!isZero(v(c, p))) subtractMultiple<T>(-v(c, p), &h(0, c), 1, column, 1, n);
+    }
+    for (std::size_t q = 0; q < p; ++q) subtractMultiple<T>(w[q], &y(0, q), 1, column, 1, n);
+    for (std::size_t i = 0; i < n; ++i) column[i] *= tau;
+  }
+}
+
+/// Aggressive early deflation of the active block [lo, hi] as LAPACK's zlaqr3: computes the Schur form S = U^H W U of
+/// a window W at the bottom of the block, whose first column is coupled to the rest of the block by the single element
+/// s = H(kw, kw - 1). After the similarity transformation this coupling becomes the spike s U(0, :)^H, and the
+/// eigenvalues with a negligible element of the spike have converged. The others are moved to the top of the window,
+/// the spike is reduced to its first element by a reflector and the window back to Hessenberg form.
+/// @param shifts Set to the number of eigenvalues of the window that did not converge, left as shifts
+/// @return Number of rows that converged at the bottom of the block
+template <scalar T>
+std::size_t BasicEigenSolver<T>::deflateWindow(const std::size_t lo, const std::size_t hi, std::size_t& shifts,
+                                               ThreadPool& pool) {
+  const std::size_t w = deflationWindow(hi - lo + 1);
+  if (w == 0) return 0;
+  const std::size_t n = m_Size;
+  const std::size_t kw = hi + 1 - w;
+  const ComplexMatrixView<T> h = m_Schur.view();
+  const ComplexMatrixView<T> window = m_Window.submatrix(0, 0, w, w);
+  const ComplexMatrixView<T> u = m_WindowVectors.submatrix(0, 0, w, w);
+  copy<T>(h.submatrix(kw, kw, w, w), window);
+  for (std::size_t j = 0; j < w; ++j) {
+    for (std::size_t i = 0; i < w; ++i) u(i, j) = BasicComplex<T>(i == j ? 1 : 0, 0);
+  }
+  const auto none = [](std::size_t, std::size_t, std::size_t&) { return std::size_t(0); };
+  if (!shiftedQr<T>(window, u, 0, w - 1, true, none, {}, m_Cosines.data(), m_Sines.data())) return 0;
+
+  const BasicComplex<T> s = h(kw, kw - 1);
+  const T ulp = std::numeric_limits<T>::epsilon();
+  const T small = std::numeric_limits<T>::min() * (static_cast<T>(n) / ulp);
+  std::size_t undeflated = w;
+  for (std::size_t top = 0; top < undeflated;) {
+    const std::size_t k = undeflated - 1;
+    T magnitude = magnitude1(window(k, k));
+    if (magnitude == 0) magnitude = magnitude1(s);
+    if (magnitude1(s) * magnitude1(u(0, k)) <= std::max(small, ulp * magnitude)) {
+      --undeflated;
+      continue;
+    }
+    for (std::size_t j = k; j > top; --j) swapDiagonal(window, u, j - 1);
+    ++top;
+  }
+  for (std::size_t k = 0; k < undeflated; ++k) m_Shifts[k] = window(k, k);
+  const std::size_t deflated = w - undeflated;
+  // Many deflations suggest more of them, and the next window follows at once
+  shifts = deflated * 100 > DEFLATION_NIBBLE * w ? 0 : undeflated;
+  if (deflated == 0) return 0;
+
+  if (undeflated > 1) {
+    BasicComplex<T>* v = m_Vector.data();
+    BasicComplex<T>* work = v + w;
+    for (std::size_t k = 0; k < undeflated; ++k) v[k] = s * conj(u(0, k));
+    const BasicComplex<T> tau = householder(v, undeflated);
+    v[0] = BasicComplex<T>(1, 0);
+    reflectLeft<T>(v, tau, window.submatrix(0, 0, undeflated, w));
+    reflectRight<T>(v, tau, window.submatrix(0, 0, undeflated, undeflated), work);
+    reflectRight<T>(v, tau, u.submatrix(0, 0, w, undeflated), work);
+    for (std::size_t j = 0; j + 2 < undeflated; ++j) {
+      const std::size_t rows = undeflated - j - 1;
+      BasicComplex<T>* column = &window(j + 1, j);
+      const BasicComplex<T> reflector = householder(column, rows);
+      v[0] = BasicComplex<T>(1, 0);
+      for (std::size_t i = 1; i < rows; ++i) {
+        v[i] = column[i];
+        column[i] = BasicComplex<T>();
+      }
+      reflectLeft<T>(v, reflector, window.submatrix(j + 1, j + 1, rows, w - j - 1));
+      reflectRight<T>(v, reflector, window.submatrix(0, j + 1, undeflated, rows), work);
+      reflectRight<T>(v, reflector, u.submatrix(0, j + 1, w, rows), work);
+    }
+  }
+  copy<T>(window, h.submatrix(kw, kw, w, w));
+  h(kw, kw - 1) = undeflated == 0 ? BasicComplex<T>() : s * conj(u(0, 0));
+
+  // The rows above and the columns right of the window, and the Schur vectors
+  const BasicComplex<T> one(1, 0);
+  const BasicComplex<T> zero;
+  const std::size_t top = m_Vectors ? 0 : lo;
+  const std::size_t end = m_Vectors ? n : hi + 1;
+  if (kw > top) {
+    const ComplexMatrixView<T> above = h.submatrix(top, kw, kw - top, w);
+    const ComplexMatrixView<T> product = m_WindowColumns.submatrix(0, 0, kw - top, w);
+    gemm(one, above, u, zero, product, pool);
+    copy<T>(product, above);
+  }
+  if (end > hi + 1) {
+    const ComplexMatrixView<T> adjoint = m_WindowAdjoint.submatrix(0, 0, w, w);
+    for (std::size_t j = 0; j < w; ++j) {
+      for (std::size_t i = 0; i < w; ++i) adjoint(i, j) = conj(u(j, i));
+    }
+    const ComplexMatrixView<T> right = h.submatrix(kw, hi + 1, w, end - hi - 1);
+    const ComplexMatrixView<T> product = m_WindowRows.submatrix(0, 0, w, end - hi - 1);
+    gemm(one, adjoint, right, zero, product, pool);
+    copy<T>(product, right);
+  }
+  if (m_Vectors) {
+    const ComplexMatrixView<T> z = m_SchurVectors.submatrix(0, kw, n, w);
+    const ComplexMatrixView<T> product = m_WindowColumns.submatrix(0, 0, n, w);
+    gemm(one, z, u, zero, product, pool);
+    copy<T>(product, z);
+  }
+  return deflated;
+}
+
+/// Solves (T - T(k, k) I) x = 0 for every k by back substitution with x(k) = 1, perturbing divisors that are almost
+/// zero and scaling x as it grows, then transforms the solutions by Z and normalizes them
+template <scalar T>
+void BasicEigenSolver<T>::solveEigenvectors(ThreadPool& pool) {
+  const std::size_t n = m_Size;
+  const ComplexMatrixView<T> t = m_Schur.view();
+  const ComplexMatrixView<T> x = m_Work.view();
+  const T ulp = std::numeric_limits<T>::epsilon();
+  const T small = std::numeric_limits<T>::min() * (static_cast<T>(n) / ulp);
+  const T large = std::sqrt(std::numeric_limits<T>::max());
+  for (std::size_t k = 0; k < n; ++k) {
+    const BasicComplex<T> lambda = t(k, k);
+    const T smallest = std::max(ulp * magnitude1(lambda), small);
+    BasicComplex<T>* column = &x(0, k);
+    std::fill(column + k + 1, column + n, BasicComplex<T>());
+    column[k] = BasicComplex<T>(1, 0);
+    for (std::size_t i = 0; i < k; ++i) column[i] = -t(i, k);
+    for (std::size_t p = k; p-- > 0;) {
+      BasicComplex<T> divisor = t(p, p) - lambda;
+      if (magnitude1(divisor) < smallest) divisor = BasicComplex<T>(smallest, 0);
+      column[p] = scaledDivide(column[p], divisor);
+      if (magnitude1(column[p]) > large) {
+        const T scale = 1 / magnitude1(column[p]);
+        for (std::size_t i = 0; i <= k; ++i) column[i] *= scale;
+      }
+      subtractMultiple<T>(column[p], &t(0, p), 1, column, 1, p);
+    }
+  }
+  const ComplexMatrixView<T> vectors = m_Eigenvectors.view();
+  gemm(BasicComplex<T>(1, 0), m_SchurVectors.view(), x, BasicComplex<T>(), vectors, pool);
+  for (std::size_t k = 0; k < n; ++k) {
+    BasicComplex<T>* column = &vectors(0, k);
+    const T length = norm(column, n);
+    if (length == 0) continue;
+    for (std::size_t i = 0; i < n; ++i) column[i] /= length;
+  }
+}
+
+/// Allocates one solver per thread of the pool
+/// @param size Number of rows and columns of the matrices
+/// @param vectors Whether to compute the eigenvectors besides the eigenvalues
+/// @param pool Threads that solve the matrices
+template <scalar T>
+BasicBatchedEigenSolver<T>::BasicBatchedEigenSolver(const size_t size, const bool vectors, ThreadPool& pool)
+    : m_Pool(&pool), m_Size(size), m_Vectors(vectors) {
+  for (std::size_t i = 0; i < pool.threadCount(); ++i) m_Free.push_back(&m_Solvers.emplace_back(size, vectors));
+}
+
+/// Computes the eigenvalues, and the eigenvectors if they were requested, of every matrix. Chunks of matrices are
+/// solved in parallel, each by a solver that is free while the chunk runs. A call that runs while another one owns
+/// the pool needs a solver beyond one per thread, which is allocated then and kept for later calls.
+/// @param matrices size() x size() matrices
+/// @param eigenvalues matrices.size() * size() numbers, the eigenvalues of matrix i at i * size()
+/// @param eigenvectors One size() x size() matrix per matrix for its eigenvectors, or empty
+template <scalar T>
+void BasicBatchedEigenSolver<T>::compute(const std::span<const ComplexMatrixView<const T>> matrices,
+                                         const std::span<BasicComplex<T>> eigenvalues,
+                                         const std::span<const ComplexMatrixView<T>> eigenvectors) {
+  const std::size_t n = size();
+  for (const ComplexMatrixView<const T>& matrix : matrices) {
+    if (matrix.rows() != n || matrix.cols() != n) {
+      throw std::invalid_argument("BatchedEigenSolver: matrices must be size() x size()");
+    }
+  }
+  if (eigenvalues.size() != matrices.size() * n) {
+    throw std::invalid_argument("BatchedEigenSolver: eigenvalues must hold size() numbers per matrix");
+  }
+  if (!eigenvectors.empty()) {
+    if (!vectors()) throw std::invalid_argument("BatchedEigenSolver: eigenvectors were not requested");
+    if (eigenvectors.size() != matrices.size()) {
+      throw std::invalid_argument("BatchedEigenSolver: eigenvectors must hold one matrix per matrix");
+    }
+    for (const ComplexMatrixView<T>& matrix : eigenvectors) {
+      if (matrix.rows() != n || matrix.cols() != n) {
+        throw std::invalid_argument("BatchedEigenSolver: eigenvectors must be size() x size()");
+      }
+    }
+  }
+  m_Pool->parallelForRange(0, matrices.size(), 1, [&](const std::size_t first, const std::size_t last) {
+    // Takes a free solver for the chunk and returns it also when the chunk throws
+    struct Lease {
+      BasicBatchedEigenSolver& owner;
+      BasicEigenSolver<T>* solver;
+
+      explicit Lease(BasicBatchedEigenSolver& batched) : owner(batched) {
+        const std::lock_guard lock(owner.m_Mutex);
+        if (owner.m_Free.empty()) owner.m_Free.push_back(&owner.m_Solvers.emplace_back(owner.m_Size, owner.m_Vectors));
+        solver = owner.m_Free.back();
+        owner.m_Free.pop_back();
+      }
+      Lease(const Lease&) = delete;
+      Lease& operator=(const Lease&) = delete;
+      ~Lease() {
+        const std::lock_guard lock(owner.m_Mutex);
+        owner.m_Free.push_back(solver);
+      }
+    };
+    const Lease lease(*this);
+    BasicEigenSolver<T>& solver = *lease.solver;
+    for (std::size_t i = first; i < last; ++i) {
+      solver.compute(matrices[i], *m_Pool);
+      std::copy(solver.eigenvalues().begin(), solver.eigenvalues().end(), eigenvalues.begin() + i * n);
+      if (!eigenvectors.empty()) copy<T>(solver.eigenvectors(), eigenvectors[i]);
+    }
+  });
+}
+
+template class BasicLuDecomposition<float>;
+template class BasicLuDecomposition<double>;
+template class BasicLuDecomposition<long double>;
+
+template class BasicQrDecomposition<float>;
+template class BasicQrDecomposition<double>;
+template class BasicQrDecomposition<long double>;
+
+template class BasicEigenSolver<float>;
+template class BasicEigenSolver<double>;
+template class BasicEigenSolver<long double>;
+
+template class BasicBatchedEigenSolver<float>;
+template class BasicBatchedEigenSolver<double>;
+template class BasicBatchedEigenSolver<long double>;
+
+}  // namespace Math
@@ -0,0 +1,364 @@
+#include "ComplexFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "ComplexArray.h"
+
+namespace Math {
+
+namespace {
+
+constexpr char MAGIC[8] = {'M', 'A', 'T', 'H', 'C', 'P', 'L', 'X'};
+constexpr uint16_t VERSION = 1;
+constexpr uint8_t LITTLE_ENDIAN_ORDER = 1;
+constexpr uint8_t BIG_ENDIAN_ORDER = 2;
+constexpr uint8_t NATIVE_ORDER = std::endian::native == std::endian::little ? LITTLE_ENDIAN_ORDER : BIG_ENDIAN_ORDER;
+
+/// Smallest capacity that a growing file reserves
+constexpr std::size_t MIN_CAPACITY = 4096;
+
+/// Numbers that append converts between the layouts at once
+constexpr std::size_t APPEND_BLOCK_SIZE = std::size_t(1) << 20;
+
+/// Header of a complex file, see BasicComplexFile
+struct Header {
+  char magic[8];
+  uint16_t version;
+  uint8_t scalarSize;
+  uint8_t layout;
+  uint8_t byteOrder;
+  uint8_t reserved0[3];
+  uint64_t size;
+  uint64_t capacity;
+  uint8_t reserved1[32];
+};
+
+static_assert(sizeof(Header) == 64);
+static_assert(MEMORY_ALIGNMENT == 64);
+
+template <typename U>
+void swapBytes(U& x) {
+  std::byte* const bytes = reinterpret_cast<std::byte*>(&x);
+  std::reverse(bytes, bytes + sizeof(U));
+}
+
+[[noreturn]] void throwSystemError(const char* what) {
+  throw std::system_error(errno, std::generic_category(), std::string("ComplexFile: ") + what);
+}
+
+/// @return Capacity rounded up to a multiple of MEMORY_ALIGNMENT bytes
+template <typename T>
+std::size_t alignedCapacity(const std::size_t capacity) {
+  constexpr std::size_t n = MEMORY_ALIGNMENT / sizeof(T);
+  return (capacity + n - 1) / n * n;
+}
+
+/// @return Size of a file with the numbers of a capacity in bytes
+template <typename T>
+std::size_t fileSize(const std::size_t capacity) {
+  return BasicComplexFile<T>::HEADER_SIZE + 2 * capacity * sizeof(T);
+}
+
+}  // namespace
+
+template <scalar T>
+BasicComplexFile<T>::BasicComplexFile(BasicComplexFile&& other) noexcept
+    : m_Descriptor(std::exchange(other.m_Descriptor, -1)),
+      m_Mapping(std::exchange(other.m_Mapping, nullptr)),
+      m_MappingSize(std::exchange(other.m_MappingSize, 0)),
+      m_Size(std::exchange(other.m_Size, 0)),
+      m_Capacity(std::exchange(other.m_Capacity, 0)),
+      m_Layout(other.m_Layout),
+      m_Access(other.m_Access) {}
+
+template <scalar T>
+BasicComplexFile<T>& BasicComplexFile<T>::operator=(BasicComplexFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    m_Descriptor = std::exchange(other.m_Descriptor, -1);
+    m_Mapping = std::exchange(other.m_Mapping, nullptr);
+    m_MappingSize = std::exchange(other.m_MappingSize, 0);
+    m_Size = std::exchange(other.m_Size, 0);
+    m_Capacity = std::exchange(other.m_Capacity, 0);
+    m_Layout = other.m_Layout;
+    m_Access = other.m_Access;
+  }
+  return *this;
+}
+
+/// Writes the header, trims the unused capacity and unmaps the file
+template <scalar T>
+BasicComplexFile<T>::~BasicComplexFile() {
+  close();
+}
+
+/// Opens an existing file
+/// @param path Path of the file
+/// @param access Read, or read and write
+/// @return Mapped file
+template <scalar T>
+BasicComplexFile<T> BasicComplexFile<T>::open(const std::filesystem::path& path, const FileAccess access) {
+  BasicComplexFile file;
+  file.m_Access = access;
+  file.m_Descriptor = ::open(path.c_str(), (access == FileAccess::Read ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+  if (file.m_Descriptor < 0) throwSystemError("cannot open the file");
+  struct stat status {};
+  if (fstat(file.m_Descriptor, &status) != 0) throwSystemError("cannot read the file size");
+  Header header{};
+  if (static_cast<std::size_t>(status.st_size) < HEADER_SIZE ||
+      pread(file.m_Descriptor, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+      std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::invalid_argument("ComplexFile: not a complex file");
+  }
+  if (header.byteOrder != LITTLE_ENDIAN_ORDER && header.byteOrder != BIG_ENDIAN_ORDER) {
+    throw std::invalid_argument("ComplexFile: unknown byte order");
+  }
+  const bool foreign = header.byteOrder != NATIVE_ORDER;
+  if (foreign) {
+    swapBytes(header.version);
+    swapBytes(header.size);
+    swapBytes(header.capacity);
+  }
+  if (header.version != VERSION) throw std::invalid_argument("ComplexFile: unsupported version");
+  if (header.scalarSize != sizeof(T)) throw std::invalid_argument("ComplexFile: precision differs");
+  if (header.layout > static_cast<uint8_t>(ComplexLayout::Split)) {
+    throw std::invalid_argument("ComplexFile: unknown layout");
+  }
+  file.m_Layout = static_cast<ComplexLayout>(header.layout);
+  file.m_Size = header.size;
+  file.m_Capacity = file.m_Layout == ComplexLayout::Split ? header.capacity : header.size;
+  // Compared before fileSize, which would overflow for the capacity of a corrupted header
+  const std::size_t maxCapacity = (static_cast<std::size_t>(status.st_size) - HEADER_SIZE) / (2 * sizeof(T));
+  if (file.m_Capacity < file.m_Size || file.m_Capacity > maxCapacity) {
+    throw std::invalid_argument("ComplexFile: file is truncated");
+  }
+  if (!foreign) {
+    file.map(fileSize<T>(file.m_Capacity));
+    return file;
+  }
+  // Foreign byte order: swap the parts in a private copy of the mapping
+  if (access != FileAccess::Read || sizeof(T) > sizeof(double)) {
+    throw std::invalid_argument("ComplexFile: foreign byte order can only be read, and not for long double");
+  }
+  file.m_MappingSize = fileSize<T>(file.m_Capacity);
+  void* const mapping = mmap(nullptr, file.m_MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file.m_Descriptor, 0);
+  if (mapping == MAP_FAILED) throwSystemError("cannot map the file");
+  file.m_Mapping = static_cast<std::byte*>(mapping);
+  // Interleaved files have the capacity size, so the two ranges cover all parts in both layouts
+  for (std::size_t i = 0; i < file.m_Size; ++i) {
+    swapBytes(file.real()[i]);
+    swapBytes(file.imag()[i]);
+  }
+  if (mprotect(mapping, file.m_MappingSize, PROT_READ) != 0) throwSystemError("cannot protect the mapping");
+  return file;
+}
+
+/// Creates an empty file for reading and writing, replacing an existing one
+/// @param path Path of the file
+/// @param layout Order of the numbers
+/// @param capacity Numbers for which space is reserved, so that appending them does not move the mapping
+/// @return Mapped file
+template <scalar T>
+BasicComplexFile<T> BasicComplexFile<T>::create(const std::filesystem::path& path, const ComplexLayout layout,
+                                                const std::size_t capacity) {
+  BasicComplexFile file;
+  file.m_Access = FileAccess::ReadWrite;
+  file.m_Layout = layout;
+  file.m_Descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (file.m_Descriptor < 0) throwSystemError("cannot create the file");
+  if (ftruncate(file.m_Descriptor, static_cast<off_t>(HEADER_SIZE)) != 0) throwSystemError("cannot resize the file");
+  file.map(HEADER_SIZE);
+  file.reserve(capacity);
+  file.writeHeader();
+  return file;
+}
+
+template <scalar T>
+T* BasicComplexFile<T>::real() const {
+  return reinterpret_cast<T*>(m_Mapping + HEADER_SIZE);
+}
+
+/// @return Imaginary parts of a split file
+template <scalar T>
+T* BasicComplexFile<T>::imag() const {
+  return real() + m_Capacity;
+}
+
+template <scalar T>
+void BasicComplexFile<T>::checkWritable() const {
+  if (m_Access != FileAccess::ReadWrite) throw std::invalid_argument("ComplexFile: file is read-only");
+}
+
+template <scalar T>
+void BasicComplexFile<T>::checkLayout(const ComplexLayout layout) const {
+  if (m_Layout != layout) throw std::invalid_argument("ComplexFile: layout differs");
+}
+
+/// Replaces the mapping by one of the first bytes of the file
+template <scalar T>
+void BasicComplexFile<T>::map(const std::size_t bytes) {
+  if (m_Mapping != nullptr) munmap(m_Mapping, m_MappingSize);
+  m_Mapping = nullptr;
+  const int protection = m_Access == FileAccess::Read ? PROT_READ : PROT_READ | PROT_WRITE;
+  void* const mapping = mmap(nullptr, bytes, protection, MAP_SHARED, m_Descriptor, 0);
+  if (mapping == MAP_FAILED) throwSystemError("cannot map the file");
+  m_Mapping = static_cast<std::byte*>(mapping);
+  m_MappingSize = bytes;
+}
+
+/// Grows the file and its mapping to a capacity, and moves the imaginary parts of a split file behind it
+template <scalar T>
+void BasicComplexFile<T>::reserve(const std::size_t capacity) {
+  const std::size_t aligned = alignedCapacity<T>(capacity);
+  if (aligned <= m_Capacity) return;
+  const std::size_t bytes = fileSize<T>(aligned);
+  if (ftruncate(m_Descriptor, static_cast<off_t>(bytes)) != 0) throwSystemError("cannot resize the file");
+  map(bytes);
+  if (m_Layout == ComplexLayout::Split) std::memmove(real() + aligned, imag(), m_Size * sizeof(T));
+  m_Capacity = aligned;
+}
+
+template <scalar T>
+void BasicComplexFile<T>::writeHeader() {
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.scalarSize = sizeof(T);
+  header.layout = static_cast<uint8_t>(m_Layout);
+  header.byteOrder = NATIVE_ORDER;
+  header.size = m_Size;
+  header.capacity = m_Layout == ComplexLayout::Split ? m_Capacity : m_Size;
+  std::memcpy(m_Mapping, &header, sizeof(header));
+}
+
+/// Writes the header, trims the file to its numbers and releases the mapping and the descriptor. Errors are ignored,
+/// the destructor cannot report them.
+template <scalar T>
+void BasicComplexFile<T>::close() {
+  if (m_Mapping != nullptr) {
+    if (m_Access == FileAccess::ReadWrite) {
+      const std::size_t capacity = m_Layout == ComplexLayout::Split ? alignedCapacity<T>(m_Size) : m_Size;
+      if (m_Layout == ComplexLayout::Split) std::memmove(real() + capacity, imag(), m_Size * sizeof(T));
+      m_Capacity = capacity;
+      writeHeader();
+    }
+    munmap(m_Mapping, m_MappingSize);
+    if (m_Access == FileAccess::ReadWrite) {
+      static_cast<void>(ftruncate(m_Descriptor, static_cast<off_t>(fileSize<T>(m_Capacity))));
+    }
+    m_Mapping = nullptr;
+  }
+  if (m_Descriptor >= 0) ::close(m_Descriptor);
+  m_Descriptor = -1;
+}
+
+/// @return Numbers of a split file. Spans are valid until the file grows or is closed.
+template <scalar T>
+SplitSpan<const T> BasicComplexFile<T>::split() const {
+  return split(0, m_Size);
+}
+
+/// @return Numbers of a split file that was opened for writing
+template <scalar T>
+SplitSpan<T> BasicComplexFile<T>::split() {
+  return split(0, m_Size);
+}
+
+/// Numbers of a split file, for files with more numbers than a SplitSpan holds
+/// @param offset Index of the first number
+/// @param count Number of numbers
+/// @return Numbers offset to offset + count
+template <scalar T>
+SplitSpan<const T> BasicComplexFile<T>::split(const std::size_t offset, const std::size_t count) const {
+  checkLayout(ComplexLayout::Split);
+  if (offset > m_Size || count > m_Size - offset) throw std::invalid_argument("ComplexFile: range exceeds the file");
+  if (count > std::numeric_limits<size_t>::max()) {
+    throw std::length_error("ComplexFile: range exceeds a SplitSpan, read the file in parts");
+  }
+  return SplitSpan<const T>(real() + offset, imag() + offset, static_cast<size_t>(count));
+}
+
+/// Numbers of a split file that was opened for writing, for files with more numbers than a SplitSpan holds
+/// @param offset Index of the first number
+/// @param count Number of numbers
+/// @return Numbers offset to offset + count
+template <scalar T>
+SplitSpan<T> BasicComplexFile<T>::split(const std::size_t offset, const std::size_t count) {
+  checkWritable();
+  const SplitSpan<const T> z = std::as_const(*this).split(offset, count);
+  return SplitSpan<T>(const_cast<T*>(z.realData()), const_cast<T*>(z.imagData()), z.size());
+}
+
+/// @return Numbers of an interleaved file. Spans are valid until the file grows or is closed.
+template <scalar T>
+std::span<const BasicComplex<T>> BasicComplexFile<T>::interleaved() const {
+  checkLayout(ComplexLayout::Interleaved);
+  return {reinterpret_cast<const BasicComplex<T>*>(real()), m_Size};
+}
+
+/// @return Numbers of an interleaved file that was opened for writing
+template <scalar T>
+std::span<BasicComplex<T>> BasicComplexFile<T>::interleaved() {
+  checkWritable();
+  checkLayout(ComplexLayout::Interleaved);
+  return {reinterpret_cast<BasicComplex<T>*>(real()), m_Size};
+}
+
+/// Appends numbers, growing the file geometrically when its capacity is exhausted
+/// @param z Numbers, in either layout
+template <scalar T>
+void BasicComplexFile<T>::append(const std::type_identity_t<SplitSpan<const T>> z) {
+  checkWritable();
+  if (m_Size + z.size() > m_Capacity) reserve(std::max({m_Size + z.size(), 2 * m_Capacity, MIN_CAPACITY}));
+  if (m_Layout == ComplexLayout::Split) {
+    std::memcpy(real() + m_Size, z.realData(), z.size() * sizeof(T));
+    std::memcpy(imag() + m_Size, z.imagData(), z.size() * sizeof(T));
+  } else {
+    interleave<T>(z, std::span(reinterpret_cast<BasicComplex<T>*>(real()) + m_Size, z.size()));
+  }
+  m_Size += z.size();
+}
+
+/// Appends numbers, growing the file geometrically when its capacity is exhausted
+/// @param z Interleaved numbers, in either layout
+template <scalar T>
+void BasicComplexFile<T>::append(const std::type_identity_t<std::span<const BasicComplex<T>>> z) {
+  checkWritable();
+  if (m_Size + z.size() > m_Capacity) reserve(std::max({m_Size + z.size(), 2 * m_Capacity, MIN_CAPACITY}));
+  if (m_Layout == ComplexLayout::Interleaved) {
+    std::memcpy(reinterpret_cast<BasicComplex<T>*>(real()) + m_Size, z.data(), z.size_bytes());
+  } else {
+    for (std::size_t i = 0; i < z.size(); i += APPEND_BLOCK_SIZE) {
+      const std::size_t n = std::min(APPEND_BLOCK_SIZE, z.size() - i);
+      deinterleave<T>(z.subspan(i, n), SplitSpan<T>(real() + m_Size + i, imag() + m_Size + i, static_cast<size_t>(n)));
+    }
+  }
+  m_Size += z.size();
+}
+
+/// Writes the header and the numbers to the disk
+template <scalar T>
+void BasicComplexFile<T>::flush() {
+  checkWritable();
+  writeHeader();
+  if (msync(m_Mapping, m_MappingSize, MS_SYNC) != 0) throwSystemError("cannot write the file");
+}
+
+template class BasicComplexFile<float>;
+template class BasicComplexFile<double>;
+template class BasicComplexFile<long double>;
+
+}  // namespace Math
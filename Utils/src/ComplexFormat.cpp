@@ -0,0 +1,274 @@
+#include "ComplexFormat.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Math {
+
+namespace {
+
+/// Size of the stack buffer through which write hands the text to the stream
+constexpr std::size_t WRITE_BUFFER_SIZE = 16384;
+
+/// Initial size of the chunks in which read takes the text from the stream
+constexpr std::size_t READ_CHUNK_SIZE = 65536;
+
+bool isSeparator(const char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';';
+}
+
+const char* skipSeparators(const char* p, const char* const last) {
+  while (p != last && isSeparator(*p)) ++p;
+  return p;
+}
+
+/// Writes count numbers z(i), each one followed by the separator
+template <typename T, typename Z>
+std::to_chars_result format(char* first, char* const last, const std::size_t count, const Z& z, const char separator) {
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::to_chars_result result = to_chars<T>(first, last, z(i));
+    if (result.ec != std::errc()) return result;
+    if (result.ptr == last) return {last, std::errc::value_too_large};
+    first = result.ptr;
+    *first++ = separator;
+  }
+  return {first, std::errc()};
+}
+
+/// Writes count numbers z(i) to a stream, each one followed by the separator
+template <typename T, typename Z>
+void write(std::ostream& os, const std::size_t count, const Z& z, const char separator) {
+  char buffer[WRITE_BUFFER_SIZE];
+  char* const end = buffer + WRITE_BUFFER_SIZE;
+  char* first = buffer;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (static_cast<std::size_t>(end - first) <= COMPLEX_CHARS_MAX<T>) {
+      os.write(buffer, first - buffer);
+      first = buffer;
+    }
+    first = to_chars<T>(first, end, z(i)).ptr;
+    *first++ = separator;
+  }
+  os.write(buffer, first - buffer);
+}
+
+/// Resizes an array to size numbers, checked before the size is narrowed to size_t
+template <typename T>
+void resize(BasicComplexArray<T>& out, const std::size_t size) {
+  if (size > MAX_ELEMENT_COUNT) throw std::length_error("ComplexFormat: size exceeds MAX_ELEMENT_COUNT");
+  out.resize(static_cast<size_t>(size));
+}
+
+template <typename T>
+void resize(std::vector<BasicComplex<T>>& out, const std::size_t size) {
+  out.resize(size);
+}
+
+/// @return Numbers of an array from offset on
+template <typename T>
+SplitSpan<T> tail(BasicComplexArray<T>& out, const std::size_t offset) {
+  return out.view().subspan(static_cast<size_t>(offset), out.size() - static_cast<size_t>(offset));
+}
+
+template <typename T>
+std::span<BasicComplex<T>> tail(std::vector<BasicComplex<T>>& out, const std::size_t offset) {
+  return std::span(out).subspan(offset);
+}
+
+/// Reads numbers into z(i, value) until the text ends or size numbers are read
+template <typename T, typename Z>
+ParseResult parse(const char* const first, const char* const last, const std::size_t size, const Z& z) {
+  const char* p = skipSeparators(first, last);
+  std::size_t count = 0;
+  for (; count < size && p != last; ++count) {
+    BasicComplex<T> value;
+    const std::from_chars_result result = from_chars<T>(p, last, value);
+    if (result.ec != std::errc()) return {p, count, result.ec};
+    if (result.ptr != last && !isSeparator(*result.ptr)) return {p, count, std::errc::invalid_argument};
+    z(count, value);
+    p = skipSeparators(result.ptr, last);
+  }
+  return {p, count, std::errc()};
+}
+
+/// @return End of the last run of separators in [first, last) that certainly lies between two numbers and is followed
+/// by one, or first if there is none. A number never contains line breaks or ';', but it may contain blanks around
+/// its sign, and blanks and ',' inside parentheses.
+const char* lastBoundary(const char* const first, const char* const last) {
+  // One past the last c before p, or first
+  const auto after = [first](const char* p, const char c) {
+    return std::find(std::make_reverse_iterator(p), std::make_reverse_iterator(first), c).base();
+  };
+  const auto sign = [](const char c) { return c == '+' || c == '-'; };
+  const auto breaks = [](const char c) { return c == '\n' || c == '\r' || c == ';'; };
+  const char* open = after(last, '(');
+  const char* close = after(last, ')');
+  const char* p = last;
+  while (p != first && isSeparator(p[-1])) --p;
+  while (p != first) {
+    while (p != first && !isSeparator(p[-1])) --p;
+    const char* const end = p;
+    while (p != first && isSeparator(p[-1])) --p;
+    if (p == end) break;
+    // The parentheses before the run, found again only when the run moves before them
+    if (open > p) open = after(p, '(');
+    if (close > p) close = after(p, ')');
+    if (open > close) continue;
+    if (std::any_of(p, end, breaks) || std::find(p, end, ',') != end || p == first || (!sign(p[-1]) && !sign(*end))) {
+      return end;
+    }
+  }
+  return first;
+}
+
+/// Reads a stream in chunks that end between two numbers and appends the numbers to out
+template <typename T, typename C>
+ReadResult readChunks(std::istream& is, C& out) {
+  std::vector<char> buffer(READ_CHUNK_SIZE);
+  std::size_t carried = 0;
+  ReadResult status{0, 0, std::errc()};
+  while (true) {
+    is.read(buffer.data() + carried, static_cast<std::streamsize>(buffer.size() - carried));
+    const std::size_t size = carried + static_cast<std::size_t>(is.gcount());
+    const bool end = size < buffer.size();
+    const char* const first = buffer.data();
+    const char* last = first + size;
+    if (!end) {
+      // Only a chunk without a separator between two numbers grows, until it holds a whole number
+      last = lastBoundary(first, last);
+      if (last == first) {
+        carried = size;
+        buffer.resize(2 * buffer.size());
+        continue;
+      }
+    }
+    // Every number but the last one takes a character and a separator
+    const std::size_t offset = out.size();
+    resize(out, offset + (static_cast<std::size_t>(last - first) + 1) / 2);
+    const ParseResult result = from_chars<T>(first, last, tail(out, offset));
+    resize(out, offset + result.count);
+    status.count += result.count;
+    if (result.ec != std::errc() || end) {
+      status.position += static_cast<std::size_t>(result.ptr - first);
+      status.ec = result.ec;
+      return status;
+    }
+    status.position += static_cast<std::size_t>(last - first);
+    carried = static_cast<std::size_t>(first + size - last);
+    std::memmove(buffer.data(), last, carried);
+  }
+}
+
+}  // namespace
+
+/// Writes complex numbers as text, each one as by to_chars and followed by a separator
+/// @param first Start of the buffer
+/// @param last End of the buffer, formattedSize<T>(z.size()) characters are always enough
+/// @param z Complex numbers
+/// @param separator Character after every number
+/// @return End of the text, or errc::value_too_large with ptr == last if the buffer is too small
+template <scalar T>
+std::to_chars_result to_chars(char* const first, char* const last, const std::type_identity_t<SplitSpan<const T>> z,
+                              const char separator) {
+  return format<T>(first, last, z.size(), [z](const std::size_t i) { return z[i]; }, separator);
+}
+
+/// Writes complex numbers as text, each one as by to_chars and followed by a separator
+/// @param first Start of the buffer
+/// @param last End of the buffer, formattedSize<T>(z.size()) characters are always enough
+/// @param z Interleaved complex numbers
+/// @param separator Character after every number
+/// @return End of the text, or errc::value_too_large with ptr == last if the buffer is too small
+template <scalar T>
+std::to_chars_result to_chars(char* const first, char* const last,
+                              const std::type_identity_t<std::span<const BasicComplex<T>>> z, const char separator) {
+  return format<T>(first, last, z.size(), [z](const std::size_t i) { return z[i]; }, separator);
+}
+
+/// Writes complex numbers to a stream, each one as by to_chars and followed by a separator. The text is formatted
+/// into a buffer on the stack and handed to the stream in large blocks, so a file is written at I/O speed.
+/// @param os Output stream
+/// @param z Complex numbers
+/// @param separator Character after every number
+template <scalar T>
+void write(std::ostream& os, const std::type_identity_t<SplitSpan<const T>> z, const char separator) {
+  write<T>(os, z.size(), [z](const std::size_t i) { return z[i]; }, separator);
+}
+
+/// Writes complex numbers to a stream, each one as by to_chars and followed by a separator. The text is formatted
+/// into a buffer on the stack and handed to the stream in large blocks, so a file is written at I/O speed.
+/// @param os Output stream
+/// @param z Interleaved complex numbers
+/// @param separator Character after every number
+template <scalar T>
+void write(std::ostream& os, const std::type_identity_t<std::span<const BasicComplex<T>>> z, const char separator) {
+  write<T>(os, z.size(), [z](const std::size_t i) { return z[i]; }, separator);
+}
+
+/// Reads complex numbers in the forms of from_chars, separated by blanks, line breaks, ',' or ';'. Errors are
+/// reported, not thrown.
+/// @param first Start of the text
+/// @param last End of the text
+/// @param z Complex numbers, read until the text ends or z is full
+/// @return Where reading stopped, numbers read and error
+template <scalar T>
+ParseResult from_chars(const char* const first, const char* const last, const std::type_identity_t<SplitSpan<T>> z) {
+  return parse<T>(first, last, z.size(), [z](const std::size_t i, const BasicComplex<T>& value) {
+    z.real()[i] = value.real();
+    z.imag()[i] = value.imag();
+  });
+}
+
+/// Reads complex numbers in the forms of from_chars, separated by blanks, line breaks, ',' or ';'. Errors are
+/// reported, not thrown.
+/// @param first Start of the text
+/// @param last End of the text
+/// @param z Interleaved complex numbers, read until the text ends or z is full
+/// @return Where reading stopped, numbers read and error
+template <scalar T>
+ParseResult from_chars(const char* const first, const char* const last,
+                       const std::type_identity_t<std::span<BasicComplex<T>>> z) {
+  return parse<T>(first, last, z.size(), [z](const std::size_t i, const BasicComplex<T>& value) { z[i] = value; });
+}
+
+/// Reads complex numbers from a stream until it ends and appends them to an array, see from_chars. The stream is
+/// read in large chunks that are cut between numbers, and every chunk is parsed straight into the array. Errors are
+/// reported, not thrown, the numbers before the error are appended.
+/// @param is Input stream
+/// @param out Array to append to
+/// @return Numbers appended, position and error
+/// @throws std::length_error If the array would exceed MAX_ELEMENT_COUNT
+template <scalar T>
+ReadResult read(std::istream& is, BasicComplexArray<T>& out) {
+  return readChunks<T>(is, out);
+}
+
+/// Reads complex numbers from a stream until it ends and appends them to a vector, see from_chars. The stream is
+/// read in large chunks that are cut between numbers, and every chunk is parsed straight into the vector. Errors are
+/// reported, not thrown, the numbers before the error are appended.
+/// @param is Input stream
+/// @param out Vector to append to
+/// @return Numbers appended, position and error
+template <scalar T>
+ReadResult read(std::istream& is, std::vector<BasicComplex<T>>& out) {
+  return readChunks<T>(is, out);
+}
+
+#define MATH_INSTANTIATE_COMPLEX_FORMAT(T)                                                         \
+  template std::to_chars_result to_chars<T>(char*, char*, SplitSpan<const T>, char);               \
+  template std::to_chars_result to_chars<T>(char*, char*, std::span<const BasicComplex<T>>, char); \
+  template void write<T>(std::ostream&, SplitSpan<const T>, char);                                 \
+  template void write<T>(std::ostream&, std::span<const BasicComplex<T>>, char);                   \
+  template ParseResult from_chars<T>(const char*, const char*, SplitSpan<T>);                      \
+  template ParseResult from_chars<T>(const char*, const char*, std::span<BasicComplex<T>>);        \
+  template ReadResult read<T>(std::istream&, BasicComplexArray<T>&);                               \
+  template ReadResult read<T>(std::istream&, std::vector<BasicComplex<T>>&);
+
+MATH_INSTANTIATE_COMPLEX_FORMAT(float)
+MATH_INSTANTIATE_COMPLEX_FORMAT(double)
+MATH_INSTANTIATE_COMPLEX_FORMAT(long double)
+
+#undef MATH_INSTANTIATE_COMPLEX_FORMAT
+
+}  // namespace Math
@@ -0,0 +1,431 @@
+#include "ComplexMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+/// Number of interleaved elements that are converted to split form at once, and block length of the power sequences
+constexpr std::size_t BLOCK_SIZE = 256;
+
+/// Number of blocks of a power sequence after which its anchor is recomputed instead of advanced by the recurrence
+constexpr std::size_t RENORMALIZATION_INTERVAL = 16;
+
+template <typename T>
+Kernels::Split<T> split(const SplitSpan<T> z) {
+  return {z.realData(), z.imagData()};
+}
+
+template <typename T>
+const Kernels::TranscendentalKernels<T>& kernels() {
+  return Kernels::table<T>().transcendental;
+}
+
+void checkSize(const std::size_t size, const std::size_t expected) {
+  if (size != expected) throw std::invalid_argument("ComplexMath: operands differ in size");
+}
+
+template <typename T>
+void unary(const typename Kernels::TranscendentalKernels<T>::Unary kernel, const SplitSpan<const T> z,
+           const SplitSpan<T> out) {
+  checkSize(z.size(), out.size());
+  kernel(split(z), split(out), out.size());
+}
+
+/// Split copy of a block of interleaved complex numbers
+template <typename T>
+struct Block {
+  alignas(MEMORY_ALIGNMENT) T real[BLOCK_SIZE];
+  alignas(MEMORY_ALIGNMENT) T imag[BLOCK_SIZE];
+
+  void load(const BasicComplex<T>* z, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      real[i] = z[i].real();
+      imag[i] = z[i].imag();
+    }
+  }
+
+  void store(BasicComplex<T>* out, const std::size_t n) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] = BasicComplex<T>(real[i], imag[i]);
+  }
+
+  Kernels::Split<T> split() { return {real, imag}; }
+  Kernels::Split<const T> split() const { return {real, imag}; }
+};
+
+/// Runs a split kernel over interleaved complex numbers block by block
+/// @param f Called with the split input block, the split output block and the block size
+template <typename T, typename F>
+void blocked(const std::span<const BasicComplex<T>> z, const std::span<BasicComplex<T>> out, F f) {
+  checkSize(z.size(), out.size());
+  Block<T> block;
+  for (std::size_t i = 0; i < z.size(); i += BLOCK_SIZE) {
+    const std::size_t n = std::min(BLOCK_SIZE, z.size() - i);
+    block.load(z.data() + i, n);
+    f(std::as_const(block).split(), block.split(), i, n);
+    block.store(out.data() + i, n);
+  }
+}
+
+template <typename T>
+void unary(const typename Kernels::TranscendentalKernels<T>::Unary kernel, const std::span<const BasicComplex<T>> z,
+           const std::span<BasicComplex<T>> out) {
+  blocked<T>(z, out,
+             [kernel](const Kernels::Split<const T> in, const Kernels::Split<T> result, std::size_t /*offset*/,
+                      const std::size_t n) { kernel(in, result, n); });
+}
+
+/// Extended precision of the first block, the anchors and the recurrence of the power sequences
+using Extended = BasicComplex<long double>;
+
+/// Generates anchor(j) ratio^k for the elements j * BLOCK_SIZE + k of a power sequence. The first block and the
+/// anchors are evaluated in extended precision and rounded once, so that every element of T is off by a few ulp plus
+/// the error of the extended power, about k units in the last place of long double.
+/// @param size Length of the sequence
+/// @param ratio Ratio of consecutive elements
+/// @param step ratio^BLOCK_SIZE, the ratio of consecutive anchors
+/// @param anchor Exact value of the anchor of a block, called every RENORMALIZATION_INTERVAL blocks
+/// @param emit Called with the powers of the ratio, the anchor, the offset and the length of every block
+template <typename T, typename Anchor, typename Emit>
+void sequence(const std::size_t size, const Extended& ratio, const Extended& step, Anchor anchor, Emit emit) {
+  Block<T> powers;
+  Extended power(1, 0);
+  for (std::size_t k = 0; k < std::min(BLOCK_SIZE, size); ++k, power *= ratio) {
+    powers.real[k] = static_cast<T>(power.real());
+    powers.imag[k] = static_cast<T>(power.imag());
+  }
+  Extended a;
+  for (std::size_t j = 0, i = 0; i < size; ++j, i += BLOCK_SIZE) {
+    a = j % RENORMALIZATION_INTERVAL == 0 ? anchor(j) : a * step;
+    const BasicComplex<T> rounded(static_cast<T>(a.real()), static_cast<T>(a.imag()));
+    emit(std::as_const(powers).split(), rounded, i, std::min(BLOCK_SIZE, size - i));
+  }
+}
+
+/// Writes a power sequence to split output
+template <typename T, typename Anchor>
+void emitSequence(const Extended& ratio, const Extended& step, Anchor anchor, const SplitSpan<T> out) {
+  const auto multiply = Kernels::table<T>().elementwise.arrayComplex[Kernels::Multiply];
+  sequence<T>(out.size(), ratio, step, anchor,
+              [multiply, &out](const Kernels::Split<const T> powers, const BasicComplex<T>& a, const std::size_t i,
+                               const std::size_t n) {
+                multiply(powers, a.real(), a.imag(), {out.realData() + i, out.imagData() + i}, n);
+              });
+}
+
+/// Writes a power sequence to interleaved output
+template <typename T, typename Anchor>
+void emitSequence(const Extended& ratio, const Extended& step, Anchor anchor, const std::span<BasicComplex<T>> out) {
+  const auto multiply = Kernels::table<T>().elementwise.arrayComplex[Kernels::Multiply];
+  Block<T> block;
+  sequence<T>(out.size(), ratio, step, anchor,
+              [multiply, &out, &block](const Kernels::Split<const T> powers, const BasicComplex<T>& a,
+                                       const std::size_t i, const std::size_t n) {
+                multiply(powers, a.real(), a.imag(), block.split(), n);
+                block.store(out.data() + i, n);
+              });
+}
+
+/// Writes start ratio^k to split or interleaved output
+template <typename T, typename Out>
+void geometricSequence(const BasicComplex<T>& start, const BasicComplex<T>& ratio, const Out out) {
+  const Extended s(start.real(), start.imag());
+  const Extended r(ratio.real(), ratio.imag());
+  emitSequence<T>(r, pow(r, BLOCK_SIZE), [s, r](const std::size_t j) { return s * pow(r, uint64_t(j) * BLOCK_SIZE); },
+                  out);
+}
+
+/// Writes exp(i (phase + k frequency)) to split or interleaved output. The anchors are evaluated from the phase, which
+/// also renormalizes them to unit magnitude.
+template <typename T, typename Out>
+void phasorSequence(const T phase, const T frequency, const Out out) {
+  const auto phasor = [](const long double angle) { return Extended(std::cos(angle), std::sin(angle)); };
+  const long double f = frequency;
+  emitSequence<T>(phasor(f), phasor(f * BLOCK_SIZE),
+                  [phase, f, phasor](const std::size_t j) { return phasor(phase + f * (uint64_t(j) * BLOCK_SIZE)); },
+                  out);
+}
+
+}  // namespace
+
+/// Computes the exponential map of all elements
+/// @param z Complex numbers
+/// @param out Exponentials
+template <scalar T>
+void exp(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().exp, z, out);
+}
+
+/// Computes the logarithmic map of all elements
+/// @param z Complex numbers
+/// @param out Logarithms
+template <scalar T>
+void log(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().log, z, out);
+}
+
+/// Computes the sine of all elements
+/// @param z Complex numbers
+/// @param out Sines
+template <scalar T>
+void sin(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().sin, z, out);
+}
+
+/// Computes the cosine of all elements
+/// @param z Complex numbers
+/// @param out Cosines
+template <scalar T>
+void cos(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().cos, z, out);
+}
+
+/// Computes the tangent of all elements
+/// @param z Complex numbers
+/// @param out Tangents
+template <scalar T>
+void tan(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().tan, z, out);
+}
+
+/// Computes the arc-sine of all elements
+/// @param z Complex numbers
+/// @param out Arc-sines
+template <scalar T>
+void asin(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().asin, z, out);
+}
+
+/// Computes the arc-cosine of all elements
+/// @param z Complex numbers
+/// @param out Arc-cosines
+template <scalar T>
+void acos(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().acos, z, out);
+}
+
+/// Computes the arc-tangent of all elements
+/// @param z Complex numbers
+/// @param out Arc-tangents
+template <scalar T>
+void atan(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().atan, z, out);
+}
+
+/// Computes the square root of all elements
+/// @param z Complex numbers
+/// @param out Square roots
+template <scalar T>
+void sqrt(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) {
+  unary<T>(kernels<T>().sqrt, z, out);
+}
+
+/// Raises all elements to a real power
+/// @param z Bases
+/// @param w Exponent
+/// @param out Powers
+template <scalar T>
+void pow(const std::type_identity_t<SplitSpan<const T>> z, const std::type_identity_t<T> w, const SplitSpan<T> out) {
+  checkSize(z.size(), out.size());
+  kernels<T>().powReal(split(z), w, split(out), out.size());
+}
+
+/// Raises all elements to a complex power
+/// @param z Bases
+/// @param w Exponent
+/// @param out Powers
+template <scalar T>
+void pow(const std::type_identity_t<SplitSpan<const T>> z, const BasicComplex<T>& w, const SplitSpan<T> out) {
+  checkSize(z.size(), out.size());
+  kernels<T>().powComplex(split(z), w.real(), w.imag(), split(out), out.size());
+}
+
+/// Raises the elements of z to the powers in w elementwise
+/// @param z Bases
+/// @param w Exponents
+/// @param out Powers
+template <scalar T>
+void pow(const std::type_identity_t<SplitSpan<const T>> z, const std::type_identity_t<SplitSpan<const T>> w,
+         const SplitSpan<T> out) {
+  checkSize(z.size(), out.size());
+  checkSize(w.size(), out.size());
+  kernels<T>().powArray(split(z), split(w), split(out), out.size());
+}
+
+template <scalar T>
+void exp(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().exp, z, out);
+}
+
+template <scalar T>
+void log(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().log, z, out);
+}
+
+template <scalar T>
+void sin(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().sin, z, out);
+}
+
+template <scalar T>
+void cos(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().cos, z, out);
+}
+
+template <scalar T>
+void tan(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().tan, z, out);
+}
+
+template <scalar T>
+void asin(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().asin, z, out);
+}
+
+template <scalar T>
+void acos(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().acos, z, out);
+}
+
+template <scalar T>
+void atan(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().atan, z, out);
+}
+
+template <scalar T>
+void sqrt(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::span<BasicComplex<T>> out) {
+  unary<T>(kernels<T>().sqrt, z, out);
+}
+
+template <scalar T>
+void pow(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const std::type_identity_t<T> w,
+         const std::span<BasicComplex<T>> out) {
+  const auto kernel = kernels<T>().powReal;
+  blocked<T>(z, out,
+             [kernel, w](const Kernels::Split<const T> in, const Kernels::Split<T> result, std::size_t /*offset*/,
+                         const std::size_t n) { kernel(in, w, result, n); });
+}
+
+template <scalar T>
+void pow(const std::type_identity_t<std::span<const BasicComplex<T>>> z, const BasicComplex<T>& w,
+         const std::span<BasicComplex<T>> out) {
+  const auto kernel = kernels<T>().powComplex;
+  blocked<T>(z, out,
+             [kernel, &w](const Kernels::Split<const T> in, const Kernels::Split<T> result, std::size_t /*offset*/,
+                          const std::size_t n) { kernel(in, w.real(), w.imag(), result, n); });
+}
+
+template <scalar T>
+void pow(const std::type_identity_t<std::span<const BasicComplex<T>>> z,
+         const std::type_identity_t<std::span<const BasicComplex<T>>> w, const std::span<BasicComplex<T>> out) {
+  checkSize(w.size(), out.size());
+  const auto kernel = kernels<T>().powArray;
+  Block<T> exponents;
+  blocked<T>(z, out,
+             [kernel, w, &exponents](const Kernels::Split<const T> in, const Kernels::Split<T> result,
+                                     const std::size_t offset, const std::size_t n) {
+               exponents.load(w.data() + offset, n);
+               kernel(in, std::as_const(exponents).split(), result, n);
+             });
+}
+
+/// Computes the powers z^0, z^1, ... of a complex number
+/// @param z Base
+/// @param out Powers, out[k] = z^k
+template <scalar T>
+void powers(const BasicComplex<T>& z, const SplitSpan<T> out) {
+  geometricSequence<T>(BasicComplex<T>(1, 0), z, out);
+}
+
+/// Computes a geometric sequence, the powers of the ratio scaled by the start value
+/// @param start First element
+/// @param ratio Ratio of consecutive elements
+/// @param out Sequence, out[k] = start ratio^k
+template <scalar T>
+void geometric(const BasicComplex<T>& start, const BasicComplex<T>& ratio, const SplitSpan<T> out) {
+  geometricSequence<T>(start, ratio, out);
+}
+
+/// Computes the unit phasors of a linear phase
+/// @param phase Phase of the first element in radians
+/// @param frequency Phase increment per element in radians
+/// @param out Phasors, out[k] = exp(i (phase + k frequency))
+template <scalar T>
+void phasors(const std::type_identity_t<T> phase, const std::type_identity_t<T> frequency, const SplitSpan<T> out) {
+  phasorSequence<T>(phase, frequency, out);
+}
+
+/// Computes the powers z^0, z^1, ... of a complex number
+/// @param z Base
+/// @param out Powers, out[k] = z^k
+template <scalar T>
+void powers(const BasicComplex<T>& z, const std::span<BasicComplex<T>> out) {
+  geometricSequence<T>(BasicComplex<T>(1, 0), z, out);
+}
+
+/// Computes a geometric sequence, the powers of the ratio scaled by the start value
+/// @param start First element
+/// @param ratio Ratio of consecutive elements
+/// @param out Sequence, out[k] = start ratio^k
+template <scalar T>
+void geometric(const BasicComplex<T>& start, const BasicComplex<T>& ratio, const std::span<BasicComplex<T>> out) {
+  geometricSequence<T>(start, ratio, out);
+}
+
+/// Computes the unit phasors of a linear phase
+/// @param phase Phase of the first element in radians
+/// @param frequency Phase increment per element in radians
+/// @param out Phasors, out[k] = exp(i (phase + k frequency))
+template <scalar T>
+void phasors(const std::type_identity_t<T> phase, const std::type_identity_t<T> frequency,
+             const std::span<BasicComplex<T>> out) {
+  phasorSequence<T>(phase, frequency, out);
+}
+
+#define MATH_INSTANTIATE_COMPLEX_MATH(T)                                                                        \
+  template void exp<T>(SplitSpan<const T>, SplitSpan<T>);                                                       \
+  template void log<T>(SplitSpan<const T>, SplitSpan<T>);                                                       \
+  template void sin<T>(SplitSpan<const T>, SplitSpan<T>);                                                       \
+  template void cos<T>(SplitSpan<const T>, SplitSpan<T>);                                                       \
+  template void tan<T>(SplitSpan<const T>, SplitSpan<T>);                                                       \
+  template void asin<T>(SplitSpan<const T>, SplitSpan<T>);                                                      \
+  template void acos<T>(SplitSpan<const T>, SplitSpan<T>);                                                      \
+  template void atan<T>(SplitSpan<const T>, SplitSpan<T>);                                                      \
+  template void sqrt<T>(SplitSpan<const T>, SplitSpan<T>);                                                      \
+  template void pow<T>(SplitSpan<const T>, T, SplitSpan<T>);                                                    \
+  template void pow<T>(SplitSpan<const T>, const BasicComplex<T>&, SplitSpan<T>);                               \
+  template void pow<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>);                                   \
+  template void exp<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                           \
+  template void log<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                           \
+  template void sin<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                           \
+  template void cos<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                           \
+  template void tan<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                           \
+  template void asin<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                          \
+  template void acos<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                          \
+  template void atan<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                          \
+  template void sqrt<T>(std::span<const BasicComplex<T>>, std::span<BasicComplex<T>>);                          \
+  template void pow<T>(std::span<const BasicComplex<T>>, T, std::span<BasicComplex<T>>);                        \
+  template void pow<T>(std::span<const BasicComplex<T>>, const BasicComplex<T>&, std::span<BasicComplex<T>>);   \
+  template void pow<T>(std::span<const BasicComplex<T>>, std::span<const BasicComplex<T>>,                      \
+                       std::span<BasicComplex<T>>);                                                             \
+  template void powers<T>(const BasicComplex<T>&, SplitSpan<T>);                                                \
+  template void geometric<T>(const BasicComplex<T>&, const BasicComplex<T>&, SplitSpan<T>);                     \
+  template void phasors<T>(T, T, SplitSpan<T>);                                                                 \
+  template void powers<T>(const BasicComplex<T>&, std::span<BasicComplex<T>>);                                  \
+  template void geometric<T>(const BasicComplex<T>&, const BasicComplex<T>&, std::span<BasicComplex<T>>);       \
+  template void phasors<T>(T, T, std::span<BasicComplex<T>>);
+
+MATH_INSTANTIATE_COMPLEX_MATH(float)
+MATH_INSTANTIATE_COMPLEX_MATH(double)
+MATH_INSTANTIATE_COMPLEX_MATH(long double)
+
+#undef MATH_INSTANTIATE_COMPLEX_MATH
+
+}  // namespace Math
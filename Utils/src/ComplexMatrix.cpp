@@ -0,0 +1,158 @@
+#include "ComplexMatrix.h"
+
+#include <algorithm>
+
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+/// Depth of the packed panels, a kc x nr panel of b stays in the L1 cache while the micro-kernel runs over a block
+constexpr std::size_t GEMM_KC = 256;
+/// Rows of the packed block of a, which stays in the L2 cache, a multiple of the micro-kernel rows of every target
+constexpr std::size_t GEMM_MC = 96;
+/// Columns of the packed panel of b, which stays in the L3 cache, a multiple of the micro-kernel columns
+constexpr std::size_t GEMM_NC = 1536;
+
+std::size_t roundUp(const std::size_t n, const std::size_t multiple) {
+  return (n + multiple - 1) / multiple * multiple;
+}
+
+/// Scales c by beta, zero overwrites c so that NaN and infinity in c do not propagate
+template <scalar T>
+void scale(const BasicComplex<T>& beta, const ComplexMatrixView<T> c, ThreadPool& pool) {
+  if (beta.real() == 1 && beta.imag() == 0) return;
+  const bool zero = beta.real() == 0 && beta.imag() == 0;
+  pool.parallelFor(0, c.rows(), std::max<std::size_t>(1, 4096 / std::max<std::size_t>(1, c.cols())),
+                   [&](const std::size_t i) {
+                     for (std::size_t j = 0; j < c.cols(); ++j) {
+                       c(i, j) = zero ? BasicComplex<T>() : beta * c(i, j);
+                     }
+                   });
+}
+
+/// Packs an m x k block of a, multiplied by alpha, into slivers of mr rows: per step p the mr real parts and then the
+/// mr imaginary parts, in the accumulator type A. Rows beyond m are zero.
+template <scalar T, scalar A>
+void packA(const ComplexMatrixView<const T> a, const BasicComplex<A>& alpha, const std::size_t mr, A* out) {
+  for (std::size_t i0 = 0; i0 < a.rows(); i0 += mr) {
+    const std::size_t rows = std::min<std::size_t>(mr, a.rows() - i0);
+    for (std::size_t p = 0; p < a.cols(); ++p) {
+      for (std::size_t r = 0; r < rows; ++r) {
+        const BasicComplex<T>& x = a(i0 + r, p);
+        const BasicComplex<A> z = alpha * BasicComplex<A>(x.real(), x.imag());
+        out[r] = z.real();
+        out[mr + r] = z.imag();
+      }
+      std::fill(out + rows, out + mr, A(0));
+      std::fill(out + mr + rows, out + 2 * mr, A(0));
+      out += 2 * mr;
+    }
+  }
+}
+
+/// Packs the sliver of nr columns starting at column j0 of a k x n panel of b: per step p the nr real parts and then
+/// the nr imaginary parts, in the accumulator type A. Columns beyond n are zero.
+template <scalar T, scalar A>
+void packB(const ComplexMatrixView<const T> b, const std::size_t j0, const std::size_t nr, A* out) {
+  const std::size_t cols = std::min<std::size_t>(nr, b.cols() - j0);
+  for (std::size_t p = 0; p < b.rows(); ++p) {
+    for (std::size_t c = 0; c < cols; ++c) {
+      const BasicComplex<T>& z = b(p, j0 + c);
+      out[c] = z.real();
+      out[nr + c] = z.imag();
+    }
+    std::fill(out + cols, out + nr, A(0));
+    std::fill(out + nr + cols, out + 2 * nr, A(0));
+    out += 2 * nr;
+  }
+}
+
+}  // namespace
+
+/// General matrix product c = alpha a b + beta c. The product is computed in cache blocks: panels of b (kc x nc) and
+/// blocks of a (mc x kc) are packed into contiguous split real and imaginary buffers, and a SIMD micro-kernel
+/// accumulates register tiles of c from them. Blocks of rows of c are distributed over the threads of the pool.
+/// When beta is zero, c is overwritten without being read. In mixed precision, float operands are packed as double and
+/// the products of a panel of depth kc are accumulated in double before they are added to c.
+/// @param alpha Factor of the product
+/// @param a Left factor, m x k
+/// @param b Right factor, k x n
+/// @param beta Factor of c
+/// @param c Result, m x n, must not overlap a or b
+/// @param pool Threads that compute blocks of the product
+template <scalar T>
+void gemm(const BasicComplex<T>& alpha, const std::type_identity_t<ComplexMatrixView<const T>> a,
+          const std::type_identity_t<ComplexMatrixView<const T>> b, const BasicComplex<T>& beta,
+          const std::type_identity_t<ComplexMatrixView<T>> c, ThreadPool& pool) {
+  if (a.rows() != c.rows() || b.cols() != c.cols() || a.cols() != b.rows()) {
+    throw std::invalid_argument("gemm: matrix dimensions do not match");
+  }
+  const std::size_t m = c.rows();
+  const std::size_t n = c.cols();
+  const std::size_t k = a.cols();
+  scale(beta, c, pool);
+  if (m == 0 || n == 0 || k == 0 || (alpha.real() == 0 && alpha.imag() == 0)) return;
+
+  using A = accumulator_t<T>;
+  const Kernels::GemmKernels<A>& kernels = Kernels::table<A>().gemm;
+  const std::size_t mr = kernels.mr;
+  const std::size_t nr = kernels.nr;
+  // Small products use smaller blocks of a, so that every thread gets a block
+  std::size_t mc = GEMM_MC;
+  const std::size_t threads = pool.threadCount();
+  if ((m + mc - 1) / mc < threads) mc = std::max(mr, roundUp((m + threads - 1) / threads, mr));
+  const std::size_t blocks = (m + mc - 1) / mc;
+
+  // Owned by the calling thread and reused, so that repeated products do not allocate. The workers read it through
+  // the pointer, a thread_local named in the tasks would refer to their own copy.
+  thread_local AlignedVector<A> packedBuffer;
+  packedBuffer.resize(std::max(packedBuffer.size(), 2 * GEMM_KC * roundUp(std::min(GEMM_NC, n), nr)));
+  A* const packedB = packedBuffer.data();
+  for (std::size_t jc = 0; jc < n; jc += GEMM_NC) {
+    const std::size_t nc = std::min(GEMM_NC, n - jc);
+    const std::size_t slivers = (nc + nr - 1) / nr;
+    for (std::size_t pc = 0; pc < k; pc += GEMM_KC) {
+      const std::size_t kc = std::min(GEMM_KC, k - pc);
+      const ComplexMatrixView<const T> panel = b.submatrix(pc, jc, kc, nc);
+      pool.parallelFor(0, slivers, std::max<std::size_t>(1, 4096 / (kc * nr)), [&](const std::size_t s) {
+        packB(panel, s * nr, nr, packedB + s * 2 * kc * nr);
+      });
+
+      pool.parallelFor(0, blocks, 1, [&](const std::size_t block) {
+        thread_local AlignedVector<A> packedA;
+        thread_local AlignedVector<A> tile;
+        packedA.resize(std::max(packedA.size(), 2 * roundUp(mc, mr) * kc));
+        tile.resize(std::max(tile.size(), 2 * mr * nr));
+
+        const std::size_t ic = block * mc;
+        const std::size_t rows = std::min(mc, m - ic);
+        packA(a.submatrix(ic, pc, rows, kc), BasicComplex<A>(alpha.real(), alpha.imag()), mr, packedA.data());
+        for (std::size_t jr = 0; jr < nc; jr += nr) {
+          const std::size_t tileCols = std::min(nr, nc - jr);
+          for (std::size_t ir = 0; ir < rows; ir += mr) {
+            const std::size_t tileRows = std::min(mr, rows - ir);
+            kernels.microKernel(kc, packedA.data() + ir * 2 * kc, packedB + jr * 2 * kc, tile.data());
+            for (std::size_t j = 0; j < tileCols; ++j) {
+              for (std::size_t i = 0; i < tileRows; ++i) {
+                c(ic + ir + i, jc + jr + j) +=
+                    BasicComplex<T>(static_cast<T>(tile[j * mr + i]), static_cast<T>(tile[(nr + j) * mr + i]));
+              }
+            }
+          }
+        }
+      });
+    }
+  }
+}
+
+#define MATH_INSTANTIATE_COMPLEX_MATRIX(T)                                                              \
+  template void gemm<T>(const BasicComplex<T>&, ComplexMatrixView<const T>, ComplexMatrixView<const T>, \
+                        const BasicComplex<T>&, ComplexMatrixView<T>, ThreadPool&);
+
+MATH_INSTANTIATE_COMPLEX_MATRIX(float)
+MATH_INSTANTIATE_COMPLEX_MATRIX(double)
+MATH_INSTANTIATE_COMPLEX_MATRIX(long double)
+
+}  // namespace Math
@@ -0,0 +1,222 @@
+#include "ComplexReduction.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+template <typename T>
+Kernels::Split<T> split(const SplitSpan<T> z) {
+  return {z.realData(), z.imagData()};
+}
+
+template <typename T>
+const Kernels::ReductionKernels<T>& kernels() {
+  return Kernels::table<T>().reduction;
+}
+
+void checkSize(const std::size_t size, const std::size_t expected) {
+  if (size != expected) throw std::invalid_argument("ComplexReduction: operands differ in size");
+}
+
+/// @return a + b, and the exact rounding error of the sum in error
+template <typename A>
+A twoSum(const A a, const A b, A& error) {
+  const A s = a + b;
+  const A v = s - a;
+  error = (a - (s - v)) + (b - v);
+  return s;
+}
+
+/// Compensated sums of CHAINS quantities, the running sums and their accumulated rounding errors
+template <typename A, std::size_t CHAINS>
+struct Partial {
+  A sum[CHAINS] = {};
+  A error[CHAINS] = {};
+
+  [[nodiscard]] friend Partial combine(const Partial& lhs, const Partial& rhs) {
+    Partial result;
+    for (std::size_t c = 0; c < CHAINS; ++c) {
+      A error;
+      result.sum[c] = twoSum(lhs.sum[c], rhs.sum[c], error);
+      result.error[c] = lhs.error[c] + rhs.error[c] + error;
+    }
+    return result;
+  }
+
+  /// @return Sum of chain c
+  [[nodiscard]] A value(const std::size_t c) const { return sum[c] + error[c]; }
+
+  /// @return Sum of chain a plus sign times the sum of chain b, compensated so that cancellation keeps the errors
+  [[nodiscard]] A value(const std::size_t a, const std::size_t b, const A sign) const {
+    A error;
+    const A s = twoSum(sum[a], sign * sum[b], error);
+    return s + (error + (this->error[a] + sign * this->error[b]));
+  }
+};
+
+/// Reduces z in chunks of REDUCTION_GRAIN elements with kernel(offset, count, partial), which writes the sum and the
+/// error of every chain of a chunk
+template <typename T, std::size_t CHAINS, typename Kernel>
+Partial<accumulator_t<T>, CHAINS> reduce(const std::size_t size, ThreadPool& pool, Kernel&& kernel) {
+  using A = accumulator_t<T>;
+  const auto chunk = [&](const std::size_t first, const std::size_t last) {
+    T values[2 * CHAINS];
+    kernel(first, last - first, values);
+    Partial<A, CHAINS> partial;
+    for (std::size_t c = 0; c < CHAINS; ++c) {
+      partial.sum[c] = A(values[2 * c]);
+      partial.error[c] = A(values[2 * c + 1]);
+    }
+    return partial;
+  };
+  if (size <= REDUCTION_GRAIN) return chunk(0, size);
+  return pool.parallelReduce(
+      0, size, REDUCTION_GRAIN, Partial<A, CHAINS>(), chunk,
+      [](const Partial<A, CHAINS>& lhs, const Partial<A, CHAINS>& rhs) { return combine(lhs, rhs); },
+      ReductionOrder::Deterministic);
+}
+
+/// Chains of the dot kernel
+enum DotChain : std::size_t { RealReal, ImagImag, RealImag, ImagReal };
+
+/// Element of largest squared magnitude
+template <typename T>
+struct Largest {
+  T value;
+  std::size_t index;
+};
+
+}  // namespace
+
+/// @param z Complex numbers
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Sum of the elements
+template <scalar T>
+BasicComplex<T> sum(const std::type_identity_t<SplitSpan<const T>> z, ThreadPool& pool) {
+  const auto partial = reduce<T, 2>(z.size(), pool, [&](const std::size_t offset, const std::size_t n, T* values) {
+    kernels<T>().sum(split(z.subspan(offset, n)), n, values);
+  });
+  return {static_cast<T>(partial.value(0)), static_cast<T>(partial.value(1))};
+}
+
+/// Unconjugated dot product, the sum of x[i] * y[i]
+/// @param x Complex numbers
+/// @param y Complex numbers of the same size
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Dot product
+template <scalar T>
+BasicComplex<T> dotu(const std::type_identity_t<SplitSpan<const T>> x, const std::type_identity_t<SplitSpan<const T>> y,
+                     ThreadPool& pool) {
+  checkSize(y.size(), x.size());
+  const auto partial = reduce<T, 4>(x.size(), pool, [&](const std::size_t offset, const std::size_t n, T* values) {
+    kernels<T>().dot(split(x.subspan(offset, n)), split(y.subspan(offset, n)), n, values);
+  });
+  using A = accumulator_t<T>;
+  return {static_cast<T>(partial.value(RealReal, ImagImag, A(-1))),
+          static_cast<T>(partial.value(RealImag, ImagReal, A(1)))};
+}
+
+/// Conjugated dot product, the sum of conj(x[i]) * y[i]
+/// @param x Complex numbers
+/// @param y Complex numbers of the same size
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Dot product
+template <scalar T>
+BasicComplex<T> dotc(const std::type_identity_t<SplitSpan<const T>> x, const std::type_identity_t<SplitSpan<const T>> y,
+                     ThreadPool& pool) {
+  checkSize(y.size(), x.size());
+  const auto partial = reduce<T, 4>(x.size(), pool, [&](const std::size_t offset, const std::size_t n, T* values) {
+    kernels<T>().dot(split(x.subspan(offset, n)), split(y.subspan(offset, n)), n, values);
+  });
+  using A = accumulator_t<T>;
+  return {static_cast<T>(partial.value(RealReal, ImagImag, A(1))),
+          static_cast<T>(partial.value(RealImag, ImagReal, A(-1)))};
+}
+
+/// @param z Complex numbers
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Sum of abs2(z[i]), the squared Euclidean norm
+template <scalar T>
+T squaredNorm(const std::type_identity_t<SplitSpan<const T>> z, ThreadPool& pool) {
+  const auto partial = reduce<T, 2>(z.size(), pool, [&](const std::size_t offset, const std::size_t n, T* values) {
+    kernels<T>().squaredNorm(split(z.subspan(offset, n)), n, values);
+  });
+  return static_cast<T>(partial.value(0, 1, accumulator_t<T>(1)));
+}
+
+/// @param z Complex numbers
+/// @param pool Threads that reduce the chunks of large arrays
+/// @return Index of the first element of largest magnitude, NaN is skipped; 0 if z is empty or all NaN
+template <scalar T>
+size_t maxAbsIndex(const std::type_identity_t<SplitSpan<const T>> z, ThreadPool& pool) {
+  const auto chunk = [&](const std::size_t first, const std::size_t last) {
+    Largest<T> largest;
+    largest.index = first + kernels<T>().maxAbs(split(z.subspan(first, last - first)), last - first, &largest.value);
+    return largest;
+  };
+  const Largest<T> largest =
+      z.size() <= REDUCTION_GRAIN
+          ? chunk(0, z.size())
+          : pool.parallelReduce(
+                0, z.size(), REDUCTION_GRAIN, Largest<T>{T(-1), std::numeric_limits<std::size_t>::max()}, chunk,
+                [](const Largest<T>& lhs, const Largest<T>& rhs) {
+                  return rhs.value > lhs.value || (rhs.value == lhs.value && rhs.index < lhs.index) ? rhs : lhs;
+                },
+                ReductionOrder::Deterministic);
+  if (largest.value != std::numeric_limits<T>::infinity()) return static_cast<size_t>(largest.index);
+  // The squared magnitude overflows for parts beyond the square root of the largest number, compare the magnitudes
+  size_t index = 0;
+  T value = T(-1);
+  for (size_t i = 0; i < z.size(); ++i) {
+    const T re = z.realData()[i];
+    const T im = z.imagData()[i];
+    if (std::isnan(re) || std::isnan(im)) continue;
+    const T magnitude = std::hypot(re, im);
+    if (magnitude > value) {
+      value = magnitude;
+      index = i;
+    }
+  }
+  return index;
+}
+
+/// Dot products of the taps with sliding windows of x, out[i * outStride] = sum of taps[k] * x[i * inStride + k] for
+/// the elements of out at multiples of outStride. With reversed taps this is the direct form of an FIR filter; the
+/// windows are vectorized with plain multiply-adds, without compensation.
+/// @param x Complex numbers, at least (count - 1) * inStride + taps.size() of them for count outputs
+/// @param taps Factors of a window
+/// @param out Results
+/// @param inStride Distance between the windows of consecutive outputs, at least 1
+/// @param outStride Distance between consecutive outputs, at least 1
+template <scalar T>
+void slidingDot(const std::type_identity_t<SplitSpan<const T>> x, const std::type_identity_t<SplitSpan<const T>> taps,
+                const SplitSpan<T> out, const std::size_t inStride, const std::size_t outStride) {
+  if (inStride == 0 || outStride == 0) throw std::invalid_argument("slidingDot: strides must be positive");
+  const std::size_t count = (out.size() + outStride - 1) / outStride;
+  if (count > 0 && (x.size() < taps.size() || (x.size() - taps.size()) / inStride < count - 1)) {
+    throw std::invalid_argument("slidingDot: windows exceed the input");
+  }
+  kernels<T>().slidingDot(split(x), inStride, split(taps), taps.size(), split(out), outStride, count);
+}
+
+#define MATH_INSTANTIATE_COMPLEX_REDUCTION(T)                                            \
+  template BasicComplex<T> sum<T>(SplitSpan<const T>, ThreadPool&);                      \
+  template BasicComplex<T> dotu<T>(SplitSpan<const T>, SplitSpan<const T>, ThreadPool&); \
+  template BasicComplex<T> dotc<T>(SplitSpan<const T>, SplitSpan<const T>, ThreadPool&); \
+  template T squaredNorm<T>(SplitSpan<const T>, ThreadPool&);                            \
+  template size_t maxAbsIndex<T>(SplitSpan<const T>, ThreadPool&);                       \
+  template void slidingDot<T>(SplitSpan<const T>, SplitSpan<const T>, SplitSpan<T>, std::size_t, std::size_t);
+
+MATH_INSTANTIATE_COMPLEX_REDUCTION(float)
+MATH_INSTANTIATE_COMPLEX_REDUCTION(double)
+MATH_INSTANTIATE_COMPLEX_REDUCTION(long double)
+
+#undef MATH_INSTANTIATE_COMPLEX_REDUCTION
+
+}  // namespace Math
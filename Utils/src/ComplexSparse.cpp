@@ -0,0 +1,844 @@
+#include "ComplexSparse.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "ComplexArray.h"
+#include "ComplexReduction.h"
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+static_assert(std::same_as<size_t, std::uint32_t>, "the sparse kernels take 32-bit indices");
+
+template <typename T>
+Kernels::Split<T> split(const SplitSpan<T> z) {
+  return {z.realData(), z.imagData()};
+}
+
+template <typename T>
+const Kernels::SparseKernels<T>& kernels() {
+  return Kernels::table<T>().sparse;
+}
+
+template <typename T>
+bool isZero(const BasicComplex<T>& z) {
+  return z.real() == 0 && z.imag() == 0;
+}
+
+void checkDimensions(const std::size_t rows, const std::size_t cols, const char* message) {
+  if (rows > MAX_ELEMENT_COUNT || cols > MAX_ELEMENT_COUNT) throw std::length_error(message);
+}
+
+void checkNonZeros(const std::size_t count, const char* message) {
+  if (count > std::numeric_limits<size_t>::max()) throw std::length_error(message);
+}
+
+/// Compressed rows or columns: the elements of major index i are [offsets[i], offsets[i + 1]), with their minor
+/// indices and values
+template <typename T>
+struct Compressed {
+  std::vector<size_t> offsets;
+  std::vector<size_t> indices;
+  AlignedVector<T> real;
+  AlignedVector<T> imag;
+};
+
+/// Sorts entries by their major index, row or column, and within a major index by the other one, and adds the values
+/// of duplicates
+template <typename T>
+Compressed<T> compress(const size_t majorCount, const size_t minorCount, const std::span<const SparseEntry<T>> entries,
+                       const bool rowMajor, const char* message) {
+  checkNonZeros(entries.size(), message);
+  const auto major = [&](const SparseEntry<T>& e) { return rowMajor ? e.row : e.col; };
+  const auto minor = [&](const SparseEntry<T>& e) { return rowMajor ? e.col : e.row; };
+  // Counting sort by the major index
+  std::vector<size_t> starts(std::size_t(majorCount) + 1, 0);
+  for (const SparseEntry<T>& e : entries) {
+    if (major(e) >= majorCount || minor(e) >= minorCount) throw std::invalid_argument(message);
+    ++starts[major(e) + 1];
+  }
+  for (size_t i = 0; i < majorCount; ++i) starts[i + 1] += starts[i];
+  std::vector<std::pair<size_t, BasicComplex<T>>> sorted(entries.size());
+  std::vector<size_t> next(starts.begin(), starts.end() - 1);
+  for (const SparseEntry<T>& e : entries) sorted[next[major(e)]++] = {minor(e), e.value};
+
+  Compressed<T> result;
+  result.offsets.resize(std::size_t(majorCount) + 1, 0);
+  result.indices.reserve(sorted.size());
+  result.real.reserve(sorted.size());
+  result.imag.reserve(sorted.size());
+  for (size_t i = 0; i < majorCount; ++i) {
+    const auto first = sorted.begin() + starts[i];
+    const auto last = sorted.begin() + starts[i + 1];
+    std::sort(first, last, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (auto it = first; it != last; ++it) {
+      if (it != first && it->first == result.indices.back()) {
+        result.real.back() += it->second.real();
+        result.imag.back() += it->second.imag();
+        continue;
+      }
+      result.indices.push_back(it->first);
+      result.real.push_back(it->second.real());
+      result.imag.push_back(it->second.imag());
+    }
+    result.offsets[i + 1] = static_cast<size_t>(result.indices.size());
+  }
+  return result;
+}
+
+/// Compresses the nonzero elements of a dense matrix
+template <typename T>
+Compressed<T> compress(const ComplexMatrixView<const T> a, const bool rowMajor) {
+  const size_t majorCount = rowMajor ? a.rows() : a.cols();
+  const size_t minorCount = rowMajor ? a.cols() : a.rows();
+  Compressed<T> result;
+  result.offsets.resize(std::size_t(majorCount) + 1, 0);
+  for (size_t i = 0; i < majorCount; ++i) {
+    for (size_t j = 0; j < minorCount; ++j) {
+      const BasicComplex<T> z = rowMajor ? a(i, j) : a(j, i);
+      if (isZero(z)) continue;
+      result.indices.push_back(j);
+      result.real.push_back(z.real());
+      result.imag.push_back(z.imag());
+    }
+    result.offsets[i + 1] = static_cast<size_t>(result.indices.size());
+  }
+  return result;
+}
+
+/// Compresses the same elements along the other dimension, CSR to CSC or back, by a counting sort. The major indices
+/// are visited in order, so the new minor indices are increasing.
+template <typename T>
+Compressed<T> transpose(const std::span<const size_t> offsets, const std::span<const size_t> indices,
+                        const SplitSpan<const T> values, const size_t minorCount) {
+  Compressed<T> result;
+  result.offsets.resize(std::size_t(minorCount) + 1, 0);
+  for (const size_t j : indices) ++result.offsets[j + 1];
+  for (size_t j = 0; j < minorCount; ++j) result.offsets[j + 1] += result.offsets[j];
+  result.indices.resize(indices.size());
+  result.real.resize(indices.size());
+  result.imag.resize(indices.size());
+  std::vector<size_t> next(result.offsets.begin(), result.offsets.end() - 1);
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+      const size_t slot = next[indices[k]]++;
+      result.indices[slot] = static_cast<size_t>(i);
+      result.real[slot] = values.realData()[k];
+      result.imag[slot] = values.imagData()[k];
+    }
+  }
+  return result;
+}
+
+/// Checks compressed rows or columns that are passed in by the caller
+template <typename T>
+void checkCompressed(const size_t majorCount, const size_t minorCount, const std::vector<size_t>& offsets,
+                     const std::vector<size_t>& indices, const AlignedVector<T>& real, const AlignedVector<T>& imag,
+                     const char* message) {
+  checkNonZeros(indices.size(), message);
+  if (offsets.size() != std::size_t(majorCount) + 1 || offsets.front() != 0 || offsets.back() != indices.size() ||
+      real.size() != indices.size() || imag.size() != indices.size()) {
+    throw std::invalid_argument(message);
+  }
+  for (size_t i = 0; i < majorCount; ++i) {
+    if (offsets[i + 1] < offsets[i]) throw std::invalid_argument(message);
+    for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+      if (indices[k] >= minorCount || (k > offsets[i] && indices[k] <= indices[k - 1])) {
+        throw std::invalid_argument(message);
+      }
+    }
+  }
+}
+
+/// @return Cost of the rows, or block rows, before row r: their stored elements, plus block per row for the elements
+/// of y they write
+std::size_t rowCost(const std::span<const size_t> offsets, const std::size_t block, const std::size_t r) {
+  return std::size_t(offsets[r]) * block * block + r * block;
+}
+
+/// @return First row whose rowCost is at least cost, so that rows at the costs of consecutive chunks do not overlap
+std::size_t rowAtCost(const std::span<const size_t> offsets, const std::size_t block, const std::size_t cost) {
+  std::size_t lo = 0;
+  std::size_t hi = offsets.size() - 1;
+  while (lo < hi) {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if (rowCost(offsets, block, mid) < cost) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/// Calls f(first, last) for chunks of the rows, or block rows, [0, offsets.size() - 1) in parallel, each chunk of
+/// about SPARSE_GRAIN cost
+template <typename F>
+void forRowChunks(const std::span<const size_t> offsets, const std::size_t block, ThreadPool& pool, F&& f) {
+  const std::size_t count = offsets.size() - 1;
+  const std::size_t total = rowCost(offsets, block, count);
+  if (total <= SPARSE_GRAIN) {
+    f(std::size_t(0), count);
+    return;
+  }
+  pool.parallelForRange(0, total, SPARSE_GRAIN, [&](const std::size_t first, const std::size_t last) {
+    const std::size_t begin = rowAtCost(offsets, block, first);
+    const std::size_t end = last == total ? count : rowAtCost(offsets, block, last);
+    if (begin < end) f(begin, end);
+  });
+}
+
+/// Product that runs along the compressed rows and gathers the elements of x
+template <typename T, typename Kernel>
+void gatherProduct(const std::span<const size_t> offsets, const std::size_t block, const SplitSpan<T> y,
+                   ThreadPool& pool, Kernel&& kernel) {
+  forRowChunks(offsets, block, pool, [&](const std::size_t first, const std::size_t last) {
+    kernel(offsets.data() + first, first, last - first, split(y.subspan(first * block, (last - first) * block)));
+  });
+}
+
+/// Product that runs along the compressed rows and scatters into y. The rows are split into up to one part per
+/// thread, and every part but the first adds into a partial y of its own, which are summed into y at the end. The
+/// partial vectors hold at most SPARSE_PARTIAL_RATIO elements per stored element, so short rows of long vectors run
+/// in fewer parts.
+template <typename T, typename Kernel>
+void scatterProduct(const std::span<const size_t> offsets, const std::size_t block, const SplitSpan<T> y,
+                    ThreadPool& pool, Kernel&& kernel) {
+  const std::size_t count = offsets.size() - 1;
+  const std::size_t n = y.size();
+  std::fill_n(y.realData(), n, T(0));
+  std::fill_n(y.imagData(), n, T(0));
+  const std::size_t total = rowCost(offsets, block, count);
+  const std::size_t partials = n == 0 ? 0 : SPARSE_PARTIAL_RATIO * std::size_t(offsets.back()) * block * block / n;
+  const std::size_t threads = std::min(pool.threadCount(), partials + 1);
+  const std::size_t parts = std::clamp<std::size_t>(total / SPARSE_GRAIN, 1, threads);
+  if (parts == 1) {
+    kernel(offsets.data(), std::size_t(0), count, split(y));
+    return;
+  }
+  // Owned by the calling thread and reused, so that repeated products, like those of the solvers, do not allocate.
+  // The workers read it through the pointers, a thread_local named in the tasks would refer to their own copy.
+  thread_local AlignedVector<T> workspace;
+  workspace.resize(std::max(workspace.size(), 2 * (parts - 1) * n));
+  T* const partialReal = workspace.data();
+  T* const partialImag = partialReal + (parts - 1) * n;
+  const auto part = [&](const std::size_t p) {
+    return p == 0 ? split(y) : Kernels::Split<T>{partialReal + (p - 1) * n, partialImag + (p - 1) * n};
+  };
+  pool.parallelFor(0, parts, 1, [&](const std::size_t p) {
+    if (p > 0) {
+      std::fill_n(partialReal + (p - 1) * n, n, T(0));
+      std::fill_n(partialImag + (p - 1) * n, n, T(0));
+    }
+    const std::size_t first = rowAtCost(offsets, block, total * p / parts);
+    const std::size_t last = p + 1 == parts ? count : rowAtCost(offsets, block, total * (p + 1) / parts);
+    kernel(offsets.data() + first, first, last - first, part(p));
+  });
+  pool.parallelForRange(0, n, SPARSE_GRAIN, [&](const std::size_t first, const std::size_t last) {
+    for (std::size_t p = 1; p < parts; ++p) {
+      const Kernels::Split<T> partial = part(p);
+      for (std::size_t i = first; i < last; ++i) {
+        y.realData()[i] += partial.real[i];
+        y.imagData()[i] += partial.imag[i];
+      }
+    }
+  });
+}
+
+/// Product of compressed rows with a vector: gathers computes the product with the rows, otherwise with their
+/// transpose, and conjugate uses the conjugated values
+template <typename T>
+void compressedProduct(const std::span<const size_t> offsets, const size_t* indices, const SplitSpan<const T> values,
+                       const SplitSpan<const T> x, const SplitSpan<T> y, const bool gathers, const bool conjugate,
+                       ThreadPool& pool) {
+  if (gathers) {
+    const auto kernel = kernels<T>().gatherRows[conjugate];
+    gatherProduct(offsets, 1, y, pool,
+                  [&](const size_t* rowOffsets, std::size_t /*first*/, const std::size_t rows,
+                      const Kernels::Split<T> out) {
+                    kernel(rowOffsets, indices, split(values), split(x), out, rows);
+                  });
+    return;
+  }
+  const auto kernel = kernels<T>().scatterRows[conjugate];
+  scatterProduct(offsets, 1, y, pool,
+                 [&](const size_t* rowOffsets, const std::size_t first, const std::size_t rows,
+                     const Kernels::Split<T> out) {
+                   kernel(rowOffsets, indices, split(values), split(x.subspan(first, rows)), out, rows);
+                 });
+}
+
+void checkProduct(const std::size_t rows, const std::size_t cols, const std::size_t x, const std::size_t y,
+                  const SparseOperation operation, const char* message) {
+  const bool transposed = operation != SparseOperation::None;
+  if (x != (transposed ? rows : cols) || y != (transposed ? cols : rows)) throw std::invalid_argument(message);
+}
+
+/// Calls f(first, last) for chunks of a vector of n elements in parallel
+template <typename F>
+void forVectorChunks(const std::size_t n, ThreadPool& pool, F&& f) {
+  if (n <= SPARSE_GRAIN) {
+    f(std::size_t(0), n);
+    return;
+  }
+  pool.parallelForRange(0, n, SPARSE_GRAIN, f);
+}
+
+/// out[i] = sum of factors[t] * terms[t][i], out may be one of the terms
+template <typename T, std::size_t N>
+void combine(const SplitSpan<T> out, const std::array<BasicComplex<T>, N>& factors,
+             const std::array<SplitSpan<const T>, N>& terms, ThreadPool& pool) {
+  forVectorChunks(out.size(), pool, [&](const std::size_t first, const std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      T re = 0;
+      T im = 0;
+      for (std::size_t t = 0; t < N; ++t) {
+        const T xr = terms[t].realData()[i];
+        const T xi = terms[t].imagData()[i];
+        re += factors[t].real() * xr - factors[t].imag() * xi;
+        im += factors[t].real() * xi + factors[t].imag() * xr;
+      }
+      out.realData()[i] = re;
+      out.imagData()[i] = im;
+    }
+  });
+}
+
+template <typename T>
+T norm(const SplitSpan<const T> z, ThreadPool& pool) {
+  return std::sqrt(squaredNorm<T>(z, pool));
+}
+
+/// Computes r = b - A x
+template <typename Matrix, typename T>
+void residual(const Matrix& a, const SplitSpan<const T> b, const SplitSpan<const T> x, const SplitSpan<T> r,
+              ThreadPool& pool) {
+  a.multiply(x, r, SparseOperation::None, pool);
+  combine<T, 2>(r, {BasicComplex<T>(1, 0), BasicComplex<T>(-1, 0)}, {b, r}, pool);
+}
+
+template <typename Matrix, typename T>
+void checkSystem(const Matrix& a, const SplitSpan<const T> b, const SplitSpan<T> x) {
+  if (a.rows() != a.cols()) throw std::invalid_argument("ComplexSparse: matrix must be square");
+  if (b.size() != a.rows() || x.size() != a.rows()) {
+    throw std::invalid_argument("ComplexSparse: b and x must have rows() elements");
+  }
+}
+
+/// Plane rotation [c s; -conj(s) c] with real c
+template <typename T>
+struct Rotation {
+  T c;
+  BasicComplex<T> s;
+
+  /// Applies the rotation to the pair (u, v)
+  void apply(BasicComplex<T>& u, BasicComplex<T>& v) const {
+    const BasicComplex<T> w = c * u + s * v;
+    v = c * v - conj(s) * u;
+    u = w;
+  }
+};
+
+/// @return Rotation that zeros v in (u, v), for real v >= 0, and the new u in u
+template <typename T>
+Rotation<T> givens(BasicComplex<T>& u, const T v) {
+  const T magnitude = std::hypot(u.real(), u.imag());
+  if (magnitude == 0) {
+    u = BasicComplex<T>(v, 0);
+    return {T(0), BasicComplex<T>(1, 0)};
+  }
+  const T length = std::hypot(magnitude, v);
+  const BasicComplex<T> phase = u / magnitude;
+  u = phase * length;
+  return {magnitude / length, phase * (v / length)};
+}
+
+}  // namespace
+
+/// Create a matrix from its elements in any order, the values of duplicates are added
+/// @param rows Number of rows
+/// @param cols Number of columns
+/// @param entries Elements inside the matrix
+template <scalar T>
+BasicCsrMatrix<T>::BasicCsrMatrix(const size_t rows, const size_t cols, const std::span<const SparseEntry<T>> entries)
+    : m_Rows(rows), m_Cols(cols) {
+  checkDimensions(rows, cols, "CsrMatrix: dimensions exceed MAX_ELEMENT_COUNT");
+  Compressed<T> c = compress(rows, cols, entries, true, "CsrMatrix: entry outside the matrix");
+  m_Offsets = std::move(c.offsets);
+  m_Indices = std::move(c.indices);
+  m_Real = std::move(c.real);
+  m_Imag = std::move(c.imag);
+}
+
+/// Create a matrix from the nonzero elements of a dense matrix
+/// @param a Dense matrix
+template <scalar T>
+BasicCsrMatrix<T>::BasicCsrMatrix(const std::type_identity_t<ComplexMatrixView<const T>> a)
+    : m_Rows(a.rows()), m_Cols(a.cols()) {
+  Compressed<T> c = compress(a, true);
+  m_Offsets = std::move(c.offsets);
+  m_Indices = std::move(c.indices);
+  m_Real = std::move(c.real);
+  m_Imag = std::move(c.imag);
+}
+
+/// Create a matrix from compressed rows
+/// @param rows Number of rows
+/// @param cols Number of columns
+/// @param offsets rows + 1 nondecreasing offsets from 0 to the number of elements, row i has [offsets[i],
+/// offsets[i + 1])
+/// @param indices Column of every element, increasing within a row
+/// @param real Real parts of the elements
+/// @param imag Imaginary parts of the elements
+template <scalar T>
+BasicCsrMatrix<T>::BasicCsrMatrix(const size_t rows, const size_t cols, std::vector<size_t> offsets,
+                                  std::vector<size_t> indices, AlignedVector<T> real, AlignedVector<T> imag)
+    : m_Rows(rows),
+      m_Cols(cols),
+      m_Offsets(std::move(offsets)),
+      m_Indices(std::move(indices)),
+      m_Real(std::move(real)),
+      m_Imag(std::move(imag)) {
+  checkDimensions(rows, cols, "CsrMatrix: dimensions exceed MAX_ELEMENT_COUNT");
+  checkCompressed(rows, cols, m_Offsets, m_Indices, m_Real, m_Imag, "CsrMatrix: invalid compressed rows");
+}
+
+/// @return Copy in compressed columns
+template <scalar T>
+BasicCscMatrix<T> BasicCsrMatrix<T>::toCsc() const {
+  Compressed<T> c = transpose<T>(m_Offsets, m_Indices, values(), m_Cols);
+  return BasicCscMatrix<T>(m_Rows, m_Cols, std::move(c.offsets), std::move(c.indices), std::move(c.real),
+                           std::move(c.imag));
+}
+
+/// @return Dense copy, row-major
+template <scalar T>
+BasicComplexMatrix<T> BasicCsrMatrix<T>::toDense() const {
+  BasicComplexMatrix<T> result(m_Rows, m_Cols);
+  for (size_t i = 0; i < m_Rows; ++i) {
+    for (size_t k = m_Offsets[i]; k < m_Offsets[i + 1]; ++k) result(i, m_Indices[k]) = {m_Real[k], m_Imag[k]};
+  }
+  return result;
+}
+
+/// Multiplies a vector by the matrix, its transpose or its adjoint
+/// @param x Vector of cols() elements, rows() for the transpose and the adjoint
+/// @param y Product of rows() elements, cols() for the transpose and the adjoint, must not overlap x
+/// @param operation Operator applied to the matrix
+/// @param pool Threads that compute chunks of the product
+template <scalar T>
+void BasicCsrMatrix<T>::multiply(const std::type_identity_t<SplitSpan<const T>> x, const SplitSpan<T> y,
+                                 const SparseOperation operation, ThreadPool& pool) const {
+  checkProduct(m_Rows, m_Cols, x.size(), y.size(), operation, "CsrMatrix: x and y must match the matrix");
+  compressedProduct<T>(m_Offsets, m_Indices.data(), values(), x, y, operation == SparseOperation::None,
+                       operation == SparseOperation::Adjoint, pool);
+}
+
+/// Create a matrix from its elements in any order, the values of duplicates are added
+/// @param rows Number of rows
+/// @param cols Number of columns
+/// @param entries Elements inside the matrix
+template <scalar T>
+BasicCscMatrix<T>::BasicCscMatrix(const size_t rows, const size_t cols, const std::span<const SparseEntry<T>> entries)
+    : m_Rows(rows), m_Cols(cols) {
+  checkDimensions(rows, cols, "CscMatrix: dimensions exceed MAX_ELEMENT_COUNT");
+  Compressed<T> c = compress(cols, rows, entries, false, "CscMatrix: entry outside the matrix");
+  m_Offsets = std::move(c.offsets);
+  m_Indices = std::move(c.indices);
+  m_Real = std::move(c.real);
+  m_Imag = std::move(c.imag);
+}
+
+/// Create a matrix from the nonzero elements of a dense matrix
+/// @param a Dense matrix
+template <scalar T>
+BasicCscMatrix<T>::BasicCscMatrix(const std::type_identity_t<ComplexMatrixView<const T>> a)
+    : m_Rows(a.rows()), m_Cols(a.cols()) {
+  Compressed<T> c = compress(a, false);
+  m_Offsets = std::move(c.offsets);
+  m_Indices = std::move(c.indices);
+  m_Real = std::move(c.real);
+  m_Imag = std::move(c.imag);
+}
+
+/// Create a matrix from compressed columns
+/// @param rows Number of rows
+/// @param cols Number of columns
+/// @param offsets cols + 1 nondecreasing offsets from 0 to the number of elements, column j has [offsets[j],
+/// offsets[j + 1])
+/// @param indices Row of every element, increasing within a column
+/// @param real Real parts of the elements
+/// @param imag Imaginary parts of the elements
+template <scalar T>
+BasicCscMatrix<T>::BasicCscMatrix(const size_t rows, const size_t cols, std::vector<size_t> offsets,
+                                  std::vector<size_t> indices, AlignedVector<T> real, AlignedVector<T> imag)
+    : m_Rows(rows),
+      m_Cols(cols),
+      m_Offsets(std::move(offsets)),
+      m_Indices(std::move(indices)),
+      m_Real(std::move(real)),
+      m_Imag(std::move(imag)) {
+  checkDimensions(rows, cols, "CscMatrix: dimensions exceed MAX_ELEMENT_COUNT");
+  checkCompressed(cols, rows, m_Offsets, m_Indices, m_Real, m_Imag, "CscMatrix: invalid compressed columns");
+}
+
+/// @return Copy in compressed rows
+template <scalar T>
+BasicCsrMatrix<T> BasicCscMatrix<T>::toCsr() const {
+  Compressed<T> c = transpose<T>(m_Offsets, m_Indices, values(), m_Rows);
+  return BasicCsrMatrix<T>(m_Rows, m_Cols, std::move(c.offsets), std::move(c.indices), std::move(c.real),
+                           std::move(c.imag));
+}
+
+/// @return Dense copy, column-major
+template <scalar T>
+BasicComplexMatrix<T> BasicCscMatrix<T>::toDense() const {
+  BasicComplexMatrix<T> result(m_Rows, m_Cols, MatrixLayout::ColumnMajor);
+  for (size_t j = 0; j < m_Cols; ++j) {
+    for (size_t k = m_Offsets[j]; k < m_Offsets[j + 1]; ++k) result(m_Indices[k], j) = {m_Real[k], m_Imag[k]};
+  }
+  return result;
+}
+
+/// Multiplies a vector by the matrix, its transpose or its adjoint
+/// @param x Vector of cols() elements, rows() for the transpose and the adjoint
+/// @param y Product of rows() elements, cols() for the transpose and the adjoint, must not overlap x
+/// @param operation Operator applied to the matrix
+/// @param pool Threads that compute chunks of the product
+template <scalar T>
+void BasicCscMatrix<T>::multiply(const std::type_identity_t<SplitSpan<const T>> x, const SplitSpan<T> y,
+                                 const SparseOperation operation, ThreadPool& pool) const {
+  checkProduct(m_Rows, m_Cols, x.size(), y.size(), operation, "CscMatrix: x and y must match the matrix");
+  // The columns of A are the rows of A^T, so the transposed products gather
+  compressedProduct<T>(m_Offsets, m_Indices.data(), values(), x, y, operation != SparseOperation::None,
+                       operation == SparseOperation::Adjoint, pool);
+}
+
+/// Create a matrix from the blocks that contain elements of a CSR matrix, the other elements of those blocks are 0
+/// @param a Matrix whose dimensions are multiples of block
+/// @param block Rows and columns of a block, at least 1
+template <scalar T>
+BasicBsrMatrix<T>::BasicBsrMatrix(const BasicCsrMatrix<T>& a, const size_t block)
+    : m_Rows(a.rows()), m_Cols(a.cols()), m_Block(block) {
+  if (block == 0 || m_Rows % block != 0 || m_Cols % block != 0) {
+    throw std::invalid_argument("BsrMatrix: dimensions must be multiples of the block size");
+  }
+  const std::size_t blockElements = std::size_t(block) * block;
+  const size_t blockRows = m_Rows / block;
+  const std::span<const size_t> offsets = a.offsets();
+  const std::span<const size_t> indices = a.indices();
+  const SplitSpan<const T> values = a.values();
+  constexpr size_t NONE = std::numeric_limits<size_t>::max();
+  // Block of every block column in the current block row
+  std::vector<size_t> slot(m_Cols / block, NONE);
+  std::vector<size_t> columns;
+  m_Offsets.assign(std::size_t(blockRows) + 1, 0);
+  for (size_t r = 0; r < blockRows; ++r) {
+    columns.clear();
+    for (size_t k = offsets[r * block]; k < offsets[(r + 1) * block]; ++k) {
+      const size_t column = indices[k] / block;
+      if (slot[column] == NONE) {
+        slot[column] = 0;
+        columns.push_back(column);
+      }
+    }
+    std::sort(columns.begin(), columns.end());
+    const std::size_t first = m_Indices.size();
+    checkNonZeros((first + columns.size()) * blockElements, "BsrMatrix: too many stored elements");
+    for (std::size_t b = 0; b < columns.size(); ++b) slot[columns[b]] = static_cast<size_t>(first + b);
+    m_Indices.insert(m_Indices.end(), columns.begin(), columns.end());
+    m_Real.resize(m_Indices.size() * blockElements);
+    m_Imag.resize(m_Indices.size() * blockElements);
+    for (size_t i = 0; i < block; ++i) {
+      const size_t row = r * block + i;
+      for (size_t k = offsets[row]; k < offsets[row + 1]; ++k) {
+        const size_t j = indices[k] % block;
+        const std::size_t element = slot[indices[k] / block] * blockElements + std::size_t(j) * block + i;
+        m_Real[element] = values.realData()[k];
+        m_Imag[element] = values.imagData()[k];
+      }
+    }
+    for (const size_t column : columns) slot[column] = NONE;
+    m_Offsets[r + 1] = static_cast<size_t>(m_Indices.size());
+  }
+}
+
+/// @return Copy in compressed rows without the zeros inside the blocks
+template <scalar T>
+BasicCsrMatrix<T> BasicBsrMatrix<T>::toCsr() const {
+  const std::size_t blockElements = std::size_t(m_Block) * m_Block;
+  std::vector<size_t> offsets(std::size_t(m_Rows) + 1, 0);
+  std::vector<size_t> indices;
+  AlignedVector<T> real;
+  AlignedVector<T> imag;
+  for (size_t row = 0; row < m_Rows; ++row) {
+    const size_t r = row / m_Block;
+    const size_t i = row % m_Block;
+    for (size_t k = m_Offsets[r]; k < m_Offsets[r + 1]; ++k) {
+      for (size_t j = 0; j < m_Block; ++j) {
+        const std::size_t element = k * blockElements + std::size_t(j) * m_Block + i;
+        if (m_Real[element] == 0 && m_Imag[element] == 0) continue;
+        indices.push_back(m_Indices[k] * m_Block + j);
+        real.push_back(m_Real[element]);
+        imag.push_back(m_Imag[element]);
+      }
+    }
+    offsets[row + 1] = static_cast<size_t>(indices.size());
+  }
+  return BasicCsrMatrix<T>(m_Rows, m_Cols, std::move(offsets), std::move(indices), std::move(real), std::move(imag));
+}
+
+/// @return Dense copy, row-major
+template <scalar T>
+BasicComplexMatrix<T> BasicBsrMatrix<T>::toDense() const {
+  BasicComplexMatrix<T> result(m_Rows, m_Cols);
+  const std::size_t blockElements = std::size_t(m_Block) * m_Block;
+  for (size_t r = 0; r < m_Rows / m_Block; ++r) {
+    for (size_t k = m_Offsets[r]; k < m_Offsets[r + 1]; ++k) {
+      for (size_t j = 0; j < m_Block; ++j) {
+        for (size_t i = 0; i < m_Block; ++i) {
+          const std::size_t element = k * blockElements + std::size_t(j) * m_Block + i;
+          result(r * m_Block + i, m_Indices[k] * m_Block + j) = {m_Real[element], m_Imag[element]};
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/// Multiplies a vector by the matrix, its transpose or its adjoint
+/// @param x Vector of cols() elements, rows() for the transpose and the adjoint
+/// @param y Product of rows() elements, cols() for the transpose and the adjoint, must not overlap x
+/// @param operation Operator applied to the matrix
+/// @param pool Threads that compute chunks of the product
+template <scalar T>
+void BasicBsrMatrix<T>::multiply(const std::type_identity_t<SplitSpan<const T>> x, const SplitSpan<T> y,
+                                 const SparseOperation operation, ThreadPool& pool) const {
+  checkProduct(m_Rows, m_Cols, x.size(), y.size(), operation, "BsrMatrix: x and y must match the matrix");
+  const std::size_t block = m_Block;
+  const size_t* indices = m_Indices.data();
+  if (operation == SparseOperation::None) {
+    const auto kernel = kernels<T>().gatherBlocks;
+    gatherProduct(std::span<const size_t>(m_Offsets), block, y, pool,
+                  [&](const size_t* rowOffsets, std::size_t /*first*/, const std::size_t rows,
+                      const Kernels::Split<T> out) {
+                    kernel(rowOffsets, indices, split(values()), block, split(x), out, rows);
+                  });
+    return;
+  }
+  const auto kernel = kernels<T>().scatterBlocks[operation == SparseOperation::Adjoint];
+  scatterProduct(std::span<const size_t>(m_Offsets), block, y, pool,
+                 [&](const size_t* rowOffsets, const std::size_t first, const std::size_t rows,
+                     const Kernels::Split<T> out) {
+                   kernel(rowOffsets, indices, split(values()), block, split(x.subspan(first * block, rows * block)),
+                          out, rows);
+                 });
+}
+
+/// Solves A x = b with restarted GMRES(m)
+/// @param a Square CSR, CSC or BSR matrix
+/// @param b Right-hand side
+/// @param x Initial guess, overwritten with the solution
+/// @param tolerance Relative residual |b - A x| / |b| at which the iteration stops
+/// @param maxIterations Maximum number of iterations, each one product by A
+/// @param restart Dimension m of the Krylov space between restarts, at least 1
+/// @param pool Threads that compute the products and the vector operations
+/// @return Convergence
+template <typename Matrix>
+SolverStatus gmres(const Matrix& a, const SplitSpan<const typename Matrix::scalar_type> b,
+                   const SplitSpan<typename Matrix::scalar_type> x, const double tolerance,
+                   const size_t maxIterations, const size_t restart, ThreadPool& pool) {
+  using T = typename Matrix::scalar_type;
+  using Z = BasicComplex<T>;
+  checkSystem(a, b, x);
+  if (restart == 0) throw std::invalid_argument("ComplexSparse: restart must be at least 1");
+  SolverStatus status = {0, 0, false};
+  const T bNorm = norm(b, pool);
+  if (bNorm == 0) {
+    std::fill_n(x.realData(), x.size(), T(0));
+    std::fill_n(x.imagData(), x.size(), T(0));
+    status.converged = true;
+    return status;
+  }
+  const size_t m = std::min(restart, std::max<size_t>(maxIterations, 1));
+  // Orthonormal basis of the Krylov space, the residual of the current x in basis[0] at the start of every cycle
+  std::vector<BasicComplexArray<T>> basis;
+  basis.reserve(std::size_t(m) + 1);
+  for (size_t i = 0; i <= m; ++i) basis.emplace_back(a.rows());
+  // Hessenberg matrix, column-major, reduced to upper triangular form by the rotations
+  std::vector<Z> h(std::size_t(m + 1) * m);
+  std::vector<Rotation<T>> rotations(m);
+  std::vector<Z> g(std::size_t(m) + 1);
+  std::vector<Z> y(m);
+  bool stalled = false;
+  while (true) {
+    residual<Matrix, T>(a, b, x, basis[0], pool);
+    const T beta = norm<T>(basis[0], pool);
+    status.residual = double(beta / bNorm);
+    if (status.residual <= tolerance) {
+      status.converged = true;
+      break;
+    }
+    if (stalled || status.iterations >= maxIterations) break;
+    combine<T, 1>(basis[0], {Z(T(1) / beta, 0)}, {basis[0]}, pool);
+    std::fill(g.begin(), g.end(), Z());
+    g[0] = Z(beta, 0);
+    size_t k = 0;
+    while (k < m && status.iterations < maxIterations) {
+      const size_t j = k;
+      a.multiply(basis[j], basis[j + 1], SparseOperation::None, pool);
+      ++status.iterations;
+      Z* column = h.data() + std::size_t(j) * (m + 1);
+      for (size_t i = 0; i <= j; ++i) {
+        column[i] = dotc<T>(basis[i], basis[j + 1], pool);
+        combine<T, 2>(basis[j + 1], {Z(1, 0), -column[i]}, {basis[j + 1], basis[i]}, pool);
+      }
+      const T next = norm<T>(basis[j + 1], pool);
+      for (size_t i = 0; i < j; ++i) rotations[i].apply(column[i], column[i + 1]);
+      rotations[j] = givens(column[j], next);
+      column[j + 1] = Z();
+      if (isZero(column[j])) {
+        // A x = b has no solution in the Krylov space
+        stalled = true;
+        break;
+      }
+      k = j + 1;
+      rotations[j].apply(g[j], g[j + 1]);
+      if (next == 0 || double(abs(g[j + 1]) / bNorm) <= tolerance) break;
+      combine<T, 1>(basis[j + 1], {Z(T(1) / next, 0)}, {basis[j + 1]}, pool);
+    }
+    // Back substitution of the triangular system R y = g, then x += V y
+    for (size_t i = k; i-- > 0;) {
+      Z sum = g[i];
+      for (size_t l = i + 1; l < k; ++l) sum -= h[std::size_t(l) * (m + 1) + i] * y[l];
+      y[i] = scaledDivide(sum, h[std::size_t(i) * (m + 1) + i]);
+    }
+    for (size_t i = 0; i < k; ++i) combine<T, 2>(x, {Z(1, 0), y[i]}, {x, basis[i]}, pool);
+    if (k == 0) stalled = true;
+  }
+  return status;
+}
+
+/// Solves A x = b with BiCGSTAB
+/// @param a Square CSR, CSC or BSR matrix
+/// @param b Right-hand side
+/// @param x Initial guess, overwritten with the solution
+/// @param tolerance Relative residual |b - A x| / |b| at which the iteration stops
+/// @param maxIterations Maximum number of iterations, each two products by A
+/// @param pool Threads that compute the products and the vector operations
+/// @return Convergence
+template <typename Matrix>
+SolverStatus bicgstab(const Matrix& a, const SplitSpan<const typename Matrix::scalar_type> b,
+                      const SplitSpan<typename Matrix::scalar_type> x, const double tolerance,
+                      const size_t maxIterations, ThreadPool& pool) {
+  using T = typename Matrix::scalar_type;
+  using Z = BasicComplex<T>;
+  checkSystem(a, b, x);
+  SolverStatus status = {0, 0, false};
+  const T bNorm = norm(b, pool);
+  if (bNorm == 0) {
+    std::fill_n(x.realData(), x.size(), T(0));
+    std::fill_n(x.imagData(), x.size(), T(0));
+    status.converged = true;
+    return status;
+  }
+  const size_t n = a.rows();
+  BasicComplexArray<T> r(n);
+  BasicComplexArray<T> shadow(n);
+  BasicComplexArray<T> p(n);
+  BasicComplexArray<T> v(n);
+  BasicComplexArray<T> s(n);
+  BasicComplexArray<T> t(n);
+  Z rho;
+  Z alpha;
+  Z omega;
+  // Whether r is the true residual b - A x, set after every restart
+  bool restart = true;
+  while (true) {
+    if (restart) {
+      residual<Matrix, T>(a, b, x, r, pool);
+      status.residual = double(norm<T>(r, pool) / bNorm);
+      if (status.residual <= tolerance) {
+        status.converged = true;
+        break;
+      }
+      std::ranges::copy(r.real(), shadow.real().begin());
+      std::ranges::copy(r.imag(), shadow.imag().begin());
+      std::ranges::fill(p.real(), T(0));
+      std::ranges::fill(p.imag(), T(0));
+      std::ranges::fill(v.real(), T(0));
+      std::ranges::fill(v.imag(), T(0));
+      rho = alpha = omega = Z(1, 0);
+      restart = false;
+    }
+    if (status.iterations >= maxIterations) break;
+    ++status.iterations;
+    const Z rhoNext = dotc<T>(shadow, r, pool);
+    if (isZero(rhoNext)) {
+      restart = true;
+      continue;
+    }
+    const Z beta = scaledDivide(rhoNext, rho) * scaledDivide(alpha, omega);
+    combine<T, 3>(p, {Z(1, 0), beta, -beta * omega}, {r, p, v}, pool);
+    a.multiply(p, v, SparseOperation::None, pool);
+    const Z shadowV = dotc<T>(shadow, v, pool);
+    if (isZero(shadowV)) {
+      restart = true;
+      continue;
+    }
+    alpha = scaledDivide(rhoNext, shadowV);
+    combine<T, 2>(s, {Z(1, 0), -alpha}, {r, v}, pool);
+    if (double(norm<T>(s, pool) / bNorm) <= tolerance) {
+      combine<T, 2>(x, {Z(1, 0), alpha}, {x, p}, pool);
+      restart = true;
+      continue;
+    }
+    a.multiply(s, t, SparseOperation::None, pool);
+    const T tt = squaredNorm<T>(t, pool);
+    if (tt == 0) {
+      combine<T, 2>(x, {Z(1, 0), alpha}, {x, p}, pool);
+      restart = true;
+      continue;
+    }
+    omega = dotc<T>(t, s, pool) / tt;
+    combine<T, 3>(x, {Z(1, 0), alpha, omega}, {x, p, s}, pool);
+    combine<T, 2>(r, {Z(1, 0), -omega}, {s, t}, pool);
+    rho = rhoNext;
+    restart = isZero(omega) || double(norm<T>(r, pool) / bNorm) <= tolerance;
+  }
+  if (!status.converged && !restart) {
+    residual<Matrix, T>(a, b, x, r, pool);
+    status.residual = double(norm<T>(r, pool) / bNorm);
+  }
+  return status;
+}
+
+#define MATH_INSTANTIATE_SPARSE_SOLVERS(M)                                                                     \
+  template SolverStatus gmres<M>(const M&, SplitSpan<const M::scalar_type>, SplitSpan<M::scalar_type>, double, \
+                                 size_t, size_t, ThreadPool&);                                                 \
+  template SolverStatus bicgstab<M>(const M&, SplitSpan<const M::scalar_type>, SplitSpan<M::scalar_type>,      \
+                                    double, size_t, ThreadPool&);
+
+#define MATH_INSTANTIATE_COMPLEX_SPARSE(T)             \
+  template class BasicCsrMatrix<T>;                    \
+  template class BasicCscMatrix<T>;                    \
+  template class BasicBsrMatrix<T>;                    \
+  MATH_INSTANTIATE_SPARSE_SOLVERS(BasicCsrMatrix<T>)   \
+  MATH_INSTANTIATE_SPARSE_SOLVERS(BasicCscMatrix<T>)   \
+  MATH_INSTANTIATE_SPARSE_SOLVERS(BasicBsrMatrix<T>)
+
+MATH_INSTANTIATE_COMPLEX_SPARSE(float)
+MATH_INSTANTIATE_COMPLEX_SPARSE(double)
+MATH_INSTANTIATE_COMPLEX_SPARSE(long double)
+
+#undef MATH_INSTANTIATE_COMPLEX_SPARSE
+#undef MATH_INSTANTIATE_SPARSE_SOLVERS
+
+}  // namespace Math
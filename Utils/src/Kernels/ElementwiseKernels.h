@@ -0,0 +1,238 @@
+#ifndef MATH_ELEMENTWISE_KERNELS_H
+#define MATH_ELEMENTWISE_KERNELS_H
+
+#include <utility>
+
+#include "Kernels.h"
+#include "SimdMath.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// Compile time index, like std::integral_constant, whose conversion is declared per instruction set
+template <std::size_t I>
+struct Index {
+  static constexpr std::size_t value = I;
+  MATH_SIMD_INLINE constexpr operator std::size_t() const { return I; }
+};
+
+/// Calls f(Index<i>) for i < N, unrolled at compile time
+template <std::size_t N, typename F>
+MATH_SIMD_INLINE void unrolled(F&& f) {
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    (f(Index<I>()), ...);
+  }(std::make_index_sequence<N>());
+}
+
+/// Real and imaginary parts of a pack of complex numbers
+template <typename P>
+struct CPack {
+  P re;
+  P im;
+};
+
+/// Operand that reads consecutive elements of a split array
+template <typename T>
+struct ArraySource {
+  Split<const T> z;
+
+  template <typename P>
+  CPack<P> get(const std::size_t i) const {
+    return {P::load(z.real + i), P::load(z.imag + i)};
+  }
+};
+
+/// Operand that broadcasts a complex number
+template <typename T>
+struct ComplexSource {
+  T re;
+  T im;
+
+  template <typename P>
+  CPack<P> get(const std::size_t /*i*/) const {
+    return {P(re), P(im)};
+  }
+};
+
+/// Operand that broadcasts a real number
+template <typename T>
+struct RealSource {
+  T re;
+
+  template <typename P>
+  P get(const std::size_t /*i*/) const {
+    return P(re);
+  }
+};
+
+template <typename P>
+void store(const CPack<P> z, const Split<typename P::value_type> out, const std::size_t i) {
+  z.re.store(out.real + i);
+  z.im.store(out.imag + i);
+}
+
+struct AddOp {
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const CPack<P> b) {
+    return {a.re + b.re, a.im + b.im};
+  }
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const P b) {
+    return {a.re + b, a.im};
+  }
+  template <typename P>
+  static CPack<P> apply(const P a, const CPack<P> b) {
+    return {a + b.re, b.im};
+  }
+};
+
+struct SubtractOp {
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const CPack<P> b) {
+    return {a.re - b.re, a.im - b.im};
+  }
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const P b) {
+    return {a.re - b, a.im};
+  }
+  template <typename P>
+  static CPack<P> apply(const P a, const CPack<P> b) {
+    return {a - b.re, -b.im};
+  }
+};
+
+struct MultiplyOp {
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const CPack<P> b) {
+    return {mulSub(a.re, b.re, a.im * b.im), mulAdd(a.im, b.re, a.re * b.im)};
+  }
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const P b) {
+    return {a.re * b, a.im * b};
+  }
+  template <typename P>
+  static CPack<P> apply(const P a, const CPack<P> b) {
+    return {a * b.re, a * b.im};
+  }
+};
+
+struct DivideOp {
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const CPack<P> b) {
+    const P div = mulAdd(b.re, b.re, b.im * b.im);
+    return {mulAdd(a.re, b.re, a.im * b.im) / div, mulSub(a.im, b.re, a.re * b.im) / div};
+  }
+  template <typename P>
+  static CPack<P> apply(const CPack<P> a, const P b) {
+    return {a.re / b, a.im / b};
+  }
+  template <typename P>
+  static CPack<P> apply(const P a, const CPack<P> b) {
+    const P div = mulAdd(b.re, b.re, b.im * b.im);
+    return {a * b.re / div, -(a * b.im) / div};
+  }
+};
+
+/// Applies a binary operation to all elements, full packs first and the remainder lane by lane
+template <typename T, typename Op, typename L, typename R>
+void binary(const L lhs, const R rhs, const Split<T> out, const std::size_t n) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t i = 0;
+  for (; i + P::width <= n; i += P::width) store(Op::apply(lhs.template get<P>(i), rhs.template get<P>(i)), out, i);
+  for (; i < n; ++i) store(Op::apply(lhs.template get<S>(i), rhs.template get<S>(i)), out, i);
+}
+
+template <typename T, typename Op>
+void arrayArray(const Split<const T> lhs, const Split<const T> rhs, const Split<T> out, const std::size_t n) {
+  binary<T, Op>(ArraySource<T>{lhs}, ArraySource<T>{rhs}, out, n);
+}
+
+template <typename T, typename Op>
+void arrayComplex(const Split<const T> lhs, const T rhsReal, const T rhsImag, const Split<T> out,
+                  const std::size_t n) {
+  binary<T, Op>(ArraySource<T>{lhs}, ComplexSource<T>{rhsReal, rhsImag}, out, n);
+}
+
+template <typename T, typename Op>
+void complexArray(const T lhsReal, const T lhsImag, const Split<const T> rhs, const Split<T> out,
+                  const std::size_t n) {
+  binary<T, Op>(ComplexSource<T>{lhsReal, lhsImag}, ArraySource<T>{rhs}, out, n);
+}
+
+template <typename T, typename Op>
+void arrayReal(const Split<const T> lhs, const T rhs, const Split<T> out, const std::size_t n) {
+  binary<T, Op>(ArraySource<T>{lhs}, RealSource<T>{rhs}, out, n);
+}
+
+template <typename T, typename Op>
+void realArray(const T lhs, const Split<const T> rhs, const Split<T> out, const std::size_t n) {
+  binary<T, Op>(RealSource<T>{lhs}, ArraySource<T>{rhs}, out, n);
+}
+
+/// Applies a function that maps a pack of complex numbers to a pack of complex numbers
+template <typename T, typename F>
+void mapComplex(const Split<const T> z, const Split<T> out, const std::size_t n, F f) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t i = 0;
+  for (; i + P::width <= n; i += P::width) store(f(ArraySource<T>{z}.template get<P>(i)), out, i);
+  for (; i < n; ++i) store(f(ArraySource<T>{z}.template get<S>(i)), out, i);
+}
+
+/// Applies a function that maps a pack of complex numbers to a pack of real numbers
+template <typename T, typename F>
+void mapReal(const Split<const T> z, T* out, const std::size_t n, F f) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t i = 0;
+  for (; i + P::width <= n; i += P::width) f(ArraySource<T>{z}.template get<P>(i)).store(out + i);
+  for (; i < n; ++i) f(ArraySource<T>{z}.template get<S>(i)).store(out + i);
+}
+
+template <typename T>
+void negate(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return decltype(a){-a.re, -a.im}; });
+}
+
+template <typename T>
+void conj(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return decltype(a){a.re, -a.im}; });
+}
+
+template <typename T>
+void abs(const Split<const T> z, T* out, const std::size_t n) {
+  mapReal(z, out, n, [](const auto a) { return sqrt(mulAdd(a.re, a.re, a.im * a.im)); });
+}
+
+template <typename T>
+void abs2(const Split<const T> z, T* out, const std::size_t n) {
+  mapReal(z, out, n, [](const auto a) { return mulAdd(a.re, a.re, a.im * a.im); });
+}
+
+template <typename T>
+void arg(const Split<const T> z, T* out, const std::size_t n) {
+  mapReal(z, out, n, [](const auto a) { return atan2(a.im, a.re); });
+}
+
+template <typename T>
+constexpr ElementwiseKernels<T> elementwiseKernels() {
+  return {
+      .arrayArray = {arrayArray<T, AddOp>, arrayArray<T, SubtractOp>, arrayArray<T, MultiplyOp>,
+                     arrayArray<T, DivideOp>},
+      .arrayComplex = {arrayComplex<T, AddOp>, arrayComplex<T, SubtractOp>, arrayComplex<T, MultiplyOp>,
+                       arrayComplex<T, DivideOp>},
+      .complexArray = {complexArray<T, AddOp>, complexArray<T, SubtractOp>, complexArray<T, MultiplyOp>,
+                       complexArray<T, DivideOp>},
+      .arrayReal = {arrayReal<T, AddOp>, arrayReal<T, SubtractOp>, arrayReal<T, MultiplyOp>, arrayReal<T, DivideOp>},
+      .realArray = {realArray<T, AddOp>, realArray<T, SubtractOp>, realArray<T, MultiplyOp>, realArray<T, DivideOp>},
+      .negate = negate<T>,
+      .conj = conj<T>,
+      .abs = abs<T>,
+      .abs2 = abs2<T>,
+      .arg = arg<T>,
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_ELEMENTWISE_KERNELS_H
@@ -0,0 +1,69 @@
+#ifndef MATH_GEMM_KERNELS_H
+#define MATH_GEMM_KERNELS_H
+
+// Micro-kernel of the complex matrix product. The tile of mr x nr accumulators is kept in registers as separate real
+// and imaginary packs, every step multiplies a column of the A panel with a broadcast row of the B panel in the
+// 4-multiply form re += ar br - ai bi, im += ar bi + ai br. The tile shape uses as many of the vector registers as
+// possible without spilling: 2 packs of rows by 6 columns (24 accumulators) for the 32 registers of AVX-512, and
+// 2 by 2 for the 16 registers of AVX2 and SSE2, where the broadcasts and the products without FMA need the rest.
+
+#include "ElementwiseKernels.h"
+#include "Kernels.h"
+#include "SimdPack.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// Vectors of rows and number of columns of the register tile
+#if defined(MATH_SIMD_AVX512)
+constexpr std::size_t GEMM_ROW_PACKS = 2;
+constexpr std::size_t GEMM_COLUMNS = 6;
+#else
+constexpr std::size_t GEMM_ROW_PACKS = 2;
+constexpr std::size_t GEMM_COLUMNS = 2;
+#endif
+
+template <typename T>
+void gemmMicroKernel(const std::size_t k, const T* a, const T* b, T* tile) {
+  using P = Simd::Native<T>;
+  constexpr std::size_t MR = GEMM_ROW_PACKS * P::width;
+  constexpr std::size_t NR = GEMM_COLUMNS;
+  P re[GEMM_ROW_PACKS][NR];
+  P im[GEMM_ROW_PACKS][NR];
+  for (std::size_t p = 0; p < k; ++p) {
+    P ar[GEMM_ROW_PACKS];
+    P ai[GEMM_ROW_PACKS];
+    unrolled<GEMM_ROW_PACKS>([&](const auto v) {
+      ar[v] = P::load(a + v * P::width);
+      ai[v] = P::load(a + MR + v * P::width);
+    });
+    unrolled<NR>([&](const auto j) {
+      const P br(b[j]);
+      const P bi(b[NR + j]);
+      unrolled<GEMM_ROW_PACKS>([&](const auto v) {
+        re[v][j] = negMulAdd(ai[v], bi, mulAdd(ar[v], br, re[v][j]));
+        im[v][j] = mulAdd(ai[v], br, mulAdd(ar[v], bi, im[v][j]));
+      });
+    });
+    a += 2 * MR;
+    b += 2 * NR;
+  }
+  unrolled<NR>([&](const auto j) {
+    unrolled<GEMM_ROW_PACKS>([&](const auto v) {
+      re[v][j].store(tile + j * MR + v * P::width);
+      im[v][j].store(tile + MR * NR + j * MR + v * P::width);
+    });
+  });
+}
+
+template <typename T>
+constexpr GemmKernels<T> gemmKernels() {
+  return {
+      .mr = GEMM_ROW_PACKS * Simd::Native<T>::width,
+      .nr = GEMM_COLUMNS,
+      .microKernel = gemmMicroKernel<T>,
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_GEMM_KERNELS_H
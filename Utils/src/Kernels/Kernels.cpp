@@ -0,0 +1,32 @@
+#include "Kernels.h"
+
+#include <type_traits>
+
+#include "Simd.h"
+
+namespace Math::Kernels {
+
+template <typename T>
+const KernelTable<T>& table() {
+#if defined(MATH_SIMD_X86)
+  if constexpr (!std::is_same_v<T, long double>) {
+    switch (Simd::activeIsa()) {
+      case Simd::Isa::Avx512:
+        return Avx512::table<T>();
+      case Simd::Isa::Avx2:
+        return Avx2::table<T>();
+      case Simd::Isa::Sse2:
+        return Sse2::table<T>();
+      case Simd::Isa::Scalar:
+        break;
+    }
+  }
+#endif
+  return Scalar::table<T>();
+}
+
+template const KernelTable<float>& table<float>();
+template const KernelTable<double>& table<double>();
+template const KernelTable<long double>& table<long double>();
+
+}  // namespace Math::Kernels
@@ -0,0 +1,183 @@
+#ifndef MATH_KERNELS_H
+#define MATH_KERNELS_H
+
+// Function tables of the SIMD kernels. Every instruction set has its own translation unit that fills a table from
+// the same kernel templates, table<T>() returns the one for the active instruction set.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Math::Kernels {
+
+/// Raw pointers to separate real and imaginary parts
+template <typename T>
+struct Split {
+  T* real;
+  T* imag;
+};
+
+enum BinaryOp : std::size_t { Add, Subtract, Multiply, Divide, BINARY_OP_COUNT };
+
+template <typename T>
+struct ElementwiseKernels {
+  using ArrayArray = void (*)(Split<const T> lhs, Split<const T> rhs, Split<T> out, std::size_t n);
+  using ArrayComplex = void (*)(Split<const T> lhs, T rhsReal, T rhsImag, Split<T> out, std::size_t n);
+  using ComplexArray = void (*)(T lhsReal, T lhsImag, Split<const T> rhs, Split<T> out, std::size_t n);
+  using ArrayReal = void (*)(Split<const T> lhs, T rhs, Split<T> out, std::size_t n);
+  using RealArray = void (*)(T lhs, Split<const T> rhs, Split<T> out, std::size_t n);
+  using Unary = void (*)(Split<const T> z, Split<T> out, std::size_t n);
+  using ToReal = void (*)(Split<const T> z, T* out, std::size_t n);
+
+  ArrayArray arrayArray[BINARY_OP_COUNT];
+  ArrayComplex arrayComplex[BINARY_OP_COUNT];
+  ComplexArray complexArray[BINARY_OP_COUNT];
+  ArrayReal arrayReal[BINARY_OP_COUNT];
+  RealArray realArray[BINARY_OP_COUNT];
+  Unary negate;
+  Unary conj;
+  ToReal abs;
+  ToReal abs2;
+  ToReal arg;
+};
+
+template <typename T>
+struct TranscendentalKernels {
+  using Unary = void (*)(Split<const T> z, Split<T> out, std::size_t n);
+  using PowArray = void (*)(Split<const T> z, Split<const T> w, Split<T> out, std::size_t n);
+  using PowComplex = void (*)(Split<const T> z, T wReal, T wImag, Split<T> out, std::size_t n);
+  using PowReal = void (*)(Split<const T> z, T w, Split<T> out, std::size_t n);
+
+  Unary exp;
+  Unary log;
+  Unary sin;
+  Unary cos;
+  Unary tan;
+  Unary asin;
+  Unary acos;
+  Unary atan;
+  Unary sqrt;
+  PowArray powArray;
+  PowComplex powComplex;
+  PowReal powReal;
+};
+
+/// Register blocked inner kernel of the complex matrix product. a holds an mr x k panel of the left factor and b a
+/// k x nr panel of the right factor, packed per step p as mr (nr) real parts followed by mr (nr) imaginary parts.
+/// The product is written to tile, real parts first, each in column-major order.
+template <typename T>
+struct GemmKernels {
+  using MicroKernel = void (*)(std::size_t k, const T* a, const T* b, T* tile);
+
+  std::size_t mr;
+  std::size_t nr;
+  MicroKernel microKernel;
+};
+
+/// Horner evaluation of the polynomial c[0] + c[1] z + ... + c[count - 1] z^(count - 1) at n points, count >= 1.
+/// derivative also writes the first derivative.
+template <typename T>
+struct PolynomialKernels {
+  using Evaluate = void (*)(Split<const T> c, std::size_t count, Split<const T> z, Split<T> out, std::size_t n);
+  using Derivative = void (*)(Split<const T> c, std::size_t count, Split<const T> z, Split<T> out,
+                              Split<T> derivative, std::size_t n);
+
+  Evaluate evaluate;
+  Derivative derivative;
+};
+
+/// Conversions between split complex numbers and interleaved integer pairs iq of Q = int8_t or int16_t, which stand
+/// for z = scale * (I + iQ). quantize multiplies by 1 / scale, rounds to the nearest integer, ties to even, and
+/// saturates, NaN becomes 0. multiplyAccumulate adds the products of the dequantized numbers and w to acc.
+template <typename T, typename Q>
+struct QuantizedKernels {
+  using Dequantize = void (*)(const Q* iq, T scale, Split<T> out, std::size_t n);
+  using Quantize = void (*)(Split<const T> z, T inverseScale, Q* iq, std::size_t n);
+  using MultiplyAccumulate = void (*)(const Q* iq, T scale, Split<const T> w, Split<T> acc, std::size_t n);
+
+  Dequantize dequantize;
+  Quantize quantize;
+  MultiplyAccumulate multiplyAccumulate;
+};
+
+/// Compensated reductions of n elements. partial receives the sum and the accumulated rounding error of every chain:
+/// sum the real and the imaginary parts, dot the products re*re, im*im, re*im and im*re of x and y, and squaredNorm
+/// the squares of the real and the imaginary parts. maxAbs returns the index of the first element with the largest
+/// squared magnitude, NaN is skipped, and writes that magnitude to largest, -1 if there is none. slidingDot computes
+/// out[i * outStride] = sum of taps[k] * x[i * inStride + k] over k < m for i < n with plain multiply-adds, the direct
+/// form of an FIR filter with reversed taps.
+template <typename T>
+struct ReductionKernels {
+  using Sum = void (*)(Split<const T> z, std::size_t n, T* partial);
+  using Dot = void (*)(Split<const T> x, Split<const T> y, std::size_t n, T* partial);
+  using MaxAbs = std::size_t (*)(Split<const T> z, std::size_t n, T* largest);
+  using SlidingDot = void (*)(Split<const T> x, std::size_t inStride, Split<const T> taps, std::size_t m,
+                              Split<T> out, std::size_t outStride, std::size_t n);
+
+  Sum sum;
+  Dot dot;
+  Sum squaredNorm;
+  MaxAbs maxAbs;
+  SlidingDot slidingDot;
+};
+
+/// Recurrences of bins of a spectrum over count samples, vectorized over the bins. slidingDft advances the sliding DFT
+/// state[k] = (state[k] + delta[t]) * twiddles[k] for t < count, where delta[t] is the new sample minus the one that
+/// leaves the window, and writes the state after every sample to spectra[t * stride + k] unless spectra.real is null.
+/// goertzel advances s = x[t] + coefficients[k] * s1[k] - s2[k], s2[k] = s1[k], s1[k] = s.
+template <typename T>
+struct SpectralKernels {
+  using SlidingDft = void (*)(Split<T> state, Split<const T> twiddles, std::size_t bins, Split<const T> delta,
+                              std::size_t count, Split<T> spectra, std::size_t stride);
+  using Goertzel = void (*)(Split<T> s1, Split<T> s2, const T* coefficients, std::size_t bins, Split<const T> x,
+                            std::size_t count);
+
+  SlidingDft slidingDft;
+  Goertzel goertzel;
+};
+
+/// Products of a sparse matrix in compressed rows with a vector, the elements of row r are values[k] in column
+/// indices[k] for k in [offsets[r], offsets[r + 1]), and the columns of a row are distinct. gatherRows computes
+/// y[r] = sum of values[k] * x[indices[k]] for r < rows, scatterRows adds values[k] * x[r] to y[indices[k]], which is
+/// the product of the transpose. Index [1] conjugates the values. The block kernels do the same for block rows of
+/// block x block matrices, stored column-major one after the other, whose block columns are indices[k].
+template <typename T>
+struct SparseKernels {
+  using Rows = void (*)(const std::uint32_t* offsets, const std::uint32_t* indices, Split<const T> values,
+                        Split<const T> x, Split<T> y, std::size_t rows);
+  using Blocks = void (*)(const std::uint32_t* offsets, const std::uint32_t* indices, Split<const T> values,
+                          std::size_t block, Split<const T> x, Split<T> y, std::size_t blockRows);
+
+  Rows gatherRows[2];
+  Rows scatterRows[2];
+  Blocks gatherBlocks;
+  Blocks scatterBlocks[2];
+};
+
+template <typename T>
+struct KernelTable {
+  ElementwiseKernels<T> elementwise;
+  TranscendentalKernels<T> transcendental;
+  GemmKernels<T> gemm;
+  PolynomialKernels<T> polynomial;
+  QuantizedKernels<T, std::int8_t> quantized8;
+  QuantizedKernels<T, std::int16_t> quantized16;
+  ReductionKernels<T> reduction;
+  SpectralKernels<T> spectral;
+  SparseKernels<T> sparse;
+};
+
+// clang-format off
+namespace Scalar { template <typename T> const KernelTable<T>& table(); }
+namespace Sse2 { template <typename T> const KernelTable<T>& table(); }
+namespace Avx2 { template <typename T> const KernelTable<T>& table(); }
+namespace Avx512 { template <typename T> const KernelTable<T>& table(); }
+// clang-format on
+
+/// Get the kernels of the active instruction set
+/// @return Kernel table for type T
+template <typename T>
+const KernelTable<T>& table();
+
+}  // namespace Math::Kernels
+
+#endif  // MATH_KERNELS_H
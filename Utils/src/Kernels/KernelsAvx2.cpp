@@ -0,0 +1,16 @@
+#if defined(MATH_SIMD_X86)
+
+#if !(defined(__AVX2__))
+#error "KernelsAvx2.cpp must be compiled with the matching instruction set flags (see CMake/Simd.cmake)"
+#endif
+
+#include "KernelsImpl.h"
+
+namespace Math::Kernels::Avx2 {
+
+template const KernelTable<float>& table<float>();
+template const KernelTable<double>& table<double>();
+
+}  // namespace Math::Kernels::Avx2
+
+#endif
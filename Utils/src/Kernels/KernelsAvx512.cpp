@@ -0,0 +1,16 @@
+#if defined(MATH_SIMD_X86)
+
+#if !(defined(__AVX512F__))
+#error "KernelsAvx512.cpp must be compiled with the matching instruction set flags (see CMake/Simd.cmake)"
+#endif
+
+#include "KernelsImpl.h"
+
+namespace Math::Kernels::Avx512 {
+
+template const KernelTable<float>& table<float>();
+template const KernelTable<double>& table<double>();
+
+}  // namespace Math::Kernels::Avx512
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef MATH_KERNELS_IMPL_H
+#define MATH_KERNELS_IMPL_H
+
+// Included once by every per-ISA translation unit, builds the kernel table of the instruction set it is compiled for.
+
+#include "ElementwiseKernels.h"
+#include "GemmKernels.h"
+#include "Kernels.h"
+#include "PolynomialKernels.h"
+#include "QuantizedKernels.h"
+#include "ReductionKernels.h"
+#include "SparseKernels.h"
+#include "SpectralKernels.h"
+#include "TranscendentalKernels.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+template <typename T>
+const KernelTable<T>& table() {
+  static constexpr KernelTable<T> kernels = {
+      .elementwise = elementwiseKernels<T>(),
+      .transcendental = transcendentalKernels<T>(),
+      .gemm = gemmKernels<T>(),
+      .polynomial = polynomialKernels<T>(),
+      .quantized8 = quantizedKernels<T, std::int8_t>(),
+      .quantized16 = quantizedKernels<T, std::int16_t>(),
+      .reduction = reductionKernels<T>(),
+      .spectral = spectralKernels<T>(),
+      .sparse = sparseKernels<T>(),
+  };
+  return kernels;
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_KERNELS_IMPL_H
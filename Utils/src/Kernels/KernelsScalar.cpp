@@ -0,0 +1,10 @@
+#define MATH_SIMD_FORCE_SCALAR
+#include "KernelsImpl.h"
+
+namespace Math::Kernels::Scalar {
+
+template const KernelTable<float>& table<float>();
+template const KernelTable<double>& table<double>();
+template const KernelTable<long double>& table<long double>();
+
+}  // namespace Math::Kernels::Scalar
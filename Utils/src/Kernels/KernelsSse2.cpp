@@ -0,0 +1,16 @@
+#if defined(MATH_SIMD_X86)
+
+#if !(defined(__SSE2__) || defined(_M_X64))
+#error "KernelsSse2.cpp must be compiled with the matching instruction set flags (see CMake/Simd.cmake)"
+#endif
+
+#include "KernelsImpl.h"
+
+namespace Math::Kernels::Sse2 {
+
+template const KernelTable<float>& table<float>();
+template const KernelTable<double>& table<double>();
+
+}  // namespace Math::Kernels::Sse2
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef MATH_POLYNOMIAL_KERNELS_H
+#define MATH_POLYNOMIAL_KERNELS_H
+
+// Horner evaluation of a complex polynomial at many points, one point per vector lane. Every step p = p z + c
+// depends on the previous one, so the kernel interleaves the recurrences of POLYNOMIAL_PACKS packs of points to hide
+// the latency of the multiply-adds. With that much independent work Estrin's scheme gains no throughput, and Horner
+// keeps the smaller rounding error. The derivative follows the same recurrence, d = d z + p.
+
+#include "ElementwiseKernels.h"
+#include "Kernels.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// Packs of points whose recurrences are interleaved
+constexpr std::size_t POLYNOMIAL_PACKS = 4;
+
+/// One Horner step, p z + c
+template <typename P>
+MATH_SIMD_INLINE CPack<P> hornerStep(const CPack<P> p, const CPack<P> z, const P cr, const P ci) {
+  return {mulAdd(p.re, z.re, negMulAdd(p.im, z.im, cr)), mulAdd(p.re, z.im, mulAdd(p.im, z.re, ci))};
+}
+
+/// Evaluates N packs of points starting at i
+template <typename T, typename P, std::size_t N, bool DERIVATIVE>
+MATH_SIMD_INLINE void horner(const Split<const T> c, const std::size_t count, const Split<const T> z,
+                             const Split<T> out, const Split<T> derivative, const std::size_t i) {
+  CPack<P> x[N];
+  CPack<P> p[N];
+  CPack<P> d[N];
+  unrolled<N>([&](const auto v) {
+    x[v] = ArraySource<T>{z}.template get<P>(i + v * P::width);
+    p[v] = {P(c.real[count - 1]), P(c.imag[count - 1])};
+    d[v] = {P(T(0)), P(T(0))};
+  });
+  for (std::size_t k = count - 1; k-- > 0;) {
+    const P cr(c.real[k]);
+    const P ci(c.imag[k]);
+    unrolled<N>([&](const auto v) {
+      if constexpr (DERIVATIVE) d[v] = hornerStep(d[v], x[v], p[v].re, p[v].im);
+      p[v] = hornerStep(p[v], x[v], cr, ci);
+    });
+  }
+  unrolled<N>([&](const auto v) {
+    store(p[v], out, i + v * P::width);
+    if constexpr (DERIVATIVE) store(d[v], derivative, i + v * P::width);
+  });
+}
+
+template <typename T, bool DERIVATIVE>
+void polynomial(const Split<const T> c, const std::size_t count, const Split<const T> z, const Split<T> out,
+                const Split<T> derivative, const std::size_t n) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t i = 0;
+  for (; i + POLYNOMIAL_PACKS * P::width <= n; i += POLYNOMIAL_PACKS * P::width) {
+    horner<T, P, POLYNOMIAL_PACKS, DERIVATIVE>(c, count, z, out, derivative, i);
+  }
+  for (; i + P::width <= n; i += P::width) horner<T, P, 1, DERIVATIVE>(c, count, z, out, derivative, i);
+  for (; i < n; ++i) horner<T, S, 1, DERIVATIVE>(c, count, z, out, derivative, i);
+}
+
+template <typename T>
+void evaluatePolynomial(const Split<const T> c, const std::size_t count, const Split<const T> z, const Split<T> out,
+                        const std::size_t n) {
+  polynomial<T, false>(c, count, z, out, out, n);
+}
+
+template <typename T>
+void evaluatePolynomialDerivative(const Split<const T> c, const std::size_t count, const Split<const T> z,
+                                  const Split<T> out, const Split<T> derivative, const std::size_t n) {
+  polynomial<T, true>(c, count, z, out, derivative, n);
+}
+
+template <typename T>
+constexpr PolynomialKernels<T> polynomialKernels() {
+  return {
+      .evaluate = evaluatePolynomial<T>,
+      .derivative = evaluatePolynomialDerivative<T>,
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_POLYNOMIAL_KERNELS_H
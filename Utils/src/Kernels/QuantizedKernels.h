@@ -0,0 +1,83 @@
+#ifndef MATH_QUANTIZED_KERNELS_H
+#define MATH_QUANTIZED_KERNELS_H
+
+// Conversions of interleaved int8/int16 I/Q pairs. A pack of pairs is loaded as one integer vector and split into real
+// and imaginary parts with shifts (see SimdPack.h), so the integers are read once and converted without shuffles.
+
+#include <cstdint>
+
+#include "ElementwiseKernels.h"
+#include "Kernels.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// Loads the pack of quantized numbers starting at i and multiplies it by scale
+template <typename P, typename Q>
+MATH_SIMD_INLINE CPack<P> loadQuantized(const Q* iq, const P scale, const std::size_t i) {
+  CPack<P> z;
+  P::loadPairs(iq + 2 * i, z.re, z.im);
+  return {z.re * scale, z.im * scale};
+}
+
+/// Rounds, saturates and stores the pack of numbers starting at i, NaN becomes 0
+template <typename P, typename Q>
+MATH_SIMD_INLINE void storeQuantized(const CPack<P> z, Q* iq, const std::size_t i) {
+  using T = typename P::value_type;
+  const P low(static_cast<T>(Simd::Limits<Q>::min));
+  const P high(static_cast<T>(Simd::Limits<Q>::max));
+  const auto clamp = [&](const P x) { return select(x == x, min(max(x, low), high), P(T(0))); };
+  P::storePairs(iq + 2 * i, clamp(z.re), clamp(z.im));
+}
+
+template <typename T, typename Q>
+void dequantize(const Q* iq, const T scale, const Split<T> out, const std::size_t n) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t i = 0;
+  for (; i + P::width <= n; i += P::width) store(loadQuantized(iq, P(scale), i), out, i);
+  for (; i < n; ++i) store(loadQuantized(iq, S(scale), i), out, i);
+}
+
+template <typename T, typename Q>
+void quantize(const Split<const T> z, const T inverseScale, Q* iq, const std::size_t n) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t i = 0;
+  for (; i + P::width <= n; i += P::width) {
+    storeQuantized(MultiplyOp::apply(ArraySource<T>{z}.template get<P>(i), P(inverseScale)), iq, i);
+  }
+  for (; i < n; ++i) storeQuantized(MultiplyOp::apply(ArraySource<T>{z}.template get<S>(i), S(inverseScale)), iq, i);
+}
+
+/// acc += (scale * iq) * w for one pack
+template <typename T, typename P, typename Q>
+MATH_SIMD_INLINE void multiplyAccumulateStep(const Q* iq, const P scale, const Split<const T> w, const Split<T> acc,
+                                             const std::size_t i) {
+  const CPack<P> z = loadQuantized(iq, scale, i);
+  const CPack<P> x = ArraySource<T>{w}.template get<P>(i);
+  const CPack<P> a = ArraySource<T>{Split<const T>{acc.real, acc.imag}}.template get<P>(i);
+  store(CPack<P>{mulAdd(z.re, x.re, negMulAdd(z.im, x.im, a.re)), mulAdd(z.re, x.im, mulAdd(z.im, x.re, a.im))},
+        acc, i);
+}
+
+template <typename T, typename Q>
+void multiplyAccumulate(const Q* iq, const T scale, const Split<const T> w, const Split<T> acc, const std::size_t n) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t i = 0;
+  for (; i + P::width <= n; i += P::width) multiplyAccumulateStep<T>(iq, P(scale), w, acc, i);
+  for (; i < n; ++i) multiplyAccumulateStep<T>(iq, S(scale), w, acc, i);
+}
+
+template <typename T, typename Q>
+constexpr QuantizedKernels<T, Q> quantizedKernels() {
+  return {
+      .dequantize = dequantize<T, Q>,
+      .quantize = quantize<T, Q>,
+      .multiplyAccumulate = multiplyAccumulate<T, Q>,
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_QUANTIZED_KERNELS_H
@@ -0,0 +1,232 @@
+#ifndef MATH_REDUCTION_KERNELS_H
+#define MATH_REDUCTION_KERNELS_H
+
+// Compensated sums. Every lane keeps a running sum and the sum of its rounding errors, which TwoSum (Knuth) computes
+// exactly with additions only, so the result is as accurate as if it was summed in twice the precision. Products are
+// split into their rounded value and exact error with a fused multiply-add where the instruction set has one (Dot2,
+// Ogita, Rump and Oishi), otherwise only the rounding of the sums is compensated.
+
+#include <cstddef>
+
+#include "ElementwiseKernels.h"
+#include "Kernels.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// Number of independent accumulators per chain in the main loops, which hides the latency of the additions
+constexpr std::size_t REDUCTION_UNROLL = 2;
+
+/// Lane-wise compensated sum
+template <typename P>
+struct Accumulator {
+  P sum;
+  P error;
+
+  MATH_SIMD_INLINE void add(const P x) {
+    const P s = sum + x;
+    const P b = s - sum;
+    error += (sum - (s - b)) + (x - b);
+    sum = s;
+  }
+
+  /// Adds a * b and, with a fused multiply-add, the rounding error of the product
+  MATH_SIMD_INLINE void addProduct(const P a, const P b) {
+    const P p = a * b;
+    if constexpr (P::Traits::FUSED) error += mulSub(a, b, p);
+    add(p);
+  }
+};
+
+/// Folds chain c of the accumulators, the packs lane-wise and then their lanes in order, and writes the sum and the
+/// error to partial
+template <typename P, typename S, std::size_t CHAINS>
+void fold(Accumulator<P> (&packs)[REDUCTION_UNROLL][CHAINS], const Accumulator<S>& single, const std::size_t c,
+          typename P::value_type* partial) {
+  using T = typename P::value_type;
+  Accumulator<P> merged = packs[0][c];
+  for (std::size_t u = 1; u < REDUCTION_UNROLL; ++u) {
+    merged.add(packs[u][c].sum);
+    merged.error += packs[u][c].error;
+  }
+  T sum[P::width];
+  T error[P::width];
+  merged.sum.store(sum);
+  merged.error.store(error);
+  Accumulator<S> total = single;
+  for (std::size_t lane = 0; lane < P::width; ++lane) {
+    total.add(S(sum[lane]));
+    total.error += S(error[lane]);
+  }
+  partial[0] = total.sum.v;
+  partial[1] = total.error.v;
+}
+
+/// Runs step(accumulators, i) over the packs of n elements, with an array of CHAINS compensated sums per element,
+/// and writes the sum and the error of every chain to partial
+template <typename T, std::size_t CHAINS, typename Step>
+void reduce(const std::size_t n, T* partial, Step&& step) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  Accumulator<P> packs[REDUCTION_UNROLL][CHAINS] = {};
+  Accumulator<S> singles[CHAINS] = {};
+  std::size_t i = 0;
+  for (; i + REDUCTION_UNROLL * P::width <= n; i += REDUCTION_UNROLL * P::width) {
+    unrolled<REDUCTION_UNROLL>([&](const auto u) { step(packs[u], i + u * P::width); });
+  }
+  for (; i < n; ++i) step(singles, i);
+  for (std::size_t c = 0; c < CHAINS; ++c) fold(packs, singles[c], c, partial + 2 * c);
+}
+
+template <typename T>
+void sum(const Split<const T> z, const std::size_t n, T* partial) {
+  reduce<T, 2>(n, partial, [&]<typename P>(Accumulator<P>* acc, const std::size_t i) {
+    const CPack<P> a = ArraySource<T>{z}.template get<P>(i);
+    acc[0].add(a.re);
+    acc[1].add(a.im);
+  });
+}
+
+template <typename T>
+void dot(const Split<const T> x, const Split<const T> y, const std::size_t n, T* partial) {
+  reduce<T, 4>(n, partial, [&]<typename P>(Accumulator<P>* acc, const std::size_t i) {
+    const CPack<P> a = ArraySource<T>{x}.template get<P>(i);
+    const CPack<P> b = ArraySource<T>{y}.template get<P>(i);
+    acc[0].addProduct(a.re, b.re);
+    acc[1].addProduct(a.im, b.im);
+    acc[2].addProduct(a.re, b.im);
+    acc[3].addProduct(a.im, b.re);
+  });
+}
+
+template <typename T>
+void squaredNorm(const Split<const T> z, const std::size_t n, T* partial) {
+  reduce<T, 2>(n, partial, [&]<typename P>(Accumulator<P>* acc, const std::size_t i) {
+    const CPack<P> a = ArraySource<T>{z}.template get<P>(i);
+    acc[0].addProduct(a.re, a.re);
+    acc[1].addProduct(a.im, a.im);
+  });
+}
+
+template <typename T>
+std::size_t maxAbs(const Split<const T> z, const std::size_t n, T* largest) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  // Indices are kept as T, which is exact up to 2^24 > MAX_ELEMENT_COUNT
+  T lanes[P::width];
+  for (std::size_t lane = 0; lane < P::width; ++lane) lanes[lane] = T(lane);
+  P index = P::load(lanes);
+  P best(T(-1));
+  P bestIndex;
+  std::size_t i = 0;
+  for (; i + P::width <= n; i += P::width) {
+    const CPack<P> a = ArraySource<T>{z}.template get<P>(i);
+    const P value = mulAdd(a.re, a.re, a.im * a.im);
+    // Strictly larger, so that every lane keeps the first of equal values, and NaN is never taken
+    const typename P::Mask larger = value > best;
+    best = select(larger, value, best);
+    bestIndex = select(larger, index, bestIndex);
+    index += P(T(P::width));
+  }
+  T values[P::width];
+  T indices[P::width];
+  best.store(values);
+  bestIndex.store(indices);
+  T result = T(-1);
+  std::size_t resultIndex = 0;
+  for (std::size_t lane = 0; lane < P::width; ++lane) {
+    const auto laneIndex = static_cast<std::size_t>(indices[lane]);
+    if (values[lane] > result || (values[lane] == result && laneIndex < resultIndex)) {
+      result = values[lane];
+      resultIndex = laneIndex;
+    }
+  }
+  for (; i < n; ++i) {
+    const CPack<S> a = ArraySource<T>{z}.template get<S>(i);
+    const T value = mulAdd(a.re, a.re, a.im * a.im).v;
+    if (value > result) {
+      result = value;
+      resultIndex = i;
+    }
+  }
+  *largest = result;
+  return resultIndex;
+}
+
+/// Dot products of the taps with BLOCK packs of consecutive windows of x starting at i. The taps are broadcast and the
+/// outputs stay in registers, so every tap is loaded once per block.
+template <typename T, typename P, std::size_t BLOCK>
+MATH_SIMD_INLINE void slidingBlock(const Split<const T> x, const Split<const T> taps, const std::size_t m,
+                                   const Split<T> out, const std::size_t i) {
+  CPack<P> acc[BLOCK] = {};
+  for (std::size_t k = 0; k < m; ++k) {
+    const P tr(taps.real[k]);
+    const P ti(taps.imag[k]);
+    unrolled<BLOCK>([&](const auto b) {
+      const CPack<P> a = ArraySource<T>{x}.template get<P>(i + b * P::width + k);
+      acc[b] = {mulAdd(tr, a.re, negMulAdd(ti, a.im, acc[b].re)), mulAdd(tr, a.im, mulAdd(ti, a.re, acc[b].im))};
+    });
+  }
+  unrolled<BLOCK>([&](const auto b) { store(acc[b], out, i + b * P::width); });
+}
+
+/// Dot product of the taps with the window of x at offset, vectorized over the taps
+template <typename T>
+void slidingWindow(const Split<const T> x, const std::size_t offset, const Split<const T> taps, const std::size_t m,
+                   T& re, T& im) {
+  using P = Simd::Native<T>;
+  CPack<P> acc;
+  std::size_t k = 0;
+  for (; k + P::width <= m; k += P::width) {
+    const CPack<P> a = ArraySource<T>{taps}.template get<P>(k);
+    const CPack<P> b = ArraySource<T>{x}.template get<P>(offset + k);
+    acc = {mulAdd(a.re, b.re, negMulAdd(a.im, b.im, acc.re)), mulAdd(a.re, b.im, mulAdd(a.im, b.re, acc.im))};
+  }
+  T real[P::width];
+  T imag[P::width];
+  acc.re.store(real);
+  acc.im.store(imag);
+  re = 0;
+  im = 0;
+  for (std::size_t lane = 0; lane < P::width; ++lane) {
+    re += real[lane];
+    im += imag[lane];
+  }
+  for (; k < m; ++k) {
+    const T ar = taps.real[k];
+    const T ai = taps.imag[k];
+    const T br = x.real[offset + k];
+    const T bi = x.imag[offset + k];
+    re += ar * br - ai * bi;
+    im += ar * bi + ai * br;
+  }
+}
+
+template <typename T>
+void slidingDot(const Split<const T> x, const std::size_t inStride, const Split<const T> taps, const std::size_t m,
+                const Split<T> out, const std::size_t outStride, const std::size_t n) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  constexpr std::size_t BLOCK = 4;
+  std::size_t i = 0;
+  if (inStride == 1 && outStride == 1) {
+    for (; i + BLOCK * P::width <= n; i += BLOCK * P::width) slidingBlock<T, P, BLOCK>(x, taps, m, out, i);
+    for (; i + P::width <= n; i += P::width) slidingBlock<T, P, 1>(x, taps, m, out, i);
+    for (; i < n; ++i) slidingBlock<T, S, 1>(x, taps, m, out, i);
+  }
+  for (; i < n; ++i) slidingWindow(x, i * inStride, taps, m, out.real[i * outStride], out.imag[i * outStride]);
+}
+
+template <typename T>
+constexpr ReductionKernels<T> reductionKernels() {
+  return {
+      .sum = sum<T>,
+      .dot = dot<T>,
+      .squaredNorm = squaredNorm<T>,
+      .maxAbs = maxAbs<T>,
+      .slidingDot = slidingDot<T>,
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_REDUCTION_KERNELS_H
@@ -0,0 +1,215 @@
+#ifndef MATH_SPARSE_KERNELS_H
+#define MATH_SPARSE_KERNELS_H
+
+// Products of compressed sparse matrices with vectors. The products are limited by the bandwidth of the values and
+// indices, which are read once, so the kernels stream them with full width loads and gather or scatter the vector
+// elements they refer to. The rows of a matrix are usually short, so the remainder of every row runs in single lanes
+// instead of masked packs.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ElementwiseKernels.h"
+#include "Kernels.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// @return acc + a * b, or acc + conj(a) * b
+template <bool CONJUGATE, typename P>
+MATH_SIMD_INLINE CPack<P> multiplyAdd(const CPack<P> a, const CPack<P> b, const CPack<P> acc) {
+  if constexpr (CONJUGATE) {
+    return {mulAdd(a.re, b.re, mulAdd(a.im, b.im, acc.re)), mulAdd(a.re, b.im, negMulAdd(a.im, b.re, acc.im))};
+  } else {
+    return {mulAdd(a.re, b.re, negMulAdd(a.im, b.im, acc.re)), mulAdd(a.re, b.im, mulAdd(a.im, b.re, acc.im))};
+  }
+}
+
+/// @return Elements z[indices[i]] of a split array
+template <typename P>
+MATH_SIMD_INLINE CPack<P> gather(const Split<const typename P::value_type> z, const std::uint32_t* indices) {
+  return {P::gather(z.real, indices), P::gather(z.imag, indices)};
+}
+
+/// @return Sum of the lanes of a pack
+template <typename P>
+MATH_SIMD_INLINE typename P::value_type laneSum(const P p) {
+  using T = typename P::value_type;
+  T lanes[P::width];
+  p.store(lanes);
+  T sum = 0;
+  for (std::size_t lane = 0; lane < P::width; ++lane) sum += lanes[lane];
+  return sum;
+}
+
+template <typename T, bool CONJUGATE>
+void gatherRows(const std::uint32_t* offsets, const std::uint32_t* indices, const Split<const T> values,
+                const Split<const T> x, const Split<T> y, const std::size_t rows) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  for (std::size_t r = 0; r < rows; ++r) {
+    std::size_t k = offsets[r];
+    const std::size_t end = offsets[r + 1];
+    CPack<S> sum;
+    if (end - k >= P::width) {
+      CPack<P> acc;
+      for (; k + P::width <= end; k += P::width) {
+        acc = multiplyAdd<CONJUGATE>(ArraySource<T>{values}.template get<P>(k), gather<P>(x, indices + k), acc);
+      }
+      sum = {S(laneSum(acc.re)), S(laneSum(acc.im))};
+    }
+    for (; k < end; ++k) {
+      sum = multiplyAdd<CONJUGATE>(ArraySource<T>{values}.template get<S>(k), gather<S>(x, indices + k), sum);
+    }
+    store(sum, y, r);
+  }
+}
+
+template <typename T, bool CONJUGATE>
+void scatterRows(const std::uint32_t* offsets, const std::uint32_t* indices, const Split<const T> values,
+                 const Split<const T> x, const Split<T> y, const std::size_t rows) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  const Split<const T> out = {y.real, y.imag};
+  for (std::size_t r = 0; r < rows; ++r) {
+    std::size_t k = offsets[r];
+    const std::size_t end = offsets[r + 1];
+    const CPack<P> xp = {P(x.real[r]), P(x.imag[r])};
+    for (; k + P::width <= end; k += P::width) {
+      const CPack<P> sum =
+          multiplyAdd<CONJUGATE>(ArraySource<T>{values}.template get<P>(k), xp, gather<P>(out, indices + k));
+      sum.re.scatter(y.real, indices + k);
+      sum.im.scatter(y.imag, indices + k);
+    }
+    const CPack<S> xs = {S(x.real[r]), S(x.imag[r])};
+    for (; k < end; ++k) {
+      store(multiplyAdd<CONJUGATE>(ArraySource<T>{values}.template get<S>(k), xs, gather<S>(out, indices + k)), y,
+            indices[k]);
+    }
+  }
+}
+
+/// Rows [i, i + P::width) of the products of the blocks of block row r with x
+template <typename T, typename P>
+MATH_SIMD_INLINE void gatherBlockLanes(const std::uint32_t* offsets, const std::uint32_t* indices,
+                                       const Split<const T> values, const std::size_t block, const Split<const T> x,
+                                       const Split<T> y, const std::size_t r, const std::size_t i) {
+  CPack<P> acc;
+  for (std::size_t k = offsets[r]; k < offsets[r + 1]; ++k) {
+    const std::size_t column = std::size_t(indices[k]) * block;
+    for (std::size_t j = 0; j < block; ++j) {
+      const CPack<P> xj = {P(x.real[column + j]), P(x.imag[column + j])};
+      acc = multiplyAdd<false>(ArraySource<T>{values}.template get<P>((k * block + j) * block + i), xj, acc);
+    }
+  }
+  store(acc, y, r * block + i);
+}
+
+/// Block rows with blocks of BLOCK rows, whose rows are independent multiply-add chains
+template <typename T, std::size_t BLOCK>
+void gatherSmallBlocks(const std::uint32_t* offsets, const std::uint32_t* indices, const Split<const T> values,
+                       const Split<const T> x, const Split<T> y, const std::size_t blockRows) {
+  using S = Simd::Single<T>;
+  for (std::size_t r = 0; r < blockRows; ++r) {
+    CPack<S> acc[BLOCK] = {};
+    for (std::size_t k = offsets[r]; k < offsets[r + 1]; ++k) {
+      const std::size_t column = std::size_t(indices[k]) * BLOCK;
+      unrolled<BLOCK>([&](const auto j) {
+        const CPack<S> xj = {S(x.real[column + j]), S(x.imag[column + j])};
+        unrolled<BLOCK>([&](const auto i) {
+          acc[i] = multiplyAdd<false>(ArraySource<T>{values}.template get<S>((k * BLOCK + j) * BLOCK + i), xj, acc[i]);
+        });
+      });
+    }
+    unrolled<BLOCK>([&](const auto i) { store(acc[i], y, r * BLOCK + i); });
+  }
+}
+
+template <typename T>
+void gatherBlocks(const std::uint32_t* offsets, const std::uint32_t* indices, const Split<const T> values,
+                  const std::size_t block, const Split<const T> x, const Split<T> y, const std::size_t blockRows) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  switch (block) {
+    case 2: return gatherSmallBlocks<T, 2>(offsets, indices, values, x, y, blockRows);
+    case 3: return gatherSmallBlocks<T, 3>(offsets, indices, values, x, y, blockRows);
+    case 4: return gatherSmallBlocks<T, 4>(offsets, indices, values, x, y, blockRows);
+    default: break;
+  }
+  for (std::size_t r = 0; r < blockRows; ++r) {
+    std::size_t i = 0;
+    for (; i + P::width <= block; i += P::width) gatherBlockLanes<T, P>(offsets, indices, values, block, x, y, r, i);
+    for (; i < block; ++i) gatherBlockLanes<T, S>(offsets, indices, values, block, x, y, r, i);
+  }
+}
+
+/// Transposed products of block rows with blocks of BLOCK columns, whose columns are independent multiply-add chains
+template <typename T, std::size_t BLOCK, bool CONJUGATE>
+void scatterSmallBlocks(const std::uint32_t* offsets, const std::uint32_t* indices, const Split<const T> values,
+                        const Split<const T> x, const Split<T> y, const std::size_t blockRows) {
+  using S = Simd::Single<T>;
+  for (std::size_t r = 0; r < blockRows; ++r) {
+    CPack<S> xr[BLOCK];
+    unrolled<BLOCK>([&](const auto i) { xr[i] = ArraySource<T>{x}.template get<S>(r * BLOCK + i); });
+    for (std::size_t k = offsets[r]; k < offsets[r + 1]; ++k) {
+      const std::size_t column = std::size_t(indices[k]) * BLOCK;
+      unrolled<BLOCK>([&](const auto j) {
+        CPack<S> sum = {S(y.real[column + j]), S(y.imag[column + j])};
+        unrolled<BLOCK>([&](const auto i) {
+          sum = multiplyAdd<CONJUGATE>(ArraySource<T>{values}.template get<S>((k * BLOCK + j) * BLOCK + i), xr[i], sum);
+        });
+        store(sum, y, column + j);
+      });
+    }
+  }
+}
+
+template <typename T, bool CONJUGATE>
+void scatterBlocks(const std::uint32_t* offsets, const std::uint32_t* indices, const Split<const T> values,
+                   const std::size_t block, const Split<const T> x, const Split<T> y, const std::size_t blockRows) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  switch (block) {
+    case 2: return scatterSmallBlocks<T, 2, CONJUGATE>(offsets, indices, values, x, y, blockRows);
+    case 3: return scatterSmallBlocks<T, 3, CONJUGATE>(offsets, indices, values, x, y, blockRows);
+    case 4: return scatterSmallBlocks<T, 4, CONJUGATE>(offsets, indices, values, x, y, blockRows);
+    default: break;
+  }
+  for (std::size_t r = 0; r < blockRows; ++r) {
+    const Split<const T> xr = {x.real + r * block, x.imag + r * block};
+    for (std::size_t k = offsets[r]; k < offsets[r + 1]; ++k) {
+      const std::size_t column = std::size_t(indices[k]) * block;
+      for (std::size_t j = 0; j < block; ++j) {
+        const Split<const T> a = {values.real + (k * block + j) * block, values.imag + (k * block + j) * block};
+        std::size_t i = 0;
+        CPack<S> sum = {S(y.real[column + j]), S(y.imag[column + j])};
+        if (block >= P::width) {
+          CPack<P> acc;
+          for (; i + P::width <= block; i += P::width) {
+            acc = multiplyAdd<CONJUGATE>(ArraySource<T>{a}.template get<P>(i), ArraySource<T>{xr}.template get<P>(i),
+                                         acc);
+          }
+          sum = {sum.re + S(laneSum(acc.re)), sum.im + S(laneSum(acc.im))};
+        }
+        for (; i < block; ++i) {
+          sum = multiplyAdd<CONJUGATE>(ArraySource<T>{a}.template get<S>(i), ArraySource<T>{xr}.template get<S>(i),
+                                       sum);
+        }
+        store(sum, y, column + j);
+      }
+    }
+  }
+}
+
+template <typename T>
+constexpr SparseKernels<T> sparseKernels() {
+  return {
+      .gatherRows = {gatherRows<T, false>, gatherRows<T, true>},
+      .scatterRows = {scatterRows<T, false>, scatterRows<T, true>},
+      .gatherBlocks = gatherBlocks<T>,
+      .scatterBlocks = {scatterBlocks<T, false>, scatterBlocks<T, true>},
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_SPARSE_KERNELS_H
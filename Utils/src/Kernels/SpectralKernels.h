@@ -0,0 +1,117 @@
+#ifndef MATH_SPECTRAL_KERNELS_H
+#define MATH_SPECTRAL_KERNELS_H
+
+// Banks of single bin recurrences, one bin per vector lane. Every sample of a block is one step of the recurrences
+// of all bins, and each step depends on the previous one, so the kernels keep SPECTRAL_PACKS packs of bins in
+// registers and run them through the whole block before they load the next ones: the samples are broadcast, and the
+// states are read and written once per block instead of once per sample.
+
+#include <cstddef>
+#include <utility>
+
+#include "ElementwiseKernels.h"
+#include "Kernels.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// Packs of bins whose recurrences are interleaved
+constexpr std::size_t SPECTRAL_PACKS = 4;
+
+/// Advances N packs of sliding DFT bins starting at k through count samples
+template <typename T, typename P, std::size_t N>
+MATH_SIMD_INLINE void slidingDftBins(const Split<T> state, const Split<const T> twiddles, const Split<const T> delta,
+                                     const std::size_t count, const Split<T> spectra, const std::size_t stride,
+                                     const std::size_t k) {
+  CPack<P> s[N];
+  CPack<P> w[N];
+  unrolled<N>([&](const auto v) {
+    s[v] = ArraySource<T>{{state.real, state.imag}}.template get<P>(k + v * P::width);
+    w[v] = ArraySource<T>{twiddles}.template get<P>(k + v * P::width);
+  });
+  for (std::size_t t = 0; t < count; ++t) {
+    const P dr(delta.real[t]);
+    const P di(delta.imag[t]);
+    unrolled<N>([&](const auto v) {
+      s[v] = MultiplyOp::apply(CPack<P>{s[v].re + dr, s[v].im + di}, w[v]);
+      if (spectra.real != nullptr) store(s[v], spectra, t * stride + k + v * P::width);
+    });
+  }
+  unrolled<N>([&](const auto v) { store(s[v], state, k + v * P::width); });
+}
+
+template <typename T>
+void slidingDft(const Split<T> state, const Split<const T> twiddles, const std::size_t bins,
+                const Split<const T> delta, const std::size_t count, const Split<T> spectra,
+                const std::size_t stride) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t k = 0;
+  for (; k + SPECTRAL_PACKS * P::width <= bins; k += SPECTRAL_PACKS * P::width) {
+    slidingDftBins<T, P, SPECTRAL_PACKS>(state, twiddles, delta, count, spectra, stride, k);
+  }
+  for (; k + P::width <= bins; k += P::width) {
+    slidingDftBins<T, P, 1>(state, twiddles, delta, count, spectra, stride, k);
+  }
+  for (; k < bins; ++k) slidingDftBins<T, S, 1>(state, twiddles, delta, count, spectra, stride, k);
+}
+
+/// Advances N packs of Goertzel bins starting at k through count samples
+template <typename T, typename P, std::size_t N>
+MATH_SIMD_INLINE void goertzelBins(const Split<T> s1, const Split<T> s2, const T* coefficients,
+                                   const Split<const T> x, const std::size_t count, const std::size_t k) {
+  CPack<P> a[N];
+  CPack<P> b[N];
+  P c[N];
+  unrolled<N>([&](const auto v) {
+    a[v] = ArraySource<T>{{s1.real, s1.imag}}.template get<P>(k + v * P::width);
+    b[v] = ArraySource<T>{{s2.real, s2.imag}}.template get<P>(k + v * P::width);
+    c[v] = P::load(coefficients + k + v * P::width);
+  });
+  // Two samples per iteration, so that the states swap roles instead of being moved: b <- c a + x - b, then
+  // a <- c b + x - a
+  const auto step = [&](CPack<P>(&older)[N], const CPack<P>(&newer)[N], const std::size_t t) {
+    const P xr(x.real[t]);
+    const P xi(x.imag[t]);
+    unrolled<N>([&](const auto v) {
+      older[v] = {mulAdd(c[v], newer[v].re, xr - older[v].re), mulAdd(c[v], newer[v].im, xi - older[v].im)};
+    });
+  };
+  std::size_t t = 0;
+  for (; t + 2 <= count; t += 2) {
+    step(b, a, t);
+    step(a, b, t + 1);
+  }
+  if (t < count) {
+    step(b, a, t);
+    unrolled<N>([&](const auto v) { std::swap(a[v], b[v]); });
+  }
+  unrolled<N>([&](const auto v) {
+    store(a[v], s1, k + v * P::width);
+    store(b[v], s2, k + v * P::width);
+  });
+}
+
+template <typename T>
+void goertzel(const Split<T> s1, const Split<T> s2, const T* coefficients, const std::size_t bins,
+              const Split<const T> x, const std::size_t count) {
+  using P = Simd::Native<T>;
+  using S = Simd::Single<T>;
+  std::size_t k = 0;
+  for (; k + SPECTRAL_PACKS * P::width <= bins; k += SPECTRAL_PACKS * P::width) {
+    goertzelBins<T, P, SPECTRAL_PACKS>(s1, s2, coefficients, x, count, k);
+  }
+  for (; k + P::width <= bins; k += P::width) goertzelBins<T, P, 1>(s1, s2, coefficients, x, count, k);
+  for (; k < bins; ++k) goertzelBins<T, S, 1>(s1, s2, coefficients, x, count, k);
+}
+
+template <typename T>
+constexpr SpectralKernels<T> spectralKernels() {
+  return {
+      .slidingDft = slidingDft<T>,
+      .goertzel = goertzel<T>,
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_SPECTRAL_KERNELS_H
@@ -0,0 +1,214 @@
+#ifndef MATH_TRANSCENDENTAL_KERNELS_H
+#define MATH_TRANSCENDENTAL_KERNELS_H
+
+// Elementary functions of split complex arrays. The formulas are the ones of the scalar functions in Complex.h,
+// evaluated with the pack primitives of SimdMath.h. Sine and cosine of the real part and the hyperbolic functions of
+// the imaginary part are computed in pairs from one range reduction each.
+
+#include "ElementwiseKernels.h"
+#include "Kernels.h"
+#include "SimdMath.h"
+
+namespace Math::Kernels::MATH_SIMD_TARGET {
+
+/// @return e^z
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexExp(const CPack<P> z) {
+  using T = typename P::value_type;
+  const P magnitude = exp(z.re);
+  P s(T(0));
+  P c(T(0));
+  sincos(z.im, s, c);
+  return {magnitude * c, magnitude * s};
+}
+
+/// @return Principal value of ln(z)
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexLog(const CPack<P> z) {
+  using T = typename P::value_type;
+  // Very large and very small numbers are scaled by 2^-k so that |z|^2 neither overflows nor underflows
+  constexpr bool IS_DOUBLE = sizeof(T) == sizeof(double);
+  const P m = max(abs(z.re), abs(z.im));
+  const P k = select(P(IS_DOUBLE ? T(0x1p500) : T(0x1p60F)) < m, P(IS_DOUBLE ? T(600) : T(70)),
+                     select(m < P(IS_DOUBLE ? T(0x1p-500) : T(0x1p-60F)), P(IS_DOUBLE ? T(-600) : T(-90)), P(T(0))));
+  const P scale = pow2(-k);
+  const P x = z.re * scale;
+  const P y = z.im * scale;
+  return {mulAdd(k, P(T(0.69314718055994530942)), P(T(0.5)) * log(mulAdd(x, x, y * y))), atan2(z.im, z.re)};
+}
+
+/// @return Principal square root of z, computed without cancellation in the real or imaginary part
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexSqrt(const CPack<P> z) {
+  using T = typename P::value_type;
+  const P r = sqrt(mulAdd(z.re, z.re, z.im * z.im));
+  const P t = sqrt(P(T(0.5)) * (r + abs(z.re)));
+  const P q = select(t == P(T(0)), P(T(0)), z.im / (t + t));
+  const typename P::Mask negative = z.re < P(T(0));
+  return {select(negative, abs(q), t), select(negative, select(z.im < P(T(0)), -t, t), q)};
+}
+
+/// @return sin(z)
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexSin(const CPack<P> z) {
+  using T = typename P::value_type;
+  P s(T(0));
+  P c(T(0));
+  P sh(T(0));
+  P ch(T(0));
+  sincos(z.re, s, c);
+  sinhcosh(z.im, sh, ch);
+  return {s * ch, c * sh};
+}
+
+/// @return cos(z)
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexCos(const CPack<P> z) {
+  using T = typename P::value_type;
+  P s(T(0));
+  P c(T(0));
+  P sh(T(0));
+  P ch(T(0));
+  sincos(z.re, s, c);
+  sinhcosh(z.im, sh, ch);
+  return {c * ch, -(s * sh)};
+}
+
+/// @return tan(z) = (sin(2x) + i sinh(2y)) / (cos(2x) + cosh(2y))
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexTan(const CPack<P> z) {
+  using T = typename P::value_type;
+  P s(T(0));
+  P c(T(0));
+  P sh(T(0));
+  P ch(T(0));
+  sincos(z.re + z.re, s, c);
+  sinhcosh(z.im + z.im, sh, ch);
+  const P div = c + ch;
+  // tanh(2y) rounds to +-1 long before sinh(2y) and cosh(2y) overflow
+  const P im = select(P(T(20)) < abs(z.im), copysign(P(T(1)), z.im), sh / div);
+  return {s / div, im};
+}
+
+/// @return asin(z) = -i ln(iz + sqrt(1 - z^2))
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexAsin(const CPack<P> z) {
+  using T = typename P::value_type;
+  const CPack<P> w = MultiplyOp::apply(z, z);
+  const CPack<P> t = complexSqrt(CPack<P>{P(T(1)) - w.re, -w.im});
+  const CPack<P> l = complexLog(CPack<P>{t.re - z.im, t.im + z.re});
+  return {l.im, -l.re};
+}
+
+/// @return acos(z) = -i ln(z + sqrt(z^2 - 1))
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexAcos(const CPack<P> z) {
+  using T = typename P::value_type;
+  const CPack<P> w = MultiplyOp::apply(z, z);
+  const CPack<P> t = complexSqrt(CPack<P>{w.re - P(T(1)), w.im});
+  const CPack<P> l = complexLog(CPack<P>{z.re + t.re, z.im + t.im});
+  return {l.im, -l.re};
+}
+
+/// @return atan(z) = i/2 (ln(1 - iz) - ln(1 + iz))
+template <typename P>
+MATH_SIMD_INLINE CPack<P> complexAtan(const CPack<P> z) {
+  using T = typename P::value_type;
+  const CPack<P> a = complexLog(CPack<P>{P(T(1)) + z.im, -z.re});
+  const CPack<P> b = complexLog(CPack<P>{P(T(1)) - z.im, z.re});
+  return {P(T(-0.5)) * (a.im - b.im), P(T(0.5)) * (a.re - b.re)};
+}
+
+/// z^w = e^(w ln(z)) with a complex or real exponent
+struct PowOp {
+  template <typename P>
+  MATH_SIMD_INLINE static CPack<P> apply(const CPack<P> z, const CPack<P> w) {
+    return complexExp(MultiplyOp::apply(w, complexLog(z)));
+  }
+  template <typename P>
+  MATH_SIMD_INLINE static CPack<P> apply(const CPack<P> z, const P w) {
+    return complexExp(MultiplyOp::apply(w, complexLog(z)));
+  }
+};
+
+template <typename T>
+void exp(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexExp(a); });
+}
+
+template <typename T>
+void log(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexLog(a); });
+}
+
+template <typename T>
+void sin(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexSin(a); });
+}
+
+template <typename T>
+void cos(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexCos(a); });
+}
+
+template <typename T>
+void tan(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexTan(a); });
+}
+
+template <typename T>
+void asin(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexAsin(a); });
+}
+
+template <typename T>
+void acos(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexAcos(a); });
+}
+
+template <typename T>
+void atan(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexAtan(a); });
+}
+
+template <typename T>
+void sqrt(const Split<const T> z, const Split<T> out, const std::size_t n) {
+  mapComplex(z, out, n, [](const auto a) { return complexSqrt(a); });
+}
+
+template <typename T>
+void powArray(const Split<const T> z, const Split<const T> w, const Split<T> out, const std::size_t n) {
+  binary<T, PowOp>(ArraySource<T>{z}, ArraySource<T>{w}, out, n);
+}
+
+template <typename T>
+void powComplex(const Split<const T> z, const T wReal, const T wImag, const Split<T> out, const std::size_t n) {
+  binary<T, PowOp>(ArraySource<T>{z}, ComplexSource<T>{wReal, wImag}, out, n);
+}
+
+template <typename T>
+void powReal(const Split<const T> z, const T w, const Split<T> out, const std::size_t n) {
+  binary<T, PowOp>(ArraySource<T>{z}, RealSource<T>{w}, out, n);
+}
+
+template <typename T>
+constexpr TranscendentalKernels<T> transcendentalKernels() {
+  return {
+      .exp = exp<T>,
+      .log = log<T>,
+      .sin = sin<T>,
+      .cos = cos<T>,
+      .tan = tan<T>,
+      .asin = asin<T>,
+      .acos = acos<T>,
+      .atan = atan<T>,
+      .sqrt = sqrt<T>,
+      .powArray = powArray<T>,
+      .powComplex = powComplex<T>,
+      .powReal = powReal<T>,
+  };
+}
+
+}  // namespace Math::Kernels::MATH_SIMD_TARGET
+
+#endif  // MATH_TRANSCENDENTAL_KERNELS_H
@@ -0,0 +1,208 @@
+#include "MemoryResource.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace Math {
+
+namespace {
+
+/// Largest alignment that blocks of the pool provide, chunks are aligned to at most one page
+constexpr std::size_t POOL_MAX_ALIGNMENT = 4096;
+
+/// Size of the chunks that are split into blocks of one size class, unless the blocks are larger
+constexpr std::size_t POOL_CHUNK_SIZE = std::size_t(1) << 16;
+
+/// Granularity of the placement of memory on NUMA nodes, the smallest page size of the supported platforms
+constexpr std::size_t PAGE_SIZE = 4096;
+
+std::size_t roundUp(const std::size_t n, const std::size_t multiple) {
+  return (n + multiple - 1) / multiple * multiple;
+}
+
+}  // namespace
+
+/// Create an empty arena, the first chunk is allocated on first use
+/// @param initialSize Size of the first chunk in bytes
+/// @param upstream Resource that provides the chunks
+ArenaResource::ArenaResource(const std::size_t initialSize, std::pmr::memory_resource* upstream)
+    : m_Upstream(upstream), m_NextChunkSize(roundUp(std::max<std::size_t>(initialSize, 1), MEMORY_ALIGNMENT)) {}
+
+ArenaResource::~ArenaResource() {
+  releaseChunks();
+}
+
+void ArenaResource::addChunk(const std::size_t minimumSize) {
+  const std::size_t size = std::max(m_NextChunkSize, roundUp(minimumSize, MEMORY_ALIGNMENT));
+  m_Chunks.reserve(m_Chunks.size() + 1);
+  std::byte* data = static_cast<std::byte*>(m_Upstream->allocate(size, MEMORY_ALIGNMENT));
+  m_Chunks.push_back({data, size});
+  m_Current = data;
+  m_End = data + size;
+  // Chunks grow geometrically, so that the number of upstream allocations is logarithmic in the capacity
+  m_NextChunkSize = 2 * size;
+}
+
+void ArenaResource::releaseChunks() noexcept {
+  for (const Chunk& chunk : m_Chunks) m_Upstream->deallocate(chunk.data, chunk.size, MEMORY_ALIGNMENT);
+  m_Chunks.clear();
+  m_Current = nullptr;
+  m_End = nullptr;
+}
+
+void* ArenaResource::do_allocate(const std::size_t bytes, std::size_t alignment) {
+  alignment = std::max(alignment, MEMORY_ALIGNMENT);
+  const auto fits = [&] {
+    if (m_Current == nullptr) return false;
+    const std::size_t padding = -reinterpret_cast<std::uintptr_t>(m_Current) & (alignment - 1);
+    return padding <= std::size_t(m_End - m_Current) && bytes <= std::size_t(m_End - m_Current) - padding;
+  };
+  if (!fits()) addChunk(bytes + alignment - MEMORY_ALIGNMENT);
+  std::byte* block = m_Current + (-reinterpret_cast<std::uintptr_t>(m_Current) & (alignment - 1));
+  m_Current = block + roundUp(bytes, MEMORY_ALIGNMENT);
+  return block;
+}
+
+void ArenaResource::do_deallocate(void* /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) {}
+
+bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+/// Invalidates all blocks and makes the capacity available for new allocations. If the arena grew since the last
+/// reset, its chunks are replaced by a single chunk of the total capacity.
+void ArenaResource::reset() {
+  if (m_Chunks.size() > 1) {
+    const std::size_t total = capacity();
+    releaseChunks();
+    m_NextChunkSize = total;
+    addChunk(total);
+  } else if (!m_Chunks.empty()) {
+    m_Current = m_Chunks.front().data;
+  }
+}
+
+/// Invalidates all blocks and returns all chunks to the upstream resource
+void ArenaResource::release() noexcept {
+  releaseChunks();
+}
+
+/// @return Total size of the chunks in bytes
+std::size_t ArenaResource::capacity() const {
+  std::size_t total = 0;
+  for (const Chunk& chunk : m_Chunks) total += chunk.size;
+  return total;
+}
+
+/// @return Bytes handed out since the last reset, including alignment padding
+std::size_t ArenaResource::used() const {
+  if (m_Chunks.empty()) return 0;
+  // All chunks but the last one are exhausted, their unused tails count as padding
+  return capacity() - std::size_t(m_End - m_Current);
+}
+
+/// Create an empty pool
+/// @param largestBlock Largest size in bytes that is served from the pool, rounded up to a power of two
+/// @param upstream Resource that provides the chunks of the pool and the blocks that are too large for it
+PoolResource::PoolResource(const std::size_t largestBlock, std::pmr::memory_resource* upstream)
+    : m_Upstream(upstream), m_LargestBlock(std::bit_ceil(std::max(largestBlock, MEMORY_ALIGNMENT))) {
+  m_FreeLists.resize(std::countr_zero(m_LargestBlock) - std::countr_zero(MEMORY_ALIGNMENT) + 1, nullptr);
+}
+
+PoolResource::~PoolResource() {
+  release();
+}
+
+/// @return Index of the free list that serves a request, or the number of free lists for upstream requests
+std::size_t PoolResource::sizeClass(const std::size_t bytes, const std::size_t alignment) const {
+  if (alignment > POOL_MAX_ALIGNMENT || bytes > m_LargestBlock) return m_FreeLists.size();
+  const std::size_t size = std::bit_ceil(std::max({bytes, alignment, MEMORY_ALIGNMENT}));
+  return std::countr_zero(size) - std::countr_zero(MEMORY_ALIGNMENT);
+}
+
+/// Splits a new chunk into blocks of a size class and pushes them onto its free list
+void PoolResource::refill(const std::size_t sizeClass) {
+  const std::size_t blockSize = MEMORY_ALIGNMENT << sizeClass;
+  const std::size_t chunkSize = std::max(blockSize, POOL_CHUNK_SIZE);
+  const std::size_t alignment = std::min(blockSize, POOL_MAX_ALIGNMENT);
+  m_Chunks.reserve(m_Chunks.size() + 1);
+  std::byte* data = static_cast<std::byte*>(m_Upstream->allocate(chunkSize, alignment));
+  m_Chunks.push_back({data, chunkSize, alignment});
+  FreeBlock* head = m_FreeLists[sizeClass];
+  for (std::size_t offset = chunkSize; offset >= blockSize; offset -= blockSize) {
+    head = ::new (data + offset - blockSize) FreeBlock{head};
+  }
+  m_FreeLists[sizeClass] = head;
+}
+
+void* PoolResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+  const std::size_t index = sizeClass(bytes, alignment);
+  if (index == m_FreeLists.size()) return m_Upstream->allocate(bytes, std::max(alignment, MEMORY_ALIGNMENT));
+  const std::lock_guard lock(m_Mutex);
+  if (m_FreeLists[index] == nullptr) refill(index);
+  FreeBlock* block = m_FreeLists[index];
+  m_FreeLists[index] = block->next;
+  return block;
+}
+
+void PoolResource::do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) {
+  const std::size_t index = sizeClass(bytes, alignment);
+  if (index == m_FreeLists.size()) {
+    m_Upstream->deallocate(p, bytes, std::max(alignment, MEMORY_ALIGNMENT));
+    return;
+  }
+  const std::lock_guard lock(m_Mutex);
+  m_FreeLists[index] = ::new (p) FreeBlock{m_FreeLists[index]};
+}
+
+bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+/// Returns all chunks to the upstream resource. Blocks that are still in use become invalid, blocks larger than
+/// largestBlock() are not affected.
+void PoolResource::release() noexcept {
+  const std::lock_guard lock(m_Mutex);
+  for (const Chunk& chunk : m_Chunks) m_Upstream->deallocate(chunk.data, chunk.size, chunk.alignment);
+  m_Chunks.clear();
+  std::fill(m_FreeLists.begin(), m_FreeLists.end(), nullptr);
+}
+
+/// @return Total size of the chunks in bytes
+std::size_t PoolResource::capacity() const {
+  const std::lock_guard lock(m_Mutex);
+  std::size_t total = 0;
+  for (const Chunk& chunk : m_Chunks) total += chunk.size;
+  return total;
+}
+
+/// Create a resource
+/// @param pool Threads that touch the pages, must outlive the resource
+/// @param threshold Size in bytes from which blocks are touched in parallel
+/// @param upstream Resource that provides the blocks
+FirstTouchResource::FirstTouchResource(ThreadPool& pool, const std::size_t threshold,
+                                       std::pmr::memory_resource* upstream)
+    : m_Upstream(upstream), m_Pool(&pool), m_Threshold(threshold) {}
+
+void* FirstTouchResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+  void* const p = m_Upstream->allocate(bytes, alignment);
+  if (bytes >= m_Threshold) {
+    auto* const data = static_cast<volatile std::byte*>(p);
+    const std::size_t pages = (bytes + PAGE_SIZE - 1) / PAGE_SIZE;
+    m_Pool->parallelForRange(0, pages, 1, [&](const std::size_t first, const std::size_t last) {
+      for (std::size_t page = first; page < last; ++page) data[page * PAGE_SIZE] = std::byte(0);
+    });
+  }
+  return p;
+}
+
+void FirstTouchResource::do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) {
+  m_Upstream->deallocate(p, bytes, alignment);
+}
+
+bool FirstTouchResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+}  // namespace Math
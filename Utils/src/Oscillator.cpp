@@ -0,0 +1,153 @@
+#include "Oscillator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "ComplexMath.h"
+
+namespace Math {
+
+namespace {
+
+/// Phase in radians as a fixed point fraction of a turn, modulo one turn, rounded to the nearest 2 pi / 2^64
+uint64_t toFixed(const long double angle) {
+  const long double turns = angle / (2 * std::numbers::pi_v<long double>);
+  const long double fraction = std::round(std::ldexp(turns - std::floor(turns), 64));
+  // The fraction can round up to a whole turn
+  return fraction >= std::ldexp(1.0L, 64) ? 0 : static_cast<uint64_t>(fraction);
+}
+
+/// Fixed point phase in radians, in [-pi, pi)
+long double toAngle(const uint64_t phase) {
+  return std::ldexp(static_cast<long double>(static_cast<int64_t>(phase)), -63) * std::numbers::pi_v<long double>;
+}
+
+void checkSize(const std::size_t size, const std::size_t expected) {
+  if (size != expected) throw std::invalid_argument("Oscillator: operands differ in size");
+}
+
+}  // namespace
+
+/// Creates an oscillator
+/// @param frequency Phase increment per sample in radians
+/// @param phase Phase of the first sample in radians
+template <scalar T>
+BasicOscillator<T>::BasicOscillator(const T frequency, const T phase)
+    : m_Phase(toFixed(phase)), m_Increment(0), m_Rotation(BLOCK_SIZE), m_Scratch(BLOCK_SIZE) {
+  setFrequency(frequency);
+}
+
+/// @return Phase increment per sample in radians, in [-pi, pi)
+template <scalar T>
+T BasicOscillator<T>::frequency() const {
+  return static_cast<T>(toAngle(m_Increment));
+}
+
+/// @return Phase of the next sample in radians, in [-pi, pi)
+template <scalar T>
+T BasicOscillator<T>::phase() const {
+  return static_cast<T>(toAngle(m_Phase));
+}
+
+/// Changes the frequency from the next sample on, keeping the phase continuous
+/// @param frequency Phase increment per sample in radians
+template <scalar T>
+void BasicOscillator<T>::setFrequency(const T frequency) {
+  m_Increment = toFixed(frequency);
+  phasors<T>(0, static_cast<T>(toAngle(m_Increment)), m_Rotation);
+}
+
+/// Sets the phase of the next sample
+/// @param phase Phase in radians
+template <scalar T>
+void BasicOscillator<T>::setPhase(const T phase) {
+  m_Phase = toFixed(phase);
+}
+
+/// @return Phasor of the next sample, exact up to the rounding to T
+template <scalar T>
+BasicComplex<T> BasicOscillator<T>::phasor() const {
+  const long double angle = toAngle(m_Phase);
+  return BasicComplex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+}
+
+/// Writes the unmodulated samples of one block and advances the phase
+/// @param out At most BLOCK_SIZE samples
+template <scalar T>
+void BasicOscillator<T>::carrier(const SplitSpan<T> out) {
+  multiply<T>(m_Rotation.view().subspan(0, out.size()), phasor(), out);
+  m_Phase += m_Increment * out.size();
+}
+
+/// Writes the next samples and advances the phase
+/// @param out Samples
+template <scalar T>
+void BasicOscillator<T>::generate(const SplitSpan<T> out) {
+  for (size_t i = 0; i < out.size(); i += BLOCK_SIZE) {
+    carrier(out.subspan(i, std::min(BLOCK_SIZE, out.size() - i)));
+  }
+}
+
+/// Writes the next samples and advances the phase
+/// @param out Interleaved samples
+template <scalar T>
+void BasicOscillator<T>::generate(const std::span<BasicComplex<T>> out) {
+  for (std::size_t i = 0; i < out.size(); i += BLOCK_SIZE) {
+    const size_t n = static_cast<size_t>(std::min<std::size_t>(BLOCK_SIZE, out.size() - i));
+    const SplitSpan<T> block = m_Scratch.view().subspan(0, n);
+    carrier(block);
+    interleave<T>(block, out.subspan(i, n));
+  }
+}
+
+/// Writes the next samples of the modulated oscillator, exp(i (phi_n + p_n)) with
+/// phi_(n+1) = phi_n + w + f_n. The frequency deviation is integrated into the phase.
+/// @param frequencyDeviation f_n in radians per sample, empty for no frequency modulation
+/// @param phaseDeviation p_n in radians, empty for no phase modulation
+/// @param out Samples
+template <scalar T>
+void BasicOscillator<T>::modulate(const std::span<const T> frequencyDeviation, const std::span<const T> phaseDeviation,
+                                  const SplitSpan<T> out) {
+  if (!frequencyDeviation.empty()) checkSize(frequencyDeviation.size(), out.size());
+  if (!phaseDeviation.empty()) checkSize(phaseDeviation.size(), out.size());
+  for (size_t i = 0; i < out.size(); i += BLOCK_SIZE) {
+    const size_t n = std::min(BLOCK_SIZE, out.size() - i);
+    // Deviation from the carrier phase relative to the start of the block
+    std::common_type_t<T, double> integrated = 0;
+    const std::span<T> angles = m_Scratch.imag().subspan(0, n);
+    for (size_t k = 0; k < n; ++k) {
+      const T p = phaseDeviation.empty() ? T(0) : phaseDeviation[i + k];
+      angles[k] = static_cast<T>(integrated + p);
+      if (!frequencyDeviation.empty()) integrated += frequencyDeviation[i + k];
+    }
+    std::fill_n(m_Scratch.real().begin(), n, T(0));
+    const SplitSpan<T> rotation = m_Scratch.view().subspan(0, n);
+    exp<T>(rotation, rotation);
+    const SplitSpan<T> block = out.subspan(i, n);
+    carrier(block);
+    multiply<T>(block, rotation, block);
+    m_Phase += toFixed(integrated);
+  }
+}
+
+/// Multiplies a signal by the next samples, which shifts its spectrum by the frequency. out may alias in.
+/// @param in Signal
+/// @param out Shifted signal of the same size
+template <scalar T>
+void BasicOscillator<T>::mix(const std::type_identity_t<SplitSpan<const T>> in, const SplitSpan<T> out) {
+  checkSize(in.size(), out.size());
+  for (size_t i = 0; i < out.size(); i += BLOCK_SIZE) {
+    const size_t n = std::min(BLOCK_SIZE, out.size() - i);
+    const SplitSpan<T> block = m_Scratch.view().subspan(0, n);
+    carrier(block);
+    multiply<T>(in.subspan(i, n), block, out.subspan(i, n));
+  }
+}
+
+template class BasicOscillator<float>;
+template class BasicOscillator<double>;
+template class BasicOscillator<long double>;
+
+}  // namespace Math
@@ -0,0 +1,281 @@
+#include "Polynomial.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+/// Number of interleaved points that are converted to split form at once
+constexpr std::size_t BLOCK_SIZE = 256;
+
+/// Iteration limit of the root finder, far beyond the few dozen iterations of well separated roots
+constexpr std::size_t MAX_ROOT_ITERATIONS = 500;
+
+/// Angle of the first starting point on the circle, which avoids symmetric configurations of real polynomials
+constexpr double START_ANGLE = 0.4;
+
+template <typename T>
+Kernels::Split<T> split(const SplitSpan<T> z) {
+  return {z.realData(), z.imagData()};
+}
+
+template <typename T>
+const Kernels::PolynomialKernels<T>& kernels() {
+  return Kernels::table<T>().polynomial;
+}
+
+void checkSize(const std::size_t size, const std::size_t expected) {
+  if (size != expected) throw std::invalid_argument("Polynomial: operands differ in size");
+}
+
+/// Buffers of the root finder, reused by the polynomials that a thread solves
+template <typename T>
+struct RootWorkspace {
+  BasicComplexArray<T> roots;
+  BasicComplexArray<T> values;
+  BasicComplexArray<T> derivatives;
+  BasicComplexArray<T> magnitudes;
+  BasicComplexArray<T> bounds;
+  BasicComplexArray<T> absCoefficients;
+  std::vector<bool> frozen;
+
+  void resize(const size_t degree) {
+    for (BasicComplexArray<T>* a : {&roots, &values, &derivatives, &magnitudes, &bounds}) a->resize(degree);
+    absCoefficients.resize(degree + 1);
+    frozen.assign(degree, false);
+  }
+};
+
+/// @return |z| without the overflow of abs beyond the square root of the largest number
+template <typename T>
+T magnitude(const BasicComplex<T>& z) {
+  return std::hypot(z.real(), z.imag());
+}
+
+template <typename T>
+bool isZero(const BasicComplex<T>& z) {
+  return z.real() == 0 && z.imag() == 0;
+}
+
+/// Aberth-Ehrlich iteration for one polynomial of degree at least 2 without roots at zero
+/// @param c Coefficients, c[0] != 0
+/// @param out Roots
+/// @return Convergence
+template <typename T>
+RootStatus aberth(const SplitSpan<const T> c, const std::span<BasicComplex<T>> out) {
+  constexpr T EPS = std::numeric_limits<T>::epsilon();
+  thread_local RootWorkspace<T> workspace;
+  const size_t n = c.size() - 1;
+  workspace.resize(n);
+  const SplitSpan<T> z = workspace.roots.view();
+  const SplitSpan<T> values = workspace.values.view();
+  const SplitSpan<T> derivatives = workspace.derivatives.view();
+  const SplitSpan<T> magnitudes = workspace.magnitudes.view();
+  const SplitSpan<T> bounds = workspace.bounds.view();
+  const SplitSpan<T> absCoefficients = workspace.absCoefficients.view();
+  std::vector<bool>& frozen = workspace.frozen;
+  // Starting points on the circle whose radius is the geometric mean of the root magnitudes
+  const T radius = std::pow(magnitude(c[0] / c[n]), T(1) / T(n));
+  for (size_t i = 0; i < n; ++i) {
+    const T angle = static_cast<T>(2 * std::numbers::pi * i / n + START_ANGLE);
+    z.real()[i] = radius * std::cos(angle);
+    z.imag()[i] = radius * std::sin(angle);
+    magnitudes.imag()[i] = 0;
+  }
+  for (size_t i = 0; i <= n; ++i) {
+    absCoefficients.real()[i] = magnitude(c[i]);
+    absCoefficients.imag()[i] = 0;
+  }
+  // Fujiwara's bound on the root magnitudes, 2 max |c[n - k] / c[n]|^(1/k). A step that leaves the disk is pulled
+  // back onto its boundary, far away the values overflow in single precision and the iteration would stall.
+  T maxRadius = 0;
+  for (size_t k = 1; k <= n; ++k) {
+    maxRadius = std::max(maxRadius, std::pow(magnitude(c[n - k] / c[n]), T(1) / T(k)));
+  }
+  maxRadius *= 2;
+  const auto& kernel = kernels<T>();
+  // |p(z)| below this multiple of |c|(|z|) is within the rounding error of Horner's scheme
+  const T errorBound = 4 * T(n + 1) * EPS;
+  RootStatus status{0, false};
+  while (status.iterations < MAX_ROOT_ITERATIONS) {
+    ++status.iterations;
+    kernel.derivative(split(c), n + 1, split<const T>(z), split(values), split(derivatives), n);
+    for (size_t i = 0; i < n; ++i) magnitudes.real()[i] = magnitude(z[i]);
+    kernel.evaluate(split<const T>(absCoefficients), n + 1, split<const T>(magnitudes), split(bounds), n);
+    bool done = true;
+    for (size_t i = 0; i < n; ++i) {
+      if (frozen[i]) continue;
+      const BasicComplex<T> value = values[i];
+      if (magnitude(value) <= errorBound * bounds.real()[i]) {
+        frozen[i] = true;
+        continue;
+      }
+      // Gauss-Seidel: the sum sees the roots that were already corrected in this iteration
+      const BasicComplex<T> zi = z[i];
+      BasicComplex<T> sum;
+      for (size_t j = 0; j < n; ++j) {
+        if (j != i) sum += T(1) / (zi - z[j]);
+      }
+      // Normalized by |p|, the division does not overflow where the values are large
+      const T scale = T(1) / magnitude(value);
+      const BasicComplex<T> normalized = value * scale;
+      const BasicComplex<T> correction = normalized / (derivatives[i] * scale - normalized * sum);
+      done = false;
+      if (!std::isfinite(correction.real()) || !std::isfinite(correction.imag())) continue;
+      BasicComplex<T> next = zi - correction;
+      if (magnitude(next) > maxRadius) next *= maxRadius / magnitude(next);
+      z.real()[i] = next.real();
+      z.imag()[i] = next.imag();
+      frozen[i] = magnitude(correction) <= EPS * magnitude(zi);
+    }
+    if (done) {
+      status.converged = true;
+      break;
+    }
+  }
+  for (size_t i = 0; i < n; ++i) out[i] = z[i];
+  return status;
+}
+
+/// Finds the roots of one polynomial
+/// @param polynomial Nonzero polynomial
+/// @param out degree() roots
+/// @return Convergence
+template <typename T>
+RootStatus solve(const BasicPolynomial<T>& polynomial, const std::span<BasicComplex<T>> out) {
+  const SplitSpan<const T> c = polynomial.coefficients();
+  const size_t n = polynomial.degree();
+  if (n == 0 && isZero(c[0])) throw std::invalid_argument("Polynomial: the zero polynomial has no roots");
+  // Roots at zero are exact, the remaining ones are the roots of c[zeros] + c[zeros + 1] z + ...
+  size_t zeros = 0;
+  while (zeros < n && isZero(c[zeros])) out[zeros++] = BasicComplex<T>();
+  const SplitSpan<const T> reduced = c.subspan(zeros, n + 1 - zeros);
+  const std::span<BasicComplex<T>> rest = out.subspan(zeros);
+  if (reduced.size() == 2) rest[0] = -reduced[0] / reduced[1];
+  if (reduced.size() <= 2) return {0, true};
+  return aberth<T>(reduced, rest);
+}
+
+}  // namespace
+
+/// Creates the zero polynomial
+template <scalar T>
+BasicPolynomial<T>::BasicPolynomial() : m_Coefficients(1) {}
+
+/// Creates a polynomial from its coefficients
+/// @param coefficients c[0], c[1], ..., from the constant term up
+template <scalar T>
+BasicPolynomial<T>::BasicPolynomial(const std::initializer_list<BasicComplex<T>> coefficients)
+    : BasicPolynomial(std::span<const BasicComplex<T>>(coefficients.begin(), coefficients.size())) {}
+
+/// Creates a polynomial from its coefficients
+/// @param coefficients c[0], c[1], ..., from the constant term up
+template <scalar T>
+BasicPolynomial<T>::BasicPolynomial(const std::span<const BasicComplex<T>> coefficients)
+    : m_Coefficients(coefficients) {
+  trim();
+}
+
+/// Removes trailing zero coefficients, keeping at least the constant term
+template <scalar T>
+void BasicPolynomial<T>::trim() {
+  size_t size = m_Coefficients.size();
+  while (size > 1 && isZero((*this)[size - 1])) --size;
+  m_Coefficients.resize(std::max<size_t>(size, 1));
+}
+
+/// Evaluates the polynomial at one point
+/// @param z Point
+/// @return Value at z
+template <scalar T>
+BasicComplex<T> BasicPolynomial<T>::operator()(const BasicComplex<T>& z) const {
+  BasicComplex<T> p = (*this)[degree()];
+  for (size_t k = degree(); k-- > 0;) p = p * z + (*this)[k];
+  return p;
+}
+
+/// Evaluates the polynomial at all points. out may alias z.
+/// @param z Points
+/// @param out Values of the same size
+template <scalar T>
+void BasicPolynomial<T>::evaluate(const std::type_identity_t<SplitSpan<const T>> z, const SplitSpan<T> out) const {
+  checkSize(z.size(), out.size());
+  kernels<T>().evaluate(split(coefficients()), m_Coefficients.size(), split(z), split(out), out.size());
+}
+
+/// Evaluates the polynomial at all points. out may alias z.
+/// @param z Interleaved points
+/// @param out Values of the same size
+template <scalar T>
+void BasicPolynomial<T>::evaluate(const std::type_identity_t<std::span<const BasicComplex<T>>> z,
+                                  const std::span<BasicComplex<T>> out) const {
+  checkSize(z.size(), out.size());
+  alignas(MEMORY_ALIGNMENT) T real[BLOCK_SIZE];
+  alignas(MEMORY_ALIGNMENT) T imag[BLOCK_SIZE];
+  for (std::size_t i = 0; i < z.size(); i += BLOCK_SIZE) {
+    const size_t n = static_cast<size_t>(std::min(BLOCK_SIZE, z.size() - i));
+    const SplitSpan<T> block(real, imag, n);
+    deinterleave<T>(z.subspan(i, n), block);
+    evaluate(block, block);
+    interleave<T>(block, out.subspan(i, n));
+  }
+}
+
+/// @return First derivative
+template <scalar T>
+BasicPolynomial<T> BasicPolynomial<T>::derivative() const {
+  std::vector<BasicComplex<T>> coefficients(std::max<size_t>(degree(), 1));
+  for (size_t k = 1; k <= degree(); ++k) coefficients[k - 1] = T(k) * (*this)[k];
+  return BasicPolynomial(coefficients);
+}
+
+/// Finds all roots with the Aberth-Ehrlich method, see Math::roots
+/// @return degree() roots, in no particular order
+/// @throws std::runtime_error If the iteration does not converge, e.g. for coefficients that are not finite
+template <scalar T>
+std::vector<BasicComplex<T>> BasicPolynomial<T>::roots() const {
+  std::vector<BasicComplex<T>> result(degree());
+  if (!solve<T>(*this, result).converged) throw std::runtime_error("Polynomial: Aberth iteration did not converge");
+  return result;
+}
+
+/// Finds the roots of a batch of polynomials with the Aberth-Ehrlich method, which refines all roots of a polynomial
+/// simultaneously and converges cubically to simple roots. A root is frozen once its value is dominated by the rounding
+/// error of the evaluation or its correction is below the working precision, and a polynomial stops iterating as
+/// soon as all of its roots are frozen. The polynomials are distributed over the threads of a pool.
+/// @param polynomials Polynomials, the zero polynomial is not allowed
+/// @param roots Roots of all polynomials, the degree of each one after the other
+/// @param pool Threads that find the roots
+/// @return Convergence of every polynomial
+template <scalar T>
+std::vector<RootStatus> roots(const std::span<const BasicPolynomial<T>> polynomials,
+                              const std::span<BasicComplex<T>> roots, ThreadPool& pool) {
+  std::vector<std::size_t> offsets(polynomials.size() + 1);
+  for (std::size_t i = 0; i < polynomials.size(); ++i) offsets[i + 1] = offsets[i] + polynomials[i].degree();
+  checkSize(roots.size(), offsets.back());
+  std::vector<RootStatus> status(polynomials.size());
+  pool.parallelFor(0, polynomials.size(), 1, [&](const std::size_t i) {
+    status[i] = solve<T>(polynomials[i], roots.subspan(offsets[i], offsets[i + 1] - offsets[i]));
+  });
+  return status;
+}
+
+#define MATH_INSTANTIATE_POLYNOMIAL(T)                                                                       \
+  template class BasicPolynomial<T>;                                                                         \
+  template std::vector<RootStatus> roots<T>(std::span<const BasicPolynomial<T>>, std::span<BasicComplex<T>>, \
+                                            ThreadPool&);
+
+MATH_INSTANTIATE_POLYNOMIAL(float)
+MATH_INSTANTIATE_POLYNOMIAL(double)
+MATH_INSTANTIATE_POLYNOMIAL(long double)
+
+#undef MATH_INSTANTIATE_POLYNOMIAL
+
+}  // namespace Math
@@ -0,0 +1,169 @@
+#include "QuantizedArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "ComplexArray.h"
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+/// Number of interleaved numbers that are converted to split form at once
+constexpr std::size_t BLOCK_SIZE = 256;
+
+template <typename T>
+Kernels::Split<T> split(const SplitSpan<T> z) {
+  return {z.realData(), z.imagData()};
+}
+
+template <typename T, typename Q>
+const Kernels::QuantizedKernels<T, Q>& kernels() {
+  if constexpr (std::same_as<Q, int8_t>) {
+    return Kernels::table<T>().quantized8;
+  } else {
+    return Kernels::table<T>().quantized16;
+  }
+}
+
+/// @return Integers of samples, I and Q interleaved
+template <typename Q>
+const Q* integers(const IqSample<Q>* samples) {
+  return reinterpret_cast<const Q*>(samples);
+}
+
+template <typename Q>
+Q* integers(IqSample<Q>* samples) {
+  return reinterpret_cast<Q*>(samples);
+}
+
+void checkSize(const std::size_t size, const std::size_t expected) {
+  if (size != expected) throw std::invalid_argument("QuantizedArray: operands differ in size");
+}
+
+}  // namespace
+
+template <quantized Q, scalar T>
+size_t BasicQuantizedArray<Q, T>::checkedSize(const std::size_t size) {
+  static_assert(sizeof(sample_type) == 2 * sizeof(Q), "IqSample must be a packed pair");
+  if (size > MAX_ELEMENT_COUNT) throw std::length_error("QuantizedArray: size exceeds MAX_ELEMENT_COUNT");
+  return static_cast<size_t>(size);
+}
+
+template <quantized Q, scalar T>
+T BasicQuantizedArray<Q, T>::checkedScale(const T scale) {
+  if (!(scale > 0) || !std::isfinite(scale)) throw std::invalid_argument("QuantizedArray: scale must be positive");
+  return scale;
+}
+
+template <quantized Q, scalar T>
+void BasicQuantizedArray<Q, T>::checkRange(const std::size_t offset, const std::size_t count) const {
+  if (offset > size() || count > size() - offset) throw std::invalid_argument("QuantizedArray: range out of bounds");
+}
+
+/// Create an array of zeros
+/// @param size Number of elements
+/// @param scale Value of one quantization step, positive and finite
+template <quantized Q, scalar T>
+BasicQuantizedArray<Q, T>::BasicQuantizedArray(const size_t size, const T scale)
+    : m_Samples(checkedSize(size)), m_Scale(checkedScale(scale)) {}
+
+/// Create an array by quantizing complex numbers
+/// @param z Complex numbers
+/// @param scale Value of one quantization step, e.g. fullScale(z)
+template <quantized Q, scalar T>
+BasicQuantizedArray<Q, T>::BasicQuantizedArray(const std::type_identity_t<SplitSpan<const T>> z, const T scale)
+    : BasicQuantizedArray(z.size(), scale) {
+  quantize(z);
+}
+
+/// Smallest scale at which no part of the numbers saturates, so that the largest one maps to MAX_VALUE
+/// @param z Complex numbers
+/// @return Scale, 1 if all numbers are zero or not finite
+template <quantized Q, scalar T>
+T BasicQuantizedArray<Q, T>::fullScale(const std::type_identity_t<SplitSpan<const T>> z) {
+  T largest = 0;
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    const T part = std::max(std::fabs(z.realData()[i]), std::fabs(z.imagData()[i]));
+    if (std::isfinite(part)) largest = std::max(largest, part);
+  }
+  const T scale = largest / T(MAX_VALUE);
+  return scale > 0 && std::isfinite(scale) ? scale : T(1);
+}
+
+/// Dequantizes out.size() elements
+/// @param out Complex numbers
+/// @param offset Index of the first element
+template <quantized Q, scalar T>
+void BasicQuantizedArray<Q, T>::dequantize(const SplitSpan<T> out, const std::size_t offset) const {
+  checkRange(offset, out.size());
+  kernels<T, Q>().dequantize(integers(m_Samples.data() + offset), m_Scale, split(out), out.size());
+}
+
+/// Dequantizes out.size() elements
+/// @param out Interleaved complex numbers
+/// @param offset Index of the first element
+template <quantized Q, scalar T>
+void BasicQuantizedArray<Q, T>::dequantize(const std::span<BasicComplex<T>> out, const std::size_t offset) const {
+  checkRange(offset, out.size());
+  alignas(MEMORY_ALIGNMENT) T real[BLOCK_SIZE];
+  alignas(MEMORY_ALIGNMENT) T imag[BLOCK_SIZE];
+  for (std::size_t i = 0; i < out.size(); i += BLOCK_SIZE) {
+    const size_t n = static_cast<size_t>(std::min(BLOCK_SIZE, out.size() - i));
+    const SplitSpan<T> block(real, imag, n);
+    dequantize(block, offset + i);
+    interleave<T>(block, out.subspan(i, n));
+  }
+}
+
+/// Quantizes z.size() elements with the scale of the array
+/// @param z Complex numbers
+/// @param offset Index of the first element
+template <quantized Q, scalar T>
+void BasicQuantizedArray<Q, T>::quantize(const std::type_identity_t<SplitSpan<const T>> z, const std::size_t offset) {
+  checkRange(offset, z.size());
+  kernels<T, Q>().quantize(split(z), T(1) / m_Scale, integers(m_Samples.data() + offset), z.size());
+}
+
+/// Quantizes z.size() elements with the scale of the array
+/// @param z Interleaved complex numbers
+/// @param offset Index of the first element
+template <quantized Q, scalar T>
+void BasicQuantizedArray<Q, T>::quantize(const std::type_identity_t<std::span<const BasicComplex<T>>> z,
+                                         const std::size_t offset) {
+  checkRange(offset, z.size());
+  alignas(MEMORY_ALIGNMENT) T real[BLOCK_SIZE];
+  alignas(MEMORY_ALIGNMENT) T imag[BLOCK_SIZE];
+  for (std::size_t i = 0; i < z.size(); i += BLOCK_SIZE) {
+    const size_t n = static_cast<size_t>(std::min(BLOCK_SIZE, z.size() - i));
+    const SplitSpan<T> block(real, imag, n);
+    deinterleave<T>(z.subspan(i, n), block);
+    quantize(block, offset + i);
+  }
+}
+
+/// Fused dequantize-multiply-accumulate, acc[k] += (*this)[offset + k] * w[k] for k < acc.size()
+/// @param w Factors, the size of acc
+/// @param acc Accumulators
+/// @param offset Index of the first element
+template <quantized Q, scalar T>
+void BasicQuantizedArray<Q, T>::multiplyAccumulate(const std::type_identity_t<SplitSpan<const T>> w,
+                                                   const SplitSpan<T> acc, const std::size_t offset) const {
+  checkSize(w.size(), acc.size());
+  checkRange(offset, acc.size());
+  kernels<T, Q>().multiplyAccumulate(integers(m_Samples.data() + offset), m_Scale, split(w), split(acc), acc.size());
+}
+
+#define MATH_INSTANTIATE_QUANTIZED_ARRAY(T)      \
+  template class BasicQuantizedArray<int8_t, T>; \
+  template class BasicQuantizedArray<int16_t, T>;
+
+MATH_INSTANTIATE_QUANTIZED_ARRAY(float)
+MATH_INSTANTIATE_QUANTIZED_ARRAY(double)
+MATH_INSTANTIATE_QUANTIZED_ARRAY(long double)
+
+#undef MATH_INSTANTIATE_QUANTIZED_ARRAY
+
+}  // namespace Math
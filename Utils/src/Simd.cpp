@@ -0,0 +1,88 @@
+#include "Simd.h"
+
+#include <atomic>
+
+#if defined(MATH_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Math::Simd {
+
+namespace {
+
+#if defined(MATH_SIMD_X86) && defined(_MSC_VER)
+/// Reads the CPUID feature flags and the register state enabled by the operating system
+Isa detectWithCpuid() {
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return Isa::Sse2;
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool fma = (info[2] & (1 << 12)) != 0;
+  if (!osxsave) return Isa::Sse2;
+  const unsigned long long xcr0 = _xgetbv(0);
+  __cpuidex(info, 7, 0);
+  const bool avx2 = (info[1] & (1 << 5)) != 0;
+  const bool avx512f = (info[1] & (1 << 16)) != 0;
+  if (avx512f && (xcr0 & 0xE6) == 0xE6) return Isa::Avx512;
+  if (avx2 && fma && (xcr0 & 0x6) == 0x6) return Isa::Avx2;
+  return Isa::Sse2;
+}
+#endif
+
+std::atomic<Isa>& activeIsaStorage() {
+  static std::atomic<Isa> isa(detectIsa());
+  return isa;
+}
+
+}  // namespace
+
+/// Detects the widest instruction set that is supported by the CPU and was compiled into the library
+/// @return Best available instruction set
+Isa detectIsa() {
+#if defined(MATH_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return Isa::Avx512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Isa::Avx2;
+  return Isa::Sse2;
+#elif defined(MATH_SIMD_X86) && defined(_MSC_VER)
+  static const Isa isa = detectWithCpuid();
+  return isa;
+#else
+  return Isa::Scalar;
+#endif
+}
+
+/// Get the instruction set used by the kernels
+/// @return Active instruction set, initially the detected one
+Isa activeIsa() {
+  return activeIsaStorage().load(std::memory_order_relaxed);
+}
+
+/// Selects the instruction set used by the kernels
+/// @param isa Requested instruction set, limited to the detected one
+/// @return Instruction set that is active afterwards
+Isa setActiveIsa(const Isa isa) {
+  const Isa selected = isa < detectIsa() ? isa : detectIsa();
+  activeIsaStorage().store(selected, std::memory_order_relaxed);
+  return selected;
+}
+
+/// Converts an instruction set to its name
+/// @param isa Instruction set
+/// @return Name of the instruction set
+std::string to_string(const Isa isa) {
+  switch (isa) {
+    case Isa::Scalar:
+      return "Scalar";
+    case Isa::Sse2:
+      return "SSE2";
+    case Isa::Avx2:
+      return "AVX2";
+    case Isa::Avx512:
+      return "AVX512";
+  }
+  return "Unknown";
+}
+
+}  // namespace Math::Simd
@@ -0,0 +1,273 @@
+#include "SlidingDft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "Kernels/Kernels.h"
+
+namespace Math {
+
+namespace {
+
+/// Number of samples that are prepared at once, the differences of the sliding DFT and interleaved samples
+constexpr std::size_t BLOCK_SIZE = 256;
+
+template <typename T>
+Kernels::Split<T> split(const SplitSpan<T> z) {
+  return {z.realData(), z.imagData()};
+}
+
+template <typename T>
+const Kernels::SpectralKernels<T>& kernels() {
+  return Kernels::table<T>().spectral;
+}
+
+template <typename T>
+void copy(const SplitSpan<const T> from, const SplitSpan<T> to) {
+  std::copy(from.realData(), from.realData() + from.size(), to.realData());
+  std::copy(from.imagData(), from.imagData() + from.size(), to.imagData());
+}
+
+template <typename T>
+void clear(const SplitSpan<T> z) {
+  std::fill(z.realData(), z.realData() + z.size(), T(0));
+  std::fill(z.imagData(), z.imagData() + z.size(), T(0));
+}
+
+/// @return exp(i angle), rounded once from long double
+template <typename T>
+BasicComplex<T> phasor(const long double angle) {
+  return BasicComplex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+}
+
+/// Converts interleaved samples to split form in blocks and passes them to process
+template <typename T, typename F>
+void forEachBlock(const std::span<const BasicComplex<T>> samples, const F& process) {
+  alignas(MEMORY_ALIGNMENT) T real[BLOCK_SIZE];
+  alignas(MEMORY_ALIGNMENT) T imag[BLOCK_SIZE];
+  for (std::size_t i = 0; i < samples.size(); i += BLOCK_SIZE) {
+    const size_t n = static_cast<size_t>(std::min(BLOCK_SIZE, samples.size() - i));
+    const SplitSpan<T> block(real, imag, n);
+    deinterleave<T>(samples.subspan(i, n), block);
+    process(SplitSpan<const T>(block));
+  }
+}
+
+}  // namespace
+
+/// Creates a transform of a window of zeros
+/// @param windowSize N, between 1 and MAX_ELEMENT_COUNT / 2
+/// @param bins Indices k < N of the bins
+/// @param resyncWindows Number of windows between the recomputations of the bins, at least 1
+template <scalar T>
+BasicSlidingDft<T>::BasicSlidingDft(const size_t windowSize, const std::span<const size_t> bins,
+                                    const size_t resyncWindows)
+    : m_WindowSize(windowSize),
+      m_ResyncPeriod(std::size_t(windowSize) * resyncWindows),
+      m_Bins(bins.begin(), bins.end()),
+      m_Position(0),
+      m_Elapsed(0) {
+  if (windowSize == 0) throw std::invalid_argument("SlidingDft: window size must be positive");
+  if (windowSize > MAX_ELEMENT_COUNT / 2) {
+    throw std::length_error("SlidingDft: window size exceeds MAX_ELEMENT_COUNT / 2");
+  }
+  if (bins.size() > MAX_ELEMENT_COUNT) throw std::length_error("SlidingDft: number of bins exceeds MAX_ELEMENT_COUNT");
+  if (resyncWindows == 0) throw std::invalid_argument("SlidingDft: resync period must be positive");
+  const auto n = static_cast<size_t>(bins.size());
+  m_Twiddles.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    if (bins[i] >= windowSize) throw std::invalid_argument("SlidingDft: bin out of range");
+    m_Twiddles[i] = phasor<T>(2 * std::numbers::pi_v<long double> * bins[i] / windowSize);
+  }
+  m_Spectrum.resize(n);
+  m_Buffer.resize(windowSize + std::max(static_cast<size_t>(BLOCK_SIZE), windowSize));
+  m_Delta.resize(static_cast<size_t>(BLOCK_SIZE));
+}
+
+/// Recomputes the bins from the samples of the window, starting the recurrence from zero
+template <scalar T>
+void BasicSlidingDft<T>::resync() {
+  clear(m_Spectrum.view());
+  const SplitSpan<const T> window = m_Buffer.view().subspan(m_Position, m_WindowSize);
+  kernels<T>().slidingDft(split(m_Spectrum.view()), split<const T>(m_Twiddles.view()), m_Bins.size(), split(window),
+                          m_WindowSize, {nullptr, nullptr}, 0);
+  m_Elapsed = 0;
+}
+
+/// Slides the window over samples
+/// @param samples Samples
+/// @param spectra Spectrum after every sample, or empty
+template <scalar T>
+void BasicSlidingDft<T>::slide(const SplitSpan<const T> samples, const SplitSpan<T> spectra) {
+  const std::size_t bins = m_Bins.size();
+  const size_t capacity = m_Buffer.size() - m_WindowSize;
+  for (size_t i = 0; i < samples.size();) {
+    if (m_Position == capacity) {
+      copy<T>(m_Buffer.view().subspan(capacity, m_WindowSize), m_Buffer.view());
+      m_Position = 0;
+    }
+    const auto count = static_cast<size_t>(
+        std::min<std::size_t>({samples.size() - i, capacity - m_Position, BLOCK_SIZE, m_ResyncPeriod - m_Elapsed}));
+    const SplitSpan<T> added = m_Buffer.view().subspan(m_WindowSize + m_Position, count);
+    copy<T>(samples.subspan(i, count), added);
+    const SplitSpan<T> delta = m_Delta.view().subspan(0, count);
+    subtract<T>(added, m_Buffer.view().subspan(m_Position, count), delta);
+    Kernels::Split<T> out{nullptr, nullptr};
+    if (!spectra.empty()) {
+      out = split(spectra.subspan(static_cast<size_t>(i * bins), static_cast<size_t>(count * bins)));
+    }
+    kernels<T>().slidingDft(split(m_Spectrum.view()), split<const T>(m_Twiddles.view()), bins, split<const T>(delta),
+                            count, out, bins);
+    m_Position += count;
+    m_Elapsed += count;
+    i += count;
+    if (m_Elapsed == m_ResyncPeriod) resync();
+  }
+}
+
+/// Slides the window by one sample
+/// @param sample Next sample of the stream
+template <scalar T>
+void BasicSlidingDft<T>::update(const BasicComplex<T>& sample) {
+  const T real = sample.real();
+  const T imag = sample.imag();
+  slide(SplitSpan<const T>(&real, &imag, 1), {});
+}
+
+/// Slides the window over the next samples of the stream
+/// @param samples Samples
+template <scalar T>
+void BasicSlidingDft<T>::update(const std::type_identity_t<SplitSpan<const T>> samples) {
+  slide(samples, {});
+}
+
+/// Slides the window over the next samples of the stream
+/// @param samples Interleaved samples
+template <scalar T>
+void BasicSlidingDft<T>::update(const std::type_identity_t<std::span<const BasicComplex<T>>> samples) {
+  forEachBlock<T>(samples, [&](const SplitSpan<const T> block) { slide(block, {}); });
+}
+
+/// Slides the window over the next samples of the stream and writes the spectrum after every sample
+/// @param samples Samples
+/// @param spectra samples.size() * bins().size() numbers, the spectrum after sample t at t * bins().size()
+template <scalar T>
+void BasicSlidingDft<T>::update(const std::type_identity_t<SplitSpan<const T>> samples, const SplitSpan<T> spectra) {
+  if (spectra.size() != std::size_t(samples.size()) * m_Bins.size()) {
+    throw std::invalid_argument("SlidingDft: spectra must hold one spectrum per sample");
+  }
+  slide(samples, spectra);
+}
+
+/// Clears the window, so that the next sample starts a new stream
+template <scalar T>
+void BasicSlidingDft<T>::reset() {
+  clear(m_Buffer.view());
+  clear(m_Spectrum.view());
+  m_Position = 0;
+  m_Elapsed = 0;
+}
+
+/// Creates a bank at the start of a block
+/// @param frequencies Frequencies w in radians per sample
+/// @param blockSize Number of samples per block, at least 1
+template <scalar T>
+BasicGoertzelBank<T>::BasicGoertzelBank(const std::span<const T> frequencies, const size_t blockSize)
+    : m_BlockSize(blockSize), m_Frequencies(frequencies.begin(), frequencies.end()), m_Position(0) {
+  if (blockSize == 0) throw std::invalid_argument("GoertzelBank: block size must be positive");
+  if (frequencies.size() > MAX_ELEMENT_COUNT) {
+    throw std::length_error("GoertzelBank: number of frequencies exceeds MAX_ELEMENT_COUNT");
+  }
+  const auto n = static_cast<size_t>(frequencies.size());
+  m_Coefficients.resize(n);
+  m_Last.resize(n);
+  m_BeforeLast.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    // X(w) = exp(-i w (N - 1)) (s1 - exp(-i w) s2)
+    const long double w = frequencies[i];
+    m_Coefficients[i] = static_cast<T>(2 * std::cos(w));
+    m_Last[i] = phasor<T>(-w * (blockSize - 1));
+    m_BeforeLast[i] = -phasor<T>(-w * blockSize);
+  }
+  m_S1.resize(n);
+  m_S2.resize(n);
+  m_Scratch.resize(n);
+}
+
+/// @param inputSize Number of samples of the next call of process
+/// @return Number of results that it writes, frequencies().size() per completed block
+template <scalar T>
+std::size_t BasicGoertzelBank<T>::outputSize(const std::size_t inputSize) const {
+  return (m_Position + inputSize) / m_BlockSize * m_Frequencies.size();
+}
+
+/// Writes X(w) of the completed block and starts the next one
+/// @param out Results, frequencies().size() numbers
+template <scalar T>
+void BasicGoertzelBank<T>::finish(const SplitSpan<T> out) {
+  multiply<T>(m_Last.view(), m_S1.view(), out);
+  multiply<T>(m_BeforeLast.view(), m_S2.view(), m_Scratch.view());
+  add<T>(out, m_Scratch.view(), out);
+  clear(m_S1.view());
+  clear(m_S2.view());
+  m_Position = 0;
+}
+
+/// Feeds the next samples of the stream
+/// @param in Samples
+/// @param out X(w) of every block that completes, at least outputSize(in.size()) numbers, in the order of
+/// frequencies() per block
+/// @return Number of results written
+template <scalar T>
+std::size_t BasicGoertzelBank<T>::process(const std::type_identity_t<SplitSpan<const T>> in, const SplitSpan<T> out) {
+  if (out.size() < outputSize(in.size())) throw std::invalid_argument("GoertzelBank: output is too small");
+  const auto bins = static_cast<size_t>(m_Frequencies.size());
+  std::size_t written = 0;
+  for (size_t i = 0; i < in.size();) {
+    const size_t count = std::min(in.size() - i, m_BlockSize - m_Position);
+    kernels<T>().goertzel(split(m_S1.view()), split(m_S2.view()), m_Coefficients.data(), bins,
+                          split(in.subspan(i, count)), count);
+    m_Position += count;
+    i += count;
+    if (m_Position == m_BlockSize) {
+      finish(out.subspan(static_cast<size_t>(written), bins));
+      written += bins;
+    }
+  }
+  return written;
+}
+
+/// Feeds the next samples of the stream
+/// @param in Interleaved samples
+/// @param out X(w) of every block that completes, at least outputSize(in.size()) numbers
+/// @return Number of results written
+template <scalar T>
+std::size_t BasicGoertzelBank<T>::process(const std::type_identity_t<std::span<const BasicComplex<T>>> in,
+                                          const SplitSpan<T> out) {
+  if (out.size() < outputSize(in.size())) throw std::invalid_argument("GoertzelBank: output is too small");
+  std::size_t written = 0;
+  forEachBlock<T>(in, [&](const SplitSpan<const T> block) {
+    written += process(block, out.subspan(static_cast<size_t>(written), static_cast<size_t>(out.size() - written)));
+  });
+  return written;
+}
+
+/// Discards the samples of the current block
+template <scalar T>
+void BasicGoertzelBank<T>::reset() {
+  clear(m_S1.view());
+  clear(m_S2.view());
+  m_Position = 0;
+}
+
+template class BasicSlidingDft<float>;
+template class BasicSlidingDft<double>;
+template class BasicSlidingDft<long double>;
+
+template class BasicGoertzelBank<float>;
+template class BasicGoertzelBank<double>;
+template class BasicGoertzelBank<long double>;
+
+}  // namespace Math
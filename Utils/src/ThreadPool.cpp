@@ -0,0 +1,161 @@
+#include "ThreadPool.h"
+
+namespace Math {
+
+namespace {
+
+/// Set on worker threads and while the caller executes its share of a loop, nested loops then run inline
+thread_local bool insideLoop = false;
+
+/// Chunks per thread of a loop, so that uneven chunks can be balanced by stealing
+constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+uint64_t packRange(const std::size_t begin, const std::size_t end) {
+  return (static_cast<uint64_t>(begin) << 32) | static_cast<uint64_t>(end);
+}
+
+std::size_t rangeBegin(const uint64_t range) {
+  return static_cast<std::size_t>(range >> 32);
+}
+
+std::size_t rangeEnd(const uint64_t range) {
+  return static_cast<std::size_t>(range & UINT32_MAX);
+}
+
+/// Number of chunks of a range, whose begin never exceeds its end
+std::size_t rangeSize(const uint64_t range) {
+  return rangeEnd(range) - rangeBegin(range);
+}
+
+}  // namespace
+
+/// Starts threadCount - 1 workers
+/// @param threadCount Number of threads that execute a loop, including the caller, at least 1
+ThreadPool::ThreadPool(const std::size_t threadCount)
+    : m_Shares(std::make_unique<Share[]>(std::max<std::size_t>(threadCount, 1))) {
+  for (std::size_t i = 1; i < threadCount; ++i) m_Workers.emplace_back([this, i] { work(i); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_Wake.notify_all();
+  for (std::thread& worker : m_Workers) worker.join();
+}
+
+/// Indices per chunk of a loop, at least grain, and few enough chunks for the 32-bit bounds of a share
+std::size_t ThreadPool::chunkSize(const std::size_t count, const std::size_t grain) const {
+  const std::size_t chunks = CHUNKS_PER_THREAD * threadCount();
+  return std::max<std::size_t>({grain, (count + chunks - 1) / chunks, (count - 1) / UINT32_MAX + 1});
+}
+
+void ThreadPool::work(const std::size_t thread) {
+  insideLoop = true;
+  uint64_t generation = 0;
+  std::unique_lock lock(m_Mutex);
+  while (true) {
+    m_Wake.wait(lock, [&] { return m_Stop || (m_Job != nullptr && m_Generation != generation); });
+    if (m_Stop) return;
+    generation = m_Generation;
+    Job& job = *m_Job;
+    ++m_Active;
+    lock.unlock();
+    runChunks(job, thread);
+    lock.lock();
+    --m_Active;
+    m_Finished.notify_all();
+  }
+}
+
+/// Takes the first chunk of the share of a thread
+bool ThreadPool::popChunk(const std::size_t thread, std::size_t& chunk) {
+  std::atomic<uint64_t>& share = m_Shares[thread].range;
+  uint64_t range = share.load();
+  while (rangeSize(range) > 0) {
+    if (share.compare_exchange_weak(range, packRange(rangeBegin(range) + 1, rangeEnd(range)))) {
+      chunk = rangeBegin(range);
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Steals the back half of the largest share of another thread, returns its first chunk and keeps the rest as the
+/// share of the thief, which is empty when it steals
+bool ThreadPool::stealChunk(const std::size_t thread, std::size_t& chunk) {
+  while (true) {
+    std::size_t victim = thread;
+    uint64_t largest = 0;
+    for (std::size_t k = 1; k < threadCount(); ++k) {
+      const std::size_t other = (thread + k) % threadCount();
+      const uint64_t range = m_Shares[other].range.load();
+      if (rangeSize(range) > rangeSize(largest)) {
+        victim = other;
+        largest = range;
+      }
+    }
+    if (victim == thread) return false;
+    const std::size_t middle = rangeBegin(largest) + rangeSize(largest) / 2;
+    if (m_Shares[victim].range.compare_exchange_strong(largest, packRange(rangeBegin(largest), middle))) {
+      m_Shares[thread].range.store(packRange(middle + 1, rangeEnd(largest)));
+      chunk = middle;
+      return true;
+    }
+  }
+}
+
+void ThreadPool::runChunks(Job& job, const std::size_t thread) {
+  std::size_t c = 0;
+  while (popChunk(thread, c) || stealChunk(thread, c)) {
+    try {
+      (*job.chunk)(c, thread);
+    } catch (...) {
+      const std::lock_guard lock(job.errorMutex);
+      if (!job.error) job.error = std::current_exception();
+    }
+    ++job.done;
+  }
+}
+
+void ThreadPool::run(const std::size_t chunkCount, const Chunk& chunk) {
+  std::unique_lock submit(m_Submit, std::try_to_lock);
+  if (insideLoop || m_Workers.empty() || !submit.owns_lock()) {
+    for (std::size_t c = 0; c < chunkCount; ++c) chunk(c, 0);
+    return;
+  }
+  Job job;
+  job.chunk = &chunk;
+  job.chunkCount = chunkCount;
+  // Contiguous shares in thread order, the same for every loop with the same number of chunks
+  for (std::size_t thread = 0; thread < threadCount(); ++thread) {
+    m_Shares[thread].range.store(
+        packRange(thread * chunkCount / threadCount(), (thread + 1) * chunkCount / threadCount()));
+  }
+  {
+    const std::lock_guard lock(m_Mutex);
+    m_Job = &job;
+    ++m_Generation;
+  }
+  m_Wake.notify_all();
+  insideLoop = true;
+  runChunks(job, 0);
+  insideLoop = false;
+  {
+    // Workers that picked up the job may still hold a reference to it until they leave runChunks
+    std::unique_lock lock(m_Mutex);
+    m_Finished.wait(lock, [&] { return job.done == chunkCount && m_Active == 0; });
+    m_Job = nullptr;
+  }
+  if (job.error) std::rethrow_exception(job.error);
+}
+
+/// Get the pool shared by the library, with one thread per hardware thread
+/// @return Process wide thread pool
+ThreadPool& defaultThreadPool() {
+  static ThreadPool pool(std::max(1U, std::thread::hardware_concurrency()));
+  return pool;
+}
+
+}  // namespace Math